@@ -12,7 +12,6 @@
 #include "Common.h"
 
 #include <cstdio>
-#include <fstream>
 #include <memory>
 
 #include "Cube/Cube.h"
@@ -22,8 +21,13 @@
 #include "Model/Model.h"
 #include "Renderer/Skybox.h"
 #include "Scene/Scene.h"
+#include "Scene/TerrainGenerator.h"
 #include "Scene/Voxel.h"
+#include "Shader/D3DShaderCompiler.h"
+#include "Shader/ShaderCache.h"
+#include "Shader/SkinningShadowVertexShader.h"
 #include "Shader/SkyMapVertexShader.h"
+#include "Shader/VoxelVertexShader.h"
 
 /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
   Function: wWinMain
@@ -53,8 +57,6 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
 
     std::unique_ptr<library::Game> game = std::make_unique<library::Game>(L"Game Graphics Programming Assignment 3: Cube Mapping");
 
-    std::ofstream sceneFile;
-    sceneFile.open("HeightMap.txt");
     constexpr const UINT MAP_WIDTH = 0;
     constexpr const UINT MAP_HEIGHT = 0;
     constexpr const UINT MAP_DEPTH = 0;
@@ -77,148 +79,25 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         XMFLOAT4(0.15f,     0.372f, 0.15f,  1.0f),  // TROPICAL_RAIN_FOREST
     };
 
-    sceneFile << MAP_WIDTH << " " << MAP_HEIGHT << " " << MAP_DEPTH << ' ' << ARRAYSIZE(aColors) << '\n';
-
-    for (UINT colorIdx = 0; colorIdx < ARRAYSIZE(aColors); ++colorIdx)
-    {
-        sceneFile << aColors[colorIdx].x << ' ' <<
-            aColors[colorIdx].y << ' ' <<
-            aColors[colorIdx].z << '\n';
-    }
-
-    for (UINT z = 0u; z < MAP_DEPTH; ++z)
-    {
-        for (UINT x = 0u; x < MAP_WIDTH; ++x)
-        {
-            FLOAT height = 0.0f;
-
-            FLOAT frequencySum = 0.0f;
-            for (UINT i = 0; i < 4; ++i)
-            {
-                FLOAT frequency = pow(2.0f, static_cast<FLOAT>(i));
-                frequencySum += 1.0f / frequency;
-                height += library::Scene::GetPerlin2d(frequency * static_cast<FLOAT>(x), frequency * static_cast<FLOAT>(z), 0.1f, 4u) / frequency;
-            }
-            height /= frequencySum;
-            height = pow(height * 1.2f, 1.25f);
-
-            assert(height >= 0.0f);
-
-            FLOAT moisture = 0.0f;
-
-            frequencySum = 0.0f;
-            for (UINT i = 0; i < 4; ++i)
-            {
-                FLOAT frequency = pow(2.0f, static_cast<FLOAT>(i));
-                frequencySum += 1.0f / frequency;
-                moisture += library::Scene::GetPerlin2d(frequency * static_cast<FLOAT>(x), frequency * static_cast<FLOAT>(z), 0.1f, 4u) / frequency;
-            }
-            moisture /= frequencySum;
-            moisture = pow(moisture * 1.2f, 1.25f);
-
-            library::eBlockType blockType = library::eBlockType::GRASSLAND;
-
-            if (height < 0.1f)
-            {
-                blockType = library::eBlockType::OCEAN;
-            }
-            else if (height < 0.12f)
-            {
-                blockType = library::eBlockType::SAND;
-            }
-            else if (height > 0.8f)
-            {
-                if (moisture < 0.1f)
-                {
-                    blockType = library::eBlockType::SCORCHED;
-                }
-                else if (moisture < 0.2f)
-                {
-                    blockType = library::eBlockType::BARE;
-                }
-                else if (moisture < 0.5f)
-                {
-                    blockType = library::eBlockType::TUNDRA;
-                }
-                else
-                {
-                    blockType = library::eBlockType::SNOW;
-                }
-            }
-            else if (height > 0.6f)
-            {
-                if (moisture < 0.33f)
-                {
-                    blockType = library::eBlockType::TEMPERATE_DESERT;
-                }
-                else if (moisture < 0.66f)
-                {
-                    blockType = library::eBlockType::SHRUBLAND;
-                }
-                else
-                {
-                    blockType = library::eBlockType::TAIGA;
-                }
-            }
-            else if (height > 0.3f)
-            {
-                if (moisture < 0.16f)
-                {
-                    blockType = library::eBlockType::TEMPERATE_DESERT;
-                }
-                else if (moisture < 0.5f)
-                {
-                    blockType = library::eBlockType::GRASSLAND;
-                }
-                else if (moisture < 0.83f)
-                {
-                    blockType = library::eBlockType::TEMPERATE_DECIDUOUS_FOREST;
-                }
-                else
-                {
-                    blockType = library::eBlockType::TEMPERATE_RAIN_FOREST;
-                }
-            }
-            else
-            {
-
-                if (moisture < 0.16f)
-                {
-                    blockType = library::eBlockType::SUBTROPICAL_DESERT;
-                }
-                else if (moisture < 0.33f)
-                {
-                    blockType = library::eBlockType::GRASSLAND;
-                }
-                else if (moisture < 0.66f)
-                {
-                    blockType = library::eBlockType::TROPICAL_SEASONAL_FOREST;
-                }
-                else
-                {
-                    blockType = library::eBlockType::TROPICAL_RAIN_FOREST;
-                }
-            }
-
-            sceneFile << static_cast<CHAR>(blockType);
-
-            sceneFile << height << ' ';
-        }
-        sceneFile << '\n';
-    }
-    sceneFile << std::endl;
-    sceneFile.close();
-
-    std::shared_ptr<library::Scene> mainScene = std::make_shared<library::Scene>(L"HeightMap.txt");
+    library::TerrainGenerator terrain(MAP_WIDTH, MAP_HEIGHT, MAP_DEPTH, aColors, ARRAYSIZE(aColors));
+    if (FAILED(terrain.Generate()))
+    {
+        return 0;
+    }
+
+    std::shared_ptr<library::Scene> mainScene = std::make_shared<library::Scene>(terrain);
+
+    // Keeps the compiled shaders across launches
+    library::Shader::SetCompiler(std::make_shared<library::ShaderCache>(L"ShaderCache", std::make_shared<library::D3DShaderCompiler>()));
 
     // Phong
-    std::shared_ptr<library::VertexShader> phongVertexShader = std::make_shared<library::VertexShader>(L"Shaders/PhongShaders.fxh", "VSPhong", "vs_5_0");
+    std::shared_ptr<library::VertexShader> phongVertexShader = std::make_shared<library::VertexShader>(L"Shaders/PhongShaders.fxh", "VSPhong", "vs_5_0", library::Shader::FEATURE_NORMAL_MAP);
     if (FAILED(mainScene->AddVertexShader(L"PhongShader", phongVertexShader)))
     {
         return 0;
     }
     // Voxel
-    std::shared_ptr<library::VertexShader> voxelVertexShader = std::make_shared<library::VertexShader>(L"Shaders/VoxelShaders.fxh", "VSVoxel", "vs_5_0");
+    std::shared_ptr<library::VoxelVertexShader> voxelVertexShader = std::make_shared<library::VoxelVertexShader>(L"Shaders/VoxelShaders.fxh", "VSVoxel", "vs_5_0", library::Shader::FEATURE_NORMAL_MAP);
     if (FAILED(mainScene->AddVertexShader(L"VoxelShader", voxelVertexShader)))
     {
         return 0;
@@ -243,13 +122,13 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     }
 
     // Phong
-    std::shared_ptr<library::PixelShader> phongPixelShader = std::make_shared<library::PixelShader>(L"Shaders/PhongShaders.fxh", "PSPhong", "ps_5_0");
+    std::shared_ptr<library::PixelShader> phongPixelShader = std::make_shared<library::PixelShader>(L"Shaders/PhongShaders.fxh", "PSPhong", "ps_5_0", library::Shader::FEATURE_NORMAL_MAP);
     if (FAILED(mainScene->AddPixelShader(L"PhongShader", phongPixelShader)))
     {
         return 0;
     }
     // Voxel
-    std::shared_ptr<library::PixelShader> voxelPixelShader = std::make_shared<library::PixelShader>(L"Shaders/VoxelShaders.fxh", "PSVoxel", "ps_5_0");
+    std::shared_ptr<library::PixelShader> voxelPixelShader = std::make_shared<library::PixelShader>(L"Shaders/VoxelShaders.fxh", "PSVoxel", "ps_5_0", library::Shader::FEATURE_NORMAL_MAP);
     if (FAILED(mainScene->AddPixelShader(L"VoxelShader", voxelPixelShader)))
     {
         return 0;
@@ -266,6 +145,27 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     {
         return 0;
     }
+    // Shadow casters, depth only
+    std::shared_ptr<library::VertexShader> shadowVertexShader = std::make_shared<library::VertexShader>(L"Shaders/ShadowShaders.fxh", "VSShadow", "vs_5_0");
+    if (FAILED(mainScene->AddVertexShader(L"ShadowShader", shadowVertexShader)))
+    {
+        return 0;
+    }
+
+    std::shared_ptr<library::VoxelVertexShader> voxelShadowVertexShader = std::make_shared<library::VoxelVertexShader>(L"Shaders/ShadowShaders.fxh", "VSShadowVoxel", "vs_5_0");
+    if (FAILED(mainScene->AddVertexShader(L"VoxelShadowShader", voxelShadowVertexShader)))
+    {
+        return 0;
+    }
+
+    std::shared_ptr<library::SkinningShadowVertexShader> skinningShadowVertexShader = std::make_shared<library::SkinningShadowVertexShader>(L"Shaders/ShadowShaders.fxh", "VSShadowSkinning", "vs_5_0");
+    if (FAILED(mainScene->AddVertexShader(L"SkinningShadowShader", skinningShadowVertexShader)))
+    {
+        return 0;
+    }
+
+    game->GetRenderer()->SetShadowMapShaders(shadowVertexShader, voxelShadowVertexShader, skinningShadowVertexShader);
+
     // Environment Map
     std::shared_ptr<library::PixelShader> environmentMapPixelShader = std::make_shared<library::PixelShader>(L"Shaders/CubeMap.fxh", "PSEnvironmentMap", "ps_5_0");
     if (FAILED(mainScene->AddPixelShader(L"EnvironmentMapShader", environmentMapPixelShader)))
@@ -306,6 +206,10 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     {
         return 0;
     }
+    if (FAILED(mainScene->SetStatic(mainScene->FindModel(L"Sponza"), TRUE)))
+    {
+        return 0;
+    }
     //-----------------------------------for light attenuation---------------------------------------------------
 
 
@@ -341,10 +245,14 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     }*/
     //-----------------------------------For environment mapping model---------------------------------------------------
 
+    //the sun casts the cascaded shadows
+    mainScene->SetDirectionalLight(XMFLOAT4(0.3f, -1.0f, 0.2f, 0.0f), XMFLOAT4(0.6f, 0.6f, 0.55f, 1.0f));
+
     XMFLOAT4 color;
     XMStoreFloat4(&color, Colors::Orange);
 
-    std::shared_ptr<library::PointLight> directionalLight = std::make_shared<library::PointLight>(XMFLOAT4(0.f, 10.f, 0.f, 1.0f), color, 10.0f);
+    //the light is attached to the cube below, so its position is relative to the cube
+    std::shared_ptr<library::PointLight> directionalLight = std::make_shared<library::PointLight>(XMFLOAT4(0.f, 0.f, 0.f, 1.0f), color, 10.0f);
     if (FAILED(mainScene->AddPointLight(0, directionalLight)))
     {
         return 0;
@@ -364,6 +272,10 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     {
         return 0;
     }
+    if (FAILED(mainScene->AttachPointLight(0, mainScene->FindRenderable(L"PointLight"))))
+    {
+        return 0;
+    }
 
     if (FAILED(game->GetRenderer()->AddScene(L"VoxelMap", mainScene)))
     {
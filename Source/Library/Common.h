@@ -30,6 +30,7 @@
 #include <d3d11_4.h>
 #include <d3dcompiler.h>
 #include <directxcolors.h>
+#include <DirectXCollision.h>
 
 #define _CRTDBG_MAP_ALLOC
 #include <stdlib.h>
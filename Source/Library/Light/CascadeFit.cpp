@@ -0,0 +1,168 @@
+#include "Light/CascadeFit.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadeFit::ComputeSlices
+
+      Summary:  Splits the view frustum, up to the shadow distance,
+                blending the logarithmic and the uniform schemes, and
+                computes the bounding sphere of each slice. A slice is
+                symmetric around the view axis, so its sphere is
+                centered on the axis, at the depth equally far from the
+                corners of both ends, or at the far end when that depth
+                is past it
+
+      Args:     float fovAngleY
+                  Vertical field of view, in radians
+                float aspectRatio
+                  Width divided by height of the viewport
+                float nearZ
+                  Distance to the near plane
+                float shadowDistance
+                  View depth past which nothing is shadowed
+                float splitLambda
+                  Weight of the logarithmic splits, the rest is uniform
+                uint32_t uNumCascades
+                  Number of cascades
+                CascadeSlice* aSlices
+                  Receives the slice of each cascade
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CascadeFit::ComputeSlices(float fovAngleY, float aspectRatio, float nearZ, float shadowDistance, float splitLambda, uint32_t uNumCascades, CascadeSlice* aSlices)
+    {
+        assert(nearZ > 0.0f && shadowDistance > nearZ && aspectRatio > 0.0f);
+
+        // Squared distance of a corner from the view axis per unit of depth
+        const float tanHalfFovY = tanf(fovAngleY * 0.5f);
+        const float tanHalfFovX = tanHalfFovY * aspectRatio;
+        const float cornerSlopeSquared = tanHalfFovX * tanHalfFovX + tanHalfFovY * tanHalfFovY;
+
+        float sliceNear = nearZ;
+        for (uint32_t uCascade = 0u; uCascade < uNumCascades; ++uCascade)
+        {
+            const float fraction = static_cast<float>(uCascade + 1u) / static_cast<float>(uNumCascades);
+            const float logSplit = nearZ * powf(shadowDistance / nearZ, fraction);
+            const float uniformSplit = nearZ + (shadowDistance - nearZ) * fraction;
+            const float sliceFar = splitLambda * logSplit + (1.0f - splitLambda) * uniformSplit;
+
+            const float centerDistance = (std::min)((sliceNear + sliceFar) * 0.5f * (1.0f + cornerSlopeSquared), sliceFar);
+            const float farCornerSquared = sliceFar * sliceFar * cornerSlopeSquared;
+
+            aSlices[uCascade] = CascadeSlice
+            {
+                .SplitDistance = sliceFar,
+                .CenterDistance = centerDistance,
+                .Radius = sqrtf(farCornerSquared + (sliceFar - centerDistance) * (sliceFar - centerDistance))
+            };
+
+            sliceNear = sliceFar;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadeFit::GetTexelSize
+
+      Summary:  Returns the world size of a texel of a cascade, whose
+                map covers the sphere and its margin
+
+      Args:     float radius
+                  Radius of the sphere of the cascade
+                float refitMargin
+                  Margin around the sphere, relative to its radius
+                uint32_t uMapSize
+                  Width of the shadow map in texels
+
+      Returns:  float
+                  Width of a texel in world units
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    float CascadeFit::GetTexelSize(float radius, float refitMargin, uint32_t uMapSize)
+    {
+        return 2.0f * radius * (1.0f + refitMargin) / static_cast<float>(uMapSize);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadeFit::SnapToTexels
+
+      Summary:  Snaps the x and y of a light space center down to whole
+                texels. The light view has no translation, so a cascade
+                fitted around a snapped center moves by whole texels
+
+      Args:     const float* pCenter
+                  Light space center, x, y and z
+                float texelSize
+                  Width of a texel in world units
+                float* pSnapped
+                  Receives the snapped center, z left as is
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CascadeFit::SnapToTexels(const float* pCenter, float texelSize, float* pSnapped)
+    {
+        pSnapped[0] = floorf(pCenter[0] / texelSize) * texelSize;
+        pSnapped[1] = floorf(pCenter[1] / texelSize) * texelSize;
+        pSnapped[2] = pCenter[2];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadeFit::IsOutsideMargin
+
+      Summary:  Returns whether the center of a sphere moved past the
+                margin of the fit it was last fitted at, after which
+                the box of the fit no longer covers the sphere
+
+      Args:     const float* pCenter
+                  Light space center of the sphere this frame
+                const float* pFittedCenter
+                  Light space center of the fit
+                float radius
+                  Radius of the sphere
+                float refitMargin
+                  Margin around the sphere, relative to its radius
+
+      Returns:  bool
+                  True if the cascade needs to be fitted again
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    bool CascadeFit::IsOutsideMargin(const float* pCenter, const float* pFittedCenter, float radius, float refitMargin)
+    {
+        const float margin = radius * refitMargin;
+
+        return fabsf(pCenter[0] - pFittedCenter[0]) > margin
+            || fabsf(pCenter[1] - pFittedCenter[1]) > margin
+            || fabsf(pCenter[2] - pFittedCenter[2]) > margin;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadeFit::GetLightSpaceBox
+
+      Summary:  Returns the light space box of a cascade fitted around
+                a center. It covers the sphere and its margin, and its
+                depth range reaches back toward the light so casters
+                out of view still cast
+
+      Args:     const float* pCenter
+                  Light space center of the fit
+                float radius
+                  Radius of the sphere
+                float refitMargin
+                  Margin around the sphere, relative to its radius
+                float casterDistance
+                  Distance the box reaches toward the light
+                float* pMin
+                  Receives the minimum corner
+                float* pMax
+                  Receives the maximum corner
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CascadeFit::GetLightSpaceBox(const float* pCenter, float radius, float refitMargin, float casterDistance, float* pMin, float* pMax)
+    {
+        const float extent = radius * (1.0f + refitMargin);
+
+        pMin[0] = pCenter[0] - extent;
+        pMin[1] = pCenter[1] - extent;
+        pMin[2] = pCenter[2] - extent - casterDistance;
+        pMax[0] = pCenter[0] + extent;
+        pMax[1] = pCenter[1] + extent;
+        pMax[2] = pCenter[2] + extent;
+    }
+}
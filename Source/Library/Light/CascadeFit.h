@@ -0,0 +1,71 @@
+/*+===================================================================
+  File:      CASCADEFIT.H
+
+  Summary:   CascadeFit header file contains declarations of the
+             CascadeFit class used for the lab samples of Game
+             Graphics Programming course. Only depends on the
+             standard library.
+
+  Classes: CascadeFit
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <cstdint>
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+     Struct:   CascadeSlice
+     Summary:  Slice of the view frustum covered by a cascade and its
+               bounding sphere, centered on the view axis
+   S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct CascadeSlice
+    {
+        float SplitDistance;
+        float CenterDistance;
+        float Radius;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    CascadeFit
+
+      Summary:  Math of the cascades of a shadow map that does not
+                depend on the light view: where the view frustum is
+                split, the bounding sphere of each slice, snapping a
+                light space center to texels, when a fit is stale and
+                the light space box of a fit
+
+      Methods:  ComputeSlices
+                  Splits the view frustum into cascades
+                GetTexelSize
+                  Returns the world size of a texel of a cascade
+                SnapToTexels
+                  Snaps a light space center to whole texels
+                IsOutsideMargin
+                  Returns whether a center left the margin of a fit
+                GetLightSpaceBox
+                  Returns the light space box of a fit
+                CascadeFit
+                  Constructor.
+                ~CascadeFit
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class CascadeFit final
+    {
+    public:
+        CascadeFit() = delete;
+        CascadeFit(const CascadeFit& other) = delete;
+        CascadeFit(CascadeFit&& other) = delete;
+        CascadeFit& operator=(const CascadeFit& other) = delete;
+        CascadeFit& operator=(CascadeFit&& other) = delete;
+        ~CascadeFit() = delete;
+
+        static void ComputeSlices(float fovAngleY, float aspectRatio, float nearZ, float shadowDistance, float splitLambda, uint32_t uNumCascades, CascadeSlice* aSlices);
+        static float GetTexelSize(float radius, float refitMargin, uint32_t uMapSize);
+        static void SnapToTexels(const float* pCenter, float texelSize, float* pSnapped);
+        static bool IsOutsideMargin(const float* pCenter, const float* pFittedCenter, float radius, float refitMargin);
+        static void GetLightSpaceBox(const float* pCenter, float radius, float refitMargin, float casterDistance, float* pMin, float* pMax);
+    };
+}
@@ -0,0 +1,609 @@
+#include "Light/CascadedShadowMap.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadedShadowMap::CascadedShadowMap
+
+      Summary:  Constructor
+
+      Modifies: [m_depthTexture, m_staticDepthTexture,
+                 m_aDepthStencilViews, m_aStaticDepthStencilViews,
+                 m_shaderResourceView, m_comparisonSampler, m_viewport,
+                 m_lightView, m_absLightView, m_aCascades,
+                 m_uNumRefreshes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    CascadedShadowMap::CascadedShadowMap()
+        : m_depthTexture()
+        , m_staticDepthTexture()
+        , m_aDepthStencilViews()
+        , m_aStaticDepthStencilViews()
+        , m_shaderResourceView()
+        , m_comparisonSampler()
+        , m_viewport
+        {
+            .TopLeftX = 0.0f,
+            .TopLeftY = 0.0f,
+            .Width = static_cast<FLOAT>(MAP_SIZE),
+            .Height = static_cast<FLOAT>(MAP_SIZE),
+            .MinDepth = 0.0f,
+            .MaxDepth = 1.0f
+        }
+        , m_lightView(XMMatrixIdentity())
+        , m_absLightView(XMMatrixIdentity())
+        , m_aCascades()
+        , m_uNumRefreshes(0u)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadedShadowMap::Initialize
+
+      Summary:  Creates the depth texture array, one slice per cascade,
+                a depth view per slice, a view of the whole array and
+                the comparison sampler. Past the border of a cascade
+                the comparison passes, so nothing is shadowed there.
+                The static casters get a texture array of their own,
+                which is only drawn into and copied from. Every
+                cascade is fitted again on the next frame
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the resources with
+
+      Modifies: [m_depthTexture, m_staticDepthTexture,
+                 m_aDepthStencilViews, m_aStaticDepthStencilViews,
+                 m_shaderResourceView, m_comparisonSampler,
+                 m_aCascades].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT CascadedShadowMap::Initialize(_In_ ID3D11Device* pDevice)
+    {
+        D3D11_TEXTURE2D_DESC descDepth =
+        {
+            .Width = MAP_SIZE,
+            .Height = MAP_SIZE,
+            .MipLevels = 1u,
+            .ArraySize = NUM_SHADOW_CASCADES,
+            .Format = DXGI_FORMAT_R32_TYPELESS,
+            .SampleDesc = {.Count = 1u, .Quality = 0u },
+            .Usage = D3D11_USAGE_DEFAULT,
+            .BindFlags = D3D11_BIND_DEPTH_STENCIL | D3D11_BIND_SHADER_RESOURCE,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = 0u
+        };
+        HRESULT hr = pDevice->CreateTexture2D(&descDepth, nullptr, m_depthTexture.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        descDepth.BindFlags = D3D11_BIND_DEPTH_STENCIL;
+        hr = pDevice->CreateTexture2D(&descDepth, nullptr, m_staticDepthTexture.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        for (UINT uCascade = 0u; uCascade < NUM_SHADOW_CASCADES; ++uCascade)
+        {
+            D3D11_DEPTH_STENCIL_VIEW_DESC descDSV =
+            {
+                .Format = DXGI_FORMAT_D32_FLOAT,
+                .ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2DARRAY,
+                .Texture2DArray = {.MipSlice = 0u, .FirstArraySlice = uCascade, .ArraySize = 1u }
+            };
+            hr = pDevice->CreateDepthStencilView(m_depthTexture.Get(), &descDSV, m_aDepthStencilViews[uCascade].GetAddressOf());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            hr = pDevice->CreateDepthStencilView(m_staticDepthTexture.Get(), &descDSV, m_aStaticDepthStencilViews[uCascade].GetAddressOf());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            m_aCascades[uCascade].bFitted = FALSE;
+        }
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC descSRV =
+        {
+            .Format = DXGI_FORMAT_R32_FLOAT,
+            .ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY,
+            .Texture2DArray = {.MostDetailedMip = 0u, .MipLevels = 1u, .FirstArraySlice = 0u, .ArraySize = NUM_SHADOW_CASCADES }
+        };
+        hr = pDevice->CreateShaderResourceView(m_depthTexture.Get(), &descSRV, m_shaderResourceView.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        D3D11_SAMPLER_DESC descSampler =
+        {
+            .Filter = D3D11_FILTER_COMPARISON_MIN_MAG_LINEAR_MIP_POINT,
+            .AddressU = D3D11_TEXTURE_ADDRESS_BORDER,
+            .AddressV = D3D11_TEXTURE_ADDRESS_BORDER,
+            .AddressW = D3D11_TEXTURE_ADDRESS_BORDER,
+            .MipLODBias = 0.0f,
+            .MaxAnisotropy = 1u,
+            .ComparisonFunc = D3D11_COMPARISON_LESS_EQUAL,
+            .BorderColor = { 1.0f, 1.0f, 1.0f, 1.0f },
+            .MinLOD = 0.0f,
+            .MaxLOD = D3D11_FLOAT32_MAX
+        };
+        return pDevice->CreateSamplerState(&descSampler, m_comparisonSampler.GetAddressOf());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadedShadowMap::SetProjection
+
+      Summary:  Splits the view frustum, up to the shadow distance,
+                into the cascades and computes the bounding sphere of
+                each slice
+
+      Args:     FLOAT fovAngleY
+                  Vertical field of view, in radians
+                FLOAT aspectRatio
+                  Width divided by height of the viewport
+                FLOAT nearZ
+                  Distance to the near plane
+                FLOAT shadowDistance
+                  View depth past which nothing is shadowed
+
+      Modifies: [m_aCascades].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CascadedShadowMap::SetProjection(_In_ FLOAT fovAngleY, _In_ FLOAT aspectRatio, _In_ FLOAT nearZ, _In_ FLOAT shadowDistance)
+    {
+        CascadeSlice aSlices[NUM_SHADOW_CASCADES];
+        CascadeFit::ComputeSlices(fovAngleY, aspectRatio, nearZ, shadowDistance, SPLIT_LAMBDA, NUM_SHADOW_CASCADES, aSlices);
+
+        for (UINT uCascade = 0u; uCascade < NUM_SHADOW_CASCADES; ++uCascade)
+        {
+            m_aCascades[uCascade].Slice = aSlices[uCascade];
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadedShadowMap::Update
+
+      Summary:  Builds the light view and finds the center of the
+                sphere of every cascade in light space. The light view
+                has no translation, so snapping the center to whole
+                texels in light space moves the cascade by whole texels
+                in world space. A cascade whose sphere left the margin
+                of its box, or whose light view changed, is marked
+                stale; its fit is kept until it is refreshed. Resets
+                the caster counters
+
+      Args:     const XMMATRIX& view
+                  View matrix of the camera
+                FXMVECTOR lightDirection
+                  Direction the light travels in
+
+      Modifies: [m_lightView, m_absLightView, m_aCascades].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CascadedShadowMap::Update(_In_ const XMMATRIX& view, _In_ FXMVECTOR lightDirection)
+    {
+        const XMVECTOR direction = XMVector3Normalize(lightDirection);
+        const XMVECTOR up = fabsf(XMVectorGetY(direction)) > 0.99f ? XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f) : XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+        m_lightView = XMMatrixLookToLH(XMVectorZero(), direction, up);
+
+        // Maps world extents to light space extents
+        m_absLightView.r[0] = XMVectorAbs(m_lightView.r[0]);
+        m_absLightView.r[1] = XMVectorAbs(m_lightView.r[1]);
+        m_absLightView.r[2] = XMVectorAbs(m_lightView.r[2]);
+        m_absLightView.r[3] = XMVectorZero();
+
+        const XMMATRIX inverseView = XMMatrixInverse(nullptr, view);
+
+        for (UINT uCascade = 0u; uCascade < NUM_SHADOW_CASCADES; ++uCascade)
+        {
+            Cascade& cascade = m_aCascades[uCascade];
+
+            const XMVECTOR worldCenter = XMVector3TransformCoord(XMVectorSet(0.0f, 0.0f, cascade.Slice.CenterDistance, 1.0f), inverseView);
+            XMFLOAT3 center;
+            XMStoreFloat3(&center, XMVector3TransformCoord(worldCenter, m_lightView));
+
+            CascadeFit::SnapToTexels(&center.x, GetTexelSize(uCascade), &cascade.PendingCenter.x);
+
+            if (cascade.bFitted && !cascade.bStale)
+            {
+                cascade.bStale = memcmp(&cascade.LightView, &m_lightView, sizeof(XMMATRIX)) != 0
+                    || CascadeFit::IsOutsideMargin(&center.x, &cascade.Center.x, cascade.Slice.Radius, REFIT_MARGIN);
+            }
+
+            cascade.uNumCasters = 0u;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadedShadowMap::Invalidate
+
+      Summary:  Marks the cascades a static caster overlaps as stale,
+                for the caster moved, appeared or disappeared. Called
+                with both the old and the new bounds of a moved caster
+
+      Args:     const BoundingBox& bounds
+                  World space bounds of the caster
+
+      Modifies: [m_aCascades].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CascadedShadowMap::Invalidate(_In_ const BoundingBox& bounds)
+    {
+        for (UINT uCascade = 0u; uCascade < NUM_SHADOW_CASCADES; ++uCascade)
+        {
+            Cascade& cascade = m_aCascades[uCascade];
+            if (cascade.bFitted && !cascade.bStale && intersects(cascade, bounds))
+            {
+                cascade.bStale = TRUE;
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadedShadowMap::InvalidateCascades
+
+      Summary:  Marks cascades as stale, such as the ones a caster was
+                culled into when its old bounds are no longer known
+
+      Args:     UINT uCascadeMask
+                  Cascades to mark, bit i being cascade i
+
+      Modifies: [m_aCascades].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CascadedShadowMap::InvalidateCascades(_In_ UINT uCascadeMask)
+    {
+        for (UINT uCascade = 0u; uCascade < NUM_SHADOW_CASCADES; ++uCascade)
+        {
+            if ((uCascadeMask & (1u << uCascade)) && m_aCascades[uCascade].bFitted)
+            {
+                m_aCascades[uCascade].bStale = TRUE;
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadedShadowMap::ScheduleRefreshes
+
+      Summary:  Chooses the cascades whose static depth is drawn this
+                frame and fits them to their pending center and the
+                current light view. The cascades never fitted are
+                always chosen, as they have nothing to show. Of the
+                stale ones, at most the given number are chosen, the
+                ones waiting the longest first and the nearest first
+                among those, so a light turning every frame refreshes
+                the cascades in turn. Must be called after Update and
+                the invalidations, before culling the casters
+
+      Args:     UINT uMaxRefreshes
+                  Maximum number of stale cascades to refresh
+
+      Modifies: [m_aCascades, m_uNumRefreshes].
+
+      Returns:  UINT
+                  Mask of the cascades to draw the static casters
+                  into, bit i being cascade i
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT CascadedShadowMap::ScheduleRefreshes(_In_ UINT uMaxRefreshes)
+    {
+        UINT uMask = 0u;
+        for (UINT uCascade = 0u; uCascade < NUM_SHADOW_CASCADES; ++uCascade)
+        {
+            if (!m_aCascades[uCascade].bFitted)
+            {
+                uMask |= 1u << uCascade;
+            }
+        }
+
+        for (UINT uRefresh = 0u; uRefresh < uMaxRefreshes; ++uRefresh)
+        {
+            UINT uOldest = NUM_SHADOW_CASCADES;
+            for (UINT uCascade = 0u; uCascade < NUM_SHADOW_CASCADES; ++uCascade)
+            {
+                const Cascade& cascade = m_aCascades[uCascade];
+                if (cascade.bStale && !(uMask & (1u << uCascade)) && (uOldest == NUM_SHADOW_CASCADES || cascade.uStaleFrames > m_aCascades[uOldest].uStaleFrames))
+                {
+                    uOldest = uCascade;
+                }
+            }
+
+            if (uOldest == NUM_SHADOW_CASCADES)
+            {
+                break;
+            }
+            uMask |= 1u << uOldest;
+        }
+
+        for (UINT uCascade = 0u; uCascade < NUM_SHADOW_CASCADES; ++uCascade)
+        {
+            Cascade& cascade = m_aCascades[uCascade];
+            if (uMask & (1u << uCascade))
+            {
+                setFit(cascade);
+                ++m_uNumRefreshes;
+            }
+            else if (cascade.bStale)
+            {
+                ++cascade.uStaleFrames;
+            }
+        }
+
+        return uMask;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadedShadowMap::Cull
+
+      Summary:  Tests the bounds of a caster against the box of every
+                cascade and counts it in the cascades it overlaps
+
+      Args:     const BoundingBox& bounds
+                  World space bounds of the caster
+
+      Modifies: [m_aCascades].
+
+      Returns:  UINT
+                  Mask of the cascades the caster is drawn into, bit i
+                  being cascade i
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT CascadedShadowMap::Cull(_In_ const BoundingBox& bounds)
+    {
+        UINT uMask = 0u;
+        for (UINT uCascade = 0u; uCascade < NUM_SHADOW_CASCADES; ++uCascade)
+        {
+            Cascade& cascade = m_aCascades[uCascade];
+            if (intersects(cascade, bounds))
+            {
+                uMask |= 1u << uCascade;
+                ++cascade.uNumCasters;
+            }
+        }
+
+        return uMask;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadedShadowMap::GetViewProjection
+
+      Summary:  Returns the light view projection of a cascade
+
+      Args:     UINT uCascade
+                  Index of the cascade
+
+      Returns:  const XMMATRIX&
+                  World to cascade clip space matrix
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const XMMATRIX& CascadedShadowMap::GetViewProjection(_In_ UINT uCascade) const
+    {
+        assert(uCascade < NUM_SHADOW_CASCADES);
+        return m_aCascades[uCascade].ViewProjection;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadedShadowMap::GetSplitDistance
+
+      Summary:  Returns the view depth where a cascade ends
+
+      Args:     UINT uCascade
+                  Index of the cascade
+
+      Returns:  FLOAT
+                  Far split distance of the cascade
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT CascadedShadowMap::GetSplitDistance(_In_ UINT uCascade) const
+    {
+        assert(uCascade < NUM_SHADOW_CASCADES);
+        return m_aCascades[uCascade].Slice.SplitDistance;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadedShadowMap::GetTexelSize
+
+      Summary:  Returns the world size of a texel of a cascade, which
+                the shaders offset the receivers by along their normal
+
+      Args:     UINT uCascade
+                  Index of the cascade
+
+      Returns:  FLOAT
+                  Width of a texel in world units
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT CascadedShadowMap::GetTexelSize(_In_ UINT uCascade) const
+    {
+        assert(uCascade < NUM_SHADOW_CASCADES);
+        return CascadeFit::GetTexelSize(m_aCascades[uCascade].Slice.Radius, REFIT_MARGIN, MAP_SIZE);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadedShadowMap::GetViewport
+
+      Summary:  Returns the viewport covering a cascade
+
+      Returns:  const D3D11_VIEWPORT&
+                  Viewport of MAP_SIZE by MAP_SIZE pixels
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const D3D11_VIEWPORT& CascadedShadowMap::GetViewport() const
+    {
+        return m_viewport;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadedShadowMap::GetDepthStencilView
+
+      Summary:  Returns the depth view of a cascade
+
+      Args:     UINT uCascade
+                  Index of the cascade
+
+      Returns:  ID3D11DepthStencilView*
+                  View of the slice of the cascade
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ID3D11DepthStencilView* CascadedShadowMap::GetDepthStencilView(_In_ UINT uCascade) const
+    {
+        assert(uCascade < NUM_SHADOW_CASCADES);
+        return m_aDepthStencilViews[uCascade].Get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadedShadowMap::GetStaticDepthStencilView
+
+      Summary:  Returns the depth view of the static casters of a
+                cascade
+
+      Args:     UINT uCascade
+                  Index of the cascade
+
+      Returns:  ID3D11DepthStencilView*
+                  View of the slice of the cascade in the static array
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ID3D11DepthStencilView* CascadedShadowMap::GetStaticDepthStencilView(_In_ UINT uCascade) const
+    {
+        assert(uCascade < NUM_SHADOW_CASCADES);
+        return m_aStaticDepthStencilViews[uCascade].Get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadedShadowMap::GetDepthTexture
+
+      Summary:  Returns the depth texture array sampled by the shaders
+
+      Returns:  ID3D11Texture2D*
+                  Texture array, subresource i being cascade i
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ID3D11Texture2D* CascadedShadowMap::GetDepthTexture() const
+    {
+        return m_depthTexture.Get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadedShadowMap::GetStaticDepthTexture
+
+      Summary:  Returns the depth texture array of the static casters
+
+      Returns:  ID3D11Texture2D*
+                  Texture array, subresource i being cascade i
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ID3D11Texture2D* CascadedShadowMap::GetStaticDepthTexture() const
+    {
+        return m_staticDepthTexture.Get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadedShadowMap::GetShaderResourceView
+
+      Summary:  Returns the view of every cascade
+
+      Returns:  ID3D11ShaderResourceView*
+                  Texture array view, one slice per cascade
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ID3D11ShaderResourceView* CascadedShadowMap::GetShaderResourceView() const
+    {
+        return m_shaderResourceView.Get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadedShadowMap::GetComparisonSampler
+
+      Summary:  Returns the sampler filtering the depth comparisons
+
+      Returns:  ID3D11SamplerState*
+                  Bilinear comparison sampler
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ID3D11SamplerState* CascadedShadowMap::GetComparisonSampler() const
+    {
+        return m_comparisonSampler.Get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadedShadowMap::GetNumCasters
+
+      Summary:  Returns the number of casters culled into a cascade
+                since the last Update
+
+      Args:     UINT uCascade
+                  Index of the cascade
+
+      Returns:  UINT
+                  Number of casters
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT CascadedShadowMap::GetNumCasters(_In_ UINT uCascade) const
+    {
+        assert(uCascade < NUM_SHADOW_CASCADES);
+        return m_aCascades[uCascade].uNumCasters;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadedShadowMap::GetNumRefreshes
+
+      Summary:  Returns the number of times the static depth of a
+                cascade was scheduled to be drawn
+
+      Returns:  UINT
+                  Number of refreshes since the construction
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT CascadedShadowMap::GetNumRefreshes() const
+    {
+        return m_uNumRefreshes;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadedShadowMap::setFit
+
+      Summary:  Fits an orthographic projection around the pending
+                center of a cascade, in the current light view. The box
+                covers the sphere and its margin, and its depth range
+                reaches back toward the light
+
+      Args:     Cascade& cascade
+                  Cascade to fit
+
+      Modifies: [m_aCascades].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CascadedShadowMap::setFit(_Inout_ Cascade& cascade)
+    {
+        cascade.LightView = m_lightView;
+        cascade.AbsLightView = m_absLightView;
+        cascade.Center = cascade.PendingCenter;
+        CascadeFit::GetLightSpaceBox(&cascade.Center.x, cascade.Slice.Radius, REFIT_MARGIN, CASTER_DISTANCE, &cascade.LightSpaceMin.x, &cascade.LightSpaceMax.x);
+        cascade.ViewProjection = m_lightView * XMMatrixOrthographicOffCenterLH(
+            cascade.LightSpaceMin.x,
+            cascade.LightSpaceMax.x,
+            cascade.LightSpaceMin.y,
+            cascade.LightSpaceMax.y,
+            cascade.LightSpaceMin.z,
+            cascade.LightSpaceMax.z
+        );
+        cascade.uStaleFrames = 0u;
+        cascade.bFitted = TRUE;
+        cascade.bStale = FALSE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CascadedShadowMap::intersects
+
+      Summary:  Tests the light space box of a caster against the box
+                of a cascade, in the light view the cascade was fitted
+                in. A caster past the far end of a cascade can not
+                shadow it, and the near end already reaches back toward
+                the light
+
+      Args:     const Cascade& cascade
+                  Cascade to test against
+                const BoundingBox& bounds
+                  World space bounds of the caster
+
+      Returns:  BOOL
+                  TRUE if the boxes overlap
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL CascadedShadowMap::intersects(_In_ const Cascade& cascade, _In_ const BoundingBox& bounds) const
+    {
+        const XMVECTOR center = XMVector3TransformCoord(XMLoadFloat3(&bounds.Center), cascade.LightView);
+        const XMVECTOR extents = XMVector3TransformNormal(XMLoadFloat3(&bounds.Extents), cascade.AbsLightView);
+
+        return XMVector3LessOrEqual(XMVectorSubtract(center, extents), XMLoadFloat3(&cascade.LightSpaceMax))
+            && XMVector3GreaterOrEqual(XMVectorAdd(center, extents), XMLoadFloat3(&cascade.LightSpaceMin));
+    }
+}
@@ -0,0 +1,171 @@
+/*+===================================================================
+  File:      CASCADEDSHADOWMAP.H
+
+  Summary:   CascadedShadowMap header file contains declarations of
+             CascadedShadowMap class used for the lab samples of Game
+             Graphics Programming course.
+
+  Classes: CascadedShadowMap
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Light/CascadeFit.h"
+#include "Renderer/DataTypes.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    CascadedShadowMap
+
+      Summary:  Shadow map of a directional light split into cascades
+                along the view. The splits blend the logarithmic and
+                the uniform schemes. Each cascade is fitted to the
+                bounding sphere of its slice of the view frustum, whose
+                radius only depends on the projection, and its center
+                is snapped to the texels of the map, so the shadows do
+                not shimmer while the camera moves or turns. The
+                casters are culled against the light space box of each
+                cascade, extended toward the light
+
+                The static casters are drawn into a second texture
+                array that is kept across frames. A cascade covers a
+                margin around its sphere and keeps its fit until the
+                sphere leaves the margin, the light turns or a static
+                caster in its box changes. Only then is its static
+                depth drawn again, for a limited number of cascades
+                per frame; the others keep their last fit meanwhile
+
+      Methods:  Initialize
+                  Creates the depth texture arrays and their views
+                SetProjection
+                  Sets the projection the cascades split
+                Update
+                  Fits the cascades to the view and the light
+                Invalidate
+                  Marks the cascades a changed static caster is in
+                InvalidateCascades
+                  Marks cascades for their static depth to be redrawn
+                ScheduleRefreshes
+                  Chooses the cascades whose static depth is redrawn
+                Cull
+                  Returns the cascades a caster is drawn into
+                GetViewProjection
+                  Returns the light view projection of a cascade
+                GetSplitDistance
+                  Returns the view depth where a cascade ends
+                GetTexelSize
+                  Returns the world size of a texel of a cascade
+                GetViewport
+                  Returns the viewport of a cascade
+                GetDepthStencilView
+                  Returns the depth view of a cascade
+                GetStaticDepthStencilView
+                  Returns the depth view of the static casters of a
+                  cascade
+                GetDepthTexture
+                  Returns the depth texture array sampled by the
+                  shaders
+                GetStaticDepthTexture
+                  Returns the depth texture array of the static
+                  casters
+                GetShaderResourceView
+                  Returns the view of every cascade
+                GetComparisonSampler
+                  Returns the sampler filtering the depth comparisons
+                GetNumCasters
+                  Returns the number of casters culled into a cascade
+                GetNumRefreshes
+                  Returns the number of static depth redraws so far
+                setFit
+                  Fits a cascade to its pending center and light view
+                intersects
+                  Returns whether a box overlaps the box of a cascade
+                CascadedShadowMap
+                  Constructor.
+                ~CascadedShadowMap
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class CascadedShadowMap final
+    {
+    public:
+        static constexpr const UINT MAP_SIZE = 2048u;
+
+        // Weight of the logarithmic splits, the rest is uniform
+        static constexpr const FLOAT SPLIT_LAMBDA = 0.75f;
+
+        // Distance the depth range of every cascade reaches toward the light, so casters out of view still cast
+        static constexpr const FLOAT CASTER_DISTANCE = 200.0f;
+
+        // Margin around the sphere of a cascade, relative to its radius, the sphere can move in before the cascade is refitted
+        static constexpr const FLOAT REFIT_MARGIN = 0.125f;
+
+        CascadedShadowMap();
+        CascadedShadowMap(const CascadedShadowMap& other) = delete;
+        CascadedShadowMap(CascadedShadowMap&& other) = delete;
+        CascadedShadowMap& operator=(const CascadedShadowMap& other) = delete;
+        CascadedShadowMap& operator=(CascadedShadowMap&& other) = delete;
+        ~CascadedShadowMap() = default;
+
+        HRESULT Initialize(_In_ ID3D11Device* pDevice);
+        void SetProjection(_In_ FLOAT fovAngleY, _In_ FLOAT aspectRatio, _In_ FLOAT nearZ, _In_ FLOAT shadowDistance);
+
+        void Update(_In_ const XMMATRIX& view, _In_ FXMVECTOR lightDirection);
+        void Invalidate(_In_ const BoundingBox& bounds);
+        void InvalidateCascades(_In_ UINT uCascadeMask);
+        UINT ScheduleRefreshes(_In_ UINT uMaxRefreshes);
+        UINT Cull(_In_ const BoundingBox& bounds);
+
+        const XMMATRIX& GetViewProjection(_In_ UINT uCascade) const;
+        FLOAT GetSplitDistance(_In_ UINT uCascade) const;
+        FLOAT GetTexelSize(_In_ UINT uCascade) const;
+        const D3D11_VIEWPORT& GetViewport() const;
+        ID3D11DepthStencilView* GetDepthStencilView(_In_ UINT uCascade) const;
+        ID3D11DepthStencilView* GetStaticDepthStencilView(_In_ UINT uCascade) const;
+        ID3D11Texture2D* GetDepthTexture() const;
+        ID3D11Texture2D* GetStaticDepthTexture() const;
+        ID3D11ShaderResourceView* GetShaderResourceView() const;
+        ID3D11SamplerState* GetComparisonSampler() const;
+
+        UINT GetNumCasters(_In_ UINT uCascade) const;
+        UINT GetNumRefreshes() const;
+
+    private:
+        struct Cascade
+        {
+            XMMATRIX ViewProjection;
+            XMMATRIX LightView;
+            XMMATRIX AbsLightView;
+            XMFLOAT3 Center;
+            XMFLOAT3 PendingCenter;
+            XMFLOAT3 LightSpaceMin;
+            XMFLOAT3 LightSpaceMax;
+            CascadeSlice Slice;
+            UINT uNumCasters;
+            UINT uStaleFrames;
+            BOOL bFitted;
+            BOOL bStale;
+        };
+
+    private:
+        void setFit(_Inout_ Cascade& cascade);
+        BOOL intersects(_In_ const Cascade& cascade, _In_ const BoundingBox& bounds) const;
+
+    private:
+        ComPtr<ID3D11Texture2D> m_depthTexture;
+        ComPtr<ID3D11Texture2D> m_staticDepthTexture;
+        ComPtr<ID3D11DepthStencilView> m_aDepthStencilViews[NUM_SHADOW_CASCADES];
+        ComPtr<ID3D11DepthStencilView> m_aStaticDepthStencilViews[NUM_SHADOW_CASCADES];
+        ComPtr<ID3D11ShaderResourceView> m_shaderResourceView;
+        ComPtr<ID3D11SamplerState> m_comparisonSampler;
+        D3D11_VIEWPORT m_viewport;
+
+        XMMATRIX m_lightView;
+        XMMATRIX m_absLightView;
+        Cascade m_aCascades[NUM_SHADOW_CASCADES];
+        UINT m_uNumRefreshes;
+    };
+}
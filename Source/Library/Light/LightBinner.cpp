@@ -0,0 +1,295 @@
+#include "Light/LightBinner.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightBinner::LightBinner
+
+      Summary:  Constructor
+
+      Modifies: [m_tanHalfFovX, m_tanHalfFovY, m_nearZ, m_farZ,
+                 m_aVisibleLights, m_aSpans, m_aClusters,
+                 m_aLightIndices, m_uNumDroppedLightIndices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    LightBinner::LightBinner()
+        : m_tanHalfFovX(1.0f)
+        , m_tanHalfFovY(1.0f)
+        , m_nearZ(0.01f)
+        , m_farZ(1000.0f)
+        , m_aVisibleLights()
+        , m_aSpans()
+        , m_aClusters(NUM_CLUSTERS)
+        , m_aLightIndices()
+        , m_uNumDroppedLightIndices(0u)
+    {
+        m_aVisibleLights.reserve(MAX_VISIBLE_LIGHTS);
+        m_aLightIndices.reserve(MAX_LIGHT_INDICES);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightBinner::SetProjection
+
+      Summary:  Sets the perspective projection and the viewport the
+                clusters are built for
+
+      Args:     float fovAngleY
+                  Vertical field of view, in radians
+                uint32_t uWidth
+                  Width of the viewport in pixels
+                uint32_t uHeight
+                  Height of the viewport in pixels
+                float nearZ
+                  Distance to the near plane
+                float farZ
+                  Distance to the far plane
+
+      Modifies: [m_tanHalfFovX, m_tanHalfFovY, m_nearZ, m_farZ].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void LightBinner::SetProjection(float fovAngleY, uint32_t uWidth, uint32_t uHeight, float nearZ, float farZ)
+    {
+        assert(uWidth > 0u && uHeight > 0u && nearZ > 0.0f && farZ > nearZ);
+
+        m_tanHalfFovY = tanf(fovAngleY * 0.5f);
+        m_tanHalfFovX = m_tanHalfFovY * static_cast<float>(uWidth) / static_cast<float>(uHeight);
+        m_nearZ = nearZ;
+        m_farZ = farZ;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightBinner::Bin
+
+      Summary:  Keeps the lights whose range reaches the view frustum
+                and lists them in every cluster their bounding sphere
+                overlaps. For each depth slice, the screen bounds of
+                the sphere are taken over the part of the slice it
+                covers, so a light only reaches the tiles it can light
+
+      Args:     const LightSphere* aSpheres
+                  Lights in view space
+                uint32_t uNumSpheres
+                  Number of lights
+
+      Modifies: [m_aVisibleLights, m_aSpans, m_aClusters,
+                 m_aLightIndices, m_uNumDroppedLightIndices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void LightBinner::Bin(const LightSphere* aSpheres, uint32_t uNumSpheres)
+    {
+        m_aVisibleLights.clear();
+        m_aSpans.clear();
+        m_aLightIndices.clear();
+        m_uNumDroppedLightIndices = 0u;
+        for (LightClusterRange& cluster : m_aClusters)
+        {
+            cluster = LightClusterRange{ .Offset = 0u, .Count = 0u };
+        }
+
+        for (uint32_t i = 0u; i < uNumSpheres && m_aVisibleLights.size() < MAX_VISIBLE_LIGHTS; ++i)
+        {
+            const LightSphere& sphere = aSpheres[i];
+            const float range = sphere.Range;
+            if (sphere.Z + range < m_nearZ || sphere.Z - range > m_farZ)
+            {
+                continue;
+            }
+
+            const uint32_t uLight = static_cast<uint32_t>(m_aVisibleLights.size());
+            const size_t uNumSpans = m_aSpans.size();
+            const float minZ = (std::max)(sphere.Z - range, m_nearZ);
+            const float maxZ = (std::min)(sphere.Z + range, m_farZ);
+            const uint32_t uLastSlice = getSlice(maxZ);
+            for (uint32_t uSlice = getSlice(minZ); uSlice <= uLastSlice; ++uSlice)
+            {
+                const float sliceNearZ = (std::max)(getSliceNear(uSlice), minZ);
+                const float sliceFarZ = (std::min)(getSliceNear(uSlice + 1u), maxZ);
+
+                // x / z is monotonic in z, so the extremes of the sphere's box are at the ends of the slice
+                const float minX = (std::min)((sphere.X - range) / sliceNearZ, (sphere.X - range) / sliceFarZ) / m_tanHalfFovX;
+                const float maxX = (std::max)((sphere.X + range) / sliceNearZ, (sphere.X + range) / sliceFarZ) / m_tanHalfFovX;
+                const float minY = (std::min)((sphere.Y - range) / sliceNearZ, (sphere.Y - range) / sliceFarZ) / m_tanHalfFovY;
+                const float maxY = (std::max)((sphere.Y + range) / sliceNearZ, (sphere.Y + range) / sliceFarZ) / m_tanHalfFovY;
+                if (maxX < -1.0f || minX > 1.0f || maxY < -1.0f || minY > 1.0f)
+                {
+                    continue;
+                }
+
+                // Tiles are counted from the top left corner, like SV_Position
+                auto toTile = [](float ndc, uint32_t uNumTiles)
+                {
+                    const float tile = (ndc * 0.5f + 0.5f) * static_cast<float>(uNumTiles);
+                    return static_cast<uint32_t>((std::min)((std::max)(tile, 0.0f), static_cast<float>(uNumTiles - 1u)));
+                };
+                LightSpan span =
+                {
+                    .uLight = uLight,
+                    .uSlice = uSlice,
+                    .uMinX = toTile(minX, NUM_CLUSTERS_X),
+                    .uMaxX = toTile(maxX, NUM_CLUSTERS_X),
+                    .uMinY = toTile(-maxY, NUM_CLUSTERS_Y),
+                    .uMaxY = toTile(-minY, NUM_CLUSTERS_Y),
+                };
+                m_aSpans.push_back(span);
+
+                for (uint32_t y = span.uMinY; y <= span.uMaxY; ++y)
+                {
+                    for (uint32_t x = span.uMinX; x <= span.uMaxX; ++x)
+                    {
+                        ++m_aClusters[(uSlice * NUM_CLUSTERS_Y + y) * NUM_CLUSTERS_X + x].Count;
+                    }
+                }
+            }
+
+            if (m_aSpans.size() > uNumSpans)
+            {
+                m_aVisibleLights.push_back(i);
+            }
+        }
+
+        // Prefix sum of the counts, clusters past the capacity of the index list lose their lights
+        uint32_t uOffset = 0u;
+        for (LightClusterRange& cluster : m_aClusters)
+        {
+            const uint32_t uCount = (std::min)(cluster.Count, MAX_LIGHT_INDICES - uOffset);
+            m_uNumDroppedLightIndices += cluster.Count - uCount;
+            cluster = LightClusterRange{ .Offset = uOffset, .Count = 0u };
+            uOffset += uCount;
+        }
+        m_aLightIndices.resize(uOffset);
+
+        for (const LightSpan& span : m_aSpans)
+        {
+            for (uint32_t y = span.uMinY; y <= span.uMaxY; ++y)
+            {
+                for (uint32_t x = span.uMinX; x <= span.uMaxX; ++x)
+                {
+                    const uint32_t uCluster = (span.uSlice * NUM_CLUSTERS_Y + y) * NUM_CLUSTERS_X + x;
+                    LightClusterRange& cluster = m_aClusters[uCluster];
+                    const uint32_t uEnd = uCluster + 1u < NUM_CLUSTERS ? m_aClusters[uCluster + 1u].Offset : uOffset;
+                    if (cluster.Offset + cluster.Count < uEnd)
+                    {
+                        m_aLightIndices[cluster.Offset + cluster.Count++] = span.uLight;
+                    }
+                }
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightBinner::GetNumVisibleLights
+
+      Summary:  Returns the number of lights kept by the last build
+
+      Returns:  uint32_t
+                  Number of lights in the compact list
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t LightBinner::GetNumVisibleLights() const
+    {
+        return static_cast<uint32_t>(m_aVisibleLights.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightBinner::GetVisibleLights
+
+      Summary:  Returns the compact light list of the last build, as
+                indices of the spheres given to Bin
+
+      Returns:  const uint32_t*
+                  Input index of each visible light
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const uint32_t* LightBinner::GetVisibleLights() const
+    {
+        return m_aVisibleLights.data();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightBinner::GetClusters
+
+      Summary:  Returns the range of the light index list of every
+                cluster, slice by slice, rows from the top
+
+      Returns:  const LightClusterRange*
+                  NUM_CLUSTERS ranges
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const LightClusterRange* LightBinner::GetClusters() const
+    {
+        return m_aClusters.data();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightBinner::GetNumLightIndices
+
+      Summary:  Returns the number of light indices of the last build
+
+      Returns:  uint32_t
+                  Size of the light index list
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t LightBinner::GetNumLightIndices() const
+    {
+        return static_cast<uint32_t>(m_aLightIndices.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightBinner::GetLightIndices
+
+      Summary:  Returns the light index list of the last build, whose
+                entries index the compact light list
+
+      Returns:  const uint32_t*
+                  Light index list
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const uint32_t* LightBinner::GetLightIndices() const
+    {
+        return m_aLightIndices.data();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightBinner::GetNumDroppedLightIndices
+
+      Summary:  Returns the number of light indices of the last build
+                that did not fit in MAX_LIGHT_INDICES
+
+      Returns:  uint32_t
+                  Number of dropped light indices
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t LightBinner::GetNumDroppedLightIndices() const
+    {
+        return m_uNumDroppedLightIndices;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightBinner::getSlice
+
+      Summary:  Returns the depth slice of a view space depth
+
+      Args:     float viewZ
+                  View space depth, between the near and far planes
+
+      Returns:  uint32_t
+                  Depth slice
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t LightBinner::getSlice(float viewZ) const
+    {
+        const float slice = logf(viewZ / m_nearZ) / logf(m_farZ / m_nearZ) * static_cast<float>(NUM_CLUSTERS_Z);
+
+        return static_cast<uint32_t>((std::min)((std::max)(slice, 0.0f), static_cast<float>(NUM_CLUSTERS_Z - 1u)));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightBinner::getSliceNear
+
+      Summary:  Returns the view space depth where a slice starts
+
+      Args:     uint32_t uSlice
+                  Depth slice, NUM_CLUSTERS_Z for the far plane
+
+      Returns:  float
+                  Near depth of the slice
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    float LightBinner::getSliceNear(uint32_t uSlice) const
+    {
+        return m_nearZ * powf(m_farZ / m_nearZ, static_cast<float>(uSlice) / static_cast<float>(NUM_CLUSTERS_Z));
+    }
+}
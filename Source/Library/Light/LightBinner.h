@@ -0,0 +1,129 @@
+/*+===================================================================
+  File:      LIGHTBINNER.H
+
+  Summary:   LightBinner header file contains declarations of
+             LightBinner class used for the lab samples of Game
+             Graphics Programming course. Only depends on the
+             standard library.
+
+  Classes: LightBinner
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+     Struct:   LightClusterRange
+     Summary:  Range of the light index list read by a cluster
+   S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct LightClusterRange
+    {
+        uint32_t Offset;
+        uint32_t Count;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+     Struct:   LightSphere
+     Summary:  Bounding sphere of a point light in view space, Range
+               being the distance past which it is culled
+   S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct LightSphere
+    {
+        float X;
+        float Y;
+        float Z;
+        float Range;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    LightBinner
+
+      Summary:  Bins light spheres into view space clusters: screen
+                tiles split into logarithmic depth slices. The lights
+                that reach the frustum are kept in a compact list, and
+                each cluster gets a range of an index list into it
+
+      Methods:  SetProjection
+                  Sets the projection the clusters are built for
+                Bin
+                  Bins the lights into the clusters
+                GetNumVisibleLights
+                  Returns the number of lights kept
+                GetVisibleLights
+                  Returns the input index of each light kept
+                GetClusters
+                  Returns the range of every cluster
+                GetNumLightIndices
+                  Returns the number of light indices written
+                GetLightIndices
+                  Returns the light index list
+                GetNumDroppedLightIndices
+                  Returns the number of light indices that did not fit
+                getSlice
+                  Returns the depth slice of a view space depth
+                getSliceNear
+                  Returns the depth where a slice starts
+                LightBinner
+                  Constructor.
+                ~LightBinner
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class LightBinner final
+    {
+    public:
+        static constexpr const uint32_t NUM_CLUSTERS_X = 16u;
+        static constexpr const uint32_t NUM_CLUSTERS_Y = 9u;
+        static constexpr const uint32_t NUM_CLUSTERS_Z = 24u;
+        static constexpr const uint32_t NUM_CLUSTERS = NUM_CLUSTERS_X * NUM_CLUSTERS_Y * NUM_CLUSTERS_Z;
+        static constexpr const uint32_t MAX_LIGHT_INDICES = NUM_CLUSTERS * 32u;
+        static constexpr const uint32_t MAX_VISIBLE_LIGHTS = 1024u;
+
+        LightBinner();
+        LightBinner(const LightBinner& other) = delete;
+        LightBinner(LightBinner&& other) = delete;
+        LightBinner& operator=(const LightBinner& other) = delete;
+        LightBinner& operator=(LightBinner&& other) = delete;
+        ~LightBinner() = default;
+
+        void SetProjection(float fovAngleY, uint32_t uWidth, uint32_t uHeight, float nearZ, float farZ);
+        void Bin(const LightSphere* aSpheres, uint32_t uNumSpheres);
+
+        uint32_t GetNumVisibleLights() const;
+        const uint32_t* GetVisibleLights() const;
+        const LightClusterRange* GetClusters() const;
+        uint32_t GetNumLightIndices() const;
+        const uint32_t* GetLightIndices() const;
+        uint32_t GetNumDroppedLightIndices() const;
+
+    private:
+        struct LightSpan
+        {
+            uint32_t uLight;
+            uint32_t uSlice;
+            uint32_t uMinX;
+            uint32_t uMaxX;
+            uint32_t uMinY;
+            uint32_t uMaxY;
+        };
+
+        uint32_t getSlice(float viewZ) const;
+        float getSliceNear(uint32_t uSlice) const;
+
+    private:
+        float m_tanHalfFovX;
+        float m_tanHalfFovY;
+        float m_nearZ;
+        float m_farZ;
+
+        std::vector<uint32_t> m_aVisibleLights;
+        std::vector<LightSpan> m_aSpans;
+        std::vector<LightClusterRange> m_aClusters;
+        std::vector<uint32_t> m_aLightIndices;
+        uint32_t m_uNumDroppedLightIndices;
+    };
+}
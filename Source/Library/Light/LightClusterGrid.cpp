@@ -0,0 +1,339 @@
+#include "Light/LightClusterGrid.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusterGrid::LightClusterGrid
+
+      Summary:  Constructor
+
+      Modifies: [m_lightBuffer, m_clusterBuffer, m_indexBuffer,
+                 m_cbLightClusters, m_lightBufferView,
+                 m_clusterBufferView, m_indexBufferView, m_cbData,
+                 m_binner, m_aSpheres, m_aLights].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    LightClusterGrid::LightClusterGrid()
+        : m_lightBuffer()
+        , m_clusterBuffer()
+        , m_indexBuffer()
+        , m_cbLightClusters()
+        , m_lightBufferView()
+        , m_clusterBufferView()
+        , m_indexBufferView()
+        , m_cbData()
+        , m_binner()
+        , m_aSpheres()
+        , m_aLights()
+    {
+        static_assert(LightBinner::MAX_VISIBLE_LIGHTS == MAX_NUM_LIGHTS, "The light buffer holds every light the binner keeps");
+        static_assert(sizeof(LightClusterRange) == 8u, "LightClusterRange must match the uint2 of the cluster buffer");
+
+        m_aLights.reserve(MAX_NUM_LIGHTS);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusterGrid::Initialize
+
+      Summary:  Creates the structured buffers of the lights, cluster
+                ranges and light indices, and the cluster constants
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers with
+
+      Modifies: [m_lightBuffer, m_clusterBuffer, m_indexBuffer,
+                 m_cbLightClusters, m_lightBufferView,
+                 m_clusterBufferView, m_indexBufferView].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT LightClusterGrid::Initialize(_In_ ID3D11Device* pDevice)
+    {
+        HRESULT hr = createStructuredBuffer(pDevice, sizeof(Lights), MAX_NUM_LIGHTS, m_lightBuffer, m_lightBufferView);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = createStructuredBuffer(pDevice, sizeof(LightClusterRange), NUM_CLUSTERS, m_clusterBuffer, m_clusterBufferView);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = createStructuredBuffer(pDevice, sizeof(UINT), MAX_LIGHT_INDICES, m_indexBuffer, m_indexBufferView);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        D3D11_BUFFER_DESC bd =
+        {
+            .ByteWidth = sizeof(CBLightClusters),
+            .Usage = D3D11_USAGE_DYNAMIC,
+            .BindFlags = D3D11_BIND_CONSTANT_BUFFER,
+            .CPUAccessFlags = D3D11_CPU_ACCESS_WRITE,
+            .MiscFlags = 0u,
+            .StructureByteStride = 0u
+        };
+
+        return pDevice->CreateBuffer(&bd, nullptr, m_cbLightClusters.GetAddressOf());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusterGrid::SetProjection
+
+      Summary:  Sets the perspective projection and the viewport the
+                clusters are built for
+
+      Args:     FLOAT fovAngleY
+                  Vertical field of view, in radians
+                UINT uWidth
+                  Width of the viewport in pixels
+                UINT uHeight
+                  Height of the viewport in pixels
+                FLOAT nearZ
+                  Distance to the near plane
+                FLOAT farZ
+                  Distance to the far plane
+
+      Modifies: [m_binner, m_cbData].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void LightClusterGrid::SetProjection(_In_ FLOAT fovAngleY, _In_ UINT uWidth, _In_ UINT uHeight, _In_ FLOAT nearZ, _In_ FLOAT farZ)
+    {
+        m_binner.SetProjection(fovAngleY, uWidth, uHeight, nearZ, farZ);
+
+        // slice = log(z) * scale - bias = log(z / near) / log(far / near) * NUM_CLUSTERS_Z
+        const FLOAT sliceScale = static_cast<FLOAT>(NUM_CLUSTERS_Z) / logf(farZ / nearZ);
+        m_cbData =
+        {
+            .ClusterScale = XMFLOAT4(
+                static_cast<FLOAT>(NUM_CLUSTERS_X) / static_cast<FLOAT>(uWidth),
+                static_cast<FLOAT>(NUM_CLUSTERS_Y) / static_cast<FLOAT>(uHeight),
+                sliceScale,
+                logf(nearZ) * sliceScale
+            ),
+            .ClusterCounts = XMUINT4(NUM_CLUSTERS_X, NUM_CLUSTERS_Y, NUM_CLUSTERS_Z, 0u)
+        };
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusterGrid::Build
+
+      Summary:  Moves the lights into view space and bins them. The
+                lights the binner keeps are copied into the compact
+                list the clusters index
+
+      Args:     const XMMATRIX& view
+                  View matrix of the camera
+                const Lights* aLights
+                  Lights in world space, AttenuationDistance.y being
+                  their range
+                UINT uNumLights
+                  Number of lights
+
+      Modifies: [m_cbData, m_binner, m_aSpheres, m_aLights].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void LightClusterGrid::Build(_In_ const XMMATRIX& view, _In_reads_(uNumLights) const Lights* aLights, _In_ UINT uNumLights)
+    {
+        m_aSpheres.resize(uNumLights);
+        for (UINT i = 0u; i < uNumLights; ++i)
+        {
+            const Lights& light = aLights[i];
+
+            XMFLOAT3 center;
+            XMStoreFloat3(&center, XMVector3TransformCoord(XMVectorSet(light.Position.x, light.Position.y, light.Position.z, 1.0f), view));
+            m_aSpheres[i] = LightSphere{ .X = center.x, .Y = center.y, .Z = center.z, .Range = light.AttenuationDistance.y };
+        }
+
+        m_binner.Bin(m_aSpheres.data(), uNumLights);
+
+        m_aLights.clear();
+        const UINT* auVisibleLights = m_binner.GetVisibleLights();
+        for (UINT i = 0u; i < m_binner.GetNumVisibleLights(); ++i)
+        {
+            m_aLights.push_back(aLights[auVisibleLights[i]]);
+        }
+
+        m_cbData.ClusterCounts.w = static_cast<UINT>(m_aLights.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusterGrid::Upload
+
+      Summary:  Copies the lists and the constants into the buffers.
+                Must be called before the draws that read them are
+                executed
+
+      Args:     ID3D11DeviceContext* pImmediateContext
+                  The immediate context
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT LightClusterGrid::Upload(_In_ ID3D11DeviceContext* pImmediateContext)
+    {
+        struct BufferUpload
+        {
+            ID3D11Buffer* pBuffer;
+            const void* pData;
+            size_t uDataSize;
+        };
+        const BufferUpload aUploads[] =
+        {
+            { m_lightBuffer.Get(), m_aLights.data(), m_aLights.size() * sizeof(Lights) },
+            { m_clusterBuffer.Get(), m_binner.GetClusters(), NUM_CLUSTERS * sizeof(LightClusterRange) },
+            { m_indexBuffer.Get(), m_binner.GetLightIndices(), m_binner.GetNumLightIndices() * sizeof(UINT) },
+            { m_cbLightClusters.Get(), &m_cbData, sizeof(m_cbData) },
+        };
+
+        for (const BufferUpload& upload : aUploads)
+        {
+            D3D11_MAPPED_SUBRESOURCE mappedResource = {};
+            HRESULT hr = pImmediateContext->Map(upload.pBuffer, 0u, D3D11_MAP_WRITE_DISCARD, 0u, &mappedResource);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            if (upload.uDataSize > 0u)
+            {
+                memcpy(mappedResource.pData, upload.pData, upload.uDataSize);
+            }
+            pImmediateContext->Unmap(upload.pBuffer, 0u);
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusterGrid::GetLightBufferView
+
+      Summary:  Returns the view of the compact light list
+
+      Returns:  ID3D11ShaderResourceView*
+                  StructuredBuffer<PointLight> view
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ID3D11ShaderResourceView* LightClusterGrid::GetLightBufferView() const
+    {
+        return m_lightBufferView.Get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusterGrid::GetClusterBufferView
+
+      Summary:  Returns the view of the cluster ranges
+
+      Returns:  ID3D11ShaderResourceView*
+                  StructuredBuffer<uint2> view
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ID3D11ShaderResourceView* LightClusterGrid::GetClusterBufferView() const
+    {
+        return m_clusterBufferView.Get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusterGrid::GetIndexBufferView
+
+      Summary:  Returns the view of the light index list
+
+      Returns:  ID3D11ShaderResourceView*
+                  StructuredBuffer<uint> view
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ID3D11ShaderResourceView* LightClusterGrid::GetIndexBufferView() const
+    {
+        return m_indexBufferView.Get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusterGrid::GetConstantBuffer
+
+      Summary:  Returns the cluster constants
+
+      Returns:  ID3D11Buffer*
+                  cbLightClusters buffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ID3D11Buffer* LightClusterGrid::GetConstantBuffer() const
+    {
+        return m_cbLightClusters.Get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusterGrid::GetNumVisibleLights
+
+      Summary:  Returns the number of lights kept by the last build
+
+      Returns:  UINT
+                  Number of lights in the compact list
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT LightClusterGrid::GetNumVisibleLights() const
+    {
+        return static_cast<UINT>(m_aLights.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusterGrid::GetNumLightIndices
+
+      Summary:  Returns the number of light indices of the last build
+
+      Returns:  UINT
+                  Size of the light index list
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT LightClusterGrid::GetNumLightIndices() const
+    {
+        return m_binner.GetNumLightIndices();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusterGrid::GetNumDroppedLightIndices
+
+      Summary:  Returns the number of light indices of the last build
+                that did not fit in MAX_LIGHT_INDICES
+
+      Returns:  UINT
+                  Number of dropped light indices
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT LightClusterGrid::GetNumDroppedLightIndices() const
+    {
+        return m_binner.GetNumDroppedLightIndices();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightClusterGrid::createStructuredBuffer
+
+      Summary:  Creates a dynamic structured buffer and its view
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffer with
+                UINT uStride
+                  Size of an element in bytes
+                UINT uNumElements
+                  Capacity of the buffer
+                ComPtr<ID3D11Buffer>& buffer
+                  Created buffer
+                ComPtr<ID3D11ShaderResourceView>& view
+                  Created view
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT LightClusterGrid::createStructuredBuffer(_In_ ID3D11Device* pDevice, _In_ UINT uStride, _In_ UINT uNumElements, _Out_ ComPtr<ID3D11Buffer>& buffer, _Out_ ComPtr<ID3D11ShaderResourceView>& view)
+    {
+        D3D11_BUFFER_DESC bd =
+        {
+            .ByteWidth = uStride * uNumElements,
+            .Usage = D3D11_USAGE_DYNAMIC,
+            .BindFlags = D3D11_BIND_SHADER_RESOURCE,
+            .CPUAccessFlags = D3D11_CPU_ACCESS_WRITE,
+            .MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED,
+            .StructureByteStride = uStride
+        };
+        HRESULT hr = pDevice->CreateBuffer(&bd, nullptr, buffer.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        return pDevice->CreateShaderResourceView(buffer.Get(), nullptr, view.GetAddressOf());
+    }
+}
@@ -0,0 +1,110 @@
+/*+===================================================================
+  File:      LIGHTCLUSTERGRID.H
+
+  Summary:   LightClusterGrid header file contains declarations of
+             LightClusterGrid class used for the lab samples of Game
+             Graphics Programming course.
+
+  Classes: LightClusterGrid
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Light/LightBinner.h"
+#include "Renderer/DataTypes.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    LightClusterGrid
+
+      Summary:  Bins point lights into view space clusters: screen
+                tiles split into logarithmic depth slices. Each cluster
+                gets a range of a compact light index list, so a pixel
+                only shades the lights whose range reaches its cluster.
+                The lists are built on the CPU by a LightBinner and
+                uploaded to structured buffers every frame
+
+      Methods:  Initialize
+                  Creates the buffers and their views
+                SetProjection
+                  Sets the projection the clusters are built for
+                Build
+                  Bins the lights into the clusters
+                Upload
+                  Copies the lists into the buffers
+                GetLightBufferView
+                  Returns the view of the compact light list
+                GetClusterBufferView
+                  Returns the view of the cluster ranges
+                GetIndexBufferView
+                  Returns the view of the light index list
+                GetConstantBuffer
+                  Returns the cluster constants
+                GetNumVisibleLights
+                  Returns the number of lights in the compact list
+                GetNumLightIndices
+                  Returns the number of light indices written
+                GetNumDroppedLightIndices
+                  Returns the number of light indices that did not fit
+                LightClusterGrid
+                  Constructor.
+                ~LightClusterGrid
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class LightClusterGrid final
+    {
+    public:
+        static constexpr const UINT NUM_CLUSTERS_X = LightBinner::NUM_CLUSTERS_X;
+        static constexpr const UINT NUM_CLUSTERS_Y = LightBinner::NUM_CLUSTERS_Y;
+        static constexpr const UINT NUM_CLUSTERS_Z = LightBinner::NUM_CLUSTERS_Z;
+        static constexpr const UINT NUM_CLUSTERS = LightBinner::NUM_CLUSTERS;
+        static constexpr const UINT MAX_LIGHT_INDICES = LightBinner::MAX_LIGHT_INDICES;
+
+        // Attenuation below which a light is culled, its range is the attenuation distance / sqrt(LIGHT_CUTOFF)
+        static constexpr const FLOAT LIGHT_CUTOFF = 1.0f / 256.0f;
+
+        LightClusterGrid();
+        LightClusterGrid(const LightClusterGrid& other) = delete;
+        LightClusterGrid(LightClusterGrid&& other) = delete;
+        LightClusterGrid& operator=(const LightClusterGrid& other) = delete;
+        LightClusterGrid& operator=(LightClusterGrid&& other) = delete;
+        ~LightClusterGrid() = default;
+
+        HRESULT Initialize(_In_ ID3D11Device* pDevice);
+        void SetProjection(_In_ FLOAT fovAngleY, _In_ UINT uWidth, _In_ UINT uHeight, _In_ FLOAT nearZ, _In_ FLOAT farZ);
+
+        void Build(_In_ const XMMATRIX& view, _In_reads_(uNumLights) const Lights* aLights, _In_ UINT uNumLights);
+        HRESULT Upload(_In_ ID3D11DeviceContext* pImmediateContext);
+
+        ID3D11ShaderResourceView* GetLightBufferView() const;
+        ID3D11ShaderResourceView* GetClusterBufferView() const;
+        ID3D11ShaderResourceView* GetIndexBufferView() const;
+        ID3D11Buffer* GetConstantBuffer() const;
+
+        UINT GetNumVisibleLights() const;
+        UINT GetNumLightIndices() const;
+        UINT GetNumDroppedLightIndices() const;
+
+    private:
+        HRESULT createStructuredBuffer(_In_ ID3D11Device* pDevice, _In_ UINT uStride, _In_ UINT uNumElements, _Out_ ComPtr<ID3D11Buffer>& buffer, _Out_ ComPtr<ID3D11ShaderResourceView>& view);
+
+    private:
+        ComPtr<ID3D11Buffer> m_lightBuffer;
+        ComPtr<ID3D11Buffer> m_clusterBuffer;
+        ComPtr<ID3D11Buffer> m_indexBuffer;
+        ComPtr<ID3D11Buffer> m_cbLightClusters;
+        ComPtr<ID3D11ShaderResourceView> m_lightBufferView;
+        ComPtr<ID3D11ShaderResourceView> m_clusterBufferView;
+        ComPtr<ID3D11ShaderResourceView> m_indexBufferView;
+
+        CBLightClusters m_cbData;
+
+        LightBinner m_binner;
+        std::vector<LightSphere> m_aSpheres;
+        std::vector<Lights> m_aLights;
+    };
+}
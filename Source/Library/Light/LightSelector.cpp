@@ -0,0 +1,182 @@
+#include "Light/LightSelector.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightSelector::LightSelector
+
+      Summary:  Constructor
+
+      Modifies: [m_aLightGroups, m_uNumLights].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    LightSelector::LightSelector()
+        : m_aLightGroups()
+        , m_uNumLights(0u)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightSelector::SetLights
+
+      Summary:  Transposes the lights into groups of four. The slots
+                past the last light get a negative squared range, so
+                no box ever reaches them
+
+      Args:     const Lights* aLights
+                  Lights in world space, AttenuationDistance.z and .w
+                  being the squared attenuation distance and range
+                UINT uNumLights
+                  Number of lights
+
+      Modifies: [m_aLightGroups, m_uNumLights].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void LightSelector::SetLights(_In_reads_(uNumLights) const Lights* aLights, _In_ UINT uNumLights)
+    {
+        m_uNumLights = uNumLights;
+        m_aLightGroups.resize((uNumLights + 3u) / 4u);
+
+        for (UINT uGroup = 0u; uGroup < m_aLightGroups.size(); ++uGroup)
+        {
+            XMFLOAT4A x(0.0f, 0.0f, 0.0f, 0.0f);
+            XMFLOAT4A y(0.0f, 0.0f, 0.0f, 0.0f);
+            XMFLOAT4A z(0.0f, 0.0f, 0.0f, 0.0f);
+            XMFLOAT4A rangeSquared(-1.0f, -1.0f, -1.0f, -1.0f);
+            XMFLOAT4A attenuationSquared(1.0f, 1.0f, 1.0f, 1.0f);
+            XMFLOAT4A intensity(0.0f, 0.0f, 0.0f, 0.0f);
+
+            FLOAT* aX = &x.x;
+            FLOAT* aY = &y.x;
+            FLOAT* aZ = &z.x;
+            FLOAT* aRangeSquared = &rangeSquared.x;
+            FLOAT* aAttenuationSquared = &attenuationSquared.x;
+            FLOAT* aIntensity = &intensity.x;
+            for (UINT uLane = 0u; uLane < 4u && uGroup * 4u + uLane < uNumLights; ++uLane)
+            {
+                const Lights& light = aLights[uGroup * 4u + uLane];
+                aX[uLane] = light.Position.x;
+                aY[uLane] = light.Position.y;
+                aZ[uLane] = light.Position.z;
+                aRangeSquared[uLane] = light.AttenuationDistance.w;
+                aAttenuationSquared[uLane] = (std::max)(light.AttenuationDistance.z, 1e-6f);
+                aIntensity[uLane] = 0.2126f * light.Color.x + 0.7152f * light.Color.y + 0.0722f * light.Color.z;
+            }
+
+            m_aLightGroups[uGroup] =
+            {
+                .X = XMLoadFloat4A(&x),
+                .Y = XMLoadFloat4A(&y),
+                .Z = XMLoadFloat4A(&z),
+                .RangeSquared = XMLoadFloat4A(&rangeSquared),
+                .AttenuationSquared = XMLoadFloat4A(&attenuationSquared),
+                .Intensity = XMLoadFloat4A(&intensity)
+            };
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightSelector::Select
+
+      Summary:  Tests every light against a box, four at a time, and
+                keeps the brightest of the lights that reach it. A
+                light is ranked by its luminance times its inverse
+                square attenuation at the point of the box closest to
+                it, which saturates inside the attenuation distance
+
+      Args:     const BoundingBox& bounds
+                  World space bounds of the object
+                UINT* auLights
+                  Indices of the selected lights, brightest first
+                UINT uMaxLights
+                  Maximum number of lights to select, at most
+                  MAX_NUM_OBJECT_LIGHTS
+
+      Returns:  UINT
+                  Number of lights selected
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT LightSelector::Select(_In_ const BoundingBox& bounds, _Out_writes_(uMaxLights) UINT* auLights, _In_ UINT uMaxLights) const
+    {
+        assert(uMaxLights <= MAX_NUM_OBJECT_LIGHTS);
+        if (uMaxLights == 0u)
+        {
+            return 0u;
+        }
+
+        const XMVECTOR center = XMLoadFloat3(&bounds.Center);
+        const XMVECTOR extents = XMLoadFloat3(&bounds.Extents);
+        const XMVECTOR boxMin = XMVectorSubtract(center, extents);
+        const XMVECTOR boxMax = XMVectorAdd(center, extents);
+        const XMVECTOR minX = XMVectorSplatX(boxMin);
+        const XMVECTOR minY = XMVectorSplatY(boxMin);
+        const XMVECTOR minZ = XMVectorSplatZ(boxMin);
+        const XMVECTOR maxX = XMVectorSplatX(boxMax);
+        const XMVECTOR maxY = XMVectorSplatY(boxMax);
+        const XMVECTOR maxZ = XMVectorSplatZ(boxMax);
+        const XMVECTOR zero = XMVectorZero();
+
+        FLOAT aBestScores[MAX_NUM_OBJECT_LIGHTS];
+        UINT uNumSelected = 0u;
+
+        for (UINT uGroup = 0u; uGroup < m_aLightGroups.size(); ++uGroup)
+        {
+            const LightGroup& group = m_aLightGroups[uGroup];
+
+            // Distance from each light to the closest point of the box, zero inside
+            const XMVECTOR dx = XMVectorMax(XMVectorMax(XMVectorSubtract(minX, group.X), XMVectorSubtract(group.X, maxX)), zero);
+            const XMVECTOR dy = XMVectorMax(XMVectorMax(XMVectorSubtract(minY, group.Y), XMVectorSubtract(group.Y, maxY)), zero);
+            const XMVECTOR dz = XMVectorMax(XMVectorMax(XMVectorSubtract(minZ, group.Z), XMVectorSubtract(group.Z, maxZ)), zero);
+            const XMVECTOR distanceSquared = XMVectorMultiplyAdd(dz, dz, XMVectorMultiplyAdd(dy, dy, XMVectorMultiply(dx, dx)));
+
+            const XMVECTOR inRange = XMVectorLessOrEqual(distanceSquared, group.RangeSquared);
+            if (XMVector4EqualInt(inRange, XMVectorFalseInt()))
+            {
+                continue;
+            }
+
+            const XMVECTOR score = XMVectorDivide(
+                XMVectorMultiply(group.Intensity, group.AttenuationSquared),
+                XMVectorMax(distanceSquared, group.AttenuationSquared)
+            );
+
+            XMFLOAT4A scores;
+            XMUINT4 mask;
+            XMStoreFloat4A(&scores, score);
+            XMStoreUInt4(&mask, inRange);
+
+            const FLOAT* aScores = &scores.x;
+            const UINT* auMask = &mask.x;
+            for (UINT uLane = 0u; uLane < 4u; ++uLane)
+            {
+                if (!auMask[uLane] || (uNumSelected == uMaxLights && aScores[uLane] <= aBestScores[uNumSelected - 1u]))
+                {
+                    continue;
+                }
+
+                // Insertion into the short sorted list, dropping the dimmest when it is full
+                UINT uSlot = uNumSelected < uMaxLights ? uNumSelected++ : uNumSelected - 1u;
+                while (uSlot > 0u && aBestScores[uSlot - 1u] < aScores[uLane])
+                {
+                    aBestScores[uSlot] = aBestScores[uSlot - 1u];
+                    auLights[uSlot] = auLights[uSlot - 1u];
+                    --uSlot;
+                }
+                aBestScores[uSlot] = aScores[uLane];
+                auLights[uSlot] = uGroup * 4u + uLane;
+            }
+        }
+
+        return uNumSelected;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   LightSelector::GetNumLights
+
+      Summary:  Returns the number of lights given to SetLights
+
+      Returns:  UINT
+                  Number of lights
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT LightSelector::GetNumLights() const
+    {
+        return m_uNumLights;
+    }
+}
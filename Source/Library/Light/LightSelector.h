@@ -0,0 +1,72 @@
+/*+===================================================================
+  File:      LIGHTSELECTOR.H
+
+  Summary:   LightSelector header file contains declarations of
+             LightSelector class used for the lab samples of Game
+             Graphics Programming course.
+
+  Classes: LightSelector
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/DataTypes.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    LightSelector
+
+      Summary:  Picks the lights of an object for forward shading. The
+                lights are stored four to a group, one component per
+                light, so a single SIMD sphere-box test checks four
+                lights against the bounds of an object. The lights
+                whose range reaches the box are ranked by their
+                attenuated brightness at the box, and the brightest
+                ones are kept
+
+      Methods:  SetLights
+                  Sets the lights to select from
+                Select
+                  Selects the brightest lights reaching a box
+                GetNumLights
+                  Returns the number of lights to select from
+                LightSelector
+                  Constructor.
+                ~LightSelector
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class LightSelector final
+    {
+    public:
+        LightSelector();
+        LightSelector(const LightSelector& other) = delete;
+        LightSelector(LightSelector&& other) = delete;
+        LightSelector& operator=(const LightSelector& other) = delete;
+        LightSelector& operator=(LightSelector&& other) = delete;
+        ~LightSelector() = default;
+
+        void SetLights(_In_reads_(uNumLights) const Lights* aLights, _In_ UINT uNumLights);
+        UINT Select(_In_ const BoundingBox& bounds, _Out_writes_(uMaxLights) UINT* auLights, _In_ UINT uMaxLights) const;
+
+        UINT GetNumLights() const;
+
+    private:
+        struct LightGroup
+        {
+            XMVECTOR X;
+            XMVECTOR Y;
+            XMVECTOR Z;
+            XMVECTOR RangeSquared;
+            XMVECTOR AttenuationSquared;
+            XMVECTOR Intensity;
+        };
+
+    private:
+        std::vector<LightGroup> m_aLightGroups;
+        UINT m_uNumLights;
+    };
+}
@@ -55,6 +55,9 @@ namespace library
     }
 
     std::unique_ptr<Assimp::Importer> Model::sm_pImporter = std::make_unique<Assimp::Importer>();
+    TextureLoader Model::sm_textureLoader;
+    TextureCache Model::sm_textureCache;
+    TextureStreamer Model::sm_textureStreamer;
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::Model
@@ -233,6 +236,50 @@ namespace library
     {
         return m_boneNameToIndexMap;
     }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::GetTextureCache
+
+      Summary:  Returns the cache the textures of every model are
+                loaded through, so materials sharing an image share
+                one texture
+
+      Returns:  TextureCache&
+                  Texture cache
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TextureCache& Model::GetTextureCache()
+    {
+        return sm_textureCache;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::GetTextureLoader
+
+      Summary:  Returns the loader decoding the textures of every model
+                in the background, to be updated every frame
+
+      Returns:  TextureLoader&
+                  Texture loader
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TextureLoader& Model::GetTextureLoader()
+    {
+        return sm_textureLoader;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::GetTextureStreamer
+
+      Summary:  Returns the streamer keeping the mips of the textures
+                of every model within a budget, to be requested while
+                rendering and updated every frame
+
+      Returns:  TextureStreamer&
+                  Texture streamer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TextureStreamer& Model::GetTextureStreamer()
+    {
+        return sm_textureStreamer;
+    }
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
        Method:   Model::countVerticesAndIndices
        Summary:  Fill the BasicMeshEntry information
@@ -258,6 +305,32 @@ namespace library
         }
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::findCookedTexture
+
+      Summary:  Returns the DDS file the TextureCooker wrote next to an
+                image, compressed with its mips, if there is one
+
+      Args:     const std::filesystem::path& filePath
+                  Path to the image
+
+      Returns:  std::filesystem::path
+                  Path to the cooked texture, or to the image
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::filesystem::path Model::findCookedTexture(_In_ const std::filesystem::path& filePath)
+    {
+        std::filesystem::path cookedPath = filePath;
+        cookedPath.replace_extension(L".dds");
+
+        std::error_code ec;
+        if (cookedPath != filePath && std::filesystem::is_regular_file(cookedPath, ec))
+        {
+            return cookedPath;
+        }
+
+        return filePath;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
         Method:   Model::findNodeAnimOrNull
         Summary:  Find the aiNodeAnim with the givne node name in the given animation
@@ -725,7 +798,7 @@ namespace library
     }
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
      Method:   Model::loadDiffuseTexture
-     Summary:  Load a diffuse texture from given path
+     Summary:  Queue a diffuse texture from given path to be loaded
      Args:     ID3D11Device* pDevice
                  The Direct3D device to create the buffers
                ID3D11DeviceContext* pImmediateContext
@@ -745,6 +818,9 @@ namespace library
         _In_ UINT uIndex
     )
     {
+        UNREFERENCED_PARAMETER(pDevice);
+        UNREFERENCED_PARAMETER(pImmediateContext);
+
         HRESULT hr = S_OK;
         m_aMaterials[uIndex]->pDiffuse = nullptr;
 
@@ -761,21 +837,11 @@ namespace library
                     szPath = szPath.substr(2ull, szPath.size() - 2ull);
                 }
 
-                std::filesystem::path fullPath = parentDirectory / szPath;
-
-                m_aMaterials[uIndex]->pDiffuse = std::make_shared<Texture>(fullPath);
-
-                hr = m_aMaterials[uIndex]->pDiffuse->Initialize(pDevice, pImmediateContext);
-                if (FAILED(hr))
-                {
-                    OutputDebugString(L"Error loading diffuse texture \"");
-                    OutputDebugString(fullPath.c_str());
-                    OutputDebugString(L"\"\n");
+                std::filesystem::path fullPath = findCookedTexture(parentDirectory / szPath);
 
-                    return hr;
-                }
+                m_aMaterials[uIndex]->pDiffuse = sm_textureCache.GetOrLoad(fullPath, eTextureSamplerType::TRILINEAR_WRAP, eTextureContent::COLOR, sm_textureLoader);
 
-                OutputDebugString(L"Loaded diffuse texture \"");
+                OutputDebugString(L"Queued diffuse texture \"");
                 OutputDebugString(fullPath.c_str());
                 OutputDebugString(L"\"\n");
             }
@@ -785,7 +851,7 @@ namespace library
     }
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
        Method:   Model::loadSpecularTexture
-       Summary:  Load a specular texture from given path
+       Summary:  Queue a specular texture from given path to be loaded
        Args:     ID3D11Device* pDevice
                    The Direct3D device to create the buffers
                  ID3D11DeviceContext* pImmediateContext
@@ -805,6 +871,9 @@ namespace library
         _In_ UINT uIndex
     )
     {
+        UNREFERENCED_PARAMETER(pDevice);
+        UNREFERENCED_PARAMETER(pImmediateContext);
+
         HRESULT hr = S_OK;
         m_aMaterials[uIndex]->pSpecularExponent = nullptr;
 
@@ -821,21 +890,11 @@ namespace library
                     szPath = szPath.substr(2ull, szPath.size() - 2ull);
                 }
 
-                std::filesystem::path fullPath = parentDirectory / szPath;
-
-                m_aMaterials[uIndex]->pSpecularExponent = std::make_shared<Texture>(fullPath);
-
-                hr = m_aMaterials[uIndex]->pSpecularExponent->Initialize(pDevice, pImmediateContext);
-                if (FAILED(hr))
-                {
-                    OutputDebugString(L"Error loading specular texture \"");
-                    OutputDebugString(fullPath.c_str());
-                    OutputDebugString(L"\"\n");
+                std::filesystem::path fullPath = findCookedTexture(parentDirectory / szPath);
 
-                    return hr;
-                }
+                m_aMaterials[uIndex]->pSpecularExponent = sm_textureCache.GetOrLoad(fullPath, eTextureSamplerType::TRILINEAR_WRAP, eTextureContent::DATA, sm_textureLoader);
 
-                OutputDebugString(L"Loaded specular texture \"");
+                OutputDebugString(L"Queued specular texture \"");
                 OutputDebugString(fullPath.c_str());
                 OutputDebugString(L"\"\n");
             }
@@ -846,7 +905,7 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::loadNormalTexture
 
-      Summary:  Load a normal texture from given path
+      Summary:  Queue a normal texture from given path to be loaded
 
       Args:     ID3D11Device* pDevice
                   The Direct3D device to create the buffers
@@ -861,6 +920,9 @@ namespace library
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT Model::loadNormalTexture(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext, _In_ const std::filesystem::path& parentDirectory, _In_ const aiMaterial* pMaterial, _In_ UINT uIndex)
     {
+        UNREFERENCED_PARAMETER(pDevice);
+        UNREFERENCED_PARAMETER(pImmediateContext);
+
         HRESULT hr = S_OK;
         m_aMaterials[uIndex]->pNormal = nullptr;
 
@@ -877,21 +939,12 @@ namespace library
                     szPath = szPath.substr(2ull, szPath.size() - 2ull);
                 }
 
-                std::filesystem::path fullPath = parentDirectory / szPath;
+                std::filesystem::path fullPath = findCookedTexture(parentDirectory / szPath);
 
-                m_aMaterials[uIndex]->pNormal = std::make_shared<Texture>(fullPath);
+                m_aMaterials[uIndex]->pNormal = sm_textureCache.GetOrLoad(fullPath, eTextureSamplerType::TRILINEAR_WRAP, eTextureContent::NORMAL, sm_textureLoader);
                 m_bHasNormalMap = true;
 
-                if (FAILED(hr))
-                {
-                    OutputDebugString(L"Error loading normal texture \"");
-                    OutputDebugString(fullPath.c_str());
-                    OutputDebugString(L"\"\n");
-
-                    return hr;
-                }
-
-                OutputDebugString(L"Loaded normal texture \"");
+                OutputDebugString(L"Queued normal texture \"");
                 OutputDebugString(fullPath.c_str());
                 OutputDebugString(L"\"\n");
             }
@@ -17,6 +17,8 @@
 #include "Shader/PixelShader.h"
 #include "Shader/VertexShader.h"
 #include "Texture/Material.h"
+#include "Texture/TextureCache.h"
+#include "Texture/TextureStreamer.h"
 
 struct aiScene;
 struct aiMesh;
@@ -57,6 +59,12 @@ namespace library
                 GetNumIndices
                   Pure virtual function that returns the number of
                   indices
+                GetTextureCache
+                  Returns the textures shared by every model
+                GetTextureLoader
+                  Returns the loader of the textures of every model
+                GetTextureStreamer
+                  Returns the streamer of the textures of every model
                 Model
                   Constructor.
                 ~Model
@@ -85,6 +93,10 @@ namespace library
         std::vector<XMMATRIX>& GetBoneTransforms();
         const std::unordered_map<std::string, UINT>& GetBoneNameToIndexMap() const;
 
+        static TextureCache& GetTextureCache();
+        static TextureLoader& GetTextureLoader();
+        static TextureStreamer& GetTextureStreamer();
+
     protected:
         struct VertexBoneData
         {
@@ -130,6 +142,7 @@ namespace library
         };
 
         void countVerticesAndIndices(_Inout_ UINT& uOutNumVertices, _Inout_ UINT& uOutNumIndices, _In_ const aiScene* pScene);
+        static std::filesystem::path findCookedTexture(_In_ const std::filesystem::path& filePath);
         const aiNodeAnim* findNodeAnimOrNull(_In_ const aiAnimation* pAnimation, _In_ PCSTR pszNodeName);
         UINT findPosition(_In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
         UINT findRotation(_In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
@@ -189,6 +202,9 @@ namespace library
 
     protected:
         static std::unique_ptr<Assimp::Importer> sm_pImporter;
+        static TextureLoader sm_textureLoader;
+        static TextureCache sm_textureCache;
+        static TextureStreamer sm_textureStreamer;
 
     protected:
         std::filesystem::path m_filePath;
@@ -0,0 +1,312 @@
+#include "Renderer/CommandList.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandList::CommandList
+
+      Summary:  Constructor
+
+      Modifies: [m_aArena, m_uSize, m_uNumCommands].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    CommandList::CommandList()
+        : m_aArena()
+        , m_uSize(0u)
+        , m_uNumCommands(0u)
+    {
+    }
+
+    void CommandList::ClearRenderTargetView(ID3D11RenderTargetView* pRenderTargetView, const float aColor[4])
+    {
+        CommandPacket& packet = allocatePacket(eCommandType::CLEAR_RENDER_TARGET_VIEW, 0u);
+        packet.pObject = pRenderTargetView;
+        for (uint32_t i = 0u; i < 4u; ++i)
+        {
+            packet.afArgs[i] = aColor[i];
+        }
+    }
+
+    void CommandList::ClearDepthStencilView(ID3D11DepthStencilView* pDepthStencilView, uint32_t uClearFlags, float depth, uint8_t uStencil)
+    {
+        CommandPacket& packet = allocatePacket(eCommandType::CLEAR_DEPTH_STENCIL_VIEW, 0u);
+        packet.pObject = pDepthStencilView;
+        packet.auArgs[0] = uClearFlags;
+        packet.afArgs[1] = depth;
+        packet.auArgs[2] = uStencil;
+    }
+
+    void CommandList::UpdateBuffer(ID3D11Buffer* pBuffer, const void* pData, uint32_t uDataSize)
+    {
+        CommandPacket& packet = allocatePacket(eCommandType::UPDATE_BUFFER, uDataSize);
+        packet.pObject = pBuffer;
+        memcpy(&packet + 1, pData, uDataSize);
+    }
+
+    void CommandList::CopySubresource(ID3D11Resource* pDstResource, uint32_t uDstSubresource, ID3D11Resource* pSrcResource, uint32_t uSrcSubresource)
+    {
+        CommandPacket& packet = allocatePacket(eCommandType::COPY_SUBRESOURCE, sizeof(ID3D11Resource*));
+        packet.pObject = pDstResource;
+        packet.auArgs[0] = uDstSubresource;
+        packet.auArgs[1] = uSrcSubresource;
+        memcpy(&packet + 1, &pSrcResource, sizeof(ID3D11Resource*));
+    }
+
+    void CommandList::SetRenderTargets(ID3D11RenderTargetView* pRenderTargetView, ID3D11DepthStencilView* pDepthStencilView)
+    {
+        CommandPacket& packet = allocatePacket(eCommandType::SET_RENDER_TARGETS, sizeof(ID3D11DepthStencilView*));
+        packet.pObject = pRenderTargetView;
+        memcpy(&packet + 1, &pDepthStencilView, sizeof(ID3D11DepthStencilView*));
+    }
+
+    void CommandList::SetViewport(const Viewport& viewport)
+    {
+        CommandPacket& packet = allocatePacket(eCommandType::SET_VIEWPORT, sizeof(Viewport));
+        memcpy(&packet + 1, &viewport, sizeof(Viewport));
+    }
+
+    void CommandList::SetInputLayout(ID3D11InputLayout* pInputLayout)
+    {
+        allocatePacket(eCommandType::SET_INPUT_LAYOUT, 0u).pObject = pInputLayout;
+    }
+
+    void CommandList::SetPrimitiveTopology(uint32_t uTopology)
+    {
+        allocatePacket(eCommandType::SET_PRIMITIVE_TOPOLOGY, 0u).auArgs[0] = uTopology;
+    }
+
+    void CommandList::SetVertexBuffer(uint32_t uSlot, ID3D11Buffer* pBuffer, uint32_t uStride, uint32_t uOffset)
+    {
+        CommandPacket& packet = allocatePacket(eCommandType::SET_VERTEX_BUFFER, 0u);
+        packet.uSlot = uSlot;
+        packet.pObject = pBuffer;
+        packet.auArgs[0] = uStride;
+        packet.auArgs[1] = uOffset;
+    }
+
+    void CommandList::SetIndexBuffer(ID3D11Buffer* pBuffer, uint32_t uFormat)
+    {
+        CommandPacket& packet = allocatePacket(eCommandType::SET_INDEX_BUFFER, 0u);
+        packet.pObject = pBuffer;
+        packet.auArgs[0] = uFormat;
+    }
+
+    void CommandList::SetVertexShader(ID3D11VertexShader* pVertexShader)
+    {
+        allocatePacket(eCommandType::SET_VERTEX_SHADER, 0u).pObject = pVertexShader;
+    }
+
+    void CommandList::SetPixelShader(ID3D11PixelShader* pPixelShader)
+    {
+        allocatePacket(eCommandType::SET_PIXEL_SHADER, 0u).pObject = pPixelShader;
+    }
+
+    void CommandList::SetVSConstantBuffer(uint32_t uSlot, ID3D11Buffer* pBuffer, uint32_t uFirstConstant, uint32_t uNumConstants)
+    {
+        CommandPacket& packet = allocatePacket(eCommandType::SET_VS_CONSTANT_BUFFER, 0u);
+        packet.uSlot = uSlot;
+        packet.pObject = pBuffer;
+        packet.auArgs[0] = uFirstConstant;
+        packet.auArgs[1] = uNumConstants;
+    }
+
+    void CommandList::SetPSConstantBuffer(uint32_t uSlot, ID3D11Buffer* pBuffer, uint32_t uFirstConstant, uint32_t uNumConstants)
+    {
+        CommandPacket& packet = allocatePacket(eCommandType::SET_PS_CONSTANT_BUFFER, 0u);
+        packet.uSlot = uSlot;
+        packet.pObject = pBuffer;
+        packet.auArgs[0] = uFirstConstant;
+        packet.auArgs[1] = uNumConstants;
+    }
+
+    void CommandList::SetPSShaderResource(uint32_t uSlot, ID3D11ShaderResourceView* pShaderResourceView)
+    {
+        CommandPacket& packet = allocatePacket(eCommandType::SET_PS_SHADER_RESOURCE, 0u);
+        packet.uSlot = uSlot;
+        packet.pObject = pShaderResourceView;
+    }
+
+    void CommandList::SetPSSampler(uint32_t uSlot, ID3D11SamplerState* pSampler)
+    {
+        CommandPacket& packet = allocatePacket(eCommandType::SET_PS_SAMPLER, 0u);
+        packet.uSlot = uSlot;
+        packet.pObject = pSampler;
+    }
+
+    void CommandList::DrawIndexed(uint32_t uNumIndices, uint32_t uStartIndex, int32_t iBaseVertex)
+    {
+        CommandPacket& packet = allocatePacket(eCommandType::DRAW_INDEXED, 0u);
+        packet.auArgs[0] = uNumIndices;
+        packet.auArgs[2] = uStartIndex;
+        packet.aiArgs[3] = iBaseVertex;
+    }
+
+    void CommandList::DrawIndexedInstanced(uint32_t uNumIndices, uint32_t uNumInstances, uint32_t uStartIndex, int32_t iBaseVertex, uint32_t uStartInstance)
+    {
+        CommandPacket& packet = allocatePacket(eCommandType::DRAW_INDEXED_INSTANCED, 0u);
+        packet.auArgs[0] = uNumIndices;
+        packet.auArgs[1] = uNumInstances;
+        packet.auArgs[2] = uStartIndex;
+        packet.aiArgs[3] = iBaseVertex;
+        packet.auArgs[4] = uStartInstance;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandList::Reset
+
+      Summary:  Discards the recorded commands, keeping the arena
+
+      Modifies: [m_uSize, m_uNumCommands].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandList::Reset()
+    {
+        m_uSize = 0u;
+        m_uNumCommands = 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandList::Execute
+
+      Summary:  Replays the recorded commands in order
+
+      Args:     IRenderContext& renderContext
+                  Render context to replay the commands on
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandList::Execute(IRenderContext& renderContext) const
+    {
+        size_t uOffset = 0u;
+        while (uOffset < m_uSize)
+        {
+            const CommandPacket& packet = *reinterpret_cast<const CommandPacket*>(m_aArena.data() + uOffset);
+
+            switch (packet.eType)
+            {
+            case eCommandType::CLEAR_RENDER_TARGET_VIEW:
+                renderContext.ClearRenderTargetView(static_cast<ID3D11RenderTargetView*>(packet.pObject), packet.afArgs);
+                break;
+            case eCommandType::CLEAR_DEPTH_STENCIL_VIEW:
+                renderContext.ClearDepthStencilView(static_cast<ID3D11DepthStencilView*>(packet.pObject), packet.auArgs[0], packet.afArgs[1], static_cast<uint8_t>(packet.auArgs[2]));
+                break;
+            case eCommandType::UPDATE_BUFFER:
+                renderContext.UpdateBuffer(static_cast<ID3D11Buffer*>(packet.pObject), &packet + 1, packet.uPayloadSize);
+                break;
+            case eCommandType::COPY_SUBRESOURCE:
+                renderContext.CopySubresource(static_cast<ID3D11Resource*>(packet.pObject), packet.auArgs[0], *reinterpret_cast<ID3D11Resource* const*>(&packet + 1), packet.auArgs[1]);
+                break;
+            case eCommandType::SET_RENDER_TARGETS:
+                renderContext.SetRenderTargets(static_cast<ID3D11RenderTargetView*>(packet.pObject), *reinterpret_cast<ID3D11DepthStencilView* const*>(&packet + 1));
+                break;
+            case eCommandType::SET_VIEWPORT:
+                renderContext.SetViewport(*reinterpret_cast<const Viewport*>(&packet + 1));
+                break;
+            case eCommandType::SET_INPUT_LAYOUT:
+                renderContext.SetInputLayout(static_cast<ID3D11InputLayout*>(packet.pObject));
+                break;
+            case eCommandType::SET_PRIMITIVE_TOPOLOGY:
+                renderContext.SetPrimitiveTopology(packet.auArgs[0]);
+                break;
+            case eCommandType::SET_VERTEX_BUFFER:
+                renderContext.SetVertexBuffer(packet.uSlot, static_cast<ID3D11Buffer*>(packet.pObject), packet.auArgs[0], packet.auArgs[1]);
+                break;
+            case eCommandType::SET_INDEX_BUFFER:
+                renderContext.SetIndexBuffer(static_cast<ID3D11Buffer*>(packet.pObject), packet.auArgs[0]);
+                break;
+            case eCommandType::SET_VERTEX_SHADER:
+                renderContext.SetVertexShader(static_cast<ID3D11VertexShader*>(packet.pObject));
+                break;
+            case eCommandType::SET_PIXEL_SHADER:
+                renderContext.SetPixelShader(static_cast<ID3D11PixelShader*>(packet.pObject));
+                break;
+            case eCommandType::SET_VS_CONSTANT_BUFFER:
+                renderContext.SetVSConstantBuffer(packet.uSlot, static_cast<ID3D11Buffer*>(packet.pObject), packet.auArgs[0], packet.auArgs[1]);
+                break;
+            case eCommandType::SET_PS_CONSTANT_BUFFER:
+                renderContext.SetPSConstantBuffer(packet.uSlot, static_cast<ID3D11Buffer*>(packet.pObject), packet.auArgs[0], packet.auArgs[1]);
+                break;
+            case eCommandType::SET_PS_SHADER_RESOURCE:
+                renderContext.SetPSShaderResource(packet.uSlot, static_cast<ID3D11ShaderResourceView*>(packet.pObject));
+                break;
+            case eCommandType::SET_PS_SAMPLER:
+                renderContext.SetPSSampler(packet.uSlot, static_cast<ID3D11SamplerState*>(packet.pObject));
+                break;
+            case eCommandType::DRAW_INDEXED:
+                renderContext.DrawIndexed(packet.auArgs[0], packet.auArgs[2], packet.aiArgs[3]);
+                break;
+            case eCommandType::DRAW_INDEXED_INSTANCED:
+                renderContext.DrawIndexedInstanced(packet.auArgs[0], packet.auArgs[1], packet.auArgs[2], packet.aiArgs[3], packet.auArgs[4]);
+                break;
+            default:
+                assert(false);
+                break;
+            }
+
+            uOffset += (sizeof(CommandPacket) + packet.uPayloadSize + PACKET_ALIGNMENT - 1u) & ~(PACKET_ALIGNMENT - 1u);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandList::GetNumCommands
+
+      Summary:  Returns the number of recorded commands
+
+      Returns:  uint32_t
+                  Number of commands since the last Reset
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t CommandList::GetNumCommands() const
+    {
+        return m_uNumCommands;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandList::GetSize
+
+      Summary:  Returns the number of bytes used in the arena
+
+      Returns:  size_t
+                  Size of the recorded commands in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    size_t CommandList::GetSize() const
+    {
+        return m_uSize;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandList::allocatePacket
+
+      Summary:  Bumps the arena for a packet and its payload. The arena
+                doubles when it is full. The returned reference is
+                only valid until the next allocation
+
+      Args:     eCommandType eType
+                  Type of the command
+                uint32_t uPayloadSize
+                  Number of bytes following the packet
+
+      Modifies: [m_aArena, m_uSize, m_uNumCommands].
+
+      Returns:  CommandPacket&
+                  Zeroed packet with its type and payload size set
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    CommandPacket& CommandList::allocatePacket(eCommandType eType, uint32_t uPayloadSize)
+    {
+        const size_t uAllocationSize = (sizeof(CommandPacket) + uPayloadSize + PACKET_ALIGNMENT - 1u) & ~(PACKET_ALIGNMENT - 1u);
+
+        if (m_uSize + uAllocationSize > m_aArena.size())
+        {
+            m_aArena.resize((std::max)(m_aArena.size() * 2u, m_uSize + uAllocationSize));
+        }
+
+        CommandPacket& packet = *reinterpret_cast<CommandPacket*>(m_aArena.data() + m_uSize);
+        packet = {};
+        packet.eType = eType;
+        packet.uPayloadSize = uPayloadSize;
+
+        m_uSize += uAllocationSize;
+        ++m_uNumCommands;
+
+        return packet;
+    }
+}
@@ -0,0 +1,162 @@
+/*+===================================================================
+  File:      COMMANDLIST.H
+
+  Summary:   CommandList header file contains declarations of
+             CommandList class used for the lab samples of Game
+             Graphics Programming course. Only depends on the standard
+             library.
+
+  Classes: CommandList
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Renderer/RenderContext.h"
+
+namespace library
+{
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+      Enum:     eCommandType
+
+      Summary:  Enumeration of the recorded commands, one per
+                IRenderContext method
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eCommandType : uint32_t
+    {
+        CLEAR_RENDER_TARGET_VIEW,
+        CLEAR_DEPTH_STENCIL_VIEW,
+        UPDATE_BUFFER,
+        COPY_SUBRESOURCE,
+        SET_RENDER_TARGETS,
+        SET_VIEWPORT,
+        SET_INPUT_LAYOUT,
+        SET_PRIMITIVE_TOPOLOGY,
+        SET_VERTEX_BUFFER,
+        SET_INDEX_BUFFER,
+        SET_VERTEX_SHADER,
+        SET_PIXEL_SHADER,
+        SET_VS_CONSTANT_BUFFER,
+        SET_PS_CONSTANT_BUFFER,
+        SET_PS_SHADER_RESOURCE,
+        SET_PS_SAMPLER,
+        DRAW_INDEXED,
+        DRAW_INDEXED_INSTANCED,
+        COUNT,
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   CommandPacket
+
+      Summary:  POD header of a recorded command. Buffer updates are
+                followed by uPayloadSize bytes of data in the arena,
+                copies by the source resource, render target bindings
+                by the depth stencil view and viewports by the
+                Viewport
+
+                Arguments by command:
+                  CLEAR_RENDER_TARGET_VIEW  afArgs[0..3] color
+                  CLEAR_DEPTH_STENCIL_VIEW  auArgs[0] flags,
+                                            afArgs[1] depth,
+                                            auArgs[2] stencil
+                  COPY_SUBRESOURCE          auArgs[0] destination,
+                                            auArgs[1] source
+                                            subresource
+                  SET_PRIMITIVE_TOPOLOGY    auArgs[0] topology
+                  SET_VERTEX_BUFFER         auArgs[0] stride,
+                                            auArgs[1] offset
+                  SET_*S_CONSTANT_BUFFER    auArgs[0] first constant,
+                                            auArgs[1] constants
+                  SET_INDEX_BUFFER          auArgs[0] format
+                  DRAW_INDEXED(_INSTANCED)  auArgs[0] indices,
+                                            auArgs[1] instances,
+                                            auArgs[2] start index,
+                                            aiArgs[3] base vertex,
+                                            auArgs[4] start instance
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct CommandPacket
+    {
+        eCommandType eType;
+        uint32_t uSlot;
+        void* pObject;
+        union
+        {
+            uint32_t auArgs[5];
+            int32_t aiArgs[5];
+            float afArgs[5];
+        };
+        uint32_t uPayloadSize;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    CommandList
+
+      Summary:  Records every IRenderContext call as a POD packet in a
+                linear arena and replays them in order on another
+                render context. Reset keeps the arena allocation, so a
+                list recorded every frame stops allocating once it has
+                grown to the size of a frame
+
+      Methods:  Reset
+                  Discards the recorded commands
+                Execute
+                  Replays the recorded commands
+                GetNumCommands
+                  Returns the number of recorded commands
+                GetSize
+                  Returns the number of bytes used in the arena
+                CommandList
+                  Constructor.
+                ~CommandList
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class CommandList final : public IRenderContext
+    {
+    public:
+        static constexpr const size_t PACKET_ALIGNMENT = 16u;
+
+        CommandList();
+        CommandList(const CommandList& other) = delete;
+        CommandList(CommandList&& other) = delete;
+        CommandList& operator=(const CommandList& other) = delete;
+        CommandList& operator=(CommandList&& other) = delete;
+        ~CommandList() = default;
+
+        void ClearRenderTargetView(ID3D11RenderTargetView* pRenderTargetView, const float aColor[4]) override;
+        void ClearDepthStencilView(ID3D11DepthStencilView* pDepthStencilView, uint32_t uClearFlags, float depth, uint8_t uStencil) override;
+        void UpdateBuffer(ID3D11Buffer* pBuffer, const void* pData, uint32_t uDataSize) override;
+        void CopySubresource(ID3D11Resource* pDstResource, uint32_t uDstSubresource, ID3D11Resource* pSrcResource, uint32_t uSrcSubresource) override;
+        void SetRenderTargets(ID3D11RenderTargetView* pRenderTargetView, ID3D11DepthStencilView* pDepthStencilView) override;
+        void SetViewport(const Viewport& viewport) override;
+        void SetInputLayout(ID3D11InputLayout* pInputLayout) override;
+        void SetPrimitiveTopology(uint32_t uTopology) override;
+        void SetVertexBuffer(uint32_t uSlot, ID3D11Buffer* pBuffer, uint32_t uStride, uint32_t uOffset) override;
+        void SetIndexBuffer(ID3D11Buffer* pBuffer, uint32_t uFormat) override;
+        void SetVertexShader(ID3D11VertexShader* pVertexShader) override;
+        void SetPixelShader(ID3D11PixelShader* pPixelShader) override;
+        void SetVSConstantBuffer(uint32_t uSlot, ID3D11Buffer* pBuffer, uint32_t uFirstConstant, uint32_t uNumConstants) override;
+        void SetPSConstantBuffer(uint32_t uSlot, ID3D11Buffer* pBuffer, uint32_t uFirstConstant, uint32_t uNumConstants) override;
+        void SetPSShaderResource(uint32_t uSlot, ID3D11ShaderResourceView* pShaderResourceView) override;
+        void SetPSSampler(uint32_t uSlot, ID3D11SamplerState* pSampler) override;
+        void DrawIndexed(uint32_t uNumIndices, uint32_t uStartIndex, int32_t iBaseVertex) override;
+        void DrawIndexedInstanced(uint32_t uNumIndices, uint32_t uNumInstances, uint32_t uStartIndex, int32_t iBaseVertex, uint32_t uStartInstance) override;
+
+        void Reset();
+        void Execute(IRenderContext& renderContext) const;
+
+        uint32_t GetNumCommands() const;
+        size_t GetSize() const;
+
+    private:
+        CommandPacket& allocatePacket(eCommandType eType, uint32_t uPayloadSize);
+
+    private:
+        std::vector<uint8_t> m_aArena;
+        size_t m_uSize;
+        uint32_t m_uNumCommands;
+    };
+}
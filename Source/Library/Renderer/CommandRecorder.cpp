@@ -0,0 +1,103 @@
+#include "Renderer/CommandRecorder.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandListRecorder::CommandListRecorder
+
+      Summary:  Constructor
+
+      Args:     uint32_t uNumContexts
+                  Number of command lists
+                IRenderContext* pTargetContext
+                  Render context the command lists are replayed on
+
+      Modifies: [m_aCommandLists, m_pTargetContext].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    CommandListRecorder::CommandListRecorder(uint32_t uNumContexts, IRenderContext* pTargetContext)
+        : m_aCommandLists()
+        , m_pTargetContext(pTargetContext)
+    {
+        m_aCommandLists.reserve(uNumContexts);
+        for (uint32_t i = 0u; i < uNumContexts; ++i)
+        {
+            m_aCommandLists.push_back(std::make_unique<CommandList>());
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandListRecorder::GetNumContexts
+
+      Summary:  Returns the number of command lists
+
+      Returns:  uint32_t
+                  Number of command lists
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t CommandListRecorder::GetNumContexts() const
+    {
+        return static_cast<uint32_t>(m_aCommandLists.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandListRecorder::BeginRecording
+
+      Summary:  Resets a command list
+
+      Args:     uint32_t uContextIdx
+                  Index of the command list
+
+      Returns:  IRenderContext&
+                  Command list to record into
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    IRenderContext& CommandListRecorder::BeginRecording(uint32_t uContextIdx)
+    {
+        m_aCommandLists[uContextIdx]->Reset();
+        return *m_aCommandLists[uContextIdx];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandListRecorder::FinishRecording
+
+      Summary:  Command lists need no closing
+
+      Args:     uint32_t uContextIdx
+                  Index of the command list
+
+      Returns:  bool
+                  Always true
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    bool CommandListRecorder::FinishRecording(uint32_t uContextIdx)
+    {
+        static_cast<void>(uContextIdx);
+        return true;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandListRecorder::ExecuteRecorded
+
+      Summary:  Replays a command list on the target context
+
+      Args:     uint32_t uContextIdx
+                  Index of the command list
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void CommandListRecorder::ExecuteRecorded(uint32_t uContextIdx)
+    {
+        m_aCommandLists[uContextIdx]->Execute(*m_pTargetContext);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CommandListRecorder::GetCommandList
+
+      Summary:  Returns a command list
+
+      Args:     uint32_t uContextIdx
+                  Index of the command list
+
+      Returns:  const CommandList&
+                  Command list
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const CommandList& CommandListRecorder::GetCommandList(uint32_t uContextIdx) const
+    {
+        return *m_aCommandLists[uContextIdx];
+    }
+}
@@ -0,0 +1,101 @@
+/*+===================================================================
+  File:      COMMANDRECORDER.H
+
+  Summary:   CommandRecorder header file contains declarations of
+             ICommandRecorder interface and CommandListRecorder class
+             used for the lab samples of Game Graphics Programming
+             course. Only depends on the standard library.
+
+  Classes: ICommandRecorder, CommandListRecorder
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Renderer/CommandList.h"
+#include "Renderer/RenderContext.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ICommandRecorder
+
+      Summary:  Interface of a set of render contexts that can record
+                at the same time, one per thread, and be executed in
+                order afterwards
+
+      Methods:  GetNumContexts
+                  Returns the number of recording contexts
+                BeginRecording
+                  Starts recording on a context
+                FinishRecording
+                  Closes the recording of a context
+                ExecuteRecorded
+                  Executes what a context recorded
+                ~ICommandRecorder
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ICommandRecorder
+    {
+    public:
+        virtual ~ICommandRecorder() = default;
+
+        virtual uint32_t GetNumContexts() const = 0;
+
+        // Called on the recording thread, each context by one thread at a time
+        virtual IRenderContext& BeginRecording(uint32_t uContextIdx) = 0;
+        virtual bool FinishRecording(uint32_t uContextIdx) = 0;
+
+        // Called on the rendering thread once every context has finished
+        virtual void ExecuteRecorded(uint32_t uContextIdx) = 0;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    CommandListRecorder
+
+      Summary:  Records into CommandLists and replays them on another
+                render context. Needs no device, so the bucketing of
+                the render queue can be run and measured headless
+
+      Methods:  GetNumContexts
+                  Returns the number of command lists
+                BeginRecording
+                  Resets a command list
+                FinishRecording
+                  Does nothing
+                ExecuteRecorded
+                  Replays a command list on the target context
+                GetCommandList
+                  Returns a command list
+                CommandListRecorder
+                  Constructor.
+                ~CommandListRecorder
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class CommandListRecorder final : public ICommandRecorder
+    {
+    public:
+        CommandListRecorder() = delete;
+        CommandListRecorder(uint32_t uNumContexts, IRenderContext* pTargetContext);
+        CommandListRecorder(const CommandListRecorder& other) = delete;
+        CommandListRecorder(CommandListRecorder&& other) = delete;
+        CommandListRecorder& operator=(const CommandListRecorder& other) = delete;
+        CommandListRecorder& operator=(CommandListRecorder&& other) = delete;
+        ~CommandListRecorder() = default;
+
+        uint32_t GetNumContexts() const override;
+        IRenderContext& BeginRecording(uint32_t uContextIdx) override;
+        bool FinishRecording(uint32_t uContextIdx) override;
+        void ExecuteRecorded(uint32_t uContextIdx) override;
+
+        const CommandList& GetCommandList(uint32_t uContextIdx) const;
+
+    private:
+        std::vector<std::unique_ptr<CommandList>> m_aCommandLists;
+        IRenderContext* m_pTargetContext;
+    };
+}
@@ -0,0 +1,245 @@
+#include "Renderer/ConstantRingBuffer.h"
+
+#include <thread>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantRingBuffer::ConstantRingBuffer
+
+      Summary:  Constructor
+
+      Args:     UINT uSize
+                  Size of the constant buffer in bytes
+
+      Modifies: [m_buffer, m_aFenceQueries, m_allocator, m_pMappedData,
+                 m_uFrameFence, m_uCompletedFence, m_bMappedOnce].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ConstantRingBuffer::ConstantRingBuffer(_In_ UINT uSize)
+        : m_buffer()
+        , m_aFenceQueries()
+        , m_allocator(uSize, CONSTANT_ALIGNMENT)
+        , m_pMappedData(nullptr)
+        , m_uFrameFence(0u)
+        , m_uCompletedFence(0u)
+        , m_bMappedOnce(FALSE)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantRingBuffer::Initialize
+
+      Summary:  Creates the buffer and the fence queries
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffer with
+
+      Modifies: [m_buffer, m_aFenceQueries].
+
+      Returns:  HRESULT
+                  Status code, E_NOTIMPL when the device cannot bind
+                  constant buffers with offsets or map them with
+                  NO_OVERWRITE
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT ConstantRingBuffer::Initialize(_In_ ID3D11Device* pDevice)
+    {
+        D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+        HRESULT hr = pDevice->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options));
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        if (!options.ConstantBufferOffsetting || !options.MapNoOverwriteOnDynamicConstantBuffer)
+        {
+            return E_NOTIMPL;
+        }
+
+        D3D11_BUFFER_DESC bd =
+        {
+            .ByteWidth = m_allocator.GetCapacity(),
+            .Usage = D3D11_USAGE_DYNAMIC,
+            .BindFlags = D3D11_BIND_CONSTANT_BUFFER,
+            .CPUAccessFlags = D3D11_CPU_ACCESS_WRITE,
+            .MiscFlags = 0u,
+            .StructureByteStride = 0u
+        };
+        hr = pDevice->CreateBuffer(&bd, nullptr, m_buffer.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        D3D11_QUERY_DESC queryDesc =
+        {
+            .Query = D3D11_QUERY_EVENT,
+            .MiscFlags = 0u
+        };
+        for (ComPtr<ID3D11Query>& fenceQuery : m_aFenceQueries)
+        {
+            hr = pDevice->CreateQuery(&queryDesc, fenceQuery.GetAddressOf());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantRingBuffer::BeginFrame
+
+      Summary:  Retires the frames the GPU is done with and maps the
+                buffer. Waits for the oldest frame when
+                MAX_FRAMES_IN_FLIGHT frames are still in flight
+
+      Args:     ID3D11DeviceContext* pImmediateContext
+                  The immediate context
+
+      Modifies: [m_allocator, m_pMappedData, m_uCompletedFence,
+                 m_bMappedOnce].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT ConstantRingBuffer::BeginFrame(_In_ ID3D11DeviceContext* pImmediateContext)
+    {
+        while (m_uCompletedFence < m_uFrameFence)
+        {
+            const BOOL bMustWait = m_uFrameFence - m_uCompletedFence >= MAX_FRAMES_IN_FLIGHT;
+
+            BOOL bDone = FALSE;
+            HRESULT hr = pImmediateContext->GetData(
+                m_aFenceQueries[m_uCompletedFence % MAX_FRAMES_IN_FLIGHT].Get(),
+                &bDone,
+                sizeof(bDone),
+                bMustWait ? 0u : D3D11_ASYNC_GETDATA_DONOTFLUSH
+            );
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            if (hr == S_OK && bDone)
+            {
+                ++m_uCompletedFence;
+            }
+            else if (bMustWait)
+            {
+                std::this_thread::yield();
+            }
+            else
+            {
+                break;
+            }
+        }
+        m_allocator.Retire(m_uCompletedFence);
+
+        // The first map discards whatever the driver had, later ones only append
+        D3D11_MAPPED_SUBRESOURCE mappedSubresource = {};
+        HRESULT hr = pImmediateContext->Map(m_buffer.Get(), 0u, m_bMappedOnce ? D3D11_MAP_WRITE_NO_OVERWRITE : D3D11_MAP_WRITE_DISCARD, 0u, &mappedSubresource);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        m_pMappedData = static_cast<BYTE*>(mappedSubresource.pData);
+        m_bMappedOnce = TRUE;
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantRingBuffer::Allocate
+
+      Summary:  Copies constants into a 256-byte aligned range of the
+                mapped buffer
+
+      Args:     const void* pData
+                  Constants to copy
+                UINT uDataSize
+                  Size of the constants in bytes
+                UINT& uFirstConstant
+                  First 16-byte constant of the range, for
+                  *SSetConstantBuffers1
+                UINT& uNumConstants
+                  Number of 16-byte constants of the range, a multiple
+                  of 16
+
+      Modifies: [m_allocator].
+
+      Returns:  BOOL
+                  FALSE if the buffer is not mapped or full, in which
+                  case the constants have to be uploaded another way
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL ConstantRingBuffer::Allocate(_In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize, _Out_ UINT& uFirstConstant, _Out_ UINT& uNumConstants)
+    {
+        uFirstConstant = 0u;
+        uNumConstants = 0u;
+
+        const UINT uAllocationSize = (uDataSize + CONSTANT_ALIGNMENT - 1u) & ~(CONSTANT_ALIGNMENT - 1u);
+        UINT uOffset = 0u;
+        if (!m_pMappedData || !m_allocator.Allocate(uAllocationSize, uOffset))
+        {
+            return FALSE;
+        }
+
+        memcpy(m_pMappedData + uOffset, pData, uDataSize);
+        uFirstConstant = uOffset / 16u;
+        uNumConstants = uAllocationSize / 16u;
+
+        return TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantRingBuffer::Unmap
+
+      Summary:  Unmaps the buffer. Must be called before the draws that
+                read the constants are executed
+
+      Args:     ID3D11DeviceContext* pImmediateContext
+                  The immediate context
+
+      Modifies: [m_pMappedData].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ConstantRingBuffer::Unmap(_In_ ID3D11DeviceContext* pImmediateContext)
+    {
+        if (m_pMappedData)
+        {
+            pImmediateContext->Unmap(m_buffer.Get(), 0u);
+            m_pMappedData = nullptr;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantRingBuffer::EndFrame
+
+      Summary:  Fences the ranges allocated during the frame. Must be
+                called after the draws that read them are executed
+
+      Args:     ID3D11DeviceContext* pImmediateContext
+                  The immediate context
+
+      Modifies: [m_allocator, m_uFrameFence].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ConstantRingBuffer::EndFrame(_In_ ID3D11DeviceContext* pImmediateContext)
+    {
+        pImmediateContext->End(m_aFenceQueries[m_uFrameFence % MAX_FRAMES_IN_FLIGHT].Get());
+        ++m_uFrameFence;
+        m_allocator.EndFrame(m_uFrameFence);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantRingBuffer::GetBuffer
+
+      Summary:  Returns the constant buffer
+
+      Returns:  ComPtr<ID3D11Buffer>&
+                  Constant buffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ComPtr<ID3D11Buffer>& ConstantRingBuffer::GetBuffer()
+    {
+        return m_buffer;
+    }
+}
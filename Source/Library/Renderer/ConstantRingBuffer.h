@@ -0,0 +1,79 @@
+/*+===================================================================
+  File:      CONSTANTRINGBUFFER.H
+
+  Summary:   ConstantRingBuffer header file contains declarations of
+             ConstantRingBuffer class used for the lab samples of Game
+             Graphics Programming course.
+
+  Classes: ConstantRingBuffer
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/FrameRingAllocator.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ConstantRingBuffer
+
+      Summary:  One large dynamic constant buffer that per-object
+                constants are bump allocated into every frame and bound
+                with constant offsets (Direct3D 11.1). The buffer stays
+                mapped with NO_OVERWRITE while a frame is built, and an
+                event query issued after the frame's draws fences the
+                ranges the GPU may still be reading
+
+      Methods:  Initialize
+                  Creates the buffer and the fence queries
+                BeginFrame
+                  Retires the finished frames and maps the buffer
+                Allocate
+                  Copies constants into the buffer
+                Unmap
+                  Unmaps the buffer before the frame is drawn
+                EndFrame
+                  Fences the ranges of the frame
+                GetBuffer
+                  Returns the constant buffer
+                ConstantRingBuffer
+                  Constructor.
+                ~ConstantRingBuffer
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ConstantRingBuffer final
+    {
+    public:
+        static constexpr const UINT CONSTANT_ALIGNMENT = 256u;
+        static constexpr const UINT MAX_FRAMES_IN_FLIGHT = 3u;
+
+        ConstantRingBuffer() = delete;
+        ConstantRingBuffer(_In_ UINT uSize);
+        ConstantRingBuffer(const ConstantRingBuffer& other) = delete;
+        ConstantRingBuffer(ConstantRingBuffer&& other) = delete;
+        ConstantRingBuffer& operator=(const ConstantRingBuffer& other) = delete;
+        ConstantRingBuffer& operator=(ConstantRingBuffer&& other) = delete;
+        ~ConstantRingBuffer() = default;
+
+        HRESULT Initialize(_In_ ID3D11Device* pDevice);
+
+        HRESULT BeginFrame(_In_ ID3D11DeviceContext* pImmediateContext);
+        BOOL Allocate(_In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize, _Out_ UINT& uFirstConstant, _Out_ UINT& uNumConstants);
+        void Unmap(_In_ ID3D11DeviceContext* pImmediateContext);
+        void EndFrame(_In_ ID3D11DeviceContext* pImmediateContext);
+
+        ComPtr<ID3D11Buffer>& GetBuffer();
+
+    private:
+        ComPtr<ID3D11Buffer> m_buffer;
+        ComPtr<ID3D11Query> m_aFenceQueries[MAX_FRAMES_IN_FLIGHT];
+        FrameRingAllocator m_allocator;
+        BYTE* m_pMappedData;
+        UINT64 m_uFrameFence;
+        UINT64 m_uCompletedFence;
+        BOOL m_bMappedOnce;
+    };
+}
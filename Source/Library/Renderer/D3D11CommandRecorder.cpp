@@ -0,0 +1,156 @@
+#include "Renderer/D3D11CommandRecorder.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11CommandRecorder::D3D11CommandRecorder
+
+      Summary:  Constructor
+
+      Modifies: [m_immediateContext, m_aDeferredContexts,
+                 m_aRenderContexts, m_aCommandLists, m_renderTargetView,
+                 m_depthStencilView, m_viewport].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    D3D11CommandRecorder::D3D11CommandRecorder()
+        : m_immediateContext()
+        , m_aDeferredContexts()
+        , m_aRenderContexts()
+        , m_aCommandLists()
+        , m_renderTargetView()
+        , m_depthStencilView()
+        , m_viewport()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11CommandRecorder::Initialize
+
+      Summary:  Creates the deferred contexts
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the contexts with
+                ID3D11DeviceContext* pImmediateContext
+                  The context the command lists are executed on
+                UINT uNumContexts
+                  Number of deferred contexts
+                ID3D11RenderTargetView* pRenderTargetView
+                  Render target every context draws to
+                ID3D11DepthStencilView* pDepthStencilView
+                  Depth stencil buffer every context draws to
+                const D3D11_VIEWPORT& viewport
+                  Viewport every context draws to
+
+      Modifies: [m_immediateContext, m_aDeferredContexts,
+                 m_aRenderContexts, m_aCommandLists, m_renderTargetView,
+                 m_depthStencilView, m_viewport].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT D3D11CommandRecorder::Initialize(
+        _In_ ID3D11Device* pDevice,
+        _In_ ID3D11DeviceContext* pImmediateContext,
+        _In_ UINT uNumContexts,
+        _In_ ID3D11RenderTargetView* pRenderTargetView,
+        _In_ ID3D11DepthStencilView* pDepthStencilView,
+        _In_ const D3D11_VIEWPORT& viewport
+    )
+    {
+        m_immediateContext = pImmediateContext;
+        m_renderTargetView = pRenderTargetView;
+        m_depthStencilView = pDepthStencilView;
+        m_viewport = viewport;
+
+        m_aDeferredContexts.resize(uNumContexts);
+        m_aRenderContexts.resize(uNumContexts);
+        m_aCommandLists.resize(uNumContexts);
+
+        for (UINT i = 0u; i < uNumContexts; ++i)
+        {
+            HRESULT hr = pDevice->CreateDeferredContext(0u, m_aDeferredContexts[i].GetAddressOf());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            m_aRenderContexts[i] = std::make_unique<D3D11RenderContext>(m_aDeferredContexts[i].Get());
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11CommandRecorder::GetNumContexts
+
+      Summary:  Returns the number of deferred contexts
+
+      Returns:  UINT
+                  Number of deferred contexts
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT D3D11CommandRecorder::GetNumContexts() const
+    {
+        return static_cast<UINT>(m_aDeferredContexts.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11CommandRecorder::BeginRecording
+
+      Summary:  Binds the render targets and the viewport on a
+                deferred context
+
+      Args:     UINT uContextIdx
+                  Index of the deferred context
+
+      Returns:  IRenderContext&
+                  Render context recording on the deferred context
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    IRenderContext& D3D11CommandRecorder::BeginRecording(_In_ UINT uContextIdx)
+    {
+        ID3D11DeviceContext* pDeferredContext = m_aDeferredContexts[uContextIdx].Get();
+        pDeferredContext->OMSetRenderTargets(1u, m_renderTargetView.GetAddressOf(), m_depthStencilView.Get());
+        pDeferredContext->RSSetViewports(1u, &m_viewport);
+
+        return *m_aRenderContexts[uContextIdx];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11CommandRecorder::FinishRecording
+
+      Summary:  Finishes the command list of a deferred context. The
+                deferred context is reset to the default state
+
+      Args:     UINT uContextIdx
+                  Index of the deferred context
+
+      Modifies: [m_aCommandLists].
+
+      Returns:  bool
+                  false if the command list could not be created
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    bool D3D11CommandRecorder::FinishRecording(_In_ UINT uContextIdx)
+    {
+        m_aCommandLists[uContextIdx].Reset();
+        return SUCCEEDED(m_aDeferredContexts[uContextIdx]->FinishCommandList(FALSE, m_aCommandLists[uContextIdx].GetAddressOf()));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11CommandRecorder::ExecuteRecorded
+
+      Summary:  Executes the command list of a deferred context on the
+                immediate context and releases it. The immediate
+                context is left in the default state
+
+      Args:     UINT uContextIdx
+                  Index of the deferred context
+
+      Modifies: [m_aCommandLists].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11CommandRecorder::ExecuteRecorded(_In_ UINT uContextIdx)
+    {
+        if (m_aCommandLists[uContextIdx])
+        {
+            m_immediateContext->ExecuteCommandList(m_aCommandLists[uContextIdx].Get(), FALSE);
+            m_aCommandLists[uContextIdx].Reset();
+        }
+    }
+}
@@ -0,0 +1,78 @@
+/*+===================================================================
+  File:      D3D11COMMANDRECORDER.H
+
+  Summary:   D3D11CommandRecorder header file contains declarations of
+             D3D11CommandRecorder class used for the lab samples of
+             Game Graphics Programming course.
+
+  Classes: D3D11CommandRecorder
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/CommandRecorder.h"
+#include "Renderer/D3D11RenderContext.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    D3D11CommandRecorder
+
+      Summary:  Records on Direct3D 11 deferred contexts and executes
+                the finished command lists on the immediate context.
+                Deferred contexts start from the default state, so the
+                render targets and the viewport are bound at the start
+                of every recording
+
+      Methods:  Initialize
+                  Creates the deferred contexts
+                GetNumContexts
+                  Returns the number of deferred contexts
+                BeginRecording
+                  Binds the render targets on a deferred context
+                FinishRecording
+                  Finishes the command list of a deferred context
+                ExecuteRecorded
+                  Executes a command list on the immediate context
+                D3D11CommandRecorder
+                  Constructor.
+                ~D3D11CommandRecorder
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class D3D11CommandRecorder final : public ICommandRecorder
+    {
+    public:
+        D3D11CommandRecorder();
+        D3D11CommandRecorder(const D3D11CommandRecorder& other) = delete;
+        D3D11CommandRecorder(D3D11CommandRecorder&& other) = delete;
+        D3D11CommandRecorder& operator=(const D3D11CommandRecorder& other) = delete;
+        D3D11CommandRecorder& operator=(D3D11CommandRecorder&& other) = delete;
+        ~D3D11CommandRecorder() = default;
+
+        HRESULT Initialize(
+            _In_ ID3D11Device* pDevice,
+            _In_ ID3D11DeviceContext* pImmediateContext,
+            _In_ UINT uNumContexts,
+            _In_ ID3D11RenderTargetView* pRenderTargetView,
+            _In_ ID3D11DepthStencilView* pDepthStencilView,
+            _In_ const D3D11_VIEWPORT& viewport
+        );
+
+        UINT GetNumContexts() const override;
+        IRenderContext& BeginRecording(_In_ UINT uContextIdx) override;
+        bool FinishRecording(_In_ UINT uContextIdx) override;
+        void ExecuteRecorded(_In_ UINT uContextIdx) override;
+
+    private:
+        ComPtr<ID3D11DeviceContext> m_immediateContext;
+        std::vector<ComPtr<ID3D11DeviceContext>> m_aDeferredContexts;
+        std::vector<std::unique_ptr<D3D11RenderContext>> m_aRenderContexts;
+        std::vector<ComPtr<ID3D11CommandList>> m_aCommandLists;
+        ComPtr<ID3D11RenderTargetView> m_renderTargetView;
+        ComPtr<ID3D11DepthStencilView> m_depthStencilView;
+        D3D11_VIEWPORT m_viewport;
+    };
+}
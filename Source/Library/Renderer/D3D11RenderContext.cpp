@@ -0,0 +1,164 @@
+#include "Renderer/D3D11RenderContext.h"
+
+namespace library
+{
+    static_assert(sizeof(Viewport) == sizeof(D3D11_VIEWPORT) && offsetof(Viewport, MaxDepth) == offsetof(D3D11_VIEWPORT, MaxDepth), "Viewport must be laid out like D3D11_VIEWPORT");
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::D3D11RenderContext
+
+      Summary:  Constructor
+
+      Args:     ID3D11DeviceContext* pDeviceContext
+                  Immediate or deferred context to forward the calls to
+
+      Modifies: [m_deviceContext, m_deviceContext1].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    D3D11RenderContext::D3D11RenderContext(_In_ ID3D11DeviceContext* pDeviceContext)
+        : m_deviceContext(pDeviceContext)
+        , m_deviceContext1()
+    {
+        // Null on Direct3D 11.0, where only whole constant buffers can be bound
+        m_deviceContext.As(&m_deviceContext1);
+    }
+
+    void D3D11RenderContext::ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_reads_(4) const FLOAT aColor[4])
+    {
+        m_deviceContext->ClearRenderTargetView(pRenderTargetView, aColor);
+    }
+
+    void D3D11RenderContext::ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 uStencil)
+    {
+        m_deviceContext->ClearDepthStencilView(pDepthStencilView, uClearFlags, depth, uStencil);
+    }
+
+    void D3D11RenderContext::UpdateBuffer(_In_ ID3D11Buffer* pBuffer, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize)
+    {
+        UNREFERENCED_PARAMETER(uDataSize);
+        m_deviceContext->UpdateSubresource(pBuffer, 0u, nullptr, pData, 0u, 0u);
+    }
+
+    void D3D11RenderContext::CopySubresource(_In_ ID3D11Resource* pDstResource, _In_ UINT uDstSubresource, _In_ ID3D11Resource* pSrcResource, _In_ UINT uSrcSubresource)
+    {
+        m_deviceContext->CopySubresourceRegion(pDstResource, uDstSubresource, 0u, 0u, 0u, pSrcResource, uSrcSubresource, nullptr);
+    }
+
+    void D3D11RenderContext::SetRenderTargets(_In_opt_ ID3D11RenderTargetView* pRenderTargetView, _In_opt_ ID3D11DepthStencilView* pDepthStencilView)
+    {
+        m_deviceContext->OMSetRenderTargets(pRenderTargetView ? 1u : 0u, pRenderTargetView ? &pRenderTargetView : nullptr, pDepthStencilView);
+    }
+
+    void D3D11RenderContext::SetViewport(_In_ const Viewport& viewport)
+    {
+        m_deviceContext->RSSetViewports(1u, reinterpret_cast<const D3D11_VIEWPORT*>(&viewport));
+    }
+
+    void D3D11RenderContext::SetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout)
+    {
+        m_deviceContext->IASetInputLayout(pInputLayout);
+    }
+
+    void D3D11RenderContext::SetPrimitiveTopology(_In_ UINT uTopology)
+    {
+        m_deviceContext->IASetPrimitiveTopology(static_cast<D3D11_PRIMITIVE_TOPOLOGY>(uTopology));
+    }
+
+    void D3D11RenderContext::SetVertexBuffer(_In_ UINT uSlot, _In_opt_ ID3D11Buffer* pBuffer, _In_ UINT uStride, _In_ UINT uOffset)
+    {
+        m_deviceContext->IASetVertexBuffers(uSlot, 1u, &pBuffer, &uStride, &uOffset);
+    }
+
+    void D3D11RenderContext::SetIndexBuffer(_In_opt_ ID3D11Buffer* pBuffer, _In_ UINT uFormat)
+    {
+        m_deviceContext->IASetIndexBuffer(pBuffer, static_cast<DXGI_FORMAT>(uFormat), 0u);
+    }
+
+    void D3D11RenderContext::SetVertexShader(_In_opt_ ID3D11VertexShader* pVertexShader)
+    {
+        m_deviceContext->VSSetShader(pVertexShader, nullptr, 0u);
+    }
+
+    void D3D11RenderContext::SetPixelShader(_In_opt_ ID3D11PixelShader* pPixelShader)
+    {
+        m_deviceContext->PSSetShader(pPixelShader, nullptr, 0u);
+    }
+
+    void D3D11RenderContext::SetVSConstantBuffer(_In_ UINT uSlot, _In_opt_ ID3D11Buffer* pBuffer, _In_ UINT uFirstConstant, _In_ UINT uNumConstants)
+    {
+        if (uNumConstants > 0u && m_deviceContext1)
+        {
+            m_deviceContext1->VSSetConstantBuffers1(uSlot, 1u, &pBuffer, &uFirstConstant, &uNumConstants);
+            return;
+        }
+
+        m_deviceContext->VSSetConstantBuffers(uSlot, 1u, &pBuffer);
+    }
+
+    void D3D11RenderContext::SetPSConstantBuffer(_In_ UINT uSlot, _In_opt_ ID3D11Buffer* pBuffer, _In_ UINT uFirstConstant, _In_ UINT uNumConstants)
+    {
+        if (uNumConstants > 0u && m_deviceContext1)
+        {
+            m_deviceContext1->PSSetConstantBuffers1(uSlot, 1u, &pBuffer, &uFirstConstant, &uNumConstants);
+            return;
+        }
+
+        m_deviceContext->PSSetConstantBuffers(uSlot, 1u, &pBuffer);
+    }
+
+    void D3D11RenderContext::SetPSShaderResource(_In_ UINT uSlot, _In_opt_ ID3D11ShaderResourceView* pShaderResourceView)
+    {
+        m_deviceContext->PSSetShaderResources(uSlot, 1u, &pShaderResourceView);
+    }
+
+    void D3D11RenderContext::SetPSSampler(_In_ UINT uSlot, _In_opt_ ID3D11SamplerState* pSampler)
+    {
+        m_deviceContext->PSSetSamplers(uSlot, 1u, &pSampler);
+    }
+
+    void D3D11RenderContext::DrawIndexed(_In_ UINT uNumIndices, _In_ UINT uStartIndex, _In_ INT iBaseVertex)
+    {
+        m_deviceContext->DrawIndexed(uNumIndices, uStartIndex, iBaseVertex);
+    }
+
+    void D3D11RenderContext::DrawIndexedInstanced(_In_ UINT uNumIndices, _In_ UINT uNumInstances, _In_ UINT uStartIndex, _In_ INT iBaseVertex, _In_ UINT uStartInstance)
+    {
+        m_deviceContext->DrawIndexedInstanced(uNumIndices, uNumInstances, uStartIndex, iBaseVertex, uStartInstance);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::GetDeviceContext
+
+      Summary:  Returns the wrapped device context
+
+      Returns:  ID3D11DeviceContext*
+                  Device context
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ID3D11DeviceContext* D3D11RenderContext::GetDeviceContext() const
+    {
+        return m_deviceContext.Get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderContext::ToViewport
+
+      Summary:  Converts a Direct3D viewport
+
+      Args:     const D3D11_VIEWPORT& viewport
+                  Direct3D viewport
+
+      Returns:  Viewport
+                  Viewport of a render context
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    Viewport D3D11RenderContext::ToViewport(_In_ const D3D11_VIEWPORT& viewport)
+    {
+        return Viewport
+        {
+            .TopLeftX = viewport.TopLeftX,
+            .TopLeftY = viewport.TopLeftY,
+            .Width = viewport.Width,
+            .Height = viewport.Height,
+            .MinDepth = viewport.MinDepth,
+            .MaxDepth = viewport.MaxDepth
+        };
+    }
+}
@@ -0,0 +1,74 @@
+/*+===================================================================
+  File:      D3D11RENDERCONTEXT.H
+
+  Summary:   D3D11RenderContext header file contains declarations of
+             D3D11RenderContext class used for the lab samples of Game
+             Graphics Programming course.
+
+  Classes: D3D11RenderContext
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/RenderContext.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    D3D11RenderContext
+
+      Summary:  Forwards every call to a Direct3D 11 device context.
+                Constant buffer ranges are bound through
+                ID3D11DeviceContext1
+
+      Methods:  GetDeviceContext
+                  Returns the wrapped device context
+                ToViewport
+                  Converts a Direct3D viewport
+                D3D11RenderContext
+                  Constructor.
+                ~D3D11RenderContext
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class D3D11RenderContext final : public IRenderContext
+    {
+    public:
+        D3D11RenderContext() = delete;
+        D3D11RenderContext(_In_ ID3D11DeviceContext* pDeviceContext);
+        D3D11RenderContext(const D3D11RenderContext& other) = delete;
+        D3D11RenderContext(D3D11RenderContext&& other) = delete;
+        D3D11RenderContext& operator=(const D3D11RenderContext& other) = delete;
+        D3D11RenderContext& operator=(D3D11RenderContext&& other) = delete;
+        ~D3D11RenderContext() = default;
+
+        void ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_reads_(4) const FLOAT aColor[4]) override;
+        void ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 uStencil) override;
+        void UpdateBuffer(_In_ ID3D11Buffer* pBuffer, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize) override;
+        void CopySubresource(_In_ ID3D11Resource* pDstResource, _In_ UINT uDstSubresource, _In_ ID3D11Resource* pSrcResource, _In_ UINT uSrcSubresource) override;
+        void SetRenderTargets(_In_opt_ ID3D11RenderTargetView* pRenderTargetView, _In_opt_ ID3D11DepthStencilView* pDepthStencilView) override;
+        void SetViewport(_In_ const Viewport& viewport) override;
+        void SetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout) override;
+        void SetPrimitiveTopology(_In_ UINT uTopology) override;
+        void SetVertexBuffer(_In_ UINT uSlot, _In_opt_ ID3D11Buffer* pBuffer, _In_ UINT uStride, _In_ UINT uOffset) override;
+        void SetIndexBuffer(_In_opt_ ID3D11Buffer* pBuffer, _In_ UINT uFormat) override;
+        void SetVertexShader(_In_opt_ ID3D11VertexShader* pVertexShader) override;
+        void SetPixelShader(_In_opt_ ID3D11PixelShader* pPixelShader) override;
+        void SetVSConstantBuffer(_In_ UINT uSlot, _In_opt_ ID3D11Buffer* pBuffer, _In_ UINT uFirstConstant, _In_ UINT uNumConstants) override;
+        void SetPSConstantBuffer(_In_ UINT uSlot, _In_opt_ ID3D11Buffer* pBuffer, _In_ UINT uFirstConstant, _In_ UINT uNumConstants) override;
+        void SetPSShaderResource(_In_ UINT uSlot, _In_opt_ ID3D11ShaderResourceView* pShaderResourceView) override;
+        void SetPSSampler(_In_ UINT uSlot, _In_opt_ ID3D11SamplerState* pSampler) override;
+        void DrawIndexed(_In_ UINT uNumIndices, _In_ UINT uStartIndex, _In_ INT iBaseVertex) override;
+        void DrawIndexedInstanced(_In_ UINT uNumIndices, _In_ UINT uNumInstances, _In_ UINT uStartIndex, _In_ INT iBaseVertex, _In_ UINT uStartInstance) override;
+
+        ID3D11DeviceContext* GetDeviceContext() const;
+
+        static Viewport ToViewport(_In_ const D3D11_VIEWPORT& viewport);
+
+    private:
+        ComPtr<ID3D11DeviceContext> m_deviceContext;
+        ComPtr<ID3D11DeviceContext1> m_deviceContext1;
+    };
+}
@@ -2,11 +2,20 @@
 
 #include "Common.h"
 
+#include "Light/LightBinner.h"
+#include "Renderer/VoxelInstanceData.h"
+
 namespace library
 {
 #define NUM_LIGHTS (1)
+#define MAX_NUM_LIGHTS (1024)
+#define MAX_NUM_OBJECT_LIGHTS (4)
 #define MAX_NUM_BONES (256)
 #define MAX_NUM_BONES_PER_VERTEX (16)
+#define NUM_BLOCK_TYPES (15)
+#define NUM_SHADOW_CASCADES (4)
+
+	static_assert(NUM_BLOCK_TYPES == static_cast<INT>(eBlockType::COUNT) - static_cast<INT>(eBlockType::GRASSLAND), "NUM_BLOCK_TYPES must match eBlockType");
 
 	/*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
 	 Struct:   NormalData
@@ -31,6 +40,17 @@ namespace library
 		XMMATRIX Transformation;
 	};
 
+	/*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+	 Enum:     eInstanceLayout
+	 Summary:  Enumeration of the instance buffer layouts
+   E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+	enum class eInstanceLayout
+	{
+		TRANSFORM,
+		VOXEL,
+		COUNT,
+	};
+
 	struct AnimationData
 	{
 		XMUINT4 aBoneIndices;
@@ -48,23 +68,47 @@ namespace library
 		XMMATRIX Projection;
 	};
 
+	/*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+	 Struct:   Lights
+	 Summary:  Point light as seen by the shaders. AttenuationDistance
+			   holds the attenuation distance, the range beyond which
+			   the light is culled, and both of them squared
+   S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+	struct Lights
+	{
+		XMFLOAT4 Position;
+		XMFLOAT4 Color;
+		XMFLOAT4 AttenuationDistance;
+	};
+
+	/*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+	 Struct:   CBChangesEveryFrame
+	 Summary:  Per-draw constants. ObjectLights holds the NumLights
+			   lights that reach the bounds of the object, brightest
+			   first; the padding keeps them on a 16 byte register
+			   like the HLSL packing
+   S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
 	struct CBChangesEveryFrame
 	{
 		XMMATRIX World;
 		XMFLOAT4 OutputColor;
-		BOOL HasNormalMap;
+		UINT NumLights;
+		UINT Padding[3];
+		Lights ObjectLights[MAX_NUM_OBJECT_LIGHTS];
 	};
 
-	struct CBSkinning
+	/*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+	 Struct:   CBBlockColors
+	 Summary:  Color of each block type, indexed from GRASSLAND
+   S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+	struct CBBlockColors
 	{
-		XMMATRIX BoneTransforms[MAX_NUM_BONES];
+		XMFLOAT4 BlockColors[NUM_BLOCK_TYPES];
 	};
 
-	struct Lights
+	struct CBSkinning
 	{
-		XMFLOAT4 Position;
-		XMFLOAT4 Color;
-		XMFLOAT4 AttenuationDistance;
+		XMMATRIX BoneTransforms[MAX_NUM_BONES];
 	};
 
 	struct CBLights
@@ -72,4 +116,42 @@ namespace library
 		Lights PointLights[NUM_LIGHTS];
 	};
 
+	/*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+	 Struct:   CBLightClusters
+	 Summary:  Maps a pixel to its light cluster. ClusterScale holds
+			   the clusters per pixel along x and y, and the scale and
+			   bias of the logarithmic depth slices
+   S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+	struct CBLightClusters
+	{
+		XMFLOAT4 ClusterScale;
+		XMUINT4 ClusterCounts;
+	};
+
+	/*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+	 Struct:   CBShadowPass
+	 Summary:  Light view projection of the cascade being drawn into
+   S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+	struct CBShadowPass
+	{
+		XMMATRIX ViewProjection;
+	};
+
+	/*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+	 Struct:   CBShadowCascades
+	 Summary:  Directional light and the cascades of its shadow map.
+			   CascadeSplits holds the view depth where each cascade
+			   ends and CascadeTexelSizes the world size of their
+			   texels
+   S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+	struct CBShadowCascades
+	{
+		XMMATRIX CascadeViewProjections[NUM_SHADOW_CASCADES];
+		XMFLOAT4 CascadeSplits;
+		XMFLOAT4 CascadeTexelSizes;
+		XMFLOAT4 LightDirection;
+		XMFLOAT4 LightColor;
+	};
+	static_assert(NUM_SHADOW_CASCADES == 4, "CascadeSplits and CascadeTexelSizes hold one cascade per component");
+
 }
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include "Renderer/FrameRingAllocator.h"
+
+#include <cassert>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameRingAllocator::FrameRingAllocator
+
+      Summary:  Constructor
+
+      Args:     uint32_t uCapacity
+                  Size of the ring in bytes
+                uint32_t uAlignment
+                  Alignment of every range, a power of two
+
+      Modifies: [m_uCapacity, m_uAlignment, m_uHead, m_uUsedSize,
+                 m_uFrameSize, m_aFrames].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FrameRingAllocator::FrameRingAllocator(uint32_t uCapacity, uint32_t uAlignment)
+        : m_uCapacity(uCapacity)
+        , m_uAlignment(uAlignment)
+        , m_uHead(0u)
+        , m_uUsedSize(0u)
+        , m_uFrameSize(0u)
+        , m_aFrames()
+    {
+        assert(uAlignment > 0u && (uAlignment & (uAlignment - 1u)) == 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameRingAllocator::Allocate
+
+      Summary:  Allocates an aligned range. A range never straddles
+                the end of the ring: the bytes left at the end are
+                skipped and counted as used by the current frame
+
+      Args:     uint32_t uSize
+                  Size of the range in bytes
+                uint32_t& uOffset
+                  Offset of the range in the ring
+
+      Modifies: [m_uHead, m_uUsedSize, m_uFrameSize].
+
+      Returns:  bool
+                  false if the ring is full until more frames retire
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    bool FrameRingAllocator::Allocate(uint32_t uSize, uint32_t& uOffset)
+    {
+        uOffset = 0u;
+        if (uSize == 0u || uSize > m_uCapacity)
+        {
+            return false;
+        }
+
+        // Nothing is in use, so the ring can start over instead of skipping its end
+        if (m_uUsedSize == 0u)
+        {
+            m_uHead = 0u;
+        }
+
+        uint32_t uStart = (m_uHead + m_uAlignment - 1u) & ~(m_uAlignment - 1u);
+        if (uStart >= m_uCapacity || m_uCapacity - uStart < uSize)
+        {
+            uStart = 0u;
+        }
+
+        // Bytes consumed: the alignment padding, or the skipped end of the ring
+        const uint32_t uConsumed = (uStart >= m_uHead ? uStart - m_uHead : m_uCapacity - m_uHead) + uSize;
+        if (uConsumed > m_uCapacity - m_uUsedSize)
+        {
+            return false;
+        }
+
+        uOffset = uStart;
+        m_uHead = uStart + uSize;
+        m_uUsedSize += uConsumed;
+        m_uFrameSize += uConsumed;
+
+        return true;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameRingAllocator::EndFrame
+
+      Summary:  Assigns every range allocated since the last EndFrame
+                to a fence
+
+      Args:     uint64_t uFence
+                  Fence signaled when the GPU is done with the frame,
+                  increasing every frame
+
+      Modifies: [m_uFrameSize, m_aFrames].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void FrameRingAllocator::EndFrame(uint64_t uFence)
+    {
+        m_aFrames.push_back(FrameEntry{ .uFence = uFence, .uSize = m_uFrameSize });
+        m_uFrameSize = 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameRingAllocator::Retire
+
+      Summary:  Frees the ranges of every frame whose fence is
+                completed. Frames retire in the order they ended
+
+      Args:     uint64_t uCompletedFence
+                  Last fence the GPU is done with
+
+      Modifies: [m_uUsedSize, m_aFrames].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void FrameRingAllocator::Retire(uint64_t uCompletedFence)
+    {
+        while (!m_aFrames.empty() && m_aFrames.front().uFence <= uCompletedFence)
+        {
+            m_uUsedSize -= m_aFrames.front().uSize;
+            m_aFrames.pop_front();
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameRingAllocator::GetCapacity
+
+      Summary:  Returns the size of the ring
+
+      Returns:  uint32_t
+                  Size of the ring in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t FrameRingAllocator::GetCapacity() const
+    {
+        return m_uCapacity;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameRingAllocator::GetUsedSize
+
+      Summary:  Returns the number of bytes owned by the current frame
+                and the frames not yet retired
+
+      Returns:  uint32_t
+                  Used size in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t FrameRingAllocator::GetUsedSize() const
+    {
+        return m_uUsedSize;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrameRingAllocator::GetNumFramesInFlight
+
+      Summary:  Returns the number of ended frames not yet retired
+
+      Returns:  uint32_t
+                  Number of frames in flight
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t FrameRingAllocator::GetNumFramesInFlight() const
+    {
+        return static_cast<uint32_t>(m_aFrames.size());
+    }
+}
@@ -0,0 +1,79 @@
+/*+===================================================================
+  File:      FRAMERINGALLOCATOR.H
+
+  Summary:   FrameRingAllocator header file contains declarations of
+             FrameRingAllocator class used for the lab samples of Game
+             Graphics Programming course. Only depends on the standard
+             library.
+
+  Classes: FrameRingAllocator
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <cstdint>
+#include <deque>
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    FrameRingAllocator
+
+      Summary:  Hands out aligned ranges of a ring of bytes. The ranges
+                allocated during a frame are owned by that frame's
+                fence and are only reused once the fence has been
+                retired, so the GPU never reads a range the CPU is
+                overwriting. Holds no memory itself, only offsets
+
+      Methods:  Allocate
+                  Allocates an aligned range
+                EndFrame
+                  Assigns the ranges of the frame to a fence
+                Retire
+                  Frees the ranges of every completed fence
+                GetCapacity
+                  Returns the size of the ring
+                GetUsedSize
+                  Returns the number of bytes in use
+                GetNumFramesInFlight
+                  Returns the number of frames not yet retired
+                FrameRingAllocator
+                  Constructor.
+                ~FrameRingAllocator
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class FrameRingAllocator final
+    {
+    public:
+        FrameRingAllocator() = delete;
+        FrameRingAllocator(uint32_t uCapacity, uint32_t uAlignment);
+        FrameRingAllocator(const FrameRingAllocator& other) = delete;
+        FrameRingAllocator(FrameRingAllocator&& other) = delete;
+        FrameRingAllocator& operator=(const FrameRingAllocator& other) = delete;
+        FrameRingAllocator& operator=(FrameRingAllocator&& other) = delete;
+        ~FrameRingAllocator() = default;
+
+        bool Allocate(uint32_t uSize, uint32_t& uOffset);
+        void EndFrame(uint64_t uFence);
+        void Retire(uint64_t uCompletedFence);
+
+        uint32_t GetCapacity() const;
+        uint32_t GetUsedSize() const;
+        uint32_t GetNumFramesInFlight() const;
+
+    private:
+        struct FrameEntry
+        {
+            uint64_t uFence;
+            uint32_t uSize;
+        };
+
+        uint32_t m_uCapacity;
+        uint32_t m_uAlignment;
+        uint32_t m_uHead;
+        uint32_t m_uUsedSize;
+        uint32_t m_uFrameSize;
+        std::deque<FrameEntry> m_aFrames;
+    };
+}
@@ -0,0 +1,334 @@
+#include "Renderer/InstanceBufferRing.h"
+
+#include <algorithm>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBufferRing::InstanceBufferRing
+
+      Summary:  Constructor. There is no buffer until the first
+                OnBufferCreated
+
+      Modifies: [m_uCapacity, m_uDirtyBegin, m_uDirtyEnd, m_uSegment,
+                 m_bDynamic].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    InstanceBufferRing::InstanceBufferRing()
+        : m_uCapacity(0u)
+        , m_uDirtyBegin(0u)
+        , m_uDirtyEnd(0u)
+        , m_uSegment(0u)
+        , m_bDynamic(false)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBufferRing::SetDynamic
+
+      Summary:  Selects between a dynamic buffer, rewritten into a new
+                ring segment whenever it changes, and a default one,
+                patched in place over the dirty range. A change of
+                usage needs a new buffer holding every instance
+
+      Args:     bool bDynamic
+                  true to use a dynamic buffer
+                uint32_t uNumInstances
+                  Number of instances
+
+      Modifies: [m_bDynamic, m_uCapacity, m_uDirtyBegin, m_uDirtyEnd].
+
+      Returns:  bool
+                  true if the usage changed and the buffer must be
+                  released
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    bool InstanceBufferRing::SetDynamic(bool bDynamic, uint32_t uNumInstances)
+    {
+        if (m_bDynamic == bDynamic)
+        {
+            return false;
+        }
+
+        m_bDynamic = bDynamic;
+        Release();
+        MarkDirty(0u, uNumInstances);
+
+        return true;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBufferRing::Release
+
+      Summary:  Forgets the buffer after it was released or failed to
+                be created, so the next update creates a new one
+
+      Modifies: [m_uCapacity].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void InstanceBufferRing::Release()
+    {
+        m_uCapacity = 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBufferRing::MarkDirty
+
+      Summary:  Extends the range of instances to upload on the next
+                BeginUpload
+
+      Args:     uint32_t uBegin
+                  Index of the first changed instance
+                uint32_t uEnd
+                  One past the index of the last changed instance
+
+      Modifies: [m_uDirtyBegin, m_uDirtyEnd].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void InstanceBufferRing::MarkDirty(uint32_t uBegin, uint32_t uEnd)
+    {
+        if (uBegin >= uEnd)
+        {
+            return;
+        }
+
+        if (m_uDirtyBegin >= m_uDirtyEnd)
+        {
+            m_uDirtyBegin = uBegin;
+            m_uDirtyEnd = uEnd;
+        }
+        else
+        {
+            m_uDirtyBegin = (std::min)(m_uDirtyBegin, uBegin);
+            m_uDirtyEnd = (std::max)(m_uDirtyEnd, uEnd);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBufferRing::NeedsBuffer
+
+      Summary:  Returns whether a buffer must be created before the
+                instances are uploaded, because there is none or the
+                instances no longer fit
+
+      Args:     uint32_t uNumInstances
+                  Number of instances
+
+      Returns:  bool
+                  true if a buffer of GetGrownCapacity must be created
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    bool InstanceBufferRing::NeedsBuffer(uint32_t uNumInstances) const
+    {
+        return m_uCapacity == 0u || uNumInstances > m_uCapacity;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBufferRing::GetGrownCapacity
+
+      Summary:  Returns the capacity of the buffer to create, double
+                the current one so that appending an instance at a
+                time only creates a logarithmic number of buffers
+
+      Args:     uint32_t uNumInstances
+                  Number of instances
+
+      Returns:  uint32_t
+                  Number of instances the new buffer holds
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t InstanceBufferRing::GetGrownCapacity(uint32_t uNumInstances) const
+    {
+        return (std::max)(m_uCapacity * 2u, uNumInstances);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBufferRing::GetBufferSize
+
+      Summary:  Returns the size of a buffer holding uCapacity
+                instances, NUM_SEGMENTS times over if it is dynamic
+
+      Args:     uint32_t uCapacity
+                  Number of instances the buffer holds
+                uint32_t uStride
+                  Size of an instance in bytes
+
+      Returns:  uint32_t
+                  Size of the buffer in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t InstanceBufferRing::GetBufferSize(uint32_t uCapacity, uint32_t uStride) const
+    {
+        return uStride * uCapacity * (m_bDynamic ? NUM_SEGMENTS : 1u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBufferRing::IsFilledOnCreation
+
+      Summary:  Returns whether a new default buffer is exactly filled
+                by the instances, and so is created with them as its
+                initial data instead of being uploaded afterwards
+
+      Args:     uint32_t uCapacity
+                  Number of instances the new buffer holds
+                uint32_t uNumInstances
+                  Number of instances
+
+      Returns:  bool
+                  true to create the buffer with the instances
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    bool InstanceBufferRing::IsFilledOnCreation(uint32_t uCapacity, uint32_t uNumInstances) const
+    {
+        return !m_bDynamic && uCapacity == uNumInstances;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBufferRing::OnBufferCreated
+
+      Summary:  Records the capacity of the buffer just created. Every
+                instance is uploaded on the next update unless the
+                buffer was created with them, and the first update
+                of a dynamic buffer wraps to segment 0 and discards it
+
+      Args:     uint32_t uCapacity
+                  Number of instances the buffer holds
+                uint32_t uNumInstances
+                  Number of instances
+
+      Modifies: [m_uCapacity, m_uSegment, m_uDirtyBegin, m_uDirtyEnd].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void InstanceBufferRing::OnBufferCreated(uint32_t uCapacity, uint32_t uNumInstances)
+    {
+        if (IsFilledOnCreation(uCapacity, uNumInstances))
+        {
+            m_uDirtyBegin = 0u;
+            m_uDirtyEnd = 0u;
+        }
+        else
+        {
+            MarkDirty(0u, uNumInstances);
+        }
+
+        m_uCapacity = uCapacity;
+        m_uSegment = NUM_SEGMENTS - 1u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBufferRing::BeginUpload
+
+      Summary:  Returns the instances to copy for the changes since the
+                last update, and clears them. A dynamic buffer moves to
+                the next segment and takes every instance, a default
+                one takes the dirty range in place
+
+      Args:     uint32_t uNumInstances
+                  Number of instances, at most the capacity
+                uint32_t uStride
+                  Size of an instance in bytes
+
+      Modifies: [m_uSegment, m_uDirtyBegin, m_uDirtyEnd].
+
+      Returns:  InstanceUpload
+                  Instances to copy, if any
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    InstanceUpload InstanceBufferRing::BeginUpload(uint32_t uNumInstances, uint32_t uStride)
+    {
+        InstanceUpload upload = {};
+        if (m_uDirtyBegin >= m_uDirtyEnd)
+        {
+            return upload;
+        }
+
+        if (m_bDynamic)
+        {
+            m_uSegment = (m_uSegment + 1u) % NUM_SEGMENTS;
+
+            upload.bUpload = uNumInstances > 0u;
+            upload.bDiscard = m_uSegment == 0u;
+            upload.uBegin = 0u;
+            upload.uEnd = uNumInstances;
+            upload.uByteOffset = GetOffset(uStride);
+        }
+        else
+        {
+            upload.uBegin = m_uDirtyBegin;
+            upload.uEnd = (std::min)(m_uDirtyEnd, uNumInstances);
+            upload.bUpload = upload.uBegin < upload.uEnd;
+            upload.uByteOffset = upload.uBegin * uStride;
+        }
+
+        m_uDirtyBegin = 0u;
+        m_uDirtyEnd = 0u;
+
+        return upload;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBufferRing::HasDirtyInstances
+
+      Summary:  Returns whether instances changed since the last
+                BeginUpload
+
+      Returns:  bool
+                  true if there are instances to upload
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    bool InstanceBufferRing::HasDirtyInstances() const
+    {
+        return m_uDirtyBegin < m_uDirtyEnd;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBufferRing::GetOffset
+
+      Summary:  Returns the byte offset of the current instances in the
+                buffer, to be used when binding it
+
+      Args:     uint32_t uStride
+                  Size of an instance in bytes
+
+      Returns:  uint32_t
+                  Offset of the current segment, 0 if not dynamic
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t InstanceBufferRing::GetOffset(uint32_t uStride) const
+    {
+        if (m_bDynamic)
+        {
+            return m_uSegment * m_uCapacity * uStride;
+        }
+
+        return 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBufferRing::GetCapacity
+
+      Summary:  Returns the number of instances the buffer holds, in
+                each segment if it is dynamic
+
+      Returns:  uint32_t
+                  Capacity, 0 without a buffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t InstanceBufferRing::GetCapacity() const
+    {
+        return m_uCapacity;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBufferRing::GetSegment
+
+      Summary:  Returns the ring segment the current instances are in
+
+      Returns:  uint32_t
+                  Segment, below NUM_SEGMENTS
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t InstanceBufferRing::GetSegment() const
+    {
+        return m_uSegment;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstanceBufferRing::IsDynamic
+
+      Summary:  Returns whether the buffer is dynamic
+
+      Returns:  bool
+                  true if the buffer is dynamic
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    bool InstanceBufferRing::IsDynamic() const
+    {
+        return m_bDynamic;
+    }
+}
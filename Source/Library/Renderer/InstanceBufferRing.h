@@ -0,0 +1,119 @@
+/*+===================================================================
+  File:      INSTANCEBUFFERRING.H
+
+  Summary:   InstanceBufferRing header file contains declarations of
+             InstanceBufferRing class used for the lab samples of Game
+             Graphics Programming course. Only depends on the standard
+             library.
+
+  Classes: InstanceBufferRing
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <cstdint>
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   InstanceUpload
+
+      Summary:  Instances to copy into the instance buffer on an
+                update, [uBegin, uEnd) to uByteOffset. A dynamic buffer
+                is mapped with WRITE_DISCARD when bDiscard is set and
+                WRITE_NO_OVERWRITE otherwise
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct InstanceUpload
+    {
+        bool bUpload;
+        bool bDiscard;
+        uint32_t uBegin;
+        uint32_t uEnd;
+        uint32_t uByteOffset;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    InstanceBufferRing
+
+      Summary:  Bookkeeping of an instance buffer, without the buffer.
+                Tracks the range of instances changed since the last
+                update and the capacity, doubled when the instances no
+                longer fit. A dynamic buffer holds NUM_SEGMENTS copies
+                of the instances: every update rewrites the next
+                segment without overwriting those the GPU may still be
+                reading, and discards the buffer when the ring wraps to
+                segment 0. A default buffer only copies the dirty range
+
+      Methods:  SetDynamic
+                  Selects the dynamic or the default usage
+                Release
+                  Forgets the buffer, so the next update creates one
+                MarkDirty
+                  Extends the range of instances to upload
+                NeedsBuffer
+                  Returns whether a buffer must be created first
+                GetGrownCapacity
+                  Returns the capacity of the buffer to create
+                GetBufferSize
+                  Returns the size in bytes of a buffer
+                IsFilledOnCreation
+                  Returns whether a new buffer is created with every
+                  instance as its initial data
+                OnBufferCreated
+                  Records the capacity of the buffer just created
+                BeginUpload
+                  Returns the instances to copy and moves the ring on
+                HasDirtyInstances
+                  Returns whether instances changed since the last
+                  update
+                GetOffset
+                  Returns the byte offset of the current instances
+                GetCapacity
+                  Returns the number of instances the buffer holds
+                GetSegment
+                  Returns the ring segment of the current instances
+                IsDynamic
+                  Returns whether the buffer is dynamic
+                InstanceBufferRing
+                  Constructor.
+                ~InstanceBufferRing
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class InstanceBufferRing final
+    {
+    public:
+        static constexpr const uint32_t NUM_SEGMENTS = 3u;
+
+        InstanceBufferRing();
+        InstanceBufferRing(const InstanceBufferRing& other) = delete;
+        InstanceBufferRing(InstanceBufferRing&& other) = delete;
+        InstanceBufferRing& operator=(const InstanceBufferRing& other) = delete;
+        InstanceBufferRing& operator=(InstanceBufferRing&& other) = delete;
+        ~InstanceBufferRing() = default;
+
+        bool SetDynamic(bool bDynamic, uint32_t uNumInstances);
+        void Release();
+        void MarkDirty(uint32_t uBegin, uint32_t uEnd);
+
+        bool NeedsBuffer(uint32_t uNumInstances) const;
+        uint32_t GetGrownCapacity(uint32_t uNumInstances) const;
+        uint32_t GetBufferSize(uint32_t uCapacity, uint32_t uStride) const;
+        bool IsFilledOnCreation(uint32_t uCapacity, uint32_t uNumInstances) const;
+        void OnBufferCreated(uint32_t uCapacity, uint32_t uNumInstances);
+        InstanceUpload BeginUpload(uint32_t uNumInstances, uint32_t uStride);
+
+        bool HasDirtyInstances() const;
+        uint32_t GetOffset(uint32_t uStride) const;
+        uint32_t GetCapacity() const;
+        uint32_t GetSegment() const;
+        bool IsDynamic() const;
+
+    private:
+        uint32_t m_uCapacity;
+        uint32_t m_uDirtyBegin;
+        uint32_t m_uDirtyEnd;
+        uint32_t m_uSegment;
+        bool m_bDynamic;
+    };
+}
@@ -14,6 +14,13 @@ namespace library
         :Renderable(outputColor)
         , m_instanceBuffer(nullptr)
         , m_aInstanceData(std::vector<InstanceData>())
+        , m_aVoxelInstanceData()
+        , m_eInstanceLayout(eInstanceLayout::TRANSFORM)
+        , m_instanceRing()
+        , m_instanceBounds()
+        , m_uBoundsDirtyBegin(0u)
+        , m_uBoundsDirtyEnd(0u)
+        , m_bInstanceBoundsValid(FALSE)
         , m_padding()
     {
 
@@ -34,7 +41,43 @@ namespace library
     InstancedRenderable::InstancedRenderable(_In_ std::vector<InstanceData>&& aInstanceData, _In_ const XMFLOAT4& outputColor)
         : Renderable(outputColor)
         , m_instanceBuffer(nullptr)
-        , m_aInstanceData(aInstanceData)
+        , m_aInstanceData(std::move(aInstanceData))
+        , m_aVoxelInstanceData()
+        , m_eInstanceLayout(eInstanceLayout::TRANSFORM)
+        , m_instanceRing()
+        , m_instanceBounds()
+        , m_uBoundsDirtyBegin(0u)
+        , m_uBoundsDirtyEnd(0u)
+        , m_bInstanceBoundsValid(FALSE)
+        , m_padding()
+    {
+
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::InstancedRenderable
+
+      Summary:  Constructor that uses the compact voxel instance layout
+
+      Args:     std::vector<VoxelInstanceData>&& aInstanceData
+                  Compact instance data
+                const XMFLOAT4& outputColor
+                  Default color of the renderable
+
+      Modifies: [m_instanceBuffer, m_aVoxelInstanceData,
+                 m_eInstanceLayout].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    InstancedRenderable::InstancedRenderable(_In_ std::vector<VoxelInstanceData>&& aInstanceData, _In_ const XMFLOAT4& outputColor)
+        : Renderable(outputColor)
+        , m_instanceBuffer(nullptr)
+        , m_aInstanceData()
+        , m_aVoxelInstanceData(std::move(aInstanceData))
+        , m_eInstanceLayout(eInstanceLayout::VOXEL)
+        , m_instanceRing()
+        , m_instanceBounds()
+        , m_uBoundsDirtyBegin(0u)
+        , m_uBoundsDirtyEnd(0u)
+        , m_bInstanceBoundsValid(FALSE)
         , m_padding()
     {
 
@@ -43,16 +86,257 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   InstancedRenderable::SetInstanceData
 
-      Summary:  Sets the instance data
+      Summary:  Sets the instance data. Every instance is uploaded on
+                the next UpdateInstanceBuffer
 
       Args:     std::vector<InstanceData>&& aInstanceData
                   Instance data
 
-      Modifies: [m_aInstanceData].
+      Modifies: [m_aInstanceData, m_aVoxelInstanceData,
+                 m_eInstanceLayout, m_instanceRing].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void InstancedRenderable::SetInstanceData(_In_ std::vector<InstanceData>&& aInstanceData)
     {
-        m_aInstanceData = aInstanceData;
+        if (m_eInstanceLayout != eInstanceLayout::TRANSFORM)
+        {
+            // The stride changes, so the old buffer cannot be reused
+            m_instanceBuffer.Reset();
+            m_instanceRing.Release();
+        }
+
+        m_aInstanceData = std::move(aInstanceData);
+        m_aVoxelInstanceData.clear();
+        m_eInstanceLayout = eInstanceLayout::TRANSFORM;
+
+        markInstancesDirty(0u, GetNumInstances());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::SetInstanceData
+
+      Summary:  Sets the instance data in the compact voxel layout.
+                Every instance is uploaded on the next
+                UpdateInstanceBuffer
+
+      Args:     std::vector<VoxelInstanceData>&& aInstanceData
+                  Compact instance data
+
+      Modifies: [m_aInstanceData, m_aVoxelInstanceData,
+                 m_eInstanceLayout, m_instanceRing].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void InstancedRenderable::SetInstanceData(_In_ std::vector<VoxelInstanceData>&& aInstanceData)
+    {
+        if (m_eInstanceLayout != eInstanceLayout::VOXEL)
+        {
+            // The stride changes, so the old buffer cannot be reused
+            m_instanceBuffer.Reset();
+            m_instanceRing.Release();
+        }
+
+        m_aVoxelInstanceData = std::move(aInstanceData);
+        m_aInstanceData.clear();
+        m_eInstanceLayout = eInstanceLayout::VOXEL;
+
+        markInstancesDirty(0u, GetNumInstances());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::SetInstance
+
+      Summary:  Overwrites a single instance
+
+      Args:     UINT uIndex
+                  Index of the instance
+                const InstanceData& instanceData
+                  New instance data
+
+      Modifies: [m_aInstanceData, m_instanceRing].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void InstancedRenderable::SetInstance(_In_ UINT uIndex, _In_ const InstanceData& instanceData)
+    {
+        assert(m_eInstanceLayout == eInstanceLayout::TRANSFORM && uIndex < m_aInstanceData.size());
+
+        m_aInstanceData[uIndex] = instanceData;
+        markInstancesDirty(uIndex, uIndex + 1u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::SetInstance
+
+      Summary:  Overwrites a single instance of the compact voxel layout
+
+      Args:     UINT uIndex
+                  Index of the instance
+                const VoxelInstanceData& instanceData
+                  New instance data
+
+      Modifies: [m_aVoxelInstanceData, m_instanceRing].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void InstancedRenderable::SetInstance(_In_ UINT uIndex, _In_ const VoxelInstanceData& instanceData)
+    {
+        assert(m_eInstanceLayout == eInstanceLayout::VOXEL && uIndex < m_aVoxelInstanceData.size());
+
+        m_aVoxelInstanceData[uIndex] = instanceData;
+        markInstancesDirty(uIndex, uIndex + 1u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::AddInstance
+
+      Summary:  Appends an instance. The instance buffer grows on the
+                next UpdateInstanceBuffer if it is full
+
+      Args:     const InstanceData& instanceData
+                  Instance data to append
+
+      Modifies: [m_aInstanceData, m_instanceRing].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void InstancedRenderable::AddInstance(_In_ const InstanceData& instanceData)
+    {
+        assert(m_eInstanceLayout == eInstanceLayout::TRANSFORM);
+
+        m_aInstanceData.push_back(instanceData);
+        markInstancesDirty(GetNumInstances() - 1u, GetNumInstances());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::AddInstance
+
+      Summary:  Appends an instance of the compact voxel layout. The
+                instance buffer grows on the next UpdateInstanceBuffer
+                if it is full
+
+      Args:     const VoxelInstanceData& instanceData
+                  Instance data to append
+
+      Modifies: [m_aVoxelInstanceData, m_instanceRing].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void InstancedRenderable::AddInstance(_In_ const VoxelInstanceData& instanceData)
+    {
+        assert(m_eInstanceLayout == eInstanceLayout::VOXEL);
+
+        m_aVoxelInstanceData.push_back(instanceData);
+        markInstancesDirty(GetNumInstances() - 1u, GetNumInstances());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::SetDynamic
+
+      Summary:  Selects between a dynamic instance buffer, rewritten
+                into a new ring segment whenever it changes, and a
+                default one, patched in place over the dirty range.
+                Instances that change every frame should be dynamic
+
+      Args:     BOOL bDynamic
+                  TRUE to use a dynamic instance buffer
+
+      Modifies: [m_instanceBuffer, m_instanceRing].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void InstancedRenderable::SetDynamic(_In_ BOOL bDynamic)
+    {
+        // The buffer is recreated with the new usage on the next update
+        if (m_instanceRing.SetDynamic(bDynamic != FALSE, GetNumInstances()))
+        {
+            m_instanceBuffer.Reset();
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::UpdateInstanceBuffer
+
+      Summary:  Uploads the instances changed since the last update.
+                The buffer doubles its capacity when the instances no
+                longer fit. A dynamic buffer writes every instance into
+                the next ring segment without overwriting the segments
+                the GPU may still be reading, and discards the whole
+                buffer when the ring wraps. A default buffer only
+                copies the dirty range
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffer
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to upload the instances
+
+      Modifies: [m_instanceBuffer, m_instanceRing].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT InstancedRenderable::UpdateInstanceBuffer(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
+    {
+        HRESULT hr = S_OK;
+
+        const UINT uNumInstances = GetNumInstances();
+        if (uNumInstances == 0u)
+        {
+            return S_OK;
+        }
+
+        if (!m_instanceBuffer || m_instanceRing.NeedsBuffer(uNumInstances))
+        {
+            hr = createInstanceBuffer(pDevice, m_instanceRing.GetGrownCapacity(uNumInstances));
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        const UINT uStride = GetInstanceStride();
+        const InstanceUpload upload = m_instanceRing.BeginUpload(uNumInstances, uStride);
+        if (!upload.bUpload)
+        {
+            return S_OK;
+        }
+
+        const BYTE* pInstances = getInstanceData() + static_cast<size_t>(upload.uBegin) * uStride;
+        if (m_instanceRing.IsDynamic())
+        {
+            D3D11_MAPPED_SUBRESOURCE mappedResource;
+            hr = pImmediateContext->Map(
+                m_instanceBuffer.Get(),
+                0u,
+                upload.bDiscard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE,
+                0u,
+                &mappedResource
+            );
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            memcpy(static_cast<BYTE*>(mappedResource.pData) + upload.uByteOffset, pInstances, static_cast<size_t>(uStride) * (upload.uEnd - upload.uBegin));
+
+            pImmediateContext->Unmap(m_instanceBuffer.Get(), 0u);
+        }
+        else
+        {
+            D3D11_BOX box =
+            {
+                .left = upload.uByteOffset,
+                .top = 0u,
+                .front = 0u,
+                .right = upload.uByteOffset + (upload.uEnd - upload.uBegin) * uStride,
+                .bottom = 1u,
+                .back = 1u
+            };
+            pImmediateContext->UpdateSubresource(m_instanceBuffer.Get(), 0u, &box, pInstances, 0u, 0u);
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::HasDirtyInstances
+
+      Summary:  Returns whether instances were set or added since the
+                last UpdateInstanceBuffer
+
+      Returns:  BOOL
+                  TRUE if there are instances to upload
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL InstancedRenderable::HasDirtyInstances() const
+    {
+        return m_instanceRing.HasDirtyInstances();
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -78,43 +362,305 @@ namespace library
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     UINT InstancedRenderable::GetNumInstances() const
     {
-        return m_aInstanceData.size();
+        if (m_eInstanceLayout == eInstanceLayout::VOXEL)
+        {
+            return static_cast<UINT>(m_aVoxelInstanceData.size());
+        }
+
+        return static_cast<UINT>(m_aInstanceData.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::GetInstanceLayout
+
+      Summary:  Returns the layout of the instance buffer
+
+      Returns:  eInstanceLayout
+                  Instance layout
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    eInstanceLayout InstancedRenderable::GetInstanceLayout() const
+    {
+        return m_eInstanceLayout;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::GetInstanceStride
+
+      Summary:  Returns the size of a single instance in bytes, to be
+                used as the stride of the instance buffer
+
+      Returns:  UINT
+                  Instance stride
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT InstancedRenderable::GetInstanceStride() const
+    {
+        if (m_eInstanceLayout == eInstanceLayout::VOXEL)
+        {
+            return sizeof(VoxelInstanceData);
+        }
+
+        return sizeof(InstanceData);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::GetInstanceOffset
+
+      Summary:  Returns the byte offset of the current instances in the
+                instance buffer, to be used when binding it
+
+      Returns:  UINT
+                  Instance offset
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT InstancedRenderable::GetInstanceOffset() const
+    {
+        return m_instanceRing.GetOffset(GetInstanceStride());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::IsDynamic
+
+      Summary:  Returns whether the instance buffer is dynamic
+
+      Returns:  BOOL
+                  TRUE if the instance buffer is dynamic
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL InstancedRenderable::IsDynamic() const
+    {
+        return m_instanceRing.IsDynamic();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::GetLocalBounds
+
+      Summary:  Returns the bounding box of every instance, before the
+                world matrix is applied. The bounds are refreshed over
+                the instances changed since the last call
+
+      Modifies: [m_instanceBounds, m_uBoundsDirtyBegin,
+                 m_uBoundsDirtyEnd, m_bInstanceBoundsValid].
+
+      Returns:  const BoundingBox&
+                  Local bounding box of the instances
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const BoundingBox& InstancedRenderable::GetLocalBounds()
+    {
+        const UINT uNumInstances = GetNumInstances();
+        if (!m_bInstanceBoundsValid)
+        {
+            growInstanceBounds(0u, uNumInstances);
+        }
+        else if (m_uBoundsDirtyBegin < m_uBoundsDirtyEnd)
+        {
+            growInstanceBounds(m_uBoundsDirtyBegin, (std::min)(m_uBoundsDirtyEnd, uNumInstances));
+        }
+        m_uBoundsDirtyBegin = 0u;
+        m_uBoundsDirtyEnd = 0u;
+
+        return m_bInstanceBoundsValid ? m_instanceBounds : m_localBounds;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   InstancedRenderable::initializeInstance
 
-      Summary:  Creates an instance buffer
+      Summary:  Creates an instance buffer that fits the current
+                instances. Nothing is created while there are no
+                instances, the buffer is then created on the first
+                UpdateInstanceBuffer
 
       Args:     ID3D11Device* pDevice
                   Pointer to a Direct3D 11 device
 
-      Modifies: [m_instanceBuffer].
+      Modifies: [m_instanceBuffer, m_instanceRing].
 
       Returns:  HRESULT
                   Status code
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT InstancedRenderable::initializeInstance(_In_ ID3D11Device* pDevice)
+    {
+        if (GetNumInstances() == 0u)
+        {
+            return S_OK;
+        }
+
+        return createInstanceBuffer(pDevice, GetNumInstances());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::createInstanceBuffer
+
+      Summary:  Creates an instance buffer that holds uCapacity
+                instances, NUM_RING_SEGMENTS times over if it is
+                dynamic. The instances are uploaded right away when
+                they fill the buffer, otherwise they are marked dirty
+
+      Args:     ID3D11Device* pDevice
+                  Pointer to a Direct3D 11 device
+                UINT uCapacity
+                  Number of instances the buffer can hold
+
+      Modifies: [m_instanceBuffer, m_instanceRing].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT InstancedRenderable::createInstanceBuffer(_In_ ID3D11Device* pDevice, _In_ UINT uCapacity)
     {
         HRESULT hr = S_OK;
 
+        if (uCapacity == 0u)
+        {
+            return E_INVALIDARG;
+        }
+
+        m_instanceBuffer.Reset();
+        m_instanceRing.Release();
+
+        const BOOL bDynamic = m_instanceRing.IsDynamic();
         D3D11_BUFFER_DESC instBuffDesc =
         {
-            .ByteWidth = sizeof(InstanceData) * GetNumInstances(),
-            .Usage = D3D11_USAGE_DEFAULT,
+            .ByteWidth = m_instanceRing.GetBufferSize(uCapacity, GetInstanceStride()),
+            .Usage = bDynamic ? D3D11_USAGE_DYNAMIC : D3D11_USAGE_DEFAULT,
             .BindFlags = D3D11_BIND_VERTEX_BUFFER,
-            .CPUAccessFlags = 0
+            .CPUAccessFlags = bDynamic ? static_cast<UINT>(D3D11_CPU_ACCESS_WRITE) : 0u
         };
 
-        D3D11_SUBRESOURCE_DATA instData;
-        ZeroMemory(&instData, sizeof(instData));
-        instData.pSysMem = &m_aInstanceData[0];
-
-        hr = pDevice->CreateBuffer(&instBuffDesc, &instData, m_instanceBuffer.GetAddressOf());
+        if (m_instanceRing.IsFilledOnCreation(uCapacity, GetNumInstances()))
+        {
+            D3D11_SUBRESOURCE_DATA instData;
+            ZeroMemory(&instData, sizeof(instData));
+            instData.pSysMem = getInstanceData();
 
+            hr = pDevice->CreateBuffer(&instBuffDesc, &instData, m_instanceBuffer.GetAddressOf());
+        }
+        else
+        {
+            hr = pDevice->CreateBuffer(&instBuffDesc, nullptr, m_instanceBuffer.GetAddressOf());
+        }
         if (FAILED(hr))
             return hr;
 
+        m_instanceRing.OnBufferCreated(uCapacity, GetNumInstances());
+
         return S_OK;
     }
-}
\ No newline at end of file
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::markInstancesDirty
+
+      Summary:  Extends the range of instances to upload on the next
+                UpdateInstanceBuffer
+
+      Args:     UINT uBegin
+                  Index of the first changed instance
+                UINT uEnd
+                  One past the index of the last changed instance
+
+      Modifies: [m_instanceRing, m_uBoundsDirtyBegin,
+                 m_uBoundsDirtyEnd, m_bInstanceBoundsValid].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void InstancedRenderable::markInstancesDirty(_In_ UINT uBegin, _In_ UINT uEnd)
+    {
+        if (uBegin >= uEnd)
+        {
+            return;
+        }
+
+        // Changed instances only grow the bounds, rewriting every instance lets them shrink again
+        if (uBegin == 0u && uEnd >= GetNumInstances())
+        {
+            m_bInstanceBoundsValid = FALSE;
+        }
+        else if (m_uBoundsDirtyBegin >= m_uBoundsDirtyEnd)
+        {
+            m_uBoundsDirtyBegin = uBegin;
+            m_uBoundsDirtyEnd = uEnd;
+        }
+        else
+        {
+            m_uBoundsDirtyBegin = (std::min)(m_uBoundsDirtyBegin, uBegin);
+            m_uBoundsDirtyEnd = (std::max)(m_uBoundsDirtyEnd, uEnd);
+        }
+
+        m_instanceRing.MarkDirty(uBegin, uEnd);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::growInstanceBounds
+
+      Summary:  Extends the instance bounds over the bounds of the mesh
+                placed at each instance of a range. Voxel instances
+                only translate the mesh, so the box of their offsets is
+                enough
+
+      Args:     UINT uBegin
+                  Index of the first instance
+                UINT uEnd
+                  One past the index of the last instance
+
+      Modifies: [m_instanceBounds, m_bInstanceBoundsValid].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void InstancedRenderable::growInstanceBounds(_In_ UINT uBegin, _In_ UINT uEnd)
+    {
+        if (uBegin >= uEnd)
+        {
+            return;
+        }
+
+        BoundingBox bounds;
+        if (m_eInstanceLayout == eInstanceLayout::VOXEL)
+        {
+            XMVECTOR minOffset = g_XMFltMax;
+            XMVECTOR maxOffset = XMVectorNegate(g_XMFltMax);
+            for (UINT i = uBegin; i < uEnd; ++i)
+            {
+                const VoxelInstanceData& voxel = m_aVoxelInstanceData[i];
+                const XMVECTOR offset = XMVectorSet(static_cast<FLOAT>(voxel.X), static_cast<FLOAT>(voxel.Y), static_cast<FLOAT>(voxel.Z), 0.0f);
+                minOffset = XMVectorMin(minOffset, offset);
+                maxOffset = XMVectorMax(maxOffset, offset);
+            }
+
+            const XMVECTOR center = XMLoadFloat3(&m_localBounds.Center);
+            const XMVECTOR extents = XMLoadFloat3(&m_localBounds.Extents);
+            BoundingBox::CreateFromPoints(bounds, XMVectorAdd(XMVectorSubtract(center, extents), minOffset), XMVectorAdd(XMVectorAdd(center, extents), maxOffset));
+        }
+        else
+        {
+            m_localBounds.Transform(bounds, m_aInstanceData[uBegin].Transformation);
+            for (UINT i = uBegin + 1u; i < uEnd; ++i)
+            {
+                BoundingBox instanceBounds;
+                m_localBounds.Transform(instanceBounds, m_aInstanceData[i].Transformation);
+                BoundingBox::CreateMerged(bounds, bounds, instanceBounds);
+            }
+        }
+
+        if (m_bInstanceBoundsValid)
+        {
+            BoundingBox::CreateMerged(m_instanceBounds, m_instanceBounds, bounds);
+        }
+        else
+        {
+            m_instanceBounds = bounds;
+            m_bInstanceBoundsValid = TRUE;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::getInstanceData
+
+      Summary:  Returns the pointer to the instance data of the current
+                layout
+
+      Returns:  const BYTE*
+                  Pointer to the instance data
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const BYTE* InstancedRenderable::getInstanceData() const
+    {
+        if (m_eInstanceLayout == eInstanceLayout::VOXEL)
+        {
+            return reinterpret_cast<const BYTE*>(m_aVoxelInstanceData.data());
+        }
+
+        return reinterpret_cast<const BYTE*>(m_aInstanceData.data());
+    }
+}
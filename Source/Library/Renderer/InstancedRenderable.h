@@ -14,6 +14,7 @@
 #include "Common.h"
 
 #include "Renderer/DataTypes.h"
+#include "Renderer/InstanceBufferRing.h"
 #include "Renderer/Renderable.h"
 
 namespace library
@@ -29,8 +30,37 @@ namespace library
                   Returns a instance buffer
                 GetNumInstances
                   Returns the number of instance data
+                SetInstance
+                  Overwrites a single instance
+                AddInstance
+                  Appends an instance
+                SetDynamic
+                  Selects the dynamic or the default instance buffer
+                UpdateInstanceBuffer
+                  Uploads the instances changed since the last update
+                HasDirtyInstances
+                  Returns whether instances changed since the last
+                  update
+                GetInstanceLayout
+                  Returns the layout of the instance buffer
+                GetInstanceStride
+                  Returns the size of a single instance in bytes
+                GetInstanceOffset
+                  Returns the byte offset of the current instances
+                IsDynamic
+                  Returns whether the instance buffer is dynamic
+                GetLocalBounds
+                  Returns the bounding box of every instance
                 initializeInstance
                   Initialize the instance buffer
+                createInstanceBuffer
+                  Creates an instance buffer of the given capacity
+                markInstancesDirty
+                  Extends the range of instances to upload
+                growInstanceBounds
+                  Extends the bounds over a range of instances
+                getInstanceData
+                  Returns the pointer to the instance data
                 InstancedRenderable
                   Constructor.
                 ~InstancedRenderable
@@ -39,8 +69,11 @@ namespace library
     class InstancedRenderable : public Renderable
     {
     public:
+        static constexpr const UINT NUM_RING_SEGMENTS = InstanceBufferRing::NUM_SEGMENTS;
+
         InstancedRenderable(_In_ const XMFLOAT4& outputColor);
         InstancedRenderable(_In_ std::vector<InstanceData>&& aInstanceData, _In_ const XMFLOAT4& outputColor);
+        InstancedRenderable(_In_ std::vector<VoxelInstanceData>&& aInstanceData, _In_ const XMFLOAT4& outputColor);
         InstancedRenderable(const InstancedRenderable& other) = delete;
         InstancedRenderable(InstancedRenderable&& other) = delete;
         InstancedRenderable& operator=(const InstancedRenderable& other) = delete;
@@ -51,9 +84,24 @@ namespace library
         virtual void Update(_In_ FLOAT deltaTime) override = 0;
 
         void SetInstanceData(_In_ std::vector<InstanceData>&& aInstanceData);
+        void SetInstanceData(_In_ std::vector<VoxelInstanceData>&& aInstanceData);
+        void SetInstance(_In_ UINT uIndex, _In_ const InstanceData& instanceData);
+        void SetInstance(_In_ UINT uIndex, _In_ const VoxelInstanceData& instanceData);
+        void AddInstance(_In_ const InstanceData& instanceData);
+        void AddInstance(_In_ const VoxelInstanceData& instanceData);
+        void SetDynamic(_In_ BOOL bDynamic);
+
+        HRESULT UpdateInstanceBuffer(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext);
+        BOOL HasDirtyInstances() const;
 
         virtual ComPtr<ID3D11Buffer>& GetInstanceBuffer();
         virtual UINT GetNumInstances() const;
+        eInstanceLayout GetInstanceLayout() const;
+        UINT GetInstanceStride() const;
+        UINT GetInstanceOffset() const;
+        BOOL IsDynamic() const;
+
+        const BoundingBox& GetLocalBounds() override;
 
         UINT GetNumVertices() const override = 0;
         UINT GetNumIndices() const override = 0;
@@ -64,9 +112,22 @@ namespace library
 
         virtual HRESULT initializeInstance(_In_ ID3D11Device* pDevice);
 
+        HRESULT createInstanceBuffer(_In_ ID3D11Device* pDevice, _In_ UINT uCapacity);
+        void markInstancesDirty(_In_ UINT uBegin, _In_ UINT uEnd);
+        void growInstanceBounds(_In_ UINT uBegin, _In_ UINT uEnd);
+        const BYTE* getInstanceData() const;
+
     protected:
         ComPtr<ID3D11Buffer> m_instanceBuffer;
         std::vector<InstanceData> m_aInstanceData;
+        std::vector<VoxelInstanceData> m_aVoxelInstanceData;
+        eInstanceLayout m_eInstanceLayout;
+        InstanceBufferRing m_instanceRing;
+
+        BoundingBox m_instanceBounds;
+        UINT m_uBoundsDirtyBegin;
+        UINT m_uBoundsDirtyEnd;
+        BOOL m_bInstanceBoundsValid;
 
     private:
         BYTE m_padding[8];
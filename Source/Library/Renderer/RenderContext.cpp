@@ -0,0 +1,178 @@
+#include "Renderer/RenderContext.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderContext::NullRenderContext
+
+      Summary:  Constructor
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    NullRenderContext::NullRenderContext()
+        : m_stats()
+    {
+    }
+
+    void NullRenderContext::ClearRenderTargetView(ID3D11RenderTargetView* pRenderTargetView, const float aColor[4])
+    {
+        static_cast<void>(pRenderTargetView);
+        static_cast<void>(aColor);
+        ++m_stats.uNumClears;
+    }
+
+    void NullRenderContext::ClearDepthStencilView(ID3D11DepthStencilView* pDepthStencilView, uint32_t uClearFlags, float depth, uint8_t uStencil)
+    {
+        static_cast<void>(pDepthStencilView);
+        static_cast<void>(uClearFlags);
+        static_cast<void>(depth);
+        static_cast<void>(uStencil);
+        ++m_stats.uNumClears;
+    }
+
+    void NullRenderContext::UpdateBuffer(ID3D11Buffer* pBuffer, const void* pData, uint32_t uDataSize)
+    {
+        static_cast<void>(pBuffer);
+        static_cast<void>(pData);
+        ++m_stats.uNumUpdates;
+        m_stats.uNumUpdatedBytes += uDataSize;
+    }
+
+    void NullRenderContext::CopySubresource(ID3D11Resource* pDstResource, uint32_t uDstSubresource, ID3D11Resource* pSrcResource, uint32_t uSrcSubresource)
+    {
+        static_cast<void>(pDstResource);
+        static_cast<void>(uDstSubresource);
+        static_cast<void>(pSrcResource);
+        static_cast<void>(uSrcSubresource);
+        ++m_stats.uNumUpdates;
+    }
+
+    void NullRenderContext::SetRenderTargets(ID3D11RenderTargetView* pRenderTargetView, ID3D11DepthStencilView* pDepthStencilView)
+    {
+        static_cast<void>(pRenderTargetView);
+        static_cast<void>(pDepthStencilView);
+        ++m_stats.uNumStateCalls;
+    }
+
+    void NullRenderContext::SetViewport(const Viewport& viewport)
+    {
+        static_cast<void>(viewport);
+        ++m_stats.uNumStateCalls;
+    }
+
+    void NullRenderContext::SetInputLayout(ID3D11InputLayout* pInputLayout)
+    {
+        static_cast<void>(pInputLayout);
+        ++m_stats.uNumStateCalls;
+    }
+
+    void NullRenderContext::SetPrimitiveTopology(uint32_t uTopology)
+    {
+        static_cast<void>(uTopology);
+        ++m_stats.uNumStateCalls;
+    }
+
+    void NullRenderContext::SetVertexBuffer(uint32_t uSlot, ID3D11Buffer* pBuffer, uint32_t uStride, uint32_t uOffset)
+    {
+        static_cast<void>(uSlot);
+        static_cast<void>(pBuffer);
+        static_cast<void>(uStride);
+        static_cast<void>(uOffset);
+        ++m_stats.uNumStateCalls;
+    }
+
+    void NullRenderContext::SetIndexBuffer(ID3D11Buffer* pBuffer, uint32_t uFormat)
+    {
+        static_cast<void>(pBuffer);
+        static_cast<void>(uFormat);
+        ++m_stats.uNumStateCalls;
+    }
+
+    void NullRenderContext::SetVertexShader(ID3D11VertexShader* pVertexShader)
+    {
+        static_cast<void>(pVertexShader);
+        ++m_stats.uNumStateCalls;
+    }
+
+    void NullRenderContext::SetPixelShader(ID3D11PixelShader* pPixelShader)
+    {
+        static_cast<void>(pPixelShader);
+        ++m_stats.uNumStateCalls;
+    }
+
+    void NullRenderContext::SetVSConstantBuffer(uint32_t uSlot, ID3D11Buffer* pBuffer, uint32_t uFirstConstant, uint32_t uNumConstants)
+    {
+        static_cast<void>(uSlot);
+        static_cast<void>(pBuffer);
+        static_cast<void>(uFirstConstant);
+        static_cast<void>(uNumConstants);
+        ++m_stats.uNumStateCalls;
+    }
+
+    void NullRenderContext::SetPSConstantBuffer(uint32_t uSlot, ID3D11Buffer* pBuffer, uint32_t uFirstConstant, uint32_t uNumConstants)
+    {
+        static_cast<void>(uSlot);
+        static_cast<void>(pBuffer);
+        static_cast<void>(uFirstConstant);
+        static_cast<void>(uNumConstants);
+        ++m_stats.uNumStateCalls;
+    }
+
+    void NullRenderContext::SetPSShaderResource(uint32_t uSlot, ID3D11ShaderResourceView* pShaderResourceView)
+    {
+        static_cast<void>(uSlot);
+        static_cast<void>(pShaderResourceView);
+        ++m_stats.uNumStateCalls;
+    }
+
+    void NullRenderContext::SetPSSampler(uint32_t uSlot, ID3D11SamplerState* pSampler)
+    {
+        static_cast<void>(uSlot);
+        static_cast<void>(pSampler);
+        ++m_stats.uNumStateCalls;
+    }
+
+    void NullRenderContext::DrawIndexed(uint32_t uNumIndices, uint32_t uStartIndex, int32_t iBaseVertex)
+    {
+        static_cast<void>(uNumIndices);
+        static_cast<void>(uStartIndex);
+        static_cast<void>(iBaseVertex);
+        ++m_stats.uNumDraws;
+    }
+
+    void NullRenderContext::DrawIndexedInstanced(uint32_t uNumIndices, uint32_t uNumInstances, uint32_t uStartIndex, int32_t iBaseVertex, uint32_t uStartInstance)
+    {
+        static_cast<void>(uNumIndices);
+        static_cast<void>(uNumInstances);
+        static_cast<void>(uStartIndex);
+        static_cast<void>(iBaseVertex);
+        static_cast<void>(uStartInstance);
+        ++m_stats.uNumDraws;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderContext::ResetStats
+
+      Summary:  Resets the counters
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderContext::ResetStats()
+    {
+        m_stats = { .uNumClears = 0u, .uNumUpdates = 0u, .uNumUpdatedBytes = 0u, .uNumStateCalls = 0u, .uNumDraws = 0u };
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderContext::GetStats
+
+      Summary:  Returns the number of calls discarded since the last
+                ResetStats
+
+      Returns:  const NullRenderContextStats&
+                  Counters
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const NullRenderContextStats& NullRenderContext::GetStats() const
+    {
+        return m_stats;
+    }
+}
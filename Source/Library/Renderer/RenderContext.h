@@ -0,0 +1,185 @@
+/*+===================================================================
+  File:      RENDERCONTEXT.H
+
+  Summary:   RenderContext header file contains declarations of
+             IRenderContext interface and NullRenderContext class used
+             for the lab samples of Game Graphics Programming course.
+             Only depends on the standard library, the Direct3D objects
+             are opaque handles here.
+
+  Classes: IRenderContext, NullRenderContext
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <cstdint>
+
+struct ID3D11Buffer;
+struct ID3D11DepthStencilView;
+struct ID3D11InputLayout;
+struct ID3D11PixelShader;
+struct ID3D11RenderTargetView;
+struct ID3D11Resource;
+struct ID3D11SamplerState;
+struct ID3D11ShaderResourceView;
+struct ID3D11VertexShader;
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   Viewport
+
+      Summary:  Viewport of a render context, laid out like
+                D3D11_VIEWPORT
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct Viewport
+    {
+        float TopLeftX;
+        float TopLeftY;
+        float Width;
+        float Height;
+        float MinDepth;
+        float MaxDepth;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    IRenderContext
+
+      Summary:  Interface of the pipeline state bindings, buffer updates
+                and draw calls the renderer issues. Implementations may
+                forward them to Direct3D, filter them or record them.
+                Topologies are D3D11_PRIMITIVE_TOPOLOGY values and index
+                formats DXGI_FORMAT values
+
+      Methods:  ClearRenderTargetView
+                  Clears a render target
+                ClearDepthStencilView
+                  Clears a depth stencil buffer
+                UpdateBuffer
+                  Replaces the whole content of a buffer
+                CopySubresource
+                  Copies a whole subresource into another
+                SetRenderTargets
+                  Binds a render target and a depth stencil buffer
+                SetViewport
+                  Sets the viewport
+                SetInputLayout
+                  Binds an input layout
+                SetPrimitiveTopology
+                  Sets the primitive topology
+                SetVertexBuffer
+                  Binds a vertex buffer to a slot
+                SetIndexBuffer
+                  Binds an index buffer
+                SetVertexShader
+                  Binds a vertex shader
+                SetPixelShader
+                  Binds a pixel shader
+                SetVSConstantBuffer
+                  Binds a constant buffer, or a range of it, to the
+                  vertex shader
+                SetPSConstantBuffer
+                  Binds a constant buffer, or a range of it, to the
+                  pixel shader
+                SetPSShaderResource
+                  Binds a shader resource view to the pixel shader
+                SetPSSampler
+                  Binds a sampler state to the pixel shader
+                DrawIndexed
+                  Draws indexed primitives
+                DrawIndexedInstanced
+                  Draws indexed, instanced primitives
+                ~IRenderContext
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class IRenderContext
+    {
+    public:
+        virtual ~IRenderContext() = default;
+
+        virtual void ClearRenderTargetView(ID3D11RenderTargetView* pRenderTargetView, const float aColor[4]) = 0;
+        virtual void ClearDepthStencilView(ID3D11DepthStencilView* pDepthStencilView, uint32_t uClearFlags, float depth, uint8_t uStencil) = 0;
+        virtual void UpdateBuffer(ID3D11Buffer* pBuffer, const void* pData, uint32_t uDataSize) = 0;
+        virtual void CopySubresource(ID3D11Resource* pDstResource, uint32_t uDstSubresource, ID3D11Resource* pSrcResource, uint32_t uSrcSubresource) = 0;
+        virtual void SetRenderTargets(ID3D11RenderTargetView* pRenderTargetView, ID3D11DepthStencilView* pDepthStencilView) = 0;
+        virtual void SetViewport(const Viewport& viewport) = 0;
+        virtual void SetInputLayout(ID3D11InputLayout* pInputLayout) = 0;
+        virtual void SetPrimitiveTopology(uint32_t uTopology) = 0;
+        virtual void SetVertexBuffer(uint32_t uSlot, ID3D11Buffer* pBuffer, uint32_t uStride, uint32_t uOffset) = 0;
+        virtual void SetIndexBuffer(ID3D11Buffer* pBuffer, uint32_t uFormat) = 0;
+        virtual void SetVertexShader(ID3D11VertexShader* pVertexShader) = 0;
+        virtual void SetPixelShader(ID3D11PixelShader* pPixelShader) = 0;
+        virtual void SetVSConstantBuffer(uint32_t uSlot, ID3D11Buffer* pBuffer, uint32_t uFirstConstant, uint32_t uNumConstants) = 0;
+        virtual void SetPSConstantBuffer(uint32_t uSlot, ID3D11Buffer* pBuffer, uint32_t uFirstConstant, uint32_t uNumConstants) = 0;
+        virtual void SetPSShaderResource(uint32_t uSlot, ID3D11ShaderResourceView* pShaderResourceView) = 0;
+        virtual void SetPSSampler(uint32_t uSlot, ID3D11SamplerState* pSampler) = 0;
+        virtual void DrawIndexed(uint32_t uNumIndices, uint32_t uStartIndex, int32_t iBaseVertex) = 0;
+        virtual void DrawIndexedInstanced(uint32_t uNumIndices, uint32_t uNumInstances, uint32_t uStartIndex, int32_t iBaseVertex, uint32_t uStartInstance) = 0;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   NullRenderContextStats
+
+      Summary:  Number of calls a NullRenderContext discarded
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct NullRenderContextStats
+    {
+        uint32_t uNumClears;
+        uint32_t uNumUpdates;
+        uint32_t uNumUpdatedBytes;
+        uint32_t uNumStateCalls;
+        uint32_t uNumDraws;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    NullRenderContext
+
+      Summary:  Counts and discards every call, so the frame can be
+                built and measured without a device
+
+      Methods:  ResetStats
+                  Resets the counters
+                GetStats
+                  Returns the counters
+                NullRenderContext
+                  Constructor.
+                ~NullRenderContext
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class NullRenderContext final : public IRenderContext
+    {
+    public:
+        NullRenderContext();
+        NullRenderContext(const NullRenderContext& other) = delete;
+        NullRenderContext(NullRenderContext&& other) = delete;
+        NullRenderContext& operator=(const NullRenderContext& other) = delete;
+        NullRenderContext& operator=(NullRenderContext&& other) = delete;
+        ~NullRenderContext() = default;
+
+        void ClearRenderTargetView(ID3D11RenderTargetView* pRenderTargetView, const float aColor[4]) override;
+        void ClearDepthStencilView(ID3D11DepthStencilView* pDepthStencilView, uint32_t uClearFlags, float depth, uint8_t uStencil) override;
+        void UpdateBuffer(ID3D11Buffer* pBuffer, const void* pData, uint32_t uDataSize) override;
+        void CopySubresource(ID3D11Resource* pDstResource, uint32_t uDstSubresource, ID3D11Resource* pSrcResource, uint32_t uSrcSubresource) override;
+        void SetRenderTargets(ID3D11RenderTargetView* pRenderTargetView, ID3D11DepthStencilView* pDepthStencilView) override;
+        void SetViewport(const Viewport& viewport) override;
+        void SetInputLayout(ID3D11InputLayout* pInputLayout) override;
+        void SetPrimitiveTopology(uint32_t uTopology) override;
+        void SetVertexBuffer(uint32_t uSlot, ID3D11Buffer* pBuffer, uint32_t uStride, uint32_t uOffset) override;
+        void SetIndexBuffer(ID3D11Buffer* pBuffer, uint32_t uFormat) override;
+        void SetVertexShader(ID3D11VertexShader* pVertexShader) override;
+        void SetPixelShader(ID3D11PixelShader* pPixelShader) override;
+        void SetVSConstantBuffer(uint32_t uSlot, ID3D11Buffer* pBuffer, uint32_t uFirstConstant, uint32_t uNumConstants) override;
+        void SetPSConstantBuffer(uint32_t uSlot, ID3D11Buffer* pBuffer, uint32_t uFirstConstant, uint32_t uNumConstants) override;
+        void SetPSShaderResource(uint32_t uSlot, ID3D11ShaderResourceView* pShaderResourceView) override;
+        void SetPSSampler(uint32_t uSlot, ID3D11SamplerState* pSampler) override;
+        void DrawIndexed(uint32_t uNumIndices, uint32_t uStartIndex, int32_t iBaseVertex) override;
+        void DrawIndexedInstanced(uint32_t uNumIndices, uint32_t uNumInstances, uint32_t uStartIndex, int32_t iBaseVertex, uint32_t uStartInstance) override;
+
+        void ResetStats();
+        const NullRenderContextStats& GetStats() const;
+
+    private:
+        NullRenderContextStats m_stats;
+    };
+}
@@ -0,0 +1,396 @@
+#include "Renderer/RenderQueue.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "Renderer/StateCache.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderQueue::RenderQueue
+
+      Summary:  Constructor
+
+      Modifies: [m_aItems, m_aEntries, m_aScratch, m_stateIds,
+                 m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    RenderQueue::RenderQueue()
+        : m_aItems()
+        , m_aEntries()
+        , m_aScratch()
+        , m_stateIds()
+        , m_stats()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderQueue::MakeSortKey
+
+      Summary:  Builds the sort key of a draw item. Items of the same
+                pass are grouped by shaders, then by textures, then
+                drawn front to back
+
+      Args:     eRenderPass ePass
+                  Pass the item is drawn in
+                const DrawItem& item
+                  Draw item
+                float normalizedDepth
+                  Distance to the camera divided by the far plane
+
+      Modifies: [m_stateIds].
+
+      Returns:  uint64_t
+                  Sort key
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint64_t RenderQueue::MakeSortKey(eRenderPass ePass, const DrawItem& item, float normalizedDepth)
+    {
+        const float clampedDepth = normalizedDepth < 0.0f ? 0.0f : (normalizedDepth > 1.0f ? 1.0f : normalizedDepth);
+        const uint64_t uDepth = static_cast<uint64_t>(clampedDepth * static_cast<float>((1u << NUM_DEPTH_BITS) - 1u));
+
+        uint64_t uKey = static_cast<uint64_t>(ePass);
+        uKey = (uKey << NUM_SHADER_BITS) | getId(item.pVertexShader, NUM_SHADER_BITS);
+        uKey = (uKey << NUM_SHADER_BITS) | getId(item.pPixelShader, NUM_SHADER_BITS);
+        uKey = (uKey << NUM_TEXTURE_BITS) | getId(item.apShaderResourceViews[0], NUM_TEXTURE_BITS);
+        uKey = (uKey << NUM_TEXTURE_BITS) | getId(item.apShaderResourceViews[1], NUM_TEXTURE_BITS);
+        uKey = (uKey << NUM_DEPTH_BITS) | uDepth;
+
+        return uKey;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderQueue::Clear
+
+      Summary:  Removes every draw item and forgets the state ids,
+                keeping the allocations. State objects can be released
+                between frames and their addresses reused, so ids only
+                hold for the frame they were given in
+
+      Modifies: [m_aItems, m_aEntries, m_stateIds].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderQueue::Clear()
+    {
+        m_aItems.clear();
+        m_aEntries.clear();
+        m_stateIds.clear();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderQueue::Submit
+
+      Summary:  Adds a draw item
+
+      Args:     uint64_t uSortKey
+                  Sort key made by MakeSortKey
+                const DrawItem& item
+                  Draw item
+
+      Modifies: [m_aItems, m_aEntries].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderQueue::Submit(uint64_t uSortKey, const DrawItem& item)
+    {
+        m_aEntries.push_back(SortEntry{ .uKey = uSortKey, .uItemIdx = static_cast<uint32_t>(m_aItems.size()) });
+        m_aItems.push_back(item);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderQueue::IsEmpty
+
+      Summary:  Returns whether no draw item was submitted since the
+                last Clear
+
+      Returns:  bool
+                  true if there is nothing to draw
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    bool RenderQueue::IsEmpty() const
+    {
+        return m_aItems.empty();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderQueue::Sort
+
+      Summary:  Sorts the draw items by their key with a stable LSD
+                radix sort on 8-bit digits. Digits that are equal for
+                every item are skipped
+
+      Modifies: [m_aEntries, m_aScratch].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderQueue::Sort()
+    {
+        const size_t uNumEntries = m_aEntries.size();
+        if (uNumEntries < 2u)
+        {
+            return;
+        }
+
+        m_aScratch.resize(uNumEntries);
+
+        for (uint32_t uShift = 0u; uShift < 64u; uShift += 8u)
+        {
+            size_t auCounts[256] = {};
+            for (const SortEntry& entry : m_aEntries)
+            {
+                ++auCounts[(entry.uKey >> uShift) & 0xFFu];
+            }
+
+            if (auCounts[(m_aEntries[0].uKey >> uShift) & 0xFFu] == uNumEntries)
+            {
+                continue;
+            }
+
+            size_t uOffset = 0u;
+            for (size_t& uCount : auCounts)
+            {
+                const size_t uBucketSize = uCount;
+                uCount = uOffset;
+                uOffset += uBucketSize;
+            }
+
+            for (const SortEntry& entry : m_aEntries)
+            {
+                m_aScratch[auCounts[(entry.uKey >> uShift) & 0xFFu]++] = entry;
+            }
+
+            m_aEntries.swap(m_aScratch);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderQueue::Execute
+
+      Summary:  Issues the draw calls in sorted order. Every state an
+                item uses is bound through the render context, which
+                is expected to drop redundant binds. The per-frame
+                constant buffers and the primitive topology must be
+                bound by the caller
+
+      Args:     IRenderContext& renderContext
+                  Render context to draw with
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderQueue::Execute(IRenderContext& renderContext)
+    {
+        m_stats =
+        {
+            .uNumItems = static_cast<uint32_t>(m_aItems.size()),
+            .uNumDraws = executeRange(renderContext, 0u, m_aEntries.size()),
+            .uNumBuckets = 1u,
+            .uNumFallbackBuckets = 0u
+        };
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderQueue::ExecuteParallel
+
+      Summary:  Splits the sorted draw items into contiguous buckets,
+                records them on the threads of the worker pool, one
+                context per bucket, then executes the buckets in order.
+                Each bucket starts from an unknown state, so it is
+                filtered by its own state cache and fnBeginBucket binds
+                the per-frame states first. Buckets are at least
+                MIN_ITEMS_PER_BUCKET items long. A bucket that fails to
+                finish recording is issued on the fallback context in
+                its place, so the frame keeps every draw in order
+
+      Args:     ICommandRecorder& recorder
+                  Contexts to record the buckets on
+                WorkerPool& workerPool
+                  Threads to record on
+                IRenderContext& fallbackContext
+                  Render context the executed buckets run on, issued
+                  the buckets that failed to record
+                const std::function<void(IRenderContext&)>& fnBeginBucket
+                  Binds the per-frame states on a bucket context
+
+      Modifies: [m_stats].
+
+      Returns:  bool
+                  false if a bucket failed to finish recording
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    bool RenderQueue::ExecuteParallel(ICommandRecorder& recorder, WorkerPool& workerPool, IRenderContext& fallbackContext, const std::function<void(IRenderContext&)>& fnBeginBucket)
+    {
+        const size_t uNumEntries = m_aEntries.size();
+        const uint32_t uMaxBuckets = static_cast<uint32_t>((uNumEntries + MIN_ITEMS_PER_BUCKET - 1u) / MIN_ITEMS_PER_BUCKET);
+        const uint32_t uNumBuckets = (std::max)((std::min)({ recorder.GetNumContexts(), workerPool.GetNumThreads(), uMaxBuckets }), 1u);
+
+        struct BucketResult
+        {
+            uint32_t uNumDraws;
+            bool bRecorded;
+        };
+        std::vector<BucketResult> aResults(uNumBuckets, BucketResult{ .uNumDraws = 0u, .bRecorded = false });
+
+        auto getBucketRange = [uNumEntries, uNumBuckets](uint32_t uBucketIdx)
+        {
+            return std::make_pair(uNumEntries * uBucketIdx / uNumBuckets, uNumEntries * (uBucketIdx + 1u) / uNumBuckets);
+        };
+
+        workerPool.ParallelFor(uNumBuckets, [this, &recorder, &fnBeginBucket, &aResults, &getBucketRange](uint32_t uBucketIdx)
+        {
+            const auto [uBegin, uEnd] = getBucketRange(uBucketIdx);
+
+            StateCache stateCache(&recorder.BeginRecording(uBucketIdx));
+            fnBeginBucket(stateCache);
+            aResults[uBucketIdx].uNumDraws = executeRange(stateCache, uBegin, uEnd);
+            aResults[uBucketIdx].bRecorded = recorder.FinishRecording(uBucketIdx);
+        });
+
+        m_stats = { .uNumItems = static_cast<uint32_t>(uNumEntries), .uNumDraws = 0u, .uNumBuckets = uNumBuckets, .uNumFallbackBuckets = 0u };
+
+        for (uint32_t i = 0u; i < uNumBuckets; ++i)
+        {
+            if (aResults[i].bRecorded)
+            {
+                recorder.ExecuteRecorded(i);
+                m_stats.uNumDraws += aResults[i].uNumDraws;
+                continue;
+            }
+
+            // The context after an executed bucket is in an unknown state, like a bucket context
+            const auto [uBegin, uEnd] = getBucketRange(i);
+
+            StateCache stateCache(&fallbackContext);
+            fnBeginBucket(stateCache);
+            m_stats.uNumDraws += executeRange(stateCache, uBegin, uEnd);
+            ++m_stats.uNumFallbackBuckets;
+        }
+
+        return m_stats.uNumFallbackBuckets == 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderQueue::GetStats
+
+      Summary:  Returns the counters of the last executed frame
+
+      Returns:  const RenderQueueStats&
+                  Counters
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const RenderQueueStats& RenderQueue::GetStats() const
+    {
+        return m_stats;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderQueue::executeRange
+
+      Summary:  Issues the draw calls of a range of the sorted entries.
+                Only reads the queue, so ranges can be issued from
+                several threads at once
+
+      Args:     IRenderContext& renderContext
+                  Render context to draw with
+                size_t uBegin
+                  First sorted entry
+                size_t uEnd
+                  One past the last sorted entry
+
+      Returns:  uint32_t
+                  Number of draws issued
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t RenderQueue::executeRange(IRenderContext& renderContext, size_t uBegin, size_t uEnd) const
+    {
+        uint32_t uNumDraws = 0u;
+
+        for (size_t uEntryIdx = uBegin; uEntryIdx < uEnd; ++uEntryIdx)
+        {
+            const DrawItem& item = m_aItems[m_aEntries[uEntryIdx].uItemIdx];
+
+            if (item.pInputLayout)
+            {
+                renderContext.SetInputLayout(item.pInputLayout);
+            }
+            if (item.pVertexShader)
+            {
+                renderContext.SetVertexShader(item.pVertexShader);
+            }
+            if (item.pPixelShader)
+            {
+                renderContext.SetPixelShader(item.pPixelShader);
+            }
+
+            for (uint32_t uSlot = 0u; uSlot < NUM_DRAW_VERTEX_BUFFERS; ++uSlot)
+            {
+                if (item.apVertexBuffers[uSlot])
+                {
+                    renderContext.SetVertexBuffer(uSlot, item.apVertexBuffers[uSlot], item.auStrides[uSlot], item.auOffsets[uSlot]);
+                }
+            }
+
+            if (item.pIndexBuffer)
+            {
+                renderContext.SetIndexBuffer(item.pIndexBuffer, INDEX_FORMAT);
+            }
+            if (item.pObjectConstantBuffer)
+            {
+                renderContext.SetVSConstantBuffer(2u, item.pObjectConstantBuffer, item.uObjectFirstConstant, item.uObjectNumConstants);
+                renderContext.SetPSConstantBuffer(2u, item.pObjectConstantBuffer, item.uObjectFirstConstant, item.uObjectNumConstants);
+            }
+            if (item.pExtraConstantBuffer)
+            {
+                renderContext.SetVSConstantBuffer(4u, item.pExtraConstantBuffer, 0u, 0u);
+            }
+
+            for (uint32_t uSlot = 0u; uSlot < NUM_DRAW_SHADER_RESOURCES; ++uSlot)
+            {
+                if (item.apShaderResourceViews[uSlot])
+                {
+                    renderContext.SetPSShaderResource(uSlot, item.apShaderResourceViews[uSlot]);
+                }
+                if (item.apSamplers[uSlot])
+                {
+                    renderContext.SetPSSampler(uSlot, item.apSamplers[uSlot]);
+                }
+            }
+
+            if (item.uNumInstances > 0u)
+            {
+                renderContext.DrawIndexedInstanced(item.uNumIndices, item.uNumInstances, item.uStartIndex, item.iBaseVertex, 0u);
+            }
+            else
+            {
+                renderContext.DrawIndexed(item.uNumIndices, item.uStartIndex, item.iBaseVertex);
+            }
+            ++uNumDraws;
+        }
+
+        return uNumDraws;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderQueue::getId
+
+      Summary:  Returns a small id of a state object for the sort key.
+                Ids are given in the order the states are first seen
+                since the last Clear and wrap around to fit in
+                uNumBits, which only affects the order of the draws,
+                not their states
+
+      Args:     const void* pState
+                  State object, null gets the id 0
+                uint32_t uNumBits
+                  Number of bits of the id
+
+      Modifies: [m_stateIds].
+
+      Returns:  uint32_t
+                  Id of the state object
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t RenderQueue::getId(const void* pState, uint32_t uNumBits)
+    {
+        if (!pState)
+        {
+            return 0u;
+        }
+
+        auto it = m_stateIds.find(pState);
+        if (it == m_stateIds.end())
+        {
+            it = m_stateIds.emplace(pState, static_cast<uint32_t>(m_stateIds.size()) + 1u).first;
+        }
+
+        return it->second & ((1u << uNumBits) - 1u);
+    }
+}
@@ -0,0 +1,166 @@
+/*+===================================================================
+  File:      RENDERQUEUE.H
+
+  Summary:   RenderQueue header file contains declarations of
+             RenderQueue class used for the lab samples of Game
+             Graphics Programming course. Only depends on the
+             standard library.
+
+  Classes: RenderQueue
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "Renderer/CommandRecorder.h"
+#include "Renderer/RenderContext.h"
+#include "Renderer/WorkerPool.h"
+
+namespace library
+{
+#define NUM_DRAW_VERTEX_BUFFERS (4)
+#define NUM_DRAW_SHADER_RESOURCES (2)
+
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+      Enum:     eRenderPass
+
+      Summary:  Enumeration of the passes, in the order they are drawn
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eRenderPass : uint32_t
+    {
+        MAIN,
+        SKY,
+        COUNT,
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   DrawItem
+
+      Summary:  Every state a single draw call needs. A null pointer
+                means the draw does not use that slot, so whatever is
+                bound there is left untouched. uObjectNumConstants of 0
+                binds the whole object constant buffer
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct DrawItem
+    {
+        ID3D11InputLayout* pInputLayout;
+        ID3D11VertexShader* pVertexShader;
+        ID3D11PixelShader* pPixelShader;
+        ID3D11Buffer* apVertexBuffers[NUM_DRAW_VERTEX_BUFFERS];
+        uint32_t auStrides[NUM_DRAW_VERTEX_BUFFERS];
+        uint32_t auOffsets[NUM_DRAW_VERTEX_BUFFERS];
+        ID3D11Buffer* pIndexBuffer;
+        ID3D11Buffer* pObjectConstantBuffer;
+        uint32_t uObjectFirstConstant;
+        uint32_t uObjectNumConstants;
+        ID3D11Buffer* pExtraConstantBuffer;
+        ID3D11ShaderResourceView* apShaderResourceViews[NUM_DRAW_SHADER_RESOURCES];
+        ID3D11SamplerState* apSamplers[NUM_DRAW_SHADER_RESOURCES];
+        uint32_t uNumIndices;
+        uint32_t uStartIndex;
+        int32_t iBaseVertex;
+        uint32_t uNumInstances;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   RenderQueueStats
+
+      Summary:  Counters of the last executed frame. Fallback buckets
+                failed to record and were issued on the fallback
+                context instead
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct RenderQueueStats
+    {
+        uint32_t uNumItems;
+        uint32_t uNumDraws;
+        uint32_t uNumBuckets;
+        uint32_t uNumFallbackBuckets;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    RenderQueue
+
+      Summary:  Collects the draw items of a frame, radix sorts them by
+                a 64-bit key and replays them on a render context.
+
+                Key layout from the most significant bit:
+                  pass (4) | vertex shader (7) | pixel shader (7) |
+                  diffuse texture (11) | normal texture (11) |
+                  depth (24)
+
+      Methods:  MakeSortKey
+                  Builds the sort key of a draw item
+                Clear
+                  Removes every draw item
+                Submit
+                  Adds a draw item
+                IsEmpty
+                  Returns whether no draw item was submitted
+                Sort
+                  Sorts the draw items by their key
+                Execute
+                  Issues the draw calls in sorted order
+                ExecuteParallel
+                  Records the draw calls on the threads of a pool
+                GetStats
+                  Returns the counters of the last executed frame
+                executeRange
+                  Issues the draw calls of a range of sorted entries
+                RenderQueue
+                  Constructor.
+                ~RenderQueue
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class RenderQueue final
+    {
+    public:
+        static constexpr const uint32_t NUM_PASS_BITS = 4u;
+        static constexpr const uint32_t NUM_SHADER_BITS = 7u;
+        static constexpr const uint32_t NUM_TEXTURE_BITS = 11u;
+        static constexpr const uint32_t NUM_DEPTH_BITS = 24u;
+        static constexpr const size_t MIN_ITEMS_PER_BUCKET = 64u;
+        // DXGI_FORMAT_R16_UINT, every mesh has 16-bit indices
+        static constexpr const uint32_t INDEX_FORMAT = 57u;
+
+        RenderQueue();
+        RenderQueue(const RenderQueue& other) = delete;
+        RenderQueue(RenderQueue&& other) = delete;
+        RenderQueue& operator=(const RenderQueue& other) = delete;
+        RenderQueue& operator=(RenderQueue&& other) = delete;
+        ~RenderQueue() = default;
+
+        uint64_t MakeSortKey(eRenderPass ePass, const DrawItem& item, float normalizedDepth);
+
+        void Clear();
+        void Submit(uint64_t uSortKey, const DrawItem& item);
+        bool IsEmpty() const;
+        void Sort();
+        void Execute(IRenderContext& renderContext);
+        bool ExecuteParallel(ICommandRecorder& recorder, WorkerPool& workerPool, IRenderContext& fallbackContext, const std::function<void(IRenderContext&)>& fnBeginBucket);
+
+        const RenderQueueStats& GetStats() const;
+
+    private:
+        uint32_t getId(const void* pState, uint32_t uNumBits);
+        uint32_t executeRange(IRenderContext& renderContext, size_t uBegin, size_t uEnd) const;
+
+    private:
+        struct SortEntry
+        {
+            uint64_t uKey;
+            uint32_t uItemIdx;
+        };
+
+        std::vector<DrawItem> m_aItems;
+        std::vector<SortEntry> m_aEntries;
+        std::vector<SortEntry> m_aScratch;
+        std::unordered_map<const void*, uint32_t> m_stateIds;
+        RenderQueueStats m_stats;
+    };
+}
@@ -20,7 +20,7 @@ namespace library
       Modifies: [m_vertexBuffer, m_indexBuffer, m_constantBuffer,
                  m_normalBuffer, m_aMeshes, m_aMaterials, m_vertexShader,
                  m_pixelShader, m_outputColor, m_world, m_bHasNormalMap
-                 m_aNormalData].
+                 m_aNormalData, m_localBounds].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     /*--------------------------------------------------------------------
       TODO: Renderable::Renderable definition (remove the comment)
@@ -39,6 +39,7 @@ namespace library
         , m_world(XMMatrixIdentity())
         , m_padding()
         , m_bHasNormalMap(FALSE)
+        , m_localBounds()
     {
 
     }
@@ -57,7 +58,7 @@ namespace library
                   File name of the texture to usen
 
       Modifies: [m_vertexBuffer, m_normalBuffer, m_indexBuffer
-                 m_constantBuffer].
+                 m_constantBuffer, m_localBounds, m_aMeshes].
 
       Returns:  HRESULT
                   Status code
@@ -91,6 +92,15 @@ namespace library
         if (FAILED(hr))
             return hr;
 
+        //bounds of the vertices, used to pick the lights of the object
+        if (GetNumVertices() > 0u)
+        {
+            BoundingBox::CreateFromPoints(m_localBounds, GetNumVertices(), &getVertices()->Position, sizeof(SimpleVertex));
+        }
+
+        //texture coordinates per unit of the meshes, used to pick the mips of their textures
+        calculateUvDensities();
+
         //renderable has texture and m_NormalMap is empty
         if (m_aNormalData.empty())
         {
@@ -186,23 +196,29 @@ namespace library
     }
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderable::GetVertexShader
-      Summary:  Returns the vertex shader
+      Summary:  Returns the vertex shader variant drawing a set of
+                shader features
+      Args:     UINT uShaderFeatures
+                  Shader::FEATURE_* bits
       Returns:  ComPtr<ID3D11VertexShader>&
                   Vertex shader. Could be a nullptr
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    ComPtr<ID3D11VertexShader>& Renderable::GetVertexShader()
+    ComPtr<ID3D11VertexShader>& Renderable::GetVertexShader(_In_ UINT uShaderFeatures)
     {
-        return m_vertexShader->GetVertexShader();
+        return m_vertexShader->GetVertexShader(uShaderFeatures);
     }
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderable::GetPixelShader
-      Summary:  Returns the vertex shader
+      Summary:  Returns the pixel shader variant drawing a set of
+                shader features
+      Args:     UINT uShaderFeatures
+                  Shader::FEATURE_* bits
       Returns:  ComPtr<ID3D11PixelShader>&
                   Pixel shader. Could be a nullptr
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    ComPtr<ID3D11PixelShader>& Renderable::GetPixelShader()
+    ComPtr<ID3D11PixelShader>& Renderable::GetPixelShader(_In_ UINT uShaderFeatures)
     {
-        return m_pixelShader->GetPixelShader();
+        return m_pixelShader->GetPixelShader(uShaderFeatures);
     }
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderable::GetVertexLayout
@@ -254,6 +270,17 @@ namespace library
     {
         return m_world;
     }
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::GetLocalBounds
+      Summary:  Returns the bounding box of the vertices, before the
+                world matrix is applied
+      Returns:  const BoundingBox&
+                  Local bounding box
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const BoundingBox& Renderable::GetLocalBounds()
+    {
+        return m_localBounds;
+    }
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderable::GetOutputColor
       Summary:  Returns the output color
@@ -421,6 +448,58 @@ namespace library
     }
 
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::calculateUvDensities
+
+      Summary:  Calculate the texture coordinate units per object space
+                unit of every mesh, as the square root of the ratio of
+                the area its triangles cover in the textures to their
+                area in object space
+
+      Modifies: [m_aMeshes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderable::calculateUvDensities()
+    {
+        const SimpleVertex* aVertices = getVertices();
+        const WORD* aIndices = getIndices();
+        const UINT uNumVertices = GetNumVertices();
+        const UINT uNumIndices = GetNumIndices();
+
+        for (BasicMeshEntry& mesh : m_aMeshes)
+        {
+            FLOAT positionArea = 0.0f;
+            FLOAT uvArea = 0.0f;
+
+            for (UINT i = 0u; i + 2u < mesh.uNumIndices && mesh.uBaseIndex + i + 2u < uNumIndices; i += 3u)
+            {
+                const UINT uIndex0 = mesh.uBaseVertex + aIndices[mesh.uBaseIndex + i];
+                const UINT uIndex1 = mesh.uBaseVertex + aIndices[mesh.uBaseIndex + i + 1u];
+                const UINT uIndex2 = mesh.uBaseVertex + aIndices[mesh.uBaseIndex + i + 2u];
+                if (uIndex0 >= uNumVertices || uIndex1 >= uNumVertices || uIndex2 >= uNumVertices)
+                {
+                    continue;
+                }
+
+                const SimpleVertex& v0 = aVertices[uIndex0];
+                const SimpleVertex& v1 = aVertices[uIndex1];
+                const SimpleVertex& v2 = aVertices[uIndex2];
+
+                XMVECTOR p0 = XMLoadFloat3(&v0.Position);
+                XMVECTOR edge1 = XMVectorSubtract(XMLoadFloat3(&v1.Position), p0);
+                XMVECTOR edge2 = XMVectorSubtract(XMLoadFloat3(&v2.Position), p0);
+                positionArea += 0.5f * XMVectorGetX(XMVector3Length(XMVector3Cross(edge1, edge2)));
+
+                FLOAT du1 = v1.TexCoord.x - v0.TexCoord.x;
+                FLOAT dv1 = v1.TexCoord.y - v0.TexCoord.y;
+                FLOAT du2 = v2.TexCoord.x - v0.TexCoord.x;
+                FLOAT dv2 = v2.TexCoord.y - v0.TexCoord.y;
+                uvArea += 0.5f * fabsf(du1 * dv2 - du2 * dv1);
+            }
+
+            mesh.uvDensity = positionArea > 0.0f ? sqrtf(uvArea / positionArea) : 0.0f;
+        }
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderable::calculateTangentBitangent
 
@@ -590,4 +669,18 @@ namespace library
         return m_bHasNormalMap;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::GetShaderFeatures
+
+      Summary:  Returns the shader features the renderable is drawn
+                with, selecting the variants of its shaders
+
+      Returns:  UINT
+                  Shader::FEATURE_* bits
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Renderable::GetShaderFeatures() const
+    {
+        return m_bHasNormalMap ? Shader::FEATURE_NORMAL_MAP : 0u;
+    }
+
 }
@@ -39,12 +39,20 @@ namespace library
                   Returns the constant buffer
                 GetWorldMatrix
                   Returns the world matrix
+                GetLocalBounds
+                  Returns the bounding box of the vertices
                 GetNumVertices
                   Pure virtual function that returns the number of
                   vertices
                 GetNumIndices
                   Pure virtual function that returns the number of
                   indices
+                GetShaderFeatures
+                  Returns the shader features the renderable is drawn
+                  with
+                calculateUvDensities
+                  Measures the texture coordinates per unit of every
+                  mesh
                 Renderable
                   Constructor.
                 ~Renderable
@@ -63,6 +71,7 @@ namespace library
                 , uBaseVertex(0u)
                 , uBaseIndex(0u)
                 , uMaterialIndex(INVALID_MATERIAL)
+                , uvDensity(0.0f)
             {
             }
 
@@ -70,6 +79,9 @@ namespace library
             UINT uBaseVertex;
             UINT uBaseIndex;
             UINT uMaterialIndex;
+
+            // Texture coordinate units per object space unit, averaged over the area of the mesh
+            FLOAT uvDensity;
         };
 
     public:
@@ -89,8 +101,8 @@ namespace library
         void AddMaterial(_In_ const std::shared_ptr<Material>& material);
         HRESULT SetMaterialOfMesh(_In_ const UINT uMeshIndex, _In_ const UINT uMaterialIndex);
 
-        ComPtr<ID3D11VertexShader>& GetVertexShader();
-        ComPtr<ID3D11PixelShader>& GetPixelShader();
+        ComPtr<ID3D11VertexShader>& GetVertexShader(_In_ UINT uShaderFeatures = 0u);
+        ComPtr<ID3D11PixelShader>& GetPixelShader(_In_ UINT uShaderFeatures = 0u);
         ComPtr<ID3D11InputLayout>& GetVertexLayout();
         ComPtr<ID3D11Buffer>& GetVertexBuffer();
         ComPtr<ID3D11Buffer>& GetIndexBuffer();
@@ -98,6 +110,7 @@ namespace library
         ComPtr<ID3D11Buffer>& GetNormalBuffer();
 
         const XMMATRIX& GetWorldMatrix() const;
+        virtual const BoundingBox& GetLocalBounds();
         const XMFLOAT4& GetOutputColor() const;
         BOOL HasTexture() const;
         const std::shared_ptr<Material>& GetMaterial(UINT uIndex) const;
@@ -116,6 +129,7 @@ namespace library
         UINT GetNumMeshes() const;
         UINT GetNumMaterials() const;
         BOOL HasNormalMap() const;
+        UINT GetShaderFeatures() const;
 
     protected:
         const virtual SimpleVertex* getVertices() const = 0;
@@ -126,6 +140,7 @@ namespace library
         );
 
         void calculateNormalMapVectors();
+        void calculateUvDensities();
         void calculateTangentBitangent(_In_ const SimpleVertex& v1, _In_ const SimpleVertex& v2, _In_ const SimpleVertex& v3, _Out_ XMFLOAT3& tangent, _Out_ XMFLOAT3& bitangent);
 
     protected:
@@ -145,5 +160,6 @@ namespace library
         BYTE m_padding[8];
         XMMATRIX m_world;
         BOOL m_bHasNormalMap;
+        BoundingBox m_localBounds;
     };
 }
\ No newline at end of file
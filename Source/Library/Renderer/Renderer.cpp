@@ -1,7 +1,10 @@
 #include "Renderer/Renderer.h"
 
+#include <thread>
+
 namespace library
 {
+    static_assert(RenderQueue::INDEX_FORMAT == DXGI_FORMAT_R16_UINT, "RenderQueue binds the 16-bit index buffers of the meshes");
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderer::Renderer
@@ -11,10 +14,17 @@ namespace library
       Modifies: [m_driverType, m_featureLevel, m_d3dDevice, m_d3dDevice1,
                   m_immediateContext, m_immediateContext1, m_swapChain,
                   m_swapChain1, m_renderTargetView, m_depthStencil,
-                  m_depthStencilView, m_cbChangeOnResize, m_cbShadowMatrix,
-                  m_pszMainSceneName, m_camera, m_projection, m_scenes
-                  m_invalidTexture, m_shadowMapTexture, m_shadowVertexShader,
-                  m_shadowPixelShader].
+                  m_depthStencilView, m_cbChangeOnResize, m_cbShadowCascades,
+                  m_acbShadowPasses, m_pszMainSceneName, m_camera,
+                  m_projection, m_viewport, m_scenes, m_invalidTexture,
+                  m_shadowVertexShader, m_voxelShadowVertexShader,
+                  m_skinningShadowVertexShader, m_renderContext, m_commandList, m_stateCache,
+                  m_commandRecorder, m_workerPool, m_objectConstantRing,
+                  m_renderQueue, m_lightClusterGrid, m_lightSelector, m_aFrameLights,
+                  m_cascadedShadowMap, m_aShadowQueues,
+                  m_aStaticShadowQueues, m_auStaticCasterMasks,
+                  m_uShadowRefreshMask, m_abDynamicShadowsDrawn,
+                  m_bCastShadows, m_shaderReloader, m_flatNormalView].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     /*--------------------------------------------------------------------
       TODO: Renderer::Renderer definition (remove the comment)
@@ -32,12 +42,37 @@ namespace library
         , m_depthStencil()
         , m_depthStencilView()
         , m_cbChangeOnResize()
+        , m_cbShadowCascades()
+        , m_acbShadowPasses()
         , m_pszMainSceneName(nullptr)
         , m_padding{ '\0' }
         , m_camera(XMVectorSet(0.0f, 3.0f, -6.0f, 0.0f))
         , m_projection()
+        , m_viewport()
         , m_scenes()
         , m_invalidTexture(std::make_shared<Texture>(L"Content/Common/InvalidTexture.png"))
+        , m_shadowVertexShader()
+        , m_voxelShadowVertexShader()
+        , m_skinningShadowVertexShader()
+        , m_renderContext()
+        , m_commandList()
+        , m_stateCache()
+        , m_commandRecorder()
+        , m_workerPool((std::max)(std::thread::hardware_concurrency(), 1u) - 1u)
+        , m_objectConstantRing()
+        , m_renderQueue()
+        , m_lightClusterGrid()
+        , m_lightSelector()
+        , m_aFrameLights()
+        , m_cascadedShadowMap()
+        , m_aShadowQueues()
+        , m_aStaticShadowQueues()
+        , m_auStaticCasterMasks()
+        , m_uShadowRefreshMask(0u)
+        , m_abDynamicShadowsDrawn()
+        , m_bCastShadows(FALSE)
+        , m_shaderReloader()
+        , m_flatNormalView()
     {
     }
 
@@ -53,7 +88,10 @@ namespace library
                   m_d3dDevice1, m_immediateContext1, m_swapChain1,
                   m_swapChain, m_renderTargetView, m_vertexShader,
                   m_vertexLayout, m_pixelShader, m_vertexBuffer
-                  m_cbShadowMatrix].
+                  m_cbShadowCascades, m_acbShadowPasses, m_viewport,
+                  m_renderContext, m_stateCache, m_commandRecorder,
+                  m_objectConstantRing, m_lightClusterGrid,
+                  m_cascadedShadowMap, m_shaderReloader].
 
       Returns:  HRESULT
                   Status code
@@ -258,7 +296,7 @@ namespace library
         m_immediateContext->OMSetRenderTargets(1, m_renderTargetView.GetAddressOf(), m_depthStencilView.Get());
 
         // Setup the viewport
-        D3D11_VIEWPORT vp =
+        m_viewport =
         {
             .TopLeftX = 0.0f,
             .TopLeftY = 0.0f,
@@ -267,7 +305,7 @@ namespace library
             .MinDepth = 0.0f,
             .MaxDepth = 1.0f,
         };
-        m_immediateContext->RSSetViewports(1, &vp);
+        m_immediateContext->RSSetViewports(1, &m_viewport);
 
         // Set primitive topology
         m_immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
@@ -306,15 +344,74 @@ namespace library
             return hr;
         }
 
+        //the lights are binned into clusters of the same frustum
+        hr = m_lightClusterGrid.Initialize(m_d3dDevice.Get());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+        m_lightClusterGrid.SetProjection(XM_PIDIV4, uWidth, uHeight, 0.01f, 1000.0f);
+
+        //the directional light shadows the view up to SHADOW_DISTANCE, split into cascades
+        bd.ByteWidth = sizeof(CBShadowCascades);
+        hr = m_d3dDevice->CreateBuffer(&bd, nullptr, m_cbShadowCascades.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        bd.ByteWidth = sizeof(CBShadowPass);
+        for (UINT uCascade = 0u; uCascade < NUM_SHADOW_CASCADES; ++uCascade)
+        {
+            hr = m_d3dDevice->CreateBuffer(&bd, nullptr, m_acbShadowPasses[uCascade].GetAddressOf());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        hr = m_cascadedShadowMap.Initialize(m_d3dDevice.Get());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+        m_cascadedShadowMap.SetProjection(XM_PIDIV4, static_cast<FLOAT>(uWidth) / static_cast<FLOAT>(uHeight), 0.01f, SHADOW_DISTANCE);
+
         //Initialize 
         m_camera.Initialize(m_d3dDevice.Get());
 
+        m_renderContext = std::make_unique<D3D11RenderContext>(m_immediateContext.Get());
+        m_stateCache = std::make_unique<StateCache>(&m_commandList);
+
+        //bind the object constants as ranges of one ring buffer when the device can offset constant buffers
+        if (m_immediateContext1)
+        {
+            auto objectConstantRing = std::make_unique<ConstantRingBuffer>(OBJECT_CONSTANT_RING_SIZE);
+            if (SUCCEEDED(objectConstantRing->Initialize(m_d3dDevice.Get())))
+            {
+                m_objectConstantRing = std::move(objectConstantRing);
+            }
+        }
+
+        //record the draws on deferred contexts when there is more than one hardware thread
+        const UINT uNumRecordingContexts = (std::min)(m_workerPool.GetNumThreads(), MAX_RECORDING_CONTEXTS);
+        if (uNumRecordingContexts > 1u)
+        {
+            auto commandRecorder = std::make_unique<D3D11CommandRecorder>();
+            hr = commandRecorder->Initialize(m_d3dDevice.Get(), m_immediateContext.Get(), uNumRecordingContexts, m_renderTargetView.Get(), m_depthStencilView.Get(), m_viewport);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+            m_commandRecorder = std::move(commandRecorder);
+        }
+
         if (!m_scenes.contains(m_pszMainSceneName))
         {
             return E_FAIL;
         }
 
-        hr = m_scenes[m_pszMainSceneName]->Initialize(m_d3dDevice.Get(), m_immediateContext.Get());
+        hr = m_scenes[m_pszMainSceneName]->Initialize(m_d3dDevice.Get(), m_immediateContext.Get(), m_workerPool);
         if (FAILED(hr))
         {
             return hr;
@@ -326,6 +423,63 @@ namespace library
             return hr;
         }
 
+        // 1x1 normal map pointing along the normal, bound while the normal maps load
+        static constexpr const UINT FLAT_NORMAL = 0xffff8080u;
+
+        D3D11_TEXTURE2D_DESC flatNormalDesc =
+        {
+            .Width = 1u,
+            .Height = 1u,
+            .MipLevels = 1u,
+            .ArraySize = 1u,
+            .Format = DXGI_FORMAT_R8G8B8A8_UNORM,
+            .SampleDesc = {.Count = 1u, .Quality = 0u },
+            .Usage = D3D11_USAGE_IMMUTABLE,
+            .BindFlags = D3D11_BIND_SHADER_RESOURCE,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = 0u
+        };
+        D3D11_SUBRESOURCE_DATA flatNormalData =
+        {
+            .pSysMem = &FLAT_NORMAL,
+            .SysMemPitch = sizeof(FLAT_NORMAL),
+            .SysMemSlicePitch = 0u
+        };
+
+        ComPtr<ID3D11Texture2D> flatNormal;
+        hr = m_d3dDevice->CreateTexture2D(&flatNormalDesc, &flatNormalData, flatNormal.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = m_d3dDevice->CreateShaderResourceView(flatNormal.Get(), nullptr, m_flatNormalView.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+#if defined(DEBUG) || defined(_DEBUG)
+        // Edited shaders are swapped in while the game runs
+        Scene& scene = *m_scenes[m_pszMainSceneName];
+        for (auto it = scene.GetVertexShaders().begin(); it != scene.GetVertexShaders().end(); ++it)
+        {
+            m_shaderReloader.Track(it->second);
+        }
+
+        for (auto it = scene.GetPixelShaders().begin(); it != scene.GetPixelShaders().end(); ++it)
+        {
+            m_shaderReloader.Track(it->second);
+        }
+
+        // The shadow casters are drawn with shaders the renderer holds, whether or not the scene lists them
+        m_shaderReloader.Track(m_shadowVertexShader);
+        m_shaderReloader.Track(m_voxelShadowVertexShader);
+        m_shaderReloader.Track(m_skinningShadowVertexShader);
+
+        m_shaderReloader.Start();
+#endif
+
         return S_OK;
     }
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -390,19 +544,25 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderer::SetShadowMapShaders
 
-      Summary:  Set shaders for the shadow mapping
+      Summary:  Set the depth only shaders drawing the casters into
+                the shadow map. No shadows are cast until all are set
 
-      Args:     std::shared_ptr<ShadowVertexShader>
-                  vertex shader
-                std::shared_ptr<PixelShader>
-                  pixel shader
+      Args:     std::shared_ptr<VertexShader> vertexShader
+                  vertex shader of the renderables
+                std::shared_ptr<VertexShader> voxelVertexShader
+                  vertex shader of the instanced voxels
+                std::shared_ptr<VertexShader> skinningVertexShader
+                  vertex shader of the models, skinned by the bones
+                  of their pose
 
-      Modifies: [m_shadowVertexShader, m_shadowPixelShader].
+      Modifies: [m_shadowVertexShader, m_voxelShadowVertexShader,
+                 m_skinningShadowVertexShader].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    void Renderer::SetShadowMapShaders(_In_ std::shared_ptr<ShadowVertexShader> vertexShader, _In_ std::shared_ptr<PixelShader> pixelShader)
+    void Renderer::SetShadowMapShaders(_In_ std::shared_ptr<VertexShader> vertexShader, _In_ std::shared_ptr<VertexShader> voxelVertexShader, _In_ std::shared_ptr<VertexShader> skinningVertexShader)
     {
         m_shadowVertexShader = move(vertexShader);
-        m_shadowPixelShader = move(pixelShader);
+        m_voxelShadowVertexShader = move(voxelVertexShader);
+        m_skinningShadowVertexShader = move(skinningVertexShader);
     }
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderer::HandleInput
@@ -417,13 +577,55 @@ namespace library
     }
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
          Method:   Renderer::Update
-         Summary:  Update the renderables each frame
+         Summary:  Update the renderables each frame, and swap in the
+                   shaders recompiled, create the textures decoded
+                   since the last frame and stream the texture mips
+                   requested by the last frame
          Args:     FLOAT deltaTime
                      Time difference of a frame
        M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Renderer::Update(_In_ FLOAT deltaTime)
     {
-        m_scenes[m_pszMainSceneName]->Update(deltaTime);
+        m_shaderReloader.Update(m_d3dDevice.Get());
+
+        TextureLoader& textureLoader = Model::GetTextureLoader();
+        if (textureLoader.Update(m_d3dDevice.Get()) > 0u && textureLoader.GetNumPending() == 0u)
+        {
+            TextureCacheStats textureCacheStats = Model::GetTextureCache().GetStats();
+            UINT uNumTextureRequests = textureCacheStats.uNumPathHits + textureCacheStats.uNumContentHits + textureCacheStats.uNumMisses;
+
+            CHAR szTextureCacheMessage[256];
+            sprintf_s(
+                szTextureCacheMessage,
+                "Texture cache: %u of %u requests hit (%u by contents), %llu KiB loaded, %llu KiB saved\n",
+                textureCacheStats.uNumPathHits + textureCacheStats.uNumContentHits,
+                uNumTextureRequests,
+                textureCacheStats.uNumContentHits,
+                textureCacheStats.uBytesLoaded / 1024ull,
+                textureCacheStats.uBytesSaved / 1024ull
+            );
+            OutputDebugStringA(szTextureCacheMessage);
+        }
+
+        TextureStreamer& textureStreamer = Model::GetTextureStreamer();
+        if (textureStreamer.Update(m_d3dDevice.Get()) > 0u && textureStreamer.GetStats().uNumPending == 0u)
+        {
+            const TextureStreamingStats& textureStreamingStats = textureStreamer.GetStats();
+
+            CHAR szTextureStreamingMessage[256];
+            sprintf_s(
+                szTextureStreamingMessage,
+                "Texture streaming: %llu KiB resident of %llu KiB requested within %llu KiB, %u streamed in, %u evicted\n",
+                textureStreamingStats.uResidentBytes / 1024ull,
+                textureStreamingStats.uRequestedBytes / 1024ull,
+                textureStreamingStats.uBudgetBytes / 1024ull,
+                textureStreamingStats.uNumStreamedIn,
+                textureStreamingStats.uNumEvicted
+            );
+            OutputDebugStringA(szTextureStreamingMessage);
+        }
+
+        m_scenes[m_pszMainSceneName]->Update(deltaTime, m_workerPool);
 
         m_camera.Update(deltaTime);
     }
@@ -431,318 +633,776 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderer::Render
 
-      Summary:  Render the frame
+      Summary:  Render the frame. The clears and buffer updates are
+                recorded into the command list through the state cache
+                and replayed on the device context. Every draw is
+                submitted to the render queue, which sorts them and
+                records them on the deferred contexts in parallel, or
+                into the command list when there are none
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     /*--------------------------------------------------------------------
       TODO: Renderer::Render definition (remove the comment)
     --------------------------------------------------------------------*/
     void Renderer::Render()
     {
+        Scene& scene = *m_scenes[m_pszMainSceneName];
+
+        //the device context may have been changed outside the cache since the last frame
+        m_commandList.Reset();
+        m_stateCache->Invalidate();
+        m_stateCache->ResetStats();
+
+        //a failed map leaves the ring unmapped and the object constants fall back to their own buffers
+        if (m_objectConstantRing)
+        {
+            m_objectConstantRing->BeginFrame(m_immediateContext.Get());
+        }
+
         //clear the back buffer
-        m_immediateContext->ClearRenderTargetView(m_renderTargetView.Get(), Colors::MidnightBlue);
+        m_stateCache->ClearRenderTargetView(m_renderTargetView.Get(), Colors::MidnightBlue);
 
         //clear the depth buffer to 1.0
-        m_immediateContext->ClearDepthStencilView(m_depthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0);
+        m_stateCache->ClearDepthStencilView(m_depthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0u);
 
         //create camera constant buffer and update
         CBChangeOnCameraMovement cb0;
         cb0.View = XMMatrixTranspose(m_camera.GetView());
         XMStoreFloat4(&cb0.CameraPosition, m_camera.GetEye());
-        m_immediateContext->UpdateSubresource(m_camera.GetConstantBuffer().Get(), 0, nullptr, &cb0, 0, 0);
+        m_stateCache->UpdateBuffer(m_camera.GetConstantBuffer().Get(), &cb0, sizeof(cb0));
+
+        //gather the lights, culled beyond the distance where their attenuation drops below the cutoff
+        m_aFrameLights.clear();
+        for (UINT i = 0u; i < scene.GetNumPointLights(); ++i)
+        {
+            const std::shared_ptr<PointLight>& pointLight = scene.GetPointLight(i);
+            if (!pointLight)
+            {
+                continue;
+            }
+
+            const FLOAT attenuationDistance = pointLight->GetAttenuationDistance();
+            const FLOAT range = attenuationDistance / sqrtf(LightClusterGrid::LIGHT_CUTOFF);
+
+            m_aFrameLights.push_back(
+                Lights
+                {
+                    .Position = scene.GetPointLightPosition(i),
+                    .Color = pointLight->GetColor(),
+                    .AttenuationDistance = XMFLOAT4(attenuationDistance, range, attenuationDistance * attenuationDistance, range * range)
+                }
+            );
+        }
 
-        //change CBLights
+        //the first lights are still read from CBLights by the shaders that are not clustered
         CBLights cb3 = {};
+        for (UINT i = 0u; i < NUM_LIGHTS && i < m_aFrameLights.size(); ++i)
+        {
+            cb3.PointLights[i] = m_aFrameLights[i];
+        }
+        m_stateCache->UpdateBuffer(m_cbLights.Get(), &cb3, sizeof(cb3));
+
+        //bin the lights into view space clusters and upload the lists before the recorded draws are replayed
+        m_lightClusterGrid.Build(m_camera.GetView(), m_aFrameLights.data(), static_cast<UINT>(m_aFrameLights.size()));
+        m_lightClusterGrid.Upload(m_immediateContext.Get());
+
+        //the shaders that are not clustered read the brightest lights reaching each object from its own constants
+        m_lightSelector.SetLights(m_aFrameLights.data(), static_cast<UINT>(m_aFrameLights.size()));
+
+        //fit the shadow cascades to the view, the casters are culled into them while the objects are submitted
+        const XMFLOAT4& sunDirection = scene.GetDirectionalLightDirection();
+        const XMFLOAT4& sunColor = scene.GetDirectionalLightColor();
+        const BOOL bCastShadows = m_shadowVertexShader && m_voxelShadowVertexShader && m_skinningShadowVertexShader && (sunColor.x > 0.0f || sunColor.y > 0.0f || sunColor.z > 0.0f);
+        m_cascadedShadowMap.Update(m_camera.GetView(), XMLoadFloat4(&sunDirection));
 
-        for (UINT i = 0; i < NUM_LIGHTS; ++i)
+        //the static casters are only drawn into the cascades refreshed this frame, the others keep their cached depth
+        m_uShadowRefreshMask = 0u;
+        if (bCastShadows)
         {
-            FLOAT attenuationDistance = m_scenes[m_pszMainSceneName]->GetPointLight(i)->GetAttenuationDistance();
-            FLOAT attenuationDistanceSquard = attenuationDistance * attenuationDistance;
+            //nothing was tracked while the shadows were off
+            if (!m_bCastShadows)
+            {
+                m_cascadedShadowMap.InvalidateCascades((1u << NUM_SHADOW_CASCADES) - 1u);
+            }
+
+            invalidateStaticShadows(scene.GetObjects());
+            m_uShadowRefreshMask = m_cascadedShadowMap.ScheduleRefreshes(SHADOW_REFRESH_BUDGET);
+        }
+        m_bCastShadows = bCastShadows;
 
-            cb3.PointLights[i] =
+        CBShadowCascades cb6 =
+        {
+            .CascadeSplits = XMFLOAT4(m_cascadedShadowMap.GetSplitDistance(0u), m_cascadedShadowMap.GetSplitDistance(1u), m_cascadedShadowMap.GetSplitDistance(2u), m_cascadedShadowMap.GetSplitDistance(3u)),
+            .CascadeTexelSizes = XMFLOAT4(m_cascadedShadowMap.GetTexelSize(0u), m_cascadedShadowMap.GetTexelSize(1u), m_cascadedShadowMap.GetTexelSize(2u), m_cascadedShadowMap.GetTexelSize(3u)),
+            .LightDirection = sunDirection,
+            .LightColor = m_bCastShadows ? sunColor : XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f)
+        };
+        for (UINT uCascade = 0u; uCascade < NUM_SHADOW_CASCADES; ++uCascade)
+        {
+            cb6.CascadeViewProjections[uCascade] = XMMatrixTranspose(m_cascadedShadowMap.GetViewProjection(uCascade));
+
+            CBShadowPass cb0Shadow =
             {
-                .Position = m_scenes[m_pszMainSceneName]->GetPointLight(i)->GetPosition(),
-                .Color = m_scenes[m_pszMainSceneName]->GetPointLight(i)->GetColor(),
-                .AttenuationDistance = XMFLOAT4(attenuationDistance, attenuationDistance, attenuationDistanceSquard, attenuationDistanceSquard)
+                .ViewProjection = cb6.CascadeViewProjections[uCascade]
             };
+            m_stateCache->UpdateBuffer(m_acbShadowPasses[uCascade].Get(), &cb0Shadow, sizeof(cb0Shadow));
+
+            m_aShadowQueues[uCascade].Clear();
+            m_aStaticShadowQueues[uCascade].Clear();
         }
-        m_immediateContext->UpdateSubresource(m_cbLights.Get(), 0, nullptr, &cb3, 0, 0);
+        m_stateCache->UpdateBuffer(m_cbShadowCascades.Get(), &cb6, sizeof(cb6));
 
-        //render renderables
-        for (auto Renderableiter : m_scenes[m_pszMainSceneName]->GetRenderables())
+        m_renderQueue.Clear();
+
+        //submit the renderables, instanced voxels and models straight from the dense arrays of the scene
+        const SceneObjectTable& objects = scene.GetObjects();
+        const XMFLOAT4X4* aWorldMatrices = objects.GetWorldMatrices();
+        Renderable* const* apRenderables = objects.GetRenderables();
+        const SceneObjectMaterial* aMaterials = objects.GetMaterials();
+        const UINT* auFlags = objects.GetFlags();
+        for (UINT i = 0u; i < objects.GetNumObjects(); ++i)
         {
-            //set vertex buffer
-            UINT stride = sizeof(SimpleVertex);
-            UINT Nstride = sizeof(NormalData);
-            
-            UINT offset = 0;
+            if (!(auFlags[i] & SceneObjectTable::FLAG_VISIBLE))
+            {
+                continue;
+            }
+
+            Renderable& renderable = *apRenderables[i];
 
-            m_immediateContext->IASetVertexBuffers(0u, 1u, Renderableiter.second->GetVertexBuffer().GetAddressOf(), &stride, &offset);
-            m_immediateContext->IASetVertexBuffers(1u, 1u, Renderableiter.second->GetNormalBuffer().GetAddressOf(), &Nstride, &offset);
+            DrawItem item = {};
+            item.apVertexBuffers[1] = renderable.GetNormalBuffer().Get();
+            item.auStrides[1] = sizeof(NormalData);
 
-            //set index buffer
-            m_immediateContext->IASetIndexBuffer(Renderableiter.second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
+            if (auFlags[i] & SceneObjectTable::FLAG_VOXEL)
+            {
+                Voxel& voxel = static_cast<Voxel&>(renderable);
+
+                //upload the instances changed since the last frame, before the recorded draws are replayed
+                if (FAILED(voxel.UpdateInstanceBuffer(m_d3dDevice.Get(), m_immediateContext.Get())) || voxel.GetNumInstances() == 0u)
+                {
+                    continue;
+                }
+
+                item.apVertexBuffers[2] = voxel.GetInstanceBuffer().Get();
+                item.auStrides[2] = voxel.GetInstanceStride();
+                item.auOffsets[2] = voxel.GetInstanceOffset();
+                item.pExtraConstantBuffer = voxel.GetBlockColorsConstantBuffer().Get();
+                item.uNumInstances = voxel.GetNumInstances();
+            }
+            else if (auFlags[i] & SceneObjectTable::FLAG_MODEL)
+            {
+                Model& model = static_cast<Model&>(renderable);
+
+                //Additional constant buffer CBSkinning
+                const std::vector<XMMATRIX>& aBoneTransforms = model.GetBoneTransforms();
+                CBSkinning cb4 = {};
+                for (UINT uBone = 0u; uBone < aBoneTransforms.size(); ++uBone)
+                {
+                    cb4.BoneTransforms[uBone] = XMMatrixTranspose(aBoneTransforms[uBone]);
+                }
 
-            //set input layout
-            m_immediateContext->IASetInputLayout(Renderableiter.second->GetVertexLayout().Get());
+                m_stateCache->UpdateBuffer(model.GetSkinningConstantBuffer().Get(), &cb4, sizeof(cb4));
 
-            //set primitive topology
-            m_immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+                item.apVertexBuffers[3] = model.GetAnimationBuffer().Get();
+                item.auStrides[3] = sizeof(AnimationData);
+                item.pExtraConstantBuffer = model.GetSkinningConstantBuffer().Get();
+            }
 
             //create renderable constant buffer and update
+            const XMMATRIX world = XMLoadFloat4x4(&aWorldMatrices[i]);
             CBChangesEveryFrame cb2 =
             {
-                .World = XMMatrixTranspose(Renderableiter.second->GetWorldMatrix()),
-                .OutputColor = Renderableiter.second->GetOutputColor(),
-                .HasNormalMap = Renderableiter.second->HasNormalMap()
+                .World = XMMatrixTranspose(world),
+                .OutputColor = aMaterials[i].OutputColor,
             };
 
-            m_immediateContext->UpdateSubresource(Renderableiter.second->GetConstantBuffer().Get(), 0, nullptr, &cb2, 0, 0);
-
-            //set vertex shader + bind cblight constant buffer
-            m_immediateContext->VSSetShader(Renderableiter.second->GetVertexShader().Get(), nullptr, 0);
-            m_immediateContext->PSSetShader(Renderableiter.second->GetPixelShader().Get(), nullptr, 0);
+            BoundingBox worldBounds;
+            renderable.GetLocalBounds().Transform(worldBounds, world);
 
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(2u, 1u, Renderableiter.second->GetConstantBuffer().GetAddressOf());
+            UINT auLights[MAX_NUM_OBJECT_LIGHTS];
+            cb2.NumLights = m_lightSelector.Select(worldBounds, auLights, MAX_NUM_OBJECT_LIGHTS);
+            for (UINT uLight = 0u; uLight < cb2.NumLights; ++uLight)
+            {
+                cb2.ObjectLights[uLight] = m_aFrameLights[auLights[uLight]];
+            }
 
-            //set pixel shader
-            m_immediateContext->PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(2u, 1u, Renderableiter.second->GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
+            writeObjectConstants(renderable.GetConstantBuffer().Get(), cb2, item);
 
+            submitRenderable(renderable, aWorldMatrices[i], eRenderPass::MAIN, aMaterials[i].uShaderFeatures, item);
+            requestTextureMips(renderable, world, worldBounds);
 
-            //<set shader resource and samplers>
-            if (Renderableiter.second->HasTexture())
+            //the casters reuse the object constants, the shadow shaders only read World
+            if (m_bCastShadows)
             {
-                for (UINT i = 0; i < Renderableiter.second->GetNumMeshes(); ++i)
+                UINT uCascadeMask = m_cascadedShadowMap.Cull(worldBounds);
+                const BOOL bStatic = (m_auStaticCasterMasks[i] & STATIC_CASTER) != 0u;
+                if (bStatic)
                 {
-                    UINT index = Renderableiter.second->GetMesh(i).uMaterialIndex;
+                    //remembered so the cascades can be invalidated when the caster changes
+                    m_auStaticCasterMasks[i] = STATIC_CASTER | uCascadeMask;
+                    uCascadeMask &= m_uShadowRefreshMask;
+                }
 
-                    if (Renderableiter.second->GetMaterial(index)->pDiffuse)
+                if (uCascadeMask)
+                {
+                    //the models are drawn in their pose, with the bones and the animation buffer of their main pass item
+                    VertexShader* pShadowVertexShader = m_shadowVertexShader.get();
+                    if (auFlags[i] & SceneObjectTable::FLAG_VOXEL)
                     {
-                        eTextureSamplerType textureSamplerType = Renderableiter.second->GetMaterial(index)->pDiffuse->GetSamplerType();
-                        m_immediateContext->PSSetShaderResources(0u, 1u, Renderableiter.second->GetMaterial(index)->pDiffuse->GetTextureResourceView().GetAddressOf());
-                        m_immediateContext->PSSetSamplers(0u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                        pShadowVertexShader = m_voxelShadowVertexShader.get();
                     }
-                    if (Renderableiter.second->GetMaterial(index)->pNormal)
+                    else if (auFlags[i] & SceneObjectTable::FLAG_MODEL)
                     {
-                        eTextureSamplerType textureSamplerType = Renderableiter.second->GetMaterial(index)->pNormal->GetSamplerType();
-                        m_immediateContext->PSSetShaderResources(1u, 1u, Renderableiter.second->GetMaterial(index)->pNormal->GetTextureResourceView().GetAddressOf());
-                        m_immediateContext->PSSetSamplers(1u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                        pShadowVertexShader = m_skinningShadowVertexShader.get();
                     }
-
-                    m_immediateContext->DrawIndexed(Renderableiter.second->GetMesh(i).uNumIndices, Renderableiter.second->GetMesh(i).uBaseIndex, Renderableiter.second->GetMesh(i).uBaseVertex);
+                    submitShadowCaster(renderable, *pShadowVertexShader, uCascadeMask, bStatic, item);
                 }
             }
-            else
-                m_immediateContext->DrawIndexed(Renderableiter.second->GetNumIndices(), 0, 0);
-
         }
 
-        //instance data render
-        for (auto iter : m_scenes[m_pszMainSceneName]->GetVoxels())
+        //submit skymap, drawn after everything else
+        const std::shared_ptr<Skybox>& skyBox = scene.GetSkyBox();
+        if (skyBox)
         {
-            UINT stride = sizeof(SimpleVertex);
-            UINT Nstride = sizeof(NormalData);
-            UINT Istride = sizeof(InstanceData);
-
-            UINT offset = 0u;
+            XMMATRIX camera = XMMatrixTranslationFromVector(m_camera.GetEye());
 
-            //set the buffer
-            m_immediateContext->IASetVertexBuffers(0u, 1u, iter->GetVertexBuffer().GetAddressOf(), &stride, &offset);
-            m_immediateContext->IASetVertexBuffers(1u, 1u, iter->GetNormalBuffer().GetAddressOf(), &Nstride, &offset);
-            m_immediateContext->IASetVertexBuffers(2u, 1u, iter->GetInstanceBuffer().GetAddressOf(), &Istride, &offset);
+            //update renderable constant buffer
+            CBChangesEveryFrame cb2 =
+            {
+                .World = XMMatrixTranspose(skyBox->GetWorldMatrix() * camera),
+                .OutputColor = skyBox->GetOutputColor()
+            };
 
-            m_immediateContext->IASetIndexBuffer(iter->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
+            eTextureSamplerType textureSamplerType = skyBox->GetSkyboxTexture()->GetSamplerType();
 
-            //set the input layout
-            m_immediateContext->IASetInputLayout(iter->GetVertexLayout().Get());
+            DrawItem item =
+            {
+                .pInputLayout = skyBox->GetVertexLayout().Get(),
+                .pVertexShader = skyBox->GetVertexShader().Get(),
+                .pPixelShader = skyBox->GetPixelShader().Get(),
+                .apVertexBuffers = { skyBox->GetVertexBuffer().Get() },
+                .auStrides = { sizeof(SimpleVertex) },
+                .auOffsets = { 0u },
+                .pIndexBuffer = skyBox->GetIndexBuffer().Get(),
+                .pExtraConstantBuffer = nullptr,
+                .apShaderResourceViews = { skyBox->GetSkyboxTexture()->GetTextureResourceView().Get() },
+                .apSamplers = { Texture::s_samplers[static_cast<size_t>(textureSamplerType)].Get() },
+            };
 
-            //set primitive topology
-            m_immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+            writeObjectConstants(skyBox->GetConstantBuffer().Get(), cb2, item);
 
-            //update the constant buffer
-            CBChangesEveryFrame cb =
+            //for each mesh of the skybox
+            for (UINT i = 0; i < skyBox->GetNumMeshes(); ++i)
             {
-                .World = XMMatrixTranspose(iter->GetWorldMatrix()),
-                .OutputColor = iter->GetOutputColor(),
-                .HasNormalMap = iter->HasNormalMap()
-            };
-            m_immediateContext->UpdateSubresource(iter->GetConstantBuffer().Get(), 0u, nullptr, &cb, 0u, 0u);
+                item.uNumIndices = skyBox->GetMesh(i).uNumIndices;
+                item.uStartIndex = skyBox->GetMesh(i).uBaseIndex;
+                item.iBaseVertex = static_cast<INT>(skyBox->GetMesh(i).uBaseVertex);
 
-            //Set the vertex shader and constant buffers
-            m_immediateContext->VSSetShader(iter->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(2u, 1u, iter->GetConstantBuffer().GetAddressOf());
+                m_renderQueue.Submit(m_renderQueue.MakeSortKey(eRenderPass::SKY, item, 0.0f), item);
+            }
+        }
 
-            // Set the pixel shader and constant buffers
-            m_immediateContext->PSSetShader(iter->GetPixelShader().Get(), nullptr, 0u);
-            m_immediateContext->PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(2u, 1u, iter->GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
+        m_renderQueue.Sort();
+        for (UINT uCascade = 0u; uCascade < NUM_SHADOW_CASCADES; ++uCascade)
+        {
+            m_aShadowQueues[uCascade].Sort();
+            m_aStaticShadowQueues[uCascade].Sort();
+        }
 
-            //<set shader resource and samplers>
-            if (iter->HasTexture())
-            {
-                for (UINT i = 0; i < iter->GetNumMeshes(); ++i)
-                {
-                    UINT index = iter->GetMesh(i).uMaterialIndex;
-                    if (iter->GetMaterial(index)->pDiffuse)
-                    {
-                        eTextureSamplerType textureSamplerType = iter->GetMaterial(index)->pDiffuse->GetSamplerType();
-                        m_immediateContext->PSSetShaderResources(0u, 1u, iter->GetMaterial(index)->pDiffuse->GetTextureResourceView().GetAddressOf());
-                        m_immediateContext->PSSetSamplers(0u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                    }
-                    if (iter->GetMaterial(index)->pNormal)
-                    {
-                        eTextureSamplerType textureSamplerType = iter->GetMaterial(index)->pNormal->GetSamplerType();
-                        m_immediateContext->PSSetShaderResources(1u, 1u, iter->GetMaterial(index)->pNormal->GetTextureResourceView().GetAddressOf());
-                        m_immediateContext->PSSetSamplers(1u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                    }
+        //every object constant is written, the ring buffer must be unmapped before the draws
+        if (m_objectConstantRing)
+        {
+            m_objectConstantRing->Unmap(m_immediateContext.Get());
+        }
 
-                    m_immediateContext->DrawIndexedInstanced(iter->GetNumIndices(), iter->GetNumInstances(), 0u, 0u, 0u);
-                }
+        //the cascades are drawn before the main pass samples them, on whichever context runs first
+        if (m_bCastShadows)
+        {
+            renderShadowCascades(*m_stateCache);
+        }
+
+        if (m_commandRecorder)
+        {
+            //the clears and buffer updates run before the draws recorded on the deferred contexts
+            m_commandList.Execute(*m_renderContext);
+            //a bucket that fails to record is drawn on the immediate context, which an executed command list leaves in the default state
+            const BOOL bRecorded = m_renderQueue.ExecuteParallel(*m_commandRecorder, m_workerPool, *m_renderContext, [this](IRenderContext& renderContext)
+            {
+                renderContext.SetRenderTargets(m_renderTargetView.Get(), m_depthStencilView.Get());
+                renderContext.SetViewport(D3D11RenderContext::ToViewport(m_viewport));
+                bindFrameState(renderContext);
+            });
+            if (!bRecorded)
+            {
+                CHAR szMessage[128];
+                sprintf_s(szMessage, "Failed to record %u of %u draw buckets, drawn on the immediate context\n", m_renderQueue.GetStats().uNumFallbackBuckets, m_renderQueue.GetStats().uNumBuckets);
+                OutputDebugStringA(szMessage);
             }
-            else
-                m_immediateContext->DrawIndexedInstanced(iter->GetNumIndices(), iter->GetNumInstances(), 0u, 0u, 0u);
+        }
+        else
+        {
+            bindFrameState(*m_stateCache);
+            m_renderQueue.Execute(*m_stateCache);
+            m_commandList.Execute(*m_renderContext);
         }
 
-        //model render
-        for (auto Modeliter : m_scenes[m_pszMainSceneName]->GetModels())
+        if (m_objectConstantRing)
         {
-            //set vertex buffer
-            UINT stride = sizeof(SimpleVertex);
-            UINT Nstride = sizeof(NormalData);
-            UINT Astride = sizeof(AnimationData);
+            m_objectConstantRing->EndFrame(m_immediateContext.Get());
+        }
 
-            UINT aOffsets = 0u;
+        m_swapChain->Present(0, 0);
+    }
 
-            m_immediateContext->IASetVertexBuffers(0u, 1u, Modeliter.second->GetVertexBuffer().GetAddressOf(), &stride, &aOffsets);
-            m_immediateContext->IASetVertexBuffers(1u, 1u, Modeliter.second->GetNormalBuffer().GetAddressOf(), &Nstride, &aOffsets);
-            m_immediateContext->IASetVertexBuffers(3u, 1u, Modeliter.second->GetAnimationBuffer().GetAddressOf(), &Astride, &aOffsets);
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetRenderQueueStats
+      Summary:  Returns the render queue counters of the last frame
+      Returns:  const RenderQueueStats&
+                  Number of items and draws of the last frame
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const RenderQueueStats& Renderer::GetRenderQueueStats() const
+    {
+        return m_renderQueue.GetStats();
+    }
 
-            //set index buffer
-            m_immediateContext->IASetIndexBuffer(Modeliter.second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetStateCacheStats
+      Summary:  Returns the state cache counters of the last frame
+      Returns:  const StateCacheStats&
+                  Number of state calls forwarded and dropped
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const StateCacheStats& Renderer::GetStateCacheStats() const
+    {
+        return m_stateCache->GetStats();
+    }
 
-            //set input layout
-            m_immediateContext->IASetInputLayout(Modeliter.second->GetVertexLayout().Get());
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetCommandList
+      Summary:  Returns the commands recorded for the last frame
+      Returns:  const CommandList&
+                  Command list, which can be replayed on any render
+                  context
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const CommandList& Renderer::GetCommandList() const
+    {
+        return m_commandList;
+    }
 
-            //set primitive topology
-            m_immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetNumShadowCasters
+      Summary:  Returns the number of casters culled into a cascade in
+                the last frame, including the static ones drawn from
+                the cache
+      Args:     UINT uCascade
+                  Index of the cascade
+      Returns:  UINT
+                  Number of casters culled into the cascade
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Renderer::GetNumShadowCasters(_In_ UINT uCascade) const
+    {
+        return m_cascadedShadowMap.GetNumCasters(uCascade);
+    }
 
-            //create renderable constant buffer and update
-            CBChangesEveryFrame cb2 =
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetNumShadowRefreshes
+      Summary:  Returns the number of times the static casters of a
+                cascade were drawn again, which stays constant while
+                neither the light nor the static casters change
+      Returns:  UINT
+                  Number of cascade refreshes since the start
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Renderer::GetNumShadowRefreshes() const
+    {
+        return m_cascadedShadowMap.GetNumRefreshes();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetDriverType
+      Summary:  Returns the Direct3D driver type
+      Returns:  D3D_DRIVER_TYPE
+                  The Direct3D driver type used
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    D3D_DRIVER_TYPE Renderer::GetDriverType() const
+    {
+        return m_driverType;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::invalidateStaticShadows
+
+      Summary:  Finds the static casters that moved, whose instances
+                changed, or that became static or stopped being one,
+                and marks as stale the cascades they were culled into
+                last frame and the ones their bounds overlap now. The
+                objects past the end of the table were removed. An
+                object is a static caster if it is visible and static,
+                unless its instances are rewritten every frame
+
+      Args:     const SceneObjectTable& objects
+                  Objects of the scene, after their update
+
+      Modifies: [m_auStaticCasterMasks, m_cascadedShadowMap].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::invalidateStaticShadows(_In_ const SceneObjectTable& objects)
+    {
+        const UINT uNumObjects = objects.GetNumObjects();
+        for (size_t i = uNumObjects; i < m_auStaticCasterMasks.size(); ++i)
+        {
+            m_cascadedShadowMap.InvalidateCascades(m_auStaticCasterMasks[i] & ~STATIC_CASTER);
+        }
+        m_auStaticCasterMasks.resize(uNumObjects, 0u);
+
+        const XMFLOAT4X4* aWorldMatrices = objects.GetWorldMatrices();
+        Renderable* const* apRenderables = objects.GetRenderables();
+        const UINT* auFlags = objects.GetFlags();
+        const uint8_t* abMoved = objects.GetMovedFlags();
+        for (UINT i = 0u; i < uNumObjects; ++i)
+        {
+            const BOOL bVoxel = (auFlags[i] & SceneObjectTable::FLAG_VOXEL) != 0u;
+            BOOL bStatic = (auFlags[i] & (SceneObjectTable::FLAG_VISIBLE | SceneObjectTable::FLAG_STATIC)) == (SceneObjectTable::FLAG_VISIBLE | SceneObjectTable::FLAG_STATIC);
+            if (bStatic && bVoxel && static_cast<Voxel*>(apRenderables[i])->IsDynamic())
             {
-                .World = XMMatrixTranspose(Modeliter.second->GetWorldMatrix()),
-                .OutputColor = Modeliter.second->GetOutputColor(),
-                .HasNormalMap = Modeliter.second->HasNormalMap()
-            };
-            m_immediateContext->UpdateSubresource(Modeliter.second->GetConstantBuffer().Get(), 0u, nullptr, &cb2, 0u, 0u);
+                bStatic = FALSE;
+            }
 
-            //Additional constant buffer CBSkinning
-            CBSkinning cb4 = {};
-            for (UINT i = 0u; i < Modeliter.second->GetBoneTransforms().size(); ++i)
+            const BOOL bCached = (m_auStaticCasterMasks[i] & STATIC_CASTER) != 0u;
+            if (!bStatic && !bCached)
             {
-                cb4.BoneTransforms[i] = XMMatrixTranspose(Modeliter.second->GetBoneTransforms()[i]);
+                continue;
             }
 
-            m_immediateContext->UpdateSubresource(Modeliter.second->GetSkinningConstantBuffer().Get(), 0u, nullptr, &cb4, 0u, 0u);
+            const BOOL bChanged = abMoved[i] || bStatic != bCached || (bVoxel && static_cast<Voxel*>(apRenderables[i])->HasDirtyInstances());
+            if (!bChanged)
+            {
+                continue;
+            }
 
-            //set shader & set constant buffer
-            m_immediateContext->VSSetShader(Modeliter.second->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(2u, 1u, Modeliter.second->GetConstantBuffer().GetAddressOf());
+            m_cascadedShadowMap.InvalidateCascades(m_auStaticCasterMasks[i] & ~STATIC_CASTER);
+            m_auStaticCasterMasks[i] = 0u;
 
-            //set ps constant buffer
-            m_immediateContext->PSSetShader(Modeliter.second->GetPixelShader().Get(), nullptr, 0);
-            m_immediateContext->PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(2u, 1u, Modeliter.second->GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
+            if (bStatic)
+            {
+                BoundingBox worldBounds;
+                apRenderables[i]->GetLocalBounds().Transform(worldBounds, XMLoadFloat4x4(&aWorldMatrices[i]));
+                m_cascadedShadowMap.Invalidate(worldBounds);
 
-            //<set shader resource and samplers>
-            if (Modeliter.second->HasTexture())
+                //the cascades are filled in when the caster is culled
+                m_auStaticCasterMasks[i] = STATIC_CASTER;
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::requestTextureMips
+
+      Summary:  Requests from the texture streamer the mips the textures
+                of a renderable are sampled at, from the texture
+                coordinates per unit of each mesh and the pixels per
+                unit at the nearest point of the bounds
+
+      Args:     const Renderable& renderable
+                  Renderable drawn
+                const XMMATRIX& world
+                  World matrix of the renderable, including its parents
+                const BoundingBox& worldBounds
+                  Bounds of the renderable in world space
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::requestTextureMips(_In_ const Renderable& renderable, _In_ const XMMATRIX& world, _In_ const BoundingBox& worldBounds)
+    {
+        if (!renderable.HasTexture())
+        {
+            return;
+        }
+
+        const FLOAT distance = (std::max)(
+            XMVectorGetX(XMVector3Length(XMLoadFloat3(&worldBounds.Center) - m_camera.GetEye())) - XMVectorGetX(XMVector3Length(XMLoadFloat3(&worldBounds.Extents))),
+            1e-3f
+        );
+        const FLOAT pixelsPerUnit = 0.5f * m_viewport.Height * XMVectorGetY(m_projection.r[1]) / distance;
+
+        //the smallest scale of the world matrix, so stretched objects ask for the finer mips
+        const FLOAT scale = (std::min)(
+            (std::min)(XMVectorGetX(XMVector3Length(world.r[0])), XMVectorGetX(XMVector3Length(world.r[1]))),
+            XMVectorGetX(XMVector3Length(world.r[2]))
+        );
+        if (!(scale > 0.0f))
+        {
+            return;
+        }
+
+        TextureStreamer& textureStreamer = Model::GetTextureStreamer();
+        for (UINT i = 0; i < renderable.GetNumMeshes(); ++i)
+        {
+            const Renderable::BasicMeshEntry& mesh = renderable.GetMesh(i);
+            if (mesh.uMaterialIndex >= renderable.GetNumMaterials() || !(mesh.uvDensity > 0.0f))
             {
-                for (UINT i = 0; i < Modeliter.second->GetNumMeshes(); ++i)
-                {
-                    UINT index = Modeliter.second->GetMesh(i).uMaterialIndex;
-                    if (Modeliter.second->GetMaterial(index)->pDiffuse)
-                    {
-                        eTextureSamplerType textureSamplerType = Modeliter.second->GetMaterial(index)->pDiffuse->GetSamplerType();
-                        m_immediateContext->PSSetShaderResources(0u, 1u, Modeliter.second->GetMaterial(index)->pDiffuse->GetTextureResourceView().GetAddressOf());
-                        m_immediateContext->PSSetSamplers(0u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                    }
-                    if (Modeliter.second->GetMaterial(index)->pNormal)
-                    {
-                        eTextureSamplerType textureSamplerType = Modeliter.second->GetMaterial(index)->pNormal->GetSamplerType();
-                        m_immediateContext->PSSetShaderResources(1u, 1u, Modeliter.second->GetMaterial(index)->pNormal->GetTextureResourceView().GetAddressOf());
-                        m_immediateContext->PSSetSamplers(1u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                    }
+                continue;
+            }
+
+            const std::shared_ptr<Material>& material = renderable.GetMaterial(mesh.uMaterialIndex);
+            const FLOAT uvPerPixel = mesh.uvDensity / (scale * pixelsPerUnit);
+            textureStreamer.Request(material->pDiffuse, uvPerPixel);
+            textureStreamer.Request(material->pNormal, uvPerPixel);
+        }
+    }
 
-                    m_immediateContext->DrawIndexed(Modeliter.second->GetMesh(i).uNumIndices, Modeliter.second->GetMesh(i).uBaseIndex, Modeliter.second->GetMesh(i).uBaseVertex);
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::submitRenderable
+
+      Summary:  Submits a draw item for each mesh of a renderable, or a
+                single one if it has no textures. The buffers, shaders
+                and textures of the renderable are filled into a copy
+                of the given item
+
+      Args:     Renderable& renderable
+                  Renderable to draw
+                const XMFLOAT4X4& world
+                  World matrix of the renderable, including its parents
+                eRenderPass ePass
+                  Pass the renderable is drawn in
+                UINT uShaderFeatures
+                  Shader::FEATURE_* bits selecting the shader variants
+                const DrawItem& baseItem
+                  Draw item with the states specific to the kind of
+                  renderable, such as instance or animation buffers
+
+      Modifies: [m_renderQueue].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::submitRenderable(_In_ Renderable& renderable, _In_ const XMFLOAT4X4& world, _In_ eRenderPass ePass, _In_ UINT uShaderFeatures, _In_ const DrawItem& baseItem)
+    {
+        DrawItem item = baseItem;
+        item.pInputLayout = renderable.GetVertexLayout().Get();
+        item.pVertexShader = renderable.GetVertexShader(uShaderFeatures).Get();
+        item.pPixelShader = renderable.GetPixelShader(uShaderFeatures).Get();
+        item.apVertexBuffers[0] = renderable.GetVertexBuffer().Get();
+        item.auStrides[0] = sizeof(SimpleVertex);
+        item.pIndexBuffer = renderable.GetIndexBuffer().Get();
+        if (!item.pObjectConstantBuffer)
+        {
+            item.pObjectConstantBuffer = renderable.GetConstantBuffer().Get();
+        }
+
+        //front to back within a pass, relative to the far plane
+        const FLOAT normalizedDepth = XMVectorGetX(XMVector3Length(XMVectorSet(world._41, world._42, world._43, 1.0f) - m_camera.GetEye())) / 1000.0f;
+
+        if (!renderable.HasTexture())
+        {
+            item.uNumIndices = renderable.GetNumIndices();
+            m_renderQueue.Submit(m_renderQueue.MakeSortKey(ePass, item, normalizedDepth), item);
+            return;
+        }
+
+        for (UINT i = 0; i < renderable.GetNumMeshes(); ++i)
+        {
+            const Renderable::BasicMeshEntry& mesh = renderable.GetMesh(i);
+            const std::shared_ptr<Material>& material = renderable.GetMaterial(mesh.uMaterialIndex);
+
+            DrawItem meshItem = item;
+            // Textures still loading in the background are drawn with placeholders
+            if (material->pDiffuse)
+            {
+                eTextureSamplerType textureSamplerType = material->pDiffuse->GetSamplerType();
+                meshItem.apShaderResourceViews[0] = material->pDiffuse->GetTextureResourceView().Get();
+                if (!meshItem.apShaderResourceViews[0])
+                {
+                    meshItem.apShaderResourceViews[0] = m_invalidTexture->GetTextureResourceView().Get();
                 }
+                meshItem.apSamplers[0] = Texture::s_samplers[static_cast<size_t>(textureSamplerType)].Get();
             }
-            else
-                m_immediateContext->DrawIndexed(Modeliter.second->GetNumIndices(), 0, 0);
+            if (material->pNormal)
+            {
+                eTextureSamplerType textureSamplerType = material->pNormal->GetSamplerType();
+                meshItem.apShaderResourceViews[1] = material->pNormal->GetTextureResourceView().Get();
+                if (!meshItem.apShaderResourceViews[1])
+                {
+                    meshItem.apShaderResourceViews[1] = m_flatNormalView.Get();
+                }
+                meshItem.apSamplers[1] = Texture::s_samplers[static_cast<size_t>(textureSamplerType)].Get();
+            }
+
+            meshItem.uNumIndices = mesh.uNumIndices;
+            meshItem.uStartIndex = mesh.uBaseIndex;
+            meshItem.iBaseVertex = static_cast<INT>(mesh.uBaseVertex);
+
+            m_renderQueue.Submit(m_renderQueue.MakeSortKey(ePass, meshItem, normalizedDepth), meshItem);
         }
+    }
 
-        //skymap render
-        if (m_scenes[m_pszMainSceneName]->GetSkyBox())
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::submitShadowCaster
+
+      Summary:  Submits a depth only draw item for each mesh of a
+                renderable to every cascade it was culled into, in the
+                static or the dynamic queues. The buffers and object
+                constants of the given item are kept, its shaders are
+                replaced by the shadow shader
+
+      Args:     Renderable& renderable
+                  Renderable casting the shadow
+                VertexShader& shadowVertexShader
+                  Shadow vertex shader matching the renderable's
+                  vertex layout
+                UINT uCascadeMask
+                  Cascades to draw the renderable into, bit i being
+                  cascade i
+                BOOL bStatic
+                  TRUE to draw the renderable into the cached static
+                  depth of the cascades
+                const DrawItem& baseItem
+                  Draw item of the main pass, without its meshes
+
+      Modifies: [m_aShadowQueues, m_aStaticShadowQueues].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::submitShadowCaster(_In_ Renderable& renderable, _In_ VertexShader& shadowVertexShader, _In_ UINT uCascadeMask, _In_ BOOL bStatic, _In_ const DrawItem& baseItem)
+    {
+        DrawItem item = baseItem;
+        item.pInputLayout = shadowVertexShader.GetVertexLayout().Get();
+        item.pVertexShader = shadowVertexShader.GetVertexShader().Get();
+        item.pPixelShader = nullptr;
+        item.apVertexBuffers[0] = renderable.GetVertexBuffer().Get();
+        item.auStrides[0] = sizeof(SimpleVertex);
+        item.pIndexBuffer = renderable.GetIndexBuffer().Get();
+
+        for (UINT uCascade = 0u; uCascade < NUM_SHADOW_CASCADES; ++uCascade)
         {
-            UINT stride = sizeof(SimpleVertex);
-            UINT offsets = 0u;
-            m_immediateContext->IASetVertexBuffers(0u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetVertexBuffer().GetAddressOf(), &stride, &offsets);
-            m_immediateContext->IASetIndexBuffer(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
-            m_immediateContext->IASetInputLayout(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetVertexLayout().Get());
+            if (!(uCascadeMask & (1u << uCascade)))
+            {
+                continue;
+            }
 
-            XMMATRIX camera = XMMatrixTranslationFromVector(m_camera.GetEye());
-            
-            //update renderable constant buffer
-            CBChangesEveryFrame cb2 =
+            RenderQueue& shadowQueue = bStatic ? m_aStaticShadowQueues[uCascade] : m_aShadowQueues[uCascade];
+            if (!renderable.HasTexture())
             {
-                .World = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetWorldMatrix()*camera),
-                .OutputColor = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetOutputColor()
-            };
-            m_immediateContext->UpdateSubresource(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetConstantBuffer().Get(), 0u, nullptr, &cb2, 0u, 0u);
+                item.uNumIndices = renderable.GetNumIndices();
+                shadowQueue.Submit(shadowQueue.MakeSortKey(eRenderPass::MAIN, item, 0.0f), item);
+                continue;
+            }
 
-            //set shader
-            m_immediateContext->VSSetShader(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->PSSetShader(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetPixelShader().Get(), nullptr, 0u);
+            for (UINT i = 0; i < renderable.GetNumMeshes(); ++i)
+            {
+                const Renderable::BasicMeshEntry& mesh = renderable.GetMesh(i);
 
-            //bind constant buffer
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(2u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetConstantBuffer().GetAddressOf());
+                DrawItem meshItem = item;
+                meshItem.uNumIndices = mesh.uNumIndices;
+                meshItem.uStartIndex = mesh.uBaseIndex;
+                meshItem.iBaseVertex = static_cast<INT>(mesh.uBaseVertex);
 
-            m_immediateContext->PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(2u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetConstantBuffer().GetAddressOf());
+                shadowQueue.Submit(shadowQueue.MakeSortKey(eRenderPass::MAIN, meshItem, 0.0f), meshItem);
+            }
+        }
+    }
 
-            //for each mesh of the skybox
-            UINT index = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetNumMeshes();
-            for (UINT i = 0; i < index; ++i)
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::renderShadowCascades
+
+      Summary:  Draws the casters of every cascade into its slice of the
+                shadow map, depth only, then binds the back buffer and
+                its viewport again. The static casters of the refreshed
+                cascades are drawn into the static depth, which is
+                copied into the shadow map when it was refreshed or
+                dynamic casters were drawn over it last frame. The
+                dynamic casters are then drawn on top. The shadow map
+                is unbound from the pixel shader first, as it can not
+                be read and written at once
+
+      Args:     IRenderContext& renderContext
+                  Render context to draw the cascades on
+
+      Modifies: [m_abDynamicShadowsDrawn].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::renderShadowCascades(_In_ IRenderContext& renderContext)
+    {
+        renderContext.SetPSShaderResource(5u, nullptr);
+        renderContext.SetPixelShader(nullptr);
+        renderContext.SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        renderContext.SetViewport(D3D11RenderContext::ToViewport(m_cascadedShadowMap.GetViewport()));
+
+        for (UINT uCascade = 0u; uCascade < NUM_SHADOW_CASCADES; ++uCascade)
+        {
+            const BOOL bRefresh = (m_uShadowRefreshMask & (1u << uCascade)) != 0u;
+            const BOOL bDynamic = !m_aShadowQueues[uCascade].IsEmpty();
+            renderContext.SetVSConstantBuffer(0u, m_acbShadowPasses[uCascade].Get(), 0u, 0u);
+
+            if (bRefresh)
             {
-                eTextureSamplerType textureSamplerType = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetSkyboxTexture()->GetSamplerType();
-                m_immediateContext->PSSetShaderResources(0u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetSkyboxTexture()->GetTextureResourceView().GetAddressOf());
-                m_immediateContext->PSSetSamplers(0u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                ID3D11DepthStencilView* pStaticDepthStencilView = m_cascadedShadowMap.GetStaticDepthStencilView(uCascade);
+                renderContext.SetRenderTargets(nullptr, pStaticDepthStencilView);
+                renderContext.ClearDepthStencilView(pStaticDepthStencilView, D3D11_CLEAR_DEPTH, 1.0f, 0u);
 
-                m_immediateContext->DrawIndexed(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMesh(i).uNumIndices, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMesh(i).uBaseIndex, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMesh(i).uBaseVertex);
+                m_aStaticShadowQueues[uCascade].Execute(renderContext);
             }
+
+            //otherwise the slice still holds the static depth alone
+            if (bRefresh || m_abDynamicShadowsDrawn[uCascade])
+            {
+                renderContext.CopySubresource(m_cascadedShadowMap.GetDepthTexture(), uCascade, m_cascadedShadowMap.GetStaticDepthTexture(), uCascade);
+            }
+
+            if (bDynamic)
+            {
+                renderContext.SetRenderTargets(nullptr, m_cascadedShadowMap.GetDepthStencilView(uCascade));
+                m_aShadowQueues[uCascade].Execute(renderContext);
+            }
+            m_abDynamicShadowsDrawn[uCascade] = bDynamic;
         }
 
-        m_swapChain->Present(0, 0);
+        renderContext.SetRenderTargets(m_renderTargetView.Get(), m_depthStencilView.Get());
+        renderContext.SetViewport(D3D11RenderContext::ToViewport(m_viewport));
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Renderer::GetDriverType
-      Summary:  Returns the Direct3D driver type
-      Returns:  D3D_DRIVER_TYPE
-                  The Direct3D driver type used
+      Method:   Renderer::bindFrameState
+
+      Summary:  Binds the primitive topology, the per-frame constant
+                buffers and the shadow map shared by every draw
+
+      Args:     IRenderContext& renderContext
+                  Render context to bind the states on
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    D3D_DRIVER_TYPE Renderer::GetDriverType() const
+    void Renderer::bindFrameState(_In_ IRenderContext& renderContext)
     {
-        return m_driverType;
+        renderContext.SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        renderContext.SetVSConstantBuffer(0u, m_camera.GetConstantBuffer().Get(), 0u, 0u);
+        renderContext.SetVSConstantBuffer(1u, m_cbChangeOnResize.Get(), 0u, 0u);
+        renderContext.SetPSConstantBuffer(0u, m_camera.GetConstantBuffer().Get(), 0u, 0u);
+        renderContext.SetPSConstantBuffer(1u, m_cbChangeOnResize.Get(), 0u, 0u);
+        renderContext.SetPSConstantBuffer(3u, m_cbLights.Get(), 0u, 0u);
+        renderContext.SetPSConstantBuffer(5u, m_lightClusterGrid.GetConstantBuffer(), 0u, 0u);
+        renderContext.SetPSShaderResource(2u, m_lightClusterGrid.GetLightBufferView());
+        renderContext.SetPSShaderResource(3u, m_lightClusterGrid.GetClusterBufferView());
+        renderContext.SetPSShaderResource(4u, m_lightClusterGrid.GetIndexBufferView());
+        renderContext.SetPSConstantBuffer(6u, m_cbShadowCascades.Get(), 0u, 0u);
+        renderContext.SetPSShaderResource(5u, m_cascadedShadowMap.GetShaderResourceView());
+        renderContext.SetPSSampler(5u, m_cascadedShadowMap.GetComparisonSampler());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::writeObjectConstants
+
+      Summary:  Writes the constants of an object into the ring buffer
+                and points the draw item at their range. Falls back to
+                updating the object's own constant buffer when there is
+                no ring buffer or it is full
+
+      Args:     ID3D11Buffer* pObjectConstantBuffer
+                  Constant buffer of the object
+                const CBChangesEveryFrame& cb
+                  Constants of the object
+                DrawItem& item
+                  Draw item to bind the constants with
+
+      Modifies: [m_objectConstantRing, m_stateCache].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::writeObjectConstants(_In_ ID3D11Buffer* pObjectConstantBuffer, _In_ const CBChangesEveryFrame& cb, _Inout_ DrawItem& item)
+    {
+        if (m_objectConstantRing && m_objectConstantRing->Allocate(&cb, sizeof(cb), item.uObjectFirstConstant, item.uObjectNumConstants))
+        {
+            item.pObjectConstantBuffer = m_objectConstantRing->GetBuffer().Get();
+            return;
+        }
+
+        m_stateCache->UpdateBuffer(pObjectConstantBuffer, &cb, sizeof(cb));
+        item.pObjectConstantBuffer = pObjectConstantBuffer;
+        item.uObjectFirstConstant = 0u;
+        item.uObjectNumConstants = 0u;
     }
-}
\ No newline at end of file
+}
@@ -14,16 +14,26 @@
 #include "Common.h"
 
 #include "Camera/Camera.h"
+#include "Light/CascadedShadowMap.h"
+#include "Light/LightClusterGrid.h"
+#include "Light/LightSelector.h"
 #include "Light/PointLight.h"
 #include "Model/Model.h"
+#include "Renderer/CommandList.h"
+#include "Renderer/ConstantRingBuffer.h"
+#include "Renderer/D3D11CommandRecorder.h"
+#include "Renderer/D3D11RenderContext.h"
 #include "Renderer/DataTypes.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/RenderContext.h"
+#include "Renderer/RenderQueue.h"
+#include "Renderer/StateCache.h"
+#include "Renderer/WorkerPool.h"
 #include "Scene/Scene.h"
 #include "Shader/PixelShader.h"
+#include "Shader/ShaderHotReloader.h"
 #include "Shader/VertexShader.h"
 #include "Window/MainWindow.h"
-#include "Texture/RenderTexture.h"
-#include "Shader/ShadowVertexShader.h"
 
 namespace library
 {
@@ -43,6 +53,32 @@ namespace library
                   Renders the frame
                 GetDriverType
                   Returns the Direct3D driver type
+                GetRenderQueueStats
+                  Returns the render queue counters of the last frame
+                GetStateCacheStats
+                  Returns the state cache counters of the last frame
+                GetCommandList
+                  Returns the commands recorded for the last frame
+                GetNumShadowCasters
+                  Returns the number of casters culled into a cascade
+                GetNumShadowRefreshes
+                  Returns the number of times static shadows were
+                  drawn again
+                invalidateStaticShadows
+                  Marks the cascades the changed static casters are in
+                submitRenderable
+                  Submits the draw items of a renderable
+                requestTextureMips
+                  Requests the mips the textures of a renderable are
+                  sampled at
+                submitShadowCaster
+                  Submits the draw items of a renderable to cascades
+                renderShadowCascades
+                  Draws the casters into the cascades of the shadow map
+                bindFrameState
+                  Binds the states shared by every draw of a frame
+                writeObjectConstants
+                  Writes the constants of an object for a draw item
                 Renderer
                   Constructor.
                 ~Renderer
@@ -51,6 +87,16 @@ namespace library
     class Renderer final
     {
     public:
+        static constexpr const UINT MAX_RECORDING_CONTEXTS = 4u;
+        static constexpr const UINT OBJECT_CONSTANT_RING_SIZE = 4u * 1024u * 1024u;
+        static constexpr const FLOAT SHADOW_DISTANCE = 100.0f;
+
+        // Number of stale cascades whose static casters are drawn again per frame
+        static constexpr const UINT SHADOW_REFRESH_BUDGET = 2u;
+
+        // Marks the static casters in m_auStaticCasterMasks, the other bits being the cascades they were culled into
+        static constexpr const UINT STATIC_CASTER = 0x80000000u;
+
         Renderer();
         Renderer(const Renderer& other) = delete;
         Renderer(Renderer&& other) = delete;
@@ -63,7 +109,7 @@ namespace library
         HRESULT AddScene(_In_ PCWSTR pszSceneName, _In_ const std::shared_ptr<Scene>& scene);
         std::shared_ptr<Scene> GetSceneOrNull(_In_ PCWSTR pszSceneName);
         HRESULT SetMainScene(_In_ PCWSTR pszSceneName);
-        void SetShadowMapShaders(_In_ std::shared_ptr<ShadowVertexShader> vertexShader, _In_ std::shared_ptr<PixelShader> pixelShader);
+        void SetShadowMapShaders(_In_ std::shared_ptr<VertexShader> vertexShader, _In_ std::shared_ptr<VertexShader> voxelVertexShader, _In_ std::shared_ptr<VertexShader> skinningVertexShader);
 
         void HandleInput(_In_ const DirectionsInput& directions, _In_ const MouseRelativeMovement& mouseRelativeMovement, _In_ FLOAT deltaTime);
         void Update(_In_ FLOAT deltaTime);
@@ -71,6 +117,20 @@ namespace library
         //void RenderSceneToTexture();
 
         D3D_DRIVER_TYPE GetDriverType() const;
+        const RenderQueueStats& GetRenderQueueStats() const;
+        const StateCacheStats& GetStateCacheStats() const;
+        const CommandList& GetCommandList() const;
+        UINT GetNumShadowCasters(_In_ UINT uCascade) const;
+        UINT GetNumShadowRefreshes() const;
+
+    private:
+        void invalidateStaticShadows(_In_ const SceneObjectTable& objects);
+        void submitRenderable(_In_ Renderable& renderable, _In_ const XMFLOAT4X4& world, _In_ eRenderPass ePass, _In_ UINT uShaderFeatures, _In_ const DrawItem& baseItem);
+        void requestTextureMips(_In_ const Renderable& renderable, _In_ const XMMATRIX& world, _In_ const BoundingBox& worldBounds);
+        void submitShadowCaster(_In_ Renderable& renderable, _In_ VertexShader& shadowVertexShader, _In_ UINT uCascadeMask, _In_ BOOL bStatic, _In_ const DrawItem& baseItem);
+        void renderShadowCascades(_In_ IRenderContext& renderContext);
+        void bindFrameState(_In_ IRenderContext& renderContext);
+        void writeObjectConstants(_In_ ID3D11Buffer* pObjectConstantBuffer, _In_ const CBChangesEveryFrame& cb, _Inout_ DrawItem& item);
 
     private:
         D3D_DRIVER_TYPE m_driverType;
@@ -86,16 +146,37 @@ namespace library
         ComPtr<ID3D11DepthStencilView> m_depthStencilView;
         ComPtr<ID3D11Buffer> m_cbChangeOnResize;
         ComPtr<ID3D11Buffer> m_cbLights;
-        ComPtr<ID3D11Buffer> m_cbShadowMatrix;
+        ComPtr<ID3D11Buffer> m_cbShadowCascades;
+        ComPtr<ID3D11Buffer> m_acbShadowPasses[NUM_SHADOW_CASCADES];
         PCWSTR m_pszMainSceneName;
         BYTE m_padding[8];
         Camera m_camera;
         XMMATRIX m_projection;
+        D3D11_VIEWPORT m_viewport;
 
         std::unordered_map<std::wstring, std::shared_ptr<Scene>> m_scenes;
         std::shared_ptr<Texture> m_invalidTexture;
-        std::shared_ptr<RenderTexture> m_shadowMapTexture;
-        std::shared_ptr<ShadowVertexShader> m_shadowVertexShader;
-        std::shared_ptr<PixelShader> m_shadowPixelShader;
+        std::shared_ptr<VertexShader> m_shadowVertexShader;
+        std::shared_ptr<VertexShader> m_voxelShadowVertexShader;
+        std::shared_ptr<VertexShader> m_skinningShadowVertexShader;
+        std::unique_ptr<IRenderContext> m_renderContext;
+        CommandList m_commandList;
+        std::unique_ptr<StateCache> m_stateCache;
+        std::unique_ptr<ICommandRecorder> m_commandRecorder;
+        WorkerPool m_workerPool;
+        std::unique_ptr<ConstantRingBuffer> m_objectConstantRing;
+        RenderQueue m_renderQueue;
+        LightClusterGrid m_lightClusterGrid;
+        LightSelector m_lightSelector;
+        std::vector<Lights> m_aFrameLights;
+        CascadedShadowMap m_cascadedShadowMap;
+        RenderQueue m_aShadowQueues[NUM_SHADOW_CASCADES];
+        RenderQueue m_aStaticShadowQueues[NUM_SHADOW_CASCADES];
+        std::vector<UINT> m_auStaticCasterMasks;
+        UINT m_uShadowRefreshMask;
+        BOOL m_abDynamicShadowsDrawn[NUM_SHADOW_CASCADES];
+        BOOL m_bCastShadows;
+        ShaderHotReloader m_shaderReloader;
+        ComPtr<ID3D11ShaderResourceView> m_flatNormalView;
     };
 }
\ No newline at end of file
@@ -0,0 +1,263 @@
+#include "Renderer/StateCache.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCache::StateCache
+
+      Summary:  Constructor
+
+      Args:     IRenderContext* pRenderContext
+                  Render context the calls that change a state are
+                  forwarded to
+
+      Modifies: [m_pRenderContext, m_pInputLayout, m_uTopology,
+                 m_aVertexBuffers, m_indexBuffer, m_pVertexShader,
+                 m_pPixelShader, m_aVSConstantBuffers,
+                 m_aPSConstantBuffers, m_apPSShaderResourceViews,
+                 m_apPSSamplers, m_bInputLayoutKnown, m_bTopologyKnown,
+                 m_abVertexBuffersKnown, m_bIndexBufferKnown,
+                 m_bVertexShaderKnown, m_bPixelShaderKnown,
+                 m_abVSConstantBuffersKnown, m_abPSConstantBuffersKnown,
+                 m_abPSShaderResourceViewsKnown, m_abPSSamplersKnown,
+                 m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    StateCache::StateCache(IRenderContext* pRenderContext)
+        : m_pRenderContext(pRenderContext)
+        , m_pInputLayout(nullptr)
+        , m_uTopology(0u)
+        , m_aVertexBuffers()
+        , m_indexBuffer()
+        , m_pVertexShader(nullptr)
+        , m_pPixelShader(nullptr)
+        , m_aVSConstantBuffers()
+        , m_aPSConstantBuffers()
+        , m_apPSShaderResourceViews()
+        , m_apPSSamplers()
+        , m_bInputLayoutKnown(false)
+        , m_bTopologyKnown(false)
+        , m_abVertexBuffersKnown()
+        , m_bIndexBufferKnown(false)
+        , m_bVertexShaderKnown(false)
+        , m_bPixelShaderKnown(false)
+        , m_abVSConstantBuffersKnown()
+        , m_abPSConstantBuffersKnown()
+        , m_abPSShaderResourceViewsKnown()
+        , m_abPSSamplersKnown()
+        , m_stats()
+    {
+    }
+
+    void StateCache::ClearRenderTargetView(ID3D11RenderTargetView* pRenderTargetView, const float aColor[4])
+    {
+        m_pRenderContext->ClearRenderTargetView(pRenderTargetView, aColor);
+    }
+
+    void StateCache::ClearDepthStencilView(ID3D11DepthStencilView* pDepthStencilView, uint32_t uClearFlags, float depth, uint8_t uStencil)
+    {
+        m_pRenderContext->ClearDepthStencilView(pDepthStencilView, uClearFlags, depth, uStencil);
+    }
+
+    void StateCache::UpdateBuffer(ID3D11Buffer* pBuffer, const void* pData, uint32_t uDataSize)
+    {
+        m_pRenderContext->UpdateBuffer(pBuffer, pData, uDataSize);
+    }
+
+    void StateCache::CopySubresource(ID3D11Resource* pDstResource, uint32_t uDstSubresource, ID3D11Resource* pSrcResource, uint32_t uSrcSubresource)
+    {
+        m_pRenderContext->CopySubresource(pDstResource, uDstSubresource, pSrcResource, uSrcSubresource);
+    }
+
+    void StateCache::SetRenderTargets(ID3D11RenderTargetView* pRenderTargetView, ID3D11DepthStencilView* pDepthStencilView)
+    {
+        m_pRenderContext->SetRenderTargets(pRenderTargetView, pDepthStencilView);
+    }
+
+    void StateCache::SetViewport(const Viewport& viewport)
+    {
+        m_pRenderContext->SetViewport(viewport);
+    }
+
+    void StateCache::SetInputLayout(ID3D11InputLayout* pInputLayout)
+    {
+        if (changeState(m_pInputLayout, pInputLayout, m_bInputLayoutKnown))
+        {
+            m_pRenderContext->SetInputLayout(pInputLayout);
+        }
+    }
+
+    void StateCache::SetPrimitiveTopology(uint32_t uTopology)
+    {
+        if (changeState(m_uTopology, uTopology, m_bTopologyKnown))
+        {
+            m_pRenderContext->SetPrimitiveTopology(uTopology);
+        }
+    }
+
+    void StateCache::SetVertexBuffer(uint32_t uSlot, ID3D11Buffer* pBuffer, uint32_t uStride, uint32_t uOffset)
+    {
+        if (uSlot >= NUM_CACHED_SLOTS
+            || changeState(m_aVertexBuffers[uSlot], VertexBufferBinding{ .pBuffer = pBuffer, .uStride = uStride, .uOffset = uOffset }, m_abVertexBuffersKnown[uSlot]))
+        {
+            m_pRenderContext->SetVertexBuffer(uSlot, pBuffer, uStride, uOffset);
+        }
+    }
+
+    void StateCache::SetIndexBuffer(ID3D11Buffer* pBuffer, uint32_t uFormat)
+    {
+        if (changeState(m_indexBuffer, IndexBufferBinding{ .pBuffer = pBuffer, .uFormat = uFormat }, m_bIndexBufferKnown))
+        {
+            m_pRenderContext->SetIndexBuffer(pBuffer, uFormat);
+        }
+    }
+
+    void StateCache::SetVertexShader(ID3D11VertexShader* pVertexShader)
+    {
+        if (changeState(m_pVertexShader, pVertexShader, m_bVertexShaderKnown))
+        {
+            m_pRenderContext->SetVertexShader(pVertexShader);
+        }
+    }
+
+    void StateCache::SetPixelShader(ID3D11PixelShader* pPixelShader)
+    {
+        if (changeState(m_pPixelShader, pPixelShader, m_bPixelShaderKnown))
+        {
+            m_pRenderContext->SetPixelShader(pPixelShader);
+        }
+    }
+
+    void StateCache::SetVSConstantBuffer(uint32_t uSlot, ID3D11Buffer* pBuffer, uint32_t uFirstConstant, uint32_t uNumConstants)
+    {
+        if (uSlot >= NUM_CACHED_SLOTS
+            || changeState(m_aVSConstantBuffers[uSlot], ConstantBufferBinding{ .pBuffer = pBuffer, .uFirstConstant = uFirstConstant, .uNumConstants = uNumConstants }, m_abVSConstantBuffersKnown[uSlot]))
+        {
+            m_pRenderContext->SetVSConstantBuffer(uSlot, pBuffer, uFirstConstant, uNumConstants);
+        }
+    }
+
+    void StateCache::SetPSConstantBuffer(uint32_t uSlot, ID3D11Buffer* pBuffer, uint32_t uFirstConstant, uint32_t uNumConstants)
+    {
+        if (uSlot >= NUM_CACHED_SLOTS
+            || changeState(m_aPSConstantBuffers[uSlot], ConstantBufferBinding{ .pBuffer = pBuffer, .uFirstConstant = uFirstConstant, .uNumConstants = uNumConstants }, m_abPSConstantBuffersKnown[uSlot]))
+        {
+            m_pRenderContext->SetPSConstantBuffer(uSlot, pBuffer, uFirstConstant, uNumConstants);
+        }
+    }
+
+    void StateCache::SetPSShaderResource(uint32_t uSlot, ID3D11ShaderResourceView* pShaderResourceView)
+    {
+        if (uSlot >= NUM_CACHED_SLOTS || changeState(m_apPSShaderResourceViews[uSlot], pShaderResourceView, m_abPSShaderResourceViewsKnown[uSlot]))
+        {
+            m_pRenderContext->SetPSShaderResource(uSlot, pShaderResourceView);
+        }
+    }
+
+    void StateCache::SetPSSampler(uint32_t uSlot, ID3D11SamplerState* pSampler)
+    {
+        if (uSlot >= NUM_CACHED_SLOTS || changeState(m_apPSSamplers[uSlot], pSampler, m_abPSSamplersKnown[uSlot]))
+        {
+            m_pRenderContext->SetPSSampler(uSlot, pSampler);
+        }
+    }
+
+    void StateCache::DrawIndexed(uint32_t uNumIndices, uint32_t uStartIndex, int32_t iBaseVertex)
+    {
+        m_pRenderContext->DrawIndexed(uNumIndices, uStartIndex, iBaseVertex);
+    }
+
+    void StateCache::DrawIndexedInstanced(uint32_t uNumIndices, uint32_t uNumInstances, uint32_t uStartIndex, int32_t iBaseVertex, uint32_t uStartInstance)
+    {
+        m_pRenderContext->DrawIndexedInstanced(uNumIndices, uNumInstances, uStartIndex, iBaseVertex, uStartInstance);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCache::Invalidate
+
+      Summary:  Forgets every shadowed state so the next bind of each
+                state is forwarded. Must be called whenever the wrapped
+                context is changed without going through the cache
+
+      Modifies: [m_bInputLayoutKnown, m_bTopologyKnown,
+                 m_abVertexBuffersKnown, m_bIndexBufferKnown,
+                 m_bVertexShaderKnown, m_bPixelShaderKnown,
+                 m_abVSConstantBuffersKnown, m_abPSConstantBuffersKnown,
+                 m_abPSShaderResourceViewsKnown, m_abPSSamplersKnown].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCache::Invalidate()
+    {
+        m_bInputLayoutKnown = false;
+        m_bTopologyKnown = false;
+        m_bIndexBufferKnown = false;
+        m_bVertexShaderKnown = false;
+        m_bPixelShaderKnown = false;
+
+        for (uint32_t uSlot = 0u; uSlot < NUM_CACHED_SLOTS; ++uSlot)
+        {
+            m_abVertexBuffersKnown[uSlot] = false;
+            m_abVSConstantBuffersKnown[uSlot] = false;
+            m_abPSConstantBuffersKnown[uSlot] = false;
+            m_abPSShaderResourceViewsKnown[uSlot] = false;
+            m_abPSSamplersKnown[uSlot] = false;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCache::ResetStats
+
+      Summary:  Resets the counters
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCache::ResetStats()
+    {
+        m_stats = { .uNumCalls = 0u, .uNumCallsAvoided = 0u };
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCache::GetStats
+
+      Summary:  Returns the number of state calls forwarded and dropped
+                since the last ResetStats
+
+      Returns:  const StateCacheStats&
+                  Counters
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const StateCacheStats& StateCache::GetStats() const
+    {
+        return m_stats;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCache::changeState
+
+      Summary:  Records a state binding
+
+      Args:     T& current
+                  Shadowed state
+                T next
+                  State to bind
+                bool& bKnown
+                  Whether the shadowed state matches the wrapped
+                  context
+
+      Modifies: [m_stats].
+
+      Returns:  bool
+                  true if the call has to be forwarded
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    template <typename T>
+    bool StateCache::changeState(T& current, T next, bool& bKnown)
+    {
+        if (bKnown && current == next)
+        {
+            ++m_stats.uNumCallsAvoided;
+            return false;
+        }
+
+        current = next;
+        bKnown = true;
+        ++m_stats.uNumCalls;
+        return true;
+    }
+}
@@ -0,0 +1,153 @@
+/*+===================================================================
+  File:      STATECACHE.H
+
+  Summary:   StateCache header file contains declarations of
+             StateCache class used for the lab samples of Game
+             Graphics Programming course. Only depends on the standard
+             library.
+
+  Classes: StateCache
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Renderer/RenderContext.h"
+
+namespace library
+{
+#define NUM_CACHED_SLOTS (8)
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   StateCacheStats
+
+      Summary:  Number of calls forwarded and dropped since the last
+                ResetStats
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct StateCacheStats
+    {
+        uint32_t uNumCalls;
+        uint32_t uNumCallsAvoided;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    StateCache
+
+      Summary:  Shadows the states bound on another render context and
+                drops the calls that would bind what is already bound.
+                Slots past NUM_CACHED_SLOTS, clears, buffer updates,
+                copies, render targets and viewports are always
+                forwarded
+
+      Methods:  Invalidate
+                  Forgets every shadowed state
+                ResetStats
+                  Resets the counters
+                GetStats
+                  Returns the counters
+                StateCache
+                  Constructor.
+                ~StateCache
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class StateCache final : public IRenderContext
+    {
+    public:
+        StateCache() = delete;
+        StateCache(IRenderContext* pRenderContext);
+        StateCache(const StateCache& other) = delete;
+        StateCache(StateCache&& other) = delete;
+        StateCache& operator=(const StateCache& other) = delete;
+        StateCache& operator=(StateCache&& other) = delete;
+        ~StateCache() = default;
+
+        void ClearRenderTargetView(ID3D11RenderTargetView* pRenderTargetView, const float aColor[4]) override;
+        void ClearDepthStencilView(ID3D11DepthStencilView* pDepthStencilView, uint32_t uClearFlags, float depth, uint8_t uStencil) override;
+        void UpdateBuffer(ID3D11Buffer* pBuffer, const void* pData, uint32_t uDataSize) override;
+        void CopySubresource(ID3D11Resource* pDstResource, uint32_t uDstSubresource, ID3D11Resource* pSrcResource, uint32_t uSrcSubresource) override;
+        void SetRenderTargets(ID3D11RenderTargetView* pRenderTargetView, ID3D11DepthStencilView* pDepthStencilView) override;
+        void SetViewport(const Viewport& viewport) override;
+        void SetInputLayout(ID3D11InputLayout* pInputLayout) override;
+        void SetPrimitiveTopology(uint32_t uTopology) override;
+        void SetVertexBuffer(uint32_t uSlot, ID3D11Buffer* pBuffer, uint32_t uStride, uint32_t uOffset) override;
+        void SetIndexBuffer(ID3D11Buffer* pBuffer, uint32_t uFormat) override;
+        void SetVertexShader(ID3D11VertexShader* pVertexShader) override;
+        void SetPixelShader(ID3D11PixelShader* pPixelShader) override;
+        void SetVSConstantBuffer(uint32_t uSlot, ID3D11Buffer* pBuffer, uint32_t uFirstConstant, uint32_t uNumConstants) override;
+        void SetPSConstantBuffer(uint32_t uSlot, ID3D11Buffer* pBuffer, uint32_t uFirstConstant, uint32_t uNumConstants) override;
+        void SetPSShaderResource(uint32_t uSlot, ID3D11ShaderResourceView* pShaderResourceView) override;
+        void SetPSSampler(uint32_t uSlot, ID3D11SamplerState* pSampler) override;
+        void DrawIndexed(uint32_t uNumIndices, uint32_t uStartIndex, int32_t iBaseVertex) override;
+        void DrawIndexedInstanced(uint32_t uNumIndices, uint32_t uNumInstances, uint32_t uStartIndex, int32_t iBaseVertex, uint32_t uStartInstance) override;
+
+        void Invalidate();
+        void ResetStats();
+        const StateCacheStats& GetStats() const;
+
+    private:
+        template <typename T>
+        bool changeState(T& current, T next, bool& bKnown);
+
+    private:
+        struct VertexBufferBinding
+        {
+            ID3D11Buffer* pBuffer;
+            uint32_t uStride;
+            uint32_t uOffset;
+
+            bool operator==(const VertexBufferBinding& other) const
+            {
+                return pBuffer == other.pBuffer && uStride == other.uStride && uOffset == other.uOffset;
+            }
+        };
+
+        struct ConstantBufferBinding
+        {
+            ID3D11Buffer* pBuffer;
+            uint32_t uFirstConstant;
+            uint32_t uNumConstants;
+
+            bool operator==(const ConstantBufferBinding& other) const
+            {
+                return pBuffer == other.pBuffer && uFirstConstant == other.uFirstConstant && uNumConstants == other.uNumConstants;
+            }
+        };
+
+        struct IndexBufferBinding
+        {
+            ID3D11Buffer* pBuffer;
+            uint32_t uFormat;
+
+            bool operator==(const IndexBufferBinding& other) const
+            {
+                return pBuffer == other.pBuffer && uFormat == other.uFormat;
+            }
+        };
+
+        IRenderContext* m_pRenderContext;
+
+        ID3D11InputLayout* m_pInputLayout;
+        uint32_t m_uTopology;
+        VertexBufferBinding m_aVertexBuffers[NUM_CACHED_SLOTS];
+        IndexBufferBinding m_indexBuffer;
+        ID3D11VertexShader* m_pVertexShader;
+        ID3D11PixelShader* m_pPixelShader;
+        ConstantBufferBinding m_aVSConstantBuffers[NUM_CACHED_SLOTS];
+        ConstantBufferBinding m_aPSConstantBuffers[NUM_CACHED_SLOTS];
+        ID3D11ShaderResourceView* m_apPSShaderResourceViews[NUM_CACHED_SLOTS];
+        ID3D11SamplerState* m_apPSSamplers[NUM_CACHED_SLOTS];
+
+        bool m_bInputLayoutKnown;
+        bool m_bTopologyKnown;
+        bool m_abVertexBuffersKnown[NUM_CACHED_SLOTS];
+        bool m_bIndexBufferKnown;
+        bool m_bVertexShaderKnown;
+        bool m_bPixelShaderKnown;
+        bool m_abVSConstantBuffersKnown[NUM_CACHED_SLOTS];
+        bool m_abPSConstantBuffersKnown[NUM_CACHED_SLOTS];
+        bool m_abPSShaderResourceViewsKnown[NUM_CACHED_SLOTS];
+        bool m_abPSSamplersKnown[NUM_CACHED_SLOTS];
+
+        StateCacheStats m_stats;
+    };
+}
@@ -0,0 +1,89 @@
+#include "Renderer/VoxelInstanceData.h"
+
+#include <cassert>
+#include <climits>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelInstanceEncoder::Encode
+
+      Summary:  Returns the instance of a block of the voxel map. The
+                map must fit in the int16 range
+
+      Args:     uint32_t uWidthIdx
+                  Cell along the x-axis
+                uint32_t uHeightIdx
+                  Block of the column
+                uint32_t uDepthIdx
+                  Cell along the z-axis
+                uint32_t uWidth
+                  Number of cells along the x-axis
+                uint32_t uHeight
+                  Maximum number of blocks in a column
+                uint32_t uDepth
+                  Number of cells along the z-axis
+                uint16_t uBlockType
+                  eBlockType value of the block
+
+      Returns:  VoxelInstanceData
+                  Instance of the block
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelInstanceData VoxelInstanceEncoder::Encode(
+        uint32_t uWidthIdx,
+        uint32_t uHeightIdx,
+        uint32_t uDepthIdx,
+        uint32_t uWidth,
+        uint32_t uHeight,
+        uint32_t uDepth,
+        uint16_t uBlockType
+    )
+    {
+        assert(uWidth <= static_cast<uint32_t>(SHRT_MAX) && uDepth <= static_cast<uint32_t>(SHRT_MAX) && uHeight <= static_cast<uint32_t>(SHRT_MAX) / 2u);
+
+        return VoxelInstanceData
+        {
+            .X = static_cast<int16_t>(2 * static_cast<int32_t>(uWidthIdx) - static_cast<int32_t>(uWidth)),
+            .Y = static_cast<int16_t>(2 * (static_cast<int32_t>(uHeightIdx) - static_cast<int32_t>(uHeight))),
+            .Z = static_cast<int16_t>(2 * static_cast<int32_t>(uDepthIdx) - static_cast<int32_t>(uDepth)),
+            .BlockType = uBlockType
+        };
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelInstanceEncoder::GetMapOffsetY
+
+      Summary:  Returns the height the voxel map is translated by
+
+      Args:     uint32_t uHeight
+                  Maximum number of blocks in a column
+
+      Returns:  float
+                  Translation of the voxel along the y-axis
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    float VoxelInstanceEncoder::GetMapOffsetY(uint32_t uHeight)
+    {
+        return static_cast<float>(uHeight) * 0.75f;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelInstanceEncoder::Decode
+
+      Summary:  Returns the world translation of an instance the way
+                VSVoxel computes it, the integer offset followed by the
+                translation of the voxel map
+
+      Args:     const VoxelInstanceData& instance
+                  Instance of a block
+                float fMapOffsetY
+                  Translation of the voxel along the y-axis
+                float* pTranslation
+                  Receives the x, y and z translation
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelInstanceEncoder::Decode(const VoxelInstanceData& instance, float fMapOffsetY, float* pTranslation)
+    {
+        pTranslation[0] = static_cast<float>(instance.X);
+        pTranslation[1] = static_cast<float>(instance.Y) + fMapOffsetY;
+        pTranslation[2] = static_cast<float>(instance.Z);
+    }
+}
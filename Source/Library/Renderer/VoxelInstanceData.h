@@ -0,0 +1,68 @@
+/*+===================================================================
+  File:      VOXELINSTANCEDATA.H
+
+  Summary:   VoxelInstanceData header file contains declarations of
+             the compact voxel instance and of the VoxelInstanceEncoder
+             class used for the lab samples of Game Graphics
+             Programming course. Only depends on the standard library.
+
+  Classes: VoxelInstanceEncoder
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <cstdint>
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+     Struct:   VoxelInstanceData
+     Summary:  Compact instance data of a voxel. The position is an
+               integer offset from the origin of the voxel map, and
+               the block type is the eBlockType value of the voxel
+   S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelInstanceData
+    {
+        int16_t X;
+        int16_t Y;
+        int16_t Z;
+        uint16_t BlockType;
+    };
+    static_assert(sizeof(VoxelInstanceData) == 8u, "VoxelInstanceData must match the R16G16B16A16_SINT instance element");
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    VoxelInstanceEncoder
+
+      Summary:  Places the cells of a voxel map. Cubes are two units
+                wide, so the offset of a cell is 2 * idx - size, which
+                is always an integer. The fractional height offset of
+                the map goes into the world matrix of the voxel
+
+      Methods:  Encode
+                  Returns the instance of a block of the map
+                GetMapOffsetY
+                  Returns the height the voxel map is translated by
+                Decode
+                  Returns the world translation of an instance, as
+                  VSVoxel computes it
+                VoxelInstanceEncoder
+                  Constructor.
+                ~VoxelInstanceEncoder
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class VoxelInstanceEncoder final
+    {
+    public:
+        VoxelInstanceEncoder() = delete;
+        VoxelInstanceEncoder(const VoxelInstanceEncoder& other) = delete;
+        VoxelInstanceEncoder(VoxelInstanceEncoder&& other) = delete;
+        VoxelInstanceEncoder& operator=(const VoxelInstanceEncoder& other) = delete;
+        VoxelInstanceEncoder& operator=(VoxelInstanceEncoder&& other) = delete;
+        ~VoxelInstanceEncoder() = delete;
+
+        static VoxelInstanceData Encode(uint32_t uWidthIdx, uint32_t uHeightIdx, uint32_t uDepthIdx, uint32_t uWidth, uint32_t uHeight, uint32_t uDepth, uint16_t uBlockType);
+        static float GetMapOffsetY(uint32_t uHeight);
+        static void Decode(const VoxelInstanceData& instance, float fMapOffsetY, float* pTranslation);
+    };
+}
@@ -0,0 +1,162 @@
+#include "Renderer/WorkerPool.h"
+
+#include <cassert>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   WorkerPool::WorkerPool
+
+      Summary:  Constructor, starts the workers
+
+      Args:     uint32_t uNumWorkers
+                  Number of threads besides the calling thread
+
+      Modifies: [m_mutex, m_wake, m_done, m_aWorkers, m_pfnTask,
+                 m_uNumTasks, m_uNextTask, m_uNumBusy, m_uLoop,
+                 m_bStopping].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    WorkerPool::WorkerPool(uint32_t uNumWorkers)
+        : m_mutex()
+        , m_wake()
+        , m_done()
+        , m_aWorkers()
+        , m_pfnTask(nullptr)
+        , m_uNumTasks(0u)
+        , m_uNextTask(0u)
+        , m_uNumBusy(0u)
+        , m_uLoop(0u)
+        , m_bStopping(false)
+    {
+        m_aWorkers.reserve(uNumWorkers);
+        for (uint32_t i = 0u; i < uNumWorkers; ++i)
+        {
+            m_aWorkers.emplace_back(&WorkerPool::work, this);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   WorkerPool::~WorkerPool
+
+      Summary:  Destructor, stops the workers
+
+      Modifies: [m_aWorkers, m_bStopping].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    WorkerPool::~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_bStopping = true;
+        }
+
+        m_wake.notify_all();
+
+        for (std::thread& worker : m_aWorkers)
+        {
+            worker.join();
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   WorkerPool::GetNumThreads
+
+      Summary:  Returns the number of threads a loop runs on, the
+                workers and the calling thread
+
+      Returns:  uint32_t
+                  Number of threads
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t WorkerPool::GetNumThreads() const
+    {
+        return static_cast<uint32_t>(m_aWorkers.size()) + 1u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   WorkerPool::ParallelFor
+
+      Summary:  Calls fnTask once for every task index, on the workers
+                and the calling thread, and returns when every task is
+                done. Tasks are taken one at a time, so a few long
+                tasks do not hold up the others
+
+      Args:     uint32_t uNumTasks
+                  Number of tasks
+                const std::function<void(uint32_t)>& fnTask
+                  Runs the task of an index
+
+      Modifies: [m_pfnTask, m_uNumTasks, m_uNextTask, m_uLoop].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void WorkerPool::ParallelFor(uint32_t uNumTasks, const std::function<void(uint32_t)>& fnTask)
+    {
+        if (uNumTasks <= 1u || m_aWorkers.empty())
+        {
+            for (uint32_t i = 0u; i < uNumTasks; ++i)
+            {
+                fnTask(i);
+            }
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            assert(!m_pfnTask);
+
+            m_pfnTask = &fnTask;
+            m_uNumTasks = uNumTasks;
+            m_uNextTask.store(0u, std::memory_order_relaxed);
+            ++m_uLoop;
+        }
+
+        m_wake.notify_all();
+
+        for (uint32_t i = m_uNextTask.fetch_add(1u, std::memory_order_relaxed); i < uNumTasks; i = m_uNextTask.fetch_add(1u, std::memory_order_relaxed))
+        {
+            fnTask(i);
+        }
+
+        // Every task is taken, wait for the workers still running one. Workers that wake up later find no loop
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_pfnTask = nullptr;
+        m_done.wait(lock, [this] { return m_uNumBusy == 0u; });
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   WorkerPool::work
+
+      Summary:  Takes the tasks of every loop started until the pool
+                is stopped
+
+      Modifies: [m_uNextTask, m_uNumBusy].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void WorkerPool::work()
+    {
+        uint64_t uLastLoop = 0u;
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;)
+        {
+            m_wake.wait(lock, [this, uLastLoop] { return m_bStopping || (m_pfnTask && m_uLoop != uLastLoop); });
+            if (m_bStopping)
+            {
+                return;
+            }
+
+            uLastLoop = m_uLoop;
+            const std::function<void(uint32_t)>& fnTask = *m_pfnTask;
+            const uint32_t uNumTasks = m_uNumTasks;
+            ++m_uNumBusy;
+            lock.unlock();
+
+            for (uint32_t i = m_uNextTask.fetch_add(1u, std::memory_order_relaxed); i < uNumTasks; i = m_uNextTask.fetch_add(1u, std::memory_order_relaxed))
+            {
+                fnTask(i);
+            }
+
+            lock.lock();
+            if (--m_uNumBusy == 0u)
+            {
+                m_done.notify_one();
+            }
+        }
+    }
+}
@@ -0,0 +1,74 @@
+/*+===================================================================
+  File:      WORKERPOOL.H
+
+  Summary:   WorkerPool header file contains declarations of
+             WorkerPool class used for the lab samples of Game
+             Graphics Programming course. Only depends on the
+             standard library.
+
+  Classes: WorkerPool
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    WorkerPool
+
+      Summary:  Threads started once and reused by every parallel loop
+                of a frame, instead of spawning threads per loop. The
+                calling thread takes tasks too, so a pool without
+                workers runs the loop inline. One loop runs at a time,
+                started from one thread
+
+      Methods:  GetNumThreads
+                  Returns the number of threads a loop runs on
+                ParallelFor
+                  Runs tasks on the workers and the calling thread
+                work
+                  Takes the tasks of every loop until stopped
+                WorkerPool
+                  Constructor.
+                ~WorkerPool
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class WorkerPool final
+    {
+    public:
+        WorkerPool() = delete;
+        explicit WorkerPool(uint32_t uNumWorkers);
+        WorkerPool(const WorkerPool& other) = delete;
+        WorkerPool(WorkerPool&& other) = delete;
+        WorkerPool& operator=(const WorkerPool& other) = delete;
+        WorkerPool& operator=(WorkerPool&& other) = delete;
+        ~WorkerPool();
+
+        uint32_t GetNumThreads() const;
+        void ParallelFor(uint32_t uNumTasks, const std::function<void(uint32_t)>& fnTask);
+
+    private:
+        void work();
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_done;
+        std::vector<std::thread> m_aWorkers;
+        const std::function<void(uint32_t)>* m_pfnTask;
+        uint32_t m_uNumTasks;
+        std::atomic<uint32_t> m_uNextTask;
+        uint32_t m_uNumBusy;
+        uint64_t m_uLoop;
+        bool m_bStopping;
+    };
+}
@@ -1,5 +1,7 @@
 #include "Scene/Scene.h"
 
+#include <chrono>
+
 #include "Shader/SkyMapVertexShader.h"
 
 namespace library
@@ -26,9 +28,14 @@ namespace library
 
     Scene::Scene(const std::filesystem::path& filePath)
         : m_filePath(filePath)
-        , m_voxels()
+        , m_objects()
         , m_renderables()
-        , m_aPointLights{ nullptr }
+        , m_models()
+        , m_aPointLights()
+        , m_aPointLightParents()
+        , m_aPointLightPositions()
+        , m_directionalLightDirection(0.0f, -1.0f, 0.0f, 0.0f)
+        , m_directionalLightColor(0.0f, 0.0f, 0.0f, 0.0f)
         , m_vertexShaders()
         , m_pixelShaders()
         , m_skyBox()
@@ -60,6 +67,8 @@ namespace library
 
         UINT uColorIdx = 0u;
         XMFLOAT4 color;
+        std::vector<XMFLOAT4> aColors;
+        aColors.reserve(aDimension[3]);
         while (!inputFile.eof() && uColorIdx < aDimension[3])
         {
             inputFile >> color.x >> color.y >> color.z;
@@ -76,23 +85,16 @@ namespace library
             else
             {
                 color.w = 1.0f;
-                m_voxels.push_back(std::make_shared<Voxel>(color));
+                aColors.push_back(color);
                 ++uColorIdx;
             }
         }
 
-        std::vector<std::vector<InstanceData>> aInstanceData;
-        aInstanceData.reserve(m_voxels.size());
-        for (UINT renderableIdx = 0u; renderableIdx < m_voxels.size(); ++renderableIdx)
-        {
-            aInstanceData.push_back(std::vector<InstanceData>());
-            aInstanceData.back().reserve(
-                static_cast<size_t>(aDimension[0]) * static_cast<size_t>(aDimension[1]) * static_cast<size_t>(aDimension[2])
-            );
-        }
+        std::vector<eBlockType> aBlockTypes;
+        std::vector<FLOAT> aHeights;
+        aBlockTypes.reserve(static_cast<size_t>(aDimension[0]) * static_cast<size_t>(aDimension[2]));
+        aHeights.reserve(static_cast<size_t>(aDimension[0]) * static_cast<size_t>(aDimension[2]));
 
-        UINT uDepthIdx = 0u;
-        UINT uWidthIdx = 0u;
         CHAR voxelType;
         FLOAT height;
         while (!inputFile.eof())
@@ -110,80 +112,77 @@ namespace library
             }
             else if (static_cast<CHAR>(eBlockType::GRASSLAND) <= voxelType && voxelType < static_cast<CHAR>(eBlockType::COUNT))
             {
-                for (UINT heightIdx = 0; heightIdx < static_cast<UINT>(static_cast<float>(aDimension[1]) * height); ++heightIdx)
-                {
-                    aInstanceData[static_cast<size_t>(voxelType) - static_cast<size_t>(eBlockType::GRASSLAND)].push_back(
-                        InstanceData
-                        {
-                            .Transformation = XMMatrixTranslation(
-                                2.0f * (static_cast<FLOAT>(uWidthIdx) - static_cast<FLOAT>(aDimension[0]) / 2.0f),
-                                2.0f * (static_cast<FLOAT>(heightIdx) - static_cast<FLOAT>(aDimension[1])) + (static_cast<FLOAT>(aDimension[1]) * 0.75f),
-                                2.0f * (static_cast<FLOAT>(uDepthIdx) - static_cast<FLOAT>(aDimension[2]) / 2.0f)
-                                )
-                        }
-                    );
-                }
-                ++uWidthIdx;
-                if (uWidthIdx >= aDimension[0])
-                {
-                    uWidthIdx -= aDimension[0];
-                    ++uDepthIdx;
-
-                    if (uDepthIdx >= aDimension[2])
-                    {
-                        uDepthIdx -= aDimension[2];
-                    }
-                }
+                aBlockTypes.push_back(static_cast<eBlockType>(voxelType));
+                aHeights.push_back(height);
             }
         }
 
         inputFile.close();
 
-        UINT uVoxelIdx = 0u;
-        auto it = m_voxels.begin();
-        while (it != m_voxels.end())
-        {
-            if (aInstanceData[uVoxelIdx].size() <= 0)
-            {
-                it = m_voxels.erase(it);
-            }
-            else
-            {
-                (*it)->SetInstanceData(std::move(aInstanceData[uVoxelIdx]));
-                ++it;
-            }
-            ++uVoxelIdx;
-        }
+        initializeVoxels(aDimension[0], aDimension[1], aDimension[2], aColors, aBlockTypes, aHeights);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::Scene
+
+      Summary:  Constructor that builds the voxels straight from a
+                generated terrain, without a height map file
+
+      Args:     const TerrainGenerator& terrain
+                  Terrain that has already been generated
+
+      Modifies: [m_filePath, m_objects, m_renderables, m_models,
+                 m_aPointLights, m_aPointLightParents,
+                 m_aPointLightPositions, m_directionalLightDirection,
+                 m_directionalLightColor, m_vertexShaders, m_pixelShaders,
+                 m_skyBox].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    Scene::Scene(const TerrainGenerator& terrain)
+        : m_filePath()
+        , m_objects()
+        , m_renderables()
+        , m_models()
+        , m_aPointLights()
+        , m_aPointLightParents()
+        , m_aPointLightPositions()
+        , m_directionalLightDirection(0.0f, -1.0f, 0.0f, 0.0f)
+        , m_directionalLightColor(0.0f, 0.0f, 0.0f, 0.0f)
+        , m_vertexShaders()
+        , m_pixelShaders()
+        , m_skyBox()
+    {
+        initializeVoxels(terrain.GetWidth(), terrain.GetHeight(), terrain.GetDepth(), terrain.GetColors(), terrain.GetBlockTypes(), terrain.GetHeights());
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::Initialize
 
       Summary:  Initializes the voxels, shaders, renderables, models,
-                and skybox
+                and skybox. The shader variants are compiled in
+                parallel first
 
       Args:     ID3D11Device* pDevice
                   The Direct3D device to create the buffers
                 ID3D11DeviceContext* pImmediateContext
                   The Direct3D context to set buffers
+                WorkerPool& workerPool
+                  Threads to compile the shader variants on
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     /*--------------------------------------------------------------------
       TODO: Scene::Initialize definition (remove the comment)
     --------------------------------------------------------------------*/
-    HRESULT Scene::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
+    HRESULT Scene::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext, _In_ WorkerPool& workerPool)
     {
-        for (auto voxel : m_voxels)
+        HRESULT hr = compileShaders(workerPool);
+        if (FAILED(hr))
         {
-            HRESULT hr = voxel->Initialize(pDevice, pImmediateContext);
-            if (FAILED(hr))
-            {
-                return hr;
-            }
+            return hr;
         }
 
+        // The device objects are created on this thread from the compiled bytecode
         for (auto it = m_vertexShaders.begin(); it != m_vertexShaders.end(); ++it)
         {
-            HRESULT hr = it->second->Initialize(pDevice);
+            hr = it->second->Initialize(pDevice);
             if (FAILED(hr))
             {
                 return hr;
@@ -192,25 +191,17 @@ namespace library
 
         for (auto it = m_pixelShaders.begin(); it != m_pixelShaders.end(); ++it)
         {
-            HRESULT hr = it->second->Initialize(pDevice);
-            if (FAILED(hr))
-            {
-                return hr;
-            }
-        }
-
-        for (auto it = m_renderables.begin(); it != m_renderables.end(); ++it)
-        {
-            HRESULT hr = it->second->Initialize(pDevice, pImmediateContext);
+            hr = it->second->Initialize(pDevice);
             if (FAILED(hr))
             {
                 return hr;
             }
         }
 
-        for (auto it = m_models.begin(); it != m_models.end(); ++it)
+        Renderable* const* apRenderables = m_objects.GetRenderables();
+        for (UINT i = 0u; i < m_objects.GetNumObjects(); ++i)
         {
-            HRESULT hr = it->second->Initialize(pDevice, pImmediateContext);
+            hr = apRenderables[i]->Initialize(pDevice, pImmediateContext);
             if (FAILED(hr))
             {
                 return hr;
@@ -219,7 +210,7 @@ namespace library
         
         if (m_skyBox)
         {
-            HRESULT hr = m_skyBox->Initialize(pDevice, pImmediateContext);
+            hr = m_skyBox->Initialize(pDevice, pImmediateContext);
             if (FAILED(hr))
             {
                 MessageBox(nullptr, L"sky box scene init error", L"Error", MB_OK);
@@ -230,22 +221,150 @@ namespace library
         return S_OK;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::compileShaders
+
+      Summary:  Compiles every variant of every vertex and pixel
+                shader on the worker pool, a variant per task. The
+                time taken is logged next to the sum of the variant
+                times, which is what compiling them serially takes.
+                The messages of every variant are sent to the
+                debugger, and the errors of every variant that failed
+                are reported together
+
+      Args:     WorkerPool& workerPool
+                  Threads to compile the variants on
+
+      Returns:  HRESULT
+                  Status code of the first variant that failed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::compileShaders(_In_ WorkerPool& workerPool)
+    {
+        struct CompileJob
+        {
+            Shader* pShader;
+            UINT uVariant;
+        };
+
+        // A shader added under several names is compiled once, by one thread per variant
+        std::unordered_set<Shader*> uniqueShaders;
+        std::vector<CompileJob> aJobs;
+        auto addJobs = [&uniqueShaders, &aJobs](Shader* pShader)
+        {
+            if (!uniqueShaders.insert(pShader).second)
+            {
+                return;
+            }
+
+            for (UINT uVariant = 0u; uVariant < Shader::NUM_VARIANTS; ++uVariant)
+            {
+                if (pShader->HasVariant(uVariant))
+                {
+                    aJobs.push_back(CompileJob{ .pShader = pShader, .uVariant = uVariant });
+                }
+            }
+        };
+
+        for (auto it = m_vertexShaders.begin(); it != m_vertexShaders.end(); ++it)
+        {
+            addJobs(it->second.get());
+        }
+        for (auto it = m_pixelShaders.begin(); it != m_pixelShaders.end(); ++it)
+        {
+            addJobs(it->second.get());
+        }
+
+        const UINT uNumJobs = static_cast<UINT>(aJobs.size());
+        if (uNumJobs == 0u)
+        {
+            return S_OK;
+        }
+
+        std::vector<HRESULT> aResults(uNumJobs, S_OK);
+        std::vector<FLOAT> aCompileTimes(uNumJobs, 0.0f);
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        workerPool.ParallelFor(uNumJobs, [&aJobs, &aResults, &aCompileTimes](uint32_t uJobIdx)
+        {
+            const std::chrono::steady_clock::time_point jobStart = std::chrono::steady_clock::now();
+            aResults[uJobIdx] = aJobs[uJobIdx].pShader->Compile(aJobs[uJobIdx].uVariant);
+            aCompileTimes[uJobIdx] = std::chrono::duration<FLOAT, std::milli>(std::chrono::steady_clock::now() - jobStart).count();
+        });
+
+        // The sum of the variant times is what compiling them one after another takes
+        const FLOAT elapsedTime = std::chrono::duration<FLOAT, std::milli>(std::chrono::steady_clock::now() - start).count();
+        FLOAT serialTime = 0.0f;
+        for (FLOAT compileTime : aCompileTimes)
+        {
+            serialTime += compileTime;
+        }
+
+        CHAR szMessage[160];
+        sprintf_s(szMessage, "Compiled %u shader variants on %u threads in %.1f ms, %.1f ms of compiling (%.1fx)\n",
+                  uNumJobs, workerPool.GetNumThreads(), elapsedTime, serialTime, serialTime / (std::max)(elapsedTime, 1e-3f));
+        OutputDebugStringA(szMessage);
+
+        HRESULT hrFirstFailure = S_OK;
+        std::wstring report;
+        for (UINT i = 0u; i < uNumJobs; ++i)
+        {
+            const Shader& shader = *aJobs[i].pShader;
+            const std::string& errors = shader.GetCompileErrors(aJobs[i].uVariant);
+            if (!errors.empty())
+            {
+                OutputDebugStringA(errors.c_str());
+            }
+
+            if (SUCCEEDED(aResults[i]))
+            {
+                continue;
+            }
+
+            if (SUCCEEDED(hrFirstFailure))
+            {
+                hrFirstFailure = aResults[i];
+            }
+
+            const std::string entryPoint(shader.GetEntryPoint());
+            report += shader.GetFileName();
+            report += L" (";
+            report.append(entryPoint.begin(), entryPoint.end());
+            report += L", variant ";
+            report += std::to_wstring(aJobs[i].uVariant);
+            report += L")\n";
+            if (errors.empty())
+            {
+                report += L"The file cannot be compiled. Please run this executable from the directory that contains it.\n";
+            }
+            report.append(errors.begin(), errors.end());
+            report += L"\n";
+        }
+
+        if (FAILED(hrFirstFailure))
+        {
+            MessageBox(nullptr, report.c_str(), L"Shader compile Error", MB_OK);
+        }
+
+        return hrFirstFailure;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::AddVoxel
 
-      Summary:  Add a voxel object
+      Summary:  Add a voxel object. Voxels are static, so their
+                shadows are cached
 
       Args:     const std::shared_ptr<Voxel>& voxel
                   Shared pointer to the voxel object
 
-      Modifies: [m_renderables].
+      Modifies: [m_objects].
 
       Returns:  HRESULT
                   Status code.
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT Scene::AddVoxel(_In_ const std::shared_ptr<Voxel>& voxel)
     {
-        m_voxels.push_back(voxel);
+        m_objects.Add(voxel, SceneObjectTable::FLAG_VISIBLE | SceneObjectTable::FLAG_VOXEL | SceneObjectTable::FLAG_STATIC);
 
         return S_OK;
     }
@@ -260,7 +379,7 @@ namespace library
                 const std::shared_ptr<Renderable>& renderable
                   Shared pointer to the renderable object
 
-      Modifies: [m_renderables].
+      Modifies: [m_objects, m_renderables].
 
       Returns:  HRESULT
                   Status code.
@@ -272,7 +391,7 @@ namespace library
             return E_FAIL;
         }
 
-        m_renderables[pszRenderableName] = renderable;
+        m_renderables[pszRenderableName] = m_objects.Add(renderable, SceneObjectTable::FLAG_VISIBLE);
 
         return S_OK;
     }
@@ -287,7 +406,7 @@ namespace library
                 const std::shared_ptr<Model>& model
                   Shared pointer to the model object
 
-      Modifies: [m_models].
+      Modifies: [m_objects, m_models].
 
       Returns:  HRESULT
                   Status code.
@@ -299,7 +418,7 @@ namespace library
             return E_FAIL;
         }
 
-        m_models[pszModelName] = pModel;
+        m_models[pszModelName] = m_objects.Add(pModel, SceneObjectTable::FLAG_VISIBLE | SceneObjectTable::FLAG_MODEL);
 
         return S_OK;
     }
@@ -307,14 +426,16 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::AddPointLight
 
-      Summary:  Add a point light object
+      Summary:  Add a point light object. The light arrays grow to
+                the index, up to MAX_NUM_LIGHTS
 
       Args:     size_t index
                   Index of the point light
                 const std::shared_ptr<PointLight>& pointLight
                   Shared pointer to the point light object
 
-      Modifies: [m_aPointLights].
+      Modifies: [m_aPointLights, m_aPointLightParents,
+                 m_aPointLightPositions].
 
       Returns:  HRESULT
                   Status code.
@@ -323,12 +444,21 @@ namespace library
     {
         HRESULT hr = S_OK;
 
-        if (index >= NUM_LIGHTS)
+        if (index >= MAX_NUM_LIGHTS || !pPointLight)
         {
             return E_FAIL;
         }
 
+        if (index >= m_aPointLights.size())
+        {
+            m_aPointLights.resize(index + 1u);
+            m_aPointLightParents.resize(index + 1u, SceneHandle{});
+            m_aPointLightPositions.resize(index + 1u, XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f));
+        }
+
         m_aPointLights[index] = pPointLight;
+        m_aPointLightParents[index] = SceneHandle{};
+        m_aPointLightPositions[index] = pPointLight->GetPosition();
 
         return hr;
     }
@@ -417,76 +547,218 @@ namespace library
         }
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::SetParent
+
+      Summary:  Parents an object to another, so that it follows the
+                parent's transform
+
+      Args:     SceneHandle handle
+                  Handle of the object
+                SceneHandle parent
+                  Handle of the parent, an invalid handle to detach
+                  the object
+
+      Modifies: [m_objects].
+
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG if the object is stale or
+                  the parent is one of its descendants
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::SetParent(_In_ SceneHandle handle, _In_ SceneHandle parent)
+    {
+        return m_objects.SetParent(handle, parent) ? S_OK : E_INVALIDARG;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::SetStatic
+
+      Summary:  Marks an object as static or dynamic. The shadows of
+                static objects are cached and only drawn again when
+                they move or change, which is costly if it happens
+                often
+
+      Args:     SceneHandle handle
+                  Handle of the object
+                BOOL bStatic
+                  TRUE if the object rarely moves
+
+      Modifies: [m_objects].
+
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG if the object is stale
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::SetStatic(_In_ SceneHandle handle, _In_ BOOL bStatic)
+    {
+        const UINT uDenseIndex = m_objects.GetDenseIndex(handle);
+        if (uDenseIndex == SceneObjectTable::INVALID_INDEX)
+        {
+            return E_INVALIDARG;
+        }
+
+        const UINT uFlags = m_objects.GetFlags()[uDenseIndex];
+        m_objects.SetFlags(handle, bStatic ? uFlags | SceneObjectTable::FLAG_STATIC : uFlags & ~SceneObjectTable::FLAG_STATIC);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::AttachPointLight
+
+      Summary:  Attaches a point light to an object. The position of
+                the light becomes relative to the object
+
+      Args:     size_t index
+                  Index of the point light
+                SceneHandle parent
+                  Handle of the object, an invalid handle to detach
+                  the light
+
+      Modifies: [m_aPointLightParents].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::AttachPointLight(_In_ size_t index, _In_ SceneHandle parent)
+    {
+        if (index >= m_aPointLights.size() || !m_aPointLights[index])
+        {
+            return E_INVALIDARG;
+        }
+
+        m_aPointLightParents[index] = parent;
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::SetDirectionalLight
+
+      Summary:  Sets the directional light of the scene, which casts
+                the cascaded shadows. A black color turns it off
+
+      Args:     const XMFLOAT4& direction
+                  Direction the light travels in
+                const XMFLOAT4& color
+                  Color of the light
+
+      Modifies: [m_directionalLightDirection, m_directionalLightColor].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Scene::SetDirectionalLight(_In_ const XMFLOAT4& direction, _In_ const XMFLOAT4& color)
+    {
+        XMStoreFloat4(&m_directionalLightDirection, XMVector3Normalize(XMVectorSetW(XMLoadFloat4(&direction), 0.0f)));
+        m_directionalLightColor = color;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::Update
 
       Summary:  Update the renderables, models, point lights, skybox
-                each frame
+                each frame. The world matrices and the positions of
+                the attached lights are updated in the same pass
 
       Args:     FLOAT deltaTime
                   Time difference of a frame
+                WorkerPool& workerPool
+                  Threads to update the world matrices on
+
+      Modifies: [m_objects, m_aPointLightPositions].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     /*--------------------------------------------------------------------
       TODO: Scene::Update definition (remove the comment)
     --------------------------------------------------------------------*/
-    void Scene::Update(_In_ FLOAT deltaTime)
+    void Scene::Update(_In_ FLOAT deltaTime, _In_ WorkerPool& workerPool)
     {
-        for (auto it = m_renderables.begin(); it != m_renderables.end(); ++it)
-        {
-            it->second->Update(deltaTime);
-        }
+        m_objects.Update(deltaTime, workerPool);
 
-        for (auto it = m_models.begin(); it != m_models.end(); ++it)
+        for (size_t lightIdx = 0; lightIdx < m_aPointLights.size(); ++lightIdx)
         {
-            it->second->Update(deltaTime);
-        }
+            if (!m_aPointLights[lightIdx])
+            {
+                continue;
+            }
 
-        for (UINT lightIdx = 0; lightIdx < NUM_LIGHTS; ++lightIdx)
-        {
             m_aPointLights[lightIdx]->Update(deltaTime);
+
+            const UINT uParent = m_objects.GetDenseIndex(m_aPointLightParents[lightIdx]);
+            if (uParent == SceneObjectTable::INVALID_INDEX)
+            {
+                m_aPointLightPositions[lightIdx] = m_aPointLights[lightIdx]->GetPosition();
+                continue;
+            }
+
+            const XMFLOAT4& localPosition = m_aPointLights[lightIdx]->GetPosition();
+            XMVECTOR position = XMVector3Transform(XMVectorSet(localPosition.x, localPosition.y, localPosition.z, 1.0f), XMLoadFloat4x4(&m_objects.GetWorldMatrices()[uParent]));
+            XMStoreFloat4(&m_aPointLightPositions[lightIdx], position);
         }
 
         m_skyBox->Update(deltaTime);
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Scene::GetVoxels
+      Method:   Scene::GetObjects
 
-      Summary:  Returns the vector of voxels
+      Summary:  Returns the table of the voxels, renderables and
+                models, iterated every frame
 
-      Returns:  std::vector<std::shared_ptr<Voxel>>&
-                  Voxels
+      Returns:  const SceneObjectTable&
+                  Scene objects
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    std::vector<std::shared_ptr<Voxel>>& Scene::GetVoxels()
+    const SceneObjectTable& Scene::GetObjects() const
     {
-        return m_voxels;
+        return m_objects;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::FindRenderable
+
+      Summary:  Looks up a renderable by name. Meant for loading, the
+                handle should be kept instead of looking it up again
+
+      Args:     PCWSTR pszRenderableName
+                  Key of the renderable
+
+      Returns:  SceneHandle
+                  Handle of the renderable, invalid if not found
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    SceneHandle Scene::FindRenderable(_In_ PCWSTR pszRenderableName) const
+    {
+        auto it = m_renderables.find(pszRenderableName);
+
+        return it != m_renderables.end() ? it->second : SceneHandle{};
+    }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Scene::GetRenderables
+      Method:   Scene::FindModel
+
+      Summary:  Looks up a model by name. Meant for loading, the handle
+                should be kept instead of looking it up again
 
-      Summary:  Returns the vector of renderables
+      Args:     PCWSTR pszModelName
+                  Key of the model
 
-      Returns:  std::unordered_map<std::wstring, std::shared_ptr<Renderable>>&
-                  Renderables
+      Returns:  SceneHandle
+                  Handle of the model, invalid if not found
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    std::unordered_map<std::wstring, std::shared_ptr<Renderable>>& Scene::GetRenderables()
+    SceneHandle Scene::FindModel(_In_ PCWSTR pszModelName) const
     {
-        return m_renderables;
+        auto it = m_models.find(pszModelName);
+
+        return it != m_models.end() ? it->second : SceneHandle{};
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Scene::GetModels
+      Method:   Scene::GetNumPointLights
 
-      Summary:  Returns the vector of models
+      Summary:  Returns the size of the point light array. Indices
+                that were skipped when adding hold no light
 
-      Returns:  std::unordered_map<std::wstring, std::shared_ptr<Model>>&
-                  Models
+      Returns:  size_t
+                  Number of point light slots
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    std::unordered_map<std::wstring, std::shared_ptr<Model>>& Scene::GetModels()
+    size_t Scene::GetNumPointLights() const
     {
-        return m_models;
+        return m_aPointLights.size();
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -502,11 +774,56 @@ namespace library
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     std::shared_ptr<PointLight>& Scene::GetPointLight(_In_ size_t index)
     {
-        assert(index < NUM_LIGHTS);
+        assert(index < m_aPointLights.size());
 
         return m_aPointLights[index];
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetPointLightPosition
+
+      Summary:  Returns the world position of a point light, following
+                the object it is attached to
+
+      Args:     size_t index
+                  Index of the point light
+
+      Returns:  const XMFLOAT4&
+                  World position of the light
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const XMFLOAT4& Scene::GetPointLightPosition(_In_ size_t index) const
+    {
+        assert(index < m_aPointLights.size());
+
+        return m_aPointLightPositions[index];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetDirectionalLightDirection
+
+      Summary:  Returns the direction of the directional light
+
+      Returns:  const XMFLOAT4&
+                  Normalized direction the light travels in
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const XMFLOAT4& Scene::GetDirectionalLightDirection() const
+    {
+        return m_directionalLightDirection;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetDirectionalLightColor
+
+      Summary:  Returns the color of the directional light
+
+      Returns:  const XMFLOAT4&
+                  Color of the light, black when there is none
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const XMFLOAT4& Scene::GetDirectionalLightColor() const
+    {
+        return m_directionalLightColor;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::GetVertexShaders
 
@@ -585,19 +902,20 @@ namespace library
                 PCWSTR pszVertexShaderName
                   Key of the vertex shader
 
-      Modifies: [m_renderables].
+      Modifies: [m_objects].
 
       Returns:  HRESULT
                   Status code
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT Scene::SetVertexShaderOfRenderable(_In_ PCWSTR pszRenderableName, _In_ PCWSTR pszVertexShaderName)
     {
-        if (!m_renderables.contains(pszRenderableName) || !m_vertexShaders.contains(pszVertexShaderName))
+        Renderable* pRenderable = findObject(m_renderables, pszRenderableName);
+        if (!pRenderable || !m_vertexShaders.contains(pszVertexShaderName))
         {
             return E_FAIL;
         }
 
-        m_renderables[pszRenderableName]->SetVertexShader(m_vertexShaders[pszVertexShaderName]);
+        pRenderable->SetVertexShader(m_vertexShaders[pszVertexShaderName]);
 
         return S_OK;
     }
@@ -612,19 +930,20 @@ namespace library
                 PCWSTR pszPixelShaderName
                   Key of the pixel shader
 
-      Modifies: [m_renderables].
+      Modifies: [m_objects].
 
       Returns:  HRESULT
                   Status code
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT Scene::SetPixelShaderOfRenderable(_In_ PCWSTR pszRenderableName, _In_ PCWSTR pszPixelShaderName)
     {
-        if (!m_renderables.contains(pszRenderableName) || !m_pixelShaders.contains(pszPixelShaderName))
+        Renderable* pRenderable = findObject(m_renderables, pszRenderableName);
+        if (!pRenderable || !m_pixelShaders.contains(pszPixelShaderName))
         {
             return E_FAIL;
         }
 
-        m_renderables[pszRenderableName]->SetPixelShader(m_pixelShaders[pszPixelShaderName]);
+        pRenderable->SetPixelShader(m_pixelShaders[pszPixelShaderName]);
 
         return S_OK;
     }
@@ -639,19 +958,20 @@ namespace library
                 PCWSTR pszVertexShaderName
                   Key of the vertex shader
 
-      Modifies: [m_models].
+      Modifies: [m_objects].
 
       Returns:  HRESULT
                   Status code
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT Scene::SetVertexShaderOfModel(_In_ PCWSTR pszModelName, _In_ PCWSTR pszVertexShaderName)
     {
-        if (!m_models.contains(pszModelName) || !m_vertexShaders.contains(pszVertexShaderName))
+        Renderable* pModel = findObject(m_models, pszModelName);
+        if (!pModel || !m_vertexShaders.contains(pszVertexShaderName))
         {
             return E_FAIL;
         }
 
-        m_models[pszModelName]->SetVertexShader(m_vertexShaders[pszVertexShaderName]);
+        pModel->SetVertexShader(m_vertexShaders[pszVertexShaderName]);
 
         return S_OK;
     }
@@ -666,19 +986,20 @@ namespace library
                 PCWSTR pszPixelShaderName
                   Key of the pixel shader
 
-      Modifies: [m_models].
+      Modifies: [m_objects].
 
       Returns:  HRESULT
                   Status code
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT Scene::SetPixelShaderOfModel(_In_ PCWSTR pszModelName, _In_ PCWSTR pszPixelShaderName)
     {
-        if (!m_models.contains(pszModelName) || !m_pixelShaders.contains(pszPixelShaderName))
+        Renderable* pModel = findObject(m_models, pszModelName);
+        if (!pModel || !m_pixelShaders.contains(pszPixelShaderName))
         {
             return E_FAIL;
         }
 
-        m_models[pszModelName]->SetPixelShader(m_pixelShaders[pszPixelShaderName]);
+        pModel->SetPixelShader(m_pixelShaders[pszPixelShaderName]);
 
         return S_OK;
     }
@@ -693,7 +1014,7 @@ namespace library
                 PCWSTR pszVertexShaderName
                   Key of the vertex shader
 
-      Modifies: [m_scenes].
+      Modifies: [m_objects].
 
       Returns:  HRESULT
                   Status code
@@ -705,9 +1026,14 @@ namespace library
             return E_FAIL;
         }
 
-        for (std::shared_ptr<Voxel>& voxel : m_voxels)
+        Renderable* const* apRenderables = m_objects.GetRenderables();
+        const UINT* auFlags = m_objects.GetFlags();
+        for (UINT i = 0u; i < m_objects.GetNumObjects(); ++i)
         {
-            voxel->SetVertexShader(m_vertexShaders[pszVertexShaderName]);
+            if (auFlags[i] & SceneObjectTable::FLAG_VOXEL)
+            {
+                apRenderables[i]->SetVertexShader(m_vertexShaders[pszVertexShaderName]);
+            }
         }
 
         return S_OK;
@@ -723,7 +1049,7 @@ namespace library
                 PCWSTR pszPixelShaderName
                   Key of the pixel shader
 
-      Modifies: [m_renderables].
+      Modifies: [m_objects].
 
       Returns:  HRESULT
                   Status code
@@ -735,14 +1061,117 @@ namespace library
             return E_FAIL;
         }
 
-        for (std::shared_ptr<Voxel>& voxel : m_voxels)
+        Renderable* const* apRenderables = m_objects.GetRenderables();
+        const UINT* auFlags = m_objects.GetFlags();
+        for (UINT i = 0u; i < m_objects.GetNumObjects(); ++i)
         {
-            voxel->SetPixelShader(m_pixelShaders[pszPixelShaderName]);
+            if (auFlags[i] & SceneObjectTable::FLAG_VOXEL)
+            {
+                apRenderables[i]->SetPixelShader(m_pixelShaders[pszPixelShaderName]);
+            }
         }
 
         return S_OK;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::initializeVoxels
+
+      Summary:  Creates a single voxel that holds the instances of
+                every block type, filled from the columns of the map
+
+      Args:     UINT uWidth
+                  Number of cells along the x-axis
+                UINT uHeight
+                  Maximum number of blocks in a column
+                UINT uDepth
+                  Number of cells along the z-axis
+                const std::vector<XMFLOAT4>& aColors
+                  Color of each block type, starting from GRASSLAND
+                const std::vector<eBlockType>& aBlockTypes
+                  Block type of each cell, row-major along the x-axis
+                const std::vector<FLOAT>& aHeights
+                  Normalized height of each cell
+
+      Modifies: [m_objects].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Scene::initializeVoxels(
+        _In_ UINT uWidth,
+        _In_ UINT uHeight,
+        _In_ UINT uDepth,
+        _In_ const std::vector<XMFLOAT4>& aColors,
+        _In_ const std::vector<eBlockType>& aBlockTypes,
+        _In_ const std::vector<FLOAT>& aHeights
+    )
+    {
+        assert(aBlockTypes.size() == aHeights.size());
+
+        const size_t uNumCells = static_cast<size_t>(uWidth) * static_cast<size_t>(uDepth);
+        if (uNumCells == 0u)
+        {
+            return;
+        }
+
+        std::vector<VoxelInstanceData> aInstanceData;
+
+        for (size_t uCellIdx = 0u; uCellIdx < aBlockTypes.size(); ++uCellIdx)
+        {
+            const size_t uTypeIdx = static_cast<size_t>(aBlockTypes[uCellIdx]) - static_cast<size_t>(eBlockType::GRASSLAND);
+            if (uTypeIdx >= aColors.size())
+            {
+                continue;
+            }
+
+            const UINT uWidthIdx = static_cast<UINT>(uCellIdx % uWidth);
+            const UINT uDepthIdx = static_cast<UINT>((uCellIdx / uWidth) % uDepth);
+            const UINT uColumnHeight = static_cast<UINT>(static_cast<FLOAT>(uHeight) * aHeights[uCellIdx]);
+
+            for (UINT heightIdx = 0; heightIdx < uColumnHeight; ++heightIdx)
+            {
+                aInstanceData.push_back(
+                    VoxelInstanceEncoder::Encode(uWidthIdx, heightIdx, uDepthIdx, uWidth, uHeight, uDepth, static_cast<USHORT>(aBlockTypes[uCellIdx]))
+                );
+            }
+        }
+
+        if (!aInstanceData.empty())
+        {
+            std::shared_ptr<Voxel> voxel = std::make_shared<Voxel>(std::move(aInstanceData), aColors);
+            voxel->Translate(XMVectorSet(0.0f, VoxelInstanceEncoder::GetMapOffsetY(uHeight), 0.0f, 0.0f));
+            AddVoxel(voxel);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::findObject
+
+      Summary:  Looks up an object by name in one of the name tables
+
+      Args:     const std::unordered_map<std::wstring, SceneHandle>& objectNames
+                  Name table of the renderables or the models
+                PCWSTR pszObjectName
+                  Key of the object
+
+      Returns:  Renderable*
+                  Renderable of the object, nullptr if not found
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    Renderable* Scene::findObject(_In_ const std::unordered_map<std::wstring, SceneHandle>& objectNames, _In_ PCWSTR pszObjectName) const
+    {
+        auto it = objectNames.find(pszObjectName);
+        if (it == objectNames.end())
+        {
+            return nullptr;
+        }
+
+        const UINT uDenseIndex = m_objects.GetDenseIndex(it->second);
+        if (uDenseIndex == SceneObjectTable::INVALID_INDEX)
+        {
+            return nullptr;
+        }
+
+        return m_objects.GetRenderables()[uDenseIndex];
+    }
+
     FLOAT Scene::getNoise2(UINT x, UINT y)
     {
         UINT temp = ms_aHashes[y % 256u];
@@ -19,6 +19,8 @@
 #include "Light/PointLight.h"
 #include "Renderer/Skybox.h"
 #include "Renderer/Renderable.h"
+#include "Scene/SceneObjectTable.h"
+#include "Scene/TerrainGenerator.h"
 #include "Scene/Voxel.h"
 
 namespace library
@@ -29,13 +31,14 @@ namespace library
         static FLOAT GetPerlin2d(FLOAT x, FLOAT y, FLOAT frequency, UINT uDepth);
 
         Scene(const std::filesystem::path& filePath);
+        Scene(const TerrainGenerator& terrain);
         Scene(const Scene& other) = delete;
         Scene(Scene&& other) = delete;
         Scene& operator=(const Scene& other) = delete;
         Scene& operator=(Scene&& other) = delete;
         virtual ~Scene() = default;
 
-        virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext);
+        virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext, _In_ WorkerPool& workerPool);
 
         HRESULT AddVoxel(_In_ const std::shared_ptr<Voxel>& voxel);
         HRESULT AddRenderable(_In_ PCWSTR pszRenderableName, _In_ const std::shared_ptr<Renderable>& renderable);
@@ -45,12 +48,21 @@ namespace library
         HRESULT AddPixelShader(_In_ PCWSTR pszPixelShaderName, _In_ const std::shared_ptr<PixelShader>& pixelShader);
         HRESULT AddSkyBox(_In_ const std::shared_ptr<Skybox>& skybox);
 
-        void Update(_In_ FLOAT deltaTime);
+        HRESULT SetParent(_In_ SceneHandle handle, _In_ SceneHandle parent);
+        HRESULT SetStatic(_In_ SceneHandle handle, _In_ BOOL bStatic);
+        HRESULT AttachPointLight(_In_ size_t index, _In_ SceneHandle parent);
+        void SetDirectionalLight(_In_ const XMFLOAT4& direction, _In_ const XMFLOAT4& color);
 
-        std::vector<std::shared_ptr<Voxel>>& GetVoxels();
-        std::unordered_map<std::wstring, std::shared_ptr<Renderable>>& GetRenderables();
-        std::unordered_map<std::wstring, std::shared_ptr<Model>>& GetModels();
+        void Update(_In_ FLOAT deltaTime, _In_ WorkerPool& workerPool);
+
+        const SceneObjectTable& GetObjects() const;
+        SceneHandle FindRenderable(_In_ PCWSTR pszRenderableName) const;
+        SceneHandle FindModel(_In_ PCWSTR pszModelName) const;
+        size_t GetNumPointLights() const;
         std::shared_ptr<PointLight>& GetPointLight(_In_ size_t index);
+        const XMFLOAT4& GetPointLightPosition(_In_ size_t index) const;
+        const XMFLOAT4& GetDirectionalLightDirection() const;
+        const XMFLOAT4& GetDirectionalLightColor() const;
         std::unordered_map<std::wstring, std::shared_ptr<VertexShader>>& GetVertexShaders();
         std::unordered_map<std::wstring, std::shared_ptr<PixelShader>>& GetPixelShaders();
         std::shared_ptr<Skybox>& GetSkyBox();
@@ -66,6 +78,18 @@ namespace library
         HRESULT SetPixelShaderOfVoxel(_In_ PCWSTR pszPixelShaderName);
 
     private:
+        void initializeVoxels(
+            _In_ UINT uWidth,
+            _In_ UINT uHeight,
+            _In_ UINT uDepth,
+            _In_ const std::vector<XMFLOAT4>& aColors,
+            _In_ const std::vector<eBlockType>& aBlockTypes,
+            _In_ const std::vector<FLOAT>& aHeights
+        );
+
+        HRESULT compileShaders(_In_ WorkerPool& workerPool);
+        Renderable* findObject(_In_ const std::unordered_map<std::wstring, SceneHandle>& objectNames, _In_ PCWSTR pszObjectName) const;
+
         static FLOAT getNoise2(UINT x, UINT y);
         static FLOAT getNoise2d(FLOAT x, FLOAT y);
         static FLOAT lerp(FLOAT x, FLOAT y, FLOAT s);
@@ -90,10 +114,14 @@ namespace library
 
     private:
         std::filesystem::path m_filePath;
-        std::vector<std::shared_ptr<Voxel>> m_voxels;
-        std::unordered_map<std::wstring, std::shared_ptr<Renderable>> m_renderables;
-        std::unordered_map<std::wstring, std::shared_ptr<Model>> m_models;
-        std::shared_ptr<PointLight> m_aPointLights[NUM_LIGHTS];
+        SceneObjectTable m_objects;
+        std::unordered_map<std::wstring, SceneHandle> m_renderables;
+        std::unordered_map<std::wstring, SceneHandle> m_models;
+        std::vector<std::shared_ptr<PointLight>> m_aPointLights;
+        std::vector<SceneHandle> m_aPointLightParents;
+        std::vector<XMFLOAT4> m_aPointLightPositions;
+        XMFLOAT4 m_directionalLightDirection;
+        XMFLOAT4 m_directionalLightColor;
         std::unordered_map<std::wstring, std::shared_ptr<VertexShader>> m_vertexShaders;
         std::unordered_map<std::wstring, std::shared_ptr<PixelShader>> m_pixelShaders;
         std::unordered_map<std::wstring, std::shared_ptr<Material>> m_materials;
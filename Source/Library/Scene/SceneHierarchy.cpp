@@ -0,0 +1,512 @@
+#include "Scene/SceneHierarchy.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#define SCENE_HIERARCHY_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneHierarchy::Multiply
+
+      Summary:  Multiplies two matrices the way XMMatrixMultiply does,
+                a then b for row vectors
+
+      Args:     const SceneMatrix& a
+                  First transform
+                const SceneMatrix& b
+                  Second transform
+                SceneMatrix& result
+                  Receives a * b, must not alias b
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void SceneHierarchy::Multiply(const SceneMatrix& a, const SceneMatrix& b, SceneMatrix& result)
+    {
+#if defined(SCENE_HIERARCHY_SSE)
+        const __m128 b0 = _mm_loadu_ps(b.m[0]);
+        const __m128 b1 = _mm_loadu_ps(b.m[1]);
+        const __m128 b2 = _mm_loadu_ps(b.m[2]);
+        const __m128 b3 = _mm_loadu_ps(b.m[3]);
+        for (uint32_t uRow = 0u; uRow < 4u; ++uRow)
+        {
+            __m128 row = _mm_mul_ps(_mm_set1_ps(a.m[uRow][0]), b0);
+            row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a.m[uRow][1]), b1));
+            row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a.m[uRow][2]), b2));
+            row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a.m[uRow][3]), b3));
+            _mm_storeu_ps(result.m[uRow], row);
+        }
+#else
+        for (uint32_t uRow = 0u; uRow < 4u; ++uRow)
+        {
+            const float aRow[4] = { a.m[uRow][0], a.m[uRow][1], a.m[uRow][2], a.m[uRow][3] };
+            for (uint32_t uColumn = 0u; uColumn < 4u; ++uColumn)
+            {
+                result.m[uRow][uColumn] = aRow[0] * b.m[0][uColumn] + aRow[1] * b.m[1][uColumn] + aRow[2] * b.m[2][uColumn] + aRow[3] * b.m[3][uColumn];
+            }
+        }
+#endif
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneHierarchy::SceneHierarchy
+
+      Summary:  Constructor
+
+      Modifies: [m_aLocalMatrices, m_aWorldMatrices, m_aParents,
+                 m_aParentIndices, m_abDirty, m_abMoved,
+                 m_aDenseToSlot, m_aSlots, m_aFreeSlots,
+                 m_aUpdateOrder, m_aLevelOffsets, m_bHierarchyChanged,
+                 m_uNumUpdatedWorldMatrices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    SceneHierarchy::SceneHierarchy()
+        : m_aLocalMatrices()
+        , m_aWorldMatrices()
+        , m_aParents()
+        , m_aParentIndices()
+        , m_abDirty()
+        , m_abMoved()
+        , m_aDenseToSlot()
+        , m_aSlots()
+        , m_aFreeSlots()
+        , m_aUpdateOrder()
+        , m_aLevelOffsets()
+        , m_bHierarchyChanged(false)
+        , m_uNumUpdatedWorldMatrices(0u)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneHierarchy::Add
+
+      Summary:  Appends an object at the end of the dense arrays,
+                without a parent
+
+      Args:     const SceneMatrix& local
+                  Local matrix of the object
+
+      Modifies: [m_aLocalMatrices, m_aWorldMatrices, m_aParents,
+                 m_aParentIndices, m_abDirty, m_abMoved,
+                 m_aDenseToSlot, m_aSlots, m_aFreeSlots,
+                 m_bHierarchyChanged].
+
+      Returns:  SceneHandle
+                  Handle of the object
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    SceneHandle SceneHierarchy::Add(const SceneMatrix& local)
+    {
+        uint32_t uSlot = 0u;
+        if (m_aFreeSlots.empty())
+        {
+            uSlot = static_cast<uint32_t>(m_aSlots.size());
+            m_aSlots.push_back(Slot{ .uDenseIndex = INVALID_INDEX, .uGeneration = 1u });
+        }
+        else
+        {
+            uSlot = m_aFreeSlots.back();
+            m_aFreeSlots.pop_back();
+        }
+
+        m_aSlots[uSlot].uDenseIndex = static_cast<uint32_t>(m_aLocalMatrices.size());
+
+        m_aLocalMatrices.push_back(local);
+        m_aWorldMatrices.push_back(local);
+        m_aParents.push_back(SceneHandle{});
+        m_aParentIndices.push_back(INVALID_INDEX);
+        m_abDirty.push_back(1u);
+        m_abMoved.push_back(0u);
+        m_aDenseToSlot.push_back(uSlot);
+        m_bHierarchyChanged = true;
+
+        return SceneHandle{ .uIndex = uSlot, .uGeneration = m_aSlots[uSlot].uGeneration };
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneHierarchy::Remove
+
+      Summary:  Removes an object by moving the last object into its
+                place, and invalidates the handles to it. Its children
+                lose their parent
+
+      Args:     SceneHandle handle
+                  Handle of the object
+
+      Modifies: [m_aLocalMatrices, m_aWorldMatrices, m_aParents,
+                 m_aParentIndices, m_abDirty, m_abMoved,
+                 m_aDenseToSlot, m_aSlots, m_aFreeSlots,
+                 m_bHierarchyChanged].
+
+      Returns:  uint32_t
+                  Dense index the last object moved to, INVALID_INDEX
+                  if the handle is stale
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t SceneHierarchy::Remove(SceneHandle handle)
+    {
+        const uint32_t uDenseIndex = GetDenseIndex(handle);
+        if (uDenseIndex == INVALID_INDEX)
+        {
+            return INVALID_INDEX;
+        }
+
+        const uint32_t uLastIndex = static_cast<uint32_t>(m_aLocalMatrices.size()) - 1u;
+        if (uDenseIndex != uLastIndex)
+        {
+            m_aLocalMatrices[uDenseIndex] = m_aLocalMatrices[uLastIndex];
+            m_aWorldMatrices[uDenseIndex] = m_aWorldMatrices[uLastIndex];
+            m_aParents[uDenseIndex] = m_aParents[uLastIndex];
+            m_aParentIndices[uDenseIndex] = m_aParentIndices[uLastIndex];
+            m_abDirty[uDenseIndex] = m_abDirty[uLastIndex];
+            m_abMoved[uDenseIndex] = m_abMoved[uLastIndex];
+            m_aDenseToSlot[uDenseIndex] = m_aDenseToSlot[uLastIndex];
+            m_aSlots[m_aDenseToSlot[uDenseIndex]].uDenseIndex = uDenseIndex;
+        }
+
+        m_aLocalMatrices.pop_back();
+        m_aWorldMatrices.pop_back();
+        m_aParents.pop_back();
+        m_aParentIndices.pop_back();
+        m_abDirty.pop_back();
+        m_abMoved.pop_back();
+        m_aDenseToSlot.pop_back();
+
+        // The children still hold the stale handle and become roots when the order is rebuilt
+        m_aSlots[handle.uIndex].uDenseIndex = INVALID_INDEX;
+        ++m_aSlots[handle.uIndex].uGeneration;
+        m_aFreeSlots.push_back(handle.uIndex);
+        m_bHierarchyChanged = true;
+
+        return uDenseIndex;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneHierarchy::IsValid
+
+      Summary:  Returns whether the handle refers to a live object
+
+      Args:     SceneHandle handle
+                  Handle of the object
+
+      Returns:  bool
+                  True if the object has not been removed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    bool SceneHierarchy::IsValid(SceneHandle handle) const
+    {
+        return GetDenseIndex(handle) != INVALID_INDEX;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneHierarchy::GetDenseIndex
+
+      Summary:  Returns the index of the object in the dense arrays. It
+                changes when another object is removed
+
+      Args:     SceneHandle handle
+                  Handle of the object
+
+      Returns:  uint32_t
+                  Dense index, INVALID_INDEX if the handle is stale
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t SceneHierarchy::GetDenseIndex(SceneHandle handle) const
+    {
+        if (handle.uIndex >= m_aSlots.size() || m_aSlots[handle.uIndex].uGeneration != handle.uGeneration)
+        {
+            return INVALID_INDEX;
+        }
+
+        return m_aSlots[handle.uIndex].uDenseIndex;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneHierarchy::SetParent
+
+      Summary:  Parents an object to another. The local matrix of the
+                object becomes relative to the world matrix of the
+                parent
+
+      Args:     SceneHandle handle
+                  Handle of the object
+                SceneHandle parent
+                  Handle of the parent, an invalid handle to detach
+                  the object
+
+      Modifies: [m_aParents, m_bHierarchyChanged].
+
+      Returns:  bool
+                  False if the object handle is stale or the parent is
+                  the object or one of its descendants
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    bool SceneHierarchy::SetParent(SceneHandle handle, SceneHandle parent)
+    {
+        const uint32_t uDenseIndex = GetDenseIndex(handle);
+        if (uDenseIndex == INVALID_INDEX)
+        {
+            return false;
+        }
+
+        for (uint32_t uAncestor = GetDenseIndex(parent); uAncestor != INVALID_INDEX; uAncestor = GetDenseIndex(m_aParents[uAncestor]))
+        {
+            if (uAncestor == uDenseIndex)
+            {
+                return false;
+            }
+        }
+
+        m_aParents[uDenseIndex] = IsValid(parent) ? parent : SceneHandle{};
+        m_bHierarchyChanged = true;
+
+        return true;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneHierarchy::SetLocalMatrix
+
+      Summary:  Sets the local matrix of an object, which marks it
+                dirty only if the matrix changed
+
+      Args:     uint32_t uDenseIndex
+                  Dense index of the object
+                const SceneMatrix& local
+                  Local matrix of the object
+
+      Modifies: [m_aLocalMatrices, m_abDirty].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void SceneHierarchy::SetLocalMatrix(uint32_t uDenseIndex, const SceneMatrix& local)
+    {
+        if (memcmp(&local, &m_aLocalMatrices[uDenseIndex], sizeof(local)) != 0)
+        {
+            m_aLocalMatrices[uDenseIndex] = local;
+            m_abDirty[uDenseIndex] = 1u;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneHierarchy::UpdateWorldMatrices
+
+      Summary:  Recomputes the world matrices of the dirty objects and
+                their descendants, one level at a time. The objects of
+                a large level are split across the threads of the pool
+
+      Args:     WorkerPool& workerPool
+                  Threads to update the levels on
+
+      Modifies: [m_aWorldMatrices, m_abDirty, m_abMoved,
+                 m_bHierarchyChanged, m_uNumUpdatedWorldMatrices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void SceneHierarchy::UpdateWorldMatrices(WorkerPool& workerPool)
+    {
+        if (m_bHierarchyChanged)
+        {
+            rebuildUpdateOrder();
+            m_bHierarchyChanged = false;
+        }
+
+        m_uNumUpdatedWorldMatrices = 0u;
+        std::fill(m_abMoved.begin(), m_abMoved.end(), static_cast<uint8_t>(0u));
+
+        for (size_t uLevel = 0u; uLevel + 1u < m_aLevelOffsets.size(); ++uLevel)
+        {
+            const uint32_t uBegin = m_aLevelOffsets[uLevel];
+            const uint32_t uEnd = m_aLevelOffsets[uLevel + 1u];
+            const uint32_t uNumTasks = (std::max)((std::min)(workerPool.GetNumThreads(), (uEnd - uBegin) / MIN_OBJECTS_PER_TASK), 1u);
+            if (uNumTasks == 1u)
+            {
+                m_uNumUpdatedWorldMatrices += updateWorldMatrixRange(uBegin, uEnd);
+                continue;
+            }
+
+            // The objects of a level only read the previous levels, so the ranges are independent
+            std::vector<uint32_t> aNumUpdated(uNumTasks, 0u);
+            workerPool.ParallelFor(uNumTasks, [this, &aNumUpdated, uBegin, uEnd, uNumTasks](uint32_t uTask)
+            {
+                const uint32_t uNumObjects = uEnd - uBegin;
+                aNumUpdated[uTask] = updateWorldMatrixRange(
+                    uBegin + static_cast<uint32_t>(static_cast<uint64_t>(uNumObjects) * uTask / uNumTasks),
+                    uBegin + static_cast<uint32_t>(static_cast<uint64_t>(uNumObjects) * (uTask + 1u) / uNumTasks)
+                );
+            });
+
+            for (uint32_t uNumUpdated : aNumUpdated)
+            {
+                m_uNumUpdatedWorldMatrices += uNumUpdated;
+            }
+        }
+
+        std::fill(m_abDirty.begin(), m_abDirty.end(), static_cast<uint8_t>(0u));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneHierarchy::GetNumObjects
+
+      Summary:  Returns the number of objects
+
+      Returns:  uint32_t
+                  Size of the dense arrays
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t SceneHierarchy::GetNumObjects() const
+    {
+        return static_cast<uint32_t>(m_aLocalMatrices.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneHierarchy::GetWorldMatrices
+
+      Summary:  Returns the world matrices, indexed by dense index
+
+      Returns:  const SceneMatrix*
+                  World matrix array
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const SceneMatrix* SceneHierarchy::GetWorldMatrices() const
+    {
+        return m_aWorldMatrices.data();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneHierarchy::GetMovedFlags
+
+      Summary:  Returns whether the world matrix of each object was
+                recomputed by the last update, indexed by dense index.
+                Adding or removing an object or changing a parent
+                recomputes every world matrix
+
+      Returns:  const uint8_t*
+                  Moved flag array, non-zero if it moved
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const uint8_t* SceneHierarchy::GetMovedFlags() const
+    {
+        return m_abMoved.data();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneHierarchy::GetNumUpdatedWorldMatrices
+
+      Summary:  Returns the number of world matrices recomputed by the
+                last update
+
+      Returns:  uint32_t
+                  Number of objects that moved or whose ancestors moved
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t SceneHierarchy::GetNumUpdatedWorldMatrices() const
+    {
+        return m_uNumUpdatedWorldMatrices;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneHierarchy::rebuildUpdateOrder
+
+      Summary:  Resolves the parent handles to dense indices and sorts
+                the objects by depth, so that each level only depends
+                on the levels before it. Parents that were removed are
+                dropped
+
+      Modifies: [m_aParents, m_aParentIndices, m_abDirty,
+                 m_aUpdateOrder, m_aLevelOffsets].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void SceneHierarchy::rebuildUpdateOrder()
+    {
+        const uint32_t uNumObjects = GetNumObjects();
+
+        for (uint32_t i = 0u; i < uNumObjects; ++i)
+        {
+            m_aParentIndices[i] = GetDenseIndex(m_aParents[i]);
+            if (m_aParentIndices[i] == INVALID_INDEX)
+            {
+                m_aParents[i] = SceneHandle{};
+            }
+        }
+
+        // Depth of every object, walking up until an ancestor with a known depth
+        std::vector<uint32_t> aDepths(uNumObjects, INVALID_INDEX);
+        std::vector<uint32_t> aChain;
+        uint32_t uNumLevels = 0u;
+        for (uint32_t i = 0u; i < uNumObjects; ++i)
+        {
+            uint32_t uObject = i;
+            while (uObject != INVALID_INDEX && aDepths[uObject] == INVALID_INDEX)
+            {
+                aChain.push_back(uObject);
+                uObject = m_aParentIndices[uObject];
+            }
+
+            uint32_t uDepth = uObject == INVALID_INDEX ? 0u : aDepths[uObject] + 1u;
+            for (auto it = aChain.rbegin(); it != aChain.rend(); ++it, ++uDepth)
+            {
+                aDepths[*it] = uDepth;
+            }
+            aChain.clear();
+
+            uNumLevels = (std::max)(uNumLevels, aDepths[i] + 1u);
+        }
+
+        // Counting sort by depth
+        m_aLevelOffsets.assign(uNumLevels + 1u, 0u);
+        for (uint32_t i = 0u; i < uNumObjects; ++i)
+        {
+            ++m_aLevelOffsets[aDepths[i] + 1u];
+        }
+        for (uint32_t uLevel = 0u; uLevel < uNumLevels; ++uLevel)
+        {
+            m_aLevelOffsets[uLevel + 1u] += m_aLevelOffsets[uLevel];
+        }
+
+        std::vector<uint32_t> aCursors(m_aLevelOffsets.begin(), m_aLevelOffsets.end() - 1);
+        m_aUpdateOrder.resize(uNumObjects);
+        for (uint32_t i = 0u; i < uNumObjects; ++i)
+        {
+            m_aUpdateOrder[aCursors[aDepths[i]]++] = i;
+        }
+
+        // Dense indices moved, every world matrix is recomputed once
+        m_abDirty.assign(uNumObjects, 1u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneHierarchy::updateWorldMatrixRange
+
+      Summary:  Recomputes the world matrices of a range of the update
+                order. An object is dirty if it moved or its parent was
+                recomputed
+
+      Args:     uint32_t uBegin
+                  First position in the update order
+                uint32_t uEnd
+                  Position past the last one
+
+      Modifies: [m_aWorldMatrices, m_abDirty, m_abMoved].
+
+      Returns:  uint32_t
+                  Number of world matrices recomputed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t SceneHierarchy::updateWorldMatrixRange(uint32_t uBegin, uint32_t uEnd)
+    {
+        uint32_t uNumUpdated = 0u;
+        for (uint32_t uOrder = uBegin; uOrder < uEnd; ++uOrder)
+        {
+            const uint32_t i = m_aUpdateOrder[uOrder];
+            const uint32_t uParent = m_aParentIndices[i];
+            if (uParent != INVALID_INDEX && m_abDirty[uParent])
+            {
+                m_abDirty[i] = 1u;
+            }
+
+            if (!m_abDirty[i])
+            {
+                continue;
+            }
+
+            if (uParent == INVALID_INDEX)
+            {
+                m_aWorldMatrices[i] = m_aLocalMatrices[i];
+            }
+            else
+            {
+                Multiply(m_aLocalMatrices[i], m_aWorldMatrices[uParent], m_aWorldMatrices[i]);
+            }
+            m_abMoved[i] = 1u;
+            ++uNumUpdated;
+        }
+
+        return uNumUpdated;
+    }
+}
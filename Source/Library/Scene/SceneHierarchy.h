@@ -0,0 +1,153 @@
+/*+===================================================================
+  File:      SCENEHIERARCHY.H
+
+  Summary:   SceneHierarchy header file contains declarations of
+             SceneHierarchy class used for the lab samples of Game
+             Graphics Programming course. Only depends on the
+             standard library.
+
+  Classes: SceneHierarchy
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Renderer/WorkerPool.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   SceneHandle
+
+      Summary:  Stable reference to an object of a SceneHierarchy.
+                The generation of a removed object's slot is bumped, so
+                a handle to it stays invalid when the slot is reused
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct SceneHandle
+    {
+        uint32_t uIndex;
+        uint32_t uGeneration;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   SceneMatrix
+
+      Summary:  Row-major 4x4 matrix with the layout of XMFLOAT4X4,
+                transforming row vectors
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct SceneMatrix
+    {
+        float m[4][4];
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    SceneHierarchy
+
+      Summary:  Slots, transforms and parents of the scene objects.
+                Objects live at a dense index, and removing one moves
+                the last object into its place; handles go through a
+                slot array and stay valid across the move. Owners of
+                other per-object arrays mirror that move
+
+                The world matrices are updated level by level, parents
+                before children, only for the objects whose local
+                matrix or ancestors changed
+
+      Methods:  Add
+                  Adds an object and returns its handle
+                Remove
+                  Removes an object
+                IsValid
+                  Returns whether a handle refers to a live object
+                GetDenseIndex
+                  Returns the dense index of an object
+                SetParent
+                  Parents an object to another
+                SetLocalMatrix
+                  Sets the local matrix of an object
+                UpdateWorldMatrices
+                  Recomputes the world matrices that changed
+                GetNumObjects
+                  Returns the number of objects
+                GetWorldMatrices
+                  Returns the world matrix array
+                GetMovedFlags
+                  Returns whether each world matrix was recomputed by
+                  the last update
+                GetNumUpdatedWorldMatrices
+                  Returns the number of world matrices recomputed by
+                  the last update
+                Multiply
+                  Multiplies two matrices
+                rebuildUpdateOrder
+                  Sorts the objects by depth
+                updateWorldMatrixRange
+                  Recomputes the world matrices of a range of the
+                  update order
+                SceneHierarchy
+                  Constructor.
+                ~SceneHierarchy
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class SceneHierarchy final
+    {
+    public:
+        static constexpr const uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+        static constexpr const uint32_t MIN_OBJECTS_PER_TASK = 1024u;
+
+        static void Multiply(const SceneMatrix& a, const SceneMatrix& b, SceneMatrix& result);
+
+        SceneHierarchy();
+        SceneHierarchy(const SceneHierarchy& other) = delete;
+        SceneHierarchy(SceneHierarchy&& other) = delete;
+        SceneHierarchy& operator=(const SceneHierarchy& other) = delete;
+        SceneHierarchy& operator=(SceneHierarchy&& other) = delete;
+        ~SceneHierarchy() = default;
+
+        SceneHandle Add(const SceneMatrix& local);
+        uint32_t Remove(SceneHandle handle);
+        bool IsValid(SceneHandle handle) const;
+        uint32_t GetDenseIndex(SceneHandle handle) const;
+        bool SetParent(SceneHandle handle, SceneHandle parent);
+        void SetLocalMatrix(uint32_t uDenseIndex, const SceneMatrix& local);
+
+        void UpdateWorldMatrices(WorkerPool& workerPool);
+
+        uint32_t GetNumObjects() const;
+        const SceneMatrix* GetWorldMatrices() const;
+        const uint8_t* GetMovedFlags() const;
+        uint32_t GetNumUpdatedWorldMatrices() const;
+
+    private:
+        void rebuildUpdateOrder();
+        uint32_t updateWorldMatrixRange(uint32_t uBegin, uint32_t uEnd);
+
+    private:
+        struct Slot
+        {
+            uint32_t uDenseIndex;
+            uint32_t uGeneration;
+        };
+
+    private:
+        std::vector<SceneMatrix> m_aLocalMatrices;
+        std::vector<SceneMatrix> m_aWorldMatrices;
+        std::vector<SceneHandle> m_aParents;
+        std::vector<uint32_t> m_aParentIndices;
+        // Bytes rather than std::vector<bool>, the ranges of a level are written from several threads
+        std::vector<uint8_t> m_abDirty;
+        std::vector<uint8_t> m_abMoved;
+
+        std::vector<uint32_t> m_aDenseToSlot;
+        std::vector<Slot> m_aSlots;
+        std::vector<uint32_t> m_aFreeSlots;
+
+        std::vector<uint32_t> m_aUpdateOrder;
+        std::vector<uint32_t> m_aLevelOffsets;
+        bool m_bHierarchyChanged;
+        uint32_t m_uNumUpdatedWorldMatrices;
+    };
+}
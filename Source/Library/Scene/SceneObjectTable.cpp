@@ -0,0 +1,311 @@
+#include "Scene/SceneObjectTable.h"
+
+namespace library
+{
+    static_assert(sizeof(SceneMatrix) == sizeof(XMFLOAT4X4), "SceneMatrix must have the layout of XMFLOAT4X4");
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectTable::SceneObjectTable
+
+      Summary:  Constructor
+
+      Modifies: [m_hierarchy, m_apRenderables, m_aMaterials, m_aFlags,
+                 m_aOwners].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    SceneObjectTable::SceneObjectTable()
+        : m_hierarchy()
+        , m_apRenderables()
+        , m_aMaterials()
+        , m_aFlags()
+        , m_aOwners()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectTable::Add
+
+      Summary:  Appends an object to the dense arrays, without a
+                parent
+
+      Args:     const std::shared_ptr<Renderable>& renderable
+                  Renderable of the object, kept alive by the table
+                UINT uFlags
+                  FLAG_* bits of the object
+
+      Modifies: [m_hierarchy, m_apRenderables, m_aMaterials, m_aFlags,
+                 m_aOwners].
+
+      Returns:  SceneHandle
+                  Handle of the object
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    SceneHandle SceneObjectTable::Add(_In_ const std::shared_ptr<Renderable>& renderable, _In_ UINT uFlags)
+    {
+        assert(renderable);
+
+        SceneMatrix local;
+        XMStoreFloat4x4(reinterpret_cast<XMFLOAT4X4*>(&local), renderable->GetWorldMatrix());
+        const SceneHandle handle = m_hierarchy.Add(local);
+
+        m_apRenderables.push_back(renderable.get());
+        m_aMaterials.push_back(SceneObjectMaterial{ .OutputColor = renderable->GetOutputColor(), .uShaderFeatures = renderable->GetShaderFeatures() });
+        m_aFlags.push_back(uFlags);
+        m_aOwners.push_back(renderable);
+
+        return handle;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectTable::Remove
+
+      Summary:  Removes an object from the hierarchy, and moves the
+                last renderable into its place the way the hierarchy
+                moved the last transform. Its children lose their
+                parent
+
+      Args:     SceneHandle handle
+                  Handle of the object
+
+      Modifies: [m_hierarchy, m_apRenderables, m_aMaterials, m_aFlags,
+                 m_aOwners].
+
+      Returns:  BOOL
+                  FALSE if the handle is stale
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL SceneObjectTable::Remove(_In_ SceneHandle handle)
+    {
+        const UINT uDenseIndex = m_hierarchy.Remove(handle);
+        if (uDenseIndex == INVALID_INDEX)
+        {
+            return FALSE;
+        }
+
+        const UINT uLastIndex = static_cast<UINT>(m_apRenderables.size()) - 1u;
+        if (uDenseIndex != uLastIndex)
+        {
+            m_apRenderables[uDenseIndex] = m_apRenderables[uLastIndex];
+            m_aMaterials[uDenseIndex] = m_aMaterials[uLastIndex];
+            m_aFlags[uDenseIndex] = m_aFlags[uLastIndex];
+            m_aOwners[uDenseIndex] = std::move(m_aOwners[uLastIndex]);
+        }
+
+        m_apRenderables.pop_back();
+        m_aMaterials.pop_back();
+        m_aFlags.pop_back();
+        m_aOwners.pop_back();
+
+        return TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectTable::IsValid
+
+      Summary:  Returns whether the handle refers to a live object
+
+      Args:     SceneHandle handle
+                  Handle of the object
+
+      Returns:  BOOL
+                  TRUE if the object has not been removed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL SceneObjectTable::IsValid(_In_ SceneHandle handle) const
+    {
+        return m_hierarchy.IsValid(handle);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectTable::GetDenseIndex
+
+      Summary:  Returns the index of the object in the component
+                arrays. It changes when another object is removed
+
+      Args:     SceneHandle handle
+                  Handle of the object
+
+      Returns:  UINT
+                  Dense index, INVALID_INDEX if the handle is stale
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT SceneObjectTable::GetDenseIndex(_In_ SceneHandle handle) const
+    {
+        return m_hierarchy.GetDenseIndex(handle);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectTable::SetFlags
+
+      Summary:  Sets the flags of an object
+
+      Args:     SceneHandle handle
+                  Handle of the object
+                UINT uFlags
+                  FLAG_* bits of the object
+
+      Modifies: [m_aFlags].
+
+      Returns:  BOOL
+                  FALSE if the handle is stale
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL SceneObjectTable::SetFlags(_In_ SceneHandle handle, _In_ UINT uFlags)
+    {
+        const UINT uDenseIndex = GetDenseIndex(handle);
+        if (uDenseIndex == INVALID_INDEX)
+        {
+            return FALSE;
+        }
+
+        m_aFlags[uDenseIndex] = uFlags;
+
+        return TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectTable::SetParent
+
+      Summary:  Parents an object to another. The matrix of the object
+                becomes relative to the world matrix of the parent
+
+      Args:     SceneHandle handle
+                  Handle of the object
+                SceneHandle parent
+                  Handle of the parent, an invalid handle to detach
+                  the object
+
+      Modifies: [m_hierarchy].
+
+      Returns:  BOOL
+                  FALSE if the object handle is stale or the parent is
+                  the object or one of its descendants
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL SceneObjectTable::SetParent(_In_ SceneHandle handle, _In_ SceneHandle parent)
+    {
+        return m_hierarchy.SetParent(handle, parent);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectTable::Update
+
+      Summary:  Updates every object, copies its local matrix and
+                material constants into the component arrays, and
+                updates the world matrices of the objects that moved
+
+      Args:     FLOAT deltaTime
+                  Time difference of a frame
+                WorkerPool& workerPool
+                  Threads to update the world matrices on
+
+      Modifies: [m_hierarchy, m_aMaterials].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void SceneObjectTable::Update(_In_ FLOAT deltaTime, _In_ WorkerPool& workerPool)
+    {
+        const UINT uNumObjects = static_cast<UINT>(m_apRenderables.size());
+        for (UINT i = 0u; i < uNumObjects; ++i)
+        {
+            Renderable* pRenderable = m_apRenderables[i];
+            pRenderable->Update(deltaTime);
+
+            SceneMatrix local;
+            XMStoreFloat4x4(reinterpret_cast<XMFLOAT4X4*>(&local), pRenderable->GetWorldMatrix());
+            m_hierarchy.SetLocalMatrix(i, local);
+
+            m_aMaterials[i].OutputColor = pRenderable->GetOutputColor();
+            m_aMaterials[i].uShaderFeatures = pRenderable->GetShaderFeatures();
+        }
+
+        m_hierarchy.UpdateWorldMatrices(workerPool);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectTable::GetNumObjects
+
+      Summary:  Returns the number of objects
+
+      Returns:  UINT
+                  Size of the component arrays
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT SceneObjectTable::GetNumObjects() const
+    {
+        return static_cast<UINT>(m_apRenderables.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectTable::GetWorldMatrices
+
+      Summary:  Returns the world matrices, indexed by dense index
+
+      Returns:  const XMFLOAT4X4*
+                  World matrix array
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const XMFLOAT4X4* SceneObjectTable::GetWorldMatrices() const
+    {
+        return reinterpret_cast<const XMFLOAT4X4*>(m_hierarchy.GetWorldMatrices());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectTable::GetRenderables
+
+      Summary:  Returns the renderables holding the meshes and GPU
+                resources, indexed by dense index
+
+      Returns:  Renderable* const*
+                  Renderable array
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    Renderable* const* SceneObjectTable::GetRenderables() const
+    {
+        return m_apRenderables.data();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectTable::GetMaterials
+
+      Summary:  Returns the material constants, indexed by dense index
+
+      Returns:  const SceneObjectMaterial*
+                  Material array
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const SceneObjectMaterial* SceneObjectTable::GetMaterials() const
+    {
+        return m_aMaterials.data();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectTable::GetFlags
+
+      Summary:  Returns the flags, indexed by dense index
+
+      Returns:  const UINT*
+                  Flag array
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const UINT* SceneObjectTable::GetFlags() const
+    {
+        return m_aFlags.data();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectTable::GetMovedFlags
+
+      Summary:  Returns whether the world matrix of each object was
+                recomputed by the last update, indexed by dense index.
+                Adding or removing an object or changing a parent
+                recomputes every world matrix
+
+      Returns:  const uint8_t*
+                  Moved flag array, non-zero if it moved
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const uint8_t* SceneObjectTable::GetMovedFlags() const
+    {
+        return m_hierarchy.GetMovedFlags();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SceneObjectTable::GetNumUpdatedWorldMatrices
+
+      Summary:  Returns the number of world matrices recomputed by the
+                last update
+
+      Returns:  UINT
+                  Number of objects that moved or whose ancestors moved
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT SceneObjectTable::GetNumUpdatedWorldMatrices() const
+    {
+        return m_hierarchy.GetNumUpdatedWorldMatrices();
+    }
+}
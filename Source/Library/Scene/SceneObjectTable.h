@@ -0,0 +1,123 @@
+/*+===================================================================
+  File:      SCENEOBJECTTABLE.H
+
+  Summary:   SceneObjectTable header file contains declarations of
+             SceneObjectTable class used for the lab samples of Game
+             Graphics Programming course.
+
+  Classes: SceneObjectTable
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/Renderable.h"
+#include "Renderer/WorkerPool.h"
+#include "Scene/SceneHierarchy.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   SceneObjectMaterial
+
+      Summary:  Per-object material constants read every frame
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct SceneObjectMaterial
+    {
+        XMFLOAT4 OutputColor;
+        UINT uShaderFeatures;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    SceneObjectTable
+
+      Summary:  Dense table of the scene objects. Each component is
+                stored in its own array indexed by the dense index, so
+                the frame loop walks contiguous memory without hashing
+                names or touching reference counts. The slots, parents
+                and transforms are kept by a SceneHierarchy, and the
+                renderable arrays follow its dense indices
+
+                The matrix of each renderable is its local transform.
+                Objects flagged static are expected to rarely move, so
+                what is derived from them can be cached
+
+      Methods:  Add
+                  Adds an object and returns its handle
+                Remove
+                  Removes an object
+                IsValid
+                  Returns whether a handle refers to a live object
+                GetDenseIndex
+                  Returns the dense index of an object
+                SetFlags
+                  Sets the flags of an object
+                SetParent
+                  Parents an object to another
+                Update
+                  Updates the objects and refreshes their components
+                GetNumObjects
+                  Returns the number of objects
+                GetWorldMatrices
+                  Returns the world matrix array
+                GetRenderables
+                  Returns the renderable array
+                GetMaterials
+                  Returns the material array
+                GetFlags
+                  Returns the flag array
+                GetMovedFlags
+                  Returns whether each world matrix was recomputed by
+                  the last update
+                GetNumUpdatedWorldMatrices
+                  Returns the number of world matrices recomputed by
+                  the last update
+                SceneObjectTable
+                  Constructor.
+                ~SceneObjectTable
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class SceneObjectTable final
+    {
+    public:
+        static constexpr const UINT INVALID_INDEX = SceneHierarchy::INVALID_INDEX;
+
+        static constexpr const UINT FLAG_VISIBLE = 0x1u;
+        static constexpr const UINT FLAG_VOXEL = 0x2u;
+        static constexpr const UINT FLAG_MODEL = 0x4u;
+        static constexpr const UINT FLAG_STATIC = 0x8u;
+
+        SceneObjectTable();
+        SceneObjectTable(const SceneObjectTable& other) = delete;
+        SceneObjectTable(SceneObjectTable&& other) = delete;
+        SceneObjectTable& operator=(const SceneObjectTable& other) = delete;
+        SceneObjectTable& operator=(SceneObjectTable&& other) = delete;
+        ~SceneObjectTable() = default;
+
+        SceneHandle Add(_In_ const std::shared_ptr<Renderable>& renderable, _In_ UINT uFlags);
+        BOOL Remove(_In_ SceneHandle handle);
+        BOOL IsValid(_In_ SceneHandle handle) const;
+        UINT GetDenseIndex(_In_ SceneHandle handle) const;
+        BOOL SetFlags(_In_ SceneHandle handle, _In_ UINT uFlags);
+        BOOL SetParent(_In_ SceneHandle handle, _In_ SceneHandle parent);
+
+        void Update(_In_ FLOAT deltaTime, _In_ WorkerPool& workerPool);
+
+        UINT GetNumObjects() const;
+        const XMFLOAT4X4* GetWorldMatrices() const;
+        Renderable* const* GetRenderables() const;
+        const SceneObjectMaterial* GetMaterials() const;
+        const UINT* GetFlags() const;
+        const uint8_t* GetMovedFlags() const;
+        UINT GetNumUpdatedWorldMatrices() const;
+
+    private:
+        SceneHierarchy m_hierarchy;
+        std::vector<Renderable*> m_apRenderables;
+        std::vector<SceneObjectMaterial> m_aMaterials;
+        std::vector<UINT> m_aFlags;
+        std::vector<std::shared_ptr<Renderable>> m_aOwners;
+    };
+}
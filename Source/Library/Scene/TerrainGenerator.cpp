@@ -0,0 +1,389 @@
+#include "Scene/TerrainGenerator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <fstream>
+#include <thread>
+
+#include "Scene/Scene.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::GetBlockType
+
+      Summary:  Classifies a cell of the map into a biome
+
+      Args:     FLOAT height
+                  Normalized height of the cell
+                FLOAT moisture
+                  Normalized moisture of the cell
+
+      Returns:  eBlockType
+                  Block type of the cell
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    eBlockType TerrainGenerator::GetBlockType(_In_ FLOAT height, _In_ FLOAT moisture)
+    {
+        if (height < 0.1f)
+        {
+            return eBlockType::OCEAN;
+        }
+        if (height < 0.12f)
+        {
+            return eBlockType::SAND;
+        }
+        if (height > 0.8f)
+        {
+            if (moisture < 0.1f)
+            {
+                return eBlockType::SCORCHED;
+            }
+            if (moisture < 0.2f)
+            {
+                return eBlockType::BARE;
+            }
+            if (moisture < 0.5f)
+            {
+                return eBlockType::TUNDRA;
+            }
+            return eBlockType::SNOW;
+        }
+        if (height > 0.6f)
+        {
+            if (moisture < 0.33f)
+            {
+                return eBlockType::TEMPERATE_DESERT;
+            }
+            if (moisture < 0.66f)
+            {
+                return eBlockType::SHRUBLAND;
+            }
+            return eBlockType::TAIGA;
+        }
+        if (height > 0.3f)
+        {
+            if (moisture < 0.16f)
+            {
+                return eBlockType::TEMPERATE_DESERT;
+            }
+            if (moisture < 0.5f)
+            {
+                return eBlockType::GRASSLAND;
+            }
+            if (moisture < 0.83f)
+            {
+                return eBlockType::TEMPERATE_DECIDUOUS_FOREST;
+            }
+            return eBlockType::TEMPERATE_RAIN_FOREST;
+        }
+
+        if (moisture < 0.16f)
+        {
+            return eBlockType::SUBTROPICAL_DESERT;
+        }
+        if (moisture < 0.33f)
+        {
+            return eBlockType::GRASSLAND;
+        }
+        if (moisture < 0.66f)
+        {
+            return eBlockType::TROPICAL_SEASONAL_FOREST;
+        }
+        return eBlockType::TROPICAL_RAIN_FOREST;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::TerrainGenerator
+
+      Summary:  Constructor
+
+      Args:     UINT uWidth
+                  Number of cells along the x-axis
+                UINT uHeight
+                  Maximum number of blocks in a column
+                UINT uDepth
+                  Number of cells along the z-axis
+                const XMFLOAT4* aColors
+                  Color of each block type, starting from GRASSLAND
+                UINT uNumColors
+                  Number of colors
+
+      Modifies: [m_uWidth, m_uHeight, m_uDepth, m_uNumTilesX,
+                 m_aColors, m_aHeights, m_aMoistures, m_aBlockTypes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TerrainGenerator::TerrainGenerator(_In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uDepth, _In_ const XMFLOAT4* aColors, _In_ UINT uNumColors)
+        : m_uWidth(uWidth)
+        , m_uHeight(uHeight)
+        , m_uDepth(uDepth)
+        , m_uNumTilesX((uWidth + TILE_SIZE - 1u) / TILE_SIZE)
+        , m_aColors(aColors, aColors + uNumColors)
+        , m_aHeights()
+        , m_aMoistures()
+        , m_aBlockTypes()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::Generate
+
+      Summary:  Generates the height, moisture and biome grids. Every
+                tile of the map is written by exactly one worker, so
+                the workers never touch the same memory
+
+      Args:     UINT uNumThreads
+                  Number of worker threads, 0 to use every hardware
+                  thread
+
+      Modifies: [m_aHeights, m_aMoistures, m_aBlockTypes].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT TerrainGenerator::Generate(_In_opt_ UINT uNumThreads)
+    {
+        const size_t uNumCells = static_cast<size_t>(m_uWidth) * static_cast<size_t>(m_uDepth);
+
+        m_aHeights.assign(uNumCells, 0.0f);
+        m_aMoistures.assign(uNumCells, 0.0f);
+        m_aBlockTypes.assign(uNumCells, eBlockType::GRASSLAND);
+
+        const UINT uNumTiles = m_uNumTilesX * ((m_uDepth + TILE_SIZE - 1u) / TILE_SIZE);
+        if (uNumTiles == 0u)
+        {
+            return S_OK;
+        }
+
+        if (uNumThreads == 0u)
+        {
+            uNumThreads = (std::max)(std::thread::hardware_concurrency(), 1u);
+        }
+        uNumThreads = (std::min)(uNumThreads, uNumTiles);
+
+        std::atomic<UINT> uNextTile(0u);
+        auto worker = [this, &uNextTile, uNumTiles]()
+        {
+            for (UINT uTileIdx = uNextTile.fetch_add(1u); uTileIdx < uNumTiles; uTileIdx = uNextTile.fetch_add(1u))
+            {
+                generateTile(uTileIdx);
+            }
+        };
+
+        std::vector<std::thread> aWorkers;
+        aWorkers.reserve(uNumThreads - 1u);
+        for (UINT i = 1u; i < uNumThreads; ++i)
+        {
+            aWorkers.emplace_back(worker);
+        }
+
+        // The calling thread works on the tiles too
+        worker();
+
+        for (std::thread& thread : aWorkers)
+        {
+            thread.join();
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::ExportToFile
+
+      Summary:  Writes the generated map in the height map format that
+                Scene can load
+
+      Args:     const std::filesystem::path& filePath
+                  Path to the height map file
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT TerrainGenerator::ExportToFile(_In_ const std::filesystem::path& filePath) const
+    {
+        std::ofstream sceneFile;
+        sceneFile.open(filePath);
+        if (!sceneFile.is_open())
+        {
+            return E_FAIL;
+        }
+
+        sceneFile << m_uWidth << " " << m_uHeight << " " << m_uDepth << ' ' << m_aColors.size() << '\n';
+
+        for (const XMFLOAT4& color : m_aColors)
+        {
+            sceneFile << color.x << ' ' << color.y << ' ' << color.z << '\n';
+        }
+
+        for (UINT z = 0u; z < m_uDepth; ++z)
+        {
+            for (UINT x = 0u; x < m_uWidth; ++x)
+            {
+                const size_t uCellIdx = static_cast<size_t>(z) * m_uWidth + x;
+
+                sceneFile << static_cast<CHAR>(m_aBlockTypes[uCellIdx]);
+                sceneFile << m_aHeights[uCellIdx] << ' ';
+            }
+            sceneFile << '\n';
+        }
+        sceneFile << std::endl;
+        sceneFile.close();
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::GetWidth
+
+      Summary:  Returns the number of cells along the x-axis
+
+      Returns:  UINT
+                  Width of the map
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TerrainGenerator::GetWidth() const
+    {
+        return m_uWidth;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::GetHeight
+
+      Summary:  Returns the maximum number of blocks in a column
+
+      Returns:  UINT
+                  Height of the map
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TerrainGenerator::GetHeight() const
+    {
+        return m_uHeight;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::GetDepth
+
+      Summary:  Returns the number of cells along the z-axis
+
+      Returns:  UINT
+                  Depth of the map
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TerrainGenerator::GetDepth() const
+    {
+        return m_uDepth;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::GetColors
+
+      Summary:  Returns the color of each block type
+
+      Returns:  const std::vector<XMFLOAT4>&
+                  Colors indexed from GRASSLAND
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<XMFLOAT4>& TerrainGenerator::GetColors() const
+    {
+        return m_aColors;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::GetHeights
+
+      Summary:  Returns the height grid, row-major along the x-axis
+
+      Returns:  const std::vector<FLOAT>&
+                  Height grid
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<FLOAT>& TerrainGenerator::GetHeights() const
+    {
+        return m_aHeights;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::GetMoistures
+
+      Summary:  Returns the moisture grid, row-major along the x-axis
+
+      Returns:  const std::vector<FLOAT>&
+                  Moisture grid
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<FLOAT>& TerrainGenerator::GetMoistures() const
+    {
+        return m_aMoistures;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::GetBlockTypes
+
+      Summary:  Returns the biome grid, row-major along the x-axis
+
+      Returns:  const std::vector<eBlockType>&
+                  Biome grid
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<eBlockType>& TerrainGenerator::GetBlockTypes() const
+    {
+        return m_aBlockTypes;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::getOctaveNoise
+
+      Summary:  Sums four octaves of perlin noise at the given cell
+
+      Args:     UINT x
+                  Cell index along the x-axis
+                UINT z
+                  Cell index along the z-axis
+
+      Returns:  FLOAT
+                  Normalized noise value
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT TerrainGenerator::getOctaveNoise(_In_ UINT x, _In_ UINT z)
+    {
+        FLOAT value = 0.0f;
+        FLOAT frequencySum = 0.0f;
+        for (UINT i = 0; i < 4; ++i)
+        {
+            FLOAT frequency = pow(2.0f, static_cast<FLOAT>(i));
+            frequencySum += 1.0f / frequency;
+            value += Scene::GetPerlin2d(frequency * static_cast<FLOAT>(x), frequency * static_cast<FLOAT>(z), 0.1f, 4u) / frequency;
+        }
+        value /= frequencySum;
+
+        return pow(value * 1.2f, 1.25f);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::generateTile
+
+      Summary:  Generates the cells of a single tile
+
+      Args:     UINT uTileIdx
+                  Index of the tile, row-major along the x-axis
+
+      Modifies: [m_aHeights, m_aMoistures, m_aBlockTypes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainGenerator::generateTile(_In_ UINT uTileIdx)
+    {
+        const UINT uBeginX = (uTileIdx % m_uNumTilesX) * TILE_SIZE;
+        const UINT uBeginZ = (uTileIdx / m_uNumTilesX) * TILE_SIZE;
+        const UINT uEndX = (std::min)(uBeginX + TILE_SIZE, m_uWidth);
+        const UINT uEndZ = (std::min)(uBeginZ + TILE_SIZE, m_uDepth);
+
+        for (UINT z = uBeginZ; z < uEndZ; ++z)
+        {
+            for (UINT x = uBeginX; x < uEndX; ++x)
+            {
+                const size_t uCellIdx = static_cast<size_t>(z) * m_uWidth + x;
+
+                FLOAT height = getOctaveNoise(x, z);
+                assert(height >= 0.0f);
+
+                // Moisture is sampled from the same octaves as the height
+                FLOAT moisture = height;
+
+                m_aHeights[uCellIdx] = height;
+                m_aMoistures[uCellIdx] = moisture;
+                m_aBlockTypes[uCellIdx] = GetBlockType(height, moisture);
+            }
+        }
+    }
+}
@@ -0,0 +1,91 @@
+/*+===================================================================
+  File:      TERRAINGENERATOR.H
+
+  Summary:   TerrainGenerator header file contains declarations of
+             TerrainGenerator class used for the lab samples of Game
+             Graphics Programming course.
+
+  Classes: TerrainGenerator
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    TerrainGenerator
+
+      Summary:  Generates the height, moisture and biome grids of the
+                voxel map in memory. The map is split into square tiles
+                that are processed by worker threads
+
+      Methods:  GetBlockType
+                  Classifies a cell into a biome
+                Generate
+                  Generates every grid of the map
+                ExportToFile
+                  Writes the generated map in the height map format
+                GetWidth
+                  Returns the width of the map
+                GetHeight
+                  Returns the maximum height of the map
+                GetDepth
+                  Returns the depth of the map
+                GetColors
+                  Returns the color of each block type
+                GetHeights
+                  Returns the height grid
+                GetMoistures
+                  Returns the moisture grid
+                GetBlockTypes
+                  Returns the biome grid
+                TerrainGenerator
+                  Constructor.
+                ~TerrainGenerator
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class TerrainGenerator
+    {
+    public:
+        static constexpr const UINT TILE_SIZE = 64u;
+
+        static eBlockType GetBlockType(_In_ FLOAT height, _In_ FLOAT moisture);
+
+        TerrainGenerator() = delete;
+        TerrainGenerator(_In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uDepth, _In_ const XMFLOAT4* aColors, _In_ UINT uNumColors);
+        TerrainGenerator(const TerrainGenerator& other) = delete;
+        TerrainGenerator(TerrainGenerator&& other) = delete;
+        TerrainGenerator& operator=(const TerrainGenerator& other) = delete;
+        TerrainGenerator& operator=(TerrainGenerator&& other) = delete;
+        ~TerrainGenerator() = default;
+
+        HRESULT Generate(_In_opt_ UINT uNumThreads = 0u);
+        HRESULT ExportToFile(_In_ const std::filesystem::path& filePath) const;
+
+        UINT GetWidth() const;
+        UINT GetHeight() const;
+        UINT GetDepth() const;
+        const std::vector<XMFLOAT4>& GetColors() const;
+        const std::vector<FLOAT>& GetHeights() const;
+        const std::vector<FLOAT>& GetMoistures() const;
+        const std::vector<eBlockType>& GetBlockTypes() const;
+
+    private:
+        static FLOAT getOctaveNoise(_In_ UINT x, _In_ UINT z);
+
+        void generateTile(_In_ UINT uTileIdx);
+
+    private:
+        UINT m_uWidth;
+        UINT m_uHeight;
+        UINT m_uDepth;
+        UINT m_uNumTilesX;
+        std::vector<XMFLOAT4> m_aColors;
+        std::vector<FLOAT> m_aHeights;
+        std::vector<FLOAT> m_aMoistures;
+        std::vector<eBlockType> m_aBlockTypes;
+    };
+}
@@ -6,26 +6,51 @@ namespace library
 {
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Voxel::Voxel
-      Summary:  Constructor
+      Summary:  Constructor of a voxel without instances yet. Every
+                block type gets the output color, as PSVoxel only
+                reads the block color table
       Args:     const XMFLOAT4& outputColor
                   Color of the voxel
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     Voxel::Voxel(_In_ const XMFLOAT4& outputColor)
-        :InstancedRenderable(outputColor)
+        :InstancedRenderable(std::vector<VoxelInstanceData>(), outputColor)
+        , m_cbBlockColors()
+        , m_aBlockColors(NUM_BLOCK_TYPES, outputColor)
     {
 
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Voxel::Voxel
-      Summary:  Constructor
-      Args:     std::vector<InstanceData>&& aInstanceData
-                  Instance data
+      Summary:  Constructor of a voxel of a single color. Every block
+                type gets the output color, as PSVoxel only reads the
+                block color table
+      Args:     std::vector<VoxelInstanceData>&& aInstanceData
+                  Compact instance data
                 const XMFLOAT4& outputColor
                   Color of the voxel
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    Voxel::Voxel(_In_ std::vector<InstanceData>&& aInstanceData, _In_ const XMFLOAT4& outputColor)
+    Voxel::Voxel(_In_ std::vector<VoxelInstanceData>&& aInstanceData, _In_ const XMFLOAT4& outputColor)
         :InstancedRenderable(std::move(aInstanceData), outputColor)
+        , m_cbBlockColors()
+        , m_aBlockColors(NUM_BLOCK_TYPES, outputColor)
+    {
+
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Voxel::Voxel
+      Summary:  Constructor of a voxel that holds every block type. The
+                color of each instance is looked up from its block type
+      Args:     std::vector<VoxelInstanceData>&& aInstanceData
+                  Compact instance data of every block type
+                const std::vector<XMFLOAT4>& aBlockColors
+                  Color of each block type, starting from GRASSLAND
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    Voxel::Voxel(_In_ std::vector<VoxelInstanceData>&& aInstanceData, _In_ const std::vector<XMFLOAT4>& aBlockColors)
+        :InstancedRenderable(std::move(aInstanceData), XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f))
+        , m_cbBlockColors()
+        , m_aBlockColors(aBlockColors)
     {
 
     }
@@ -49,6 +74,35 @@ namespace library
             return hr;
         }
 
+        //the pixel shader colors every instance from the table, so it always exists
+        CBBlockColors cbBlockColors = {};
+        for (size_t i = 0u; i < m_aBlockColors.size() && i < NUM_BLOCK_TYPES; ++i)
+        {
+            cbBlockColors.BlockColors[i] = m_aBlockColors[i];
+        }
+
+        D3D11_BUFFER_DESC bd =
+        {
+            .ByteWidth = sizeof(CBBlockColors),
+            .Usage = D3D11_USAGE_IMMUTABLE,
+            .BindFlags = D3D11_BIND_CONSTANT_BUFFER,
+            .CPUAccessFlags = 0,
+            .MiscFlags = 0,
+            .StructureByteStride = 0
+        };
+        D3D11_SUBRESOURCE_DATA initData =
+        {
+            .pSysMem = &cbBlockColors,
+            .SysMemPitch = 0,
+            .SysMemSlicePitch = 0
+        };
+
+        hr = pDevice->CreateBuffer(&bd, &initData, m_cbBlockColors.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
         if (HasTexture() > 0)
         {
             hr = SetMaterialOfMesh(0, 0);
@@ -71,6 +125,17 @@ namespace library
         UNREFERENCED_PARAMETER(deltaTime);
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Voxel::GetBlockColorsConstantBuffer
+      Summary:  Returns the constant buffer of the block colors
+      Returns:  ComPtr<ID3D11Buffer>&
+                  Constant buffer of the block colors
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ComPtr<ID3D11Buffer>& Voxel::GetBlockColorsConstantBuffer()
+    {
+        return m_cbBlockColors;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Voxel::GetNumVertices
       Summary:  Returns the number of vertices in the voxel
@@ -21,9 +21,12 @@ namespace library
     /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
       Class:    Voxel
 
-      Summary:  Base class for renderable 3d cube object
+      Summary:  Base class for renderable 3d cube object. Instances
+                always use the compact voxel layout
 
-      Methods:  Voxel
+      Methods:  GetBlockColorsConstantBuffer
+                  Returns the constant buffer of the block colors
+                Voxel
                   Constructor.
                 ~Voxel
                   Destructor.
@@ -32,7 +35,8 @@ namespace library
     {
     public:
         Voxel(_In_ const XMFLOAT4& outputColor);
-        Voxel(_In_ std::vector<InstanceData>&& aInstanceData, _In_ const XMFLOAT4& outputColor);
+        Voxel(_In_ std::vector<VoxelInstanceData>&& aInstanceData, _In_ const XMFLOAT4& outputColor);
+        Voxel(_In_ std::vector<VoxelInstanceData>&& aInstanceData, _In_ const std::vector<XMFLOAT4>& aBlockColors);
         Voxel(const Voxel& other) = delete;
         Voxel(Voxel&& other) = delete;
         Voxel& operator=(const Voxel& other) = delete;
@@ -42,6 +46,16 @@ namespace library
         virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext) override;
         virtual void Update(_In_ FLOAT deltaTime) override;
 
+        // VoxelVertexShader only reads the compact layout, so the matrix instances are hidden
+        using InstancedRenderable::SetInstanceData;
+        using InstancedRenderable::SetInstance;
+        using InstancedRenderable::AddInstance;
+        void SetInstanceData(_In_ std::vector<InstanceData>&& aInstanceData) = delete;
+        void SetInstance(_In_ UINT uIndex, _In_ const InstanceData& instanceData) = delete;
+        void AddInstance(_In_ const InstanceData& instanceData) = delete;
+
+        ComPtr<ID3D11Buffer>& GetBlockColorsConstantBuffer();
+
         UINT GetNumVertices() const override;
         UINT GetNumIndices() const override;
 
@@ -103,5 +117,9 @@ namespace library
             23,20,22
         };
         static constexpr const UINT NUM_INDICES = 36u;
+
+    protected:
+        ComPtr<ID3D11Buffer> m_cbBlockColors;
+        std::vector<XMFLOAT4> m_aBlockColors;
     };
 }
\ No newline at end of file
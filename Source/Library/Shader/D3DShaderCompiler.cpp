@@ -0,0 +1,67 @@
+#include "Shader/D3DShaderCompiler.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3DShaderCompiler::Compile
+
+      Summary:  Compiles an entry point of a shader source file
+
+      Args:     const std::filesystem::path& sourcePath
+                  Shader source file
+                PCSTR pszEntryPoint
+                  Name of the entry point function
+                PCSTR pszShaderModel
+                  Shader target to compile against
+                const std::vector<std::string>& aDefines
+                  Macros defined to 1
+                UINT uFlags
+                  D3DCOMPILE flags
+                std::vector<BYTE>& aBytecode
+                  Receives the compiled bytecode
+                std::string& errors
+                  Receives the warnings and errors of the compiler,
+                  or the status code when it failed without any
+
+      Returns:  bool
+                  false if the shader failed to compile
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    bool D3DShaderCompiler::Compile(_In_ const std::filesystem::path& sourcePath, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel, _In_ const std::vector<std::string>& aDefines, _In_ UINT uFlags, _Out_ std::vector<BYTE>& aBytecode, _Out_ std::string& errors)
+    {
+        aBytecode.clear();
+        errors.clear();
+
+        std::vector<D3D_SHADER_MACRO> aMacros;
+        aMacros.reserve(aDefines.size() + 1u);
+        for (const std::string& define : aDefines)
+        {
+            aMacros.push_back(D3D_SHADER_MACRO{ .Name = define.c_str(), .Definition = "1" });
+        }
+        aMacros.push_back(D3D_SHADER_MACRO{ .Name = nullptr, .Definition = nullptr });
+
+        ComPtr<ID3DBlob> pBlob;
+        ComPtr<ID3DBlob> pErrorBlob;
+        HRESULT hr = D3DCompileFromFile(sourcePath.c_str(), aMacros.data(), D3D_COMPILE_STANDARD_FILE_INCLUDE, pszEntryPoint, pszShaderModel, uFlags, 0u, pBlob.GetAddressOf(), pErrorBlob.GetAddressOf());
+
+        if (pErrorBlob)
+        {
+            errors.assign(static_cast<const CHAR*>(pErrorBlob->GetBufferPointer()), pErrorBlob->GetBufferSize());
+        }
+
+        if (FAILED(hr))
+        {
+            if (errors.empty())
+            {
+                CHAR szMessage[64];
+                sprintf_s(szMessage, "D3DCompileFromFile failed with 0x%08X", static_cast<UINT>(hr));
+                errors = szMessage;
+            }
+            return false;
+        }
+
+        const BYTE* pBytecode = static_cast<const BYTE*>(pBlob->GetBufferPointer());
+        aBytecode.assign(pBytecode, pBytecode + pBlob->GetBufferSize());
+
+        return true;
+    }
+}
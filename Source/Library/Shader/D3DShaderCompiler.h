@@ -0,0 +1,45 @@
+/*+===================================================================
+  File:      D3DSHADERCOMPILER.H
+
+  Summary:   D3DShaderCompiler header file contains declarations of
+             D3DShaderCompiler class used for the lab samples of Game
+             Graphics Programming course.
+
+  Classes: D3DShaderCompiler
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Shader/ShaderCompiler.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    D3DShaderCompiler
+
+      Summary:  Compiles with D3DCompileFromFile, resolving the
+                includes relative to the including file
+
+      Methods:  Compile
+                  Compiles an entry point of a shader source file
+                D3DShaderCompiler
+                  Constructor.
+                ~D3DShaderCompiler
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class D3DShaderCompiler final : public IShaderCompiler
+    {
+    public:
+        D3DShaderCompiler() = default;
+        D3DShaderCompiler(const D3DShaderCompiler& other) = delete;
+        D3DShaderCompiler(D3DShaderCompiler&& other) = delete;
+        D3DShaderCompiler& operator=(const D3DShaderCompiler& other) = delete;
+        D3DShaderCompiler& operator=(D3DShaderCompiler&& other) = delete;
+        ~D3DShaderCompiler() = default;
+
+        bool Compile(_In_ const std::filesystem::path& sourcePath, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel, _In_ const std::vector<std::string>& aDefines, _In_ UINT uFlags, _Out_ std::vector<BYTE>& aBytecode, _Out_ std::string& errors) override;
+    };
+}
@@ -15,61 +15,112 @@ namespace library
                 PCSTR pszShaderModel
                   Specifies the shader target or set of shader features
                   to compile against
+                UINT uFeatures
+                  FEATURE_* bits the source has variants for
 
-      Modifies: [m_pixelShader].
+      Modifies: [m_aPixelShaders].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    PixelShader::PixelShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel)
-        :Shader(pszFileName, pszEntryPoint, pszShaderModel)
-        , m_pixelShader(nullptr)
+    PixelShader::PixelShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel, _In_ UINT uFeatures)
+        :Shader(pszFileName, pszEntryPoint, pszShaderModel, uFeatures)
+        , m_aPixelShaders()
     {
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   PixelShader::Initialize
 
-      Summary:  Initializes the pixel shader
+      Summary:  Initializes the pixel shader of every variant
 
       Args:     ID3D11Device* pDevice
                   The Direct3D device to create the pixel shader
 
+      Modifies: [m_aPixelShaders].
+
       Returns:  HRESULT
                   Status code
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT PixelShader::Initialize(_In_ ID3D11Device* pDevice)
     {
-        //Compile the pixel shader
-        ComPtr<ID3DBlob> pPSBlob(nullptr);
+        for (UINT uVariant = 0u; uVariant < NUM_VARIANTS; ++uVariant)
+        {
+            if (!HasVariant(uVariant))
+            {
+                continue;
+            }
+
+            //Compile the pixel shader
+            ComPtr<ID3DBlob> pPSBlob(nullptr);
+
+            HRESULT hr = compile(pPSBlob.GetAddressOf(), uVariant);
+
+            if (FAILED(hr))
+            {
+                MessageBox(nullptr, L"Pixel Shader compile Error", L"Error", MB_OK);
+                return hr;
+            }
+
+            //Create the pixel shader
+            hr = pDevice->CreatePixelShader(pPSBlob->GetBufferPointer(), pPSBlob->GetBufferSize(), nullptr, m_aPixelShaders[uVariant].GetAddressOf());
+
+            if (FAILED(hr))
+            {
+                MessageBox(nullptr, L"Pixel Shader create Error", L"Error", MB_OK);
+                return hr;
+            }
+        }
+
+        return S_OK;
+    }
 
-        HRESULT hr = compile(pPSBlob.GetAddressOf());
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PixelShader::Reload
 
-        if (FAILED(hr))
+      Summary:  Initializes the pixel shader of every variant again
+                from the bytecode compiled since. The previous pixel
+                shaders are kept if any variant fails
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the pixel shader
+
+      Modifies: [m_aPixelShaders].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT PixelShader::Reload(_In_ ID3D11Device* pDevice)
+    {
+        ComPtr<ID3D11PixelShader> aPreviousPixelShaders[NUM_VARIANTS];
+        for (UINT uVariant = 0u; uVariant < NUM_VARIANTS; ++uVariant)
         {
-            MessageBox(nullptr, L"Pixel Shader compile Error", L"Error", MB_OK);
-            return hr;
+            aPreviousPixelShaders[uVariant].Swap(m_aPixelShaders[uVariant]);
         }
 
-        //Create the pixel shader
-        hr = pDevice->CreatePixelShader(pPSBlob->GetBufferPointer(), pPSBlob->GetBufferSize(), nullptr, m_pixelShader.GetAddressOf());
-
+        HRESULT hr = Initialize(pDevice);
         if (FAILED(hr))
         {
-            MessageBox(nullptr, L"Pixel Shader create Error", L"Error", MB_OK);
-            return hr;
+            for (UINT uVariant = 0u; uVariant < NUM_VARIANTS; ++uVariant)
+            {
+                m_aPixelShaders[uVariant].Swap(aPreviousPixelShaders[uVariant]);
+            }
         }
 
-        return S_OK;
+        return hr;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   PixelShader::GetPixelShader
 
-      Summary:  Returns the pixel shader
+      Summary:  Returns the pixel shader of the variant drawing a set
+                of features
+
+      Args:     UINT uFeatures
+                  FEATURE_* bits of what is drawn
 
       Returns:  ComPtr<ID3D11PixelShader>&
                   Pixel shader. Could be a nullptr
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    ComPtr<ID3D11PixelShader>& PixelShader::GetPixelShader()
+    ComPtr<ID3D11PixelShader>& PixelShader::GetPixelShader(_In_ UINT uFeatures)
     {
-        return m_pixelShader;
+        return m_aPixelShaders[GetVariant(uFeatures)];
     }
 }
@@ -20,12 +20,16 @@ namespace library
     /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
       Class:    PixelShader
 
-      Summary:  Pixel shader
+      Summary:  Pixel shader, with one D3D11 pixel shader per variant
 
       Methods:  Initialize
                   Initializes and compiles the pixel shader
+                Reload
+                  Initializes the pixel shader again, keeping the
+                  previous one on failure
                 GetPixelShader
-                  Returns the reference to the D3D11 pixel shader
+                  Returns the reference to the D3D11 pixel shader of
+                  the variant drawing a set of features
                 Game
                   Constructor.
                 ~Game
@@ -35,7 +39,7 @@ namespace library
     {
     public:
         PixelShader() = delete;
-        PixelShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel);
+        PixelShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel, _In_ UINT uFeatures = 0u);
         PixelShader(const PixelShader& other) = delete;
         PixelShader(PixelShader&& other) = delete;
         PixelShader& operator=(const PixelShader& other) = delete;
@@ -43,10 +47,11 @@ namespace library
         virtual ~PixelShader() = default;
 
         virtual HRESULT Initialize(_In_ ID3D11Device* pDevice) override;
+        HRESULT Reload(_In_ ID3D11Device* pDevice) override;
 
-        ComPtr<ID3D11PixelShader>& GetPixelShader();
+        ComPtr<ID3D11PixelShader>& GetPixelShader(_In_ UINT uFeatures = 0u);
 
     protected:
-        ComPtr<ID3D11PixelShader> m_pixelShader;
+        ComPtr<ID3D11PixelShader> m_aPixelShaders[NUM_VARIANTS];
     };
 }
\ No newline at end of file
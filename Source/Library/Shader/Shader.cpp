@@ -1,7 +1,11 @@
 #include "Shader.h"
 
+#include "Shader/D3DShaderCompiler.h"
+
 namespace library
 {
+    std::shared_ptr<IShaderCompiler> Shader::ms_compiler = std::make_shared<D3DShaderCompiler>();
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Shader::Shader
 
@@ -15,43 +19,81 @@ namespace library
               PCSTR pszShaderModel
                   Specifies the shader target or set of shader features
                   to compile against
+              UINT uFeatures
+                  FEATURE_* bits the source has variants for
 
-      Modifies: [m_pszFileName, m_pszEntryPoint, m_pszShaderModel].
+      Modifies: [m_pszFileName, m_pszEntryPoint, m_pszShaderModel,
+                 m_uFeatures, m_aCompiledBlobs, m_aCompileErrors].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    Shader::Shader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel)
+    Shader::Shader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel, _In_ UINT uFeatures)
         :m_pszFileName(pszFileName)
         ,m_pszEntryPoint(pszEntryPoint)
         ,m_pszShaderModel(pszShaderModel)
+        ,m_uFeatures(uFeatures & (NUM_VARIANTS - 1u))
+        ,m_aCompiledBlobs()
+        ,m_aCompileErrors()
     {
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Shader::GetFileName
+      Method:   Shader::Compile
 
-      Summary:  Returns the shader file name
+      Summary:  Compiles a variant with the compiler shared by every
+                shader and keeps the bytecode for Initialize. Touches
+                no device object, so shaders and the variants of a
+                shader can compile on several threads at the same time
 
-      Returns:  PCWSTR
-                  Shader file name
+      Args:     UINT uVariant
+                  Feature bits of the variant
+
+      Modifies: [m_aCompiledBlobs, m_aCompileErrors].
+
+      Returns:  HRESULT
+                  Status code
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    PCWSTR Shader::GetFileName() const
+    HRESULT Shader::Compile(_In_ UINT uVariant)
     {
-        return m_pszFileName;
+        if (!HasVariant(uVariant))
+        {
+            return E_INVALIDARG;
+        }
+
+        ComPtr<ID3DBlob>& compiledBlob = m_aCompiledBlobs[uVariant];
+        compiledBlob.Reset();
+
+        return CompileBlob(uVariant, compiledBlob.GetAddressOf(), m_aCompileErrors[uVariant]);
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Shader::compile
+      Method:   Shader::CompileBlob
 
-      Summary:  Compiles the given shader file
+      Summary:  Compiles a variant with the compiler shared by every
+                shader, leaving the shader as is. The shader can keep
+                drawing on another thread meanwhile, and take the
+                bytecode later with SetCompiledBlob
 
-      Args:     ID3DBlob** ppOutBlob
-                  Receives a pointer to the ID3DBlob interface that you
-                  can use to access the compiled code
+      Args:     UINT uVariant
+                  Feature bits of the variant
+                ID3DBlob** ppOutBlob
+                  Receives the bytecode, nullptr on failure
+                std::string& errors
+                  Receives the errors and warnings of the compiler
+
+      Modifies: [ppOutBlob, errors].
 
       Returns:  HRESULT
                   Status code
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    HRESULT Shader::compile(_Outptr_ ID3DBlob** ppOutBlob)
+    HRESULT Shader::CompileBlob(_In_ UINT uVariant, _Outptr_result_maybenull_ ID3DBlob** ppOutBlob, _Out_ std::string& errors) const
     {
+        *ppOutBlob = nullptr;
+        errors.clear();
+
+        if (!HasVariant(uVariant))
+        {
+            return E_INVALIDARG;
+        }
+
         HRESULT hr = S_OK;
         DWORD dwShaderFlags = D3DCOMPILE_ENABLE_STRICTNESS;
 
@@ -60,17 +102,198 @@ namespace library
         dwShaderFlags |= D3DCOMPILE_SKIP_OPTIMIZATION;
 #endif     
 
-        ComPtr<ID3DBlob> pErrorBlob(nullptr);
-        hr = D3DCompileFromFile(m_pszFileName, nullptr, nullptr, m_pszEntryPoint, m_pszShaderModel, dwShaderFlags, 0u, ppOutBlob, pErrorBlob.GetAddressOf());
+        std::vector<std::string> aDefines;
+        for (UINT uFeature = 0u; uFeature < NUM_FEATURES; ++uFeature)
+        {
+            if (uVariant & (1u << uFeature))
+            {
+                aDefines.push_back(ms_apszFeatureDefines[uFeature]);
+            }
+        }
+
+        std::vector<BYTE> aBytecode;
+        if (!ms_compiler->Compile(m_pszFileName, m_pszEntryPoint, m_pszShaderModel, aDefines, dwShaderFlags, aBytecode, errors))
+            return E_FAIL;
+
+        ComPtr<ID3DBlob> compiledBlob;
+        hr = D3DCreateBlob(aBytecode.size(), compiledBlob.GetAddressOf());
 
         if (FAILED(hr))
             return hr;
 
-        /*if (pErrorBlob)
+        memcpy(compiledBlob->GetBufferPointer(), aBytecode.data(), aBytecode.size());
+        *ppOutBlob = compiledBlob.Detach();
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Shader::SetCompiledBlob
+
+      Summary:  Keeps the bytecode of a variant compiled by CompileBlob
+                for the next Initialize or Reload. Must not be called
+                while the shader is being initialized
+
+      Args:     UINT uVariant
+                  Feature bits of the variant
+                const ComPtr<ID3DBlob>& compiledBlob
+                  Bytecode of the variant
+
+      Modifies: [m_aCompiledBlobs].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Shader::SetCompiledBlob(_In_ UINT uVariant, _In_ const ComPtr<ID3DBlob>& compiledBlob)
+    {
+        if (!HasVariant(uVariant))
         {
-            pErrorBlob.Reset();
-            return hr;
-        }*/
+            return;
+        }
+
+        m_aCompiledBlobs[uVariant] = compiledBlob;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Shader::GetFileName
+
+      Summary:  Returns the shader file name
+
+      Returns:  PCWSTR
+                  Shader file name
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    PCWSTR Shader::GetFileName() const
+    {
+        return m_pszFileName;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Shader::GetEntryPoint
+
+      Summary:  Returns the name of the entry point
+
+      Returns:  PCSTR
+                  Entry point name
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    PCSTR Shader::GetEntryPoint() const
+    {
+        return m_pszEntryPoint;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Shader::GetFeatures
+
+      Summary:  Returns the features the shader has variants for
+
+      Returns:  UINT
+                  FEATURE_* bits
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Shader::GetFeatures() const
+    {
+        return m_uFeatures;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Shader::GetVariant
+
+      Summary:  Returns the variant drawing a set of features. The
+                features the shader has no variants for are dropped
+
+      Args:     UINT uFeatures
+                  FEATURE_* bits of what is drawn
+
+      Returns:  UINT
+                  Feature bits of the variant
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Shader::GetVariant(_In_ UINT uFeatures) const
+    {
+        return uFeatures & m_uFeatures;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Shader::HasVariant
+
+      Summary:  Returns whether a variant exists, that is whether the
+                shader has variants for all of its features
+
+      Args:     UINT uVariant
+                  Feature bits of the variant
+
+      Returns:  BOOL
+                  TRUE if the variant exists
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL Shader::HasVariant(_In_ UINT uVariant) const
+    {
+        return uVariant < NUM_VARIANTS && (uVariant & ~m_uFeatures) == 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Shader::GetCompileErrors
+
+      Summary:  Returns the errors and warnings of the last
+                compilation of a variant, empty when its bytecode came
+                from the shader cache
+
+      Args:     UINT uVariant
+                  Feature bits of the variant
+
+      Returns:  const std::string&
+                  Compiler messages
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::string& Shader::GetCompileErrors(_In_ UINT uVariant) const
+    {
+        return m_aCompileErrors[uVariant];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Shader::SetCompiler
+
+      Summary:  Sets the compiler every shader compiles with, a
+                ShaderCache to keep the bytecode across launches.
+                Must be called before the shaders are initialized
+
+      Args:     const std::shared_ptr<IShaderCompiler>& compiler
+                  Compiler shared by every shader
+
+      Modifies: [ms_compiler].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Shader::SetCompiler(_In_ const std::shared_ptr<IShaderCompiler>& compiler)
+    {
+        ms_compiler = compiler;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Shader::compile
+
+      Summary:  Hands over the bytecode of a variant kept by Compile,
+                compiling the variant first if Compile was not called
+
+      Args:     ID3DBlob** ppOutBlob
+                  Receives a pointer to the ID3DBlob interface that you
+                  can use to access the compiled code
+                UINT uVariant
+                  Feature bits of the variant
+
+      Modifies: [m_aCompiledBlobs, m_aCompileErrors].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Shader::compile(_Outptr_ ID3DBlob** ppOutBlob, _In_ UINT uVariant)
+    {
+        if (!HasVariant(uVariant))
+        {
+            return E_INVALIDARG;
+        }
+
+        if (!m_aCompiledBlobs[uVariant])
+        {
+            HRESULT hr = Compile(uVariant);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        // Initialize does not need the bytecode after creating the shader
+        *ppOutBlob = m_aCompiledBlobs[uVariant].Detach();
 
         return S_OK;
     }
@@ -13,29 +13,67 @@
 
 #include "Common.h"
 
+#include "Shader/ShaderCompiler.h"
+
 namespace library
 {
     /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
-      Class:    PixelShader
+      Class:    Shader
+
+      Summary:  Shader compiled from a file by the compiler shared by
+                every shader. Compile may run on any thread ahead of
+                Initialize, which then only creates the device objects
+                from the bytecode kept in between
 
-      Summary:  Pixel shader
+                A shader lists the features its source selects with
+                #if instead of branching on constants. Every subset of
+                them is a variant, compiled with the define of each of
+                its features set to 1, and indexed by its feature bits
 
       Methods:  Initialize
                   Pure virtual function that initializes the shader
+                Reload
+                  Pure virtual function that initializes the shader
+                  again, keeping the previous device objects on failure
+                Compile
+                  Compiles a variant and keeps its bytecode
+                CompileBlob
+                  Compiles a variant without keeping its bytecode
+                SetCompiledBlob
+                  Keeps bytecode compiled ahead for a variant
                 GetFileName
                   Returns the name of the shader file to be compiled
+                GetEntryPoint
+                  Returns the name of the entry point
+                GetFeatures
+                  Returns the features the shader has variants for
+                GetVariant
+                  Returns the variant drawing a set of features
+                HasVariant
+                  Returns whether a variant exists
+                GetCompileErrors
+                  Returns the messages of the last compilation of a
+                  variant
+                SetCompiler
+                  Sets the compiler shared by every shader
                 compile
-                  Compiles the given shader file
-                Game
+                  Hands over the bytecode of a variant
+                Shader
                   Constructor.
-                ~Game
+                ~Shader
                   Destructor.
     C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
     class Shader
     {
     public:
+        // Samples aTextures[1] as a tangent space normal map, HAS_NORMAL_MAP in the source
+        static constexpr const UINT FEATURE_NORMAL_MAP = 1u << 0u;
+
+        static constexpr const UINT NUM_FEATURES = 1u;
+        static constexpr const UINT NUM_VARIANTS = 1u << NUM_FEATURES;
+
         Shader() = delete;
-        Shader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel);
+        Shader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel, _In_ UINT uFeatures = 0u);
         Shader(const Shader& other) = delete;
         Shader(Shader&& other) = delete;
         Shader& operator=(const Shader& other) = delete;
@@ -43,13 +81,34 @@ namespace library
         virtual ~Shader() = default;
 
         virtual HRESULT Initialize(_In_ ID3D11Device* pDevice) = 0;
+        virtual HRESULT Reload(_In_ ID3D11Device* pDevice) = 0;
+        HRESULT Compile(_In_ UINT uVariant);
+        HRESULT CompileBlob(_In_ UINT uVariant, _Outptr_result_maybenull_ ID3DBlob** ppOutBlob, _Out_ std::string& errors) const;
+        void SetCompiledBlob(_In_ UINT uVariant, _In_ const ComPtr<ID3DBlob>& compiledBlob);
         PCWSTR GetFileName() const;
+        PCSTR GetEntryPoint() const;
+        UINT GetFeatures() const;
+        UINT GetVariant(_In_ UINT uFeatures) const;
+        BOOL HasVariant(_In_ UINT uVariant) const;
+        const std::string& GetCompileErrors(_In_ UINT uVariant) const;
+
+        static void SetCompiler(_In_ const std::shared_ptr<IShaderCompiler>& compiler);
 
     protected:
-        HRESULT compile(_Outptr_ ID3DBlob** ppOutBlob);
+        HRESULT compile(_Outptr_ ID3DBlob** ppOutBlob, _In_ UINT uVariant = 0u);
 
         PCWSTR m_pszFileName;
         PCSTR m_pszEntryPoint;
         PCSTR m_pszShaderModel;
+        UINT m_uFeatures;
+        ComPtr<ID3DBlob> m_aCompiledBlobs[NUM_VARIANTS];
+        std::string m_aCompileErrors[NUM_VARIANTS];
+
+        static std::shared_ptr<IShaderCompiler> ms_compiler;
+
+        static constexpr const PCSTR ms_apszFeatureDefines[NUM_FEATURES] =
+        {
+            "HAS_NORMAL_MAP",
+        };
     };
 }
\ No newline at end of file
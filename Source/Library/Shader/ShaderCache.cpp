@@ -0,0 +1,503 @@
+#include "Shader/ShaderCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderCache::ShaderCache
+
+      Summary:  Constructor
+
+      Args:     const std::filesystem::path& directory
+                  Directory the entries are kept in, created on the
+                  first store
+                const std::shared_ptr<IShaderCompiler>& compiler
+                  Compiler called on a miss
+
+      Modifies: [m_directory, m_compiler, m_uNumHits, m_uNumMisses,
+                 m_uNumCorrupt, m_uNumTemporaryFiles].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ShaderCache::ShaderCache(const std::filesystem::path& directory, const std::shared_ptr<IShaderCompiler>& compiler)
+        : m_directory(directory)
+        , m_compiler(compiler)
+        , m_uNumHits(0u)
+        , m_uNumMisses(0u)
+        , m_uNumCorrupt(0u)
+        , m_uNumTemporaryFiles(0u)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderCache::Compile
+
+      Summary:  Loads the bytecode of an entry point from the cache,
+                or compiles it and stores it. Failing to store is not
+                an error, the bytecode is still returned
+
+      Args:     const std::filesystem::path& sourcePath
+                  Shader source file
+                const char* pszEntryPoint
+                  Name of the entry point function
+                const char* pszShaderModel
+                  Shader target to compile against
+                const std::vector<std::string>& aDefines
+                  Macros defined to 1
+                uint32_t uFlags
+                  Compile flags
+                std::vector<uint8_t>& aBytecode
+                  Receives the bytecode
+                std::string& errors
+                  Receives the messages of the compiler on a miss
+
+      Modifies: [m_uNumHits, m_uNumMisses, m_uNumCorrupt].
+
+      Returns:  bool
+                  false if the shader failed to compile
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    bool ShaderCache::Compile(const std::filesystem::path& sourcePath, const char* pszEntryPoint, const char* pszShaderModel, const std::vector<std::string>& aDefines, uint32_t uFlags, std::vector<uint8_t>& aBytecode, std::string& errors)
+    {
+        errors.clear();
+
+        if (!m_compiler)
+        {
+            errors = "The shader cache has no compiler";
+            return false;
+        }
+
+        uint64_t uKey = computeKey(sourcePath, pszEntryPoint, pszShaderModel, aDefines, uFlags);
+        std::filesystem::path entryPath = getEntryPath(sourcePath, pszEntryPoint, uKey);
+
+        if (load(entryPath, uKey, aBytecode))
+        {
+            ++m_uNumHits;
+            return true;
+        }
+
+        ++m_uNumMisses;
+
+        if (!m_compiler->Compile(sourcePath, pszEntryPoint, pszShaderModel, aDefines, uFlags, aBytecode, errors))
+        {
+            return false;
+        }
+
+        store(entryPath, uKey, aBytecode);
+
+        return true;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderCache::GetDirectory
+
+      Summary:  Returns the directory of the entries
+
+      Returns:  const std::filesystem::path&
+                  Directory of the entries
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::filesystem::path& ShaderCache::GetDirectory() const
+    {
+        return m_directory;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderCache::GetNumHits
+
+      Summary:  Returns the number of entries loaded from the cache
+
+      Returns:  uint32_t
+                  Number of hits
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t ShaderCache::GetNumHits() const
+    {
+        return m_uNumHits.load();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderCache::GetNumMisses
+
+      Summary:  Returns the number of entries that had to be compiled
+
+      Returns:  uint32_t
+                  Number of misses
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t ShaderCache::GetNumMisses() const
+    {
+        return m_uNumMisses.load();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderCache::GetNumCorrupt
+
+      Summary:  Returns the number of entries found corrupt and deleted
+
+      Returns:  uint32_t
+                  Number of corrupt entries
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t ShaderCache::GetNumCorrupt() const
+    {
+        return m_uNumCorrupt.load();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderCache::FindDependencies
+
+      Summary:  Returns the files the compiled bytecode of a source
+                depends on: the source first, then every file it
+                includes, directly or not
+
+      Args:     const std::filesystem::path& sourcePath
+                  Shader source file
+                std::vector<std::filesystem::path>& aDependencies
+                  Receives the files
+
+      Modifies: [aDependencies].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ShaderCache::FindDependencies(const std::filesystem::path& sourcePath, std::vector<std::filesystem::path>& aDependencies)
+    {
+        aDependencies.clear();
+
+        std::unordered_set<std::wstring> visited;
+        findDependencies(sourcePath, visited, aDependencies);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderCache::computeKey
+
+      Summary:  Hashes everything the bytecode depends on: the layout
+                version, the sources, the entry point, the shader
+                model, the defines and the flags
+
+      Args:     const std::filesystem::path& sourcePath
+                  Shader source file
+                const char* pszEntryPoint
+                  Name of the entry point function
+                const char* pszShaderModel
+                  Shader target
+                const std::vector<std::string>& aDefines
+                  Macros defined to 1
+                uint32_t uFlags
+                  Compile flags
+
+      Returns:  uint64_t
+                  Key of the entry
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint64_t ShaderCache::computeKey(const std::filesystem::path& sourcePath, const char* pszEntryPoint, const char* pszShaderModel, const std::vector<std::string>& aDefines, uint32_t uFlags) const
+    {
+        uint64_t uHash = FNV_OFFSET_BASIS;
+        uHash = hashBytes(&VERSION, sizeof(VERSION), uHash);
+
+        std::vector<std::filesystem::path> aDependencies;
+        FindDependencies(sourcePath, aDependencies);
+        for (const std::filesystem::path& dependency : aDependencies)
+        {
+            hashFile(dependency, uHash);
+        }
+
+        // The terminators keep "ab" + "c" apart from "a" + "bc"
+        uHash = hashBytes(pszEntryPoint, strlen(pszEntryPoint) + 1u, uHash);
+        uHash = hashBytes(pszShaderModel, strlen(pszShaderModel) + 1u, uHash);
+        uint64_t uNumDefines = aDefines.size();
+        uHash = hashBytes(&uNumDefines, sizeof(uNumDefines), uHash);
+        for (const std::string& define : aDefines)
+        {
+            uHash = hashBytes(define.c_str(), define.size() + 1u, uHash);
+        }
+        uHash = hashBytes(&uFlags, sizeof(uFlags), uHash);
+
+        return uHash;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderCache::hashFile
+
+      Summary:  Hashes the name and the contents of a file. A file that
+                cannot be read is hashed as missing, so creating it
+                later changes the key
+
+      Args:     const std::filesystem::path& filePath
+                  File to hash
+                uint64_t& uHash
+                  Hash to fold the file into
+
+      Modifies: [uHash].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ShaderCache::hashFile(const std::filesystem::path& filePath, uint64_t& uHash)
+    {
+        std::string name = filePath.filename().string();
+        uHash = hashBytes(name.c_str(), name.size() + 1u, uHash);
+
+        std::ifstream file(filePath, std::ios::binary);
+        if (!file)
+        {
+            static constexpr const char MISSING[] = "<missing>";
+            uHash = hashBytes(MISSING, sizeof(MISSING), uHash);
+            return;
+        }
+
+        std::ostringstream stream;
+        stream << file.rdbuf();
+        std::string contents = stream.str();
+
+        uint64_t uSize = contents.size();
+        uHash = hashBytes(&uSize, sizeof(uSize), uHash);
+        uHash = hashBytes(contents.data(), contents.size(), uHash);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderCache::findDependencies
+
+      Summary:  Appends a source file, then the files its #include
+                lines name, resolved relative to it, depth first. A
+                file is appended once however often it is included.
+                A file that cannot be read is still appended, it just
+                includes nothing
+
+      Args:     const std::filesystem::path& sourcePath
+                  Source file
+                std::unordered_set<std::wstring>& visited
+                  Files appended so far
+                std::vector<std::filesystem::path>& aDependencies
+                  Files the source depends on
+
+      Modifies: [visited, aDependencies].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ShaderCache::findDependencies(const std::filesystem::path& sourcePath, std::unordered_set<std::wstring>& visited, std::vector<std::filesystem::path>& aDependencies)
+    {
+        std::error_code ec;
+        std::filesystem::path canonicalPath = std::filesystem::weakly_canonical(sourcePath, ec);
+        if (ec)
+        {
+            canonicalPath = sourcePath.lexically_normal();
+        }
+
+        if (!visited.insert(canonicalPath.wstring()).second)
+        {
+            return;
+        }
+
+        aDependencies.push_back(sourcePath);
+
+        std::ifstream file(sourcePath, std::ios::binary);
+        if (!file)
+        {
+            return;
+        }
+
+        std::ostringstream stream;
+        stream << file.rdbuf();
+        std::string source = stream.str();
+
+        size_t uLineStart = 0u;
+        while (uLineStart < source.size())
+        {
+            size_t uLineEnd = source.find('\n', uLineStart);
+            if (uLineEnd == std::string::npos)
+            {
+                uLineEnd = source.size();
+            }
+
+            size_t i = source.find_first_not_of(" \t", uLineStart);
+            if (i < uLineEnd && source[i] == '#')
+            {
+                i = source.find_first_not_of(" \t", i + 1u);
+                if (i < uLineEnd && source.compare(i, 7u, "include") == 0)
+                {
+                    i = source.find_first_not_of(" \t", i + 7u);
+                    if (i < uLineEnd && (source[i] == '"' || source[i] == '<'))
+                    {
+                        char closing = source[i] == '"' ? '"' : '>';
+                        size_t uNameEnd = source.find(closing, i + 1u);
+                        if (uNameEnd < uLineEnd)
+                        {
+                            std::filesystem::path includePath = sourcePath.parent_path() / source.substr(i + 1u, uNameEnd - i - 1u);
+                            findDependencies(includePath, visited, aDependencies);
+                        }
+                    }
+                }
+            }
+
+            uLineStart = uLineEnd + 1u;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderCache::getEntryPath
+
+      Summary:  Returns the file of an entry, named after the source
+                and the entry point so the directory stays readable
+
+      Args:     const std::filesystem::path& sourcePath
+                  Shader source file
+                const char* pszEntryPoint
+                  Name of the entry point function
+                uint64_t uKey
+                  Key of the entry
+
+      Returns:  std::filesystem::path
+                  File of the entry
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::filesystem::path ShaderCache::getEntryPath(const std::filesystem::path& sourcePath, const char* pszEntryPoint, uint64_t uKey) const
+    {
+        char szKey[17];
+        snprintf(szKey, sizeof(szKey), "%016llx", static_cast<unsigned long long>(uKey));
+
+        std::filesystem::path fileName = sourcePath.stem();
+        fileName += "_";
+        fileName += pszEntryPoint;
+        fileName += "_";
+        fileName += szKey;
+        fileName += ".cso";
+
+        return m_directory / fileName;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderCache::load
+
+      Summary:  Reads an entry and checks its header and checksum. An
+                entry that does not match is deleted
+
+      Args:     const std::filesystem::path& entryPath
+                  File of the entry
+                uint64_t uKey
+                  Key the entry must have
+                std::vector<uint8_t>& aBytecode
+                  Receives the bytecode
+
+      Modifies: [m_uNumCorrupt].
+
+      Returns:  bool
+                  true if the entry was valid
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    bool ShaderCache::load(const std::filesystem::path& entryPath, uint64_t uKey, std::vector<uint8_t>& aBytecode)
+    {
+        aBytecode.clear();
+
+        std::error_code ec;
+        uint64_t uFileSize = std::filesystem::file_size(entryPath, ec);
+        if (ec)
+        {
+            return false;
+        }
+
+        bool bValid = false;
+        {
+            std::ifstream file(entryPath, std::ios::binary);
+            EntryHeader header = {};
+            if (file && uFileSize >= sizeof(header) && file.read(reinterpret_cast<char*>(&header), sizeof(header))
+                && header.uMagic == MAGIC
+                && header.uVersion == VERSION
+                && header.uKey == uKey
+                && header.uBytecodeSize == uFileSize - sizeof(header))
+            {
+                aBytecode.resize(static_cast<size_t>(header.uBytecodeSize));
+                bValid = file.read(reinterpret_cast<char*>(aBytecode.data()), static_cast<std::streamsize>(aBytecode.size()))
+                    && hashBytes(aBytecode.data(), aBytecode.size(), FNV_OFFSET_BASIS) == header.uChecksum;
+            }
+        }
+
+        if (!bValid)
+        {
+            aBytecode.clear();
+            ++m_uNumCorrupt;
+            std::filesystem::remove(entryPath, ec);
+        }
+
+        return bValid;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderCache::store
+
+      Summary:  Writes an entry to a temporary file unique to the call
+                and renames it over the entry, so readers see either
+                the old entry, no entry or the whole new one
+
+      Args:     const std::filesystem::path& entryPath
+                  File of the entry
+                uint64_t uKey
+                  Key of the entry
+                const std::vector<uint8_t>& aBytecode
+                  Bytecode of the entry
+
+      Modifies: [m_uNumTemporaryFiles].
+
+      Returns:  bool
+                  false if the entry could not be written
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    bool ShaderCache::store(const std::filesystem::path& entryPath, uint64_t uKey, const std::vector<uint8_t>& aBytecode)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(m_directory, ec);
+        if (ec)
+        {
+            return false;
+        }
+
+        std::ostringstream suffix;
+        suffix << ".tmp" << std::this_thread::get_id() << "_" << m_uNumTemporaryFiles++;
+        std::filesystem::path temporaryPath = entryPath;
+        temporaryPath += suffix.str();
+
+        EntryHeader header =
+        {
+            .uMagic = MAGIC,
+            .uVersion = VERSION,
+            .uKey = uKey,
+            .uBytecodeSize = aBytecode.size(),
+            .uChecksum = hashBytes(aBytecode.data(), aBytecode.size(), FNV_OFFSET_BASIS),
+        };
+
+        bool bWritten = false;
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            bWritten = file.write(reinterpret_cast<const char*>(&header), sizeof(header))
+                && file.write(reinterpret_cast<const char*>(aBytecode.data()), static_cast<std::streamsize>(aBytecode.size()))
+                && file.flush();
+        }
+
+        if (bWritten)
+        {
+            std::filesystem::rename(temporaryPath, entryPath, ec);
+        }
+
+        if (!bWritten || ec)
+        {
+            std::filesystem::remove(temporaryPath, ec);
+            return false;
+        }
+
+        return true;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderCache::hashBytes
+
+      Summary:  Folds bytes into a 64-bit FNV-1a hash
+
+      Args:     const void* pData
+                  Bytes to hash
+                size_t uSize
+                  Number of bytes
+                uint64_t uHash
+                  Hash so far, FNV_OFFSET_BASIS to start
+
+      Returns:  uint64_t
+                  Hash including the bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint64_t ShaderCache::hashBytes(const void* pData, size_t uSize, uint64_t uHash)
+    {
+        const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+        for (size_t i = 0u; i < uSize; ++i)
+        {
+            uHash ^= pBytes[i];
+            uHash *= FNV_PRIME;
+        }
+
+        return uHash;
+    }
+}
@@ -0,0 +1,128 @@
+/*+===================================================================
+  File:      SHADERCACHE.H
+
+  Summary:   ShaderCache header file contains declarations of
+             ShaderCache class used for the lab samples of Game
+             Graphics Programming course. Only depends on the
+             standard library.
+
+  Classes: ShaderCache
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "Shader/ShaderCompiler.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ShaderCache
+
+      Summary:  Keeps the bytecode compiled by another compiler in a
+                directory across launches. An entry is keyed by a hash
+                of the source, of every file it includes, the entry
+                point, the shader model, the defines and the flags, so
+                editing any of them compiles again. Entries are written to a
+                temporary file first and renamed, so a crash never
+                leaves half an entry behind, and an entry whose header
+                or checksum does not match is deleted and compiled
+                again
+
+      Methods:  Compile
+                  Loads the bytecode of an entry point or compiles it
+                GetDirectory
+                  Returns the directory of the entries
+                GetNumHits
+                  Returns the number of entries loaded
+                GetNumMisses
+                  Returns the number of entries compiled
+                GetNumCorrupt
+                  Returns the number of entries found corrupt
+                FindDependencies
+                  Returns a source file and the files it includes
+                computeKey
+                  Hashes everything the bytecode depends on
+                hashFile
+                  Hashes the name and the contents of a file
+                findDependencies
+                  Appends a source file and the files it includes
+                getEntryPath
+                  Returns the file of an entry
+                load
+                  Reads and validates an entry
+                store
+                  Writes an entry atomically
+                hashBytes
+                  Folds bytes into a 64-bit FNV-1a hash
+                ShaderCache
+                  Constructor.
+                ~ShaderCache
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ShaderCache final : public IShaderCompiler
+    {
+    public:
+        static constexpr const uint32_t MAGIC = 0x48534743u; // 'CGSH'
+
+        // Bumped whenever the key or the entry layout changes, so older entries miss
+        static constexpr const uint32_t VERSION = 2u;
+
+        static constexpr const uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+        static constexpr const uint64_t FNV_PRIME = 0x100000001b3ull;
+
+        ShaderCache() = delete;
+        ShaderCache(const std::filesystem::path& directory, const std::shared_ptr<IShaderCompiler>& compiler);
+        ShaderCache(const ShaderCache& other) = delete;
+        ShaderCache(ShaderCache&& other) = delete;
+        ShaderCache& operator=(const ShaderCache& other) = delete;
+        ShaderCache& operator=(ShaderCache&& other) = delete;
+        ~ShaderCache() = default;
+
+        bool Compile(const std::filesystem::path& sourcePath, const char* pszEntryPoint, const char* pszShaderModel, const std::vector<std::string>& aDefines, uint32_t uFlags, std::vector<uint8_t>& aBytecode, std::string& errors) override;
+
+        const std::filesystem::path& GetDirectory() const;
+        uint32_t GetNumHits() const;
+        uint32_t GetNumMisses() const;
+        uint32_t GetNumCorrupt() const;
+
+        static void FindDependencies(const std::filesystem::path& sourcePath, std::vector<std::filesystem::path>& aDependencies);
+
+    private:
+        struct EntryHeader
+        {
+            uint32_t uMagic;
+            uint32_t uVersion;
+            uint64_t uKey;
+            uint64_t uBytecodeSize;
+            uint64_t uChecksum;
+        };
+
+    private:
+        uint64_t computeKey(const std::filesystem::path& sourcePath, const char* pszEntryPoint, const char* pszShaderModel, const std::vector<std::string>& aDefines, uint32_t uFlags) const;
+        std::filesystem::path getEntryPath(const std::filesystem::path& sourcePath, const char* pszEntryPoint, uint64_t uKey) const;
+        bool load(const std::filesystem::path& entryPath, uint64_t uKey, std::vector<uint8_t>& aBytecode);
+        bool store(const std::filesystem::path& entryPath, uint64_t uKey, const std::vector<uint8_t>& aBytecode);
+
+        static void hashFile(const std::filesystem::path& filePath, uint64_t& uHash);
+        static void findDependencies(const std::filesystem::path& sourcePath, std::unordered_set<std::wstring>& visited, std::vector<std::filesystem::path>& aDependencies);
+        static uint64_t hashBytes(const void* pData, size_t uSize, uint64_t uHash);
+
+    private:
+        std::filesystem::path m_directory;
+        std::shared_ptr<IShaderCompiler> m_compiler;
+        std::atomic<uint32_t> m_uNumHits;
+        std::atomic<uint32_t> m_uNumMisses;
+        std::atomic<uint32_t> m_uNumCorrupt;
+        std::atomic<uint32_t> m_uNumTemporaryFiles;
+    };
+}
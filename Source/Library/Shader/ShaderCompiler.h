@@ -0,0 +1,43 @@
+/*+===================================================================
+  File:      SHADERCOMPILER.H
+
+  Summary:   ShaderCompiler header file contains declarations of
+             IShaderCompiler interface used for the lab samples of
+             Game Graphics Programming course. Only depends on the
+             standard library.
+
+  Classes: IShaderCompiler
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    IShaderCompiler
+
+      Summary:  Interface of a compiler turning a shader source file
+                into bytecode. The shader cache only talks to this
+                interface, so its logic does not depend on the
+                Direct3D compiler and runs on any platform
+
+      Methods:  Compile
+                  Compiles an entry point of a shader source file
+                ~IShaderCompiler
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class IShaderCompiler
+    {
+    public:
+        virtual ~IShaderCompiler() = default;
+
+        // May be called from several threads at the same time. A failed compile leaves the reason in errors
+        virtual bool Compile(const std::filesystem::path& sourcePath, const char* pszEntryPoint, const char* pszShaderModel, const std::vector<std::string>& aDefines, uint32_t uFlags, std::vector<uint8_t>& aBytecode, std::string& errors) = 0;
+    };
+}
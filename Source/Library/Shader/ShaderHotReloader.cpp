@@ -0,0 +1,277 @@
+#include "Shader/ShaderHotReloader.h"
+
+#include <algorithm>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderHotReloader::ShaderHotReloader
+
+      Summary:  Constructor
+
+      Modifies: [m_watchMutex, m_aShaders, m_shaderWatcher, m_mutex,
+                 m_aCompiledShaders, m_watcher, m_bStopping,
+                 m_uNumReloads, m_uNumFailures].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ShaderHotReloader::ShaderHotReloader()
+        : m_watchMutex()
+        , m_aShaders()
+        , m_shaderWatcher()
+        , m_mutex()
+        , m_aCompiledShaders()
+        , m_watcher()
+        , m_bStopping(FALSE)
+        , m_uNumReloads(0u)
+        , m_uNumFailures(0u)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderHotReloader::~ShaderHotReloader
+
+      Summary:  Destructor. Stops the watcher thread
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ShaderHotReloader::~ShaderHotReloader()
+    {
+        Stop();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderHotReloader::Track
+
+      Summary:  Watches the source of a shader and the files it
+                includes. A shader tracked twice is watched once
+
+      Args:     const std::shared_ptr<Shader>& shader
+                  Initialized shader to reload
+
+      Modifies: [m_aShaders, m_shaderWatcher].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ShaderHotReloader::Track(_In_ const std::shared_ptr<Shader>& shader)
+    {
+        std::lock_guard<std::mutex> lock(m_watchMutex);
+
+        if (!shader || std::find(m_aShaders.begin(), m_aShaders.end(), shader) != m_aShaders.end())
+        {
+            return;
+        }
+
+        // Indexed like the sources of the watcher
+        m_aShaders.push_back(shader);
+        m_shaderWatcher.Watch(shader->GetFileName());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderHotReloader::Start
+
+      Summary:  Starts the watcher thread if it is not running
+
+      Modifies: [m_watcher, m_bStopping].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ShaderHotReloader::Start()
+    {
+        if (m_watcher.joinable())
+        {
+            return;
+        }
+
+        m_bStopping = FALSE;
+        m_watcher = std::thread(&ShaderHotReloader::watch, this);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderHotReloader::Stop
+
+      Summary:  Stops the watcher thread and waits for it to finish
+                the compilation it is running
+
+      Modifies: [m_watcher, m_bStopping].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ShaderHotReloader::Stop()
+    {
+        m_bStopping = TRUE;
+
+        if (m_watcher.joinable())
+        {
+            m_watcher.join();
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderHotReloader::Update
+
+      Summary:  Swaps in the shaders whose variants all compiled since
+                the last call. Called on the rendering thread between
+                two frames. Returns at once when the watcher is handing
+                over bytecode, the shaders are swapped in on a later
+                frame
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the shaders
+
+      Modifies: [m_aCompiledShaders, m_uNumReloads, m_uNumFailures].
+
+      Returns:  UINT
+                  Number of shaders swapped in
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT ShaderHotReloader::Update(_In_ ID3D11Device* pDevice)
+    {
+        std::vector<CompiledShader> aCompiledShaders;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex, std::try_to_lock);
+            if (!lock.owns_lock())
+            {
+                return 0u;
+            }
+
+            aCompiledShaders.swap(m_aCompiledShaders);
+        }
+
+        UINT uNumReloaded = 0u;
+        for (CompiledShader& compiledShader : aCompiledShaders)
+        {
+            for (UINT uVariant = 0u; uVariant < Shader::NUM_VARIANTS; ++uVariant)
+            {
+                compiledShader.shader->SetCompiledBlob(uVariant, compiledShader.aCompiledBlobs[uVariant]);
+            }
+
+            // The device objects are only replaced once all of them were created
+            if (SUCCEEDED(compiledShader.shader->Reload(pDevice)))
+            {
+                ++uNumReloaded;
+                ++m_uNumReloads;
+            }
+            else
+            {
+                ++m_uNumFailures;
+            }
+        }
+
+        return uNumReloaded;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderHotReloader::GetNumReloads
+
+      Summary:  Returns the number of shaders swapped in so far
+
+      Returns:  UINT
+                  Number of reloads
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT ShaderHotReloader::GetNumReloads() const
+    {
+        return m_uNumReloads.load();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderHotReloader::GetNumFailures
+
+      Summary:  Returns the number of shaders that failed to compile or
+                to be created so far
+
+      Returns:  UINT
+                  Number of failures
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT ShaderHotReloader::GetNumFailures() const
+    {
+        return m_uNumFailures.load();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderHotReloader::watch
+
+      Summary:  Body of the watcher thread. Polls the write time of
+                every watched file and recompiles the shaders that
+                depend on a file that changed, appeared or disappeared,
+                then hands the bytecode over to Update
+
+      Modifies: [m_shaderWatcher, m_aCompiledShaders, m_uNumFailures].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ShaderHotReloader::watch()
+    {
+        std::vector<uint32_t> aChangedSources;
+        while (!m_bStopping)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(POLL_INTERVAL_MS));
+
+            std::vector<std::shared_ptr<Shader>> aChangedShaders;
+            {
+                std::lock_guard<std::mutex> watchLock(m_watchMutex);
+
+                m_shaderWatcher.Poll(aChangedSources);
+                for (uint32_t uSource : aChangedSources)
+                {
+                    aChangedShaders.push_back(m_aShaders[uSource]);
+                }
+            }
+
+            for (std::shared_ptr<Shader>& shader : aChangedShaders)
+            {
+                CompiledShader compiledShader = { .shader = std::move(shader), .aCompiledBlobs = {} };
+                if (!recompile(compiledShader))
+                {
+                    ++m_uNumFailures;
+                    continue;
+                }
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                // A shader compiled again before Update took it is swapped in once, with the latest bytecode
+                auto it = std::find_if(m_aCompiledShaders.begin(), m_aCompiledShaders.end(), [&compiledShader](const CompiledShader& pending) { return pending.shader == compiledShader.shader; });
+                if (it != m_aCompiledShaders.end())
+                {
+                    *it = std::move(compiledShader);
+                }
+                else
+                {
+                    m_aCompiledShaders.push_back(std::move(compiledShader));
+                }
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderHotReloader::recompile
+
+      Summary:  Compiles every variant of a shader into bytecode of its
+                own, sending the messages of the compiler to the
+                debugger. The shader keeps drawing with its bytecode
+                meanwhile
+
+      Args:     CompiledShader& compiledShader
+                  Shader to compile, receives the bytecode
+
+      Modifies: [compiledShader].
+
+      Returns:  BOOL
+                  TRUE if every variant compiled
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL ShaderHotReloader::recompile(_Inout_ CompiledShader& compiledShader)
+    {
+        const Shader& shader = *compiledShader.shader;
+
+        BOOL bCompiled = TRUE;
+        for (UINT uVariant = 0u; uVariant < Shader::NUM_VARIANTS; ++uVariant)
+        {
+            if (!shader.HasVariant(uVariant))
+            {
+                continue;
+            }
+
+            std::string errors;
+            HRESULT hr = shader.CompileBlob(uVariant, compiledShader.aCompiledBlobs[uVariant].ReleaseAndGetAddressOf(), errors);
+
+            if (!errors.empty())
+            {
+                OutputDebugStringA(errors.c_str());
+            }
+
+            if (FAILED(hr))
+            {
+                bCompiled = FALSE;
+            }
+        }
+
+        return bCompiled;
+    }
+}
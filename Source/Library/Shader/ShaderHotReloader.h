@@ -0,0 +1,109 @@
+/*+===================================================================
+  File:      SHADERHOTRELOADER.H
+
+  Summary:   ShaderHotReloader header file contains declarations of
+             ShaderHotReloader class used for the lab samples of Game
+             Graphics Programming course.
+
+  Classes: ShaderHotReloader
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "Shader/Shader.h"
+#include "Shader/ShaderWatcher.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ShaderHotReloader
+
+      Summary:  Recompiles shaders when their source or a file they
+                include is saved. A watcher thread polls the write
+                times of the files and compiles every variant of the
+                shaders depending on a changed file. A shader whose
+                variants all compiled is swapped in by Update on the
+                rendering thread, between two frames; one that failed
+                keeps drawing with its previous version
+
+                The watcher compiles into bytecode of its own and only
+                locks to hand it over, and Update only tries the lock,
+                so the frame never waits for a compilation
+
+      Methods:  Track
+                  Watches the files of a shader
+                Start
+                  Starts the watcher thread
+                Stop
+                  Stops the watcher thread
+                Update
+                  Swaps in the shaders compiled since the last call
+                GetNumReloads
+                  Returns the number of shaders swapped in so far
+                GetNumFailures
+                  Returns the number of failed recompilations so far
+                watch
+                  Body of the watcher thread
+                recompile
+                  Compiles every variant of a shader, leaving it as is
+                ShaderHotReloader
+                  Constructor.
+                ~ShaderHotReloader
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ShaderHotReloader final
+    {
+    public:
+        // Half of it is the average delay between a save and the compilation starting
+        static constexpr const UINT POLL_INTERVAL_MS = 50u;
+
+        ShaderHotReloader();
+        ShaderHotReloader(const ShaderHotReloader& other) = delete;
+        ShaderHotReloader(ShaderHotReloader&& other) = delete;
+        ShaderHotReloader& operator=(const ShaderHotReloader& other) = delete;
+        ShaderHotReloader& operator=(ShaderHotReloader&& other) = delete;
+        ~ShaderHotReloader();
+
+        void Track(_In_ const std::shared_ptr<Shader>& shader);
+        void Start();
+        void Stop();
+
+        UINT Update(_In_ ID3D11Device* pDevice);
+
+        UINT GetNumReloads() const;
+        UINT GetNumFailures() const;
+
+    private:
+        struct CompiledShader
+        {
+            std::shared_ptr<Shader> shader;
+            ComPtr<ID3DBlob> aCompiledBlobs[Shader::NUM_VARIANTS];
+        };
+
+    private:
+        void watch();
+        BOOL recompile(_Inout_ CompiledShader& compiledShader);
+
+    private:
+        // Held by Track and the watcher only, while the files are scanned
+        std::mutex m_watchMutex;
+        std::vector<std::shared_ptr<Shader>> m_aShaders;
+        ShaderWatcher m_shaderWatcher;
+
+        // Held by the watcher to hand over the bytecode and by Update to take it
+        std::mutex m_mutex;
+        std::vector<CompiledShader> m_aCompiledShaders;
+
+        std::thread m_watcher;
+        std::atomic<BOOL> m_bStopping;
+        std::atomic<UINT> m_uNumReloads;
+        std::atomic<UINT> m_uNumFailures;
+    };
+}
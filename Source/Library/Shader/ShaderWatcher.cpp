@@ -0,0 +1,171 @@
+#include "Shader/ShaderWatcher.h"
+
+#include <unordered_set>
+
+#include "Shader/ShaderCache.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderWatcher::ShaderWatcher
+
+      Summary:  Constructor
+
+      Modifies: [m_aSources, m_writeTimes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ShaderWatcher::ShaderWatcher()
+        : m_aSources()
+        , m_writeTimes()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderWatcher::Watch
+
+      Summary:  Watches a source and the files it includes, from their
+                current write time. Shaders sharing a source watch it
+                under an index each
+
+      Args:     const std::filesystem::path& sourcePath
+                  Shader source file
+
+      Modifies: [m_aSources, m_writeTimes].
+
+      Returns:  uint32_t
+                  Index of the source, reported by Poll
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t ShaderWatcher::Watch(const std::filesystem::path& sourcePath)
+    {
+        m_aSources.push_back(Source{ .path = sourcePath, .aDependencies = {} });
+        watchDependencies(m_aSources.back());
+
+        return static_cast<uint32_t>(m_aSources.size() - 1u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderWatcher::Poll
+
+      Summary:  Compares the write time of every watched file with the
+                one last seen, and returns the sources depending on a
+                file that changed, appeared or disappeared. Their
+                includes are scanned again and the new ones watched
+
+      Args:     std::vector<uint32_t>& aChangedSources
+                  Indices of the sources, replacing the previous
+                  contents
+
+      Modifies: [m_aSources, m_writeTimes, aChangedSources].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ShaderWatcher::Poll(std::vector<uint32_t>& aChangedSources)
+    {
+        aChangedSources.clear();
+
+        std::unordered_set<std::wstring> changedFiles;
+        for (auto it = m_writeTimes.begin(); it != m_writeTimes.end(); ++it)
+        {
+            const std::filesystem::file_time_type writeTime = getWriteTime(it->first);
+            if (writeTime != it->second)
+            {
+                it->second = writeTime;
+                changedFiles.insert(it->first);
+            }
+        }
+
+        if (changedFiles.empty())
+        {
+            return;
+        }
+
+        for (uint32_t uSource = 0u; uSource < m_aSources.size(); ++uSource)
+        {
+            Source& source = m_aSources[uSource];
+            for (const std::filesystem::path& dependency : source.aDependencies)
+            {
+                if (changedFiles.contains(dependency.lexically_normal().wstring()))
+                {
+                    aChangedSources.push_back(uSource);
+
+                    // The edit may have added or removed includes
+                    watchDependencies(source);
+                    break;
+                }
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderWatcher::GetDependencies
+
+      Summary:  Returns the files a source depends on as of the last
+                scan: the source first, then every file it includes
+
+      Args:     uint32_t uSource
+                  Index of the source, from Watch
+
+      Returns:  const std::vector<std::filesystem::path>&
+                  Files of the source
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<std::filesystem::path>& ShaderWatcher::GetDependencies(uint32_t uSource) const
+    {
+        return m_aSources[uSource].aDependencies;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderWatcher::GetNumWatchedFiles
+
+      Summary:  Returns the number of files watched, each once however
+                many sources depend on it
+
+      Returns:  uint32_t
+                  Number of files
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t ShaderWatcher::GetNumWatchedFiles() const
+    {
+        return static_cast<uint32_t>(m_writeTimes.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderWatcher::watchDependencies
+
+      Summary:  Finds the files a source depends on and starts watching
+                the ones no source depended on yet, from their current
+                write time
+
+      Args:     Source& source
+                  Source whose files are watched
+
+      Modifies: [source, m_writeTimes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ShaderWatcher::watchDependencies(Source& source)
+    {
+        ShaderCache::FindDependencies(source.path, source.aDependencies);
+
+        for (const std::filesystem::path& dependency : source.aDependencies)
+        {
+            std::wstring key = dependency.lexically_normal().wstring();
+            if (!m_writeTimes.contains(key))
+            {
+                m_writeTimes[key] = getWriteTime(dependency);
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ShaderWatcher::getWriteTime
+
+      Summary:  Returns the last write time of a file
+
+      Args:     const std::filesystem::path& filePath
+                  File watched
+
+      Returns:  std::filesystem::file_time_type
+                  Write time, the minimum if the file does not exist
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::filesystem::file_time_type ShaderWatcher::getWriteTime(const std::filesystem::path& filePath)
+    {
+        std::error_code ec;
+        const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(filePath, ec);
+
+        return ec ? std::filesystem::file_time_type::min() : writeTime;
+    }
+}
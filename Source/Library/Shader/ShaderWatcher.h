@@ -0,0 +1,81 @@
+/*+===================================================================
+  File:      SHADERWATCHER.H
+
+  Summary:   ShaderWatcher header file contains declarations of
+             ShaderWatcher class used for the lab samples of Game
+             Graphics Programming course. Only depends on the standard
+             library.
+
+  Classes: ShaderWatcher
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ShaderWatcher
+
+      Summary:  Finds the shader sources to recompile, without the
+                shaders. Watches the write time of every source and of
+                the files it includes, directly or not, and reports the
+                sources depending on a file that changed, appeared or
+                disappeared. The includes of those sources are scanned
+                again, since the edit may have added or removed some.
+                Not synchronized, the hot reloader locks around it
+
+      Methods:  Watch
+                  Watches a source and the files it includes
+                Poll
+                  Returns the sources depending on a changed file
+                GetDependencies
+                  Returns the files a source depends on
+                GetNumWatchedFiles
+                  Returns the number of files watched
+                watchDependencies
+                  Finds the files of a source and watches the new ones
+                getWriteTime
+                  Returns the write time of a file
+                ShaderWatcher
+                  Constructor.
+                ~ShaderWatcher
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ShaderWatcher final
+    {
+    public:
+        ShaderWatcher();
+        ShaderWatcher(const ShaderWatcher& other) = delete;
+        ShaderWatcher(ShaderWatcher&& other) = delete;
+        ShaderWatcher& operator=(const ShaderWatcher& other) = delete;
+        ShaderWatcher& operator=(ShaderWatcher&& other) = delete;
+        ~ShaderWatcher() = default;
+
+        uint32_t Watch(const std::filesystem::path& sourcePath);
+        void Poll(std::vector<uint32_t>& aChangedSources);
+
+        const std::vector<std::filesystem::path>& GetDependencies(uint32_t uSource) const;
+        uint32_t GetNumWatchedFiles() const;
+
+    private:
+        struct Source
+        {
+            std::filesystem::path path;
+            std::vector<std::filesystem::path> aDependencies;
+        };
+
+        void watchDependencies(Source& source);
+        static std::filesystem::file_time_type getWriteTime(const std::filesystem::path& filePath);
+
+    private:
+        std::vector<Source> m_aSources;
+        std::unordered_map<std::wstring, std::filesystem::file_time_type> m_writeTimes;
+    };
+}
@@ -0,0 +1,48 @@
+/*+===================================================================
+  File:      SKINNINGSHADOWVERTEXSHADER.H
+
+  Summary:   SkinningShadowVertexShader header file contains
+             declarations of SkinningShadowVertexShader class used for
+             the lab samples of Game Graphics Programming course.
+
+  Classes: SkinningShadowVertexShader
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Shader/VertexShader.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    SkinningShadowVertexShader
+
+      Summary:  Depth only vertex shader of the skinned models, reading
+                the positions from the vertex buffer and the bone
+                indices and weights from the animation buffer the
+                renderer binds in slot 3
+
+      Methods:  Initialize
+                  Compiles the shader and creates its input layout
+                SkinningShadowVertexShader
+                  Constructor.
+                ~SkinningShadowVertexShader
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class SkinningShadowVertexShader : public VertexShader
+    {
+    public:
+        SkinningShadowVertexShader() = delete;
+        SkinningShadowVertexShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel);
+        SkinningShadowVertexShader(const SkinningShadowVertexShader& other) = delete;
+        SkinningShadowVertexShader(SkinningShadowVertexShader&& other) = delete;
+        SkinningShadowVertexShader& operator=(const SkinningShadowVertexShader& other) = delete;
+        SkinningShadowVertexShader& operator=(SkinningShadowVertexShader&& other) = delete;
+        virtual ~SkinningShadowVertexShader() = default;
+
+        virtual HRESULT Initialize(_In_ ID3D11Device* pDevice) override;
+    };
+}
@@ -15,13 +15,17 @@ namespace library
                 PCSTR pszShaderModel
                   Specifies the shader target or set of shader features
                   to compile against
+                UINT uFeatures
+                  FEATURE_* bits the source has variants for
 
-      Modifies: [m_vertexShader].
+      Modifies: [m_vertexShader, m_vertexLayout,
+                 m_aVariantVertexShaders].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    VertexShader::VertexShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel)
-        :Shader(pszFileName, pszEntryPoint, pszShaderModel)
+    VertexShader::VertexShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel, _In_ UINT uFeatures)
+        :Shader(pszFileName, pszEntryPoint, pszShaderModel, uFeatures)
         , m_vertexShader()
         , m_vertexLayout()
+        , m_aVariantVertexShaders()
     {
     }
 
@@ -83,20 +87,69 @@ namespace library
             MessageBox(nullptr, L"input layout Error", L"Error", MB_OK);
             return hr;
         }
-        return S_OK;
+
+        return createVariants(pDevice);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VertexShader::Reload
+
+      Summary:  Initializes the vertex shaders and the input layout
+                again from the bytecode compiled since, through the
+                Initialize of the subclass. The previous ones are kept
+                if anything fails
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the vertex shader
+
+      Modifies: [m_vertexShader, m_vertexLayout,
+                 m_aVariantVertexShaders].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VertexShader::Reload(_In_ ID3D11Device* pDevice)
+    {
+        ComPtr<ID3D11VertexShader> previousVertexShader;
+        ComPtr<ID3D11InputLayout> previousVertexLayout;
+        ComPtr<ID3D11VertexShader> aPreviousVariantVertexShaders[NUM_VARIANTS];
+        previousVertexShader.Swap(m_vertexShader);
+        previousVertexLayout.Swap(m_vertexLayout);
+        for (UINT uVariant = 0u; uVariant < NUM_VARIANTS; ++uVariant)
+        {
+            aPreviousVariantVertexShaders[uVariant].Swap(m_aVariantVertexShaders[uVariant]);
+        }
+
+        HRESULT hr = Initialize(pDevice);
+        if (FAILED(hr))
+        {
+            m_vertexShader.Swap(previousVertexShader);
+            m_vertexLayout.Swap(previousVertexLayout);
+            for (UINT uVariant = 0u; uVariant < NUM_VARIANTS; ++uVariant)
+            {
+                m_aVariantVertexShaders[uVariant].Swap(aPreviousVariantVertexShaders[uVariant]);
+            }
+        }
+
+        return hr;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   VertexShader::GetVertexShader
 
-      Summary:  Returns the vertex shader
+      Summary:  Returns the vertex shader of the variant drawing a set
+                of features
+
+      Args:     UINT uFeatures
+                  FEATURE_* bits of what is drawn
 
       Returns:  ComPtr<ID3D11VertexShader>&
                   Vertex shader. Could be a nullptr
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    ComPtr<ID3D11VertexShader>& VertexShader::GetVertexShader()
+    ComPtr<ID3D11VertexShader>& VertexShader::GetVertexShader(_In_ UINT uFeatures)
     {
-        return m_vertexShader;
+        const UINT uVariant = GetVariant(uFeatures);
+        return uVariant == 0u ? m_vertexShader : m_aVariantVertexShaders[uVariant];
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -111,4 +164,49 @@ namespace library
     {
         return m_vertexLayout;
     }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VertexShader::createVariants
+
+      Summary:  Creates the vertex shaders of the variants with
+                features. Called by Initialize once the variant
+                without features and the input layout exist
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the vertex shaders
+
+      Modifies: [m_aVariantVertexShaders].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VertexShader::createVariants(_In_ ID3D11Device* pDevice)
+    {
+        for (UINT uVariant = 1u; uVariant < NUM_VARIANTS; ++uVariant)
+        {
+            if (!HasVariant(uVariant))
+            {
+                continue;
+            }
+
+            ComPtr<ID3DBlob> pVSBlob(nullptr);
+            HRESULT hr = compile(pVSBlob.GetAddressOf(), uVariant);
+
+            if (FAILED(hr))
+            {
+                MessageBox(nullptr, L"Vertex Shader compile Error", L"Error", MB_OK);
+                return hr;
+            }
+
+            hr = pDevice->CreateVertexShader(pVSBlob->GetBufferPointer(), pVSBlob->GetBufferSize(), nullptr, m_aVariantVertexShaders[uVariant].GetAddressOf());
+
+            if (FAILED(hr))
+            {
+                MessageBox(nullptr, L"Vertex Shader create Error", L"Error", MB_OK);
+                return hr;
+            }
+        }
+
+        return S_OK;
+    }
 }
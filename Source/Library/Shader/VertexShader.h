@@ -20,14 +20,23 @@ namespace library
     /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
       Class:    VertexShader
 
-      Summary:  Vertex shader
+      Summary:  Vertex shader. The subclasses create the variant
+                without features and the input layout, the other
+                variants share the layout
 
       Methods:  Initialize
                   Initializes the vertex shader and the input layout
+                Reload
+                  Initializes the vertex shader and the input layout
+                  again, keeping the previous ones on failure
                 GetVertexShader
-                  Returns the vertex shader
+                  Returns the vertex shader of the variant drawing a
+                  set of features
                 GetVertexLayout
                   Returns the vertex input layout
+                createVariants
+                  Creates the vertex shaders of the variants with
+                  features
                 Game
                   Constructor.
                 ~Game
@@ -37,7 +46,7 @@ namespace library
     {
     public:
         VertexShader() = delete;
-        VertexShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel);
+        VertexShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel, _In_ UINT uFeatures = 0u);
         VertexShader(const VertexShader& other) = delete;
         VertexShader(VertexShader&& other) = delete;
         VertexShader& operator=(const VertexShader& other) = delete;
@@ -45,12 +54,18 @@ namespace library
         virtual ~VertexShader() = default;
 
         virtual HRESULT Initialize(_In_ ID3D11Device* pDevice) override;
+        HRESULT Reload(_In_ ID3D11Device* pDevice) override;
 
-        ComPtr<ID3D11VertexShader>& GetVertexShader();
+        ComPtr<ID3D11VertexShader>& GetVertexShader(_In_ UINT uFeatures = 0u);
         ComPtr<ID3D11InputLayout>& GetVertexLayout();
 
     protected:
+        HRESULT createVariants(_In_ ID3D11Device* pDevice);
+
         ComPtr<ID3D11VertexShader> m_vertexShader;
         ComPtr<ID3D11InputLayout> m_vertexLayout;
+
+        // Indexed by variant, the variant without features is m_vertexShader
+        ComPtr<ID3D11VertexShader> m_aVariantVertexShaders[NUM_VARIANTS];
     };
 }
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "Shader/VoxelVertexShader.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelVertexShader::VoxelVertexShader
+
+      Summary:  Constructor
+
+      Args:     PCWSTR pszFileName
+                  Name of the file that contains the shader code
+                PCSTR pszEntryPoint
+                  Name of the shader entry point functino where shader
+                  execution begins
+                PCSTR pszShaderModel
+                  Specifies the shader target or set of shader features
+                  to compile against
+                UINT uFeatures
+                  FEATURE_* bits the source has variants for
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelVertexShader::VoxelVertexShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel, _In_ UINT uFeatures)
+        :VertexShader(pszFileName, pszEntryPoint, pszShaderModel, uFeatures)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelVertexShader::Initialize
+
+      Summary:  Initializes the vertex shader and the input layout. The
+                instance slot holds a single VoxelInstanceData element
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the vertex shader
+
+      Modifies: [m_vertexShader, m_vertexLayout,
+                 m_aVariantVertexShaders].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelVertexShader::Initialize(_In_ ID3D11Device* pDevice)
+    {
+        ComPtr<ID3DBlob> pVSBlob(nullptr);
+        HRESULT hr = compile(pVSBlob.GetAddressOf());
+        if (FAILED(hr))
+        {
+            MessageBox(nullptr, L"Voxel Vertex Shader compile Error", L"Error", MB_OK);
+            return hr;
+        }
+
+        hr = pDevice->CreateVertexShader(pVSBlob->GetBufferPointer(), pVSBlob->GetBufferSize(), nullptr, m_vertexShader.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        // Define the input layout
+        D3D11_INPUT_ELEMENT_DESC aLayouts[] =
+        {
+            {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
+            {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0},
+            {"NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 20, D3D11_INPUT_PER_VERTEX_DATA, 0},
+
+            {"TANGENT", 0, DXGI_FORMAT_R32G32B32_FLOAT, 1, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
+            {"BITANGENT", 0, DXGI_FORMAT_R32G32B32_FLOAT, 1, 12, D3D11_INPUT_PER_VERTEX_DATA, 0},
+
+            // X, Y, Z and BlockType of VoxelInstanceData
+            {"INSTANCE_VOXEL", 0, DXGI_FORMAT_R16G16B16A16_SINT, 2, 0, D3D11_INPUT_PER_INSTANCE_DATA, 1},
+        };
+        UINT uNumElements = ARRAYSIZE(aLayouts);
+
+        // Create the input layout
+        hr = pDevice->CreateInputLayout(aLayouts, uNumElements, pVSBlob->GetBufferPointer(), pVSBlob->GetBufferSize(), m_vertexLayout.GetAddressOf());
+        if (FAILED(hr))
+        {
+            MessageBox(nullptr, L"Voxel input layout Error", L"Error", MB_OK);
+            return hr;
+        }
+
+        return createVariants(pDevice);
+    }
+}
@@ -0,0 +1,182 @@
+//--------------------------------------------------------------------------------------
+// File: DDSParser.h
+//
+// DDS file structure definitions and the parts of the DDS loader that read a file
+// without a device: locating the headers, working out the texture layout and the size
+// of every subresource. They only read the data they are given, so the fuzz harness
+// and the tests build them on any platform.
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+//
+// http://go.microsoft.com/fwlink/?LinkId=248926
+// http://go.microsoft.com/fwlink/?LinkId=248929
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Texture/DDSPlatform.h"
+
+//--------------------------------------------------------------------------------------
+// Macros
+//--------------------------------------------------------------------------------------
+#ifndef MAKEFOURCC
+#define MAKEFOURCC(ch0, ch1, ch2, ch3)                              \
+                ((uint32_t)(uint8_t)(ch0) | ((uint32_t)(uint8_t)(ch1) << 8) |       \
+                ((uint32_t)(uint8_t)(ch2) << 16) | ((uint32_t)(uint8_t)(ch3) << 24 ))
+#endif /* defined(MAKEFOURCC) */
+
+//--------------------------------------------------------------------------------------
+// DDS file structure definitions
+//
+// See DDS.h in the 'Texconv' sample and the 'DirectXTex' library
+//--------------------------------------------------------------------------------------
+#pragma pack(push,1)
+
+namespace DirectX
+{
+    const uint32_t DDS_MAGIC = 0x20534444; // "DDS "
+
+    struct DDS_PIXELFORMAT
+    {
+        uint32_t    size;
+        uint32_t    flags;
+        uint32_t    fourCC;
+        uint32_t    RGBBitCount;
+        uint32_t    RBitMask;
+        uint32_t    GBitMask;
+        uint32_t    BBitMask;
+        uint32_t    ABitMask;
+    };
+
+#define DDS_FOURCC      0x00000004  // DDPF_FOURCC
+#define DDS_RGB         0x00000040  // DDPF_RGB
+#define DDS_LUMINANCE   0x00020000  // DDPF_LUMINANCE
+#define DDS_ALPHA       0x00000002  // DDPF_ALPHA
+#define DDS_BUMPDUDV    0x00080000  // DDPF_BUMPDUDV
+
+#define DDS_HEADER_FLAGS_VOLUME         0x00800000  // DDSD_DEPTH
+
+#define DDS_HEIGHT 0x00000002 // DDSD_HEIGHT
+
+#define DDS_CUBEMAP_POSITIVEX 0x00000600 // DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_POSITIVEX
+#define DDS_CUBEMAP_NEGATIVEX 0x00000a00 // DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_NEGATIVEX
+#define DDS_CUBEMAP_POSITIVEY 0x00001200 // DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_POSITIVEY
+#define DDS_CUBEMAP_NEGATIVEY 0x00002200 // DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_NEGATIVEY
+#define DDS_CUBEMAP_POSITIVEZ 0x00004200 // DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_POSITIVEZ
+#define DDS_CUBEMAP_NEGATIVEZ 0x00008200 // DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_NEGATIVEZ
+
+#define DDS_CUBEMAP_ALLFACES ( DDS_CUBEMAP_POSITIVEX | DDS_CUBEMAP_NEGATIVEX |\
+                               DDS_CUBEMAP_POSITIVEY | DDS_CUBEMAP_NEGATIVEY |\
+                               DDS_CUBEMAP_POSITIVEZ | DDS_CUBEMAP_NEGATIVEZ )
+
+#define DDS_CUBEMAP 0x00000200 // DDSCAPS2_CUBEMAP
+
+    enum DDS_MISC_FLAGS2
+    {
+        DDS_MISC_FLAGS2_ALPHA_MODE_MASK = 0x7L,
+    };
+
+    struct DDS_HEADER
+    {
+        uint32_t        size;
+        uint32_t        flags;
+        uint32_t        height;
+        uint32_t        width;
+        uint32_t        pitchOrLinearSize;
+        uint32_t        depth; // only if DDS_HEADER_FLAGS_VOLUME is set in flags
+        uint32_t        mipMapCount;
+        uint32_t        reserved1[11];
+        DDS_PIXELFORMAT ddspf;
+        uint32_t        caps;
+        uint32_t        caps2;
+        uint32_t        caps3;
+        uint32_t        caps4;
+        uint32_t        reserved2;
+    };
+
+    struct DDS_HEADER_DXT10
+    {
+        DXGI_FORMAT     dxgiFormat;
+        uint32_t        resourceDimension;
+        uint32_t        miscFlag; // see D3D11_RESOURCE_MISC_FLAG
+        uint32_t        arraySize;
+        uint32_t        miscFlags2;
+    };
+}
+
+#pragma pack(pop)
+
+namespace DirectX
+{
+#ifndef DDS_ALPHA_MODE_DEFINED
+#define DDS_ALPHA_MODE_DEFINED
+    enum DDS_ALPHA_MODE : uint32_t
+    {
+        DDS_ALPHA_MODE_UNKNOWN = 0,
+        DDS_ALPHA_MODE_STRAIGHT = 1,
+        DDS_ALPHA_MODE_PREMULTIPLIED = 2,
+        DDS_ALPHA_MODE_OPAQUE = 3,
+        DDS_ALPHA_MODE_CUSTOM = 4,
+    };
+#endif
+
+    // Kind, size and format of the texture a DDS file describes
+    struct DDS_TEXTURE_LAYOUT
+    {
+        uint32_t resourceDimension; // D3D11_RESOURCE_DIMENSION
+        uint32_t width;
+        uint32_t height;
+        uint32_t depth;
+        uint32_t mipCount;
+        uint32_t arraySize;         // 6 per cube of a cube map
+        DXGI_FORMAT format;
+        bool isCubeMap;
+    };
+
+    // Checks without a device that the header is sound and every subresource lies within the data
+    HRESULT ValidateDDSTextureMemory(
+        _In_reads_bytes_(ddsDataSize) const uint8_t* ddsData,
+        _In_ size_t ddsDataSize,
+        _Out_opt_ DDS_TEXTURE_LAYOUT* layout = nullptr) noexcept;
+
+    // Finds the header and the pixel data of a DDS file in memory
+    HRESULT LoadTextureDataFromMemory(
+        _In_reads_(ddsDataSize) const uint8_t* ddsData,
+        size_t ddsDataSize,
+        const DDS_HEADER** header,
+        const uint8_t** bitData,
+        size_t* bitSize) noexcept;
+
+    // Bits per pixel of a format, 0 if the format is not supported
+    size_t BitsPerPixel(_In_ DXGI_FORMAT fmt) noexcept;
+
+    // Size of a surface of a format, and of its rows
+    HRESULT GetSurfaceInfo(
+        _In_ size_t width,
+        _In_ size_t height,
+        _In_ DXGI_FORMAT fmt,
+        size_t* outNumBytes,
+        _Out_opt_ size_t* outRowBytes,
+        _Out_opt_ size_t* outNumRows) noexcept;
+
+    // Format of a legacy pixel format, DXGI_FORMAT_UNKNOWN if none matches
+    DXGI_FORMAT GetDXGIFormat(const DDS_PIXELFORMAT& ddpf) noexcept;
+
+    // Reads the kind, size and format of the texture a header describes
+    HRESULT GetTextureLayout(
+        _In_ const DDS_HEADER* header,
+        _Out_ uint32_t& resDim,
+        _Out_ uint32_t& width,
+        _Out_ uint32_t& height,
+        _Out_ uint32_t& depth,
+        _Out_ size_t& mipCount,
+        _Out_ uint32_t& arraySize,
+        _Out_ DXGI_FORMAT& format,
+        _Out_ bool& isCubeMap) noexcept;
+
+    // Alpha mode a header records
+    DDS_ALPHA_MODE GetAlphaMode(_In_ const DDS_HEADER* header) noexcept;
+}
@@ -20,20 +20,10 @@
 
 #include <cstdint>
 
+#include "Texture/DDSParser.h"
+
 namespace DirectX
 {
-#ifndef DDS_ALPHA_MODE_DEFINED
-#define DDS_ALPHA_MODE_DEFINED
-    enum DDS_ALPHA_MODE : uint32_t
-    {
-        DDS_ALPHA_MODE_UNKNOWN = 0,
-        DDS_ALPHA_MODE_STRAIGHT = 1,
-        DDS_ALPHA_MODE_PREMULTIPLIED = 2,
-        DDS_ALPHA_MODE_OPAQUE = 3,
-        DDS_ALPHA_MODE_CUSTOM = 4,
-    };
-#endif
-
     // Standard version
     HRESULT CreateDDSTextureFromMemory(
         _In_ ID3D11Device* d3dDevice,
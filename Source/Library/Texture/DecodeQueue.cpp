@@ -0,0 +1,254 @@
+#include "Texture/DecodeQueue.h"
+
+#include <cassert>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DecodeQueue::DecodeQueue
+
+      Summary:  Constructor. The workers are only started with the
+                first job queued
+
+      Args:     uint32_t uNumWorkers
+                  Number of jobs decoded at once
+
+      Modifies: [m_mutex, m_wake, m_aQueued, m_aDecoded, m_aWorkers,
+                 m_batchStart, m_loadTime, m_uNumWorkers, m_uNumPending,
+                 m_bStopping].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    DecodeQueue::DecodeQueue(uint32_t uNumWorkers)
+        : m_mutex()
+        , m_wake()
+        , m_aQueued()
+        , m_aDecoded()
+        , m_aWorkers()
+        , m_batchStart()
+        , m_loadTime(0.0f)
+        , m_uNumWorkers(uNumWorkers)
+        , m_uNumPending(0u)
+        , m_bStopping(false)
+    {
+        assert(uNumWorkers > 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DecodeQueue::~DecodeQueue
+
+      Summary:  Destructor. Stops the workers
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    DecodeQueue::~DecodeQueue()
+    {
+        Stop();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DecodeQueue::Enqueue
+
+      Summary:  Queues a job to be decoded by a worker, starting the
+                workers if not started. A job queued while nothing is
+                pending starts a new batch
+
+      Args:     std::unique_ptr<DecodeJob> job
+                  Job to decode
+
+      Modifies: [m_aQueued, m_aWorkers, m_batchStart, m_uNumPending].
+
+      Returns:  bool
+                  False if the queue is stopped and the job dropped
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    bool DecodeQueue::Enqueue(std::unique_ptr<DecodeJob> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (m_bStopping)
+            {
+                return false;
+            }
+
+            if (m_uNumPending == 0u)
+            {
+                m_batchStart = std::chrono::steady_clock::now();
+            }
+
+            ++m_uNumPending;
+            m_aQueued.push_back(std::move(job));
+
+            if (m_aWorkers.empty())
+            {
+                m_aWorkers.reserve(m_uNumWorkers);
+                for (uint32_t i = 0u; i < m_uNumWorkers; ++i)
+                {
+                    m_aWorkers.emplace_back(&DecodeQueue::work, this);
+                }
+            }
+        }
+
+        m_wake.notify_one();
+
+        return true;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DecodeQueue::TakeDecoded
+
+      Summary:  Takes the jobs decoded since the last call, in the
+                order they were decoded. They stay pending until they
+                are finished
+
+      Args:     std::vector<std::unique_ptr<DecodeJob>>& aDecoded
+                  Receives the decoded jobs, cleared first
+
+      Modifies: [m_aDecoded].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void DecodeQueue::TakeDecoded(std::vector<std::unique_ptr<DecodeJob>>& aDecoded)
+    {
+        aDecoded.clear();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        aDecoded.swap(m_aDecoded);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DecodeQueue::Finish
+
+      Summary:  Retires jobs taken by TakeDecoded. Keeps the load time
+                of the batch when its last pending job is finished
+
+      Args:     uint32_t uNumJobs
+                  Number of jobs finished
+
+      Modifies: [m_loadTime, m_uNumPending].
+
+      Returns:  bool
+                  True if these were the last pending jobs of a batch
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    bool DecodeQueue::Finish(uint32_t uNumJobs)
+    {
+        if (uNumJobs == 0u)
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        assert(uNumJobs <= m_uNumPending);
+        m_uNumPending -= uNumJobs;
+        if (m_uNumPending != 0u)
+        {
+            return false;
+        }
+
+        m_loadTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - m_batchStart).count();
+
+        return true;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DecodeQueue::Stop
+
+      Summary:  Stops the workers once they finish the jobs they are
+                decoding. The jobs still queued are dropped, and no job
+                is queued afterwards
+
+      Modifies: [m_aQueued, m_aWorkers, m_bStopping].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void DecodeQueue::Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_bStopping = true;
+        }
+
+        m_wake.notify_all();
+
+        for (std::thread& worker : m_aWorkers)
+        {
+            worker.join();
+        }
+        m_aWorkers.clear();
+        m_aQueued.clear();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DecodeQueue::GetNumWorkers
+
+      Summary:  Returns the number of workers running, none before the
+                first job is queued or after Stop
+
+      Returns:  uint32_t
+                  Number of workers
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t DecodeQueue::GetNumWorkers() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return static_cast<uint32_t>(m_aWorkers.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DecodeQueue::GetNumPending
+
+      Summary:  Returns the number of jobs queued, decoding or decoded
+                and not finished yet
+
+      Returns:  uint32_t
+                  Number of jobs pending
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t DecodeQueue::GetNumPending() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return m_uNumPending;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DecodeQueue::GetLoadTime
+
+      Summary:  Returns the time from the first job queued to the last
+                one finished, of the last batch that completed
+
+      Returns:  float
+                  Load time in milliseconds
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    float DecodeQueue::GetLoadTime() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return m_loadTime;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DecodeQueue::work
+
+      Summary:  Body of a worker. Decodes the queued jobs one at a time
+                and hands them to TakeDecoded until stopped
+
+      Modifies: [m_aQueued, m_aDecoded].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void DecodeQueue::work()
+    {
+        for (;;)
+        {
+            std::unique_ptr<DecodeJob> job;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [this] { return m_bStopping || !m_aQueued.empty(); });
+
+                if (m_bStopping)
+                {
+                    break;
+                }
+
+                job = std::move(m_aQueued.front());
+                m_aQueued.pop_front();
+            }
+
+            job->Decode();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_aDecoded.push_back(std::move(job));
+        }
+    }
+}
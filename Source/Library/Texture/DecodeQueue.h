@@ -0,0 +1,119 @@
+/*+===================================================================
+  File:      DECODEQUEUE.H
+
+  Summary:   DecodeQueue header file contains declarations of the
+             DecodeJob and DecodeQueue classes used for the lab samples
+             of Game Graphics Programming course. Only depends on the
+             standard library.
+
+  Classes: DecodeJob, DecodeQueue
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    DecodeJob
+
+      Summary:  Work queued on a DecodeQueue. Decode runs on a worker
+                and keeps its result in the job, which is handed back
+                to the thread that drains the queue
+
+      Methods:  Decode
+                  Does the work of the job on a worker
+                DecodeJob
+                  Constructor.
+                ~DecodeJob
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class DecodeJob
+    {
+    public:
+        DecodeJob() = default;
+        DecodeJob(const DecodeJob& other) = delete;
+        DecodeJob(DecodeJob&& other) = delete;
+        DecodeJob& operator=(const DecodeJob& other) = delete;
+        DecodeJob& operator=(DecodeJob&& other) = delete;
+        virtual ~DecodeJob() = default;
+
+        virtual void Decode() = 0;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    DecodeQueue
+
+      Summary:  Runs queued jobs on a fixed number of workers, started
+                with the first job queued, and collects the decoded
+                ones for a single thread to take. A job stays pending
+                until that thread finishes it, so a batch lasts from
+                the first job queued to the last one finished, and its
+                time is kept
+
+      Methods:  Enqueue
+                  Queues a job
+                TakeDecoded
+                  Takes the jobs decoded since the last call
+                Finish
+                  Retires taken jobs, ending the batch with the last
+                Stop
+                  Stops the workers
+                GetNumWorkers
+                  Returns the number of workers started
+                GetNumPending
+                  Returns the number of jobs not finished yet
+                GetLoadTime
+                  Returns the time the last batch took
+                work
+                  Decodes queued jobs until stopped
+                DecodeQueue
+                  Constructor.
+                ~DecodeQueue
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class DecodeQueue final
+    {
+    public:
+        DecodeQueue() = delete;
+        explicit DecodeQueue(uint32_t uNumWorkers);
+        DecodeQueue(const DecodeQueue& other) = delete;
+        DecodeQueue(DecodeQueue&& other) = delete;
+        DecodeQueue& operator=(const DecodeQueue& other) = delete;
+        DecodeQueue& operator=(DecodeQueue&& other) = delete;
+        ~DecodeQueue();
+
+        bool Enqueue(std::unique_ptr<DecodeJob> job);
+        void TakeDecoded(std::vector<std::unique_ptr<DecodeJob>>& aDecoded);
+        bool Finish(uint32_t uNumJobs);
+        void Stop();
+
+        uint32_t GetNumWorkers() const;
+        uint32_t GetNumPending() const;
+        float GetLoadTime() const;
+
+    private:
+        void work();
+
+    private:
+        mutable std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::deque<std::unique_ptr<DecodeJob>> m_aQueued;
+        std::vector<std::unique_ptr<DecodeJob>> m_aDecoded;
+        std::vector<std::thread> m_aWorkers;
+        std::chrono::steady_clock::time_point m_batchStart;
+        float m_loadTime;
+        uint32_t m_uNumWorkers;
+        uint32_t m_uNumPending;
+        bool m_bStopping;
+    };
+}
@@ -0,0 +1,135 @@
+#include "Texture/MappedFile.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MappedFile::MappedFile
+
+      Summary:  Constructor
+
+      Modifies: [m_pData, m_uSize].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    MappedFile::MappedFile()
+        : m_pData(nullptr)
+        , m_uSize(0u)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MappedFile::~MappedFile
+
+      Summary:  Destructor, unmaps the file
+
+      Modifies: [m_pData, m_uSize].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MappedFile::Open
+
+      Summary:  Maps a file read only, unmapping the one mapped before.
+                The handles of the file and of the mapping are closed
+                at once, the view keeps the file open until it is
+                unmapped
+
+      Args:     const std::filesystem::path& filePath
+                  Path to the file
+
+      Modifies: [m_pData, m_uSize].
+
+      Returns:  HRESULT
+                  Status code, an error for an empty file, which
+                  cannot be mapped
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT MappedFile::Open(_In_ const std::filesystem::path& filePath)
+    {
+        Close();
+
+        HANDLE hFile = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (hFile == INVALID_HANDLE_VALUE)
+        {
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
+
+        LARGE_INTEGER fileSize = {};
+        if (!GetFileSizeEx(hFile, &fileSize))
+        {
+            HRESULT hr = HRESULT_FROM_WIN32(GetLastError());
+            CloseHandle(hFile);
+            return hr;
+        }
+
+        if (fileSize.QuadPart <= 0ll || static_cast<UINT64>(fileSize.QuadPart) > SIZE_MAX)
+        {
+            CloseHandle(hFile);
+            return HRESULT_FROM_WIN32(ERROR_FILE_INVALID);
+        }
+
+        HANDLE hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0u, 0u, nullptr);
+        HRESULT hr = hMapping ? S_OK : HRESULT_FROM_WIN32(GetLastError());
+        CloseHandle(hFile);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        m_pData = static_cast<const BYTE*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0u, 0u, 0u));
+        hr = m_pData ? S_OK : HRESULT_FROM_WIN32(GetLastError());
+        CloseHandle(hMapping);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        m_uSize = static_cast<size_t>(fileSize.QuadPart);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MappedFile::Close
+
+      Summary:  Unmaps the file if one is mapped
+
+      Modifies: [m_pData, m_uSize].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void MappedFile::Close()
+    {
+        if (m_pData)
+        {
+            UnmapViewOfFile(m_pData);
+        }
+
+        m_pData = nullptr;
+        m_uSize = 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MappedFile::GetData
+
+      Summary:  Returns the bytes of the file
+
+      Returns:  const BYTE*
+                  Start of the view, nullptr if no file is mapped
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const BYTE* MappedFile::GetData() const
+    {
+        return m_pData;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MappedFile::GetSize
+
+      Summary:  Returns the size of the file
+
+      Returns:  size_t
+                  Size of the file in bytes, 0 if no file is mapped
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    size_t MappedFile::GetSize() const
+    {
+        return m_uSize;
+    }
+}
@@ -0,0 +1,61 @@
+/*+===================================================================
+  File:      MAPPEDFILE.H
+
+  Summary:   MappedFile header file contains declarations of
+             MappedFile class used for the lab samples of Game
+             Graphics Programming course.
+
+  Classes: MappedFile
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    MappedFile
+
+      Summary:  Maps a whole file read only into memory, so its bytes
+                are read where they lie instead of being copied into a
+                buffer first. The pages are read from the disk the
+                first time they are touched, and belong to the file
+                cache, not to the process. The view is shared, so the
+                file must not be written while it is mapped
+
+      Methods:  Open
+                  Maps a file, unmapping the one mapped before
+                Close
+                  Unmaps the file
+                GetData
+                  Returns the bytes of the file
+                GetSize
+                  Returns the size of the file
+                MappedFile
+                  Constructor.
+                ~MappedFile
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class MappedFile final
+    {
+    public:
+        MappedFile();
+        MappedFile(const MappedFile& other) = delete;
+        MappedFile(MappedFile&& other) = delete;
+        MappedFile& operator=(const MappedFile& other) = delete;
+        MappedFile& operator=(MappedFile&& other) = delete;
+        ~MappedFile();
+
+        HRESULT Open(_In_ const std::filesystem::path& filePath);
+        void Close();
+
+        const BYTE* GetData() const;
+        size_t GetSize() const;
+
+    private:
+        const BYTE* m_pData;
+        size_t m_uSize;
+    };
+}
@@ -0,0 +1,53 @@
+/*+===================================================================
+  File:      MIPCHAIN.H
+
+  Summary:   MipChain header file contains declarations of IMipChain
+             interface used for the lab samples of Game Graphics
+             Programming course. Only depends on the standard library.
+
+  Classes: IMipChain
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <cstdint>
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    IMipChain
+
+      Summary:  Interface of a texture whose finest mips may be
+                evicted from video memory. The streaming policy only
+                talks to this interface, so which mips stay resident
+                does not depend on Direct3D and runs on any platform
+
+      Methods:  GetWidth
+                  Returns the width of the finest mip
+                GetHeight
+                  Returns the height of the finest mip
+                GetNumMips
+                  Returns the number of mips
+                GetResidentMip
+                  Returns the finest mip resident
+                GetFallbackMip
+                  Returns the finest mip never evicted
+                GetMipChainSize
+                  Returns the bytes of the mips from one down
+                ~IMipChain
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class IMipChain
+    {
+    public:
+        virtual ~IMipChain() = default;
+
+        virtual uint32_t GetWidth() const = 0;
+        virtual uint32_t GetHeight() const = 0;
+        virtual uint32_t GetNumMips() const = 0;
+        virtual uint32_t GetResidentMip() const = 0;
+        virtual uint32_t GetFallbackMip() const = 0;
+        virtual uint64_t GetMipChainSize(uint32_t uFirstMip) const = 0;
+    };
+}
@@ -0,0 +1,557 @@
+#include "Texture/MipGenerator.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#include <emmintrin.h>
+
+// MSVC builds AVX2 code without /arch:AVX2, so it is chosen when the processor runs it
+#if defined(_MSC_VER) || defined(__AVX2__)
+#define MIP_GENERATOR_AVX2
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MipGenerator::GetNumMips
+
+      Summary:  Returns the number of mips of an image down to a texel
+
+      Args:     uint32_t uWidth
+                  Width of the image
+                uint32_t uHeight
+                  Height of the image
+
+      Returns:  uint32_t
+                  Number of mips, the image included
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t MipGenerator::GetNumMips(uint32_t uWidth, uint32_t uHeight)
+    {
+        uint32_t uNumMips = 1u;
+        while ((uWidth >> uNumMips) > 0u || (uHeight >> uNumMips) > 0u)
+        {
+            ++uNumMips;
+        }
+
+        return uNumMips;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MipGenerator::GenerateMips
+
+      Summary:  Builds every mip below the top one, each from the one
+                above
+
+      Args:     eTextureContent textureContent
+                  What the texels mean
+                uint32_t uWidth
+                  Width of the top mip
+                uint32_t uHeight
+                  Height of the top mip
+                std::vector<std::vector<uint8_t>>& aMips
+                  RGBA texels of the mips, the top one filled
+
+      Modifies: [aMips].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void MipGenerator::GenerateMips(eTextureContent textureContent, uint32_t uWidth, uint32_t uHeight, std::vector<std::vector<uint8_t>>& aMips)
+    {
+        const uint32_t uNumMips = GetNumMips(uWidth, uHeight);
+
+        aMips.resize(uNumMips);
+        for (uint32_t uMip = 1u; uMip < uNumMips; ++uMip)
+        {
+            uint32_t uMipWidth = (std::max)(uWidth >> (uMip - 1u), 1u);
+            uint32_t uMipHeight = (std::max)(uHeight >> (uMip - 1u), 1u);
+
+            aMips[uMip].resize(static_cast<size_t>((std::max)(uMipWidth / 2u, 1u)) * (std::max)(uMipHeight / 2u, 1u) * 4u);
+            Downsample(textureContent, aMips[uMip - 1u].data(), uMipWidth, uMipHeight, aMips[uMip].data());
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MipGenerator::Downsample
+
+      Summary:  Averages each 2x2 block of an RGBA mip into a texel of
+                the next mip. A side of a single texel stays a single
+                texel, and the last row or column of an odd side is
+                left out
+
+      Args:     eTextureContent textureContent
+                  What the texels mean
+                const uint8_t* pSource
+                  RGBA texels of the mip
+                uint32_t uWidth
+                  Width of the mip
+                uint32_t uHeight
+                  Height of the mip
+                uint8_t* pDestination
+                  RGBA texels of the next mip
+
+      Modifies: [pDestination].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void MipGenerator::Downsample(eTextureContent textureContent, const uint8_t* pSource, uint32_t uWidth, uint32_t uHeight, uint8_t* pDestination)
+    {
+        const uint32_t uNextWidth = (std::max)(uWidth / 2u, 1u);
+        const uint32_t uNextHeight = (std::max)(uHeight / 2u, 1u);
+        const bool bAvx2 = hasAvx2();
+
+        for (uint32_t y = 0u; y < uNextHeight; ++y)
+        {
+            const uint8_t* pRow0 = pSource + static_cast<size_t>((std::min)(y * 2u, uHeight - 1u)) * uWidth * 4u;
+            const uint8_t* pRow1 = pSource + static_cast<size_t>((std::min)(y * 2u + 1u, uHeight - 1u)) * uWidth * 4u;
+            uint8_t* pRow = pDestination + static_cast<size_t>(y) * uNextWidth * 4u;
+
+            switch (textureContent)
+            {
+            case eTextureContent::COLOR:
+                downsampleColorRow(pRow0, pRow1, uWidth, bAvx2 ? downsampleColorRowAvx2(pRow0, pRow1, uWidth, pRow) : 0u, pRow);
+                break;
+            case eTextureContent::NORMAL:
+                downsampleNormalRow(pRow0, pRow1, uWidth, pRow);
+                break;
+            default:
+                downsampleDataRow(pRow0, pRow1, uWidth, bAvx2 ? downsampleDataRowAvx2(pRow0, pRow1, uWidth, pRow) : 0u, pRow);
+                break;
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MipGenerator::downsampleColorRow
+
+      Summary:  Builds a row of a color mip a texel at a time, the four
+                channels of a texel in a register: decoded through the
+                table, summed, then encoded through the other table
+
+      Args:     const uint8_t* pRow0
+                  Upper row of the mip above
+                const uint8_t* pRow1
+                  Lower row of the mip above
+                uint32_t uWidth
+                  Width of the mip above
+                uint32_t uBegin
+                  First texel of the row to build
+                uint8_t* pDestination
+                  Row of the mip
+
+      Modifies: [pDestination].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void MipGenerator::downsampleColorRow(const uint8_t* pRow0, const uint8_t* pRow1, uint32_t uWidth, uint32_t uBegin, uint8_t* pDestination)
+    {
+        const float* pDecode = getSrgbToLinearTable();
+        const uint8_t* pEncode = getLinearToSrgbTable();
+
+        const uint32_t uNextWidth = (std::max)(uWidth / 2u, 1u);
+        const size_t uRight = uWidth > 1u ? 4u : 0u;
+
+        // The average of four texels, scaled to the indices of the table, alpha to a byte
+        const float lastIndex = static_cast<float>(LINEAR_TO_SRGB_TABLE_SIZE - 1u);
+        const __m128 scale = _mm_setr_ps(0.25f * lastIndex, 0.25f * lastIndex, 0.25f * lastIndex, 0.25f * 255.0f);
+        const __m128 maximum = _mm_setr_ps(lastIndex, lastIndex, lastIndex, 255.0f);
+
+        auto decode = [pDecode](const uint8_t* pTexel)
+        {
+            return _mm_setr_ps(pDecode[pTexel[0]], pDecode[pTexel[1]], pDecode[pTexel[2]], pDecode[256u + pTexel[3]]);
+        };
+
+        for (uint32_t x = uBegin; x < uNextWidth; ++x)
+        {
+            const uint8_t* p0 = pRow0 + static_cast<size_t>(x) * 8u;
+            const uint8_t* p1 = pRow1 + static_cast<size_t>(x) * 8u;
+
+            __m128 sum = _mm_add_ps(_mm_add_ps(decode(p0), decode(p0 + uRight)), _mm_add_ps(decode(p1), decode(p1 + uRight)));
+            sum = _mm_min_ps(_mm_max_ps(_mm_mul_ps(sum, scale), _mm_setzero_ps()), maximum);
+
+            alignas(16) int32_t aIndices[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(aIndices), _mm_cvtps_epi32(sum));
+
+            uint8_t* pTexel = pDestination + static_cast<size_t>(x) * 4u;
+            pTexel[0] = pEncode[aIndices[0]];
+            pTexel[1] = pEncode[aIndices[1]];
+            pTexel[2] = pEncode[aIndices[2]];
+            pTexel[3] = static_cast<uint8_t>(aIndices[3]);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MipGenerator::downsampleColorRowAvx2
+
+      Summary:  Builds a row of a color mip two texels at a time,
+                gathering the decoded values of four texels above at
+                once, and leaves the odd texel at the end
+
+      Args:     const uint8_t* pRow0
+                  Upper row of the mip above
+                const uint8_t* pRow1
+                  Lower row of the mip above
+                uint32_t uWidth
+                  Width of the mip above
+                uint8_t* pDestination
+                  Row of the mip
+
+      Modifies: [pDestination].
+
+      Returns:  uint32_t
+                  Number of texels built
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t MipGenerator::downsampleColorRowAvx2(const uint8_t* pRow0, const uint8_t* pRow1, uint32_t uWidth, uint8_t* pDestination)
+    {
+#if defined(MIP_GENERATOR_AVX2)
+        const float* pDecode = getSrgbToLinearTable();
+        const uint8_t* pEncode = getLinearToSrgbTable();
+
+        const uint32_t uNextWidth = uWidth / 2u;
+
+        // Alpha is decoded from the second half of the table
+        const __m256i alphaOffset = _mm256_setr_epi32(0, 0, 0, 256, 0, 0, 0, 256);
+        const float lastIndex = static_cast<float>(LINEAR_TO_SRGB_TABLE_SIZE - 1u);
+        const __m256 scale = _mm256_setr_ps(0.25f * lastIndex, 0.25f * lastIndex, 0.25f * lastIndex, 0.25f * 255.0f, 0.25f * lastIndex, 0.25f * lastIndex, 0.25f * lastIndex, 0.25f * 255.0f);
+        const __m256 maximum = _mm256_setr_ps(lastIndex, lastIndex, lastIndex, 255.0f, lastIndex, lastIndex, lastIndex, 255.0f);
+
+        uint32_t x = 0u;
+        for (; x + 2u <= uNextWidth; x += 2u)
+        {
+            const __m128i row0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow0 + static_cast<size_t>(x) * 8u));
+            const __m128i row1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow1 + static_cast<size_t>(x) * 8u));
+
+            // Two texels above each: the left pair makes texel x, the right pair texel x + 1
+            const __m256 left = _mm256_add_ps(
+                _mm256_i32gather_ps(pDecode, _mm256_add_epi32(_mm256_cvtepu8_epi32(row0), alphaOffset), 4),
+                _mm256_i32gather_ps(pDecode, _mm256_add_epi32(_mm256_cvtepu8_epi32(row1), alphaOffset), 4)
+            );
+            const __m256 right = _mm256_add_ps(
+                _mm256_i32gather_ps(pDecode, _mm256_add_epi32(_mm256_cvtepu8_epi32(_mm_srli_si128(row0, 8)), alphaOffset), 4),
+                _mm256_i32gather_ps(pDecode, _mm256_add_epi32(_mm256_cvtepu8_epi32(_mm_srli_si128(row1, 8)), alphaOffset), 4)
+            );
+
+            __m256 sum = _mm256_add_ps(_mm256_permute2f128_ps(left, right, 0x20), _mm256_permute2f128_ps(left, right, 0x31));
+            sum = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(sum, scale), _mm256_setzero_ps()), maximum);
+
+            alignas(32) int32_t aIndices[8];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(aIndices), _mm256_cvtps_epi32(sum));
+
+            uint8_t* pTexel = pDestination + static_cast<size_t>(x) * 4u;
+            for (uint32_t i = 0u; i < 8u; i += 4u)
+            {
+                pTexel[i + 0u] = pEncode[aIndices[i + 0u]];
+                pTexel[i + 1u] = pEncode[aIndices[i + 1u]];
+                pTexel[i + 2u] = pEncode[aIndices[i + 2u]];
+                pTexel[i + 3u] = static_cast<uint8_t>(aIndices[i + 3u]);
+            }
+        }
+
+        return x;
+#else
+        static_cast<void>(pRow0);
+        static_cast<void>(pRow1);
+        static_cast<void>(uWidth);
+        static_cast<void>(pDestination);
+
+        return 0u;
+#endif
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MipGenerator::downsampleNormalRow
+
+      Summary:  Builds a row of a normal mip a texel at a time: the
+                four normals above are expanded to [-1, 1] and summed
+                in a register, then the sum is normalized and packed
+                back. A sum of length 0 points straight out
+
+      Args:     const uint8_t* pRow0
+                  Upper row of the mip above
+                const uint8_t* pRow1
+                  Lower row of the mip above
+                uint32_t uWidth
+                  Width of the mip above
+                uint8_t* pDestination
+                  Row of the mip
+
+      Modifies: [pDestination].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void MipGenerator::downsampleNormalRow(const uint8_t* pRow0, const uint8_t* pRow1, uint32_t uWidth, uint8_t* pDestination)
+    {
+        const uint32_t uNextWidth = (std::max)(uWidth / 2u, 1u);
+        const size_t uRight = uWidth > 1u ? 4u : 0u;
+
+        const __m128i zero = _mm_setzero_si128();
+        auto load = [zero](const uint8_t* pTexel)
+        {
+            int32_t iTexel;
+            std::memcpy(&iTexel, pTexel, sizeof(iTexel));
+
+            return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(iTexel), zero), zero));
+        };
+
+        // The sum of four texels expanded to [-1, 1] but alpha, averaged
+        const __m128 expandScale = _mm_setr_ps(2.0f / 255.0f, 2.0f / 255.0f, 2.0f / 255.0f, 0.25f);
+        const __m128 expandBias = _mm_setr_ps(4.0f, 4.0f, 4.0f, 0.0f);
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 byteMaximum = _mm_set1_ps(255.0f);
+
+        for (uint32_t x = 0u; x < uNextWidth; ++x)
+        {
+            const uint8_t* p0 = pRow0 + static_cast<size_t>(x) * 8u;
+            const uint8_t* p1 = pRow1 + static_cast<size_t>(x) * 8u;
+
+            __m128 sum = _mm_add_ps(_mm_add_ps(load(p0), load(p0 + uRight)), _mm_add_ps(load(p1), load(p1 + uRight)));
+            sum = _mm_sub_ps(_mm_mul_ps(sum, expandScale), expandBias);
+
+            alignas(16) float aSquares[4];
+            _mm_store_ps(aSquares, _mm_mul_ps(sum, sum));
+            const float lengthSquared = aSquares[0] + aSquares[1] + aSquares[2];
+
+            __m128 normal;
+            if (lengthSquared > 1e-12f)
+            {
+                const float invLength = 1.0f / std::sqrt(lengthSquared);
+                normal = _mm_mul_ps(sum, _mm_setr_ps(invLength, invLength, invLength, 1.0f));
+                normal = _mm_add_ps(_mm_mul_ps(normal, _mm_setr_ps(127.5f, 127.5f, 127.5f, 1.0f)), _mm_setr_ps(128.0f, 128.0f, 128.0f, 0.5f));
+            }
+            else
+            {
+                alignas(16) float aSum[4];
+                _mm_store_ps(aSum, sum);
+                normal = _mm_setr_ps(128.0f, 128.0f, 255.5f, aSum[3] + 0.5f);
+            }
+
+            // Truncated after adding a half, so rounded
+            normal = _mm_min_ps(_mm_max_ps(normal, _mm_setzero_ps()), _mm_add_ps(byteMaximum, half));
+            const __m128i texel = _mm_cvttps_epi32(normal);
+            const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(texel, zero), zero);
+
+            const int32_t iTexel = _mm_cvtsi128_si32(packed);
+            std::memcpy(pDestination + static_cast<size_t>(x) * 4u, &iTexel, sizeof(iTexel));
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MipGenerator::downsampleDataRow
+
+      Summary:  Builds a row of a mip of data four texels at a time in
+                16-bit integers, rounding to nearest, then texel by
+                texel to the end of the row
+
+      Args:     const uint8_t* pRow0
+                  Upper row of the mip above
+                const uint8_t* pRow1
+                  Lower row of the mip above
+                uint32_t uWidth
+                  Width of the mip above
+                uint32_t uBegin
+                  First texel of the row to build
+                uint8_t* pDestination
+                  Row of the mip
+
+      Modifies: [pDestination].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void MipGenerator::downsampleDataRow(const uint8_t* pRow0, const uint8_t* pRow1, uint32_t uWidth, uint32_t uBegin, uint8_t* pDestination)
+    {
+        const uint32_t uNextWidth = (std::max)(uWidth / 2u, 1u);
+        const size_t uRight = uWidth > 1u ? 4u : 0u;
+
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i two = _mm_set1_epi16(2);
+
+        // Sums the 2x2 blocks of four texels above, giving two texels in 16 bits
+        auto sumBlocks = [zero](__m128i upper, __m128i lower)
+        {
+            const __m128i left = _mm_add_epi16(_mm_unpacklo_epi8(upper, zero), _mm_unpacklo_epi8(lower, zero));
+            const __m128i right = _mm_add_epi16(_mm_unpackhi_epi8(upper, zero), _mm_unpackhi_epi8(lower, zero));
+
+            return _mm_unpacklo_epi64(_mm_add_epi16(left, _mm_srli_si128(left, 8)), _mm_add_epi16(right, _mm_srli_si128(right, 8)));
+        };
+
+        uint32_t x = uBegin;
+        for (; x + 4u <= uNextWidth; x += 4u)
+        {
+            const __m128i* pUpper = reinterpret_cast<const __m128i*>(pRow0 + static_cast<size_t>(x) * 8u);
+            const __m128i* pLower = reinterpret_cast<const __m128i*>(pRow1 + static_cast<size_t>(x) * 8u);
+
+            const __m128i first = sumBlocks(_mm_loadu_si128(pUpper), _mm_loadu_si128(pLower));
+            const __m128i second = sumBlocks(_mm_loadu_si128(pUpper + 1), _mm_loadu_si128(pLower + 1));
+
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i*>(pDestination + static_cast<size_t>(x) * 4u),
+                _mm_packus_epi16(_mm_srli_epi16(_mm_add_epi16(first, two), 2), _mm_srli_epi16(_mm_add_epi16(second, two), 2))
+            );
+        }
+
+        for (; x < uNextWidth; ++x)
+        {
+            const uint8_t* p0 = pRow0 + static_cast<size_t>(x) * 8u;
+            const uint8_t* p1 = pRow1 + static_cast<size_t>(x) * 8u;
+
+            uint8_t* pTexel = pDestination + static_cast<size_t>(x) * 4u;
+            for (uint32_t c = 0u; c < 4u; ++c)
+            {
+                pTexel[c] = static_cast<uint8_t>((p0[c] + p0[uRight + c] + p1[c] + p1[uRight + c] + 2u) / 4u);
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MipGenerator::downsampleDataRowAvx2
+
+      Summary:  Builds a row of a mip of data eight texels at a time in
+                16-bit integers, and leaves the texels past the last
+                eight
+
+      Args:     const uint8_t* pRow0
+                  Upper row of the mip above
+                const uint8_t* pRow1
+                  Lower row of the mip above
+                uint32_t uWidth
+                  Width of the mip above
+                uint8_t* pDestination
+                  Row of the mip
+
+      Modifies: [pDestination].
+
+      Returns:  uint32_t
+                  Number of texels built
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t MipGenerator::downsampleDataRowAvx2(const uint8_t* pRow0, const uint8_t* pRow1, uint32_t uWidth, uint8_t* pDestination)
+    {
+#if defined(MIP_GENERATOR_AVX2)
+        const uint32_t uNextWidth = uWidth / 2u;
+
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i two = _mm256_set1_epi16(2);
+
+        // Within each half: the 2x2 blocks of four texels above, giving two texels in 16 bits
+        auto sumBlocks = [zero](__m256i upper, __m256i lower)
+        {
+            const __m256i left = _mm256_add_epi16(_mm256_unpacklo_epi8(upper, zero), _mm256_unpacklo_epi8(lower, zero));
+            const __m256i right = _mm256_add_epi16(_mm256_unpackhi_epi8(upper, zero), _mm256_unpackhi_epi8(lower, zero));
+
+            return _mm256_unpacklo_epi64(_mm256_add_epi16(left, _mm256_srli_si256(left, 8)), _mm256_add_epi16(right, _mm256_srli_si256(right, 8)));
+        };
+
+        uint32_t x = 0u;
+        for (; x + 8u <= uNextWidth; x += 8u)
+        {
+            const __m256i* pUpper = reinterpret_cast<const __m256i*>(pRow0 + static_cast<size_t>(x) * 8u);
+            const __m256i* pLower = reinterpret_cast<const __m256i*>(pRow1 + static_cast<size_t>(x) * 8u);
+
+            // Texels 0, 1 | 2, 3 and 4, 5 | 6, 7, interleaved by half when packed
+            const __m256i first = _mm256_srli_epi16(_mm256_add_epi16(sumBlocks(_mm256_loadu_si256(pUpper), _mm256_loadu_si256(pLower)), two), 2);
+            const __m256i second = _mm256_srli_epi16(_mm256_add_epi16(sumBlocks(_mm256_loadu_si256(pUpper + 1), _mm256_loadu_si256(pLower + 1)), two), 2);
+            const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(first, second), _MM_SHUFFLE(3, 1, 2, 0));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pDestination + static_cast<size_t>(x) * 4u), packed);
+        }
+
+        return x;
+#else
+        static_cast<void>(pRow0);
+        static_cast<void>(pRow1);
+        static_cast<void>(uWidth);
+        static_cast<void>(pDestination);
+
+        return 0u;
+#endif
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MipGenerator::hasAvx2
+
+      Summary:  Returns whether the AVX2 kernels are built and the
+                processor and the operating system run them
+
+      Returns:  bool
+                  true if the AVX2 kernels can run
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    bool MipGenerator::hasAvx2()
+    {
+#if defined(MIP_GENERATOR_AVX2) && defined(_MSC_VER)
+        static const bool s_bHasAvx2 = []() -> bool
+        {
+            int32_t aInfo[4];
+            __cpuid(aInfo, 0);
+            if (aInfo[0] < 7)
+            {
+                return false;
+            }
+
+            // AVX, and the operating system saving the YMM registers
+            __cpuid(aInfo, 1);
+            if ((aInfo[2] & (1 << 27)) == 0 || (aInfo[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6ull) != 6ull)
+            {
+                return false;
+            }
+
+            __cpuidex(aInfo, 7, 0);
+            return (aInfo[1] & (1 << 5)) != 0;
+        }();
+
+        return s_bHasAvx2;
+#elif defined(MIP_GENERATOR_AVX2)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MipGenerator::getSrgbToLinearTable
+
+      Summary:  Returns the table decoding bytes to values in [0, 1]:
+                the first 256 entries decode sRGB to linear light, the
+                next 256 only divide by 255, for alpha
+
+      Returns:  const float*
+                  512 values
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const float* MipGenerator::getSrgbToLinearTable()
+    {
+        static const std::array<float, 512u> s_aTable = []()
+        {
+            std::array<float, 512u> aTable = {};
+            for (uint32_t i = 0u; i < 256u; ++i)
+            {
+                const float value = static_cast<float>(i) / 255.0f;
+                aTable[i] = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+                aTable[256u + i] = value;
+            }
+
+            return aTable;
+        }();
+
+        return s_aTable.data();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MipGenerator::getLinearToSrgbTable
+
+      Summary:  Returns the table encoding linear values to sRGB bytes,
+                indexed by the value times LINEAR_TO_SRGB_TABLE_SIZE - 1
+
+      Returns:  const uint8_t*
+                  LINEAR_TO_SRGB_TABLE_SIZE bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const uint8_t* MipGenerator::getLinearToSrgbTable()
+    {
+        static const std::array<uint8_t, LINEAR_TO_SRGB_TABLE_SIZE> s_aTable = []()
+        {
+            std::array<uint8_t, LINEAR_TO_SRGB_TABLE_SIZE> aTable = {};
+            for (uint32_t i = 0u; i < LINEAR_TO_SRGB_TABLE_SIZE; ++i)
+            {
+                const float value = static_cast<float>(i) / static_cast<float>(LINEAR_TO_SRGB_TABLE_SIZE - 1u);
+                const float srgb = value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+                aTable[i] = static_cast<uint8_t>(srgb * 255.0f + 0.5f);
+            }
+
+            return aTable;
+        }();
+
+        return s_aTable.data();
+    }
+}
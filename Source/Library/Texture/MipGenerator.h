@@ -0,0 +1,88 @@
+/*+===================================================================
+  File:      MIPGENERATOR.H
+
+  Summary:   MipGenerator header file contains declarations of
+             MipGenerator class used for the lab samples of Game
+             Graphics Programming course. Only depends on the
+             standard library.
+
+  Classes: MipGenerator
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Texture/TextureContent.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    MipGenerator
+
+      Summary:  Builds the mip chain of an RGBA image on the CPU, so a
+                texture gets its mips without a device and without
+                GenerateMips. Every texel of a mip is the 2x2 box of
+                the one above: colors are averaged in linear light
+                through tables, normals are averaged as vectors and
+                normalized again, anything else is averaged as is.
+                Alpha is always averaged as is. The kernels use SSE2,
+                and AVX2 when the processor has it
+
+      Methods:  GetNumMips
+                  Returns the number of mips down to a texel
+                GenerateMips
+                  Builds the mips below the top one
+                Downsample
+                  Builds a mip from the one above
+                downsampleColorRow
+                  Builds a row of a color mip
+                downsampleColorRowAvx2
+                  Builds a row of a color mip with AVX2
+                downsampleNormalRow
+                  Builds a row of a normal mip
+                downsampleDataRow
+                  Builds a row of a mip of data
+                downsampleDataRowAvx2
+                  Builds a row of a mip of data with AVX2
+                hasAvx2
+                  Returns whether the processor runs AVX2
+                getSrgbToLinearTable
+                  Returns the table decoding bytes to linear values
+                getLinearToSrgbTable
+                  Returns the table encoding linear values to bytes
+                MipGenerator
+                  Constructor.
+                ~MipGenerator
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class MipGenerator final
+    {
+    public:
+        // Entries of the table encoding linear values, within half a level of sRGB but for the darkest
+        static constexpr const uint32_t LINEAR_TO_SRGB_TABLE_SIZE = 4096u;
+
+        MipGenerator() = delete;
+        MipGenerator(const MipGenerator& other) = delete;
+        MipGenerator(MipGenerator&& other) = delete;
+        MipGenerator& operator=(const MipGenerator& other) = delete;
+        MipGenerator& operator=(MipGenerator&& other) = delete;
+        ~MipGenerator() = delete;
+
+        static uint32_t GetNumMips(uint32_t uWidth, uint32_t uHeight);
+        static void GenerateMips(eTextureContent textureContent, uint32_t uWidth, uint32_t uHeight, std::vector<std::vector<uint8_t>>& aMips);
+        static void Downsample(eTextureContent textureContent, const uint8_t* pSource, uint32_t uWidth, uint32_t uHeight, uint8_t* pDestination);
+
+    private:
+        static void downsampleColorRow(const uint8_t* pRow0, const uint8_t* pRow1, uint32_t uWidth, uint32_t uBegin, uint8_t* pDestination);
+        static uint32_t downsampleColorRowAvx2(const uint8_t* pRow0, const uint8_t* pRow1, uint32_t uWidth, uint8_t* pDestination);
+        static void downsampleNormalRow(const uint8_t* pRow0, const uint8_t* pRow1, uint32_t uWidth, uint8_t* pDestination);
+        static void downsampleDataRow(const uint8_t* pRow0, const uint8_t* pRow1, uint32_t uWidth, uint32_t uBegin, uint8_t* pDestination);
+        static uint32_t downsampleDataRowAvx2(const uint8_t* pRow0, const uint8_t* pRow1, uint32_t uWidth, uint8_t* pDestination);
+        static bool hasAvx2();
+        static const float* getSrgbToLinearTable();
+        static const uint8_t* getLinearToSrgbTable();
+    };
+}
@@ -0,0 +1,331 @@
+#include "Texture/MipStreamingPolicy.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MipStreamingPolicy::MipStreamingPolicy
+
+      Summary:  Constructor
+
+      Modifies: [m_entries, m_uFrame, m_uBudgetBytes, m_uResidentBytes,
+                 m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    MipStreamingPolicy::MipStreamingPolicy()
+        : m_entries()
+        , m_uFrame(0ull)
+        , m_uBudgetBytes(DEFAULT_BUDGET)
+        , m_uResidentBytes(0ull)
+        , m_stats()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MipStreamingPolicy::Request
+
+      Summary:  Requests the mip a draw of a texture is sampled from in
+                the frame, the finest request of the frame winning
+
+      Args:     const std::shared_ptr<IMipChain>& mipChain
+                  Texture drawn
+                float uvPerPixel
+                  Texture coordinates spanned by a pixel of the draw,
+                  where it is the closest to the camera
+
+      Modifies: [m_entries].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void MipStreamingPolicy::Request(const std::shared_ptr<IMipChain>& mipChain, float uvPerPixel)
+    {
+        if (!mipChain)
+        {
+            return;
+        }
+
+        const uint32_t uMip = ComputeMip(*mipChain, uvPerPixel);
+
+        // A texture released since may have left its address to this one
+        Entry& entry = m_entries[mipChain.get()];
+        if (entry.mipChain.expired())
+        {
+            entry = Entry{ .mipChain = mipChain, .uRequestedMip = uMip, .uLastUsedFrame = m_uFrame };
+            return;
+        }
+
+        if (entry.uLastUsedFrame != m_uFrame)
+        {
+            entry.uRequestedMip = uMip;
+            entry.uLastUsedFrame = m_uFrame;
+            return;
+        }
+
+        entry.uRequestedMip = (std::min)(entry.uRequestedMip, uMip);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MipStreamingPolicy::Update
+
+      Summary:  Streams in the mips requested in the frame, at most
+                MAX_STREAM_INS_PER_UPDATE textures and the textures
+                missing the most mips first, evicting mips to stay
+                within the budget, then starts the next frame
+
+      Args:     const SetResidentMipFunction& fnSetResidentMip
+                  Creates a texture again with its mips from the given
+                  one down
+
+      Modifies: [m_entries, m_uFrame, m_uResidentBytes, m_stats].
+
+      Returns:  uint32_t
+                  Number of textures created again
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t MipStreamingPolicy::Update(const SetResidentMipFunction& fnSetResidentMip)
+    {
+        std::erase_if(m_entries, [](const auto& entry) { return entry.second.mipChain.expired(); });
+
+        std::vector<std::pair<std::shared_ptr<IMipChain>, uint32_t>> aStreamIns;
+        m_uResidentBytes = 0ull;
+        m_stats.uRequestedBytes = 0ull;
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            std::shared_ptr<IMipChain> mipChain = it->second.mipChain.lock();
+            if (!mipChain)
+            {
+                continue;
+            }
+
+            const bool bUsed = it->second.uLastUsedFrame == m_uFrame;
+
+            m_uResidentBytes += mipChain->GetMipChainSize(mipChain->GetResidentMip());
+            m_stats.uRequestedBytes += mipChain->GetMipChainSize(bUsed ? it->second.uRequestedMip : mipChain->GetFallbackMip());
+
+            if (bUsed && it->second.uRequestedMip < mipChain->GetResidentMip())
+            {
+                aStreamIns.emplace_back(std::move(mipChain), it->second.uRequestedMip);
+            }
+        }
+
+        std::sort(aStreamIns.begin(), aStreamIns.end(), [](const auto& a, const auto& b) { return a.first->GetResidentMip() - a.second > b.first->GetResidentMip() - b.second; });
+
+        uint32_t uNumCreated = 0u;
+        uint32_t uNumStreamedIn = 0u;
+        for (auto& [mipChain, uMip] : aStreamIns)
+        {
+            if (uNumStreamedIn == MAX_STREAM_INS_PER_UPDATE)
+            {
+                break;
+            }
+
+            const uint64_t uResidentSize = mipChain->GetMipChainSize(mipChain->GetResidentMip());
+            const uint64_t uRequestedSize = mipChain->GetMipChainSize(uMip);
+            if (m_uResidentBytes + uRequestedSize - uResidentSize > m_uBudgetBytes)
+            {
+                uNumCreated += evict(fnSetResidentMip, m_uResidentBytes + uRequestedSize - uResidentSize - m_uBudgetBytes, mipChain.get(), false);
+            }
+
+            // The finest mip that fits once the others made room
+            while (uMip < mipChain->GetResidentMip() && m_uResidentBytes + mipChain->GetMipChainSize(uMip) - uResidentSize > m_uBudgetBytes)
+            {
+                ++uMip;
+            }
+
+            if (uMip == mipChain->GetResidentMip() || !fnSetResidentMip(*mipChain, uMip))
+            {
+                continue;
+            }
+
+            m_uResidentBytes += mipChain->GetMipChainSize(uMip) - uResidentSize;
+            ++uNumStreamedIn;
+            ++m_stats.uNumStreamedIn;
+        }
+        uNumCreated += uNumStreamedIn;
+
+        // The budget may have been lowered since the last frame, or the frame may need more than it
+        if (m_uResidentBytes > m_uBudgetBytes)
+        {
+            uNumCreated += evict(fnSetResidentMip, m_uResidentBytes - m_uBudgetBytes, nullptr, false);
+        }
+        if (m_uResidentBytes > m_uBudgetBytes)
+        {
+            uNumCreated += evict(fnSetResidentMip, m_uResidentBytes - m_uBudgetBytes, nullptr, true);
+        }
+
+        m_stats.uNumTextures = static_cast<uint32_t>(m_entries.size());
+        m_stats.uNumPending = static_cast<uint32_t>(aStreamIns.size()) - uNumStreamedIn;
+        m_stats.uResidentBytes = m_uResidentBytes;
+        m_stats.uBudgetBytes = m_uBudgetBytes;
+
+        ++m_uFrame;
+
+        return uNumCreated;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MipStreamingPolicy::SetBudget
+
+      Summary:  Sets the video memory the mips of the streamed textures
+                may take, enforced from the next Update. The fallback
+                mips are never evicted, so they may exceed it
+
+      Args:     uint64_t uBudgetBytes
+                  Budget in bytes
+
+      Modifies: [m_uBudgetBytes, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void MipStreamingPolicy::SetBudget(uint64_t uBudgetBytes)
+    {
+        m_uBudgetBytes = uBudgetBytes;
+        m_stats.uBudgetBytes = uBudgetBytes;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MipStreamingPolicy::GetBudget
+
+      Summary:  Returns the video memory the mips of the streamed
+                textures may take
+
+      Returns:  uint64_t
+                  Budget in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint64_t MipStreamingPolicy::GetBudget() const
+    {
+        return m_uBudgetBytes;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MipStreamingPolicy::GetStats
+
+      Summary:  Returns the counters since the construction, and the
+                memory of the mips as of the last Update
+
+      Returns:  const TextureStreamingStats&
+                  Textures and bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const TextureStreamingStats& MipStreamingPolicy::GetStats() const
+    {
+        return m_stats;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MipStreamingPolicy::ComputeMip
+
+      Summary:  Returns the mip a texture is sampled from where a pixel
+                spans the given texture coordinates: the one whose
+                texels are at most a pixel wide, along the longest
+                side of the texture
+
+      Args:     const IMipChain& mipChain
+                  Texture sampled
+                float uvPerPixel
+                  Texture coordinates spanned by a pixel
+
+      Returns:  uint32_t
+                  Index of the mip, clamped to the coarsest
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t MipStreamingPolicy::ComputeMip(const IMipChain& mipChain, float uvPerPixel)
+    {
+        if (mipChain.GetNumMips() == 0u)
+        {
+            return 0u;
+        }
+
+        const uint32_t uCoarsestMip = mipChain.GetNumMips() - 1u;
+        const float texelsPerPixel = static_cast<float>((std::max)(mipChain.GetWidth(), mipChain.GetHeight())) * uvPerPixel;
+        if (!(texelsPerPixel > 1.0f))
+        {
+            return 0u;
+        }
+
+        const float mip = std::floor(std::log2(texelsPerPixel));
+        if (mip >= static_cast<float>(uCoarsestMip))
+        {
+            return uCoarsestMip;
+        }
+
+        return static_cast<uint32_t>(mip);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MipStreamingPolicy::evict
+
+      Summary:  Evicts the finest mips of the textures drawn the least
+                recently, the ones requesting the coarsest mips first
+                among those drawn as recently, a mip at a time, until
+                the given bytes are freed: down to the fallback mip for
+                a texture not drawn in the frame, down to the mip
+                requested for the others unless told otherwise
+
+      Args:     const SetResidentMipFunction& fnSetResidentMip
+                  Creates a texture again with its mips from the given
+                  one down
+                uint64_t uBytes
+                  Bytes to free
+                const IMipChain* pKeptMipChain
+                  Texture making room, left as is
+                bool bBelowRequests
+                  true to evict the textures drawn in the frame down
+                  to their fallback mip too
+
+      Modifies: [m_uResidentBytes, m_stats].
+
+      Returns:  uint32_t
+                  Number of textures created again
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t MipStreamingPolicy::evict(const SetResidentMipFunction& fnSetResidentMip, uint64_t uBytes, const IMipChain* pKeptMipChain, bool bBelowRequests)
+    {
+        std::vector<const Entry*> aVictims;
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            if (it->first != pKeptMipChain)
+            {
+                aVictims.push_back(&it->second);
+            }
+        }
+
+        std::sort(aVictims.begin(), aVictims.end(), [](const Entry* pA, const Entry* pB)
+        {
+            return pA->uLastUsedFrame != pB->uLastUsedFrame ? pA->uLastUsedFrame < pB->uLastUsedFrame : pA->uRequestedMip > pB->uRequestedMip;
+        });
+
+        uint32_t uNumEvicted = 0u;
+        uint64_t uFreedBytes = 0ull;
+        for (const Entry* pEntry : aVictims)
+        {
+            if (uFreedBytes >= uBytes)
+            {
+                break;
+            }
+
+            std::shared_ptr<IMipChain> mipChain = pEntry->mipChain.lock();
+            if (!mipChain)
+            {
+                continue;
+            }
+
+            const uint32_t uFloorMip = pEntry->uLastUsedFrame == m_uFrame && !bBelowRequests ? pEntry->uRequestedMip : mipChain->GetFallbackMip();
+            const uint64_t uResidentSize = mipChain->GetMipChainSize(mipChain->GetResidentMip());
+
+            uint32_t uMip = mipChain->GetResidentMip();
+            while (uMip < uFloorMip && uFreedBytes + uResidentSize - mipChain->GetMipChainSize(uMip) < uBytes)
+            {
+                ++uMip;
+            }
+
+            if (uMip == mipChain->GetResidentMip() || !fnSetResidentMip(*mipChain, uMip))
+            {
+                continue;
+            }
+
+            uFreedBytes += uResidentSize - mipChain->GetMipChainSize(uMip);
+            ++uNumEvicted;
+            ++m_stats.uNumEvicted;
+        }
+
+        m_uResidentBytes -= uFreedBytes;
+
+        return uNumEvicted;
+    }
+}
@@ -0,0 +1,127 @@
+/*+===================================================================
+  File:      MIPSTREAMINGPOLICY.H
+
+  Summary:   MipStreamingPolicy header file contains declarations of
+             MipStreamingPolicy class used for the lab samples of Game
+             Graphics Programming course. Only depends on the standard
+             library.
+
+  Classes: MipStreamingPolicy
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+#include "Texture/MipChain.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   TextureStreamingStats
+
+      Summary:  Number of streamed textures drawn at least once, of
+                those still waiting for the mips they were drawn with,
+                and of textures given finer mips or evicted since the
+                construction. Then the bytes of video memory of the
+                mips resident, of the mips the last frame asked for,
+                and the budget
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct TextureStreamingStats
+    {
+        uint32_t uNumTextures;
+        uint32_t uNumPending;
+        uint32_t uNumStreamedIn;
+        uint32_t uNumEvicted;
+        uint64_t uResidentBytes;
+        uint64_t uRequestedBytes;
+        uint64_t uBudgetBytes;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    MipStreamingPolicy
+
+      Summary:  Decides which mips of the streamed textures are
+                resident, without the textures. Keeps the finest mip
+                each texture was requested with in the frame, and on
+                Update streams in at most MAX_STREAM_INS_PER_UPDATE
+                textures, those missing the most mips first. When the
+                mips resident would exceed the budget, the fine mips of
+                the textures drawn the least recently are evicted
+                first: down to the fallback for the textures not drawn
+                in the frame, down to the mip requested for the others.
+                A texture that still does not fit gets the finest mip
+                that does. If the budget is still exceeded, the
+                textures drawn lose mips they requested too, those
+                requesting the coarsest first. The mips are changed
+                through the function given to Update. Not synchronized
+
+      Methods:  Request
+                  Requests the mips a draw of a texture needs
+                Update
+                  Streams mips in and out for the frame requested
+                SetBudget
+                  Sets the video memory the mips may take
+                GetBudget
+                  Returns the video memory the mips may take
+                GetStats
+                  Returns the counters and the memory of the mips
+                ComputeMip
+                  Returns the mip a texture is sampled from
+                evict
+                  Evicts mips of the least recently drawn textures
+                MipStreamingPolicy
+                  Constructor.
+                ~MipStreamingPolicy
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class MipStreamingPolicy final
+    {
+    public:
+        static constexpr const uint64_t DEFAULT_BUDGET = 256ull * 1024ull * 1024ull;
+
+        // Textures given finer mips per Update, bounding the time spent creating them between two frames
+        static constexpr const uint32_t MAX_STREAM_INS_PER_UPDATE = 4u;
+
+        // Makes the given mip the finest resident, returns false if the texture could not be created again
+        using SetResidentMipFunction = std::function<bool(IMipChain& mipChain, uint32_t uMip)>;
+
+        MipStreamingPolicy();
+        MipStreamingPolicy(const MipStreamingPolicy& other) = delete;
+        MipStreamingPolicy(MipStreamingPolicy&& other) = delete;
+        MipStreamingPolicy& operator=(const MipStreamingPolicy& other) = delete;
+        MipStreamingPolicy& operator=(MipStreamingPolicy&& other) = delete;
+        ~MipStreamingPolicy() = default;
+
+        void Request(const std::shared_ptr<IMipChain>& mipChain, float uvPerPixel);
+        uint32_t Update(const SetResidentMipFunction& fnSetResidentMip);
+
+        void SetBudget(uint64_t uBudgetBytes);
+        uint64_t GetBudget() const;
+        const TextureStreamingStats& GetStats() const;
+
+        static uint32_t ComputeMip(const IMipChain& mipChain, float uvPerPixel);
+
+    private:
+        struct Entry
+        {
+            std::weak_ptr<IMipChain> mipChain;
+            uint32_t uRequestedMip;
+            uint64_t uLastUsedFrame;
+        };
+
+    private:
+        uint32_t evict(const SetResidentMipFunction& fnSetResidentMip, uint64_t uBytes, const IMipChain* pKeptMipChain, bool bBelowRequests);
+
+    private:
+        std::unordered_map<const IMipChain*, Entry> m_entries;
+        uint64_t m_uFrame;
+        uint64_t m_uBudgetBytes;
+        uint64_t m_uResidentBytes;
+        TextureStreamingStats m_stats;
+    };
+}
@@ -1,7 +1,7 @@
 #include "Texture.h"
 
 #include "Texture/DDSTextureLoader.h"
-#include "Texture/WICTextureLoader.h"
+#include "Texture/MipGenerator.h"
 
 namespace library
 {
@@ -16,16 +16,34 @@ namespace library
                   Path to the texture to use
                 eTextureSamplerType textureSamplerType
                   Texture sampler type of this texture
+                eTextureContent textureContent
+                  What the texels of this texture mean
+                BOOL bStreamable
+                  Whether the mips of this texture are streamed in and
+                  out by a TextureStreamer once it is created
 
-      Modifies: [m_filePath, m_textureRV, m_textureSamplerType].
+      Modifies: [m_filePath, m_textureRV, m_textureSamplerType,
+                 m_textureContent, m_file, m_aMips, m_format,
+                 m_uWidth, m_uHeight, m_uNumMips, m_uResidentMip,
+                 m_bStreamable, m_bStreamed].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     /*--------------------------------------------------------------------
       TODO: Texture::Texture definition (remove the comment)
     --------------------------------------------------------------------*/
-    Texture::Texture(_In_ const std::filesystem::path& filePath, _In_opt_ eTextureSamplerType textureSamplerType/* = eTextureSamplerType::TRILINEAR_WRAP*/)
+    Texture::Texture(_In_ const std::filesystem::path& filePath, _In_opt_ eTextureSamplerType textureSamplerType/* = eTextureSamplerType::TRILINEAR_WRAP*/, _In_opt_ eTextureContent textureContent/* = eTextureContent::COLOR*/, _In_opt_ BOOL bStreamable/* = FALSE*/)
         : m_filePath(filePath)
         , m_textureRV()
         , m_textureSamplerType(textureSamplerType)
+        , m_textureContent(textureContent)
+        , m_file()
+        , m_aMips()
+        , m_format(DXGI_FORMAT_UNKNOWN)
+        , m_uWidth(0u)
+        , m_uHeight(0u)
+        , m_uNumMips(0u)
+        , m_uResidentMip(0u)
+        , m_bStreamable(bStreamable)
+        , m_bStreamed(FALSE)
     {
 
     }
@@ -33,35 +51,196 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Texture::Initialize
 
-      Summary:  Initializes the texture and samplers if not initialized
+      Summary:  Initializes the texture and samplers if not initialized,
+                decoding the image on the calling thread
 
       Args:     ID3D11Device* pDevice
                   The Direct3D device to create the buffers
                 ID3D11DeviceContext* pImmediateContext
                   The Direct3D context to set buffers
 
-      Modifies: [m_textureRV].
+      Modifies: [m_textureRV, m_file, m_aMips, m_format, m_uWidth,
+                 m_uHeight, m_uNumMips, m_uResidentMip, m_bStreamable,
+                 m_bStreamed].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT Texture::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
     {
-        HRESULT hr = CreateWICTextureFromFile(
-            pDevice,
-            pImmediateContext,
-            m_filePath.c_str(),
-            nullptr,
-            m_textureRV.GetAddressOf()
-        );
+        UNREFERENCED_PARAMETER(pImmediateContext);
+
+        HRESULT hr = Decode();
         if (FAILED(hr))
         {
-            hr = CreateDDSTextureFromFile(pDevice, m_filePath.c_str(), nullptr, m_textureRV.GetAddressOf());
-            if (FAILED(hr))
+            return hr;
+        }
+
+        return Upload(pDevice);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::Decode
+
+      Summary:  Maps the file of the texture. A DDS file stays mapped
+                until Upload creates the texture from it in place, once
+                its header and sizes are checked against the file, any
+                other image is decoded by WIC to RGBA and its mips are
+                generated by the MipGenerator, filtered as its content
+                requires. Only a single 2D texture is streamed. Touches
+                no Direct3D object, so it runs on the loader threads;
+                the thread must have initialized COM
+
+      Modifies: [m_file, m_aMips, m_format, m_uWidth, m_uHeight,
+                 m_uNumMips, m_bStreamable].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Texture::Decode()
+    {
+        HRESULT hr = m_file.Open(m_filePath);
+        if (FAILED(hr))
+        {
+            OutputDebugString(L"Can't load texture from \"");
+            OutputDebugString(m_filePath.c_str());
+            OutputDebugString(L"\n");
+            return hr;
+        }
+
+        if (m_file.GetSize() >= sizeof(DDS_MAGIC) && memcmp(m_file.GetData(), &DDS_MAGIC, sizeof(DDS_MAGIC)) == 0)
+        {
+            DDS_TEXTURE_LAYOUT layout;
+            hr = ValidateDDSTextureMemory(m_file.GetData(), m_file.GetSize(), &layout);
+            if (SUCCEEDED(hr))
             {
-                OutputDebugString(L"Can't load texture from \"");
-                OutputDebugString(m_filePath.c_str());
-                OutputDebugString(L"\n");
-                return hr;
+                m_format = layout.format;
+                m_uWidth = layout.width;
+                m_uHeight = layout.height;
+                m_uNumMips = layout.mipCount;
+                m_bStreamable = m_bStreamable && layout.resourceDimension == D3D11_RESOURCE_DIMENSION_TEXTURE2D && layout.arraySize == 1u;
             }
         }
+        else
+        {
+            hr = decodeImage();
+            m_file.Close();
+
+            m_format = DXGI_FORMAT_R8G8B8A8_UNORM;
+            m_uNumMips = static_cast<UINT>(m_aMips.size());
+        }
+
+        if (FAILED(hr))
+        {
+            m_file.Close();
+
+            OutputDebugString(L"Can't load texture from \"");
+            OutputDebugString(m_filePath.c_str());
+            OutputDebugString(L"\n");
+            return hr;
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::Upload
+
+      Summary:  Creates the texture from what Decode left, a DDS
+                straight from the mapped file, and frees it, and the
+                samplers if not created. A streamed texture is created
+                with its fallback mips only and keeps what Decode left,
+                for the TextureStreamer to create its finer mips
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the texture
+
+      Modifies: [m_textureRV, m_file, m_aMips, m_uResidentMip,
+                 m_bStreamed].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Texture::Upload(_In_ ID3D11Device* pDevice)
+    {
+        if (!m_file.GetData() && m_aMips.empty())
+        {
+            return E_UNEXPECTED;
+        }
+
+        m_bStreamed = m_bStreamable && m_uNumMips > 1u;
+
+        HRESULT hr = createResource(pDevice, m_bStreamed ? GetFallbackMip() : 0u);
+        if (FAILED(hr))
+        {
+            m_bStreamed = FALSE;
+        }
+
+        if (!m_bStreamed)
+        {
+            m_file.Close();
+            m_aMips = std::vector<std::vector<BYTE>>();
+        }
+
+        if (FAILED(hr))
+        {
+            OutputDebugString(L"Can't create texture from \"");
+            OutputDebugString(m_filePath.c_str());
+            OutputDebugString(L"\n");
+            return hr;
+        }
+
+        return createSamplers(pDevice);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::SetResidentMip
+
+      Summary:  Creates the texture again with its mips from the given
+                one down, from the file or mips kept since Decode. The
+                texture keeps its view if it cannot be created
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the texture
+                UINT uMip
+                  Finest mip to be resident, clamped to the coarsest
+
+      Modifies: [m_textureRV, m_uResidentMip].
+
+      Returns:  HRESULT
+                  Status code, E_UNEXPECTED if the texture is not
+                  streamed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Texture::SetResidentMip(_In_ ID3D11Device* pDevice, _In_ UINT uMip)
+    {
+        if (!m_bStreamed)
+        {
+            return E_UNEXPECTED;
+        }
+
+        uMip = (std::min)(uMip, m_uNumMips - 1u);
+        if (uMip == m_uResidentMip)
+        {
+            return S_OK;
+        }
+
+        return createResource(pDevice, uMip);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::createSamplers
+
+      Summary:  Creates the samplers shared by every texture if not
+                created
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the samplers
+
+      Modifies: [s_samplers].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Texture::createSamplers(_In_ ID3D11Device* pDevice)
+    {
+        HRESULT hr = S_OK;
 
         // Create the sample state
         if (!s_samplers[static_cast<size_t>(eTextureSamplerType::TRILINEAR_WRAP)].Get())
@@ -82,7 +261,7 @@ namespace library
             hr = pDevice->CreateSamplerState(&sampDesc, s_samplers[static_cast<size_t>(eTextureSamplerType::TRILINEAR_WRAP)].GetAddressOf());
             if (FAILED(hr))
             {
-                return hr;
+                return S_OK;
             }
         }
 
@@ -104,11 +283,166 @@ namespace library
             hr = pDevice->CreateSamplerState(&sampDesc, s_samplers[static_cast<size_t>(eTextureSamplerType::TRILINEAR_CLAMP)].GetAddressOf());
             if (FAILED(hr))
             {
-                return hr;
+                return S_OK;
+            }
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::decodeImage
+
+      Summary:  Decodes the mapped image by WIC to RGBA, reading the
+                file where it is mapped, and generates its mips
+
+      Modifies: [m_aMips, m_uWidth, m_uHeight].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Texture::decodeImage()
+    {
+        if (m_file.GetSize() > MAXDWORD)
+        {
+            return HRESULT_FROM_WIN32(ERROR_FILE_TOO_LARGE);
+        }
+
+        ComPtr<IWICImagingFactory> factory;
+        HRESULT hr = CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(factory.GetAddressOf()));
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        ComPtr<IWICStream> stream;
+        hr = factory->CreateStream(stream.GetAddressOf());
+        if (SUCCEEDED(hr))
+        {
+            hr = stream->InitializeFromMemory(const_cast<BYTE*>(m_file.GetData()), static_cast<DWORD>(m_file.GetSize()));
+        }
+
+        ComPtr<IWICBitmapDecoder> decoder;
+        if (SUCCEEDED(hr))
+        {
+            hr = factory->CreateDecoderFromStream(stream.Get(), nullptr, WICDecodeMetadataCacheOnDemand, decoder.GetAddressOf());
+        }
+
+        ComPtr<IWICBitmapFrameDecode> frame;
+        if (SUCCEEDED(hr))
+        {
+            hr = decoder->GetFrame(0u, frame.GetAddressOf());
+        }
+
+        if (SUCCEEDED(hr))
+        {
+            hr = frame->GetSize(&m_uWidth, &m_uHeight);
+        }
+
+        ComPtr<IWICFormatConverter> converter;
+        if (SUCCEEDED(hr))
+        {
+            hr = factory->CreateFormatConverter(converter.GetAddressOf());
+        }
+
+        if (SUCCEEDED(hr))
+        {
+            hr = converter->Initialize(frame.Get(), GUID_WICPixelFormat32bppRGBA, WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeCustom);
+        }
+
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        m_aMips.resize(1u);
+        m_aMips[0].resize(static_cast<size_t>(m_uWidth) * m_uHeight * 4u);
+
+        hr = converter->CopyPixels(nullptr, m_uWidth * 4u, static_cast<UINT>(m_aMips[0].size()), m_aMips[0].data());
+        if (FAILED(hr))
+        {
+            m_aMips.clear();
+            return hr;
+        }
+
+        MipGenerator::GenerateMips(m_textureContent, m_uWidth, m_uHeight, m_aMips);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::createResource
+
+      Summary:  Creates the texture with its mips from the given one
+                down, from the mapped DDS file or the RGBA mips, and
+                replaces the view once it is created
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the texture
+                UINT uFirstMip
+                  Finest mip created
+
+      Modifies: [m_textureRV, m_uResidentMip].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Texture::createResource(_In_ ID3D11Device* pDevice, _In_ UINT uFirstMip)
+    {
+        HRESULT hr = S_OK;
+        ComPtr<ID3D11ShaderResourceView> textureRV;
+
+        if (m_file.GetData())
+        {
+            // DDSTextureLoader skips the mips larger than maxsize a side, 0 keeping them all
+            const size_t uMaxSize = uFirstMip > 0u ? (std::max)((std::max)(m_uWidth >> uFirstMip, m_uHeight >> uFirstMip), 1u) : 0u;
+            hr = CreateDDSTextureFromMemoryEx(pDevice, m_file.GetData(), m_file.GetSize(), uMaxSize, D3D11_USAGE_DEFAULT, D3D11_BIND_SHADER_RESOURCE, 0u, 0u, false, nullptr, textureRV.GetAddressOf());
+        }
+        else
+        {
+            std::vector<D3D11_SUBRESOURCE_DATA> aInitialData(m_uNumMips - uFirstMip);
+            for (UINT uMip = uFirstMip; uMip < m_uNumMips; ++uMip)
+            {
+                aInitialData[uMip - uFirstMip] =
+                {
+                    .pSysMem = m_aMips[uMip].data(),
+                    .SysMemPitch = (std::max)(m_uWidth >> uMip, 1u) * 4u,
+                    .SysMemSlicePitch = 0u
+                };
             }
+
+            D3D11_TEXTURE2D_DESC textureDesc =
+            {
+                .Width = (std::max)(m_uWidth >> uFirstMip, 1u),
+                .Height = (std::max)(m_uHeight >> uFirstMip, 1u),
+                .MipLevels = m_uNumMips - uFirstMip,
+                .ArraySize = 1u,
+                .Format = DXGI_FORMAT_R8G8B8A8_UNORM,
+                .SampleDesc = {.Count = 1u, .Quality = 0u },
+                .Usage = D3D11_USAGE_IMMUTABLE,
+                .BindFlags = D3D11_BIND_SHADER_RESOURCE,
+                .CPUAccessFlags = 0u,
+                .MiscFlags = 0u
+            };
+
+            ComPtr<ID3D11Texture2D> texture;
+            hr = pDevice->CreateTexture2D(&textureDesc, aInitialData.data(), texture.GetAddressOf());
+            if (SUCCEEDED(hr))
+            {
+                hr = pDevice->CreateShaderResourceView(texture.Get(), nullptr, textureRV.GetAddressOf());
+            }
+
         }
 
-        return hr;
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        m_textureRV = std::move(textureRV);
+        m_uResidentMip = uFirstMip;
+
+        return S_OK;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -136,4 +470,245 @@ namespace library
     {
         return m_textureSamplerType;
     }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::GetContent
+
+      Summary:  Returns what the texels mean
+
+      Returns:  eTextureContent
+                  Content of the texture
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    eTextureContent Texture::GetContent() const
+    {
+        return m_textureContent;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::GetMemorySize
+
+      Summary:  Returns the bytes of video memory the texture takes,
+                over every mip and array slice
+
+      Returns:  UINT64
+                  Size of the texture, 0 if it is not loaded
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 Texture::GetMemorySize() const
+    {
+        if (!m_textureRV)
+        {
+            return 0ull;
+        }
+
+        ComPtr<ID3D11Resource> resource;
+        m_textureRV->GetResource(resource.GetAddressOf());
+
+        ComPtr<ID3D11Texture2D> texture2D;
+        if (FAILED(resource.As(&texture2D)))
+        {
+            return 0ull;
+        }
+
+        D3D11_TEXTURE2D_DESC desc;
+        texture2D->GetDesc(&desc);
+
+        return computeMemorySize(desc.Format, desc.Width, desc.Height, desc.MipLevels, desc.ArraySize);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::IsStreamed
+
+      Summary:  Returns whether the mips of the texture are streamed,
+                which is known once it is created
+
+      Returns:  BOOL
+                  TRUE if the texture is streamed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL Texture::IsStreamed() const
+    {
+        return m_bStreamed;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::GetWidth
+
+      Summary:  Returns the width of the finest mip, resident or not
+
+      Returns:  UINT
+                  Width in texels
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Texture::GetWidth() const
+    {
+        return m_uWidth;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::GetHeight
+
+      Summary:  Returns the height of the finest mip, resident or not
+
+      Returns:  UINT
+                  Height in texels
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Texture::GetHeight() const
+    {
+        return m_uHeight;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::GetNumMips
+
+      Summary:  Returns the number of mips of the image, resident or
+                not
+
+      Returns:  UINT
+                  Number of mips
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Texture::GetNumMips() const
+    {
+        return m_uNumMips;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::GetResidentMip
+
+      Summary:  Returns the finest mip of the texture created
+
+      Returns:  UINT
+                  Index of the mip, 0 being the finest of the image
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Texture::GetResidentMip() const
+    {
+        return m_uResidentMip;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::GetFallbackMip
+
+      Summary:  Returns the finest mip of at most
+                STREAMING_FALLBACK_SIZE texels a side, which a streamed
+                texture is created with and evicted down to
+
+      Returns:  UINT
+                  Index of the mip
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Texture::GetFallbackMip() const
+    {
+        UINT uMip = 0u;
+        while (uMip + 1u < m_uNumMips && (std::max)(m_uWidth >> uMip, m_uHeight >> uMip) > STREAMING_FALLBACK_SIZE)
+        {
+            ++uMip;
+        }
+
+        return uMip;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::GetMipChainSize
+
+      Summary:  Returns the bytes of video memory the texture would
+                take with its mips from the given one down
+
+      Args:     UINT uFirstMip
+                  Finest mip, clamped to the coarsest
+
+      Returns:  UINT64
+                  Size of the mips
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 Texture::GetMipChainSize(_In_ UINT uFirstMip) const
+    {
+        if (m_uNumMips == 0u)
+        {
+            return 0ull;
+        }
+
+        uFirstMip = (std::min)(uFirstMip, m_uNumMips - 1u);
+
+        return computeMemorySize(m_format, (std::max)(m_uWidth >> uFirstMip, 1u), (std::max)(m_uHeight >> uFirstMip, 1u), m_uNumMips - uFirstMip, 1u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Texture::computeMemorySize
+
+      Summary:  Returns the bytes of video memory of a 2D texture
+
+      Args:     DXGI_FORMAT format
+                  Format of the texels
+                UINT uWidth
+                  Width of the finest mip
+                UINT uHeight
+                  Height of the finest mip
+                UINT uNumMips
+                  Number of mips
+                UINT uArraySize
+                  Number of array slices
+
+      Returns:  UINT64
+                  Size of the texture
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 Texture::computeMemorySize(_In_ DXGI_FORMAT format, _In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uNumMips, _In_ UINT uArraySize)
+    {
+        // Bytes of a 4x4 block of the compressed formats, of a pixel of the others
+        UINT64 uBlockSize = 0ull;
+        UINT64 uPixelSize = 4ull;
+        switch (format)
+        {
+        case DXGI_FORMAT_BC1_TYPELESS:
+        case DXGI_FORMAT_BC1_UNORM:
+        case DXGI_FORMAT_BC1_UNORM_SRGB:
+        case DXGI_FORMAT_BC4_TYPELESS:
+        case DXGI_FORMAT_BC4_UNORM:
+        case DXGI_FORMAT_BC4_SNORM:
+            uBlockSize = 8ull;
+            break;
+        case DXGI_FORMAT_BC2_TYPELESS:
+        case DXGI_FORMAT_BC2_UNORM:
+        case DXGI_FORMAT_BC2_UNORM_SRGB:
+        case DXGI_FORMAT_BC3_TYPELESS:
+        case DXGI_FORMAT_BC3_UNORM:
+        case DXGI_FORMAT_BC3_UNORM_SRGB:
+        case DXGI_FORMAT_BC5_TYPELESS:
+        case DXGI_FORMAT_BC5_UNORM:
+        case DXGI_FORMAT_BC5_SNORM:
+        case DXGI_FORMAT_BC6H_TYPELESS:
+        case DXGI_FORMAT_BC6H_UF16:
+        case DXGI_FORMAT_BC6H_SF16:
+        case DXGI_FORMAT_BC7_TYPELESS:
+        case DXGI_FORMAT_BC7_UNORM:
+        case DXGI_FORMAT_BC7_UNORM_SRGB:
+            uBlockSize = 16ull;
+            break;
+        case DXGI_FORMAT_R8_UNORM:
+        case DXGI_FORMAT_A8_UNORM:
+            uPixelSize = 1ull;
+            break;
+        case DXGI_FORMAT_R8G8_UNORM:
+        case DXGI_FORMAT_R16_UNORM:
+        case DXGI_FORMAT_R16_FLOAT:
+        case DXGI_FORMAT_B5G6R5_UNORM:
+            uPixelSize = 2ull;
+            break;
+        case DXGI_FORMAT_R16G16B16A16_UNORM:
+        case DXGI_FORMAT_R16G16B16A16_FLOAT:
+        case DXGI_FORMAT_R32G32_FLOAT:
+            uPixelSize = 8ull;
+            break;
+        case DXGI_FORMAT_R32G32B32A32_FLOAT:
+            uPixelSize = 16ull;
+            break;
+        default:
+            break;
+        }
+
+        UINT64 uSize = 0ull;
+        for (UINT uMip = 0u; uMip < uNumMips; ++uMip)
+        {
+            UINT64 uMipWidth = (std::max)(uWidth >> uMip, 1u);
+            UINT64 uMipHeight = (std::max)(uHeight >> uMip, 1u);
+
+            uSize += uBlockSize ? ((uMipWidth + 3ull) / 4ull) * ((uMipHeight + 3ull) / 4ull) * uBlockSize : uMipWidth * uMipHeight * uPixelSize;
+        }
+
+        return uSize * uArraySize;
+    }
 }
\ No newline at end of file
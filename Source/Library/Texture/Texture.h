@@ -12,6 +12,10 @@
 
 #include "Common.h"
 
+#include "Texture/MappedFile.h"
+#include "Texture/MipChain.h"
+#include "Texture/TextureContent.h"
+
 namespace library
 {
     enum class eTextureSamplerType : size_t
@@ -21,11 +25,14 @@ namespace library
         COUNT,
     };
 
-    class Texture
+    class Texture : public IMipChain
     {
     public:
+        // A streamed texture is created with its mips of at most this many texels a side, which are never evicted
+        static constexpr const UINT STREAMING_FALLBACK_SIZE = 64u;
+
         Texture() = delete;
-        Texture(_In_ const std::filesystem::path& filePath, _In_opt_ eTextureSamplerType textureSamplerType = eTextureSamplerType::TRILINEAR_WRAP);
+        Texture(_In_ const std::filesystem::path& filePath, _In_opt_ eTextureSamplerType textureSamplerType = eTextureSamplerType::TRILINEAR_WRAP, _In_opt_ eTextureContent textureContent = eTextureContent::COLOR, _In_opt_ BOOL bStreamable = FALSE);
         Texture(const Texture& other) = delete;
         Texture(Texture&& other) = delete;
         Texture& operator=(const Texture& other) = delete;
@@ -35,15 +42,51 @@ namespace library
         // Should be called once to load the texture
         virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext);
 
+        // Decode can run on any thread, Upload then creates the texture on the rendering thread
+        HRESULT Decode();
+        HRESULT Upload(_In_ ID3D11Device* pDevice);
+
+        // A streamed texture keeps its file or mips after Upload, to create its mips again from any level down
+        HRESULT SetResidentMip(_In_ ID3D11Device* pDevice, _In_ UINT uMip);
+
         ComPtr<ID3D11ShaderResourceView>& GetTextureResourceView();
         eTextureSamplerType GetSamplerType() const;
+        eTextureContent GetContent() const;
+        UINT64 GetMemorySize() const;
+
+        BOOL IsStreamed() const;
+        UINT GetWidth() const override;
+        UINT GetHeight() const override;
+        UINT GetNumMips() const override;
+        UINT GetResidentMip() const override;
+        UINT GetFallbackMip() const override;
+        UINT64 GetMipChainSize(_In_ UINT uFirstMip) const override;
 
     public:
         static ComPtr<ID3D11SamplerState> s_samplers[static_cast<size_t>(eTextureSamplerType::COUNT)];
 
+    protected:
+        static HRESULT createSamplers(_In_ ID3D11Device* pDevice);
+        static UINT64 computeMemorySize(_In_ DXGI_FORMAT format, _In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uNumMips, _In_ UINT uArraySize);
+
+        HRESULT decodeImage();
+        HRESULT createResource(_In_ ID3D11Device* pDevice, _In_ UINT uFirstMip);
+
     protected:
         std::filesystem::path m_filePath;
         ComPtr<ID3D11ShaderResourceView> m_textureRV;
         eTextureSamplerType m_textureSamplerType;
+        eTextureContent m_textureContent;
+
+        // Decoded data waiting for Upload, kept while streamed: the mapped file of a DDS, the RGBA mips of another image
+        MappedFile m_file;
+        std::vector<std::vector<BYTE>> m_aMips;
+        DXGI_FORMAT m_format;
+        UINT m_uWidth;
+        UINT m_uHeight;
+        UINT m_uNumMips;
+        UINT m_uResidentMip;
+        BOOL m_bStreamable;
+        BOOL m_bStreamed;
     };
 }
\ No newline at end of file
@@ -0,0 +1,189 @@
+#include "Texture/TextureCache.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCache::TextureCache
+
+      Summary:  Constructor
+
+      Modifies: [m_mutex, m_index].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TextureCache::TextureCache()
+        : m_mutex()
+        , m_index()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCache::GetOrLoad
+
+      Summary:  Returns the texture of an image that is still alive,
+                found by path or else by contents, or creates it and
+                queues it on a loader. A texture is cached as soon as
+                it is created, so an image failing to load fails once.
+                The file is only hashed on a miss of its path, without
+                the lock, and the path and the contents are looked up
+                again after since another request may have inserted
+                them meanwhile. The textures created are streamable
+
+      Args:     const std::filesystem::path& filePath
+                  Path to the image
+                eTextureSamplerType textureSamplerType
+                  Texture sampler type of the texture
+                eTextureContent textureContent
+                  What the texels of the texture mean
+                TextureLoader& loader
+                  Loader of the textures created
+
+      Modifies: [m_index].
+
+      Returns:  std::shared_ptr<Texture>
+                  Texture of the image, possibly still loading
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::shared_ptr<Texture> TextureCache::GetOrLoad(_In_ const std::filesystem::path& filePath, _In_ eTextureSamplerType textureSamplerType, _In_ eTextureContent textureContent, _In_ TextureLoader& loader)
+    {
+        const std::wstring pathKey = TextureCacheIndex::MakePathKey(filePath, static_cast<UINT>(textureSamplerType), static_cast<UINT>(textureContent));
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            std::shared_ptr<void> entry = m_index.Find(pathKey, nullptr);
+            if (entry)
+            {
+                return std::static_pointer_cast<Texture>(entry);
+            }
+        }
+
+        UINT64 uContentHash = 0ull;
+        const UINT64* puContentHash = hashFile(filePath, textureSamplerType, textureContent, uContentHash) ? &uContentHash : nullptr;
+
+        std::shared_ptr<Texture> texture;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            std::shared_ptr<void> entry = m_index.Find(pathKey, puContentHash);
+            if (entry)
+            {
+                return std::static_pointer_cast<Texture>(entry);
+            }
+
+            texture = std::make_shared<Texture>(filePath, textureSamplerType, textureContent, TRUE);
+            m_index.Insert(pathKey, puContentHash, texture);
+        }
+
+        loader.Enqueue(texture);
+
+        return texture;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCache::Purge
+
+      Summary:  Drops the entries of the textures no material
+                references anymore
+
+      Modifies: [m_index].
+
+      Returns:  UINT
+                  Number of entries dropped
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TextureCache::Purge()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return m_index.Purge();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCache::GetNumTextures
+
+      Summary:  Returns the number of cached textures still referenced
+
+      Returns:  UINT
+                  Number of textures alive
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TextureCache::GetNumTextures() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        std::vector<TextureCacheShare> aShares;
+        m_index.GetShares(aShares);
+
+        return static_cast<UINT>(aShares.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCache::GetStats
+
+      Summary:  Returns the counters since the construction, and the
+                memory of the textures alive: the bytes they take, and
+                the bytes each request they served after the first
+                would have loaded again. Called on the rendering
+                thread, where the textures are created
+
+      Returns:  TextureCacheStats
+                  Hits, misses and bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TextureCacheStats TextureCache::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        const TextureCacheCounts& counts = m_index.GetCounts();
+        TextureCacheStats stats =
+        {
+            .uNumPathHits = counts.uNumPathHits,
+            .uNumContentHits = counts.uNumContentHits,
+            .uNumMisses = counts.uNumMisses,
+            .uBytesLoaded = 0ull,
+            .uBytesSaved = 0ull,
+        };
+
+        std::vector<TextureCacheShare> aShares;
+        m_index.GetShares(aShares);
+        for (const TextureCacheShare& share : aShares)
+        {
+            const UINT64 uSize = static_cast<const Texture*>(share.entry.get())->GetMemorySize();
+
+            stats.uBytesLoaded += uSize;
+            stats.uBytesSaved += uSize * share.uNumDeduplicated;
+        }
+
+        return stats;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCache::hashFile
+
+      Summary:  Hashes the bytes of a file where they are mapped, the
+                sampler type and the content
+
+      Args:     const std::filesystem::path& filePath
+                  File to hash
+                eTextureSamplerType textureSamplerType
+                  Texture sampler type of the texture
+                eTextureContent textureContent
+                  What the texels of the texture mean
+                UINT64& uHash
+                  Hash of the contents
+
+      Modifies: [uHash].
+
+      Returns:  BOOL
+                  FALSE if the file cannot be read or is empty
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL TextureCache::hashFile(_In_ const std::filesystem::path& filePath, _In_ eTextureSamplerType textureSamplerType, _In_ eTextureContent textureContent, _Out_ UINT64& uHash)
+    {
+        uHash = TextureCacheIndex::FNV_OFFSET_BASIS;
+
+        MappedFile file;
+        if (FAILED(file.Open(filePath)))
+        {
+            return FALSE;
+        }
+
+        uHash = TextureCacheIndex::HashContents(file.GetData(), file.GetSize(), static_cast<UINT>(textureSamplerType), static_cast<UINT>(textureContent));
+
+        return TRUE;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+/*+===================================================================
+  File:      TEXTURECACHE.H
+
+  Summary:   TextureCache header file contains declarations of
+             TextureCache class used for the lab samples of Game
+             Graphics Programming course.
+
+  Classes: TextureCache
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <mutex>
+
+#include "Texture/TextureCacheIndex.h"
+#include "Texture/TextureLoader.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   TextureCacheStats
+
+      Summary:  Number of requests served by a texture already loaded,
+                by path or by contents, and of textures loaded. Then
+                the bytes of video memory of the textures alive, and
+                the bytes the requests they served would have loaded
+                again without the cache
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct TextureCacheStats
+    {
+        UINT uNumPathHits;
+        UINT uNumContentHits;
+        UINT uNumMisses;
+        UINT64 uBytesLoaded;
+        UINT64 uBytesSaved;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    TextureCache
+
+      Summary:  Hands out one texture per image, so materials sharing
+                an image share its decoded texture. A texture is found
+                by its normalized path first, then by a hash of the
+                bytes of its file, which catches copies of an image
+                under other names. The cache only holds weak
+                references: a texture lives as long as a material
+                references it, and is loaded again if requested after
+                the last one let it go. Textures are loaded in the
+                background by a TextureLoader. The lock is only held
+                to look up and insert, a file is hashed without it
+
+      Methods:  GetOrLoad
+                  Returns the texture of an image, loading it once
+                Purge
+                  Drops the entries of released textures
+                GetNumTextures
+                  Returns the number of textures alive
+                GetStats
+                  Returns the counters and the memory of the textures
+                hashFile
+                  Hashes the bytes of a file
+                TextureCache
+                  Constructor.
+                ~TextureCache
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class TextureCache final
+    {
+    public:
+        TextureCache();
+        TextureCache(const TextureCache& other) = delete;
+        TextureCache(TextureCache&& other) = delete;
+        TextureCache& operator=(const TextureCache& other) = delete;
+        TextureCache& operator=(TextureCache&& other) = delete;
+        ~TextureCache() = default;
+
+        std::shared_ptr<Texture> GetOrLoad(_In_ const std::filesystem::path& filePath, _In_ eTextureSamplerType textureSamplerType, _In_ eTextureContent textureContent, _In_ TextureLoader& loader);
+        UINT Purge();
+
+        UINT GetNumTextures() const;
+        TextureCacheStats GetStats() const;
+
+    private:
+        static BOOL hashFile(_In_ const std::filesystem::path& filePath, _In_ eTextureSamplerType textureSamplerType, _In_ eTextureContent textureContent, _Out_ UINT64& uHash);
+
+    private:
+        mutable std::mutex m_mutex;
+        TextureCacheIndex m_index;
+    };
+}
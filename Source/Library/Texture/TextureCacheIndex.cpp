@@ -0,0 +1,286 @@
+#include "Texture/TextureCacheIndex.h"
+
+#include <algorithm>
+#include <cwctype>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCacheIndex::TextureCacheIndex
+
+      Summary:  Constructor
+
+      Modifies: [m_pathEntries, m_contentEntries, m_records, m_counts].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TextureCacheIndex::TextureCacheIndex()
+        : m_pathEntries()
+        , m_contentEntries()
+        , m_records()
+        , m_counts()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCacheIndex::Find
+
+      Summary:  Returns the entry of a path that is still alive, or
+                else the entry of the same contents, which is then
+                cached under the path too. A hit counts as a request
+                served by the entry
+
+      Args:     const std::wstring& pathKey
+                  Key of the path, from MakePathKey
+                const uint64_t* puContentHash
+                  Hash of the contents, from HashContents, nullptr
+                  to only look up the path
+
+      Modifies: [m_pathEntries, m_records, m_counts].
+
+      Returns:  std::shared_ptr<void>
+                  Entry found, nullptr on a miss
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::shared_ptr<void> TextureCacheIndex::Find(const std::wstring& pathKey, const uint64_t* puContentHash)
+    {
+        auto pathIt = m_pathEntries.find(pathKey);
+        if (pathIt != m_pathEntries.end())
+        {
+            std::shared_ptr<void> entry = share(pathIt->second);
+            if (entry)
+            {
+                ++m_counts.uNumPathHits;
+
+                return entry;
+            }
+        }
+
+        if (!puContentHash)
+        {
+            return nullptr;
+        }
+
+        auto contentIt = m_contentEntries.find(*puContentHash);
+        if (contentIt != m_contentEntries.end())
+        {
+            std::shared_ptr<void> entry = share(contentIt->second);
+            if (entry)
+            {
+                ++m_counts.uNumContentHits;
+
+                m_pathEntries[pathKey] = entry;
+
+                return entry;
+            }
+        }
+
+        return nullptr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCacheIndex::Insert
+
+      Summary:  Caches the entry created on a miss under its path and
+                its contents
+
+      Args:     const std::wstring& pathKey
+                  Key of the path, from MakePathKey
+                const uint64_t* puContentHash
+                  Hash of the contents, nullptr if the file could not
+                  be hashed
+                const std::shared_ptr<void>& entry
+                  Entry of the path
+
+      Modifies: [m_pathEntries, m_contentEntries, m_records, m_counts].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureCacheIndex::Insert(const std::wstring& pathKey, const uint64_t* puContentHash, const std::shared_ptr<void>& entry)
+    {
+        ++m_counts.uNumMisses;
+
+        m_pathEntries[pathKey] = entry;
+        if (puContentHash)
+        {
+            m_contentEntries[*puContentHash] = entry;
+        }
+
+        // A record left by a released entry at the same address starts over
+        m_records[entry.get()] = Record{ .entry = entry, .uNumDeduplicated = 0u };
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCacheIndex::Purge
+
+      Summary:  Drops the entries nothing references anymore
+
+      Modifies: [m_pathEntries, m_contentEntries, m_records].
+
+      Returns:  uint32_t
+                  Number of path and content entries dropped
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint32_t TextureCacheIndex::Purge()
+    {
+        const size_t uNumEntries = m_pathEntries.size() + m_contentEntries.size();
+
+        std::erase_if(m_pathEntries, [](const auto& entry) { return entry.second.expired(); });
+        std::erase_if(m_contentEntries, [](const auto& entry) { return entry.second.expired(); });
+        std::erase_if(m_records, [](const auto& record) { return record.second.entry.expired(); });
+
+        return static_cast<uint32_t>(uNumEntries - m_pathEntries.size() - m_contentEntries.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCacheIndex::GetShares
+
+      Summary:  Returns every entry alive once, with the number of
+                requests it served after the one inserting it
+
+      Args:     std::vector<TextureCacheShare>& aShares
+                  Entries alive, replacing the previous contents
+
+      Modifies: [aShares].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureCacheIndex::GetShares(std::vector<TextureCacheShare>& aShares) const
+    {
+        aShares.clear();
+        for (const auto& record : m_records)
+        {
+            std::shared_ptr<void> entry = record.second.entry.lock();
+            if (entry)
+            {
+                aShares.push_back(TextureCacheShare{ .entry = std::move(entry), .uNumDeduplicated = record.second.uNumDeduplicated });
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCacheIndex::GetCounts
+
+      Summary:  Returns the hits and misses since the construction
+
+      Returns:  const TextureCacheCounts&
+                  Counters
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const TextureCacheCounts& TextureCacheIndex::GetCounts() const
+    {
+        return m_counts;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCacheIndex::MakePathKey
+
+      Summary:  Returns the key of a path: the path made absolute and
+                normal, in lower case since paths on Windows ignore
+                the case and model files disagree on it, followed by
+                the sampler type and the content
+
+      Args:     const std::filesystem::path& filePath
+                  Path to the image
+                uint32_t uSamplerType
+                  Texture sampler type of the texture
+                uint32_t uContent
+                  What the texels of the texture mean
+
+      Returns:  std::wstring
+                  Key of the path
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::wstring TextureCacheIndex::MakePathKey(const std::filesystem::path& filePath, uint32_t uSamplerType, uint32_t uContent)
+    {
+        std::error_code ec;
+        std::filesystem::path normalPath = std::filesystem::weakly_canonical(filePath, ec);
+        if (ec)
+        {
+            normalPath = filePath.lexically_normal();
+        }
+
+        std::wstring key = normalPath.wstring();
+        std::transform(key.begin(), key.end(), key.begin(), [](wchar_t c) { return static_cast<wchar_t>(std::towlower(static_cast<std::wint_t>(c))); });
+
+        key += L'|';
+        key += std::to_wstring(uSamplerType);
+        key += L'|';
+        key += std::to_wstring(uContent);
+
+        return key;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCacheIndex::HashContents
+
+      Summary:  Hashes the bytes of a file, the sampler type and the
+                content
+
+      Args:     const void* pData
+                  Bytes of the file
+                size_t uSize
+                  Number of bytes
+                uint32_t uSamplerType
+                  Texture sampler type of the texture
+                uint32_t uContent
+                  What the texels of the texture mean
+
+      Returns:  uint64_t
+                  Hash of the contents
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint64_t TextureCacheIndex::HashContents(const void* pData, size_t uSize, uint32_t uSamplerType, uint32_t uContent)
+    {
+        const uint64_t uSize64 = uSize;
+
+        uint64_t uHash = FNV_OFFSET_BASIS;
+        uHash = hashBytes(&uSamplerType, sizeof(uSamplerType), uHash);
+        uHash = hashBytes(&uContent, sizeof(uContent), uHash);
+        uHash = hashBytes(&uSize64, sizeof(uSize64), uHash);
+        uHash = hashBytes(pData, uSize, uHash);
+
+        return uHash;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCacheIndex::share
+
+      Summary:  Takes a reference to an entry found, counting the
+                request it serves
+
+      Args:     const std::weak_ptr<void>& entry
+                  Entry found
+
+      Modifies: [m_records].
+
+      Returns:  std::shared_ptr<void>
+                  Entry, nullptr if it was released
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::shared_ptr<void> TextureCacheIndex::share(const std::weak_ptr<void>& entry)
+    {
+        std::shared_ptr<void> sharedEntry = entry.lock();
+        if (sharedEntry)
+        {
+            ++m_records[sharedEntry.get()].uNumDeduplicated;
+        }
+
+        return sharedEntry;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCacheIndex::hashBytes
+
+      Summary:  Folds bytes into a 64-bit FNV-1a hash
+
+      Args:     const void* pData
+                  Bytes to hash
+                size_t uSize
+                  Number of bytes
+                uint64_t uHash
+                  Hash so far, FNV_OFFSET_BASIS to start
+
+      Returns:  uint64_t
+                  Hash including the bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    uint64_t TextureCacheIndex::hashBytes(const void* pData, size_t uSize, uint64_t uHash)
+    {
+        const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+        for (size_t i = 0u; i < uSize; ++i)
+        {
+            uHash ^= pBytes[i];
+            uHash *= FNV_PRIME;
+        }
+
+        return uHash;
+    }
+}
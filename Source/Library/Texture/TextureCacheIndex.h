@@ -0,0 +1,122 @@
+/*+===================================================================
+  File:      TEXTURECACHEINDEX.H
+
+  Summary:   TextureCacheIndex header file contains declarations of
+             TextureCacheIndex class used for the lab samples of Game
+             Graphics Programming course. Only depends on the standard
+             library.
+
+  Classes: TextureCacheIndex
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   TextureCacheCounts
+
+      Summary:  Number of requests served by an entry already cached,
+                by path or by contents, and of entries inserted
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct TextureCacheCounts
+    {
+        uint32_t uNumPathHits;
+        uint32_t uNumContentHits;
+        uint32_t uNumMisses;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   TextureCacheShare
+
+      Summary:  Entry alive in the cache, and the number of requests it
+                served after the one that inserted it
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct TextureCacheShare
+    {
+        std::shared_ptr<void> entry;
+        uint32_t uNumDeduplicated;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    TextureCacheIndex
+
+      Summary:  Lookup of the TextureCache, without the textures. Finds
+                an entry by the key of its path, then by the hash of
+                its contents, and only holds weak references to them.
+                Counts the requests each entry served beyond the first
+                so the memory saved does not depend on who else holds
+                a reference. Not synchronized, the cache locks around
+                it
+
+      Methods:  Find
+                  Returns the entry of a path or contents, if alive
+                Insert
+                  Caches the entry of a path and contents
+                Purge
+                  Drops the entries released
+                GetShares
+                  Returns every entry alive and the requests it served
+                GetCounts
+                  Returns the hits and misses
+                MakePathKey
+                  Returns the key of a path
+                HashContents
+                  Hashes the bytes of a file
+                share
+                  Takes a reference to an entry found
+                hashBytes
+                  Folds bytes into a 64-bit FNV-1a hash
+                TextureCacheIndex
+                  Constructor.
+                ~TextureCacheIndex
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class TextureCacheIndex final
+    {
+    public:
+        static constexpr const uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+        static constexpr const uint64_t FNV_PRIME = 0x100000001b3ull;
+
+        TextureCacheIndex();
+        TextureCacheIndex(const TextureCacheIndex& other) = delete;
+        TextureCacheIndex(TextureCacheIndex&& other) = delete;
+        TextureCacheIndex& operator=(const TextureCacheIndex& other) = delete;
+        TextureCacheIndex& operator=(TextureCacheIndex&& other) = delete;
+        ~TextureCacheIndex() = default;
+
+        std::shared_ptr<void> Find(const std::wstring& pathKey, const uint64_t* puContentHash);
+        void Insert(const std::wstring& pathKey, const uint64_t* puContentHash, const std::shared_ptr<void>& entry);
+        uint32_t Purge();
+
+        void GetShares(std::vector<TextureCacheShare>& aShares) const;
+        const TextureCacheCounts& GetCounts() const;
+
+        static std::wstring MakePathKey(const std::filesystem::path& filePath, uint32_t uSamplerType, uint32_t uContent);
+        static uint64_t HashContents(const void* pData, size_t uSize, uint32_t uSamplerType, uint32_t uContent);
+
+    private:
+        struct Record
+        {
+            std::weak_ptr<void> entry;
+            uint32_t uNumDeduplicated;
+        };
+
+        std::shared_ptr<void> share(const std::weak_ptr<void>& entry);
+        static uint64_t hashBytes(const void* pData, size_t uSize, uint64_t uHash);
+
+    private:
+        std::unordered_map<std::wstring, std::weak_ptr<void>> m_pathEntries;
+        std::unordered_map<uint64_t, std::weak_ptr<void>> m_contentEntries;
+        std::unordered_map<const void*, Record> m_records;
+        TextureCacheCounts m_counts;
+    };
+}
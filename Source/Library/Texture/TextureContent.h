@@ -0,0 +1,24 @@
+/*+===================================================================
+  File:      TEXTURECONTENT.H
+
+  Summary:   TextureContent header file contains the eTextureContent
+             enumeration used for the lab samples of Game Graphics
+             Programming course. Only depends on the standard library.
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <cstddef>
+
+namespace library
+{
+    // What the texels mean, which decides how the mips are filtered
+    enum class eTextureContent : size_t
+    {
+        COLOR = 0,
+        NORMAL,
+        DATA,
+        COUNT,
+    };
+}
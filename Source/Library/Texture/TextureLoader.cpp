@@ -0,0 +1,209 @@
+#include "Texture/TextureLoader.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureLoader::TextureLoader
+
+      Summary:  Constructor. Decodes on as many workers as there are
+                cores, up to MAX_CONCURRENT_DECODES
+
+      Modifies: [m_decodeQueue, m_aDecoded, m_uNumLoaded, m_uNumFailed].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TextureLoader::TextureLoader()
+        : m_decodeQueue((std::min)((std::max)(std::thread::hardware_concurrency(), 1u), MAX_CONCURRENT_DECODES))
+        , m_aDecoded()
+        , m_uNumLoaded(0u)
+        , m_uNumFailed(0u)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureLoader::~TextureLoader
+
+      Summary:  Destructor. Stops the workers
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TextureLoader::~TextureLoader()
+    {
+        Stop();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureLoader::Enqueue
+
+      Summary:  Queues a texture to be decoded by a worker, starting
+                the workers if not started
+
+      Args:     const std::shared_ptr<Texture>& texture
+                  Texture to load, kept alive until it is created
+
+      Modifies: [m_decodeQueue].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureLoader::Enqueue(_In_ const std::shared_ptr<Texture>& texture)
+    {
+        m_decodeQueue.Enqueue(std::make_unique<TextureDecodeJob>(texture));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureLoader::Update
+
+      Summary:  Creates the textures decoded since the last call. Called
+                on the rendering thread between two frames; logs the
+                load time when the last pending texture is created
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the textures
+
+      Modifies: [m_decodeQueue, m_aDecoded, m_uNumLoaded, m_uNumFailed].
+
+      Returns:  UINT
+                  Number of textures created
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TextureLoader::Update(_In_ ID3D11Device* pDevice)
+    {
+        m_decodeQueue.TakeDecoded(m_aDecoded);
+        if (m_aDecoded.empty())
+        {
+            return 0u;
+        }
+
+        UINT uNumCreated = 0u;
+        for (const std::unique_ptr<DecodeJob>& job : m_aDecoded)
+        {
+            TextureDecodeJob& decodeJob = static_cast<TextureDecodeJob&>(*job);
+
+            HRESULT hr = decodeJob.m_hr;
+            if (SUCCEEDED(hr))
+            {
+                hr = decodeJob.m_texture->Upload(pDevice);
+            }
+
+            if (SUCCEEDED(hr))
+            {
+                ++uNumCreated;
+                ++m_uNumLoaded;
+            }
+            else
+            {
+                ++m_uNumFailed;
+            }
+        }
+
+        const UINT uNumDecoded = static_cast<UINT>(m_aDecoded.size());
+        m_aDecoded.clear();
+
+        if (m_decodeQueue.Finish(uNumDecoded))
+        {
+            CHAR szMessage[128];
+            sprintf_s(szMessage, "Loaded %u textures (%u failed) in %.1f ms\n", m_uNumLoaded, m_uNumFailed, m_decodeQueue.GetLoadTime());
+            OutputDebugStringA(szMessage);
+        }
+
+        return uNumCreated;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureLoader::Stop
+
+      Summary:  Stops the workers once they finish the textures they
+                are decoding. The textures still queued are dropped
+
+      Modifies: [m_decodeQueue].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureLoader::Stop()
+    {
+        m_decodeQueue.Stop();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureLoader::GetNumPending
+
+      Summary:  Returns the number of textures queued, decoding or
+                waiting for Update
+
+      Returns:  UINT
+                  Number of textures not created yet
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TextureLoader::GetNumPending() const
+    {
+        return m_decodeQueue.GetNumPending();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureLoader::GetNumLoaded
+
+      Summary:  Returns the number of textures created so far
+
+      Returns:  UINT
+                  Number of textures loaded
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TextureLoader::GetNumLoaded() const
+    {
+        return m_uNumLoaded;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureLoader::GetNumFailed
+
+      Summary:  Returns the number of textures that failed to decode or
+                to be created so far
+
+      Returns:  UINT
+                  Number of textures failed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TextureLoader::GetNumFailed() const
+    {
+        return m_uNumFailed;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureLoader::GetLoadTime
+
+      Summary:  Returns the time from the first texture queued to the
+                last one created, of the last batch that completed
+
+      Returns:  FLOAT
+                  Load time in milliseconds
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT TextureLoader::GetLoadTime() const
+    {
+        return m_decodeQueue.GetLoadTime();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureLoader::TextureDecodeJob::TextureDecodeJob
+
+      Summary:  Constructor
+
+      Args:     const std::shared_ptr<Texture>& texture
+                  Texture to decode
+
+      Modifies: [m_texture, m_hr].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TextureLoader::TextureDecodeJob::TextureDecodeJob(_In_ const std::shared_ptr<Texture>& texture)
+        : m_texture(texture)
+        , m_hr(E_PENDING)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureLoader::TextureDecodeJob::Decode
+
+      Summary:  Decodes the texture on a worker of the queue. WIC needs
+                COM on the thread; Texture::Decode creates its own WIC
+                factory, so COM is only held for the decode
+
+      Modifies: [m_hr].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureLoader::TextureDecodeJob::Decode()
+    {
+        HRESULT hrCom = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+        m_hr = m_texture->Decode();
+
+        if (SUCCEEDED(hrCom))
+        {
+            CoUninitialize();
+        }
+    }
+}
@@ -0,0 +1,97 @@
+/*+===================================================================
+  File:      TEXTURELOADER.H
+
+  Summary:   TextureLoader header file contains declarations of
+             TextureLoader class used for the lab samples of Game
+             Graphics Programming course.
+
+  Classes: TextureLoader
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Texture/DecodeQueue.h"
+#include "Texture/Texture.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    TextureLoader
+
+      Summary:  Loads textures in the background. Worker threads read
+                and decode the queued textures and generate their
+                mips; Update creates the decoded ones on the rendering
+                thread, between two frames. A texture has no resource
+                view until then, and the renderer binds a placeholder
+                in its place
+
+                The workers of its DecodeQueue are started with the
+                first texture queued, at most MAX_CONCURRENT_DECODES of
+                them, which bounds both the cores taken from the game
+                and the memory of the images decoded at once. The time
+                from the first texture queued to the last one created
+                is logged for every batch
+
+      Methods:  Enqueue
+                  Queues a texture to be loaded
+                Update
+                  Creates the textures decoded since the last call
+                Stop
+                  Stops the workers
+                GetNumPending
+                  Returns the number of textures not created yet
+                GetNumLoaded
+                  Returns the number of textures created so far
+                GetNumFailed
+                  Returns the number of textures that failed so far
+                GetLoadTime
+                  Returns the time the last batch took to load
+                TextureLoader
+                  Constructor.
+                ~TextureLoader
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class TextureLoader final
+    {
+    public:
+        static constexpr const UINT MAX_CONCURRENT_DECODES = 4u;
+
+        TextureLoader();
+        TextureLoader(const TextureLoader& other) = delete;
+        TextureLoader(TextureLoader&& other) = delete;
+        TextureLoader& operator=(const TextureLoader& other) = delete;
+        TextureLoader& operator=(TextureLoader&& other) = delete;
+        ~TextureLoader();
+
+        void Enqueue(_In_ const std::shared_ptr<Texture>& texture);
+        UINT Update(_In_ ID3D11Device* pDevice);
+        void Stop();
+
+        UINT GetNumPending() const;
+        UINT GetNumLoaded() const;
+        UINT GetNumFailed() const;
+        FLOAT GetLoadTime() const;
+
+    private:
+        class TextureDecodeJob final : public DecodeJob
+        {
+        public:
+            explicit TextureDecodeJob(_In_ const std::shared_ptr<Texture>& texture);
+
+            void Decode() override;
+
+        public:
+            std::shared_ptr<Texture> m_texture;
+            HRESULT m_hr;
+        };
+
+    private:
+        DecodeQueue m_decodeQueue;
+        std::vector<std::unique_ptr<DecodeJob>> m_aDecoded;
+        UINT m_uNumLoaded;
+        UINT m_uNumFailed;
+    };
+}
@@ -0,0 +1,111 @@
+#include "Texture/TextureStreamer.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureStreamer::TextureStreamer
+
+      Summary:  Constructor
+
+      Modifies: [m_policy].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TextureStreamer::TextureStreamer()
+        : m_policy()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureStreamer::Request
+
+      Summary:  Requests the mip a draw of a texture is sampled from in
+                the frame, the finest request of the frame winning.
+                Textures not created yet or not streamed are ignored
+
+      Args:     const std::shared_ptr<Texture>& texture
+                  Texture drawn
+                FLOAT uvPerPixel
+                  Texture coordinates spanned by a pixel of the draw,
+                  where it is the closest to the camera
+
+      Modifies: [m_policy].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureStreamer::Request(_In_ const std::shared_ptr<Texture>& texture, _In_ FLOAT uvPerPixel)
+    {
+        if (!texture || !texture->IsStreamed())
+        {
+            return;
+        }
+
+        m_policy.Request(texture, uvPerPixel);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureStreamer::Update
+
+      Summary:  Creates the textures again with the mips the policy
+                streams in and out for the frame. Called on the
+                rendering thread between two frames, after the
+                requests of a frame
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the textures
+
+      Modifies: [m_policy].
+
+      Returns:  UINT
+                  Number of textures created again
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TextureStreamer::Update(_In_ ID3D11Device* pDevice)
+    {
+        // Only Request adds mip chains, and it only takes textures
+        return m_policy.Update([pDevice](IMipChain& mipChain, uint32_t uMip)
+        {
+            return SUCCEEDED(static_cast<Texture&>(mipChain).SetResidentMip(pDevice, uMip));
+        });
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureStreamer::SetBudget
+
+      Summary:  Sets the video memory the mips of the streamed textures
+                may take, enforced from the next Update. The fallback
+                mips are never evicted, so they may exceed it
+
+      Args:     UINT64 uBudgetBytes
+                  Budget in bytes
+
+      Modifies: [m_policy].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TextureStreamer::SetBudget(_In_ UINT64 uBudgetBytes)
+    {
+        m_policy.SetBudget(uBudgetBytes);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureStreamer::GetBudget
+
+      Summary:  Returns the video memory the mips of the streamed
+                textures may take
+
+      Returns:  UINT64
+                  Budget in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 TextureStreamer::GetBudget() const
+    {
+        return m_policy.GetBudget();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureStreamer::GetStats
+
+      Summary:  Returns the counters since the construction, and the
+                memory of the mips as of the last Update
+
+      Returns:  const TextureStreamingStats&
+                  Textures and bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const TextureStreamingStats& TextureStreamer::GetStats() const
+    {
+        return m_policy.GetStats();
+    }
+}
@@ -0,0 +1,67 @@
+/*+===================================================================
+  File:      TEXTURESTREAMER.H
+
+  Summary:   TextureStreamer header file contains declarations of
+             TextureStreamer class used for the lab samples of Game
+             Graphics Programming course.
+
+  Classes: TextureStreamer
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Texture/MipStreamingPolicy.h"
+#include "Texture/Texture.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    TextureStreamer
+
+      Summary:  Streams the mips of the streamed textures. A texture is
+                created with its coarse fallback mips, then the
+                renderer requests the mip each draw needs from the
+                screen space density of its texels, and Update creates
+                the texture again with the mips MipStreamingPolicy
+                chose within the budget. Used on the rendering thread
+                only
+
+      Methods:  Request
+                  Requests the mips a draw of a texture needs
+                Update
+                  Streams mips in and out for the frame requested
+                SetBudget
+                  Sets the video memory the mips may take
+                GetBudget
+                  Returns the video memory the mips may take
+                GetStats
+                  Returns the counters and the memory of the mips
+                TextureStreamer
+                  Constructor.
+                ~TextureStreamer
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class TextureStreamer final
+    {
+    public:
+        TextureStreamer();
+        TextureStreamer(const TextureStreamer& other) = delete;
+        TextureStreamer(TextureStreamer&& other) = delete;
+        TextureStreamer& operator=(const TextureStreamer& other) = delete;
+        TextureStreamer& operator=(TextureStreamer&& other) = delete;
+        ~TextureStreamer() = default;
+
+        void Request(_In_ const std::shared_ptr<Texture>& texture, _In_ FLOAT uvPerPixel);
+        UINT Update(_In_ ID3D11Device* pDevice);
+
+        void SetBudget(_In_ UINT64 uBudgetBytes);
+        UINT64 GetBudget() const;
+        const TextureStreamingStats& GetStats() const;
+
+    private:
+        MipStreamingPolicy m_policy;
+    };
+}
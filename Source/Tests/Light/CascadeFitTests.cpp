@@ -0,0 +1,164 @@
+#include "Light/CascadeFit.h"
+
+#include <cmath>
+#include <random>
+
+#include <gtest/gtest.h>
+
+namespace library
+{
+    namespace
+    {
+        constexpr const uint32_t NUM_CASCADES = 4u;
+        constexpr const uint32_t MAP_SIZE = 2048u;
+        constexpr const float SPLIT_LAMBDA = 0.75f;
+        constexpr const float REFIT_MARGIN = 0.125f;
+        constexpr const float NEAR_Z = 0.01f;
+        constexpr const float SHADOW_DISTANCE = 150.0f;
+
+        struct Projection
+        {
+            float FovAngleY;
+            float AspectRatio;
+        };
+
+        constexpr const Projection PROJECTIONS[] =
+        {
+            { 0.785398163f, 16.0f / 9.0f },
+            { 1.570796327f, 16.0f / 9.0f },
+            { 0.5f, 1.0f },
+            { 1.2f, 0.5f },
+        };
+    }
+
+    TEST(CascadeFitTest, SplitsBlendTheLogarithmicAndUniformSchemes)
+    {
+        CascadeSlice aLog[NUM_CASCADES];
+        CascadeSlice aUniform[NUM_CASCADES];
+        CascadeSlice aBlend[NUM_CASCADES];
+        CascadeFit::ComputeSlices(0.785398163f, 16.0f / 9.0f, NEAR_Z, SHADOW_DISTANCE, 1.0f, NUM_CASCADES, aLog);
+        CascadeFit::ComputeSlices(0.785398163f, 16.0f / 9.0f, NEAR_Z, SHADOW_DISTANCE, 0.0f, NUM_CASCADES, aUniform);
+        CascadeFit::ComputeSlices(0.785398163f, 16.0f / 9.0f, NEAR_Z, SHADOW_DISTANCE, SPLIT_LAMBDA, NUM_CASCADES, aBlend);
+
+        float previous = NEAR_Z;
+        for (uint32_t i = 0u; i < NUM_CASCADES; ++i)
+        {
+            const float fraction = static_cast<float>(i + 1u) / static_cast<float>(NUM_CASCADES);
+            EXPECT_NEAR(aLog[i].SplitDistance, NEAR_Z * std::pow(SHADOW_DISTANCE / NEAR_Z, fraction), 1e-3f);
+            EXPECT_NEAR(aUniform[i].SplitDistance, NEAR_Z + (SHADOW_DISTANCE - NEAR_Z) * fraction, 1e-3f);
+            EXPECT_NEAR(aBlend[i].SplitDistance, SPLIT_LAMBDA * aLog[i].SplitDistance + (1.0f - SPLIT_LAMBDA) * aUniform[i].SplitDistance, 1e-3f);
+
+            EXPECT_GT(aBlend[i].SplitDistance, previous);
+            previous = aBlend[i].SplitDistance;
+        }
+        EXPECT_NEAR(aBlend[NUM_CASCADES - 1u].SplitDistance, SHADOW_DISTANCE, 1e-3f);
+    }
+
+    // The sphere of a slice must hold its eight corners, and be no larger than the farthest of them
+    TEST(CascadeFitTest, SpheresBoundTheirSlicesTightly)
+    {
+        for (const Projection& projection : PROJECTIONS)
+        {
+            CascadeSlice aSlices[NUM_CASCADES];
+            CascadeFit::ComputeSlices(projection.FovAngleY, projection.AspectRatio, NEAR_Z, SHADOW_DISTANCE, SPLIT_LAMBDA, NUM_CASCADES, aSlices);
+
+            const float tanHalfFovY = std::tan(projection.FovAngleY * 0.5f);
+            const float tanHalfFovX = tanHalfFovY * projection.AspectRatio;
+            float sliceNear = NEAR_Z;
+            for (const CascadeSlice& slice : aSlices)
+            {
+                float farthest = 0.0f;
+                for (const float z : { sliceNear, slice.SplitDistance })
+                {
+                    const float x = z * tanHalfFovX;
+                    const float y = z * tanHalfFovY;
+                    const float distance = std::sqrt(x * x + y * y + (z - slice.CenterDistance) * (z - slice.CenterDistance));
+                    EXPECT_LE(distance, slice.Radius * 1.0001f);
+                    farthest = (std::max)(farthest, distance);
+                }
+                EXPECT_NEAR(farthest, slice.Radius, slice.Radius * 1e-4f);
+                EXPECT_LE(slice.CenterDistance, slice.SplitDistance);
+                EXPECT_GE(slice.CenterDistance, sliceNear);
+
+                sliceNear = slice.SplitDistance;
+            }
+        }
+    }
+
+    TEST(CascadeFitTest, MapCoversTheSphereAndItsMargin)
+    {
+        const float radius = 12.5f;
+        const float texelSize = CascadeFit::GetTexelSize(radius, REFIT_MARGIN, MAP_SIZE);
+        const float aCenter[3] = { 3.0f, -4.0f, 20.0f };
+        float aMin[3];
+        float aMax[3];
+        CascadeFit::GetLightSpaceBox(aCenter, radius, REFIT_MARGIN, 200.0f, aMin, aMax);
+
+        EXPECT_FLOAT_EQ(aMax[0] - aMin[0], texelSize * MAP_SIZE);
+        EXPECT_FLOAT_EQ(aMax[1] - aMin[1], texelSize * MAP_SIZE);
+        EXPECT_FLOAT_EQ(aMax[2], aCenter[2] + radius * (1.0f + REFIT_MARGIN));
+        EXPECT_FLOAT_EQ(aMin[2], aCenter[2] - radius * (1.0f + REFIT_MARGIN) - 200.0f);
+    }
+
+    // Moving the camera by a fraction of a texel must move the cascade by whole texels only
+    TEST(CascadeFitTest, SnappedCentersMoveByWholeTexels)
+    {
+        const float texelSize = CascadeFit::GetTexelSize(40.0f, REFIT_MARGIN, MAP_SIZE);
+        std::mt19937 random(2048u);
+        std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+        for (uint32_t i = 0u; i < 1000u; ++i)
+        {
+            const float aCenter[3] = { position(random), position(random), position(random) };
+            float aSnapped[3];
+            CascadeFit::SnapToTexels(aCenter, texelSize, aSnapped);
+
+            for (uint32_t uAxis = 0u; uAxis < 2u; ++uAxis)
+            {
+                const float texels = aSnapped[uAxis] / texelSize;
+                EXPECT_NEAR(texels, std::round(texels), 1e-3f);
+                EXPECT_LE(aSnapped[uAxis], aCenter[uAxis] + texelSize * 1e-3f);
+                EXPECT_GT(aSnapped[uAxis], aCenter[uAxis] - texelSize * 1.001f);
+            }
+            EXPECT_EQ(aSnapped[2], aCenter[2]);
+        }
+    }
+
+    // A center inside the margin keeps its sphere inside the box of the fit, so the fit can be kept
+    TEST(CascadeFitTest, FitsAreKeptOnlyWhileTheyCoverTheSphere)
+    {
+        CascadeSlice aSlices[NUM_CASCADES];
+        CascadeFit::ComputeSlices(0.785398163f, 16.0f / 9.0f, NEAR_Z, SHADOW_DISTANCE, SPLIT_LAMBDA, NUM_CASCADES, aSlices);
+
+        std::mt19937 random(125u);
+        std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+        for (const CascadeSlice& slice : aSlices)
+        {
+            const float aCenter[3] = { 10.0f, 20.0f, 30.0f };
+            float aFitted[3];
+            CascadeFit::SnapToTexels(aCenter, CascadeFit::GetTexelSize(slice.Radius, REFIT_MARGIN, MAP_SIZE), aFitted);
+            float aMin[3];
+            float aMax[3];
+            CascadeFit::GetLightSpaceBox(aFitted, slice.Radius, REFIT_MARGIN, 0.0f, aMin, aMax);
+            EXPECT_FALSE(CascadeFit::IsOutsideMargin(aCenter, aFitted, slice.Radius, REFIT_MARGIN));
+
+            for (uint32_t i = 0u; i < 1000u; ++i)
+            {
+                const float move = slice.Radius * REFIT_MARGIN * 2.0f;
+                const float aMoved[3] = { aFitted[0] + offset(random) * move, aFitted[1] + offset(random) * move, aFitted[2] + offset(random) * move };
+                if (CascadeFit::IsOutsideMargin(aMoved, aFitted, slice.Radius, REFIT_MARGIN))
+                {
+                    continue;
+                }
+
+                for (uint32_t uAxis = 0u; uAxis < 3u; ++uAxis)
+                {
+                    ASSERT_GE(aMoved[uAxis] - slice.Radius, aMin[uAxis]);
+                    ASSERT_LE(aMoved[uAxis] + slice.Radius, aMax[uAxis]);
+                }
+            }
+
+            const float aOutside[3] = { aFitted[0] + slice.Radius * REFIT_MARGIN * 1.01f, aFitted[1], aFitted[2] };
+            EXPECT_TRUE(CascadeFit::IsOutsideMargin(aOutside, aFitted, slice.Radius, REFIT_MARGIN));
+        }
+    }
+}
@@ -0,0 +1,36 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Light/LightBinner.h"
+
+namespace library
+{
+    // A frame of the renderer's light binning; the argument is the number of lights
+    void BM_BinLights(benchmark::State& state)
+    {
+        const uint32_t uNumLights = static_cast<uint32_t>(state.range(0));
+        std::mt19937 random(uNumLights);
+        std::uniform_real_distribution<float> lateral(-60.0f, 60.0f);
+        std::uniform_real_distribution<float> depth(0.0f, 150.0f);
+        std::uniform_real_distribution<float> range(1.0f, 6.0f);
+        std::vector<LightSphere> aLights(uNumLights);
+        for (LightSphere& light : aLights)
+        {
+            light = LightSphere{ .X = lateral(random), .Y = lateral(random) * 0.5f, .Z = depth(random), .Range = range(random) };
+        }
+
+        LightBinner binner;
+        binner.SetProjection(0.785398163f, 1600u, 900u, 0.01f, 1000.0f);
+        for (auto _ : state)
+        {
+            binner.Bin(aLights.data(), uNumLights);
+            benchmark::DoNotOptimize(binner.GetLightIndices());
+        }
+        state.counters["indices"] = static_cast<double>(binner.GetNumLightIndices());
+        state.SetItemsProcessed(state.iterations() * uNumLights);
+    }
+    BENCHMARK(BM_BinLights)->Arg(100)->Arg(1000);
+}
@@ -0,0 +1,186 @@
+#include "Light/LightBinner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <gtest/gtest.h>
+
+namespace library
+{
+    namespace
+    {
+        constexpr const float FOV_ANGLE_Y = 0.785398163f;
+        constexpr const uint32_t WIDTH = 1600u;
+        constexpr const uint32_t HEIGHT = 900u;
+        constexpr const float NEAR_Z = 0.01f;
+        constexpr const float FAR_Z = 1000.0f;
+
+        // Cluster of a view space point, the way PhongShaders.fxh finds the cluster of a pixel
+        uint32_t GetShaderCluster(float x, float y, float z)
+        {
+            const float tanHalfFovY = tanf(FOV_ANGLE_Y * 0.5f);
+            const float tanHalfFovX = tanHalfFovY * static_cast<float>(WIDTH) / static_cast<float>(HEIGHT);
+            const float sliceScale = static_cast<float>(LightBinner::NUM_CLUSTERS_Z) / logf(FAR_Z / NEAR_Z);
+            const float sliceBias = logf(NEAR_Z) * sliceScale;
+
+            const float slice = std::clamp(floorf(logf(z) * sliceScale - sliceBias), 0.0f, static_cast<float>(LightBinner::NUM_CLUSTERS_Z - 1u));
+            const float pixelX = (x / (z * tanHalfFovX) * 0.5f + 0.5f) * static_cast<float>(WIDTH);
+            const float pixelY = (-y / (z * tanHalfFovY) * 0.5f + 0.5f) * static_cast<float>(HEIGHT);
+            const uint32_t uTileX = (std::min)(static_cast<uint32_t>(pixelX * LightBinner::NUM_CLUSTERS_X / WIDTH), LightBinner::NUM_CLUSTERS_X - 1u);
+            const uint32_t uTileY = (std::min)(static_cast<uint32_t>(pixelY * LightBinner::NUM_CLUSTERS_Y / HEIGHT), LightBinner::NUM_CLUSTERS_Y - 1u);
+
+            return (static_cast<uint32_t>(slice) * LightBinner::NUM_CLUSTERS_Y + uTileY) * LightBinner::NUM_CLUSTERS_X + uTileX;
+        }
+
+        bool IsOnScreen(float x, float y, float z)
+        {
+            const float tanHalfFovY = tanf(FOV_ANGLE_Y * 0.5f);
+            const float tanHalfFovX = tanHalfFovY * static_cast<float>(WIDTH) / static_cast<float>(HEIGHT);
+            return z > NEAR_Z && z < FAR_Z && fabsf(x) < z * tanHalfFovX && fabsf(y) < z * tanHalfFovY;
+        }
+
+        // Input indices of the lights a cluster lists
+        std::vector<uint32_t> GetClusterLights(const LightBinner& binner, uint32_t uCluster)
+        {
+            const LightClusterRange& cluster = binner.GetClusters()[uCluster];
+            std::vector<uint32_t> auLights;
+            for (uint32_t i = 0u; i < cluster.Count; ++i)
+            {
+                auLights.push_back(binner.GetVisibleLights()[binner.GetLightIndices()[cluster.Offset + i]]);
+            }
+            return auLights;
+        }
+
+        std::vector<LightSphere> MakeLights(uint32_t uNumLights, float maxRange, uint32_t uSeed)
+        {
+            std::mt19937 random(uSeed);
+            std::uniform_real_distribution<float> lateral(-60.0f, 60.0f);
+            std::uniform_real_distribution<float> depth(-5.0f, 150.0f);
+            std::uniform_real_distribution<float> range(0.5f, maxRange);
+            std::vector<LightSphere> aLights(uNumLights);
+            for (LightSphere& light : aLights)
+            {
+                light = LightSphere{ .X = lateral(random), .Y = lateral(random) * 0.5f, .Z = depth(random), .Range = range(random) };
+            }
+            return aLights;
+        }
+
+        class LightBinnerTest : public testing::Test
+        {
+        protected:
+            void SetUp() override
+            {
+                m_binner.SetProjection(FOV_ANGLE_Y, WIDTH, HEIGHT, NEAR_Z, FAR_Z);
+            }
+
+            LightBinner m_binner;
+        };
+    }
+
+    TEST_F(LightBinnerTest, CullsLightsOutsideTheFrustum)
+    {
+        const LightSphere aLights[] =
+        {
+            { .X = 0.0f, .Y = 0.0f, .Z = 10.0f, .Range = 1.0f },
+            { .X = 0.0f, .Y = 0.0f, .Z = -10.0f, .Range = 1.0f },
+            { .X = 0.0f, .Y = 0.0f, .Z = 1010.0f, .Range = 5.0f },
+            { .X = 500.0f, .Y = 0.0f, .Z = 10.0f, .Range = 1.0f },
+            { .X = 0.0f, .Y = -500.0f, .Z = 10.0f, .Range = 1.0f },
+            // Behind the camera, but its range reaches past the near plane
+            { .X = 0.0f, .Y = 0.0f, .Z = -1.0f, .Range = 2.0f },
+        };
+        m_binner.Bin(aLights, 6u);
+
+        ASSERT_EQ(m_binner.GetNumVisibleLights(), 2u);
+        EXPECT_EQ(m_binner.GetVisibleLights()[0], 0u);
+        EXPECT_EQ(m_binner.GetVisibleLights()[1], 5u);
+    }
+
+    TEST_F(LightBinnerTest, ListsASmallLightInItsClusterOnly)
+    {
+        const LightSphere light = { .X = 0.5f, .Y = 0.5f, .Z = 20.0f, .Range = 0.05f };
+        m_binner.Bin(&light, 1u);
+
+        const uint32_t uCluster = GetShaderCluster(light.X, light.Y, light.Z);
+        EXPECT_EQ(GetClusterLights(m_binner, uCluster), std::vector<uint32_t>{ 0u });
+        EXPECT_EQ(m_binner.GetNumLightIndices(), 1u);
+    }
+
+    TEST_F(LightBinnerTest, RangesAreContiguous)
+    {
+        const std::vector<LightSphere> aLights = MakeLights(200u, 10.0f, 7u);
+        m_binner.Bin(aLights.data(), static_cast<uint32_t>(aLights.size()));
+
+        uint32_t uOffset = 0u;
+        for (uint32_t uCluster = 0u; uCluster < LightBinner::NUM_CLUSTERS; ++uCluster)
+        {
+            const LightClusterRange& cluster = m_binner.GetClusters()[uCluster];
+            ASSERT_EQ(cluster.Offset, uOffset);
+            for (uint32_t i = 0u; i < cluster.Count; ++i)
+            {
+                ASSERT_LT(m_binner.GetLightIndices()[cluster.Offset + i], m_binner.GetNumVisibleLights());
+            }
+            uOffset += cluster.Count;
+        }
+        EXPECT_EQ(uOffset, m_binner.GetNumLightIndices());
+        EXPECT_EQ(m_binner.GetNumDroppedLightIndices(), 0u);
+    }
+
+    // A pixel inside the range of a light must find it in its cluster, for 1k lights
+    TEST_F(LightBinnerTest, EveryLitPointFindsItsLights)
+    {
+        constexpr const uint32_t NUM_LIGHTS = 1000u;
+        const std::vector<LightSphere> aLights = MakeLights(NUM_LIGHTS, 6.0f, 1000u);
+        m_binner.Bin(aLights.data(), NUM_LIGHTS);
+        ASSERT_EQ(m_binner.GetNumDroppedLightIndices(), 0u);
+
+        std::mt19937 random(1u);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        uint32_t uNumChecked = 0u;
+        for (uint32_t uLight = 0u; uLight < NUM_LIGHTS; ++uLight)
+        {
+            const LightSphere& light = aLights[uLight];
+            for (uint32_t uSample = 0u; uSample < 64u; ++uSample)
+            {
+                // Points spread through the sphere, the surface included
+                float aOffset[3] = { unit(random), unit(random), unit(random) };
+                const float length = sqrtf(aOffset[0] * aOffset[0] + aOffset[1] * aOffset[1] + aOffset[2] * aOffset[2]);
+                const float scale = uSample % 4u == 0u ? light.Range * 0.999f / length : light.Range * (std::min)(length, 0.999f) / length;
+                const float x = light.X + aOffset[0] * scale;
+                const float y = light.Y + aOffset[1] * scale;
+                const float z = light.Z + aOffset[2] * scale;
+                if (!IsOnScreen(x, y, z))
+                {
+                    continue;
+                }
+
+                const std::vector<uint32_t> auLights = GetClusterLights(m_binner, GetShaderCluster(x, y, z));
+                ASSERT_NE(std::find(auLights.begin(), auLights.end(), uLight), auLights.end())
+                    << "light " << uLight << " misses the cluster of (" << x << ", " << y << ", " << z << ")";
+                ++uNumChecked;
+            }
+        }
+        EXPECT_GT(uNumChecked, NUM_LIGHTS * 16u);
+    }
+
+    TEST_F(LightBinnerTest, DropsIndicesPastTheCapacity)
+    {
+        // Lights covering the whole view overflow the 32 indices per cluster of the list
+        std::vector<LightSphere> aLights(LightBinner::MAX_VISIBLE_LIGHTS, LightSphere{ .X = 0.0f, .Y = 0.0f, .Z = 0.0f, .Range = 2000.0f });
+        m_binner.Bin(aLights.data(), static_cast<uint32_t>(aLights.size()));
+
+        EXPECT_EQ(m_binner.GetNumVisibleLights(), LightBinner::MAX_VISIBLE_LIGHTS);
+        EXPECT_EQ(m_binner.GetNumLightIndices(), LightBinner::MAX_LIGHT_INDICES);
+        EXPECT_EQ(m_binner.GetNumDroppedLightIndices(), LightBinner::MAX_VISIBLE_LIGHTS * LightBinner::NUM_CLUSTERS - LightBinner::MAX_LIGHT_INDICES);
+        EXPECT_EQ(m_binner.GetClusters()[LightBinner::NUM_CLUSTERS - 1u].Count, 0u);
+    }
+
+    TEST_F(LightBinnerTest, KeepsAtMostTheVisibleLightCapacity)
+    {
+        std::vector<LightSphere> aLights(LightBinner::MAX_VISIBLE_LIGHTS + 10u, LightSphere{ .X = 0.0f, .Y = 0.0f, .Z = 10.0f, .Range = 0.1f });
+        m_binner.Bin(aLights.data(), static_cast<uint32_t>(aLights.size()));
+
+        EXPECT_EQ(m_binner.GetNumVisibleLights(), LightBinner::MAX_VISIBLE_LIGHTS);
+    }
+}
@@ -0,0 +1,72 @@
+#include "Renderer/CommandList.h"
+
+#include <gtest/gtest.h>
+
+#include "Renderer/RecordingRenderContext.h"
+
+namespace library
+{
+    namespace
+    {
+        // Issues one call of every kind
+        void issueEveryCall(IRenderContext& renderContext, uint32_t uSeed)
+        {
+            const float aColor[4] = { 0.0f, 0.25f, 0.5f, 1.0f };
+            const uint8_t auData[5] = { 1u, 2u, 3u, 4u, static_cast<uint8_t>(uSeed) };
+            const Viewport viewport = { .TopLeftX = 1.0f, .TopLeftY = 2.0f, .Width = 640.0f, .Height = 480.0f, .MinDepth = 0.0f, .MaxDepth = 1.0f };
+
+            renderContext.ClearRenderTargetView(FakeHandle<ID3D11RenderTargetView>(0x60), aColor);
+            renderContext.ClearDepthStencilView(FakeHandle<ID3D11DepthStencilView>(0x70), 3u, 0.5f, 7u);
+            renderContext.UpdateBuffer(FakeHandle<ID3D11Buffer>(0x40), auData, sizeof(auData));
+            renderContext.CopySubresource(FakeHandle<ID3D11Resource>(0x80), 2u, FakeHandle<ID3D11Resource>(0x90), 1u);
+            renderContext.SetRenderTargets(FakeHandle<ID3D11RenderTargetView>(0x60), nullptr);
+            renderContext.SetViewport(viewport);
+            renderContext.SetInputLayout(FakeHandle<ID3D11InputLayout>(0x10));
+            renderContext.SetPrimitiveTopology(4u);
+            renderContext.SetVertexBuffer(1u, FakeHandle<ID3D11Buffer>(0x100 + uSeed), 32u, 64u);
+            renderContext.SetIndexBuffer(FakeHandle<ID3D11Buffer>(0x101), 57u);
+            renderContext.SetVertexShader(FakeHandle<ID3D11VertexShader>(0x20));
+            renderContext.SetPixelShader(nullptr);
+            renderContext.SetVSConstantBuffer(2u, FakeHandle<ID3D11Buffer>(0x40), 16u, 16u);
+            renderContext.SetPSConstantBuffer(3u, FakeHandle<ID3D11Buffer>(0x41), 0u, 0u);
+            renderContext.SetPSShaderResource(5u, FakeHandle<ID3D11ShaderResourceView>(0x200));
+            renderContext.SetPSSampler(5u, FakeHandle<ID3D11SamplerState>(0x50));
+            renderContext.DrawIndexed(36u, 6u, -3);
+            renderContext.DrawIndexedInstanced(36u, 100u, 6u, -3, 9u);
+        }
+    }
+
+    TEST(CommandListTest, ReplaysEveryCallInOrder)
+    {
+        RecordingRenderContext expected;
+        issueEveryCall(expected, 0u);
+        issueEveryCall(expected, 1u);
+
+        CommandList commandList;
+        issueEveryCall(commandList, 0u);
+        issueEveryCall(commandList, 1u);
+        EXPECT_EQ(commandList.GetNumCommands(), expected.GetCalls().size());
+
+        RecordingRenderContext replayed;
+        commandList.Execute(replayed);
+        EXPECT_EQ(replayed.GetCalls(), expected.GetCalls());
+    }
+
+    TEST(CommandListTest, ResetKeepsTheArena)
+    {
+        CommandList commandList;
+        issueEveryCall(commandList, 0u);
+        const size_t uSize = commandList.GetSize();
+
+        commandList.Reset();
+        EXPECT_EQ(commandList.GetNumCommands(), 0u);
+        EXPECT_EQ(commandList.GetSize(), 0u);
+
+        RecordingRenderContext replayed;
+        commandList.Execute(replayed);
+        EXPECT_TRUE(replayed.GetCalls().empty());
+
+        issueEveryCall(commandList, 1u);
+        EXPECT_EQ(commandList.GetSize(), uSize);
+    }
+}
@@ -0,0 +1,174 @@
+#include "Renderer/FrameRingAllocator.h"
+
+#include <deque>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace library
+{
+    TEST(FrameRingAllocatorTest, AlignsRanges)
+    {
+        FrameRingAllocator allocator(1024u, 256u);
+
+        uint32_t uOffset = 0u;
+        ASSERT_TRUE(allocator.Allocate(16u, uOffset));
+        EXPECT_EQ(uOffset, 0u);
+        ASSERT_TRUE(allocator.Allocate(16u, uOffset));
+        EXPECT_EQ(uOffset, 256u);
+        EXPECT_EQ(allocator.GetUsedSize(), 272u);
+    }
+
+    TEST(FrameRingAllocatorTest, RejectsEmptyAndOversizedRanges)
+    {
+        FrameRingAllocator allocator(256u, 16u);
+
+        uint32_t uOffset = 0u;
+        EXPECT_FALSE(allocator.Allocate(0u, uOffset));
+        EXPECT_FALSE(allocator.Allocate(257u, uOffset));
+        EXPECT_EQ(allocator.GetUsedSize(), 0u);
+    }
+
+    TEST(FrameRingAllocatorTest, WrapsAroundInsteadOfStraddlingTheEnd)
+    {
+        FrameRingAllocator allocator(256u, 16u);
+
+        uint32_t uOffset = 0u;
+        ASSERT_TRUE(allocator.Allocate(100u, uOffset));
+        allocator.EndFrame(1u);
+        ASSERT_TRUE(allocator.Allocate(100u, uOffset));
+        EXPECT_EQ(uOffset, 112u);
+        allocator.EndFrame(2u);
+        allocator.Retire(1u);
+        EXPECT_EQ(allocator.GetUsedSize(), 112u);
+
+        // 32 bytes are left past the aligned head, so the range starts over at the front and the end is skipped
+        ASSERT_TRUE(allocator.Allocate(64u, uOffset));
+        EXPECT_EQ(uOffset, 0u);
+        EXPECT_EQ(allocator.GetUsedSize(), 112u + (256u - 212u) + 64u);
+
+        // The frame in flight still owns [100, 212) with its padding, which leaves [64, 100)
+        EXPECT_FALSE(allocator.Allocate(48u, uOffset));
+        ASSERT_TRUE(allocator.Allocate(32u, uOffset));
+        EXPECT_EQ(uOffset, 64u);
+    }
+
+    TEST(FrameRingAllocatorTest, FailsUntilTheOwningFrameRetires)
+    {
+        FrameRingAllocator allocator(256u, 16u);
+
+        uint32_t uOffset = 0u;
+        ASSERT_TRUE(allocator.Allocate(192u, uOffset));
+        allocator.EndFrame(1u);
+        EXPECT_FALSE(allocator.Allocate(128u, uOffset));
+
+        allocator.Retire(0u);
+        EXPECT_EQ(allocator.GetNumFramesInFlight(), 1u);
+        EXPECT_FALSE(allocator.Allocate(128u, uOffset));
+
+        allocator.Retire(1u);
+        EXPECT_EQ(allocator.GetNumFramesInFlight(), 0u);
+        EXPECT_EQ(allocator.GetUsedSize(), 0u);
+        ASSERT_TRUE(allocator.Allocate(128u, uOffset));
+        EXPECT_EQ(uOffset, 0u);
+    }
+
+    TEST(FrameRingAllocatorTest, RetiresFramesInOrderUpToTheCompletedFence)
+    {
+        FrameRingAllocator allocator(1024u, 16u);
+
+        uint32_t uOffset = 0u;
+        for (uint64_t uFence = 1u; uFence <= 4u; ++uFence)
+        {
+            ASSERT_TRUE(allocator.Allocate(64u, uOffset));
+            allocator.EndFrame(uFence);
+        }
+        EXPECT_EQ(allocator.GetNumFramesInFlight(), 4u);
+
+        allocator.Retire(2u);
+        EXPECT_EQ(allocator.GetNumFramesInFlight(), 2u);
+        EXPECT_EQ(allocator.GetUsedSize(), 128u);
+
+        allocator.Retire(2u);
+        EXPECT_EQ(allocator.GetNumFramesInFlight(), 2u);
+
+        allocator.Retire(10u);
+        EXPECT_EQ(allocator.GetNumFramesInFlight(), 0u);
+        EXPECT_EQ(allocator.GetUsedSize(), 0u);
+    }
+
+    TEST(FrameRingAllocatorTest, CountsFramesWithoutAllocations)
+    {
+        FrameRingAllocator allocator(256u, 16u);
+
+        allocator.EndFrame(1u);
+        allocator.EndFrame(2u);
+        EXPECT_EQ(allocator.GetNumFramesInFlight(), 2u);
+        EXPECT_EQ(allocator.GetUsedSize(), 0u);
+
+        allocator.Retire(2u);
+        EXPECT_EQ(allocator.GetNumFramesInFlight(), 0u);
+    }
+
+    // Frames of random sizes with a GPU a random number of frames behind: a range handed out must never overlap one a frame in flight owns
+    TEST(FrameRingAllocatorTest, NeverHandsOutRangesOfFramesInFlight)
+    {
+        struct Range
+        {
+            uint64_t uFence;
+            uint32_t uBegin;
+            uint32_t uEnd;
+        };
+
+        constexpr uint32_t CAPACITY = 4096u;
+        constexpr uint32_t ALIGNMENT = 64u;
+        FrameRingAllocator allocator(CAPACITY, ALIGNMENT);
+        std::mt19937 random(1234u);
+        std::deque<Range> aLiveRanges;
+        uint64_t uCompletedFence = 0u;
+
+        for (uint64_t uFence = 1u; uFence <= 20000u; ++uFence)
+        {
+            const uint32_t uNumAllocations = std::uniform_int_distribution<uint32_t>(0u, 12u)(random);
+            for (uint32_t i = 0u; i < uNumAllocations; ++i)
+            {
+                const uint32_t uSize = std::uniform_int_distribution<uint32_t>(1u, 700u)(random);
+                uint32_t uOffset = 0u;
+                if (!allocator.Allocate(uSize, uOffset))
+                {
+                    continue;
+                }
+
+                ASSERT_EQ(uOffset % ALIGNMENT, 0u);
+                ASSERT_LE(uOffset + uSize, CAPACITY);
+                for (const Range& range : aLiveRanges)
+                {
+                    ASSERT_TRUE(uOffset + uSize <= range.uBegin || range.uEnd <= uOffset)
+                        << "[" << uOffset << ", " << uOffset + uSize << ") of frame " << uFence
+                        << " overlaps [" << range.uBegin << ", " << range.uEnd << ") of frame " << range.uFence;
+                }
+                aLiveRanges.push_back(Range{ .uFence = uFence, .uBegin = uOffset, .uEnd = uOffset + uSize });
+            }
+            allocator.EndFrame(uFence);
+
+            // The GPU catches up to between 0 and 3 frames behind
+            const uint64_t uLag = std::uniform_int_distribution<uint64_t>(0u, 3u)(random);
+            if (uFence > uLag && uFence - uLag > uCompletedFence)
+            {
+                uCompletedFence = uFence - uLag;
+                allocator.Retire(uCompletedFence);
+                while (!aLiveRanges.empty() && aLiveRanges.front().uFence <= uCompletedFence)
+                {
+                    aLiveRanges.pop_front();
+                }
+            }
+
+            ASSERT_LE(allocator.GetUsedSize(), CAPACITY);
+            ASSERT_EQ(allocator.GetNumFramesInFlight(), uFence - uCompletedFence);
+        }
+
+        allocator.Retire(UINT64_MAX);
+        EXPECT_EQ(allocator.GetUsedSize(), 0u);
+    }
+}
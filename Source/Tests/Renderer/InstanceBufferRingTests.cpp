@@ -0,0 +1,180 @@
+#include "Renderer/InstanceBufferRing.h"
+
+#include <gtest/gtest.h>
+
+namespace library
+{
+    namespace
+    {
+        constexpr const uint32_t STRIDE = 64u;
+
+        // Creates the buffer the update would, as InstancedRenderable::UpdateInstanceBuffer does
+        bool CreateIfNeeded(InstanceBufferRing& ring, uint32_t uNumInstances)
+        {
+            if (!ring.NeedsBuffer(uNumInstances))
+            {
+                return false;
+            }
+
+            ring.OnBufferCreated(ring.GetGrownCapacity(uNumInstances), uNumInstances);
+            return true;
+        }
+    }
+
+    TEST(InstanceBufferRingTest, CreatesADefaultBufferWithItsInstances)
+    {
+        InstanceBufferRing ring;
+        ring.MarkDirty(0u, 10u);
+        ASSERT_TRUE(ring.NeedsBuffer(10u));
+        EXPECT_EQ(ring.GetGrownCapacity(10u), 10u);
+        EXPECT_TRUE(ring.IsFilledOnCreation(10u, 10u));
+        EXPECT_EQ(ring.GetBufferSize(10u, STRIDE), 10u * STRIDE);
+
+        ring.OnBufferCreated(10u, 10u);
+        EXPECT_FALSE(ring.NeedsBuffer(10u));
+        EXPECT_FALSE(ring.HasDirtyInstances());
+        EXPECT_FALSE(ring.BeginUpload(10u, STRIDE).bUpload);
+        EXPECT_EQ(ring.GetOffset(STRIDE), 0u);
+    }
+
+    // The changes since the last update are merged into a single box, written in place
+    TEST(InstanceBufferRingTest, PatchesTheDirtyRangeOfADefaultBuffer)
+    {
+        InstanceBufferRing ring;
+        ring.OnBufferCreated(16u, 16u);
+
+        ring.MarkDirty(7u, 9u);
+        ring.MarkDirty(3u, 4u);
+        ring.MarkDirty(5u, 5u);
+        ASSERT_TRUE(ring.HasDirtyInstances());
+
+        const InstanceUpload upload = ring.BeginUpload(16u, STRIDE);
+        EXPECT_TRUE(upload.bUpload);
+        EXPECT_FALSE(upload.bDiscard);
+        EXPECT_EQ(upload.uBegin, 3u);
+        EXPECT_EQ(upload.uEnd, 9u);
+        EXPECT_EQ(upload.uByteOffset, 3u * STRIDE);
+
+        EXPECT_FALSE(ring.HasDirtyInstances());
+        EXPECT_FALSE(ring.BeginUpload(16u, STRIDE).bUpload);
+    }
+
+    TEST(InstanceBufferRingTest, ClampsTheDirtyRangeToTheInstances)
+    {
+        InstanceBufferRing ring;
+        ring.OnBufferCreated(16u, 16u);
+
+        ring.MarkDirty(6u, 16u);
+        const InstanceUpload upload = ring.BeginUpload(10u, STRIDE);
+        EXPECT_TRUE(upload.bUpload);
+        EXPECT_EQ(upload.uBegin, 6u);
+        EXPECT_EQ(upload.uEnd, 10u);
+
+        ring.MarkDirty(12u, 16u);
+        EXPECT_FALSE(ring.BeginUpload(10u, STRIDE).bUpload);
+        EXPECT_FALSE(ring.HasDirtyInstances());
+    }
+
+    // Appending instances one at a time doubles the capacity, and a grown buffer is uploaded whole
+    TEST(InstanceBufferRingTest, DoublesTheCapacityWhenTheInstancesNoLongerFit)
+    {
+        InstanceBufferRing ring;
+        ring.OnBufferCreated(4u, 4u);
+
+        ring.MarkDirty(4u, 5u);
+        ASSERT_TRUE(ring.NeedsBuffer(5u));
+        EXPECT_EQ(ring.GetGrownCapacity(5u), 8u);
+        EXPECT_FALSE(ring.IsFilledOnCreation(8u, 5u));
+        ring.OnBufferCreated(8u, 5u);
+        EXPECT_EQ(ring.GetCapacity(), 8u);
+
+        const InstanceUpload upload = ring.BeginUpload(5u, STRIDE);
+        EXPECT_TRUE(upload.bUpload);
+        EXPECT_EQ(upload.uBegin, 0u);
+        EXPECT_EQ(upload.uEnd, 5u);
+        EXPECT_EQ(upload.uByteOffset, 0u);
+
+        // Many more than fit at once grow straight to their number
+        EXPECT_EQ(ring.GetGrownCapacity(100u), 100u);
+
+        InstanceBufferRing appended;
+        uint32_t uNumBuffers = 0u;
+        for (uint32_t uNumInstances = 1u; uNumInstances <= 1000u; ++uNumInstances)
+        {
+            appended.MarkDirty(uNumInstances - 1u, uNumInstances);
+            uNumBuffers += CreateIfNeeded(appended, uNumInstances) ? 1u : 0u;
+            appended.BeginUpload(uNumInstances, STRIDE);
+        }
+        EXPECT_EQ(uNumBuffers, 11u);
+        EXPECT_EQ(appended.GetCapacity(), 1024u);
+    }
+
+    // Each update writes every instance into the next segment, and only the wrap to segment 0 discards
+    TEST(InstanceBufferRingTest, CyclesTheSegmentsOfADynamicBuffer)
+    {
+        InstanceBufferRing ring;
+        ASSERT_TRUE(ring.SetDynamic(true, 0u));
+        EXPECT_EQ(ring.GetBufferSize(10u, STRIDE), InstanceBufferRing::NUM_SEGMENTS * 10u * STRIDE);
+        EXPECT_FALSE(ring.IsFilledOnCreation(10u, 10u));
+        ring.OnBufferCreated(10u, 10u);
+        ASSERT_TRUE(ring.HasDirtyInstances());
+
+        for (uint32_t uUpdate = 0u; uUpdate < 2u * InstanceBufferRing::NUM_SEGMENTS; ++uUpdate)
+        {
+            ring.MarkDirty(2u, 3u);
+            const InstanceUpload upload = ring.BeginUpload(10u, STRIDE);
+            const uint32_t uSegment = uUpdate % InstanceBufferRing::NUM_SEGMENTS;
+            EXPECT_TRUE(upload.bUpload);
+            EXPECT_EQ(upload.bDiscard, uSegment == 0u) << "update " << uUpdate;
+            EXPECT_EQ(upload.uBegin, 0u);
+            EXPECT_EQ(upload.uEnd, 10u);
+            EXPECT_EQ(upload.uByteOffset, uSegment * 10u * STRIDE);
+            EXPECT_EQ(ring.GetSegment(), uSegment);
+            EXPECT_EQ(ring.GetOffset(STRIDE), upload.uByteOffset);
+        }
+    }
+
+    // The GPU keeps reading the current segment until something changes
+    TEST(InstanceBufferRingTest, KeepsTheSegmentWithoutChanges)
+    {
+        InstanceBufferRing ring;
+        ring.SetDynamic(true, 10u);
+        ring.OnBufferCreated(10u, 10u);
+        ring.BeginUpload(10u, STRIDE);
+        ASSERT_EQ(ring.GetSegment(), 0u);
+
+        EXPECT_FALSE(ring.BeginUpload(10u, STRIDE).bUpload);
+        EXPECT_EQ(ring.GetSegment(), 0u);
+    }
+
+    // A new usage needs a new buffer with every instance, a dynamic buffer grows as a default one does
+    TEST(InstanceBufferRingTest, ReleasesTheBufferWhenTheUsageChanges)
+    {
+        InstanceBufferRing ring;
+        ring.OnBufferCreated(8u, 8u);
+        EXPECT_FALSE(ring.SetDynamic(false, 8u));
+        EXPECT_FALSE(ring.NeedsBuffer(8u));
+
+        ASSERT_TRUE(ring.SetDynamic(true, 8u));
+        EXPECT_TRUE(ring.IsDynamic());
+        EXPECT_TRUE(ring.NeedsBuffer(8u));
+        EXPECT_TRUE(ring.HasDirtyInstances());
+        ASSERT_TRUE(CreateIfNeeded(ring, 8u));
+        EXPECT_EQ(ring.GetCapacity(), 8u);
+
+        ring.MarkDirty(8u, 9u);
+        ASSERT_TRUE(CreateIfNeeded(ring, 9u));
+        EXPECT_EQ(ring.GetCapacity(), 16u);
+        const InstanceUpload upload = ring.BeginUpload(9u, STRIDE);
+        EXPECT_TRUE(upload.bDiscard);
+        EXPECT_EQ(upload.uEnd, 9u);
+
+        ASSERT_TRUE(ring.SetDynamic(false, 9u));
+        EXPECT_TRUE(ring.NeedsBuffer(9u));
+        EXPECT_EQ(ring.GetOffset(STRIDE), 0u);
+
+        ring.Release();
+        EXPECT_EQ(ring.GetCapacity(), 0u);
+        EXPECT_TRUE(ring.NeedsBuffer(1u));
+    }
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Renderer/RenderContext.h"
+
+namespace library
+{
+    // Opaque handle for tests, never dereferenced
+    template <typename T>
+    T* FakeHandle(uintptr_t uValue)
+    {
+        return reinterpret_cast<T*>(uValue);
+    }
+
+    // Records every call as text, so a test can compare whole call sequences
+    class RecordingRenderContext final : public IRenderContext
+    {
+    public:
+        void ClearRenderTargetView(ID3D11RenderTargetView* pRenderTargetView, const float aColor[4]) override
+        {
+            record("ClearRenderTargetView", pRenderTargetView, aColor[0], aColor[1], aColor[2], aColor[3]);
+        }
+
+        void ClearDepthStencilView(ID3D11DepthStencilView* pDepthStencilView, uint32_t uClearFlags, float depth, uint8_t uStencil) override
+        {
+            record("ClearDepthStencilView", pDepthStencilView, uClearFlags, depth, static_cast<uint32_t>(uStencil));
+        }
+
+        void UpdateBuffer(ID3D11Buffer* pBuffer, const void* pData, uint32_t uDataSize) override
+        {
+            std::string data(uDataSize, '\0');
+            memcpy(data.data(), pData, uDataSize);
+            record("UpdateBuffer", pBuffer, uDataSize, data);
+        }
+
+        void CopySubresource(ID3D11Resource* pDstResource, uint32_t uDstSubresource, ID3D11Resource* pSrcResource, uint32_t uSrcSubresource) override
+        {
+            record("CopySubresource", pDstResource, uDstSubresource, pSrcResource, uSrcSubresource);
+        }
+
+        void SetRenderTargets(ID3D11RenderTargetView* pRenderTargetView, ID3D11DepthStencilView* pDepthStencilView) override
+        {
+            record("SetRenderTargets", pRenderTargetView, pDepthStencilView);
+        }
+
+        void SetViewport(const Viewport& viewport) override
+        {
+            record("SetViewport", viewport.TopLeftX, viewport.TopLeftY, viewport.Width, viewport.Height, viewport.MinDepth, viewport.MaxDepth);
+        }
+
+        void SetInputLayout(ID3D11InputLayout* pInputLayout) override
+        {
+            record("SetInputLayout", pInputLayout);
+        }
+
+        void SetPrimitiveTopology(uint32_t uTopology) override
+        {
+            record("SetPrimitiveTopology", uTopology);
+        }
+
+        void SetVertexBuffer(uint32_t uSlot, ID3D11Buffer* pBuffer, uint32_t uStride, uint32_t uOffset) override
+        {
+            record("SetVertexBuffer", uSlot, pBuffer, uStride, uOffset);
+        }
+
+        void SetIndexBuffer(ID3D11Buffer* pBuffer, uint32_t uFormat) override
+        {
+            record("SetIndexBuffer", pBuffer, uFormat);
+        }
+
+        void SetVertexShader(ID3D11VertexShader* pVertexShader) override
+        {
+            record("SetVertexShader", pVertexShader);
+        }
+
+        void SetPixelShader(ID3D11PixelShader* pPixelShader) override
+        {
+            record("SetPixelShader", pPixelShader);
+        }
+
+        void SetVSConstantBuffer(uint32_t uSlot, ID3D11Buffer* pBuffer, uint32_t uFirstConstant, uint32_t uNumConstants) override
+        {
+            record("SetVSConstantBuffer", uSlot, pBuffer, uFirstConstant, uNumConstants);
+        }
+
+        void SetPSConstantBuffer(uint32_t uSlot, ID3D11Buffer* pBuffer, uint32_t uFirstConstant, uint32_t uNumConstants) override
+        {
+            record("SetPSConstantBuffer", uSlot, pBuffer, uFirstConstant, uNumConstants);
+        }
+
+        void SetPSShaderResource(uint32_t uSlot, ID3D11ShaderResourceView* pShaderResourceView) override
+        {
+            record("SetPSShaderResource", uSlot, pShaderResourceView);
+        }
+
+        void SetPSSampler(uint32_t uSlot, ID3D11SamplerState* pSampler) override
+        {
+            record("SetPSSampler", uSlot, pSampler);
+        }
+
+        void DrawIndexed(uint32_t uNumIndices, uint32_t uStartIndex, int32_t iBaseVertex) override
+        {
+            record("DrawIndexed", uNumIndices, uStartIndex, iBaseVertex);
+        }
+
+        void DrawIndexedInstanced(uint32_t uNumIndices, uint32_t uNumInstances, uint32_t uStartIndex, int32_t iBaseVertex, uint32_t uStartInstance) override
+        {
+            record("DrawIndexedInstanced", uNumIndices, uNumInstances, uStartIndex, iBaseVertex, uStartInstance);
+        }
+
+        const std::vector<std::string>& GetCalls() const
+        {
+            return m_aCalls;
+        }
+
+        void Clear()
+        {
+            m_aCalls.clear();
+        }
+
+    private:
+        template <typename... Args>
+        void record(const char* pszName, const Args&... args)
+        {
+            std::ostringstream stream;
+            stream << pszName << '(';
+            const char* pszSeparator = "";
+            ((stream << pszSeparator << format(args), pszSeparator = ", "), ...);
+            stream << ')';
+            m_aCalls.push_back(stream.str());
+        }
+
+        template <typename T>
+        static std::string format(const T& value)
+        {
+            std::ostringstream stream;
+            if constexpr (std::is_pointer_v<T>)
+            {
+                stream << reinterpret_cast<uintptr_t>(value);
+            }
+            else
+            {
+                stream << value;
+            }
+            return stream.str();
+        }
+
+    private:
+        std::vector<std::string> m_aCalls;
+    };
+}
@@ -0,0 +1,139 @@
+#include "Renderer/RenderQueue.h"
+
+#include <algorithm>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "Renderer/CommandRecorder.h"
+
+namespace library
+{
+    namespace
+    {
+        template <typename T>
+        T* fakeHandle(uintptr_t uValue)
+        {
+            return reinterpret_cast<T*>(uValue);
+        }
+
+        struct Submission
+        {
+            eRenderPass ePass;
+            DrawItem item;
+            float depth;
+        };
+
+        // A scene of uNumItems draws over 32 shader pairs and 1024 materials, in submission order
+        std::vector<Submission> makeScene(size_t uNumItems)
+        {
+            std::mt19937 random(42u);
+            std::uniform_int_distribution<uintptr_t> shader(0u, 31u);
+            std::uniform_int_distribution<uintptr_t> material(0u, 1023u);
+            std::uniform_real_distribution<float> depth(0.0f, 1.0f);
+
+            std::vector<Submission> aScene(uNumItems);
+            for (size_t i = 0u; i < uNumItems; ++i)
+            {
+                const uintptr_t uShader = shader(random);
+                const uintptr_t uMaterial = material(random);
+
+                DrawItem& item = aScene[i].item;
+                item = {};
+                item.pVertexShader = fakeHandle<ID3D11VertexShader>(0x1000 + uShader * 16u);
+                item.pPixelShader = fakeHandle<ID3D11PixelShader>(0x2000 + uShader * 16u);
+                item.apShaderResourceViews[0] = fakeHandle<ID3D11ShaderResourceView>(0x100000 + uMaterial * 32u);
+                item.apShaderResourceViews[1] = fakeHandle<ID3D11ShaderResourceView>(0x100010 + uMaterial * 32u);
+                item.uNumIndices = 36u;
+                aScene[i].ePass = i % 64u == 0u ? eRenderPass::SKY : eRenderPass::MAIN;
+                aScene[i].depth = depth(random);
+            }
+            return aScene;
+        }
+
+        void submitScene(RenderQueue& queue, const std::vector<Submission>& aScene)
+        {
+            queue.Clear();
+            for (const Submission& submission : aScene)
+            {
+                queue.Submit(queue.MakeSortKey(submission.ePass, submission.item, submission.depth), submission.item);
+            }
+        }
+    }
+
+    // Building the keys of a frame, including the state id lookups that restart every frame
+    void BM_RenderQueueSubmit(benchmark::State& state)
+    {
+        const std::vector<Submission> aScene = makeScene(static_cast<size_t>(state.range(0)));
+        RenderQueue queue;
+        for (auto _ : state)
+        {
+            submitScene(queue, aScene);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_RenderQueueSubmit)->Arg(100000);
+
+    void BM_RenderQueueSubmitAndSort(benchmark::State& state)
+    {
+        const std::vector<Submission> aScene = makeScene(static_cast<size_t>(state.range(0)));
+        RenderQueue queue;
+        for (auto _ : state)
+        {
+            submitScene(queue, aScene);
+            queue.Sort();
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_RenderQueueSubmitAndSort)->Arg(100000);
+
+    // Reference for the radix sort: std::sort of the same keys and item indices
+    void BM_StdSortOfSortKeys(benchmark::State& state)
+    {
+        const std::vector<Submission> aScene = makeScene(static_cast<size_t>(state.range(0)));
+        RenderQueue queue;
+        std::vector<std::pair<uint64_t, uint32_t>> aKeys(aScene.size());
+        for (size_t i = 0u; i < aScene.size(); ++i)
+        {
+            aKeys[i] = { queue.MakeSortKey(aScene[i].ePass, aScene[i].item, aScene[i].depth), static_cast<uint32_t>(i) };
+        }
+
+        std::vector<std::pair<uint64_t, uint32_t>> aSorted;
+        for (auto _ : state)
+        {
+            aSorted = aKeys;
+            std::sort(aSorted.begin(), aSorted.end());
+            benchmark::DoNotOptimize(aSorted.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_StdSortOfSortKeys)->Arg(100000);
+
+    // Recording a sorted frame into command lists on 1 to 8 threads of a pool, then replaying it
+    void BM_RenderQueueExecuteParallel(benchmark::State& state)
+    {
+        const uint32_t uNumThreads = static_cast<uint32_t>(state.range(1));
+        const std::vector<Submission> aScene = makeScene(static_cast<size_t>(state.range(0)));
+        RenderQueue queue;
+        submitScene(queue, aScene);
+        queue.Sort();
+
+        NullRenderContext targetContext;
+        CommandListRecorder recorder(uNumThreads, &targetContext);
+        WorkerPool workerPool(uNumThreads - 1u);
+        auto beginBucket = [](IRenderContext& renderContext)
+        {
+            renderContext.SetPrimitiveTopology(4u);
+        };
+
+        for (auto _ : state)
+        {
+            queue.ExecuteParallel(recorder, workerPool, targetContext, beginBucket);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.counters["buckets"] = static_cast<double>(queue.GetStats().uNumBuckets);
+    }
+    BENCHMARK(BM_RenderQueueExecuteParallel)->ArgsProduct({ { 20000 }, { 1, 2, 4, 8 } })->UseRealTime();
+}
@@ -0,0 +1,268 @@
+#include "Renderer/RenderQueue.h"
+
+#include <gtest/gtest.h>
+
+#include "Renderer/CommandRecorder.h"
+#include "Renderer/RecordingRenderContext.h"
+
+namespace library
+{
+    namespace
+    {
+        // A draw tagged by its number of indices, so the order of the draws can be read back
+        DrawItem makeItem(uintptr_t uVertexShader, uintptr_t uPixelShader, uintptr_t uTexture, uint32_t uTag)
+        {
+            DrawItem item = {};
+            item.pVertexShader = FakeHandle<ID3D11VertexShader>(uVertexShader);
+            item.pPixelShader = FakeHandle<ID3D11PixelShader>(uPixelShader);
+            item.apShaderResourceViews[0] = FakeHandle<ID3D11ShaderResourceView>(uTexture);
+            item.uNumIndices = uTag;
+            return item;
+        }
+
+        // A recorder whose chosen context fails to finish recording, like a deferred context out of memory
+        class FailingRecorder final : public ICommandRecorder
+        {
+        public:
+            FailingRecorder(uint32_t uNumContexts, IRenderContext* pTargetContext, uint32_t uFailingContextIdx)
+                : m_recorder(uNumContexts, pTargetContext)
+                , m_uFailingContextIdx(uFailingContextIdx)
+            {
+            }
+
+            uint32_t GetNumContexts() const override
+            {
+                return m_recorder.GetNumContexts();
+            }
+
+            IRenderContext& BeginRecording(uint32_t uContextIdx) override
+            {
+                return m_recorder.BeginRecording(uContextIdx);
+            }
+
+            bool FinishRecording(uint32_t uContextIdx) override
+            {
+                return uContextIdx != m_uFailingContextIdx && m_recorder.FinishRecording(uContextIdx);
+            }
+
+            void ExecuteRecorded(uint32_t uContextIdx) override
+            {
+                m_recorder.ExecuteRecorded(uContextIdx);
+            }
+
+        private:
+            CommandListRecorder m_recorder;
+            uint32_t m_uFailingContextIdx;
+        };
+
+        void submitItems(RenderQueue& queue, uint32_t uNumItems)
+        {
+            for (uint32_t i = 0u; i < uNumItems; ++i)
+            {
+                const DrawItem item = makeItem(0x1000 + (i % 5u) * 16u, 0x2000 + (i % 3u) * 16u, 0x3000 + (i % 17u) * 16u, i + 1u);
+                queue.Submit(queue.MakeSortKey(eRenderPass::MAIN, item, static_cast<float>(i % 101u) / 100.0f), item);
+            }
+            queue.Sort();
+        }
+
+        void beginBucket(IRenderContext& renderContext)
+        {
+            renderContext.SetPrimitiveTopology(4u);
+        }
+
+        uint32_t countCalls(const RecordingRenderContext& renderContext, const std::string& name)
+        {
+            uint32_t uCount = 0u;
+            for (const std::string& call : renderContext.GetCalls())
+            {
+                uCount += call.starts_with(name) ? 1u : 0u;
+            }
+            return uCount;
+        }
+
+        std::vector<std::string> drawsOf(const RecordingRenderContext& renderContext)
+        {
+            std::vector<std::string> aDraws;
+            for (const std::string& call : renderContext.GetCalls())
+            {
+                if (call.starts_with("DrawIndexed("))
+                {
+                    aDraws.push_back(call);
+                }
+            }
+            return aDraws;
+        }
+    }
+
+    TEST(RenderQueueTest, SortsByPassThenStatesThenDepth)
+    {
+        RenderQueue queue;
+        const DrawItem sky = makeItem(0x10, 0x20, 0x30, 1u);
+        const DrawItem farA = makeItem(0x40, 0x50, 0x60, 2u);
+        const DrawItem nearB = makeItem(0x70, 0x80, 0x90, 3u);
+        const DrawItem nearA = makeItem(0x40, 0x50, 0x60, 4u);
+
+        queue.Submit(queue.MakeSortKey(eRenderPass::SKY, sky, 0.0f), sky);
+        queue.Submit(queue.MakeSortKey(eRenderPass::MAIN, farA, 0.9f), farA);
+        queue.Submit(queue.MakeSortKey(eRenderPass::MAIN, nearB, 0.1f), nearB);
+        queue.Submit(queue.MakeSortKey(eRenderPass::MAIN, nearA, 0.2f), nearA);
+        queue.Sort();
+
+        RecordingRenderContext renderContext;
+        queue.Execute(renderContext);
+
+        // The states of A were seen first, so A gets the smaller ids and its draws come first, nearest first
+        const std::vector<std::string> aExpected =
+        {
+            "DrawIndexed(4, 0, 0)",
+            "DrawIndexed(2, 0, 0)",
+            "DrawIndexed(3, 0, 0)",
+            "DrawIndexed(1, 0, 0)",
+        };
+        EXPECT_EQ(drawsOf(renderContext), aExpected);
+        EXPECT_EQ(queue.GetStats().uNumItems, 4u);
+        EXPECT_EQ(queue.GetStats().uNumDraws, 4u);
+    }
+
+    TEST(RenderQueueTest, ClampsDepthIntoTheKey)
+    {
+        RenderQueue queue;
+        const DrawItem item = makeItem(0x10, 0x20, 0x30, 1u);
+
+        const uint64_t uDepthMask = (uint64_t(1) << RenderQueue::NUM_DEPTH_BITS) - 1u;
+        EXPECT_EQ(queue.MakeSortKey(eRenderPass::MAIN, item, -1.0f) & uDepthMask, 0u);
+        EXPECT_EQ(queue.MakeSortKey(eRenderPass::MAIN, item, 2.0f) & uDepthMask, uDepthMask);
+    }
+
+    // Shaders and textures are recreated by hot reload and mip streaming, so an address can come back as a different object
+    TEST(RenderQueueTest, StateIdsOnlyHoldForOneFrame)
+    {
+        RenderQueue queue;
+        const DrawItem a = makeItem(0x10, 0x20, 0x30, 1u);
+        const DrawItem b = makeItem(0x40, 0x50, 0x60, 2u);
+
+        const uint64_t uFirstKeyA = queue.MakeSortKey(eRenderPass::MAIN, a, 0.5f);
+        const uint64_t uFirstKeyB = queue.MakeSortKey(eRenderPass::MAIN, b, 0.5f);
+        EXPECT_LT(uFirstKeyA, uFirstKeyB);
+
+        queue.Clear();
+
+        // Next frame b is seen first and takes the ids a had
+        EXPECT_EQ(queue.MakeSortKey(eRenderPass::MAIN, b, 0.5f), uFirstKeyA);
+        EXPECT_EQ(queue.MakeSortKey(eRenderPass::MAIN, a, 0.5f), uFirstKeyB);
+    }
+
+    TEST(RenderQueueTest, StateIdsDoNotGrowAcrossFrames)
+    {
+        RenderQueue queue;
+        uint64_t uFirstKey = 0u;
+        for (uintptr_t uFrame = 0u; uFrame < 1000u; ++uFrame)
+        {
+            queue.Clear();
+
+            // A new shader every frame, as after a reload
+            const DrawItem item = makeItem(0x1000 + uFrame * 16u, 0x20, 0x30, 1u);
+            const uint64_t uKey = queue.MakeSortKey(eRenderPass::MAIN, item, 0.5f);
+            if (uFrame == 0u)
+            {
+                uFirstKey = uKey;
+            }
+            ASSERT_EQ(uKey, uFirstKey);
+        }
+    }
+
+    TEST(RenderQueueTest, LeavesUnusedSlotsUntouched)
+    {
+        RenderQueue queue;
+        DrawItem item = {};
+        item.apVertexBuffers[1] = FakeHandle<ID3D11Buffer>(0x10);
+        item.auStrides[1] = 12u;
+        item.pIndexBuffer = FakeHandle<ID3D11Buffer>(0x20);
+        item.uNumIndices = 36u;
+        item.uNumInstances = 8u;
+        queue.Submit(queue.MakeSortKey(eRenderPass::MAIN, item, 0.0f), item);
+
+        RecordingRenderContext renderContext;
+        queue.Execute(renderContext);
+
+        const std::vector<std::string> aExpected =
+        {
+            "SetVertexBuffer(1, 16, 12, 0)",
+            "SetIndexBuffer(32, 57)",
+            "DrawIndexedInstanced(36, 8, 0, 0, 0)",
+        };
+        EXPECT_EQ(renderContext.GetCalls(), aExpected);
+    }
+
+    TEST(RenderQueueTest, ParallelExecutionKeepsTheSerialDrawOrder)
+    {
+        RenderQueue queue;
+        submitItems(queue, 1000u);
+
+        RecordingRenderContext serialContext;
+        queue.Execute(serialContext);
+
+        RecordingRenderContext parallelContext;
+        CommandListRecorder recorder(4u, &parallelContext);
+        WorkerPool workerPool(3u);
+        EXPECT_TRUE(queue.ExecuteParallel(recorder, workerPool, parallelContext, beginBucket));
+
+        EXPECT_EQ(drawsOf(parallelContext), drawsOf(serialContext));
+        EXPECT_EQ(queue.GetStats().uNumBuckets, 4u);
+        EXPECT_EQ(queue.GetStats().uNumDraws, 1000u);
+        EXPECT_EQ(queue.GetStats().uNumFallbackBuckets, 0u);
+
+        // Every bucket starts from an unknown state and binds the frame states once
+        EXPECT_EQ(countCalls(parallelContext, "SetPrimitiveTopology("), 4u);
+    }
+
+    TEST(RenderQueueTest, BucketsHoldAtLeastTheMinimumOfItems)
+    {
+        RenderQueue queue;
+        submitItems(queue, static_cast<uint32_t>(RenderQueue::MIN_ITEMS_PER_BUCKET) * 2u);
+
+        RecordingRenderContext renderContext;
+        CommandListRecorder recorder(8u, &renderContext);
+        WorkerPool workerPool(7u);
+        queue.ExecuteParallel(recorder, workerPool, renderContext, beginBucket);
+
+        EXPECT_EQ(queue.GetStats().uNumBuckets, 2u);
+        EXPECT_GT(recorder.GetCommandList(1u).GetNumCommands(), 0u);
+        EXPECT_EQ(recorder.GetCommandList(2u).GetNumCommands(), 0u);
+    }
+
+    TEST(RenderQueueTest, BucketsAreLimitedByThreadsAndContexts)
+    {
+        RenderQueue queue;
+        submitItems(queue, 1000u);
+
+        RecordingRenderContext renderContext;
+        CommandListRecorder recorder(4u, &renderContext);
+        WorkerPool singleThread(0u);
+        queue.ExecuteParallel(recorder, singleThread, renderContext, beginBucket);
+        EXPECT_EQ(queue.GetStats().uNumBuckets, 1u);
+
+        WorkerPool eightThreads(7u);
+        queue.ExecuteParallel(recorder, eightThreads, renderContext, beginBucket);
+        EXPECT_EQ(queue.GetStats().uNumBuckets, 4u);
+    }
+
+    TEST(RenderQueueTest, IssuesFailedBucketsOnTheFallbackContext)
+    {
+        RenderQueue queue;
+        submitItems(queue, 1000u);
+
+        RecordingRenderContext serialContext;
+        queue.Execute(serialContext);
+
+        RecordingRenderContext targetContext;
+        FailingRecorder recorder(4u, &targetContext, 2u);
+        WorkerPool workerPool(3u);
+        EXPECT_FALSE(queue.ExecuteParallel(recorder, workerPool, targetContext, beginBucket));
+
+        EXPECT_EQ(drawsOf(targetContext), drawsOf(serialContext));
+        EXPECT_EQ(queue.GetStats().uNumDraws, 1000u);
+        EXPECT_EQ(queue.GetStats().uNumFallbackBuckets, 1u);
+        EXPECT_EQ(countCalls(targetContext, "SetPrimitiveTopology("), 4u);
+    }
+}
@@ -0,0 +1,86 @@
+#include "Renderer/StateCache.h"
+
+#include <benchmark/benchmark.h>
+
+#include "Renderer/CommandList.h"
+
+namespace library
+{
+    namespace
+    {
+        template <typename T>
+        T* fakeHandle(uintptr_t uValue)
+        {
+            return reinterpret_cast<T*>(uValue);
+        }
+
+        // A sorted frame: draws grouped by shader, then by material, each with its own vertex buffer and constants
+        void issueFrame(IRenderContext& renderContext, uint32_t uNumDraws, uint32_t uDrawsPerMaterial)
+        {
+            for (uint32_t i = 0u; i < uNumDraws; ++i)
+            {
+                const uint32_t uMaterial = i / uDrawsPerMaterial;
+                renderContext.SetInputLayout(fakeHandle<ID3D11InputLayout>(0x10 + (uMaterial / 16u) * 16u));
+                renderContext.SetPrimitiveTopology(4u);
+                renderContext.SetVertexBuffer(0u, fakeHandle<ID3D11Buffer>(0x1000 + i * 16u), 32u, 0u);
+                renderContext.SetVertexBuffer(1u, fakeHandle<ID3D11Buffer>(0x1008 + i * 16u), 24u, 0u);
+                renderContext.SetIndexBuffer(fakeHandle<ID3D11Buffer>(0x100000 + i * 16u), 57u);
+                renderContext.SetVertexShader(fakeHandle<ID3D11VertexShader>(0x20 + (uMaterial / 16u) * 16u));
+                renderContext.SetPixelShader(fakeHandle<ID3D11PixelShader>(0x30 + (uMaterial / 16u) * 16u));
+                for (uint32_t uSlot = 0u; uSlot < 4u; ++uSlot)
+                {
+                    renderContext.SetVSConstantBuffer(uSlot, fakeHandle<ID3D11Buffer>(0x40 + uSlot * 16u), 0u, 0u);
+                    renderContext.SetPSConstantBuffer(uSlot, fakeHandle<ID3D11Buffer>(0x40 + uSlot * 16u), 0u, 0u);
+                }
+                renderContext.SetVSConstantBuffer(2u, fakeHandle<ID3D11Buffer>(0x80), i * 16u, 16u);
+                renderContext.SetPSShaderResource(0u, fakeHandle<ID3D11ShaderResourceView>(0x200000 + uMaterial * 32u));
+                renderContext.SetPSShaderResource(1u, fakeHandle<ID3D11ShaderResourceView>(0x200010 + uMaterial * 32u));
+                renderContext.SetPSSampler(0u, fakeHandle<ID3D11SamplerState>(0x50));
+                renderContext.SetPSSampler(1u, fakeHandle<ID3D11SamplerState>(0x50));
+                renderContext.DrawIndexed(36u, 0u, 0);
+            }
+        }
+    }
+
+    void BM_FrameDirect(benchmark::State& state)
+    {
+        NullRenderContext nullContext;
+        for (auto _ : state)
+        {
+            issueFrame(nullContext, static_cast<uint32_t>(state.range(0)), 8u);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.counters["forwarded"] = static_cast<double>(nullContext.GetStats().uNumStateCalls) / static_cast<double>(state.iterations());
+    }
+    BENCHMARK(BM_FrameDirect)->Arg(1000)->Arg(10000);
+
+    void BM_FrameThroughStateCache(benchmark::State& state)
+    {
+        NullRenderContext nullContext;
+        StateCache stateCache(&nullContext);
+        for (auto _ : state)
+        {
+            stateCache.Invalidate();
+            issueFrame(stateCache, static_cast<uint32_t>(state.range(0)), 8u);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.counters["forwarded"] = static_cast<double>(nullContext.GetStats().uNumStateCalls) / static_cast<double>(state.iterations());
+    }
+    BENCHMARK(BM_FrameThroughStateCache)->Arg(1000)->Arg(10000);
+
+    void BM_FrameRecordedThroughStateCache(benchmark::State& state)
+    {
+        NullRenderContext nullContext;
+        CommandList commandList;
+        StateCache stateCache(&commandList);
+        for (auto _ : state)
+        {
+            commandList.Reset();
+            stateCache.Invalidate();
+            issueFrame(stateCache, static_cast<uint32_t>(state.range(0)), 8u);
+            commandList.Execute(nullContext);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_FrameRecordedThroughStateCache)->Arg(1000)->Arg(10000);
+}
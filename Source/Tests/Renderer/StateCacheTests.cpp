@@ -0,0 +1,159 @@
+#include "Renderer/StateCache.h"
+
+#include <gtest/gtest.h>
+
+#include "Renderer/RecordingRenderContext.h"
+
+namespace library
+{
+    namespace
+    {
+        class StateCacheTest : public testing::Test
+        {
+        protected:
+            StateCacheTest()
+                : m_recorder()
+                , m_stateCache(&m_recorder)
+            {
+            }
+
+            // Binds what a typical draw binds
+            void bindDraw(uintptr_t uVertexBuffer, uintptr_t uShaderResource)
+            {
+                m_stateCache.SetInputLayout(FakeHandle<ID3D11InputLayout>(0x10));
+                m_stateCache.SetPrimitiveTopology(4u);
+                m_stateCache.SetVertexBuffer(0u, FakeHandle<ID3D11Buffer>(uVertexBuffer), 32u, 0u);
+                m_stateCache.SetIndexBuffer(FakeHandle<ID3D11Buffer>(uVertexBuffer + 1u), 57u);
+                m_stateCache.SetVertexShader(FakeHandle<ID3D11VertexShader>(0x20));
+                m_stateCache.SetPixelShader(FakeHandle<ID3D11PixelShader>(0x30));
+                m_stateCache.SetVSConstantBuffer(2u, FakeHandle<ID3D11Buffer>(0x40), 0u, 16u);
+                m_stateCache.SetPSShaderResource(0u, FakeHandle<ID3D11ShaderResourceView>(uShaderResource));
+                m_stateCache.SetPSSampler(0u, FakeHandle<ID3D11SamplerState>(0x50));
+                m_stateCache.DrawIndexed(36u, 0u, 0);
+            }
+
+        protected:
+            RecordingRenderContext m_recorder;
+            StateCache m_stateCache;
+        };
+    }
+
+    TEST_F(StateCacheTest, ForwardsFirstBindOfEachState)
+    {
+        bindDraw(0x100, 0x200);
+
+        const std::vector<std::string> aExpected =
+        {
+            "SetInputLayout(16)",
+            "SetPrimitiveTopology(4)",
+            "SetVertexBuffer(0, 256, 32, 0)",
+            "SetIndexBuffer(257, 57)",
+            "SetVertexShader(32)",
+            "SetPixelShader(48)",
+            "SetVSConstantBuffer(2, 64, 0, 16)",
+            "SetPSShaderResource(0, 512)",
+            "SetPSSampler(0, 80)",
+            "DrawIndexed(36, 0, 0)",
+        };
+        EXPECT_EQ(m_recorder.GetCalls(), aExpected);
+        EXPECT_EQ(m_stateCache.GetStats().uNumCalls, 9u);
+        EXPECT_EQ(m_stateCache.GetStats().uNumCallsAvoided, 0u);
+    }
+
+    TEST_F(StateCacheTest, DropsBindsOfWhatIsAlreadyBound)
+    {
+        bindDraw(0x100, 0x200);
+        m_recorder.Clear();
+
+        bindDraw(0x100, 0x201);
+
+        const std::vector<std::string> aExpected =
+        {
+            "SetPSShaderResource(0, 513)",
+            "DrawIndexed(36, 0, 0)",
+        };
+        EXPECT_EQ(m_recorder.GetCalls(), aExpected);
+        EXPECT_EQ(m_stateCache.GetStats().uNumCalls, 10u);
+        EXPECT_EQ(m_stateCache.GetStats().uNumCallsAvoided, 8u);
+    }
+
+    TEST_F(StateCacheTest, ForwardsBindsWithChangedArguments)
+    {
+        m_stateCache.SetVertexBuffer(1u, FakeHandle<ID3D11Buffer>(0x100), 32u, 0u);
+        m_stateCache.SetVertexBuffer(1u, FakeHandle<ID3D11Buffer>(0x100), 32u, 64u);
+        m_stateCache.SetVSConstantBuffer(2u, FakeHandle<ID3D11Buffer>(0x40), 0u, 16u);
+        m_stateCache.SetVSConstantBuffer(2u, FakeHandle<ID3D11Buffer>(0x40), 16u, 16u);
+        m_stateCache.SetPSConstantBuffer(2u, FakeHandle<ID3D11Buffer>(0x40), 16u, 16u);
+        m_stateCache.SetIndexBuffer(FakeHandle<ID3D11Buffer>(0x101), 57u);
+        m_stateCache.SetIndexBuffer(FakeHandle<ID3D11Buffer>(0x101), 42u);
+
+        EXPECT_EQ(m_recorder.GetCalls().size(), 7u);
+        EXPECT_EQ(m_stateCache.GetStats().uNumCallsAvoided, 0u);
+    }
+
+    TEST_F(StateCacheTest, ForwardsFirstNullBind)
+    {
+        m_stateCache.SetPSShaderResource(3u, nullptr);
+        m_stateCache.SetPSShaderResource(3u, nullptr);
+
+        const std::vector<std::string> aExpected =
+        {
+            "SetPSShaderResource(3, 0)",
+        };
+        EXPECT_EQ(m_recorder.GetCalls(), aExpected);
+    }
+
+    TEST_F(StateCacheTest, AlwaysForwardsSlotsPastTheCachedOnes)
+    {
+        m_stateCache.SetPSShaderResource(NUM_CACHED_SLOTS, FakeHandle<ID3D11ShaderResourceView>(0x200));
+        m_stateCache.SetPSShaderResource(NUM_CACHED_SLOTS, FakeHandle<ID3D11ShaderResourceView>(0x200));
+        m_stateCache.SetVertexBuffer(NUM_CACHED_SLOTS, FakeHandle<ID3D11Buffer>(0x100), 32u, 0u);
+        m_stateCache.SetVertexBuffer(NUM_CACHED_SLOTS, FakeHandle<ID3D11Buffer>(0x100), 32u, 0u);
+
+        EXPECT_EQ(m_recorder.GetCalls().size(), 4u);
+    }
+
+    TEST_F(StateCacheTest, AlwaysForwardsClearsUpdatesAndTargets)
+    {
+        const float aColor[4] = { 0.0f, 0.25f, 0.5f, 1.0f };
+        const uint32_t auData[2] = { 1u, 2u };
+        const Viewport viewport = { .TopLeftX = 0.0f, .TopLeftY = 0.0f, .Width = 640.0f, .Height = 480.0f, .MinDepth = 0.0f, .MaxDepth = 1.0f };
+        for (uint32_t i = 0u; i < 2u; ++i)
+        {
+            m_stateCache.ClearRenderTargetView(FakeHandle<ID3D11RenderTargetView>(0x60), aColor);
+            m_stateCache.ClearDepthStencilView(FakeHandle<ID3D11DepthStencilView>(0x70), 1u, 1.0f, 0u);
+            m_stateCache.UpdateBuffer(FakeHandle<ID3D11Buffer>(0x40), auData, sizeof(auData));
+            m_stateCache.CopySubresource(FakeHandle<ID3D11Resource>(0x80), 0u, FakeHandle<ID3D11Resource>(0x90), 1u);
+            m_stateCache.SetRenderTargets(FakeHandle<ID3D11RenderTargetView>(0x60), FakeHandle<ID3D11DepthStencilView>(0x70));
+            m_stateCache.SetViewport(viewport);
+        }
+
+        EXPECT_EQ(m_recorder.GetCalls().size(), 12u);
+        EXPECT_EQ(m_stateCache.GetStats().uNumCalls, 0u);
+        EXPECT_EQ(m_stateCache.GetStats().uNumCallsAvoided, 0u);
+    }
+
+    TEST_F(StateCacheTest, InvalidateForwardsTheNextBinds)
+    {
+        bindDraw(0x100, 0x200);
+        m_recorder.Clear();
+
+        m_stateCache.Invalidate();
+        bindDraw(0x100, 0x200);
+
+        EXPECT_EQ(m_recorder.GetCalls().size(), 10u);
+    }
+
+    TEST_F(StateCacheTest, ResetStatsKeepsTheShadowedStates)
+    {
+        bindDraw(0x100, 0x200);
+        m_stateCache.ResetStats();
+        m_recorder.Clear();
+
+        bindDraw(0x100, 0x200);
+
+        EXPECT_EQ(m_recorder.GetCalls().size(), 1u);
+        EXPECT_EQ(m_stateCache.GetStats().uNumCalls, 0u);
+        EXPECT_EQ(m_stateCache.GetStats().uNumCallsAvoided, 9u);
+    }
+}
@@ -0,0 +1,86 @@
+#include "Renderer/VoxelInstanceData.h"
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#if __has_include(<DirectXMath.h>)
+#include <DirectXMath.h>
+#define HAS_DIRECTXMATH (1)
+#else
+#define HAS_DIRECTXMATH (0)
+#endif
+
+namespace library
+{
+    namespace
+    {
+        // Translation of a block as the voxel map used to place it, one matrix per instance
+        void getMatrixTranslation(uint32_t uWidthIdx, uint32_t uHeightIdx, uint32_t uDepthIdx, uint32_t uWidth, uint32_t uHeight, uint32_t uDepth, float* pTranslation)
+        {
+            const float fX = 2.0f * (static_cast<float>(uWidthIdx) - static_cast<float>(uWidth) / 2.0f);
+            const float fY = 2.0f * (static_cast<float>(uHeightIdx) - static_cast<float>(uHeight)) + (static_cast<float>(uHeight) * 0.75f);
+            const float fZ = 2.0f * (static_cast<float>(uDepthIdx) - static_cast<float>(uDepth) / 2.0f);
+#if HAS_DIRECTXMATH
+            DirectX::XMFLOAT4X4 matrix;
+            DirectX::XMStoreFloat4x4(&matrix, DirectX::XMMatrixTranslation(fX, fY, fZ));
+            pTranslation[0] = matrix._41;
+            pTranslation[1] = matrix._42;
+            pTranslation[2] = matrix._43;
+#else
+            pTranslation[0] = fX;
+            pTranslation[1] = fY;
+            pTranslation[2] = fZ;
+#endif
+        }
+
+        void expectDecodeMatchesMatrix(uint32_t uWidth, uint32_t uHeight, uint32_t uDepth)
+        {
+            const float fMapOffsetY = VoxelInstanceEncoder::GetMapOffsetY(uHeight);
+            for (uint32_t uDepthIdx = 0u; uDepthIdx < uDepth; uDepthIdx += (std::max)(uDepth / 16u, 1u))
+            {
+                for (uint32_t uWidthIdx = 0u; uWidthIdx < uWidth; uWidthIdx += (std::max)(uWidth / 16u, 1u))
+                {
+                    for (uint32_t uHeightIdx = 0u; uHeightIdx < uHeight; uHeightIdx += (std::max)(uHeight / 16u, 1u))
+                    {
+                        const VoxelInstanceData instance = VoxelInstanceEncoder::Encode(uWidthIdx, uHeightIdx, uDepthIdx, uWidth, uHeight, uDepth, 21u);
+
+                        float afDecoded[3];
+                        float afExpected[3];
+                        VoxelInstanceEncoder::Decode(instance, fMapOffsetY, afDecoded);
+                        getMatrixTranslation(uWidthIdx, uHeightIdx, uDepthIdx, uWidth, uHeight, uDepth, afExpected);
+
+                        EXPECT_FLOAT_EQ(afDecoded[0], afExpected[0]) << uWidthIdx << ", " << uHeightIdx << ", " << uDepthIdx;
+                        EXPECT_FLOAT_EQ(afDecoded[1], afExpected[1]) << uWidthIdx << ", " << uHeightIdx << ", " << uDepthIdx;
+                        EXPECT_FLOAT_EQ(afDecoded[2], afExpected[2]) << uWidthIdx << ", " << uHeightIdx << ", " << uDepthIdx;
+                    }
+                }
+            }
+        }
+    }
+
+    TEST(VoxelInstanceEncoderTest, DecodeMatchesMatrixTranslation)
+    {
+        expectDecodeMatchesMatrix(64u, 32u, 64u);
+    }
+
+    TEST(VoxelInstanceEncoderTest, DecodeMatchesMatrixTranslationOfOddSizes)
+    {
+        expectDecodeMatchesMatrix(17u, 9u, 33u);
+    }
+
+    TEST(VoxelInstanceEncoderTest, DecodeMatchesMatrixTranslationAtInt16Limits)
+    {
+        expectDecodeMatchesMatrix(32767u, 16383u, 32767u);
+    }
+
+    TEST(VoxelInstanceEncoderTest, KeepsBlockType)
+    {
+        const VoxelInstanceData instance = VoxelInstanceEncoder::Encode(3u, 4u, 5u, 8u, 8u, 8u, 35u);
+
+        EXPECT_EQ(instance.BlockType, 35u);
+        EXPECT_EQ(instance.X, -2);
+        EXPECT_EQ(instance.Y, -8);
+        EXPECT_EQ(instance.Z, 2);
+    }
+}
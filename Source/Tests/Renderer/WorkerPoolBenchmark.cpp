@@ -0,0 +1,59 @@
+#include "Renderer/WorkerPool.h"
+
+#include <benchmark/benchmark.h>
+
+namespace library
+{
+    namespace
+    {
+        // Some work per task, about what a bucket of a small frame costs
+        void runTask(std::vector<uint32_t>& auResults, uint32_t uTaskIdx)
+        {
+            uint32_t uValue = uTaskIdx;
+            for (uint32_t uStep = 0u; uStep < 2000u; ++uStep)
+            {
+                uValue = uValue * 1664525u + 1013904223u;
+            }
+            auResults[uTaskIdx] = uValue;
+        }
+    }
+
+    // What the render queue and the scene did every frame before the pool: spawn and join a thread per task
+    void BM_SpawnThreadsPerLoop(benchmark::State& state)
+    {
+        const uint32_t uNumTasks = static_cast<uint32_t>(state.range(0));
+        std::vector<uint32_t> auResults(uNumTasks);
+        for (auto _ : state)
+        {
+            std::vector<std::thread> aWorkers;
+            aWorkers.reserve(uNumTasks - 1u);
+            for (uint32_t i = 1u; i < uNumTasks; ++i)
+            {
+                aWorkers.emplace_back(runTask, std::ref(auResults), i);
+            }
+            runTask(auResults, 0u);
+            for (std::thread& thread : aWorkers)
+            {
+                thread.join();
+            }
+            benchmark::DoNotOptimize(auResults.data());
+        }
+    }
+    BENCHMARK(BM_SpawnThreadsPerLoop)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+    void BM_WorkerPoolParallelFor(benchmark::State& state)
+    {
+        const uint32_t uNumTasks = static_cast<uint32_t>(state.range(0));
+        std::vector<uint32_t> auResults(uNumTasks);
+        WorkerPool workerPool(uNumTasks - 1u);
+        for (auto _ : state)
+        {
+            workerPool.ParallelFor(uNumTasks, [&auResults](uint32_t i)
+            {
+                runTask(auResults, i);
+            });
+            benchmark::DoNotOptimize(auResults.data());
+        }
+    }
+    BENCHMARK(BM_WorkerPoolParallelFor)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+}
@@ -0,0 +1,108 @@
+#include "Renderer/WorkerPool.h"
+
+#include <atomic>
+#include <set>
+
+#include <gtest/gtest.h>
+
+namespace library
+{
+    TEST(WorkerPoolTest, CountsTheCallingThread)
+    {
+        WorkerPool noWorkers(0u);
+        WorkerPool threeWorkers(3u);
+
+        EXPECT_EQ(noWorkers.GetNumThreads(), 1u);
+        EXPECT_EQ(threeWorkers.GetNumThreads(), 4u);
+    }
+
+    TEST(WorkerPoolTest, RunsInlineWithoutWorkers)
+    {
+        WorkerPool workerPool(0u);
+
+        std::vector<uint32_t> auOrder;
+        workerPool.ParallelFor(5u, [&auOrder](uint32_t i)
+        {
+            auOrder.push_back(i);
+        });
+
+        EXPECT_EQ(auOrder, (std::vector<uint32_t>{ 0u, 1u, 2u, 3u, 4u }));
+    }
+
+    TEST(WorkerPoolTest, RunsEveryTaskOnceInEveryLoop)
+    {
+        WorkerPool workerPool(3u);
+
+        std::vector<std::atomic<uint32_t>> auCounts(1000u);
+        for (uint32_t uLoop = 0u; uLoop < 200u; ++uLoop)
+        {
+            // Loops of every size, including fewer tasks than threads
+            const uint32_t uNumTasks = uLoop % 2u == 0u ? 1000u : uLoop % 7u;
+            workerPool.ParallelFor(uNumTasks, [&auCounts](uint32_t i)
+            {
+                auCounts[i].fetch_add(1u, std::memory_order_relaxed);
+            });
+        }
+
+        uint32_t uExpectedSmall = 0u;
+        for (uint32_t uLoop = 1u; uLoop < 200u; uLoop += 2u)
+        {
+            uExpectedSmall += uLoop % 7u;
+        }
+
+        uint32_t uTotal = 0u;
+        for (uint32_t i = 0u; i < 1000u; ++i)
+        {
+            ASSERT_GE(auCounts[i].load(), 100u);
+            uTotal += auCounts[i].load();
+        }
+        EXPECT_EQ(uTotal, 100u * 1000u + uExpectedSmall);
+    }
+
+    TEST(WorkerPoolTest, ReturnsOnceEveryTaskIsDone)
+    {
+        WorkerPool workerPool(3u);
+
+        for (uint32_t uLoop = 0u; uLoop < 100u; ++uLoop)
+        {
+            std::vector<uint32_t> auResults(64u, 0u);
+            workerPool.ParallelFor(64u, [&auResults](uint32_t i)
+            {
+                uint32_t uValue = i;
+                for (uint32_t uStep = 0u; uStep < 1000u; ++uStep)
+                {
+                    uValue = uValue * 1664525u + 1013904223u;
+                }
+                auResults[i] = uValue | 1u;
+            });
+
+            for (uint32_t uResult : auResults)
+            {
+                ASSERT_NE(uResult, 0u);
+            }
+        }
+    }
+
+    TEST(WorkerPoolTest, RunsTasksOnSeveralThreads)
+    {
+        WorkerPool workerPool(3u);
+
+        // Each task waits for a second thread to take a task, which only the workers can do
+        std::atomic<uint32_t> uNumStarted = 0u;
+        std::mutex mutex;
+        std::set<std::thread::id> threadIds;
+        workerPool.ParallelFor(2u, [&](uint32_t)
+        {
+            uNumStarted.fetch_add(1u);
+            while (uNumStarted.load() < 2u)
+            {
+                std::this_thread::yield();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            threadIds.insert(std::this_thread::get_id());
+        });
+
+        EXPECT_EQ(threadIds.size(), 2u);
+    }
+}
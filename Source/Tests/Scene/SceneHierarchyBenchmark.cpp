@@ -0,0 +1,100 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Scene/SceneHierarchy.h"
+
+namespace library
+{
+    namespace
+    {
+        constexpr const uint32_t NUM_OBJECTS = 100000u;
+
+        SceneMatrix MakeTranslation(std::mt19937& random)
+        {
+            std::uniform_real_distribution<float> offset(-100.0f, 100.0f);
+            return SceneMatrix{ .m = { { 1.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f, 0.0f }, { offset(random), offset(random), offset(random), 1.0f } } };
+        }
+
+        // A scene of 100k objects, a tenth of them roots and the rest parented a few levels deep
+        void AddObjects(SceneHierarchy& hierarchy, std::mt19937& random, std::vector<SceneHandle>& aHandles)
+        {
+            for (uint32_t i = 0u; i < NUM_OBJECTS; ++i)
+            {
+                aHandles.push_back(hierarchy.Add(MakeTranslation(random)));
+                if (i >= NUM_OBJECTS / 10u)
+                {
+                    hierarchy.SetParent(aHandles[i], aHandles[random() % (i / 2u)]);
+                }
+            }
+        }
+    }
+
+    // What the renderer does with every object each frame: read its world matrix and moved flag
+    void BM_IterateWorldMatrices100k(benchmark::State& state)
+    {
+        std::mt19937 random(NUM_OBJECTS);
+        SceneHierarchy hierarchy;
+        std::vector<SceneHandle> aHandles;
+        AddObjects(hierarchy, random, aHandles);
+        WorkerPool workerPool(0u);
+        hierarchy.UpdateWorldMatrices(workerPool);
+
+        for (auto _ : state)
+        {
+            const SceneMatrix* aWorldMatrices = hierarchy.GetWorldMatrices();
+            const uint8_t* abMoved = hierarchy.GetMovedFlags();
+            float fSum = 0.0f;
+            uint32_t uNumMoved = 0u;
+            for (uint32_t i = 0u; i < hierarchy.GetNumObjects(); ++i)
+            {
+                fSum += aWorldMatrices[i].m[3][0] + aWorldMatrices[i].m[3][1] + aWorldMatrices[i].m[3][2];
+                uNumMoved += abMoved[i];
+            }
+            benchmark::DoNotOptimize(fSum);
+            benchmark::DoNotOptimize(uNumMoved);
+        }
+        state.SetItemsProcessed(state.iterations() * NUM_OBJECTS);
+    }
+    BENCHMARK(BM_IterateWorldMatrices100k);
+
+    // One frame of world matrix updates; arguments are the percent of objects moved and the worker count
+    void BM_UpdateWorldMatrices100k(benchmark::State& state)
+    {
+        const uint32_t uMovedPercent = static_cast<uint32_t>(state.range(0));
+        std::mt19937 random(NUM_OBJECTS);
+        SceneHierarchy hierarchy;
+        std::vector<SceneHandle> aHandles;
+        AddObjects(hierarchy, random, aHandles);
+        WorkerPool workerPool(static_cast<uint32_t>(state.range(1)));
+        hierarchy.UpdateWorldMatrices(workerPool);
+
+        std::vector<SceneMatrix> aMoves[2];
+        for (std::vector<SceneMatrix>& aLocals : aMoves)
+        {
+            for (uint32_t i = 0u; i < NUM_OBJECTS; ++i)
+            {
+                aLocals.push_back(MakeTranslation(random));
+            }
+        }
+
+        uint32_t uFrame = 0u;
+        for (auto _ : state)
+        {
+            const std::vector<SceneMatrix>& aLocals = aMoves[uFrame++ % 2u];
+            for (uint32_t i = 0u; i < NUM_OBJECTS; ++i)
+            {
+                if (i % 100u < uMovedPercent)
+                {
+                    hierarchy.SetLocalMatrix(i, aLocals[i]);
+                }
+            }
+            hierarchy.UpdateWorldMatrices(workerPool);
+            benchmark::DoNotOptimize(hierarchy.GetWorldMatrices());
+        }
+        state.SetItemsProcessed(state.iterations() * NUM_OBJECTS);
+    }
+    BENCHMARK(BM_UpdateWorldMatrices100k)->Args({ 1, 0 })->Args({ 100, 0 })->Args({ 100, 3 })->UseRealTime();
+}
@@ -0,0 +1,234 @@
+#include "Scene/SceneHierarchy.h"
+
+#include <cstring>
+#include <random>
+
+#include <gtest/gtest.h>
+
+namespace library
+{
+    namespace
+    {
+        SceneMatrix Translation(float x, float y, float z)
+        {
+            return SceneMatrix{ .m = { { 1.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f, 0.0f }, { x, y, z, 1.0f } } };
+        }
+
+        SceneMatrix Scaling(float fScale)
+        {
+            return SceneMatrix{ .m = { { fScale, 0.0f, 0.0f, 0.0f }, { 0.0f, fScale, 0.0f, 0.0f }, { 0.0f, 0.0f, fScale, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f } } };
+        }
+
+        void ExpectTranslation(const SceneMatrix& matrix, float x, float y, float z)
+        {
+            EXPECT_FLOAT_EQ(matrix.m[3][0], x);
+            EXPECT_FLOAT_EQ(matrix.m[3][1], y);
+            EXPECT_FLOAT_EQ(matrix.m[3][2], z);
+        }
+    }
+
+    TEST(SceneHierarchyTest, MultipliesLikeRowVectors)
+    {
+        SceneMatrix a = {};
+        SceneMatrix b = {};
+        for (uint32_t uRow = 0u; uRow < 4u; ++uRow)
+        {
+            for (uint32_t uColumn = 0u; uColumn < 4u; ++uColumn)
+            {
+                a.m[uRow][uColumn] = static_cast<float>(uRow * 4u + uColumn + 1u);
+                b.m[uRow][uColumn] = static_cast<float>(16u - uRow * 4u - uColumn);
+            }
+        }
+
+        SceneMatrix result;
+        SceneHierarchy::Multiply(a, b, result);
+
+        for (uint32_t uRow = 0u; uRow < 4u; ++uRow)
+        {
+            for (uint32_t uColumn = 0u; uColumn < 4u; ++uColumn)
+            {
+                float fExpected = 0.0f;
+                for (uint32_t k = 0u; k < 4u; ++k)
+                {
+                    fExpected += a.m[uRow][k] * b.m[k][uColumn];
+                }
+                EXPECT_FLOAT_EQ(result.m[uRow][uColumn], fExpected);
+            }
+        }
+
+        // Scale then translate, the order XMMatrixMultiply applies them in
+        SceneHierarchy::Multiply(Scaling(2.0f), Translation(1.0f, 2.0f, 3.0f), result);
+        EXPECT_FLOAT_EQ(result.m[0][0], 2.0f);
+        ExpectTranslation(result, 1.0f, 2.0f, 3.0f);
+    }
+
+    TEST(SceneHierarchyTest, HandlesSurviveTheRemovalOfOtherObjects)
+    {
+        SceneHierarchy hierarchy;
+        WorkerPool workerPool(0u);
+
+        const SceneHandle first = hierarchy.Add(Translation(1.0f, 0.0f, 0.0f));
+        const SceneHandle second = hierarchy.Add(Translation(2.0f, 0.0f, 0.0f));
+        const SceneHandle third = hierarchy.Add(Translation(3.0f, 0.0f, 0.0f));
+
+        // The last object moves into the place of the first
+        EXPECT_EQ(hierarchy.Remove(first), 0u);
+        EXPECT_FALSE(hierarchy.IsValid(first));
+        EXPECT_EQ(hierarchy.GetNumObjects(), 2u);
+        EXPECT_EQ(hierarchy.GetDenseIndex(second), 1u);
+        EXPECT_EQ(hierarchy.GetDenseIndex(third), 0u);
+
+        hierarchy.UpdateWorldMatrices(workerPool);
+        ExpectTranslation(hierarchy.GetWorldMatrices()[hierarchy.GetDenseIndex(second)], 2.0f, 0.0f, 0.0f);
+        ExpectTranslation(hierarchy.GetWorldMatrices()[hierarchy.GetDenseIndex(third)], 3.0f, 0.0f, 0.0f);
+    }
+
+    TEST(SceneHierarchyTest, ReusedSlotsInvalidateOldHandles)
+    {
+        SceneHierarchy hierarchy;
+
+        const SceneHandle removed = hierarchy.Add(Translation(0.0f, 0.0f, 0.0f));
+        EXPECT_NE(hierarchy.Remove(removed), SceneHierarchy::INVALID_INDEX);
+        EXPECT_EQ(hierarchy.Remove(removed), SceneHierarchy::INVALID_INDEX);
+
+        const SceneHandle reused = hierarchy.Add(Translation(0.0f, 0.0f, 0.0f));
+        EXPECT_EQ(reused.uIndex, removed.uIndex);
+        EXPECT_NE(reused.uGeneration, removed.uGeneration);
+        EXPECT_TRUE(hierarchy.IsValid(reused));
+        EXPECT_FALSE(hierarchy.IsValid(removed));
+        EXPECT_FALSE(hierarchy.IsValid(SceneHandle{}));
+        EXPECT_FALSE(hierarchy.IsValid(SceneHandle{ .uIndex = 7u, .uGeneration = 1u }));
+    }
+
+    TEST(SceneHierarchyTest, ComposesParentsBeforeChildren)
+    {
+        SceneHierarchy hierarchy;
+        WorkerPool workerPool(0u);
+
+        // Added child first, so the dense order is not the update order
+        const SceneHandle grandchild = hierarchy.Add(Translation(0.0f, 0.0f, 1.0f));
+        const SceneHandle child = hierarchy.Add(Translation(0.0f, 1.0f, 0.0f));
+        const SceneHandle root = hierarchy.Add(Translation(1.0f, 0.0f, 0.0f));
+        ASSERT_TRUE(hierarchy.SetParent(grandchild, child));
+        ASSERT_TRUE(hierarchy.SetParent(child, root));
+
+        hierarchy.UpdateWorldMatrices(workerPool);
+        ExpectTranslation(hierarchy.GetWorldMatrices()[hierarchy.GetDenseIndex(root)], 1.0f, 0.0f, 0.0f);
+        ExpectTranslation(hierarchy.GetWorldMatrices()[hierarchy.GetDenseIndex(child)], 1.0f, 1.0f, 0.0f);
+        ExpectTranslation(hierarchy.GetWorldMatrices()[hierarchy.GetDenseIndex(grandchild)], 1.0f, 1.0f, 1.0f);
+    }
+
+    TEST(SceneHierarchyTest, RejectsCycles)
+    {
+        SceneHierarchy hierarchy;
+
+        const SceneHandle parent = hierarchy.Add(Translation(0.0f, 0.0f, 0.0f));
+        const SceneHandle child = hierarchy.Add(Translation(0.0f, 0.0f, 0.0f));
+        ASSERT_TRUE(hierarchy.SetParent(child, parent));
+
+        EXPECT_FALSE(hierarchy.SetParent(parent, child));
+        EXPECT_FALSE(hierarchy.SetParent(parent, parent));
+        EXPECT_TRUE(hierarchy.SetParent(child, SceneHandle{}));
+        EXPECT_TRUE(hierarchy.SetParent(parent, child));
+    }
+
+    TEST(SceneHierarchyTest, OnlyRecomputesWhatMoved)
+    {
+        SceneHierarchy hierarchy;
+        WorkerPool workerPool(0u);
+
+        const SceneHandle root = hierarchy.Add(Translation(0.0f, 0.0f, 0.0f));
+        const SceneHandle child = hierarchy.Add(Translation(0.0f, 1.0f, 0.0f));
+        const SceneHandle other = hierarchy.Add(Translation(5.0f, 0.0f, 0.0f));
+        ASSERT_TRUE(hierarchy.SetParent(child, root));
+
+        hierarchy.UpdateWorldMatrices(workerPool);
+        EXPECT_EQ(hierarchy.GetNumUpdatedWorldMatrices(), 3u);
+
+        hierarchy.UpdateWorldMatrices(workerPool);
+        EXPECT_EQ(hierarchy.GetNumUpdatedWorldMatrices(), 0u);
+
+        // The same matrix again is not a move
+        hierarchy.SetLocalMatrix(hierarchy.GetDenseIndex(root), Translation(0.0f, 0.0f, 0.0f));
+        hierarchy.UpdateWorldMatrices(workerPool);
+        EXPECT_EQ(hierarchy.GetNumUpdatedWorldMatrices(), 0u);
+
+        hierarchy.SetLocalMatrix(hierarchy.GetDenseIndex(root), Translation(2.0f, 0.0f, 0.0f));
+        hierarchy.UpdateWorldMatrices(workerPool);
+        EXPECT_EQ(hierarchy.GetNumUpdatedWorldMatrices(), 2u);
+        EXPECT_TRUE(hierarchy.GetMovedFlags()[hierarchy.GetDenseIndex(root)]);
+        EXPECT_TRUE(hierarchy.GetMovedFlags()[hierarchy.GetDenseIndex(child)]);
+        EXPECT_FALSE(hierarchy.GetMovedFlags()[hierarchy.GetDenseIndex(other)]);
+        ExpectTranslation(hierarchy.GetWorldMatrices()[hierarchy.GetDenseIndex(child)], 2.0f, 1.0f, 0.0f);
+    }
+
+    TEST(SceneHierarchyTest, ChildrenOfARemovedParentBecomeRoots)
+    {
+        SceneHierarchy hierarchy;
+        WorkerPool workerPool(0u);
+
+        const SceneHandle parent = hierarchy.Add(Translation(10.0f, 0.0f, 0.0f));
+        const SceneHandle child = hierarchy.Add(Translation(0.0f, 1.0f, 0.0f));
+        ASSERT_TRUE(hierarchy.SetParent(child, parent));
+        hierarchy.UpdateWorldMatrices(workerPool);
+        ExpectTranslation(hierarchy.GetWorldMatrices()[hierarchy.GetDenseIndex(child)], 10.0f, 1.0f, 0.0f);
+
+        hierarchy.Remove(parent);
+        hierarchy.UpdateWorldMatrices(workerPool);
+        ExpectTranslation(hierarchy.GetWorldMatrices()[hierarchy.GetDenseIndex(child)], 0.0f, 1.0f, 0.0f);
+
+        // The slot of the parent is reused, the child must not attach to the new object
+        const SceneHandle reused = hierarchy.Add(Translation(20.0f, 0.0f, 0.0f));
+        EXPECT_EQ(reused.uIndex, parent.uIndex);
+        hierarchy.UpdateWorldMatrices(workerPool);
+        ExpectTranslation(hierarchy.GetWorldMatrices()[hierarchy.GetDenseIndex(child)], 0.0f, 1.0f, 0.0f);
+    }
+
+    // Wide levels are split across the pool, which must give the matrices a single thread gives
+    TEST(SceneHierarchyTest, UpdatesOneHundredThousandObjectsOnThePool)
+    {
+        constexpr const uint32_t NUM_OBJECTS = 100000u;
+
+        SceneHierarchy serial;
+        SceneHierarchy parallel;
+        std::mt19937 random(100000u);
+        std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+        std::vector<SceneHandle> aSerialHandles;
+        std::vector<SceneHandle> aParallelHandles;
+        for (uint32_t i = 0u; i < NUM_OBJECTS; ++i)
+        {
+            const SceneMatrix local = Translation(offset(random), offset(random), offset(random));
+            aSerialHandles.push_back(serial.Add(local));
+            aParallelHandles.push_back(parallel.Add(local));
+
+            // Chains up to four deep under the first thousand objects
+            if (i >= 1000u)
+            {
+                const uint32_t uParent = static_cast<uint32_t>(random() % (i / 4u));
+                ASSERT_TRUE(serial.SetParent(aSerialHandles[i], aSerialHandles[uParent]));
+                ASSERT_TRUE(parallel.SetParent(aParallelHandles[i], aParallelHandles[uParent]));
+            }
+        }
+
+        WorkerPool noWorkers(0u);
+        WorkerPool threeWorkers(3u);
+        for (uint32_t uFrame = 0u; uFrame < 3u; ++uFrame)
+        {
+            // Move every hundredth object
+            for (uint32_t i = uFrame; i < NUM_OBJECTS; i += 100u)
+            {
+                const SceneMatrix local = Translation(offset(random), offset(random), offset(random));
+                serial.SetLocalMatrix(serial.GetDenseIndex(aSerialHandles[i]), local);
+                parallel.SetLocalMatrix(parallel.GetDenseIndex(aParallelHandles[i]), local);
+            }
+
+            serial.UpdateWorldMatrices(noWorkers);
+            parallel.UpdateWorldMatrices(threeWorkers);
+
+            ASSERT_EQ(serial.GetNumUpdatedWorldMatrices(), parallel.GetNumUpdatedWorldMatrices());
+            EXPECT_EQ(memcmp(serial.GetWorldMatrices(), parallel.GetWorldMatrices(), sizeof(SceneMatrix) * NUM_OBJECTS), 0);
+            EXPECT_EQ(memcmp(serial.GetMovedFlags(), parallel.GetMovedFlags(), NUM_OBJECTS), 0);
+        }
+        EXPECT_LT(serial.GetNumUpdatedWorldMatrices(), NUM_OBJECTS);
+    }
+}
@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Shader/ShaderCache.h"
+
+namespace library
+{
+    namespace
+    {
+        // Returns the source and the options as bytecode, so a stale entry shows up in the result
+        class MockShaderCompiler final : public IShaderCompiler
+        {
+        public:
+            bool Compile(const std::filesystem::path& sourcePath, const char* pszEntryPoint, const char* pszShaderModel, const std::vector<std::string>& aDefines, uint32_t uFlags, std::vector<uint8_t>& aBytecode, std::string& errors) override
+            {
+                ++m_uNumCalls;
+
+                if (m_bFail)
+                {
+                    errors = "error X3000: syntax error";
+                    return false;
+                }
+
+                std::string bytecode = readFile(sourcePath) + "|" + pszEntryPoint + "|" + pszShaderModel + "|" + std::to_string(uFlags);
+                for (const std::string& define : aDefines)
+                {
+                    bytecode += "|" + define;
+                }
+                aBytecode.assign(bytecode.begin(), bytecode.end());
+                return true;
+            }
+
+            uint32_t GetNumCalls() const
+            {
+                return m_uNumCalls.load();
+            }
+
+            void SetFail(bool bFail)
+            {
+                m_bFail = bFail;
+            }
+
+            static std::string readFile(const std::filesystem::path& path)
+            {
+                std::ifstream file(path, std::ios::binary);
+                return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            }
+
+        private:
+            std::atomic<uint32_t> m_uNumCalls = 0u;
+            bool m_bFail = false;
+        };
+
+        class ShaderCacheTest : public testing::Test
+        {
+        protected:
+            void SetUp() override
+            {
+                const testing::TestInfo* pTestInfo = testing::UnitTest::GetInstance()->current_test_info();
+                m_root = std::filesystem::temp_directory_path() / "ShaderCacheTests" / pTestInfo->name();
+                std::filesystem::remove_all(m_root);
+                std::filesystem::create_directories(m_root / "Shaders");
+
+                m_compiler = std::make_shared<MockShaderCompiler>();
+                m_cache = std::make_unique<ShaderCache>(m_root / "Cache", m_compiler);
+
+                writeFile("Common.fxh", "float4 Color;\n");
+                writeFile("Voxel.fx", "#include \"Common.fxh\"\nfloat4 PSVoxel() : SV_TARGET { return Color; }\n");
+            }
+
+            void TearDown() override
+            {
+                std::error_code ec;
+                std::filesystem::remove_all(m_root, ec);
+            }
+
+            std::filesystem::path writeFile(const char* pszName, const std::string& contents)
+            {
+                std::filesystem::path path = m_root / "Shaders" / pszName;
+                std::ofstream file(path, std::ios::binary | std::ios::trunc);
+                file << contents;
+                return path;
+            }
+
+            bool compile(std::vector<uint8_t>& aBytecode, const std::vector<std::string>& aDefines = {}, const char* pszEntryPoint = "PSVoxel", uint32_t uFlags = 0u)
+            {
+                std::string errors;
+                return m_cache->Compile(m_root / "Shaders" / "Voxel.fx", pszEntryPoint, "ps_5_0", aDefines, uFlags, aBytecode, errors);
+            }
+
+            std::vector<std::filesystem::path> getEntries() const
+            {
+                std::vector<std::filesystem::path> aEntries;
+                for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(m_root / "Cache"))
+                {
+                    aEntries.push_back(entry.path());
+                }
+                return aEntries;
+            }
+
+        protected:
+            std::filesystem::path m_root;
+            std::shared_ptr<MockShaderCompiler> m_compiler;
+            std::unique_ptr<ShaderCache> m_cache;
+        };
+    }
+
+    TEST_F(ShaderCacheTest, CompilesOnAMissAndLoadsOnAHit)
+    {
+        std::vector<uint8_t> aMissBytecode;
+        ASSERT_TRUE(compile(aMissBytecode));
+        EXPECT_EQ(m_compiler->GetNumCalls(), 1u);
+        EXPECT_EQ(m_cache->GetNumMisses(), 1u);
+        EXPECT_EQ(m_cache->GetNumHits(), 0u);
+        EXPECT_EQ(getEntries().size(), 1u);
+
+        std::vector<uint8_t> aHitBytecode;
+        ASSERT_TRUE(compile(aHitBytecode));
+        EXPECT_EQ(m_compiler->GetNumCalls(), 1u);
+        EXPECT_EQ(m_cache->GetNumHits(), 1u);
+        EXPECT_EQ(aHitBytecode, aMissBytecode);
+    }
+
+    TEST_F(ShaderCacheTest, KeepsEntriesAcrossInstances)
+    {
+        std::vector<uint8_t> aBytecode;
+        ASSERT_TRUE(compile(aBytecode));
+
+        ShaderCache relaunched(m_root / "Cache", m_compiler);
+        std::vector<uint8_t> aLoadedBytecode;
+        std::string errors;
+        ASSERT_TRUE(relaunched.Compile(m_root / "Shaders" / "Voxel.fx", "PSVoxel", "ps_5_0", {}, 0u, aLoadedBytecode, errors));
+        EXPECT_EQ(relaunched.GetNumHits(), 1u);
+        EXPECT_EQ(m_compiler->GetNumCalls(), 1u);
+        EXPECT_EQ(aLoadedBytecode, aBytecode);
+    }
+
+    TEST_F(ShaderCacheTest, MissesWhenTheOptionsChange)
+    {
+        std::vector<uint8_t> aBytecode;
+        ASSERT_TRUE(compile(aBytecode));
+        ASSERT_TRUE(compile(aBytecode, { "HAS_NORMAL_MAP" }));
+        ASSERT_TRUE(compile(aBytecode, {}, "PSVoxelShadow"));
+        ASSERT_TRUE(compile(aBytecode, {}, "PSVoxel", 1u));
+
+        EXPECT_EQ(m_compiler->GetNumCalls(), 4u);
+        EXPECT_EQ(m_cache->GetNumMisses(), 4u);
+        EXPECT_EQ(getEntries().size(), 4u);
+
+        // Every variant now hits its own entry
+        std::vector<uint8_t> aDefineBytecode;
+        ASSERT_TRUE(compile(aDefineBytecode, { "HAS_NORMAL_MAP" }));
+        EXPECT_EQ(m_compiler->GetNumCalls(), 4u);
+        EXPECT_NE(std::string(aDefineBytecode.begin(), aDefineBytecode.end()).find("HAS_NORMAL_MAP"), std::string::npos);
+    }
+
+    TEST_F(ShaderCacheTest, RecompilesWhenAnIncludedFileChanges)
+    {
+        std::vector<uint8_t> aBytecode;
+        ASSERT_TRUE(compile(aBytecode));
+
+        writeFile("Common.fxh", "float4 Color;\nfloat4 Tint;\n");
+
+        std::vector<uint8_t> aEditedBytecode;
+        ASSERT_TRUE(compile(aEditedBytecode));
+        EXPECT_EQ(m_compiler->GetNumCalls(), 2u);
+        EXPECT_EQ(m_cache->GetNumHits(), 0u);
+
+        ASSERT_TRUE(compile(aEditedBytecode));
+        EXPECT_EQ(m_compiler->GetNumCalls(), 2u);
+        EXPECT_EQ(m_cache->GetNumHits(), 1u);
+    }
+
+    TEST_F(ShaderCacheTest, RecompilesWhenAnIncludedFileAppears)
+    {
+        std::filesystem::remove(m_root / "Shaders" / "Common.fxh");
+
+        std::vector<uint8_t> aBytecode;
+        ASSERT_TRUE(compile(aBytecode));
+
+        writeFile("Common.fxh", "float4 Color;\n");
+        ASSERT_TRUE(compile(aBytecode));
+        EXPECT_EQ(m_compiler->GetNumCalls(), 2u);
+    }
+
+    TEST_F(ShaderCacheTest, DeletesAndRecompilesACorruptEntry)
+    {
+        std::vector<uint8_t> aBytecode;
+        ASSERT_TRUE(compile(aBytecode));
+        std::filesystem::path entryPath = getEntries().front();
+
+        {
+            // Flip the last byte of the bytecode, the header still matches
+            std::fstream file(entryPath, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekg(-1, std::ios::end);
+            char last = static_cast<char>(file.get());
+            file.seekp(-1, std::ios::end);
+            file.put(static_cast<char>(last ^ 0x5a));
+        }
+
+        std::vector<uint8_t> aRecompiledBytecode;
+        ASSERT_TRUE(compile(aRecompiledBytecode));
+        EXPECT_EQ(m_cache->GetNumCorrupt(), 1u);
+        EXPECT_EQ(m_compiler->GetNumCalls(), 2u);
+        EXPECT_EQ(aRecompiledBytecode, aBytecode);
+
+        // The corrupt entry was replaced by a valid one
+        ASSERT_TRUE(compile(aRecompiledBytecode));
+        EXPECT_EQ(m_cache->GetNumHits(), 1u);
+        EXPECT_EQ(m_cache->GetNumCorrupt(), 1u);
+    }
+
+    TEST_F(ShaderCacheTest, DeletesATruncatedEntry)
+    {
+        std::vector<uint8_t> aBytecode;
+        ASSERT_TRUE(compile(aBytecode));
+        std::filesystem::path entryPath = getEntries().front();
+        std::filesystem::resize_file(entryPath, std::filesystem::file_size(entryPath) / 2u);
+
+        m_compiler->SetFail(true);
+        std::vector<uint8_t> aNoBytecode;
+        EXPECT_FALSE(compile(aNoBytecode));
+        EXPECT_EQ(m_cache->GetNumCorrupt(), 1u);
+        EXPECT_TRUE(aNoBytecode.empty());
+        EXPECT_FALSE(std::filesystem::exists(entryPath));
+    }
+
+    TEST_F(ShaderCacheTest, DoesNotStoreAFailedCompile)
+    {
+        m_compiler->SetFail(true);
+
+        std::vector<uint8_t> aBytecode;
+        std::string errors;
+        EXPECT_FALSE(m_cache->Compile(m_root / "Shaders" / "Voxel.fx", "PSVoxel", "ps_5_0", {}, 0u, aBytecode, errors));
+        EXPECT_EQ(errors, "error X3000: syntax error");
+        EXPECT_FALSE(std::filesystem::exists(m_root / "Cache"));
+
+        m_compiler->SetFail(false);
+        ASSERT_TRUE(compile(aBytecode));
+        EXPECT_EQ(m_compiler->GetNumCalls(), 2u);
+        EXPECT_EQ(m_cache->GetNumMisses(), 2u);
+    }
+
+    TEST_F(ShaderCacheTest, FailsWithoutACompiler)
+    {
+        ShaderCache cache(m_root / "Cache", nullptr);
+
+        std::vector<uint8_t> aBytecode;
+        std::string errors;
+        EXPECT_FALSE(cache.Compile(m_root / "Shaders" / "Voxel.fx", "PSVoxel", "ps_5_0", {}, 0u, aBytecode, errors));
+        EXPECT_FALSE(errors.empty());
+    }
+
+    TEST_F(ShaderCacheTest, FindsEveryIncludedFileOnce)
+    {
+        writeFile("Lighting.fxh", "#include \"Common.fxh\"\n");
+        std::filesystem::path sourcePath = writeFile("Scene.fx", "#include \"Common.fxh\"\n  #  include <Lighting.fxh>\n// #include \"Commented.fxh\" is not a directive\n");
+
+        std::vector<std::filesystem::path> aDependencies;
+        ShaderCache::FindDependencies(sourcePath, aDependencies);
+
+        ASSERT_EQ(aDependencies.size(), 3u);
+        EXPECT_EQ(aDependencies[0].filename(), "Scene.fx");
+        EXPECT_EQ(aDependencies[1].filename(), "Common.fxh");
+        EXPECT_EQ(aDependencies[2].filename(), "Lighting.fxh");
+    }
+}
@@ -0,0 +1,150 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Shader/ShaderWatcher.h"
+
+namespace library
+{
+    namespace
+    {
+        class ShaderWatcherTest : public testing::Test
+        {
+        protected:
+            void SetUp() override
+            {
+                const testing::TestInfo* pTestInfo = testing::UnitTest::GetInstance()->current_test_info();
+                m_root = std::filesystem::temp_directory_path() / "ShaderWatcherTests" / pTestInfo->name();
+                std::filesystem::remove_all(m_root);
+                std::filesystem::create_directories(m_root / "Shaders");
+
+                writeFile("Common.fxh", "float4 Color;\n");
+                writeFile("Lighting.fxh", "#include \"Common.fxh\"\n");
+                writeFile("Voxel.fx", "#include \"Lighting.fxh\"\nfloat4 PSVoxel() : SV_TARGET { return Color; }\n");
+                writeFile("Sky.fx", "float4 PSSky() : SV_TARGET { return 0; }\n");
+            }
+
+            void TearDown() override
+            {
+                std::error_code ec;
+                std::filesystem::remove_all(m_root, ec);
+            }
+
+            std::filesystem::path getPath(const char* pszName) const
+            {
+                return m_root / "Shaders" / pszName;
+            }
+
+            // Moves the write time a second ahead, so the edit shows up whatever the resolution of the file system
+            std::filesystem::path writeFile(const char* pszName, const std::string& contents)
+            {
+                std::filesystem::path path = getPath(pszName);
+                std::error_code ec;
+                const std::filesystem::file_time_type previousWriteTime = std::filesystem::last_write_time(path, ec);
+                {
+                    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+                    file << contents;
+                }
+                if (!ec)
+                {
+                    std::filesystem::last_write_time(path, previousWriteTime + std::chrono::seconds(1));
+                }
+                return path;
+            }
+
+            std::vector<uint32_t> poll()
+            {
+                std::vector<uint32_t> aChangedSources;
+                m_watcher.Poll(aChangedSources);
+                return aChangedSources;
+            }
+
+        protected:
+            std::filesystem::path m_root;
+            ShaderWatcher m_watcher;
+        };
+    }
+
+    TEST_F(ShaderWatcherTest, ReportsNothingUntilAFileChanges)
+    {
+        m_watcher.Watch(getPath("Voxel.fx"));
+        m_watcher.Watch(getPath("Sky.fx"));
+
+        EXPECT_EQ(m_watcher.GetNumWatchedFiles(), 4u);
+        EXPECT_TRUE(poll().empty());
+        EXPECT_TRUE(poll().empty());
+    }
+
+    TEST_F(ShaderWatcherTest, ReportsTheSourcesOfAChangedFile)
+    {
+        const uint32_t uVoxel = m_watcher.Watch(getPath("Voxel.fx"));
+        const uint32_t uSky = m_watcher.Watch(getPath("Sky.fx"));
+
+        writeFile("Sky.fx", "float4 PSSky() : SV_TARGET { return 1; }\n");
+        EXPECT_EQ(poll(), std::vector<uint32_t>{ uSky });
+        EXPECT_TRUE(poll().empty());
+
+        writeFile("Voxel.fx", "#include \"Lighting.fxh\"\nfloat4 PSVoxel() : SV_TARGET { return 2 * Color; }\n");
+        EXPECT_EQ(poll(), std::vector<uint32_t>{ uVoxel });
+    }
+
+    // An include of an include is a dependency too, and every shader compiled from the source is reported
+    TEST_F(ShaderWatcherTest, ReportsTheSourcesIncludingAChangedFile)
+    {
+        const uint32_t uVoxelPixel = m_watcher.Watch(getPath("Voxel.fx"));
+        m_watcher.Watch(getPath("Sky.fx"));
+        const uint32_t uVoxelVertex = m_watcher.Watch(getPath("Voxel.fx"));
+        EXPECT_EQ(m_watcher.GetNumWatchedFiles(), 4u);
+
+        writeFile("Common.fxh", "float4 Color;\nfloat4 Tint;\n");
+        EXPECT_EQ(poll(), (std::vector<uint32_t>{ uVoxelPixel, uVoxelVertex }));
+        EXPECT_TRUE(poll().empty());
+    }
+
+    // An edit adding an include starts watching it, from the poll that saw the edit
+    TEST_F(ShaderWatcherTest, WatchesTheIncludesAnEditAdds)
+    {
+        const uint32_t uVoxel = m_watcher.Watch(getPath("Voxel.fx"));
+        writeFile("Shadows.fxh", "float4 ShadowColor;\n");
+        ASSERT_EQ(m_watcher.GetDependencies(uVoxel).size(), 3u);
+
+        writeFile("Lighting.fxh", "#include \"Common.fxh\"\n#include \"Shadows.fxh\"\n");
+        EXPECT_EQ(poll(), std::vector<uint32_t>{ uVoxel });
+        ASSERT_EQ(m_watcher.GetDependencies(uVoxel).size(), 4u);
+        EXPECT_EQ(m_watcher.GetDependencies(uVoxel)[3].filename(), "Shadows.fxh");
+        EXPECT_TRUE(poll().empty());
+
+        writeFile("Shadows.fxh", "float4 ShadowColor;\nfloat ShadowBias;\n");
+        EXPECT_EQ(poll(), std::vector<uint32_t>{ uVoxel });
+    }
+
+    // An include removed by an edit no longer recompiles the source
+    TEST_F(ShaderWatcherTest, ForgetsTheIncludesAnEditRemoves)
+    {
+        const uint32_t uVoxel = m_watcher.Watch(getPath("Voxel.fx"));
+
+        writeFile("Lighting.fxh", "float4 Color;\n");
+        EXPECT_EQ(poll(), std::vector<uint32_t>{ uVoxel });
+        EXPECT_EQ(m_watcher.GetDependencies(uVoxel).size(), 2u);
+
+        writeFile("Common.fxh", "float4 Color;\nfloat4 Tint;\n");
+        EXPECT_TRUE(poll().empty());
+    }
+
+    // A deleted include fails the compile, the same include written back fixes it
+    TEST_F(ShaderWatcherTest, ReportsAnIncludeDisappearingAndAppearing)
+    {
+        const uint32_t uVoxel = m_watcher.Watch(getPath("Voxel.fx"));
+
+        std::filesystem::remove(getPath("Common.fxh"));
+        EXPECT_EQ(poll(), std::vector<uint32_t>{ uVoxel });
+        EXPECT_TRUE(poll().empty());
+
+        writeFile("Common.fxh", "float4 Color;\n");
+        EXPECT_EQ(poll(), std::vector<uint32_t>{ uVoxel });
+    }
+}
@@ -0,0 +1,76 @@
+#include <cstdint>
+#include <cstdlib>
+
+#include "Texture/DDSParser.h"
+
+namespace
+{
+    // Reads the first and the last byte of every subresource, so the sanitizers catch a layout that points past the data
+    uint8_t TouchSubresources(const uint8_t* pBitData, size_t uBitSize, const DirectX::DDS_TEXTURE_LAYOUT& layout)
+    {
+        uint8_t uSum = 0u;
+        size_t uOffset = 0u;
+        for (uint32_t j = 0u; j < layout.arraySize; ++j)
+        {
+            size_t w = layout.width;
+            size_t h = layout.height;
+            size_t d = layout.depth;
+            for (uint32_t i = 0u; i < layout.mipCount; ++i)
+            {
+                size_t uNumBytes = 0u;
+                if (FAILED(DirectX::GetSurfaceInfo(w, h, layout.format, &uNumBytes, nullptr, nullptr)))
+                {
+                    abort();
+                }
+
+                size_t uSize = uNumBytes * d;
+                if (uSize > uBitSize - uOffset)
+                {
+                    abort();
+                }
+                if (uSize)
+                {
+                    uSum = static_cast<uint8_t>(uSum + pBitData[uOffset] + pBitData[uOffset + uSize - 1u]);
+                }
+                uOffset += uSize;
+
+                w = w > 1u ? w >> 1 : 1u;
+                h = h > 1u ? h >> 1 : 1u;
+                d = d > 1u ? d >> 1 : 1u;
+            }
+        }
+        return uSum;
+    }
+}
+
+// Entry point of libFuzzer, also driven by DDSParserFuzzerMain when libFuzzer is not available
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* pData, size_t uSize)
+{
+    const DirectX::DDS_HEADER* pHeader = nullptr;
+    const uint8_t* pBitData = nullptr;
+    size_t uBitSize = 0u;
+    if (FAILED(DirectX::LoadTextureDataFromMemory(pData, uSize, &pHeader, &pBitData, &uBitSize)))
+    {
+        return 0;
+    }
+
+    if (DirectX::GetAlphaMode(pHeader) > DirectX::DDS_ALPHA_MODE_CUSTOM)
+    {
+        abort();
+    }
+
+    DirectX::DDS_TEXTURE_LAYOUT layout;
+    if (FAILED(DirectX::ValidateDDSTextureMemory(pData, uSize, &layout)))
+    {
+        return 0;
+    }
+
+    if (!layout.width || !layout.height || !layout.depth || !layout.mipCount || !layout.arraySize || DirectX::BitsPerPixel(layout.format) == 0u)
+    {
+        abort();
+    }
+
+    volatile uint8_t uSum = TouchSubresources(pBitData, uBitSize, layout);
+    static_cast<void>(uSum);
+    return 0;
+}
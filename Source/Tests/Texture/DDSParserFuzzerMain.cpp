@@ -0,0 +1,154 @@
+// Runs the DDS parser fuzz target without libFuzzer: every file named on the command
+// line, then a fixed number of random mutations of valid files. The seed is fixed, so
+// a failure reproduces by running the same build again.
+//
+//   DDSParserFuzzer [--runs=N] [file...]
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Texture/DDSParser.h"
+#include "Texture/DDSTestFiles.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* pData, size_t uSize);
+
+namespace
+{
+    // Copies the input to an allocation of exactly its size, so reading one byte past it is caught
+    void RunOne(const std::vector<uint8_t>& aInput)
+    {
+        std::unique_ptr<uint8_t[]> pCopy(new uint8_t[aInput.size() + (aInput.empty() ? 1u : 0u)]);
+        if (!aInput.empty())
+        {
+            memcpy(pCopy.get(), aInput.data(), aInput.size());
+        }
+        LLVMFuzzerTestOneInput(pCopy.get(), aInput.size());
+    }
+
+    std::vector<std::vector<uint8_t>> MakeSeeds()
+    {
+        using namespace DirectX;
+
+        std::vector<std::vector<uint8_t>> aSeeds;
+        aSeeds.push_back(MakeDDSFile(MakeFourCCHeader(MAKEFOURCC('D', 'X', 'T', '1'), 64u, 32u, 7u), nullptr, GetTextureDataSize(DXGI_FORMAT_BC1_UNORM, 64u, 32u, 1u, 7u, 1u)));
+
+        DDS_HEADER_DXT10 cube = {};
+        cube.dxgiFormat = DXGI_FORMAT_BC7_UNORM_SRGB;
+        cube.resourceDimension = D3D11_RESOURCE_DIMENSION_TEXTURE2D;
+        cube.miscFlag = D3D11_RESOURCE_MISC_TEXTURECUBE;
+        cube.arraySize = 1u;
+        aSeeds.push_back(MakeDDSFile(MakeDX10Header(16u, 16u, 5u), &cube, GetTextureDataSize(DXGI_FORMAT_BC7_UNORM_SRGB, 16u, 16u, 1u, 5u, 6u)));
+
+        DDS_HEADER_DXT10 volume = {};
+        volume.dxgiFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
+        volume.resourceDimension = D3D11_RESOURCE_DIMENSION_TEXTURE3D;
+        volume.arraySize = 1u;
+        DDS_HEADER volumeHeader = MakeDX10Header(8u, 8u, 4u);
+        volumeHeader.flags |= DDS_HEADER_FLAGS_VOLUME;
+        volumeHeader.depth = 8u;
+        aSeeds.push_back(MakeDDSFile(volumeHeader, &volume, GetTextureDataSize(DXGI_FORMAT_R8G8B8A8_UNORM, 8u, 8u, 8u, 4u, 1u)));
+
+        DDS_HEADER_DXT10 array = {};
+        array.dxgiFormat = DXGI_FORMAT_NV12;
+        array.resourceDimension = D3D11_RESOURCE_DIMENSION_TEXTURE1D;
+        array.arraySize = 3u;
+        aSeeds.push_back(MakeDDSFile(MakeDX10Header(32u, 1u, 1u), &array, GetTextureDataSize(DXGI_FORMAT_NV12, 32u, 1u, 1u, 1u, 3u)));
+
+        DDS_HEADER rgb = MakeFourCCHeader(0u, 8u, 8u, 4u);
+        rgb.ddspf.flags = DDS_RGB;
+        rgb.ddspf.RGBBitCount = 16u;
+        rgb.ddspf.RBitMask = 0xf800u;
+        rgb.ddspf.GBitMask = 0x07e0u;
+        rgb.ddspf.BBitMask = 0x001fu;
+        aSeeds.push_back(MakeDDSFile(rgb, nullptr, GetTextureDataSize(DXGI_FORMAT_B5G6R5_UNORM, 8u, 8u, 1u, 4u, 1u)));
+
+        return aSeeds;
+    }
+
+    // Overwrites a header field, flips bits, or changes the length, favoring the header where the parser branches
+    void Mutate(std::vector<uint8_t>& aInput, std::mt19937& random)
+    {
+        static constexpr const uint32_t INTERESTING_VALUES[] =
+        {
+            0u, 1u, 2u, 3u, 4u, 6u, 7u, 15u, 16u, 2048u, 2049u, 16384u, 16385u, 0x7fffffffu, 0x80000000u, 0xffffffffu,
+            DDS_FOURCC, DDS_RGB, DDS_LUMINANCE, DDS_ALPHA, DDS_BUMPDUDV, DDS_HEADER_FLAGS_VOLUME, DDS_CUBEMAP, DDS_CUBEMAP_ALLFACES,
+            MAKEFOURCC('D', 'X', '1', '0'), MAKEFOURCC('D', 'X', 'T', '5'), MAKEFOURCC('A', 'T', 'I', '2'), MAKEFOURCC('B', 'C', '5', 'S'),
+        };
+        static constexpr const size_t HEADERS_SIZE = sizeof(uint32_t) + sizeof(DirectX::DDS_HEADER) + sizeof(DirectX::DDS_HEADER_DXT10);
+
+        switch (random() % 4u)
+        {
+        case 0u:
+            if (aInput.size() >= sizeof(uint32_t))
+            {
+                size_t uOffset = (random() % (std::min(aInput.size(), HEADERS_SIZE) / sizeof(uint32_t))) * sizeof(uint32_t);
+                uint32_t uValue = INTERESTING_VALUES[random() % std::size(INTERESTING_VALUES)];
+                memcpy(aInput.data() + uOffset, &uValue, sizeof(uValue));
+            }
+            break;
+
+        case 1u:
+            if (!aInput.empty())
+            {
+                aInput[random() % std::min(aInput.size(), HEADERS_SIZE)] ^= static_cast<uint8_t>(1u << (random() % 8u));
+            }
+            break;
+
+        case 2u:
+            aInput.resize(random() % (aInput.size() + 1u));
+            break;
+
+        default:
+            aInput.resize(aInput.size() + random() % 64u, static_cast<uint8_t>(random()));
+            break;
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t uNumRuns = 200000u;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strncmp(argv[i], "--runs=", 7u) == 0)
+        {
+            uNumRuns = static_cast<uint32_t>(strtoul(argv[i] + 7, nullptr, 10));
+            continue;
+        }
+
+        std::ifstream file(argv[i], std::ios::binary);
+        if (!file)
+        {
+            fprintf(stderr, "Can't open \"%s\"\n", argv[i]);
+            return 1;
+        }
+        RunOne(std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()));
+    }
+
+    std::vector<std::vector<uint8_t>> aSeeds = MakeSeeds();
+    for (const std::vector<uint8_t>& seed : aSeeds)
+    {
+        RunOne(seed);
+    }
+
+    std::mt19937 random(0x44445320u);
+    for (uint32_t uRun = 0u; uRun < uNumRuns; ++uRun)
+    {
+        std::vector<uint8_t> aInput = aSeeds[random() % aSeeds.size()];
+        uint32_t uNumMutations = 1u + random() % 4u;
+        for (uint32_t i = 0u; i < uNumMutations; ++i)
+        {
+            Mutate(aInput, random);
+        }
+        RunOne(aInput);
+    }
+
+    printf("Ran %u inputs\n", uNumRuns + static_cast<uint32_t>(aSeeds.size()));
+    return 0;
+}
@@ -0,0 +1,196 @@
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Texture/DDSParser.h"
+#include "Texture/DDSTestFiles.h"
+
+namespace DirectX
+{
+    namespace
+    {
+        std::vector<uint8_t> MakeCubeMapFile(uint32_t uNumCubes, size_t uDataSizeDelta)
+        {
+            DDS_HEADER_DXT10 extension = {};
+            extension.dxgiFormat = DXGI_FORMAT_BC7_UNORM;
+            extension.resourceDimension = D3D11_RESOURCE_DIMENSION_TEXTURE2D;
+            extension.miscFlag = D3D11_RESOURCE_MISC_TEXTURECUBE;
+            extension.arraySize = uNumCubes;
+            return MakeDDSFile(MakeDX10Header(64u, 64u, 7u), &extension, GetTextureDataSize(DXGI_FORMAT_BC7_UNORM, 64u, 64u, 1u, 7u, 6u * uNumCubes) + uDataSizeDelta);
+        }
+    }
+
+    TEST(DDSParserTest, ReadsTheLayoutOfALegacyTexture)
+    {
+        std::vector<uint8_t> aFile = MakeDDSFile(MakeFourCCHeader(MAKEFOURCC('D', 'X', 'T', '1'), 256u, 128u, 9u), nullptr, GetTextureDataSize(DXGI_FORMAT_BC1_UNORM, 256u, 128u, 1u, 9u, 1u));
+
+        DDS_TEXTURE_LAYOUT layout;
+        ASSERT_EQ(ValidateDDSTextureMemory(aFile.data(), aFile.size(), &layout), S_OK);
+        EXPECT_EQ(layout.resourceDimension, static_cast<uint32_t>(D3D11_RESOURCE_DIMENSION_TEXTURE2D));
+        EXPECT_EQ(layout.width, 256u);
+        EXPECT_EQ(layout.height, 128u);
+        EXPECT_EQ(layout.depth, 1u);
+        EXPECT_EQ(layout.mipCount, 9u);
+        EXPECT_EQ(layout.arraySize, 1u);
+        EXPECT_EQ(layout.format, DXGI_FORMAT_BC1_UNORM);
+        EXPECT_FALSE(layout.isCubeMap);
+    }
+
+    TEST(DDSParserTest, ReadsTheBitMasksOfALegacyTexture)
+    {
+        DDS_HEADER header = MakeFourCCHeader(0u, 4u, 4u, 1u);
+        header.ddspf.flags = DDS_RGB;
+        header.ddspf.RGBBitCount = 32u;
+        header.ddspf.RBitMask = 0x000000ffu;
+        header.ddspf.GBitMask = 0x0000ff00u;
+        header.ddspf.BBitMask = 0x00ff0000u;
+        header.ddspf.ABitMask = 0xff000000u;
+        std::vector<uint8_t> aFile = MakeDDSFile(header, nullptr, 4u * 4u * 4u);
+
+        DDS_TEXTURE_LAYOUT layout;
+        ASSERT_EQ(ValidateDDSTextureMemory(aFile.data(), aFile.size(), &layout), S_OK);
+        EXPECT_EQ(layout.format, DXGI_FORMAT_R8G8B8A8_UNORM);
+    }
+
+    TEST(DDSParserTest, ReadsACubeMapArrayFromTheDX10Header)
+    {
+        std::vector<uint8_t> aFile = MakeCubeMapFile(2u, 0u);
+
+        DDS_TEXTURE_LAYOUT layout;
+        ASSERT_EQ(ValidateDDSTextureMemory(aFile.data(), aFile.size(), &layout), S_OK);
+        EXPECT_TRUE(layout.isCubeMap);
+        EXPECT_EQ(layout.arraySize, 12u);
+        EXPECT_EQ(layout.mipCount, 7u);
+        EXPECT_EQ(layout.format, DXGI_FORMAT_BC7_UNORM);
+    }
+
+    TEST(DDSParserTest, RejectsSubresourcesPastTheEndOfTheData)
+    {
+        std::vector<uint8_t> aFile = MakeCubeMapFile(1u, 0u);
+        aFile.pop_back();
+
+        DDS_TEXTURE_LAYOUT layout;
+        EXPECT_EQ(ValidateDDSTextureMemory(aFile.data(), aFile.size(), &layout), HRESULT_FROM_WIN32(ERROR_HANDLE_EOF));
+        EXPECT_EQ(layout.width, 0u);
+    }
+
+    TEST(DDSParserTest, RejectsABadMagicOrHeaderSize)
+    {
+        std::vector<uint8_t> aFile = MakeDDSFile(MakeFourCCHeader(MAKEFOURCC('D', 'X', 'T', '1'), 4u, 4u, 1u), nullptr, 8u);
+        ASSERT_EQ(ValidateDDSTextureMemory(aFile.data(), aFile.size()), S_OK);
+
+        std::vector<uint8_t> aBadMagic = aFile;
+        aBadMagic[0] = 'X';
+        EXPECT_EQ(ValidateDDSTextureMemory(aBadMagic.data(), aBadMagic.size()), E_FAIL);
+
+        std::vector<uint8_t> aBadHeaderSize = aFile;
+        ++aBadHeaderSize[sizeof(DDS_MAGIC)];
+        EXPECT_EQ(ValidateDDSTextureMemory(aBadHeaderSize.data(), aBadHeaderSize.size()), E_FAIL);
+
+        EXPECT_EQ(ValidateDDSTextureMemory(aFile.data(), sizeof(DDS_MAGIC) + sizeof(DDS_HEADER) - 1u), E_FAIL);
+        EXPECT_EQ(ValidateDDSTextureMemory(nullptr, 0u), E_INVALIDARG);
+    }
+
+    TEST(DDSParserTest, RejectsATruncatedDX10Header)
+    {
+        std::vector<uint8_t> aFile = MakeDDSFile(MakeDX10Header(4u, 4u, 1u), nullptr, sizeof(DDS_HEADER_DXT10) - 1u);
+        EXPECT_EQ(ValidateDDSTextureMemory(aFile.data(), aFile.size()), E_FAIL);
+    }
+
+    TEST(DDSParserTest, RejectsAnEmptyArray)
+    {
+        std::vector<uint8_t> aFile = MakeCubeMapFile(0u, 64u);
+        EXPECT_EQ(ValidateDDSTextureMemory(aFile.data(), aFile.size()), HRESULT_FROM_WIN32(ERROR_INVALID_DATA));
+    }
+
+    TEST(DDSParserTest, RejectsACubeCountThatWrapsAround)
+    {
+        // 0x80000000 * 6 faces is 0 in 32 bits
+        std::vector<uint8_t> aFile = MakeCubeMapFile(0x80000000u, 0u);
+        EXPECT_EQ(ValidateDDSTextureMemory(aFile.data(), aFile.size()), HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED));
+
+        std::vector<uint8_t> aTooManyCubes = MakeCubeMapFile(D3D11_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION / 6u + 1u, 0u);
+        EXPECT_EQ(ValidateDDSTextureMemory(aTooManyCubes.data(), aTooManyCubes.size()), HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED));
+    }
+
+    TEST(DDSParserTest, RejectsTexturesBeyondTheD3D11Limits)
+    {
+        std::vector<uint8_t> aTooManyMips = MakeDDSFile(MakeFourCCHeader(MAKEFOURCC('D', 'X', 'T', '1'), 4u, 4u, D3D11_REQ_MIP_LEVELS + 1u), nullptr, 4096u);
+        EXPECT_EQ(ValidateDDSTextureMemory(aTooManyMips.data(), aTooManyMips.size()), HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED));
+
+        std::vector<uint8_t> aTooWide = MakeDDSFile(MakeFourCCHeader(MAKEFOURCC('D', 'X', 'T', '1'), D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION + 1u, 4u, 1u), nullptr, 65536u);
+        EXPECT_EQ(ValidateDDSTextureMemory(aTooWide.data(), aTooWide.size()), HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED));
+    }
+
+    TEST(DDSParserTest, RejectsPaletteAndUnknownFormats)
+    {
+        DDS_HEADER_DXT10 extension = {};
+        extension.resourceDimension = D3D11_RESOURCE_DIMENSION_TEXTURE2D;
+        extension.arraySize = 1u;
+
+        extension.dxgiFormat = DXGI_FORMAT_P8;
+        std::vector<uint8_t> aPalette = MakeDDSFile(MakeDX10Header(4u, 4u, 1u), &extension, 64u);
+        EXPECT_EQ(ValidateDDSTextureMemory(aPalette.data(), aPalette.size()), HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED));
+
+        extension.dxgiFormat = static_cast<DXGI_FORMAT>(0x7fffffffu);
+        std::vector<uint8_t> aUnknown = MakeDDSFile(MakeDX10Header(4u, 4u, 1u), &extension, 64u);
+        EXPECT_EQ(ValidateDDSTextureMemory(aUnknown.data(), aUnknown.size()), HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED));
+    }
+
+    TEST(DDSParserTest, RequiresTheVolumeFlagForA3DTexture)
+    {
+        DDS_HEADER_DXT10 extension = {};
+        extension.dxgiFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
+        extension.resourceDimension = D3D11_RESOURCE_DIMENSION_TEXTURE3D;
+        extension.arraySize = 1u;
+
+        DDS_HEADER header = MakeDX10Header(8u, 8u, 1u);
+        header.depth = 8u;
+        std::vector<uint8_t> aFile = MakeDDSFile(header, &extension, 8u * 8u * 8u * 4u);
+        EXPECT_EQ(ValidateDDSTextureMemory(aFile.data(), aFile.size()), HRESULT_FROM_WIN32(ERROR_INVALID_DATA));
+
+        header.flags |= DDS_HEADER_FLAGS_VOLUME;
+        aFile = MakeDDSFile(header, &extension, 8u * 8u * 8u * 4u);
+        DDS_TEXTURE_LAYOUT layout;
+        ASSERT_EQ(ValidateDDSTextureMemory(aFile.data(), aFile.size(), &layout), S_OK);
+        EXPECT_EQ(layout.depth, 8u);
+    }
+
+    TEST(DDSParserTest, RoundsBlockCompressedSurfacesUpToWholeBlocks)
+    {
+        size_t uNumBytes = 0u;
+        size_t uRowBytes = 0u;
+        size_t uNumRows = 0u;
+        ASSERT_EQ(GetSurfaceInfo(5u, 1u, DXGI_FORMAT_BC1_UNORM, &uNumBytes, &uRowBytes, &uNumRows), S_OK);
+        EXPECT_EQ(uRowBytes, 16u);
+        EXPECT_EQ(uNumRows, 1u);
+        EXPECT_EQ(uNumBytes, 16u);
+
+        ASSERT_EQ(GetSurfaceInfo(3u, 3u, DXGI_FORMAT_R8G8B8A8_UNORM, &uNumBytes, &uRowBytes, &uNumRows), S_OK);
+        EXPECT_EQ(uNumBytes, 36u);
+
+        EXPECT_EQ(GetSurfaceInfo(4u, 4u, DXGI_FORMAT_UNKNOWN, &uNumBytes, nullptr, nullptr), E_INVALIDARG);
+    }
+
+    TEST(DDSParserTest, ReadsTheAlphaMode)
+    {
+        DDS_HEADER_DXT10 extension = {};
+        extension.dxgiFormat = DXGI_FORMAT_BC3_UNORM;
+        extension.resourceDimension = D3D11_RESOURCE_DIMENSION_TEXTURE2D;
+        extension.arraySize = 1u;
+        extension.miscFlags2 = DDS_ALPHA_MODE_PREMULTIPLIED;
+        std::vector<uint8_t> aFile = MakeDDSFile(MakeDX10Header(4u, 4u, 1u), &extension, 16u);
+
+        const DDS_HEADER* pHeader = nullptr;
+        const uint8_t* pBitData = nullptr;
+        size_t uBitSize = 0u;
+        ASSERT_EQ(LoadTextureDataFromMemory(aFile.data(), aFile.size(), &pHeader, &pBitData, &uBitSize), S_OK);
+        EXPECT_EQ(GetAlphaMode(pHeader), DDS_ALPHA_MODE_PREMULTIPLIED);
+        EXPECT_EQ(uBitSize, 16u);
+
+        std::vector<uint8_t> aDXT4 = MakeDDSFile(MakeFourCCHeader(MAKEFOURCC('D', 'X', 'T', '4'), 4u, 4u, 1u), nullptr, 16u);
+        ASSERT_EQ(LoadTextureDataFromMemory(aDXT4.data(), aDXT4.size(), &pHeader, &pBitData, &uBitSize), S_OK);
+        EXPECT_EQ(GetAlphaMode(pHeader), DDS_ALPHA_MODE_PREMULTIPLIED);
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "Texture/DDSParser.h"
+
+namespace DirectX
+{
+    // Header of a texture with a legacy four character code format
+    inline DDS_HEADER MakeFourCCHeader(uint32_t uFourCC, uint32_t uWidth, uint32_t uHeight, uint32_t uMipCount)
+    {
+        DDS_HEADER header = {};
+        header.size = sizeof(DDS_HEADER);
+        header.flags = DDS_HEIGHT;
+        header.width = uWidth;
+        header.height = uHeight;
+        header.mipMapCount = uMipCount;
+        header.ddspf.size = sizeof(DDS_PIXELFORMAT);
+        header.ddspf.flags = DDS_FOURCC;
+        header.ddspf.fourCC = uFourCC;
+        return header;
+    }
+
+    // Header followed by a DX10 extension
+    inline DDS_HEADER MakeDX10Header(uint32_t uWidth, uint32_t uHeight, uint32_t uMipCount)
+    {
+        return MakeFourCCHeader(MAKEFOURCC('D', 'X', '1', '0'), uWidth, uHeight, uMipCount);
+    }
+
+    // Bytes of every subresource of a texture, as they follow the headers
+    inline size_t GetTextureDataSize(DXGI_FORMAT format, uint32_t uWidth, uint32_t uHeight, uint32_t uDepth, uint32_t uMipCount, uint32_t uArraySize)
+    {
+        size_t uSize = 0u;
+        for (uint32_t j = 0u; j < uArraySize; ++j)
+        {
+            size_t w = uWidth;
+            size_t h = uHeight;
+            size_t d = uDepth;
+            for (uint32_t i = 0u; i < uMipCount; ++i)
+            {
+                size_t uNumBytes = 0u;
+                GetSurfaceInfo(w, h, format, &uNumBytes, nullptr, nullptr);
+                uSize += uNumBytes * d;
+                w = w > 1u ? w >> 1 : 1u;
+                h = h > 1u ? h >> 1 : 1u;
+                d = d > 1u ? d >> 1 : 1u;
+            }
+        }
+        return uSize;
+    }
+
+    // DDS file of the headers followed by uDataSize bytes of pixels
+    inline std::vector<uint8_t> MakeDDSFile(const DDS_HEADER& header, const DDS_HEADER_DXT10* pExtension, size_t uDataSize)
+    {
+        std::vector<uint8_t> aFile(sizeof(DDS_MAGIC) + sizeof(DDS_HEADER) + (pExtension ? sizeof(DDS_HEADER_DXT10) : 0u) + uDataSize, 0x5a);
+        uint8_t* pData = aFile.data();
+        memcpy(pData, &DDS_MAGIC, sizeof(DDS_MAGIC));
+        pData += sizeof(DDS_MAGIC);
+        memcpy(pData, &header, sizeof(header));
+        pData += sizeof(header);
+        if (pExtension)
+        {
+            memcpy(pData, pExtension, sizeof(*pExtension));
+        }
+        return aFile;
+    }
+}
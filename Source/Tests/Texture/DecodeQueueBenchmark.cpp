@@ -0,0 +1,113 @@
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Texture/DDSParser.h"
+#include "Texture/DDSTestFiles.h"
+#include "Texture/DecodeQueue.h"
+#include "Texture/MipGenerator.h"
+
+namespace library
+{
+    namespace
+    {
+        constexpr const uint32_t IMAGE_SIZE = 1024u;
+        constexpr const uint32_t NUM_IMAGES = 24u;
+        constexpr const uint32_t NUM_DDS_FILES = 8u;
+
+        // What Texture::Decode does once a file is mapped: a DDS file is only checked in
+        // place, any other image is decoded to RGBA, a copy here, and gets its mip chain
+        class LoadJob final : public DecodeJob
+        {
+        public:
+            LoadJob(const std::vector<uint8_t>* pFile, bool bIsDDS, eTextureContent textureContent)
+                : m_pFile(pFile)
+                , m_bIsDDS(bIsDDS)
+                , m_textureContent(textureContent)
+                , m_aMips()
+                , m_bSucceeded(false)
+            {
+            }
+
+            void Decode() override
+            {
+                if (m_bIsDDS)
+                {
+                    DirectX::DDS_TEXTURE_LAYOUT layout;
+                    m_bSucceeded = DirectX::ValidateDDSTextureMemory(m_pFile->data(), m_pFile->size(), &layout) == S_OK;
+                    return;
+                }
+
+                m_aMips.resize(1u);
+                m_aMips[0].resize(m_pFile->size());
+                memcpy(m_aMips[0].data(), m_pFile->data(), m_pFile->size());
+                MipGenerator::GenerateMips(m_textureContent, IMAGE_SIZE, IMAGE_SIZE, m_aMips);
+                m_bSucceeded = true;
+            }
+
+            const std::vector<uint8_t>* m_pFile;
+            bool m_bIsDDS;
+            eTextureContent m_textureContent;
+            std::vector<std::vector<uint8_t>> m_aMips;
+            bool m_bSucceeded;
+        };
+
+        std::vector<uint8_t> MakeImage()
+        {
+            std::mt19937 random(1024u);
+            std::vector<uint8_t> aImage(static_cast<size_t>(IMAGE_SIZE) * IMAGE_SIZE * 4u);
+            for (uint8_t& uTexel : aImage)
+            {
+                uTexel = static_cast<uint8_t>(random());
+            }
+            return aImage;
+        }
+    }
+
+    // A batch of model textures, from the first queued to the last finished on the draining thread,
+    // as TextureLoader loads them. Timed in real time since the work runs on the workers
+    void BM_LoadTextureBatch(benchmark::State& state)
+    {
+        const uint32_t uNumWorkers = static_cast<uint32_t>(state.range(0));
+        const std::vector<uint8_t> aImage = MakeImage();
+        const std::vector<uint8_t> aDDSFile = DirectX::MakeDDSFile(DirectX::MakeFourCCHeader(MAKEFOURCC('D', 'X', 'T', '1'), 2048u, 2048u, 12u), nullptr,
+                                                                   DirectX::GetTextureDataSize(DXGI_FORMAT_BC1_UNORM, 2048u, 2048u, 1u, 12u, 1u));
+        constexpr const eTextureContent CONTENTS[] = { eTextureContent::COLOR, eTextureContent::NORMAL, eTextureContent::DATA };
+
+        DecodeQueue decodeQueue(uNumWorkers);
+        std::vector<std::unique_ptr<DecodeJob>> aDecoded;
+        for (auto _ : state)
+        {
+            for (uint32_t i = 0u; i < NUM_IMAGES + NUM_DDS_FILES; ++i)
+            {
+                const bool bIsDDS = i >= NUM_IMAGES;
+                decodeQueue.Enqueue(std::make_unique<LoadJob>(bIsDDS ? &aDDSFile : &aImage, bIsDDS, CONTENTS[i % 3u]));
+            }
+
+            uint32_t uNumFailed = 0u;
+            while (decodeQueue.GetNumPending() > 0u)
+            {
+                decodeQueue.TakeDecoded(aDecoded);
+                for (const std::unique_ptr<DecodeJob>& job : aDecoded)
+                {
+                    uNumFailed += static_cast<const LoadJob&>(*job).m_bSucceeded ? 0u : 1u;
+                }
+                decodeQueue.Finish(static_cast<uint32_t>(aDecoded.size()));
+                std::this_thread::yield();
+            }
+
+            if (uNumFailed != 0u)
+            {
+                state.SkipWithError("A texture failed to load");
+                break;
+            }
+        }
+        state.counters["textures"] = benchmark::Counter(static_cast<double>(state.iterations() * (NUM_IMAGES + NUM_DDS_FILES)), benchmark::Counter::kIsRate);
+        state.counters["batch_ms"] = decodeQueue.GetLoadTime();
+    }
+    BENCHMARK(BM_LoadTextureBatch)->Arg(1)->Arg(2)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+}
@@ -0,0 +1,191 @@
+#include "Texture/DecodeQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace library
+{
+    namespace
+    {
+        // Counts the jobs decoding at once, each waiting for the others to start, up to a
+        // second, so every worker is busy at the same time even on a single core
+        struct Occupancy
+        {
+            std::atomic<uint32_t> uNumDecoding{ 0u };
+            std::atomic<uint32_t> uMaxDecoding{ 0u };
+            uint32_t uExpected = 0u;
+        };
+
+        class TestJob final : public DecodeJob
+        {
+        public:
+            TestJob(uint32_t uId, Occupancy* pOccupancy)
+                : m_uId(uId)
+                , m_uNumDecodes(0u)
+                , m_pOccupancy(pOccupancy)
+            {
+            }
+
+            void Decode() override
+            {
+                ++m_uNumDecodes;
+                if (m_pOccupancy == nullptr)
+                {
+                    return;
+                }
+
+                const uint32_t uNumDecoding = ++m_pOccupancy->uNumDecoding;
+                uint32_t uMax = m_pOccupancy->uMaxDecoding.load();
+                while (uNumDecoding > uMax && !m_pOccupancy->uMaxDecoding.compare_exchange_weak(uMax, uNumDecoding))
+                {
+                }
+
+                const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+                while (m_pOccupancy->uMaxDecoding.load() < m_pOccupancy->uExpected && std::chrono::steady_clock::now() < deadline)
+                {
+                    std::this_thread::yield();
+                }
+
+                --m_pOccupancy->uNumDecoding;
+            }
+
+            uint32_t m_uId;
+            uint32_t m_uNumDecodes;
+            Occupancy* m_pOccupancy;
+        };
+
+        // Takes and finishes decoded jobs until none is pending
+        std::vector<std::unique_ptr<DecodeJob>> Drain(DecodeQueue& decodeQueue)
+        {
+            std::vector<std::unique_ptr<DecodeJob>> aFinished;
+            std::vector<std::unique_ptr<DecodeJob>> aDecoded;
+            while (decodeQueue.GetNumPending() > 0u)
+            {
+                decodeQueue.TakeDecoded(aDecoded);
+                decodeQueue.Finish(static_cast<uint32_t>(aDecoded.size()));
+                for (std::unique_ptr<DecodeJob>& job : aDecoded)
+                {
+                    aFinished.push_back(std::move(job));
+                }
+                std::this_thread::yield();
+            }
+            return aFinished;
+        }
+    }
+
+    TEST(DecodeQueueTest, StartsTheWorkersWithTheFirstJob)
+    {
+        DecodeQueue decodeQueue(3u);
+        EXPECT_EQ(decodeQueue.GetNumWorkers(), 0u);
+
+        ASSERT_TRUE(decodeQueue.Enqueue(std::make_unique<TestJob>(0u, nullptr)));
+        EXPECT_EQ(decodeQueue.GetNumWorkers(), 3u);
+
+        Drain(decodeQueue);
+        decodeQueue.Stop();
+        EXPECT_EQ(decodeQueue.GetNumWorkers(), 0u);
+    }
+
+    TEST(DecodeQueueTest, HandsBackEveryJobDecodedOnce)
+    {
+        constexpr const uint32_t NUM_JOBS = 1000u;
+        DecodeQueue decodeQueue(4u);
+
+        for (uint32_t i = 0u; i < NUM_JOBS; ++i)
+        {
+            ASSERT_TRUE(decodeQueue.Enqueue(std::make_unique<TestJob>(i, nullptr)));
+        }
+        std::vector<std::unique_ptr<DecodeJob>> aFinished = Drain(decodeQueue);
+
+        ASSERT_EQ(aFinished.size(), NUM_JOBS);
+        std::vector<uint32_t> auSeen(NUM_JOBS, 0u);
+        for (const std::unique_ptr<DecodeJob>& job : aFinished)
+        {
+            const TestJob& testJob = static_cast<const TestJob&>(*job);
+            EXPECT_EQ(testJob.m_uNumDecodes, 1u);
+            ++auSeen[testJob.m_uId];
+        }
+        EXPECT_EQ(auSeen, std::vector<uint32_t>(NUM_JOBS, 1u));
+    }
+
+    TEST(DecodeQueueTest, DecodesNoMoreJobsAtOnceThanItHasWorkers)
+    {
+        for (const uint32_t uNumWorkers : { 1u, 2u, 4u })
+        {
+            Occupancy occupancy;
+            occupancy.uExpected = uNumWorkers;
+            DecodeQueue decodeQueue(uNumWorkers);
+
+            for (uint32_t i = 0u; i < uNumWorkers * 4u; ++i)
+            {
+                ASSERT_TRUE(decodeQueue.Enqueue(std::make_unique<TestJob>(i, &occupancy)));
+            }
+            Drain(decodeQueue);
+
+            EXPECT_EQ(occupancy.uMaxDecoding.load(), uNumWorkers);
+        }
+    }
+
+    // Decoded jobs stay pending until the draining thread finishes them, and the batch ends with the last
+    TEST(DecodeQueueTest, EndsTheBatchWhenTheLastJobIsFinished)
+    {
+        DecodeQueue decodeQueue(2u);
+        for (uint32_t i = 0u; i < 8u; ++i)
+        {
+            ASSERT_TRUE(decodeQueue.Enqueue(std::make_unique<TestJob>(i, nullptr)));
+        }
+        EXPECT_EQ(decodeQueue.GetNumPending(), 8u);
+
+        std::vector<std::unique_ptr<DecodeJob>> aTaken;
+        std::vector<std::unique_ptr<DecodeJob>> aDecoded;
+        while (aTaken.size() < 8u)
+        {
+            decodeQueue.TakeDecoded(aDecoded);
+            for (std::unique_ptr<DecodeJob>& job : aDecoded)
+            {
+                aTaken.push_back(std::move(job));
+            }
+            std::this_thread::yield();
+        }
+        EXPECT_EQ(decodeQueue.GetNumPending(), 8u);
+        EXPECT_EQ(decodeQueue.GetLoadTime(), 0.0f);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        EXPECT_FALSE(decodeQueue.Finish(0u));
+        EXPECT_FALSE(decodeQueue.Finish(5u));
+        EXPECT_EQ(decodeQueue.GetNumPending(), 3u);
+        EXPECT_TRUE(decodeQueue.Finish(3u));
+        EXPECT_EQ(decodeQueue.GetNumPending(), 0u);
+        EXPECT_GE(decodeQueue.GetLoadTime(), 5.0f);
+
+        // A job queued with nothing pending times a new batch
+        ASSERT_TRUE(decodeQueue.Enqueue(std::make_unique<TestJob>(8u, nullptr)));
+        Drain(decodeQueue);
+        EXPECT_LT(decodeQueue.GetLoadTime(), 5.0f);
+    }
+
+    TEST(DecodeQueueTest, DropsTheQueuedJobsWhenStopped)
+    {
+        Occupancy occupancy;
+        occupancy.uExpected = 2u;
+        DecodeQueue decodeQueue(1u);
+
+        // The only worker holds the first job for a second, so the others are still queued
+        ASSERT_TRUE(decodeQueue.Enqueue(std::make_unique<TestJob>(0u, &occupancy)));
+        for (uint32_t i = 1u; i < 10u; ++i)
+        {
+            ASSERT_TRUE(decodeQueue.Enqueue(std::make_unique<TestJob>(i, nullptr)));
+        }
+        decodeQueue.Stop();
+
+        EXPECT_FALSE(decodeQueue.Enqueue(std::make_unique<TestJob>(10u, nullptr)));
+        std::vector<std::unique_ptr<DecodeJob>> aDecoded;
+        decodeQueue.TakeDecoded(aDecoded);
+        EXPECT_LT(aDecoded.size(), 10u);
+        EXPECT_EQ(decodeQueue.GetNumWorkers(), 0u);
+    }
+}
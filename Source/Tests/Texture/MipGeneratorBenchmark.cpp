@@ -0,0 +1,75 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Texture/MipGenerator.h"
+#include "Texture/MipReference.h"
+
+namespace library
+{
+    namespace
+    {
+        constexpr const uint32_t IMAGE_SIZE = 4096u;
+
+        std::vector<std::vector<uint8_t>> MakeTopMip()
+        {
+            std::mt19937 random(4096u);
+            std::vector<std::vector<uint8_t>> aMips(1u);
+            aMips[0].resize(static_cast<size_t>(IMAGE_SIZE) * IMAGE_SIZE * 4u);
+            for (uint8_t& uTexel : aMips[0])
+            {
+                uTexel = static_cast<uint8_t>(random());
+            }
+            return aMips;
+        }
+
+        // Bytes read to build the mips below the top one
+        int64_t GetChainBytes()
+        {
+            int64_t iBytes = 0;
+            for (uint32_t uSize = IMAGE_SIZE; uSize > 1u; uSize /= 2u)
+            {
+                iBytes += static_cast<int64_t>(uSize) * uSize * 4;
+            }
+            return iBytes;
+        }
+    }
+
+    // The whole mip chain of a 4096 x 4096 image, as Texture::Decode builds it
+    void BM_GenerateMips4K(benchmark::State& state)
+    {
+        const eTextureContent textureContent = static_cast<eTextureContent>(state.range(0));
+        std::vector<std::vector<uint8_t>> aMips = MakeTopMip();
+
+        for (auto _ : state)
+        {
+            MipGenerator::GenerateMips(textureContent, IMAGE_SIZE, IMAGE_SIZE, aMips);
+            benchmark::DoNotOptimize(aMips.back().data());
+        }
+        state.SetBytesProcessed(state.iterations() * GetChainBytes());
+    }
+    BENCHMARK(BM_GenerateMips4K)->Arg(static_cast<int64_t>(eTextureContent::COLOR))->Arg(static_cast<int64_t>(eTextureContent::NORMAL))->Arg(static_cast<int64_t>(eTextureContent::DATA))->Unit(benchmark::kMillisecond);
+
+    // The same chain through the scalar reference, the baseline of the kernels
+    void BM_GenerateMips4KScalarReference(benchmark::State& state)
+    {
+        const eTextureContent textureContent = static_cast<eTextureContent>(state.range(0));
+        std::vector<std::vector<uint8_t>> aMips = MakeTopMip();
+
+        for (auto _ : state)
+        {
+            uint32_t uMip = 1u;
+            for (uint32_t uSize = IMAGE_SIZE; uSize > 1u; uSize /= 2u, ++uMip)
+            {
+                aMips.resize((std::max)(static_cast<size_t>(uMip + 1u), aMips.size()));
+                aMips[uMip].resize(static_cast<size_t>(uSize / 2u) * (uSize / 2u) * 4u);
+                DownsampleReference(textureContent, aMips[uMip - 1u].data(), uSize, uSize, aMips[uMip].data());
+            }
+            benchmark::DoNotOptimize(aMips.back().data());
+        }
+        state.SetBytesProcessed(state.iterations() * GetChainBytes());
+    }
+    BENCHMARK(BM_GenerateMips4KScalarReference)->Arg(static_cast<int64_t>(eTextureContent::COLOR))->Arg(static_cast<int64_t>(eTextureContent::DATA))->Unit(benchmark::kMillisecond);
+}
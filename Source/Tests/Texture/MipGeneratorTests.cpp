@@ -0,0 +1,178 @@
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Texture/MipGenerator.h"
+#include "Texture/MipReference.h"
+
+namespace library
+{
+    namespace
+    {
+        std::vector<uint8_t> MakeNoise(uint32_t uWidth, uint32_t uHeight, uint32_t uSeed)
+        {
+            std::mt19937 random(uSeed);
+            std::vector<uint8_t> aTexels(static_cast<size_t>(uWidth) * uHeight * 4u);
+            for (uint8_t& uTexel : aTexels)
+            {
+                uTexel = static_cast<uint8_t>(random());
+            }
+            return aTexels;
+        }
+
+        // Largest difference of a channel from the reference, alpha apart
+        void CompareWithReference(eTextureContent textureContent, const std::vector<uint8_t>& aSource, uint32_t uWidth, uint32_t uHeight, const std::vector<uint8_t>& aMip, int& iColorError, int& iAlphaError)
+        {
+            std::vector<uint8_t> aReference(aMip.size());
+            DownsampleReference(textureContent, aSource.data(), uWidth, uHeight, aReference.data());
+
+            iColorError = 0;
+            iAlphaError = 0;
+            for (size_t i = 0u; i < aMip.size(); ++i)
+            {
+                int& iError = i % 4u == 3u ? iAlphaError : iColorError;
+                iError = (std::max)(iError, std::abs(static_cast<int>(aMip[i]) - static_cast<int>(aReference[i])));
+            }
+        }
+
+        struct MipSize
+        {
+            uint32_t uWidth;
+            uint32_t uHeight;
+        };
+
+        // Odd sides, single texel sides, and rows long enough for every SIMD loop and its tail
+        constexpr const MipSize MIP_SIZES[] =
+        {
+            { 1u, 1u }, { 2u, 2u }, { 1u, 7u }, { 7u, 1u }, { 3u, 5u }, { 17u, 9u }, { 33u, 4u }, { 64u, 33u }, { 130u, 2u },
+        };
+    }
+
+    TEST(MipGeneratorTest, CountsMipsDownToATexel)
+    {
+        EXPECT_EQ(MipGenerator::GetNumMips(1u, 1u), 1u);
+        EXPECT_EQ(MipGenerator::GetNumMips(2u, 1u), 2u);
+        EXPECT_EQ(MipGenerator::GetNumMips(5u, 3u), 3u);
+        EXPECT_EQ(MipGenerator::GetNumMips(1u, 8u), 4u);
+        EXPECT_EQ(MipGenerator::GetNumMips(4096u, 4096u), 13u);
+        EXPECT_EQ(MipGenerator::GetNumMips(4096u, 16u), 13u);
+    }
+
+    TEST(MipGeneratorTest, DataMatchesTheScalarReferenceExactly)
+    {
+        for (const MipSize& size : MIP_SIZES)
+        {
+            std::vector<uint8_t> aSource = MakeNoise(size.uWidth, size.uHeight, size.uWidth * 131u + size.uHeight);
+            std::vector<uint8_t> aMip(static_cast<size_t>((std::max)(size.uWidth / 2u, 1u)) * (std::max)(size.uHeight / 2u, 1u) * 4u);
+            MipGenerator::Downsample(eTextureContent::DATA, aSource.data(), size.uWidth, size.uHeight, aMip.data());
+
+            int iColorError = 0;
+            int iAlphaError = 0;
+            CompareWithReference(eTextureContent::DATA, aSource, size.uWidth, size.uHeight, aMip, iColorError, iAlphaError);
+            EXPECT_EQ(iColorError, 0) << size.uWidth << "x" << size.uHeight;
+            EXPECT_EQ(iAlphaError, 0) << size.uWidth << "x" << size.uHeight;
+        }
+    }
+
+    TEST(MipGeneratorTest, ColorIsWithinALevelOfTheScalarReference)
+    {
+        for (const MipSize& size : MIP_SIZES)
+        {
+            std::vector<uint8_t> aSource = MakeNoise(size.uWidth, size.uHeight, size.uWidth * 137u + size.uHeight);
+            std::vector<uint8_t> aMip(static_cast<size_t>((std::max)(size.uWidth / 2u, 1u)) * (std::max)(size.uHeight / 2u, 1u) * 4u);
+            MipGenerator::Downsample(eTextureContent::COLOR, aSource.data(), size.uWidth, size.uHeight, aMip.data());
+
+            int iColorError = 0;
+            int iAlphaError = 0;
+            CompareWithReference(eTextureContent::COLOR, aSource, size.uWidth, size.uHeight, aMip, iColorError, iAlphaError);
+            EXPECT_LE(iColorError, 1) << size.uWidth << "x" << size.uHeight;
+            EXPECT_LE(iAlphaError, 1) << size.uWidth << "x" << size.uHeight;
+        }
+    }
+
+    TEST(MipGeneratorTest, NormalsAreWithinALevelOfTheScalarReference)
+    {
+        for (const MipSize& size : MIP_SIZES)
+        {
+            std::vector<uint8_t> aSource = MakeNoise(size.uWidth, size.uHeight, size.uWidth * 139u + size.uHeight);
+            std::vector<uint8_t> aMip(static_cast<size_t>((std::max)(size.uWidth / 2u, 1u)) * (std::max)(size.uHeight / 2u, 1u) * 4u);
+            MipGenerator::Downsample(eTextureContent::NORMAL, aSource.data(), size.uWidth, size.uHeight, aMip.data());
+
+            int iColorError = 0;
+            int iAlphaError = 0;
+            CompareWithReference(eTextureContent::NORMAL, aSource, size.uWidth, size.uHeight, aMip, iColorError, iAlphaError);
+            EXPECT_LE(iColorError, 1) << size.uWidth << "x" << size.uHeight;
+            EXPECT_LE(iAlphaError, 1) << size.uWidth << "x" << size.uHeight;
+        }
+    }
+
+    TEST(MipGeneratorTest, OppositeNormalsPointStraightOut)
+    {
+        // Bytes 128 and 127 expand to +-1 / 255, so each pair cancels out
+        const uint8_t aSource[] =
+        {
+            255u, 128u, 128u, 255u, 0u, 127u, 127u, 255u,
+            0u, 127u, 127u, 255u, 255u, 128u, 128u, 255u,
+        };
+        uint8_t aMip[4] = {};
+        MipGenerator::Downsample(eTextureContent::NORMAL, aSource, 2u, 2u, aMip);
+
+        EXPECT_EQ(aMip[0], 128u);
+        EXPECT_EQ(aMip[1], 128u);
+        EXPECT_EQ(aMip[2], 255u);
+        EXPECT_EQ(aMip[3], 255u);
+    }
+
+    TEST(MipGeneratorTest, GeneratesEveryMipOfTheChain)
+    {
+        const uint32_t uWidth = 37u;
+        const uint32_t uHeight = 20u;
+
+        std::vector<std::vector<uint8_t>> aMips(1u);
+        aMips[0] = MakeNoise(uWidth, uHeight, 7u);
+        MipGenerator::GenerateMips(eTextureContent::COLOR, uWidth, uHeight, aMips);
+
+        ASSERT_EQ(aMips.size(), MipGenerator::GetNumMips(uWidth, uHeight));
+        for (size_t uMip = 1u; uMip < aMips.size(); ++uMip)
+        {
+            const uint32_t uMipWidth = (std::max)(uWidth >> (uMip - 1u), 1u);
+            const uint32_t uMipHeight = (std::max)(uHeight >> (uMip - 1u), 1u);
+            ASSERT_EQ(aMips[uMip].size(), static_cast<size_t>((std::max)(uMipWidth / 2u, 1u)) * (std::max)(uMipHeight / 2u, 1u) * 4u);
+
+            int iColorError = 0;
+            int iAlphaError = 0;
+            CompareWithReference(eTextureContent::COLOR, aMips[uMip - 1u], uMipWidth, uMipHeight, aMips[uMip], iColorError, iAlphaError);
+            EXPECT_LE(iColorError, 1) << "mip " << uMip;
+            EXPECT_LE(iAlphaError, 1) << "mip " << uMip;
+        }
+        EXPECT_EQ(aMips.back().size(), 4u);
+    }
+
+    TEST(MipGeneratorTest, KeepsAFlatImageFlat)
+    {
+        for (eTextureContent textureContent : { eTextureContent::COLOR, eTextureContent::DATA })
+        {
+            std::vector<uint8_t> aSource(16u * 16u * 4u);
+            for (size_t i = 0u; i < aSource.size(); i += 4u)
+            {
+                aSource[i + 0u] = 200u;
+                aSource[i + 1u] = 100u;
+                aSource[i + 2u] = 50u;
+                aSource[i + 3u] = 128u;
+            }
+
+            std::vector<uint8_t> aMip(8u * 8u * 4u);
+            MipGenerator::Downsample(textureContent, aSource.data(), 16u, 16u, aMip.data());
+            for (size_t i = 0u; i < aMip.size(); i += 4u)
+            {
+                ASSERT_EQ(aMip[i + 0u], 200u);
+                ASSERT_EQ(aMip[i + 1u], 100u);
+                ASSERT_EQ(aMip[i + 2u], 50u);
+                ASSERT_EQ(aMip[i + 3u], 128u);
+            }
+        }
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "Texture/TextureContent.h"
+
+namespace library
+{
+    // Scalar reference of MipGenerator::Downsample, straight from the formulas in double precision
+    inline void DownsampleReference(eTextureContent textureContent, const uint8_t* pSource, uint32_t uWidth, uint32_t uHeight, uint8_t* pDestination)
+    {
+        auto decode = [](uint8_t uValue)
+        {
+            const double value = uValue / 255.0;
+            return value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+        };
+        auto encode = [](double value)
+        {
+            const double srgb = value <= 0.0031308 ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055;
+            return static_cast<uint8_t>(std::clamp(std::floor(srgb * 255.0 + 0.5), 0.0, 255.0));
+        };
+        auto round = [](double value)
+        {
+            return static_cast<uint8_t>(std::clamp(std::floor(value + 0.5), 0.0, 255.0));
+        };
+
+        const uint32_t uNextWidth = (std::max)(uWidth / 2u, 1u);
+        const uint32_t uNextHeight = (std::max)(uHeight / 2u, 1u);
+
+        for (uint32_t y = 0u; y < uNextHeight; ++y)
+        {
+            for (uint32_t x = 0u; x < uNextWidth; ++x)
+            {
+                const uint8_t* apTexels[4];
+                for (uint32_t i = 0u; i < 4u; ++i)
+                {
+                    const uint32_t uX = (std::min)(x * 2u + (i & 1u), uWidth - 1u);
+                    const uint32_t uY = (std::min)(y * 2u + (i >> 1), uHeight - 1u);
+                    apTexels[i] = pSource + (static_cast<size_t>(uY) * uWidth + uX) * 4u;
+                }
+
+                uint8_t* pTexel = pDestination + (static_cast<size_t>(y) * uNextWidth + x) * 4u;
+                const double alpha = (apTexels[0][3] + apTexels[1][3] + apTexels[2][3] + apTexels[3][3]) / 4.0;
+
+                switch (textureContent)
+                {
+                case eTextureContent::COLOR:
+                    for (uint32_t c = 0u; c < 3u; ++c)
+                    {
+                        pTexel[c] = encode((decode(apTexels[0][c]) + decode(apTexels[1][c]) + decode(apTexels[2][c]) + decode(apTexels[3][c])) / 4.0);
+                    }
+                    pTexel[3] = round(alpha);
+                    break;
+
+                case eTextureContent::NORMAL:
+                {
+                    double aNormal[3] = {};
+                    for (uint32_t c = 0u; c < 3u; ++c)
+                    {
+                        for (uint32_t i = 0u; i < 4u; ++i)
+                        {
+                            aNormal[c] += apTexels[i][c] * (2.0 / 255.0) - 1.0;
+                        }
+                    }
+
+                    const double length = std::sqrt(aNormal[0] * aNormal[0] + aNormal[1] * aNormal[1] + aNormal[2] * aNormal[2]);
+                    for (uint32_t c = 0u; c < 3u; ++c)
+                    {
+                        const double value = length > 1e-6 ? aNormal[c] / length : (c == 2u ? 1.0 : 0.0);
+                        pTexel[c] = round(value * 127.5 + 127.5);
+                    }
+                    pTexel[3] = round(alpha);
+                    break;
+                }
+
+                default:
+                    for (uint32_t c = 0u; c < 4u; ++c)
+                    {
+                        pTexel[c] = static_cast<uint8_t>((apTexels[0][c] + apTexels[1][c] + apTexels[2][c] + apTexels[3][c] + 2u) / 4u);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+}
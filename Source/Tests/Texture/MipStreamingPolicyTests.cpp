@@ -0,0 +1,316 @@
+#include "Texture/MipStreamingPolicy.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace library
+{
+    namespace
+    {
+        // Texture::STREAMING_FALLBACK_SIZE, the constant lives with the D3D texture
+        constexpr const uint32_t FALLBACK_SIZE = 64u;
+
+        // RGBA8 texture whose mips are changed in place, like Texture::SetResidentMip does
+        class FakeMipChain final : public IMipChain
+        {
+        public:
+            FakeMipChain(std::string name, uint32_t uWidth, uint32_t uHeight)
+                : m_name(std::move(name))
+                , m_uWidth(uWidth)
+                , m_uHeight(uHeight)
+                , m_uNumMips(1u)
+                , m_uFallbackMip(0u)
+                , m_uResidentMip(0u)
+            {
+                while ((std::max)(m_uWidth, m_uHeight) >> m_uNumMips)
+                {
+                    ++m_uNumMips;
+                }
+                while ((std::max)(m_uWidth, m_uHeight) >> m_uFallbackMip > FALLBACK_SIZE)
+                {
+                    ++m_uFallbackMip;
+                }
+                m_uResidentMip = m_uFallbackMip;
+            }
+
+            uint32_t GetWidth() const override { return m_uWidth; }
+            uint32_t GetHeight() const override { return m_uHeight; }
+            uint32_t GetNumMips() const override { return m_uNumMips; }
+            uint32_t GetResidentMip() const override { return m_uResidentMip; }
+            uint32_t GetFallbackMip() const override { return m_uFallbackMip; }
+
+            uint64_t GetMipChainSize(uint32_t uFirstMip) const override
+            {
+                uint64_t uSize = 0ull;
+                for (uint32_t uMip = (std::min)(uFirstMip, m_uNumMips - 1u); uMip < m_uNumMips; ++uMip)
+                {
+                    uSize += 4ull * (std::max)(m_uWidth >> uMip, 1u) * (std::max)(m_uHeight >> uMip, 1u);
+                }
+
+                return uSize;
+            }
+
+            const std::string& GetName() const { return m_name; }
+            void SetResidentMip(uint32_t uMip) { m_uResidentMip = uMip; }
+
+        private:
+            std::string m_name;
+            uint32_t m_uWidth;
+            uint32_t m_uHeight;
+            uint32_t m_uNumMips;
+            uint32_t m_uFallbackMip;
+            uint32_t m_uResidentMip;
+        };
+
+        // Records the textures created again, in order, and fails them on demand
+        struct MipSetter
+        {
+            std::vector<std::pair<std::string, uint32_t>> aCalls;
+            bool bFail = false;
+
+            MipStreamingPolicy::SetResidentMipFunction Get()
+            {
+                return [this](IMipChain& mipChain, uint32_t uMip)
+                {
+                    FakeMipChain& fake = static_cast<FakeMipChain&>(mipChain);
+                    aCalls.emplace_back(fake.GetName(), uMip);
+                    if (bFail)
+                    {
+                        return false;
+                    }
+
+                    fake.SetResidentMip(uMip);
+                    return true;
+                };
+            }
+        };
+
+        std::shared_ptr<FakeMipChain> MakeTexture(const std::string& name, uint32_t uSize = 1024u)
+        {
+            return std::make_shared<FakeMipChain>(name, uSize, uSize);
+        }
+
+        // Texture coordinates spanned by a pixel for a texture of the given size to be sampled from the given mip
+        float UvPerPixelForMip(uint32_t uSize, uint32_t uMip)
+        {
+            return static_cast<float>(1u << uMip) / static_cast<float>(uSize);
+        }
+    }
+
+    TEST(MipStreamingPolicyTest, ComputesTheMipFromTheTexelsPerPixel)
+    {
+        const FakeMipChain texture("wood", 1024u, 512u);
+        ASSERT_EQ(texture.GetNumMips(), 11u);
+
+        EXPECT_EQ(MipStreamingPolicy::ComputeMip(texture, 1.0f / 1024.0f), 0u);
+        EXPECT_EQ(MipStreamingPolicy::ComputeMip(texture, 1.0f / 2048.0f), 0u);
+        EXPECT_EQ(MipStreamingPolicy::ComputeMip(texture, 3.0f / 1024.0f), 1u);
+        EXPECT_EQ(MipStreamingPolicy::ComputeMip(texture, 4.0f / 1024.0f), 2u);
+        EXPECT_EQ(MipStreamingPolicy::ComputeMip(texture, 100.0f), 10u);
+        EXPECT_EQ(MipStreamingPolicy::ComputeMip(texture, 0.0f), 0u);
+
+        const FakeMipChain square("bark", 256u, 256u);
+        EXPECT_EQ(MipStreamingPolicy::ComputeMip(square, UvPerPixelForMip(256u, 3u)), 3u);
+    }
+
+    // The finest request of the frame wins, the next frame starts over
+    TEST(MipStreamingPolicyTest, StreamsInTheFinestMipRequestedInTheFrame)
+    {
+        MipStreamingPolicy policy;
+        MipSetter setter;
+        std::shared_ptr<FakeMipChain> texture = MakeTexture("wood");
+        ASSERT_EQ(texture->GetResidentMip(), 4u);
+
+        policy.Request(texture, UvPerPixelForMip(1024u, 3u));
+        policy.Request(texture, UvPerPixelForMip(1024u, 1u));
+        policy.Request(texture, UvPerPixelForMip(1024u, 2u));
+        EXPECT_EQ(policy.Update(setter.Get()), 1u);
+        EXPECT_EQ(texture->GetResidentMip(), 1u);
+        EXPECT_EQ(policy.GetStats().uNumStreamedIn, 1u);
+        EXPECT_EQ(policy.GetStats().uResidentBytes, texture->GetMipChainSize(1u));
+
+        // Drawn coarser, a texture keeps its mips while they fit
+        policy.Request(texture, UvPerPixelForMip(1024u, 3u));
+        EXPECT_EQ(policy.Update(setter.Get()), 0u);
+        EXPECT_EQ(texture->GetResidentMip(), 1u);
+        EXPECT_EQ(policy.GetStats().uRequestedBytes, texture->GetMipChainSize(3u));
+        EXPECT_EQ(setter.aCalls.size(), 1u);
+    }
+
+    // At most MAX_STREAM_INS_PER_UPDATE textures are created again, those missing the most mips first
+    TEST(MipStreamingPolicyTest, CapsTheStreamInsPerUpdate)
+    {
+        ASSERT_EQ(MipStreamingPolicy::MAX_STREAM_INS_PER_UPDATE, 4u);
+
+        MipStreamingPolicy policy;
+        MipSetter setter;
+        const std::vector<std::pair<std::string, uint32_t>> aRequests = { { "a", 3u }, { "b", 0u }, { "c", 2u }, { "d", 3u }, { "e", 1u }, { "f", 0u } };
+        std::vector<std::shared_ptr<FakeMipChain>> aTextures;
+        for (const auto& [name, uMip] : aRequests)
+        {
+            aTextures.push_back(MakeTexture(name));
+            policy.Request(aTextures.back(), UvPerPixelForMip(1024u, uMip));
+        }
+
+        EXPECT_EQ(policy.Update(setter.Get()), 4u);
+        ASSERT_EQ(setter.aCalls.size(), 4u);
+        EXPECT_EQ(setter.aCalls[0].second, 0u);
+        EXPECT_EQ(setter.aCalls[1].second, 0u);
+        EXPECT_EQ(setter.aCalls[2], std::make_pair(std::string("e"), 1u));
+        EXPECT_EQ(setter.aCalls[3], std::make_pair(std::string("c"), 2u));
+        EXPECT_EQ(aTextures[0]->GetResidentMip(), 4u);
+        EXPECT_EQ(aTextures[3]->GetResidentMip(), 4u);
+        EXPECT_EQ(policy.GetStats().uNumPending, 2u);
+
+        // The textures left over are streamed in by the next updates they are still drawn in
+        for (uint32_t i = 0u; i < aTextures.size(); ++i)
+        {
+            policy.Request(aTextures[i], UvPerPixelForMip(1024u, aRequests[i].second));
+        }
+        EXPECT_EQ(policy.Update(setter.Get()), 2u);
+        EXPECT_EQ(aTextures[0]->GetResidentMip(), 3u);
+        EXPECT_EQ(aTextures[3]->GetResidentMip(), 3u);
+        EXPECT_EQ(policy.GetStats().uNumPending, 0u);
+        EXPECT_EQ(policy.GetStats().uNumStreamedIn, 6u);
+    }
+
+    // Making room evicts the texture drawn the least recently, down to its fallback, and leaves the others
+    TEST(MipStreamingPolicyTest, EvictsTheLeastRecentlyDrawnFirst)
+    {
+        MipStreamingPolicy policy;
+        MipSetter setter;
+        std::shared_ptr<FakeMipChain> a = MakeTexture("a");
+        std::shared_ptr<FakeMipChain> b = MakeTexture("b");
+        std::shared_ptr<FakeMipChain> c = MakeTexture("c");
+        const uint64_t uFullSize = a->GetMipChainSize(0u);
+        const uint64_t uFallbackSize = a->GetMipChainSize(a->GetFallbackMip());
+        policy.SetBudget(2ull * uFullSize + uFallbackSize);
+
+        for (const std::shared_ptr<FakeMipChain>& texture : { a, b, c })
+        {
+            policy.Request(texture, UvPerPixelForMip(1024u, 0u));
+            policy.Update(setter.Get());
+        }
+
+        EXPECT_EQ(a->GetResidentMip(), a->GetFallbackMip());
+        EXPECT_EQ(b->GetResidentMip(), 0u);
+        EXPECT_EQ(c->GetResidentMip(), 0u);
+        EXPECT_EQ(policy.GetStats().uNumEvicted, 1u);
+        EXPECT_EQ(policy.GetStats().uResidentBytes, policy.GetBudget());
+    }
+
+    // Among the textures drawn as recently, those requesting the coarsest mips lose theirs first, a mip at a time
+    TEST(MipStreamingPolicyTest, EvictsTheCoarsestRequestsFirstAmongTheSameFrame)
+    {
+        MipStreamingPolicy policy;
+        MipSetter setter;
+        std::shared_ptr<FakeMipChain> a = MakeTexture("a");
+        std::shared_ptr<FakeMipChain> b = MakeTexture("b");
+        std::shared_ptr<FakeMipChain> c = MakeTexture("c", 256u);
+        policy.SetBudget(a->GetMipChainSize(0u) + b->GetMipChainSize(1u) + c->GetMipChainSize(c->GetFallbackMip()));
+
+        policy.Request(a, UvPerPixelForMip(1024u, 0u));
+        policy.Request(b, UvPerPixelForMip(1024u, 1u));
+        policy.Update(setter.Get());
+        ASSERT_EQ(a->GetResidentMip(), 0u);
+        ASSERT_EQ(b->GetResidentMip(), 1u);
+
+        policy.Request(c, UvPerPixelForMip(256u, 0u));
+        policy.Update(setter.Get());
+
+        EXPECT_EQ(a->GetResidentMip(), 0u);
+        EXPECT_EQ(b->GetResidentMip(), 2u);
+        EXPECT_EQ(c->GetResidentMip(), 0u);
+        EXPECT_LE(policy.GetStats().uResidentBytes, policy.GetBudget());
+    }
+
+    // A texture that does not fit even once the others are at their fallback gets the finest mip that does
+    TEST(MipStreamingPolicyTest, StreamsInTheFinestMipWithinTheBudget)
+    {
+        MipStreamingPolicy policy;
+        MipSetter setter;
+        std::shared_ptr<FakeMipChain> texture = MakeTexture("wood");
+        policy.SetBudget(texture->GetMipChainSize(2u) + 1ull);
+
+        policy.Request(texture, UvPerPixelForMip(1024u, 0u));
+        EXPECT_EQ(policy.Update(setter.Get()), 1u);
+        EXPECT_EQ(texture->GetResidentMip(), 2u);
+        EXPECT_EQ(policy.GetStats().uRequestedBytes, texture->GetMipChainSize(0u));
+    }
+
+    // Lowering the budget below what the frame draws evicts mips the frame requested, but never the fallback
+    TEST(MipStreamingPolicyTest, EvictsRequestedMipsWhenTheBudgetIsExceeded)
+    {
+        ASSERT_EQ(MipStreamingPolicy::DEFAULT_BUDGET, 256ull * 1024ull * 1024ull);
+
+        MipStreamingPolicy policy;
+        MipSetter setter;
+        std::shared_ptr<FakeMipChain> a = MakeTexture("a");
+        std::shared_ptr<FakeMipChain> b = MakeTexture("b");
+        for (const std::shared_ptr<FakeMipChain>& texture : { a, b })
+        {
+            policy.Request(texture, UvPerPixelForMip(1024u, 0u));
+        }
+        policy.Update(setter.Get());
+        ASSERT_EQ(a->GetResidentMip(), 0u);
+        ASSERT_EQ(b->GetResidentMip(), 0u);
+        ASSERT_EQ(policy.GetStats().uNumEvicted, 0u);
+
+        policy.SetBudget(a->GetMipChainSize(0u) + b->GetMipChainSize(1u));
+        for (const std::shared_ptr<FakeMipChain>& texture : { a, b })
+        {
+            policy.Request(texture, UvPerPixelForMip(1024u, 0u));
+        }
+        EXPECT_EQ(policy.Update(setter.Get()), 1u);
+        EXPECT_EQ(a->GetResidentMip() + b->GetResidentMip(), 1u);
+        EXPECT_EQ(policy.GetStats().uNumEvicted, 1u);
+        EXPECT_LE(policy.GetStats().uResidentBytes, policy.GetBudget());
+
+        policy.SetBudget(0ull);
+        for (const std::shared_ptr<FakeMipChain>& texture : { a, b })
+        {
+            policy.Request(texture, UvPerPixelForMip(1024u, 0u));
+        }
+        policy.Update(setter.Get());
+        EXPECT_EQ(a->GetResidentMip(), a->GetFallbackMip());
+        EXPECT_EQ(b->GetResidentMip(), b->GetFallbackMip());
+        EXPECT_EQ(policy.GetStats().uResidentBytes, a->GetMipChainSize(a->GetFallbackMip()) + b->GetMipChainSize(b->GetFallbackMip()));
+    }
+
+    // A texture that could not be created again keeps its mips and stays pending
+    TEST(MipStreamingPolicyTest, KeepsTheMipsOfAFailedStreamIn)
+    {
+        MipStreamingPolicy policy;
+        MipSetter setter;
+        setter.bFail = true;
+        std::shared_ptr<FakeMipChain> texture = MakeTexture("wood");
+
+        policy.Request(texture, UvPerPixelForMip(1024u, 0u));
+        EXPECT_EQ(policy.Update(setter.Get()), 0u);
+        EXPECT_EQ(setter.aCalls.size(), 1u);
+        EXPECT_EQ(texture->GetResidentMip(), texture->GetFallbackMip());
+        EXPECT_EQ(policy.GetStats().uNumStreamedIn, 0u);
+        EXPECT_EQ(policy.GetStats().uNumPending, 1u);
+        EXPECT_EQ(policy.GetStats().uResidentBytes, texture->GetMipChainSize(texture->GetFallbackMip()));
+    }
+
+    TEST(MipStreamingPolicyTest, ForgetsReleasedTextures)
+    {
+        MipStreamingPolicy policy;
+        MipSetter setter;
+        std::shared_ptr<FakeMipChain> texture = MakeTexture("wood");
+
+        policy.Request(texture, UvPerPixelForMip(1024u, 0u));
+        policy.Update(setter.Get());
+        EXPECT_EQ(policy.GetStats().uNumTextures, 1u);
+
+        texture.reset();
+        EXPECT_EQ(policy.Update(setter.Get()), 0u);
+        EXPECT_EQ(policy.GetStats().uNumTextures, 0u);
+        EXPECT_EQ(policy.GetStats().uResidentBytes, 0ull);
+    }
+}
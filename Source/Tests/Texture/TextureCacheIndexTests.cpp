@@ -0,0 +1,158 @@
+#include "Texture/TextureCacheIndex.h"
+
+#include "Texture/TextureContent.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace library
+{
+    namespace
+    {
+        // eTextureSamplerType::TRILINEAR_WRAP, the sampler type lives with the D3D texture
+        constexpr const uint32_t TRILINEAR_WRAP = 0u;
+        constexpr const uint32_t COLOR = static_cast<uint32_t>(eTextureContent::COLOR);
+        constexpr const uint32_t NORMAL = static_cast<uint32_t>(eTextureContent::NORMAL);
+
+        std::wstring MakeKey(const std::filesystem::path& filePath)
+        {
+            return TextureCacheIndex::MakePathKey(filePath, TRILINEAR_WRAP, COLOR);
+        }
+
+        uint64_t HashText(const std::string& text, uint32_t uContent = COLOR)
+        {
+            return TextureCacheIndex::HashContents(text.data(), text.size(), TRILINEAR_WRAP, uContent);
+        }
+
+        uint32_t GetNumDeduplicated(const TextureCacheIndex& index, const std::shared_ptr<void>& entry)
+        {
+            std::vector<TextureCacheShare> aShares;
+            index.GetShares(aShares);
+            for (const TextureCacheShare& share : aShares)
+            {
+                if (share.entry == entry)
+                {
+                    return share.uNumDeduplicated;
+                }
+            }
+
+            ADD_FAILURE() << "entry not alive";
+            return 0u;
+        }
+    }
+
+    // Paths naming the same file the way model files write them share a key, other uses of the file do not
+    TEST(TextureCacheIndexTest, NormalizesPathKeys)
+    {
+        const std::filesystem::path directory = std::filesystem::path(::testing::TempDir()) / "TextureCacheIndex";
+
+        EXPECT_EQ(MakeKey(directory / "Wood.png"), MakeKey(directory / "." / "wood.PNG"));
+        EXPECT_EQ(MakeKey(directory / "Wood.png"), MakeKey(directory / "Bark" / ".." / "WOOD.png"));
+        EXPECT_NE(MakeKey(directory / "Wood.png"), MakeKey(directory / "Bark.png"));
+        EXPECT_NE(MakeKey(directory / "Wood.png"), TextureCacheIndex::MakePathKey(directory / "Wood.png", TRILINEAR_WRAP, NORMAL));
+        EXPECT_NE(MakeKey(directory / "Wood.png"), TextureCacheIndex::MakePathKey(directory / "Wood.png", TRILINEAR_WRAP + 1u, COLOR));
+    }
+
+    TEST(TextureCacheIndexTest, HashesTheBytesAndTheirUse)
+    {
+        EXPECT_EQ(HashText("texels"), HashText(std::string("texels")));
+        EXPECT_NE(HashText("texels"), HashText("texelz"));
+        EXPECT_NE(HashText("texels"), HashText("texels", NORMAL));
+        EXPECT_NE(HashText(std::string(1u, '\0')), HashText(std::string(2u, '\0')));
+    }
+
+    // Every request of a path after the first gets the entry it inserted
+    TEST(TextureCacheIndexTest, DeduplicatesByPath)
+    {
+        TextureCacheIndex index;
+        const std::wstring pathKey = MakeKey("Content/Wood.png");
+        const uint64_t uHash = HashText("wood");
+
+        EXPECT_EQ(index.Find(pathKey, nullptr), nullptr);
+        EXPECT_EQ(index.Find(pathKey, &uHash), nullptr);
+        std::shared_ptr<void> entry = std::make_shared<int>(1);
+        index.Insert(pathKey, &uHash, entry);
+
+        for (uint32_t uRequest = 0u; uRequest < 3u; ++uRequest)
+        {
+            EXPECT_EQ(index.Find(pathKey, nullptr), entry);
+        }
+        EXPECT_EQ(index.Find(MakeKey("Content/./WOOD.png"), nullptr), entry);
+
+        EXPECT_EQ(index.GetCounts().uNumPathHits, 4u);
+        EXPECT_EQ(index.GetCounts().uNumContentHits, 0u);
+        EXPECT_EQ(index.GetCounts().uNumMisses, 1u);
+        EXPECT_EQ(GetNumDeduplicated(index, entry), 4u);
+    }
+
+    // A copy of an image under another name is found by its bytes, and by its own path from then on
+    TEST(TextureCacheIndexTest, DeduplicatesByContents)
+    {
+        TextureCacheIndex index;
+        const uint64_t uHash = HashText("wood");
+        std::shared_ptr<void> entry = std::make_shared<int>(1);
+        index.Insert(MakeKey("Content/Wood.png"), &uHash, entry);
+
+        const std::wstring copyKey = MakeKey("Content/Copy/Planks.png");
+        EXPECT_EQ(index.Find(copyKey, nullptr), nullptr);
+        EXPECT_EQ(index.Find(copyKey, &uHash), entry);
+        EXPECT_EQ(index.GetCounts().uNumContentHits, 1u);
+
+        EXPECT_EQ(index.Find(copyKey, nullptr), entry);
+        EXPECT_EQ(index.GetCounts().uNumPathHits, 1u);
+
+        const uint64_t uOtherHash = HashText("bark");
+        EXPECT_EQ(index.Find(MakeKey("Content/Bark.png"), &uOtherHash), nullptr);
+        const uint64_t uNormalHash = HashText("wood", NORMAL);
+        EXPECT_EQ(index.Find(MakeKey("Content/WoodNormal.png"), &uNormalHash), nullptr);
+
+        EXPECT_EQ(index.GetCounts().uNumContentHits, 1u);
+        EXPECT_EQ(GetNumDeduplicated(index, entry), 2u);
+    }
+
+    // Only the requests served count, not the references the loader or the streamer hold
+    TEST(TextureCacheIndexTest, CountsRequestsNotReferences)
+    {
+        TextureCacheIndex index;
+        const std::wstring pathKey = MakeKey("Content/Wood.png");
+        std::shared_ptr<void> entry = std::make_shared<int>(1);
+        index.Insert(pathKey, nullptr, entry);
+
+        const std::vector<std::shared_ptr<void>> aOtherOwners(5u, entry);
+        EXPECT_EQ(GetNumDeduplicated(index, entry), 0u);
+
+        std::shared_ptr<void> shared = index.Find(pathKey, nullptr);
+        ASSERT_EQ(shared, entry);
+        EXPECT_EQ(GetNumDeduplicated(index, entry), 1u);
+    }
+
+    // Released entries are not handed out again, and the next request inserts a new one
+    TEST(TextureCacheIndexTest, ForgetsReleasedEntries)
+    {
+        TextureCacheIndex index;
+        const std::wstring pathKey = MakeKey("Content/Wood.png");
+        const std::wstring copyKey = MakeKey("Content/Planks.png");
+        const uint64_t uHash = HashText("wood");
+
+        std::shared_ptr<void> entry = std::make_shared<int>(1);
+        index.Insert(pathKey, &uHash, entry);
+        ASSERT_EQ(index.Find(copyKey, &uHash), entry);
+        entry.reset();
+
+        EXPECT_EQ(index.Find(pathKey, &uHash), nullptr);
+        EXPECT_EQ(index.Find(copyKey, &uHash), nullptr);
+        std::vector<TextureCacheShare> aShares;
+        index.GetShares(aShares);
+        EXPECT_TRUE(aShares.empty());
+
+        EXPECT_EQ(index.Purge(), 3u);
+        EXPECT_EQ(index.Purge(), 0u);
+
+        std::shared_ptr<void> reloaded = std::make_shared<int>(2);
+        index.Insert(pathKey, &uHash, reloaded);
+        EXPECT_EQ(index.Find(copyKey, &uHash), reloaded);
+        EXPECT_EQ(GetNumDeduplicated(index, reloaded), 1u);
+        EXPECT_EQ(index.GetCounts().uNumMisses, 2u);
+    }
+}
@@ -0,0 +1,124 @@
+#include "BlockCompressor.h"
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "TextureCooker/CookerTestImages.h"
+
+namespace cooker
+{
+    namespace
+    {
+        struct RoundTrip
+        {
+            eBlockFormat eFormat;
+            uint32_t uNumChannels;
+            bool bNormals;
+            double minimumPsnr;
+        };
+
+        // Below what the encoders reach on these images by a decibel or two, above what a bad fit reaches
+        constexpr const RoundTrip ROUND_TRIPS[] =
+        {
+            { eBlockFormat::BC1, 3u, false, 35.0 },
+            { eBlockFormat::BC3, 4u, false, 36.0 },
+            { eBlockFormat::BC4, 1u, false, 49.0 },
+            { eBlockFormat::BC5, 2u, true, 46.0 },
+        };
+
+        std::vector<uint8_t> RoundTripImage(eBlockFormat eFormat, const std::vector<uint8_t>& aRgba, uint32_t uWidth, uint32_t uHeight)
+        {
+            std::vector<uint8_t> aBlocks;
+            BlockCompressor::Compress(eFormat, aRgba, uWidth, uHeight, aBlocks);
+
+            const size_t uNumBlocks = static_cast<size_t>((uWidth + 3u) / 4u) * ((uHeight + 3u) / 4u);
+            EXPECT_EQ(aBlocks.size(), uNumBlocks * BlockCompressor::GetBlockSize(eFormat));
+
+            std::vector<uint8_t> aDecoded;
+            BlockCompressor::Decompress(eFormat, aBlocks, uWidth, uHeight, aDecoded);
+            EXPECT_EQ(aDecoded.size(), aRgba.size());
+            return aDecoded;
+        }
+    }
+
+    TEST(BlockCompressorTest, BlocksHaveTheSizesOfTheirFormats)
+    {
+        EXPECT_EQ(BlockCompressor::GetBlockSize(eBlockFormat::BC1), 8u);
+        EXPECT_EQ(BlockCompressor::GetBlockSize(eBlockFormat::BC3), 16u);
+        EXPECT_EQ(BlockCompressor::GetBlockSize(eBlockFormat::BC4), 8u);
+        EXPECT_EQ(BlockCompressor::GetBlockSize(eBlockFormat::BC5), 16u);
+    }
+
+    TEST(BlockCompressorTest, RoundTripsAboveThePsnrOfEachFormat)
+    {
+        for (const RoundTrip& roundTrip : ROUND_TRIPS)
+        {
+            const std::vector<uint8_t> aRgba = roundTrip.bNormals ? MakeNormalImage(128u, 128u) : MakeColorImage(128u, 128u, roundTrip.eFormat == eBlockFormat::BC3);
+            const std::vector<uint8_t> aDecoded = RoundTripImage(roundTrip.eFormat, aRgba, 128u, 128u);
+
+            EXPECT_GE(MeasurePsnr(aRgba, aDecoded, roundTrip.uNumChannels), roundTrip.minimumPsnr) << "format " << static_cast<uint32_t>(roundTrip.eFormat);
+        }
+    }
+
+    // The texels past the edge repeat the last row and column, and only the texels inside are decoded
+    TEST(BlockCompressorTest, PadsImagesNotAMultipleOfTheBlock)
+    {
+        for (const RoundTrip& roundTrip : ROUND_TRIPS)
+        {
+            for (const uint32_t uSize : { 1u, 2u, 3u, 5u, 37u })
+            {
+                const uint32_t uHeight = 23u;
+                const uint32_t uPaddedWidth = (uSize + 3u) / 4u * 4u;
+                const uint32_t uPaddedHeight = (uHeight + 3u) / 4u * 4u;
+                const std::vector<uint8_t> aRgba = roundTrip.bNormals ? MakeNormalImage(uSize, uHeight) : MakeColorImage(uSize, uHeight, roundTrip.eFormat == eBlockFormat::BC3);
+
+                std::vector<uint8_t> aPadded(static_cast<size_t>(uPaddedWidth) * uPaddedHeight * 4u);
+                for (uint32_t y = 0u; y < uPaddedHeight; ++y)
+                {
+                    for (uint32_t x = 0u; x < uPaddedWidth; ++x)
+                    {
+                        const size_t uSource = (static_cast<size_t>((std::min)(y, uHeight - 1u)) * uSize + (std::min)(x, uSize - 1u)) * 4u;
+                        std::copy_n(&aRgba[uSource], 4u, &aPadded[(static_cast<size_t>(y) * uPaddedWidth + x) * 4u]);
+                    }
+                }
+
+                std::vector<uint8_t> aBlocks;
+                std::vector<uint8_t> aPaddedBlocks;
+                BlockCompressor::Compress(roundTrip.eFormat, aRgba, uSize, uHeight, aBlocks);
+                BlockCompressor::Compress(roundTrip.eFormat, aPadded, uPaddedWidth, uPaddedHeight, aPaddedBlocks);
+                EXPECT_EQ(aBlocks, aPaddedBlocks) << "format " << static_cast<uint32_t>(roundTrip.eFormat) << ", width " << uSize;
+
+                std::vector<uint8_t> aDecoded;
+                std::vector<uint8_t> aPaddedDecoded;
+                BlockCompressor::Decompress(roundTrip.eFormat, aBlocks, uSize, uHeight, aDecoded);
+                BlockCompressor::Decompress(roundTrip.eFormat, aPaddedBlocks, uPaddedWidth, uPaddedHeight, aPaddedDecoded);
+                ASSERT_EQ(aDecoded.size(), aRgba.size());
+                for (uint32_t y = 0u; y < uHeight; ++y)
+                {
+                    EXPECT_TRUE(std::equal(&aDecoded[static_cast<size_t>(y) * uSize * 4u], &aDecoded[static_cast<size_t>(y + 1u) * uSize * 4u], &aPaddedDecoded[static_cast<size_t>(y) * uPaddedWidth * 4u]));
+                }
+            }
+        }
+    }
+
+    // A color 5:6:5 holds exactly, and a channel of a single value, decode as they were
+    TEST(BlockCompressorTest, KeepsFlatBlocksExact)
+    {
+        std::vector<uint8_t> aRgba(16u * 16u * 4u);
+        for (size_t i = 0u; i < aRgba.size(); i += 4u)
+        {
+            aRgba[i + 0u] = 0xffu;
+            aRgba[i + 1u] = 0x82u;
+            aRgba[i + 2u] = 0x00u;
+            aRgba[i + 3u] = 0x40u;
+        }
+
+        for (const RoundTrip& roundTrip : ROUND_TRIPS)
+        {
+            const std::vector<uint8_t> aDecoded = RoundTripImage(roundTrip.eFormat, aRgba, 16u, 16u);
+
+            EXPECT_EQ(MeasurePsnr(aRgba, aDecoded, roundTrip.uNumChannels), INFINITY) << "format " << static_cast<uint32_t>(roundTrip.eFormat);
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace cooker
+{
+    // RGBA image of smooth gradients with a little noise, as photographs and painted textures are
+    inline std::vector<uint8_t> MakeColorImage(uint32_t uWidth, uint32_t uHeight, bool bAlpha)
+    {
+        std::mt19937 random(uWidth * 31u + uHeight);
+        std::uniform_int_distribution<int> noise(-6, 6);
+        auto clamp = [](int iValue) { return static_cast<uint8_t>(iValue < 0 ? 0 : (iValue > 255 ? 255 : iValue)); };
+
+        std::vector<uint8_t> aRgba(static_cast<size_t>(uWidth) * uHeight * 4u);
+        for (uint32_t y = 0u; y < uHeight; ++y)
+        {
+            for (uint32_t x = 0u; x < uWidth; ++x)
+            {
+                uint8_t* pTexel = &aRgba[(static_cast<size_t>(y) * uWidth + x) * 4u];
+                pTexel[0] = clamp(static_cast<int>(x * 255u / uWidth) + noise(random));
+                pTexel[1] = clamp(static_cast<int>(y * 255u / uHeight) + noise(random));
+                pTexel[2] = clamp(128 + static_cast<int>(100.0 * std::sin(0.1 * (x + y))) + noise(random));
+                pTexel[3] = bAlpha ? clamp(static_cast<int>((x + y) * 255u / (uWidth + uHeight)) + noise(random)) : 255u;
+            }
+        }
+        return aRgba;
+    }
+
+    // RGBA image of unit normals tilting across the image, encoded to [0, 255]
+    inline std::vector<uint8_t> MakeNormalImage(uint32_t uWidth, uint32_t uHeight)
+    {
+        std::vector<uint8_t> aRgba(static_cast<size_t>(uWidth) * uHeight * 4u);
+        for (uint32_t y = 0u; y < uHeight; ++y)
+        {
+            for (uint32_t x = 0u; x < uWidth; ++x)
+            {
+                const double nx = 0.6 * std::sin(0.2 * x);
+                const double ny = 0.6 * std::cos(0.15 * y);
+                const double nz = std::sqrt((std::max)(1.0 - nx * nx - ny * ny, 0.0));
+                uint8_t* pTexel = &aRgba[(static_cast<size_t>(y) * uWidth + x) * 4u];
+                pTexel[0] = static_cast<uint8_t>(std::lround((nx * 0.5 + 0.5) * 255.0));
+                pTexel[1] = static_cast<uint8_t>(std::lround((ny * 0.5 + 0.5) * 255.0));
+                pTexel[2] = static_cast<uint8_t>(std::lround((nz * 0.5 + 0.5) * 255.0));
+                pTexel[3] = 255u;
+            }
+        }
+        return aRgba;
+    }
+
+    // Peak signal to noise ratio in decibels over the first channels of two RGBA images
+    inline double MeasurePsnr(const std::vector<uint8_t>& aExpected, const std::vector<uint8_t>& aActual, uint32_t uNumChannels)
+    {
+        double squaredError = 0.0;
+        for (size_t i = 0u; i < aExpected.size(); i += 4u)
+        {
+            for (uint32_t c = 0u; c < uNumChannels; ++c)
+            {
+                const double difference = static_cast<double>(aExpected[i + c]) - static_cast<double>(aActual[i + c]);
+                squaredError += difference * difference;
+            }
+        }
+
+        if (squaredError == 0.0)
+        {
+            return INFINITY;
+        }
+
+        return 10.0 * std::log10(255.0 * 255.0 * static_cast<double>(aExpected.size() / 4u * uNumChannels) / squaredError);
+    }
+}
@@ -0,0 +1,159 @@
+// The DDS parser first, the cooker only defines the status codes it does not
+#include "Texture/DDSParser.h"
+
+#include "TextureCooker.h"
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Texture/MipGenerator.h"
+#include "TextureCooker/CookerTestImages.h"
+
+namespace cooker
+{
+    namespace
+    {
+        struct Cooking
+        {
+            eTextureKind eKind;
+            bool bAlpha;
+            eBlockFormat eFormat;
+            DXGI_FORMAT format;
+            uint32_t uNumChannels;
+            double minimumPsnr;
+        };
+
+        constexpr const Cooking COOKINGS[] =
+        {
+            { eTextureKind::COLOR, false, eBlockFormat::BC1, DXGI_FORMAT_BC1_UNORM, 3u, 35.0 },
+            { eTextureKind::COLOR, true, eBlockFormat::BC3, DXGI_FORMAT_BC3_UNORM, 4u, 36.0 },
+            { eTextureKind::MASK, false, eBlockFormat::BC4, DXGI_FORMAT_BC4_UNORM, 1u, 49.0 },
+            { eTextureKind::NORMAL, false, eBlockFormat::BC5, DXGI_FORMAT_BC5_UNORM, 2u, 46.0 },
+        };
+
+        // Not powers of two, so the mips round down and the edge blocks are partial
+        constexpr const uint32_t WIDTH = 200u;
+        constexpr const uint32_t HEIGHT = 120u;
+
+        std::filesystem::path GetTestPath(const char* szExtension)
+        {
+            const ::testing::TestInfo* pTestInfo = ::testing::UnitTest::GetInstance()->current_test_info();
+            return std::filesystem::path(::testing::TempDir()) / (std::string("TextureCooker_") + pTestInfo->name() + szExtension);
+        }
+
+        void WritePam(const std::filesystem::path& filePath, const std::vector<uint8_t>& aRgba, uint32_t uWidth, uint32_t uHeight)
+        {
+            std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+            file << "P7\nWIDTH " << uWidth << "\nHEIGHT " << uHeight << "\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n";
+            file.write(reinterpret_cast<const char*>(aRgba.data()), static_cast<std::streamsize>(aRgba.size()));
+        }
+
+        std::vector<uint8_t> ReadFile(const std::filesystem::path& filePath)
+        {
+            std::ifstream file(filePath, std::ios::binary);
+            return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+
+        std::vector<uint8_t> MakeImage(const Cooking& cooking)
+        {
+            return cooking.eKind == eTextureKind::NORMAL ? MakeNormalImage(WIDTH, HEIGHT) : MakeColorImage(WIDTH, HEIGHT, cooking.bAlpha);
+        }
+    }
+
+    // The file holds a 2D texture of the format of the kind with every mip, and its top mip decodes close to the image
+    TEST(TextureCookerTest, WritesDdsFilesTheParserReads)
+    {
+        const std::filesystem::path inputPath = GetTestPath(".pam");
+        const std::filesystem::path outputPath = GetTestPath(".dds");
+        for (const Cooking& cooking : COOKINGS)
+        {
+            const std::vector<uint8_t> aRgba = MakeImage(cooking);
+            WritePam(inputPath, aRgba, WIDTH, HEIGHT);
+
+            CookReport report;
+            ASSERT_EQ(TextureCooker::Cook(inputPath, cooking.eKind, outputPath, report), S_OK);
+            EXPECT_EQ(report.eFormat, cooking.eFormat);
+            EXPECT_FALSE(std::filesystem::exists(std::filesystem::path(outputPath).concat(".tmp")));
+
+            const std::vector<uint8_t> aFile = ReadFile(outputPath);
+            DirectX::DDS_TEXTURE_LAYOUT layout;
+            ASSERT_EQ(DirectX::ValidateDDSTextureMemory(aFile.data(), aFile.size(), &layout), S_OK);
+            EXPECT_EQ(layout.resourceDimension, static_cast<uint32_t>(D3D11_RESOURCE_DIMENSION_TEXTURE2D));
+            EXPECT_EQ(layout.width, WIDTH);
+            EXPECT_EQ(layout.height, HEIGHT);
+            EXPECT_EQ(layout.depth, 1u);
+            EXPECT_EQ(layout.mipCount, library::MipGenerator::GetNumMips(WIDTH, HEIGHT));
+            EXPECT_EQ(layout.mipCount, report.uNumMips);
+            EXPECT_EQ(layout.arraySize, 1u);
+            EXPECT_EQ(layout.format, cooking.format);
+            EXPECT_FALSE(layout.isCubeMap);
+
+            const DirectX::DDS_HEADER* pHeader = nullptr;
+            const uint8_t* pBits = nullptr;
+            size_t uBitSize = 0u;
+            ASSERT_EQ(DirectX::LoadTextureDataFromMemory(aFile.data(), aFile.size(), &pHeader, &pBits, &uBitSize), S_OK);
+            EXPECT_EQ(uBitSize, report.uNumBytes);
+
+            size_t uTopSize = 0u;
+            ASSERT_EQ(DirectX::GetSurfaceInfo(WIDTH, HEIGHT, cooking.format, &uTopSize, nullptr, nullptr), S_OK);
+            EXPECT_EQ(pHeader->pitchOrLinearSize, uTopSize);
+
+            std::vector<uint8_t> aDecoded;
+            BlockCompressor::Decompress(cooking.eFormat, std::vector<uint8_t>(pBits, pBits + uTopSize), WIDTH, HEIGHT, aDecoded);
+            const double psnr = MeasurePsnr(aRgba, aDecoded, cooking.uNumChannels);
+            EXPECT_GE(psnr, cooking.minimumPsnr) << "format " << static_cast<uint32_t>(cooking.eFormat);
+            EXPECT_NEAR(report.psnr, psnr, 0.01);
+        }
+
+        std::filesystem::remove(inputPath);
+        std::filesystem::remove(outputPath);
+    }
+
+    // The mips follow the top one in order, each the blocks of the mip MipGenerator builds
+    TEST(TextureCookerTest, WritesTheMipsOfTheMipGenerator)
+    {
+        const std::filesystem::path inputPath = GetTestPath(".pam");
+        const std::filesystem::path outputPath = GetTestPath(".dds");
+        for (const Cooking& cooking : COOKINGS)
+        {
+            std::vector<std::vector<uint8_t>> aaMips(1u, MakeImage(cooking));
+            WritePam(inputPath, aaMips[0], WIDTH, HEIGHT);
+
+            CookReport report;
+            ASSERT_EQ(TextureCooker::Cook(inputPath, cooking.eKind, outputPath, report), S_OK);
+
+            const library::eTextureContent content = cooking.eKind == eTextureKind::NORMAL ? library::eTextureContent::NORMAL
+                                                   : cooking.eKind == eTextureKind::MASK ? library::eTextureContent::DATA
+                                                   : library::eTextureContent::COLOR;
+            library::MipGenerator::GenerateMips(content, WIDTH, HEIGHT, aaMips);
+
+            std::vector<uint8_t> aExpected;
+            for (uint32_t uMip = 0u; uMip < aaMips.size(); ++uMip)
+            {
+                std::vector<uint8_t> aBlocks;
+                BlockCompressor::Compress(cooking.eFormat, aaMips[uMip], (std::max)(WIDTH >> uMip, 1u), (std::max)(HEIGHT >> uMip, 1u), aBlocks);
+                aExpected.insert(aExpected.end(), aBlocks.begin(), aBlocks.end());
+            }
+
+            const std::vector<uint8_t> aFile = ReadFile(outputPath);
+            ASSERT_EQ(aFile.size(), sizeof(uint32_t) + sizeof(DirectX::DDS_HEADER) + aExpected.size());
+            EXPECT_TRUE(std::equal(aExpected.begin(), aExpected.end(), aFile.end() - static_cast<std::ptrdiff_t>(aExpected.size()))) << "format " << static_cast<uint32_t>(cooking.eFormat);
+        }
+
+        std::filesystem::remove(inputPath);
+        std::filesystem::remove(outputPath);
+    }
+
+    TEST(TextureCookerTest, FailsWithoutWritingOnAMissingImage)
+    {
+        const std::filesystem::path outputPath = GetTestPath(".dds");
+        std::filesystem::remove(outputPath);
+
+        CookReport report;
+        EXPECT_TRUE(FAILED(TextureCooker::Cook(GetTestPath(".pam"), eTextureKind::COLOR, outputPath, report)));
+        EXPECT_FALSE(std::filesystem::exists(outputPath));
+    }
+}
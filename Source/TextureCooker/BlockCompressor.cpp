@@ -0,0 +1,629 @@
+#include "BlockCompressor.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// BLOCK_COMPRESSOR_NO_SIMD builds the scalar path, which the tests check as well
+#if !defined(BLOCK_COMPRESSOR_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define BLOCK_COMPRESSOR_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace cooker
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BlockCompressor::GetBlockSize
+
+      Summary:  Returns the bytes of a block of a format
+
+      Args:     eBlockFormat eFormat
+                  Format of the blocks
+
+      Returns:  UINT
+                  Bytes of a 4x4 block
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT BlockCompressor::GetBlockSize(_In_ eBlockFormat eFormat)
+    {
+        return eFormat == eBlockFormat::BC1 || eFormat == eBlockFormat::BC4 ? 8u : 16u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BlockCompressor::Compress
+
+      Summary:  Encodes an image block by block, rows of blocks from
+                the top. BC3 is an alpha block then a color block, BC5
+                a red block then a green block
+
+      Args:     eBlockFormat eFormat
+                  Format of the blocks
+                const std::vector<BYTE>& aRgba
+                  RGBA bytes of the image
+                UINT uWidth
+                  Width of the image
+                UINT uHeight
+                  Height of the image
+                std::vector<BYTE>& aBlocks
+                  Blocks of the image
+
+      Modifies: [aBlocks].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void BlockCompressor::Compress(_In_ eBlockFormat eFormat, _In_ const std::vector<BYTE>& aRgba, _In_ UINT uWidth, _In_ UINT uHeight, _Out_ std::vector<BYTE>& aBlocks)
+    {
+        const UINT uNumBlocksWide = (uWidth + BLOCK_DIMENSION - 1u) / BLOCK_DIMENSION;
+        const UINT uNumBlocksHigh = (uHeight + BLOCK_DIMENSION - 1u) / BLOCK_DIMENSION;
+        const UINT uBlockSize = GetBlockSize(eFormat);
+
+        aBlocks.resize(static_cast<size_t>(uNumBlocksWide) * uNumBlocksHigh * uBlockSize);
+
+        BYTE aTexels[NUM_BLOCK_TEXELS * 4u];
+        for (UINT uBlockY = 0u; uBlockY < uNumBlocksHigh; ++uBlockY)
+        {
+            for (UINT uBlockX = 0u; uBlockX < uNumBlocksWide; ++uBlockX)
+            {
+                for (UINT y = 0u; y < BLOCK_DIMENSION; ++y)
+                {
+                    const UINT uSourceY = (std::min)(uBlockY * BLOCK_DIMENSION + y, uHeight - 1u);
+                    for (UINT x = 0u; x < BLOCK_DIMENSION; ++x)
+                    {
+                        const UINT uSourceX = (std::min)(uBlockX * BLOCK_DIMENSION + x, uWidth - 1u);
+                        std::copy_n(&aRgba[(static_cast<size_t>(uSourceY) * uWidth + uSourceX) * 4u], 4u, &aTexels[(y * BLOCK_DIMENSION + x) * 4u]);
+                    }
+                }
+
+                BYTE* pBlock = &aBlocks[(static_cast<size_t>(uBlockY) * uNumBlocksWide + uBlockX) * uBlockSize];
+                switch (eFormat)
+                {
+                case eBlockFormat::BC1:
+                    compressColorBlock(aTexels, pBlock);
+                    break;
+                case eBlockFormat::BC3:
+                    compressChannelBlock(aTexels, 3u, pBlock);
+                    compressColorBlock(aTexels, pBlock + 8u);
+                    break;
+                case eBlockFormat::BC4:
+                    compressChannelBlock(aTexels, 0u, pBlock);
+                    break;
+                case eBlockFormat::BC5:
+                    compressChannelBlock(aTexels, 0u, pBlock);
+                    compressChannelBlock(aTexels, 1u, pBlock + 8u);
+                    break;
+                default:
+                    assert(false);
+                    break;
+                }
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BlockCompressor::Decompress
+
+      Summary:  Decodes an image as the GPU samples it. The channels a
+                format does not store are 0, and alpha 255 if opaque
+
+      Args:     eBlockFormat eFormat
+                  Format of the blocks
+                const std::vector<BYTE>& aBlocks
+                  Blocks of the image
+                UINT uWidth
+                  Width of the image
+                UINT uHeight
+                  Height of the image
+                std::vector<BYTE>& aRgba
+                  RGBA bytes of the image
+
+      Modifies: [aRgba].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void BlockCompressor::Decompress(_In_ eBlockFormat eFormat, _In_ const std::vector<BYTE>& aBlocks, _In_ UINT uWidth, _In_ UINT uHeight, _Out_ std::vector<BYTE>& aRgba)
+    {
+        const UINT uNumBlocksWide = (uWidth + BLOCK_DIMENSION - 1u) / BLOCK_DIMENSION;
+        const UINT uNumBlocksHigh = (uHeight + BLOCK_DIMENSION - 1u) / BLOCK_DIMENSION;
+        const UINT uBlockSize = GetBlockSize(eFormat);
+
+        aRgba.resize(static_cast<size_t>(uWidth) * uHeight * 4u);
+
+        BYTE aTexels[NUM_BLOCK_TEXELS * 4u];
+        for (UINT uBlockY = 0u; uBlockY < uNumBlocksHigh; ++uBlockY)
+        {
+            for (UINT uBlockX = 0u; uBlockX < uNumBlocksWide; ++uBlockX)
+            {
+                for (UINT i = 0u; i < NUM_BLOCK_TEXELS; ++i)
+                {
+                    aTexels[i * 4u + 0u] = 0u;
+                    aTexels[i * 4u + 1u] = 0u;
+                    aTexels[i * 4u + 2u] = 0u;
+                    aTexels[i * 4u + 3u] = 255u;
+                }
+
+                const BYTE* pBlock = &aBlocks[(static_cast<size_t>(uBlockY) * uNumBlocksWide + uBlockX) * uBlockSize];
+                switch (eFormat)
+                {
+                case eBlockFormat::BC1:
+                    decompressColorBlock(pBlock, aTexels);
+                    break;
+                case eBlockFormat::BC3:
+                    decompressColorBlock(pBlock + 8u, aTexels);
+                    decompressChannelBlock(pBlock, 3u, aTexels);
+                    break;
+                case eBlockFormat::BC4:
+                    decompressChannelBlock(pBlock, 0u, aTexels);
+                    break;
+                case eBlockFormat::BC5:
+                    decompressChannelBlock(pBlock, 0u, aTexels);
+                    decompressChannelBlock(pBlock + 8u, 1u, aTexels);
+                    break;
+                default:
+                    assert(false);
+                    break;
+                }
+
+                for (UINT y = 0u; y < BLOCK_DIMENSION && uBlockY * BLOCK_DIMENSION + y < uHeight; ++y)
+                {
+                    for (UINT x = 0u; x < BLOCK_DIMENSION && uBlockX * BLOCK_DIMENSION + x < uWidth; ++x)
+                    {
+                        const size_t uTexel = static_cast<size_t>(uBlockY * BLOCK_DIMENSION + y) * uWidth + uBlockX * BLOCK_DIMENSION + x;
+                        std::copy_n(&aTexels[(y * BLOCK_DIMENSION + x) * 4u], 4u, &aRgba[uTexel * 4u]);
+                    }
+                }
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BlockCompressor::compressColorBlock
+
+      Summary:  Encodes the colors of a block in the four color mode.
+                The endpoints are the extremes of the colors along
+                their principal axis, found by power iteration on
+                their covariance, pulled in by a sixteenth of their
+                span since the extremes are rarely worth a level each.
+                The endpoints are then solved from the indices by
+                least squares once, kept if the error drops
+
+      Args:     const BYTE* pTexels
+                  RGBA bytes of the 16 texels of the block
+                BYTE* pBlock
+                  8 bytes of the block
+
+      Modifies: [pBlock].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void BlockCompressor::compressColorBlock(_In_reads_(NUM_BLOCK_TEXELS * 4u) const BYTE* pTexels, _Out_writes_(8u) BYTE* pBlock)
+    {
+        // Colors by channel, so four texels load at once
+        alignas(16) FLOAT aColors[3u * NUM_BLOCK_TEXELS];
+        FLOAT aMean[3] = { 0.0f, 0.0f, 0.0f };
+        for (UINT i = 0u; i < NUM_BLOCK_TEXELS; ++i)
+        {
+            for (UINT c = 0u; c < 3u; ++c)
+            {
+                aColors[c * NUM_BLOCK_TEXELS + i] = static_cast<FLOAT>(pTexels[i * 4u + c]);
+                aMean[c] += aColors[c * NUM_BLOCK_TEXELS + i];
+            }
+        }
+
+        for (UINT c = 0u; c < 3u; ++c)
+        {
+            aMean[c] /= static_cast<FLOAT>(NUM_BLOCK_TEXELS);
+        }
+
+        FLOAT aCovariance[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+        for (UINT i = 0u; i < NUM_BLOCK_TEXELS; ++i)
+        {
+            const FLOAT r = aColors[i] - aMean[0];
+            const FLOAT g = aColors[NUM_BLOCK_TEXELS + i] - aMean[1];
+            const FLOAT b = aColors[2u * NUM_BLOCK_TEXELS + i] - aMean[2];
+            aCovariance[0] += r * r;
+            aCovariance[1] += r * g;
+            aCovariance[2] += r * b;
+            aCovariance[3] += g * g;
+            aCovariance[4] += g * b;
+            aCovariance[5] += b * b;
+        }
+
+        FLOAT aAxis[3] = { 1.0f, 1.0f, 1.0f };
+        for (UINT uIteration = 0u; uIteration < 8u; ++uIteration)
+        {
+            const FLOAT r = aCovariance[0] * aAxis[0] + aCovariance[1] * aAxis[1] + aCovariance[2] * aAxis[2];
+            const FLOAT g = aCovariance[1] * aAxis[0] + aCovariance[3] * aAxis[1] + aCovariance[4] * aAxis[2];
+            const FLOAT b = aCovariance[2] * aAxis[0] + aCovariance[4] * aAxis[1] + aCovariance[5] * aAxis[2];
+            const FLOAT length = (std::max)((std::max)(std::fabs(r), std::fabs(g)), std::fabs(b));
+            if (length < FLT_EPSILON)
+            {
+                break;
+            }
+
+            aAxis[0] = r / length;
+            aAxis[1] = g / length;
+            aAxis[2] = b / length;
+        }
+
+        const FLOAT lengthSquared = aAxis[0] * aAxis[0] + aAxis[1] * aAxis[1] + aAxis[2] * aAxis[2];
+        FLOAT minimum = FLT_MAX;
+        FLOAT maximum = -FLT_MAX;
+        for (UINT i = 0u; i < NUM_BLOCK_TEXELS; ++i)
+        {
+            const FLOAT t = ((aColors[i] - aMean[0]) * aAxis[0] + (aColors[NUM_BLOCK_TEXELS + i] - aMean[1]) * aAxis[1] + (aColors[2u * NUM_BLOCK_TEXELS + i] - aMean[2]) * aAxis[2]) / lengthSquared;
+            minimum = (std::min)(minimum, t);
+            maximum = (std::max)(maximum, t);
+        }
+
+        const FLOAT inset = (maximum - minimum) / 16.0f;
+        FLOAT aEndpoint0[3];
+        FLOAT aEndpoint1[3];
+        for (UINT c = 0u; c < 3u; ++c)
+        {
+            aEndpoint0[c] = aMean[c] + aAxis[c] * (maximum - inset);
+            aEndpoint1[c] = aMean[c] + aAxis[c] * (minimum + inset);
+        }
+
+        WORD uColor0 = packColor(aEndpoint0);
+        WORD uColor1 = packColor(aEndpoint1);
+        UINT uIndices = 0u;
+        FLOAT error = fitColorIndices(aColors, uColor0, uColor1, uIndices);
+
+        // Least squares on the endpoints, weights of the first endpoint by index
+        static constexpr const FLOAT WEIGHTS[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+        FLOAT aa = 0.0f;
+        FLOAT ab = 0.0f;
+        FLOAT bb = 0.0f;
+        FLOAT aX[3] = { 0.0f, 0.0f, 0.0f };
+        FLOAT bX[3] = { 0.0f, 0.0f, 0.0f };
+        for (UINT i = 0u; i < NUM_BLOCK_TEXELS; ++i)
+        {
+            const FLOAT a = WEIGHTS[(uIndices >> (2u * i)) & 3u];
+            const FLOAT b = 1.0f - a;
+            aa += a * a;
+            ab += a * b;
+            bb += b * b;
+            for (UINT c = 0u; c < 3u; ++c)
+            {
+                aX[c] += a * aColors[c * NUM_BLOCK_TEXELS + i];
+                bX[c] += b * aColors[c * NUM_BLOCK_TEXELS + i];
+            }
+        }
+
+        const FLOAT determinant = aa * bb - ab * ab;
+        if (std::fabs(determinant) > FLT_EPSILON)
+        {
+            for (UINT c = 0u; c < 3u; ++c)
+            {
+                aEndpoint0[c] = (bb * aX[c] - ab * bX[c]) / determinant;
+                aEndpoint1[c] = (aa * bX[c] - ab * aX[c]) / determinant;
+            }
+
+            WORD uRefinedColor0 = packColor(aEndpoint0);
+            WORD uRefinedColor1 = packColor(aEndpoint1);
+            UINT uRefinedIndices = 0u;
+            const FLOAT refinedError = fitColorIndices(aColors, uRefinedColor0, uRefinedColor1, uRefinedIndices);
+            if (refinedError < error)
+            {
+                uColor0 = uRefinedColor0;
+                uColor1 = uRefinedColor1;
+                uIndices = uRefinedIndices;
+                error = refinedError;
+            }
+        }
+
+        pBlock[0] = static_cast<BYTE>(uColor0 & 0xffu);
+        pBlock[1] = static_cast<BYTE>(uColor0 >> 8u);
+        pBlock[2] = static_cast<BYTE>(uColor1 & 0xffu);
+        pBlock[3] = static_cast<BYTE>(uColor1 >> 8u);
+        for (UINT i = 0u; i < 4u; ++i)
+        {
+            pBlock[4u + i] = static_cast<BYTE>((uIndices >> (8u * i)) & 0xffu);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BlockCompressor::compressChannelBlock
+
+      Summary:  Encodes a channel of a block in the eight level mode,
+                the first endpoint the largest value and the second
+                the smallest. A value t sevenths of the span down from
+                the largest is index 0, 1 or t + 1 when in between
+
+      Args:     const BYTE* pTexels
+                  RGBA bytes of the 16 texels of the block
+                UINT uChannel
+                  Channel to encode
+                BYTE* pBlock
+                  8 bytes of the block
+
+      Modifies: [pBlock].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void BlockCompressor::compressChannelBlock(_In_reads_(NUM_BLOCK_TEXELS * 4u) const BYTE* pTexels, _In_ UINT uChannel, _Out_writes_(8u) BYTE* pBlock)
+    {
+        alignas(16) FLOAT aValues[NUM_BLOCK_TEXELS];
+        BYTE uMinimum = 255u;
+        BYTE uMaximum = 0u;
+        for (UINT i = 0u; i < NUM_BLOCK_TEXELS; ++i)
+        {
+            const BYTE uValue = pTexels[i * 4u + uChannel];
+            aValues[i] = static_cast<FLOAT>(uValue);
+            uMinimum = (std::min)(uMinimum, uValue);
+            uMaximum = (std::max)(uMaximum, uValue);
+        }
+
+        UINT64 uIndices = 0ull;
+        if (uMaximum > uMinimum)
+        {
+            alignas(16) INT aSteps[NUM_BLOCK_TEXELS];
+            const FLOAT scale = 7.0f / static_cast<FLOAT>(uMaximum - uMinimum);
+#if defined(BLOCK_COMPRESSOR_SSE2)
+            const __m128 maximum = _mm_set1_ps(static_cast<FLOAT>(uMaximum));
+            const __m128 scales = _mm_set1_ps(scale);
+            for (UINT i = 0u; i < NUM_BLOCK_TEXELS; i += 4u)
+            {
+                const __m128 values = _mm_load_ps(&aValues[i]);
+                _mm_store_si128(reinterpret_cast<__m128i*>(&aSteps[i]), _mm_cvtps_epi32(_mm_mul_ps(_mm_sub_ps(maximum, values), scales)));
+            }
+#else
+            for (UINT i = 0u; i < NUM_BLOCK_TEXELS; ++i)
+            {
+                aSteps[i] = static_cast<INT>(std::nearbyint((static_cast<FLOAT>(uMaximum) - aValues[i]) * scale));
+            }
+#endif
+
+            for (UINT i = 0u; i < NUM_BLOCK_TEXELS; ++i)
+            {
+                const UINT uStep = static_cast<UINT>(aSteps[i]);
+                const UINT uIndex = uStep == 0u ? 0u : (uStep == 7u ? 1u : uStep + 1u);
+                uIndices |= static_cast<UINT64>(uIndex) << (3u * i);
+            }
+        }
+
+        pBlock[0] = uMaximum;
+        pBlock[1] = uMinimum;
+        for (UINT i = 0u; i < 6u; ++i)
+        {
+            pBlock[2u + i] = static_cast<BYTE>((uIndices >> (8u * i)) & 0xffu);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BlockCompressor::decompressColorBlock
+
+      Summary:  Decodes the colors of a block, in the three color mode
+                with transparent black when the first endpoint is not
+                above the second
+
+      Args:     const BYTE* pBlock
+                  8 bytes of the block
+                BYTE* pTexels
+                  RGBA bytes of the 16 texels of the block
+
+      Modifies: [pTexels].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void BlockCompressor::decompressColorBlock(_In_reads_(8u) const BYTE* pBlock, _Out_writes_(NUM_BLOCK_TEXELS * 4u) BYTE* pTexels)
+    {
+        const WORD uColor0 = static_cast<WORD>(pBlock[0] | (pBlock[1] << 8u));
+        const WORD uColor1 = static_cast<WORD>(pBlock[2] | (pBlock[3] << 8u));
+
+        FLOAT aaPalette[4][4];
+        unpackColor(uColor0, aaPalette[0]);
+        unpackColor(uColor1, aaPalette[1]);
+        for (UINT c = 0u; c < 3u; ++c)
+        {
+            if (uColor0 > uColor1)
+            {
+                aaPalette[2][c] = (2.0f * aaPalette[0][c] + aaPalette[1][c]) / 3.0f;
+                aaPalette[3][c] = (aaPalette[0][c] + 2.0f * aaPalette[1][c]) / 3.0f;
+            }
+            else
+            {
+                aaPalette[2][c] = (aaPalette[0][c] + aaPalette[1][c]) / 2.0f;
+                aaPalette[3][c] = 0.0f;
+            }
+        }
+        aaPalette[0][3] = aaPalette[1][3] = aaPalette[2][3] = 255.0f;
+        aaPalette[3][3] = uColor0 > uColor1 ? 255.0f : 0.0f;
+
+        const UINT uIndices = static_cast<UINT>(pBlock[4]) | (static_cast<UINT>(pBlock[5]) << 8u) | (static_cast<UINT>(pBlock[6]) << 16u) | (static_cast<UINT>(pBlock[7]) << 24u);
+        for (UINT i = 0u; i < NUM_BLOCK_TEXELS; ++i)
+        {
+            const FLOAT* pColor = aaPalette[(uIndices >> (2u * i)) & 3u];
+            for (UINT c = 0u; c < 4u; ++c)
+            {
+                pTexels[i * 4u + c] = static_cast<BYTE>(pColor[c] + 0.5f);
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BlockCompressor::decompressChannelBlock
+
+      Summary:  Decodes a channel of a block, in the six level mode with
+                0 and 255 when the first endpoint is not above the
+                second
+
+      Args:     const BYTE* pBlock
+                  8 bytes of the block
+                UINT uChannel
+                  Channel to decode
+                BYTE* pTexels
+                  RGBA bytes of the 16 texels of the block
+
+      Modifies: [pTexels].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void BlockCompressor::decompressChannelBlock(_In_reads_(8u) const BYTE* pBlock, _In_ UINT uChannel, _Out_writes_(NUM_BLOCK_TEXELS * 4u) BYTE* pTexels)
+    {
+        const FLOAT value0 = static_cast<FLOAT>(pBlock[0]);
+        const FLOAT value1 = static_cast<FLOAT>(pBlock[1]);
+
+        FLOAT aPalette[8] = { value0, value1 };
+        if (pBlock[0] > pBlock[1])
+        {
+            for (UINT i = 1u; i < 7u; ++i)
+            {
+                aPalette[i + 1u] = (static_cast<FLOAT>(7u - i) * value0 + static_cast<FLOAT>(i) * value1) / 7.0f;
+            }
+        }
+        else
+        {
+            for (UINT i = 1u; i < 5u; ++i)
+            {
+                aPalette[i + 1u] = (static_cast<FLOAT>(5u - i) * value0 + static_cast<FLOAT>(i) * value1) / 5.0f;
+            }
+            aPalette[6] = 0.0f;
+            aPalette[7] = 255.0f;
+        }
+
+        UINT64 uIndices = 0ull;
+        for (UINT i = 0u; i < 6u; ++i)
+        {
+            uIndices |= static_cast<UINT64>(pBlock[2u + i]) << (8u * i);
+        }
+
+        for (UINT i = 0u; i < NUM_BLOCK_TEXELS; ++i)
+        {
+            pTexels[i * 4u + uChannel] = static_cast<BYTE>(aPalette[(uIndices >> (3u * i)) & 7u] + 0.5f);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BlockCompressor::fitColorIndices
+
+      Summary:  Picks the nearest color of the four color palette of two
+                endpoints for every texel. Endpoints in the wrong order
+                for the four color mode are swapped, and equal
+                endpoints leave every index on the first
+
+      Args:     const FLOAT* pColors
+                  Reds, greens then blues of the 16 texels
+                WORD& uColor0
+                  First endpoint, swapped if below the second
+                WORD& uColor1
+                  Second endpoint, swapped if above the first
+                UINT& uIndices
+                  Two bits of index per texel
+
+      Modifies: [uColor0, uColor1, uIndices].
+
+      Returns:  FLOAT
+                  Sum of the squared errors of the texels
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT BlockCompressor::fitColorIndices(_In_reads_(3u * NUM_BLOCK_TEXELS) const FLOAT* pColors, _Inout_ WORD& uColor0, _Inout_ WORD& uColor1, _Out_ UINT& uIndices)
+    {
+        if (uColor0 < uColor1)
+        {
+            std::swap(uColor0, uColor1);
+        }
+
+        FLOAT aaPalette[4][3];
+        unpackColor(uColor0, aaPalette[0]);
+        unpackColor(uColor1, aaPalette[1]);
+        for (UINT c = 0u; c < 3u; ++c)
+        {
+            aaPalette[2][c] = (2.0f * aaPalette[0][c] + aaPalette[1][c]) / 3.0f;
+            aaPalette[3][c] = (aaPalette[0][c] + 2.0f * aaPalette[1][c]) / 3.0f;
+        }
+
+        // Equal endpoints are the three color mode, where only the first index is safe
+        const UINT uNumColors = uColor0 == uColor1 ? 1u : 4u;
+
+        uIndices = 0u;
+        FLOAT error = 0.0f;
+#if defined(BLOCK_COMPRESSOR_SSE2)
+        for (UINT i = 0u; i < NUM_BLOCK_TEXELS; i += 4u)
+        {
+            const __m128 r = _mm_loadu_ps(&pColors[i]);
+            const __m128 g = _mm_loadu_ps(&pColors[NUM_BLOCK_TEXELS + i]);
+            const __m128 b = _mm_loadu_ps(&pColors[2u * NUM_BLOCK_TEXELS + i]);
+
+            __m128 bestErrors = _mm_set1_ps(FLT_MAX);
+            __m128i bestIndices = _mm_setzero_si128();
+            for (UINT uColor = 0u; uColor < uNumColors; ++uColor)
+            {
+                const __m128 dr = _mm_sub_ps(r, _mm_set1_ps(aaPalette[uColor][0]));
+                const __m128 dg = _mm_sub_ps(g, _mm_set1_ps(aaPalette[uColor][1]));
+                const __m128 db = _mm_sub_ps(b, _mm_set1_ps(aaPalette[uColor][2]));
+                const __m128 errors = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dr, dr), _mm_mul_ps(dg, dg)), _mm_mul_ps(db, db));
+
+                const __m128i closer = _mm_castps_si128(_mm_cmplt_ps(errors, bestErrors));
+                bestErrors = _mm_min_ps(errors, bestErrors);
+                bestIndices = _mm_or_si128(_mm_andnot_si128(closer, bestIndices), _mm_and_si128(closer, _mm_set1_epi32(static_cast<INT>(uColor))));
+            }
+
+            alignas(16) INT aBestIndices[4];
+            alignas(16) FLOAT aBestErrors[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(aBestIndices), bestIndices);
+            _mm_store_ps(aBestErrors, bestErrors);
+            for (UINT k = 0u; k < 4u; ++k)
+            {
+                uIndices |= static_cast<UINT>(aBestIndices[k]) << (2u * (i + k));
+                error += aBestErrors[k];
+            }
+        }
+#else
+        for (UINT i = 0u; i < NUM_BLOCK_TEXELS; ++i)
+        {
+            FLOAT bestError = FLT_MAX;
+            UINT uBestIndex = 0u;
+            for (UINT uColor = 0u; uColor < uNumColors; ++uColor)
+            {
+                const FLOAT dr = pColors[i] - aaPalette[uColor][0];
+                const FLOAT dg = pColors[NUM_BLOCK_TEXELS + i] - aaPalette[uColor][1];
+                const FLOAT db = pColors[2u * NUM_BLOCK_TEXELS + i] - aaPalette[uColor][2];
+                const FLOAT texelError = dr * dr + dg * dg + db * db;
+                if (texelError < bestError)
+                {
+                    bestError = texelError;
+                    uBestIndex = uColor;
+                }
+            }
+
+            uIndices |= uBestIndex << (2u * i);
+            error += bestError;
+        }
+#endif
+
+        return error;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BlockCompressor::packColor
+
+      Summary:  Rounds a color to 5:6:5 bits, red in the high bits
+
+      Args:     const FLOAT* pColor
+                  Red, green and blue in [0, 255], clamped
+
+      Returns:  WORD
+                  Packed color
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    WORD BlockCompressor::packColor(_In_reads_(3u) const FLOAT* pColor)
+    {
+        auto quantize = [](FLOAT value, UINT uMaximum)
+        {
+            const FLOAT clamped = (std::min)((std::max)(value, 0.0f), 255.0f);
+            return static_cast<UINT>(clamped * static_cast<FLOAT>(uMaximum) / 255.0f + 0.5f);
+        };
+
+        return static_cast<WORD>((quantize(pColor[0], 31u) << 11u) | (quantize(pColor[1], 63u) << 5u) | quantize(pColor[2], 31u));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BlockCompressor::unpackColor
+
+      Summary:  Expands a 5:6:5 color to 8 bits per channel by repeating
+                the high bits in the low ones, as the GPU does
+
+      Args:     WORD uColor
+                  Packed color
+                FLOAT* pColor
+                  Red, green and blue in [0, 255]
+
+      Modifies: [pColor].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void BlockCompressor::unpackColor(_In_ WORD uColor, _Out_writes_(3u) FLOAT* pColor)
+    {
+        const UINT uRed = (uColor >> 11u) & 31u;
+        const UINT uGreen = (uColor >> 5u) & 63u;
+        const UINT uBlue = uColor & 31u;
+
+        pColor[0] = static_cast<FLOAT>((uRed << 3u) | (uRed >> 2u));
+        pColor[1] = static_cast<FLOAT>((uGreen << 2u) | (uGreen >> 4u));
+        pColor[2] = static_cast<FLOAT>((uBlue << 3u) | (uBlue >> 2u));
+    }
+}
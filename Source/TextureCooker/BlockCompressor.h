@@ -0,0 +1,98 @@
+/*+===================================================================
+  File:      BLOCKCOMPRESSOR.H
+
+  Summary:   BlockCompressor header file contains declarations of
+             BlockCompressor class used by the TextureCooker of Game
+             Graphics Programming course.
+
+  Classes: BlockCompressor
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace cooker
+{
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+      Enum:     eBlockFormat
+
+      Summary:  Block compressed formats written by the cooker: BC1 for
+                opaque colors, BC3 for colors with alpha, BC4 for one
+                channel masks and BC5 for the two channels of normals
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eBlockFormat : UINT
+    {
+        BC1,
+        BC3,
+        BC4,
+        BC5,
+        COUNT,
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    BlockCompressor
+
+      Summary:  Encodes and decodes 4x4 blocks of RGBA bytes. A color
+                block puts its endpoints on the principal axis of its
+                colors, picks the nearest of the four colors of the
+                palette for every texel, four texels at a time with
+                SSE2 where available, then refits the endpoints to the
+                indices by least squares and keeps the better of the
+                two. A channel block spans the range of its values in
+                eight levels. The texels past the edge of an image not
+                a multiple of four repeat the last row and column
+
+      Methods:  GetBlockSize
+                  Returns the bytes of a block of a format
+                Compress
+                  Encodes an image
+                Decompress
+                  Decodes an image
+                compressColorBlock
+                  Encodes the colors of a block
+                compressChannelBlock
+                  Encodes a channel of a block
+                decompressColorBlock
+                  Decodes the colors of a block
+                decompressChannelBlock
+                  Decodes a channel of a block
+                fitColorIndices
+                  Picks the nearest palette color of every texel
+                packColor
+                  Rounds a color to 5:6:5 bits
+                unpackColor
+                  Expands a 5:6:5 color
+                BlockCompressor
+                  Constructor.
+                ~BlockCompressor
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class BlockCompressor final
+    {
+    public:
+        static constexpr const UINT BLOCK_DIMENSION = 4u;
+        static constexpr const UINT NUM_BLOCK_TEXELS = BLOCK_DIMENSION * BLOCK_DIMENSION;
+
+        BlockCompressor() = delete;
+        BlockCompressor(const BlockCompressor& other) = delete;
+        BlockCompressor(BlockCompressor&& other) = delete;
+        BlockCompressor& operator=(const BlockCompressor& other) = delete;
+        BlockCompressor& operator=(BlockCompressor&& other) = delete;
+        ~BlockCompressor() = delete;
+
+        static UINT GetBlockSize(_In_ eBlockFormat eFormat);
+        static void Compress(_In_ eBlockFormat eFormat, _In_ const std::vector<BYTE>& aRgba, _In_ UINT uWidth, _In_ UINT uHeight, _Out_ std::vector<BYTE>& aBlocks);
+        static void Decompress(_In_ eBlockFormat eFormat, _In_ const std::vector<BYTE>& aBlocks, _In_ UINT uWidth, _In_ UINT uHeight, _Out_ std::vector<BYTE>& aRgba);
+
+    private:
+        static void compressColorBlock(_In_reads_(NUM_BLOCK_TEXELS * 4u) const BYTE* pTexels, _Out_writes_(8u) BYTE* pBlock);
+        static void compressChannelBlock(_In_reads_(NUM_BLOCK_TEXELS * 4u) const BYTE* pTexels, _In_ UINT uChannel, _Out_writes_(8u) BYTE* pBlock);
+        static void decompressColorBlock(_In_reads_(8u) const BYTE* pBlock, _Out_writes_(NUM_BLOCK_TEXELS * 4u) BYTE* pTexels);
+        static void decompressChannelBlock(_In_reads_(8u) const BYTE* pBlock, _In_ UINT uChannel, _Out_writes_(NUM_BLOCK_TEXELS * 4u) BYTE* pTexels);
+        static FLOAT fitColorIndices(_In_reads_(3u * NUM_BLOCK_TEXELS) const FLOAT* pColors, _Inout_ WORD& uColor0, _Inout_ WORD& uColor1, _Out_ UINT& uIndices);
+        static WORD packColor(_In_reads_(3u) const FLOAT* pColor);
+        static void unpackColor(_In_ WORD uColor, _Out_writes_(3u) FLOAT* pColor);
+    };
+}
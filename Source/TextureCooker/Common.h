@@ -0,0 +1,81 @@
+/*+===================================================================
+  File:      COMMON.H
+
+  Summary:   Common header file that contains common header files and
+             types used for the TextureCooker project of Game Graphics
+             Programming course. The cooker builds on Windows and on
+             Linux, so only the image decoding goes through Windows.
+
+  Functions:
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#if defined(_WIN32)
+
+#ifndef  UNICODE
+#define UNICODE
+#endif // ! UNICODE
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // ! WIN32_LEAN_AND_MEAN
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // ! NOMINMAX
+
+#include <windows.h>
+#include <objbase.h>
+#include <wincodec.h>
+#include <wrl.h>
+
+using namespace Microsoft::WRL;
+
+#else
+
+#include <cstdint>
+
+typedef uint8_t BYTE;
+typedef uint16_t WORD;
+typedef uint32_t UINT;
+typedef uint32_t DWORD;
+typedef uint64_t UINT64;
+typedef int32_t INT;
+typedef int32_t LONG;
+typedef int32_t BOOL;
+typedef float FLOAT;
+typedef char CHAR;
+typedef LONG HRESULT;
+
+#define TRUE (1)
+#define FALSE (0)
+
+// The DDS parser of the Library, which the tests read cooked files with, defines these too
+#ifndef S_OK
+#define S_OK ((HRESULT)0L)
+#define E_FAIL ((HRESULT)0x80004005L)
+#define E_INVALIDARG ((HRESULT)0x80070057L)
+#define SUCCEEDED(hr) (((HRESULT)(hr)) >= 0)
+#define FAILED(hr) (((HRESULT)(hr)) < 0)
+#endif
+#ifndef E_OUTOFMEMORY
+#define E_OUTOFMEMORY ((HRESULT)0x8007000EL)
+#endif
+
+// The annotations are only checked by the Windows compiler
+#define _In_
+#define _In_opt_
+#define _Out_
+#define _Inout_
+#define _In_reads_(size)
+#define _Out_writes_(size)
+
+#endif
+
+#include <cassert>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
@@ -0,0 +1,373 @@
+#include "Image.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace cooker
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Image::Image
+
+      Summary:  Constructor of an empty image
+
+      Modifies: [m_uWidth, m_uHeight, m_aPixels].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    Image::Image()
+        : m_uWidth(0u)
+        , m_uHeight(0u)
+        , m_aPixels()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Image::Image
+
+      Summary:  Constructor of a transparent black image
+
+      Args:     UINT uWidth
+                  Width of the image
+                UINT uHeight
+                  Height of the image
+
+      Modifies: [m_uWidth, m_uHeight, m_aPixels].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    Image::Image(_In_ UINT uWidth, _In_ UINT uHeight)
+        : m_uWidth(uWidth)
+        , m_uHeight(uHeight)
+        , m_aPixels(static_cast<size_t>(uWidth) * uHeight * 4u, 0.0f)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Image::Load
+
+      Summary:  Reads an image from a netpbm file, or through WIC on
+                Windows
+
+      Args:     const std::filesystem::path& filePath
+                  Path to the image
+                Image& image
+                  Image read
+
+      Modifies: [image].
+
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG if the format is not read
+                  on this platform
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Image::Load(_In_ const std::filesystem::path& filePath, _Out_ Image& image)
+    {
+        std::string extension = filePath.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](CHAR c) { return static_cast<CHAR>(std::tolower(static_cast<unsigned char>(c))); });
+
+        if (extension == ".ppm" || extension == ".pgm" || extension == ".pam" || extension == ".pnm")
+        {
+            return loadNetpbm(filePath, image);
+        }
+
+        return loadWic(filePath, image);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Image::Quantize
+
+      Summary:  Returns the image as RGBA bytes, rounded to nearest
+
+      Args:     std::vector<BYTE>& aRgba
+                  Bytes of the image
+
+      Modifies: [aRgba].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Image::Quantize(_Out_ std::vector<BYTE>& aRgba) const
+    {
+        aRgba.resize(m_aPixels.size());
+        for (size_t i = 0u; i < m_aPixels.size(); ++i)
+        {
+            aRgba[i] = static_cast<BYTE>((std::min)((std::max)(m_aPixels[i], 0.0f), 1.0f) * 255.0f + 0.5f);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Image::HasAlpha
+
+      Summary:  Returns whether a texel is not opaque once quantized
+
+      Returns:  BOOL
+                  TRUE if the alpha is needed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL Image::HasAlpha() const
+    {
+        for (size_t i = 3u; i < m_aPixels.size(); i += 4u)
+        {
+            if (m_aPixels[i] < 254.5f / 255.0f)
+            {
+                return TRUE;
+            }
+        }
+
+        return FALSE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Image::GetWidth
+
+      Summary:  Returns the width
+
+      Returns:  UINT
+                  Width in texels
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Image::GetWidth() const
+    {
+        return m_uWidth;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Image::GetHeight
+
+      Summary:  Returns the height
+
+      Returns:  UINT
+                  Height in texels
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Image::GetHeight() const
+    {
+        return m_uHeight;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Image::loadNetpbm
+
+      Summary:  Reads a binary PGM (P5), PPM (P6) or PAM (P7) file of 8
+                or 16 bits per sample. Gray is spread to the three
+                colors and a missing alpha is opaque
+
+      Args:     const std::filesystem::path& filePath
+                  Path to the image
+                Image& image
+                  Image read
+
+      Modifies: [image].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Image::loadNetpbm(_In_ const std::filesystem::path& filePath, _Out_ Image& image)
+    {
+        std::ifstream file(filePath, std::ios::binary);
+        if (!file)
+        {
+            return E_FAIL;
+        }
+
+        // Whitespace separated tokens, # starting a comment up to the end of the line
+        auto readToken = [&file](std::string& token)
+        {
+            token.clear();
+            for (INT c = file.get(); c != EOF; c = file.get())
+            {
+                if (c == '#')
+                {
+                    while (c != EOF && c != '\n')
+                    {
+                        c = file.get();
+                    }
+                    continue;
+                }
+
+                if (std::isspace(c))
+                {
+                    if (!token.empty())
+                    {
+                        break;
+                    }
+                    continue;
+                }
+
+                token += static_cast<CHAR>(c);
+            }
+
+            return !token.empty();
+        };
+
+        std::string token;
+        if (!readToken(token))
+        {
+            return E_FAIL;
+        }
+
+        UINT uWidth = 0u;
+        UINT uHeight = 0u;
+        UINT uDepth = 0u;
+        UINT uMaxValue = 0u;
+        if (token == "P5" || token == "P6")
+        {
+            uDepth = token == "P5" ? 1u : 3u;
+
+            std::string width, height, maxValue;
+            if (!readToken(width) || !readToken(height) || !readToken(maxValue))
+            {
+                return E_FAIL;
+            }
+
+            uWidth = static_cast<UINT>(std::stoul(width));
+            uHeight = static_cast<UINT>(std::stoul(height));
+            uMaxValue = static_cast<UINT>(std::stoul(maxValue));
+        }
+        else if (token == "P7")
+        {
+            std::string value;
+            while (readToken(token) && token != "ENDHDR")
+            {
+                if (!readToken(value))
+                {
+                    return E_FAIL;
+                }
+
+                if (token == "WIDTH")
+                {
+                    uWidth = static_cast<UINT>(std::stoul(value));
+                }
+                else if (token == "HEIGHT")
+                {
+                    uHeight = static_cast<UINT>(std::stoul(value));
+                }
+                else if (token == "DEPTH")
+                {
+                    uDepth = static_cast<UINT>(std::stoul(value));
+                }
+                else if (token == "MAXVAL")
+                {
+                    uMaxValue = static_cast<UINT>(std::stoul(value));
+                }
+            }
+
+            if (token != "ENDHDR")
+            {
+                return E_FAIL;
+            }
+        }
+        else
+        {
+            return E_INVALIDARG;
+        }
+
+        if (uWidth == 0u || uHeight == 0u || uDepth == 0u || uDepth > 4u || uMaxValue == 0u || uMaxValue > 65535u)
+        {
+            return E_FAIL;
+        }
+
+        const UINT uSampleSize = uMaxValue < 256u ? 1u : 2u;
+        std::vector<BYTE> aData(static_cast<size_t>(uWidth) * uHeight * uDepth * uSampleSize);
+        if (!file.read(reinterpret_cast<CHAR*>(aData.data()), static_cast<std::streamsize>(aData.size())))
+        {
+            return E_FAIL;
+        }
+
+        image = Image(uWidth, uHeight);
+        for (size_t uPixel = 0u; uPixel < static_cast<size_t>(uWidth) * uHeight; ++uPixel)
+        {
+            FLOAT aSamples[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+            for (UINT c = 0u; c < uDepth; ++c)
+            {
+                const BYTE* pSample = &aData[(uPixel * uDepth + c) * uSampleSize];
+                UINT uSample = uSampleSize == 1u ? pSample[0] : (static_cast<UINT>(pSample[0]) << 8u) | pSample[1];
+                aSamples[c] = static_cast<FLOAT>(uSample) / static_cast<FLOAT>(uMaxValue);
+            }
+
+            FLOAT* pPixel = &image.m_aPixels[uPixel * 4u];
+            if (uDepth <= 2u)
+            {
+                pPixel[0] = pPixel[1] = pPixel[2] = aSamples[0];
+                pPixel[3] = uDepth == 2u ? aSamples[1] : 1.0f;
+            }
+            else
+            {
+                std::copy(aSamples, aSamples + 4, pPixel);
+            }
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Image::loadWic
+
+      Summary:  Reads an image through WIC, converted to 8 bits RGBA
+                like the game loads it. Only on Windows, where COM
+                must be initialized
+
+      Args:     const std::filesystem::path& filePath
+                  Path to the image
+                Image& image
+                  Image read
+
+      Modifies: [image].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Image::loadWic(_In_ const std::filesystem::path& filePath, _Out_ Image& image)
+    {
+#if defined(_WIN32)
+        ComPtr<IWICImagingFactory> factory;
+        HRESULT hr = CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(factory.GetAddressOf()));
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        ComPtr<IWICBitmapDecoder> decoder;
+        hr = factory->CreateDecoderFromFilename(filePath.c_str(), nullptr, GENERIC_READ, WICDecodeMetadataCacheOnDemand, decoder.GetAddressOf());
+
+        ComPtr<IWICBitmapFrameDecode> frame;
+        if (SUCCEEDED(hr))
+        {
+            hr = decoder->GetFrame(0u, frame.GetAddressOf());
+        }
+
+        UINT uWidth = 0u;
+        UINT uHeight = 0u;
+        if (SUCCEEDED(hr))
+        {
+            hr = frame->GetSize(&uWidth, &uHeight);
+        }
+
+        ComPtr<IWICFormatConverter> converter;
+        if (SUCCEEDED(hr))
+        {
+            hr = factory->CreateFormatConverter(converter.GetAddressOf());
+        }
+
+        if (SUCCEEDED(hr))
+        {
+            hr = converter->Initialize(frame.Get(), GUID_WICPixelFormat32bppRGBA, WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeCustom);
+        }
+
+        std::vector<BYTE> aRgba(static_cast<size_t>(uWidth) * uHeight * 4u);
+        if (SUCCEEDED(hr))
+        {
+            hr = converter->CopyPixels(nullptr, uWidth * 4u, static_cast<UINT>(aRgba.size()), aRgba.data());
+        }
+
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        image = Image(uWidth, uHeight);
+        for (size_t i = 0u; i < aRgba.size(); ++i)
+        {
+            image.m_aPixels[i] = static_cast<FLOAT>(aRgba[i]) / 255.0f;
+        }
+
+        return S_OK;
+#else
+        (void)filePath;
+        (void)image;
+
+        // No decoder for compressed formats off Windows; convert them to PAM first
+        return E_INVALIDARG;
+#endif
+    }
+}
@@ -0,0 +1,89 @@
+/*+===================================================================
+  File:      IMAGE.H
+
+  Summary:   Image header file contains declarations of Image class
+             used by the TextureCooker of Game Graphics Programming
+             course.
+
+  Classes: Image
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace cooker
+{
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+      Enum:     eTextureKind
+
+      Summary:  What the texels of a texture mean, which decides how
+                its mips are filtered and how it is compressed
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eTextureKind : UINT
+    {
+        COLOR,
+        NORMAL,
+        MASK,
+        COUNT,
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    Image
+
+      Summary:  RGBA image of floats in [0, 1], as stored in its file,
+                rows from the top. Images are read from binary netpbm
+                files (PPM, PGM, PAM) everywhere, and from anything
+                WIC decodes on Windows. Its mips are made from its
+                bytes by the MipGenerator of the Library, the filter
+                the game uses for the textures it loads
+
+      Methods:  Load
+                  Reads an image from a file
+                Quantize
+                  Returns the image as RGBA bytes
+                HasAlpha
+                  Returns whether a texel is not opaque
+                GetWidth
+                  Returns the width
+                GetHeight
+                  Returns the height
+                loadNetpbm
+                  Reads a binary PPM, PGM or PAM file
+                loadWic
+                  Reads an image through WIC, on Windows
+                Image
+                  Constructor.
+                ~Image
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class Image final
+    {
+    public:
+        Image();
+        Image(_In_ UINT uWidth, _In_ UINT uHeight);
+        Image(const Image& other) = default;
+        Image(Image&& other) = default;
+        Image& operator=(const Image& other) = default;
+        Image& operator=(Image&& other) = default;
+        ~Image() = default;
+
+        static HRESULT Load(_In_ const std::filesystem::path& filePath, _Out_ Image& image);
+
+        void Quantize(_Out_ std::vector<BYTE>& aRgba) const;
+        BOOL HasAlpha() const;
+
+        UINT GetWidth() const;
+        UINT GetHeight() const;
+
+    private:
+        static HRESULT loadNetpbm(_In_ const std::filesystem::path& filePath, _Out_ Image& image);
+        static HRESULT loadWic(_In_ const std::filesystem::path& filePath, _Out_ Image& image);
+
+    private:
+        UINT m_uWidth;
+        UINT m_uHeight;
+        std::vector<FLOAT> m_aPixels;
+    };
+}
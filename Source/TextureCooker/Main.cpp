@@ -0,0 +1,114 @@
+/*+===================================================================
+  File:      MAIN.CPP
+
+  Summary:   This application cooks the textures of the models into
+             block compressed DDS files with their mips, written next
+             to the images they come from, where Model picks them up
+             instead of the images.
+
+             Usage: TextureCooker [--color | --normal | --mask] <image>...
+             Each flag applies to the images after it, colors first.
+
+             Builds with the solution on Windows, and on Linux with
+             the CMakeLists.txt next to it, where it reads binary PPM,
+             PGM and PAM images only.
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+
+#include "Common.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "TextureCooker.h"
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: main
+
+  Summary:  Entry point to the program. Cooks every image given and
+            prints what it made of each, then the totals.
+
+  Args:     INT argc
+              Number of arguments
+            CHAR* argv[]
+              Arguments
+
+  Returns:  INT
+              0 if every image was cooked, 1 otherwise
+-----------------------------------------------------------------F-F*/
+INT main(INT argc, CHAR* argv[])
+{
+#if defined(_WIN32)
+    HRESULT hrCom = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+#endif
+
+    cooker::eTextureKind eKind = cooker::eTextureKind::COLOR;
+    UINT uNumCooked = 0u;
+    UINT uNumFailed = 0u;
+    UINT64 uNumTexels = 0ull;
+    UINT64 uNumBytes = 0ull;
+    FLOAT encodeTime = 0.0f;
+
+    for (INT i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--color") == 0)
+        {
+            eKind = cooker::eTextureKind::COLOR;
+            continue;
+        }
+        if (std::strcmp(argv[i], "--normal") == 0)
+        {
+            eKind = cooker::eTextureKind::NORMAL;
+            continue;
+        }
+        if (std::strcmp(argv[i], "--mask") == 0)
+        {
+            eKind = cooker::eTextureKind::MASK;
+            continue;
+        }
+
+        std::filesystem::path inputPath(argv[i]);
+        std::filesystem::path outputPath = inputPath;
+        outputPath.replace_extension(".dds");
+
+        cooker::CookReport report;
+        HRESULT hr = cooker::TextureCooker::Cook(inputPath, eKind, outputPath, report);
+        if (FAILED(hr))
+        {
+            std::fprintf(stderr, "%s: failed (0x%08x)\n", argv[i], static_cast<UINT>(hr));
+            ++uNumFailed;
+            continue;
+        }
+
+        std::printf("%s: %ux%u %s, %u mips, %.2f dB, mips %.1f ms, encode %.1f ms (%.1f MP/s)\n",
+                    argv[i], report.uWidth, report.uHeight, cooker::TextureCooker::GetFormatName(report.eFormat), report.uNumMips, report.psnr,
+                    report.mipTime, report.encodeTime, static_cast<double>(report.uNumTexels) / (std::max)(report.encodeTime, 1e-3f) / 1000.0);
+
+        ++uNumCooked;
+        uNumTexels += report.uNumTexels;
+        uNumBytes += report.uNumBytes;
+        encodeTime += report.encodeTime;
+    }
+
+    if (uNumCooked + uNumFailed == 0u)
+    {
+        std::fprintf(stderr, "Usage: %s [--color | --normal | --mask] <image>...\n", argc > 0 ? argv[0] : "TextureCooker");
+    }
+    else
+    {
+        std::printf("Cooked %u textures (%u failed): %llu texels into %llu bytes, encoded at %.1f MP/s\n",
+                    uNumCooked, uNumFailed, static_cast<unsigned long long>(uNumTexels), static_cast<unsigned long long>(uNumBytes),
+                    static_cast<double>(uNumTexels) / (std::max)(encodeTime, 1e-3f) / 1000.0);
+    }
+
+#if defined(_WIN32)
+    if (SUCCEEDED(hrCom))
+    {
+        CoUninitialize();
+    }
+#endif
+
+    return uNumFailed == 0u && uNumCooked > 0u ? 0 : 1;
+}
@@ -0,0 +1,306 @@
+#include "TextureCooker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+namespace cooker
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::Cook
+
+      Summary:  Reads an image, builds its mips with the MipGenerator
+                the game loads textures with, encodes them and writes
+                them to a DDS file
+
+      Args:     const std::filesystem::path& inputPath
+                  Path to the image
+                eTextureKind eKind
+                  What the texels of the image mean
+                const std::filesystem::path& outputPath
+                  Path to the DDS file, replaced if it exists
+                CookReport& report
+                  What was cooked
+
+      Modifies: [report].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT TextureCooker::Cook(_In_ const std::filesystem::path& inputPath, _In_ eTextureKind eKind, _In_ const std::filesystem::path& outputPath, _Out_ CookReport& report)
+    {
+        report = CookReport{};
+
+        Image image;
+        HRESULT hr = Image::Load(inputPath, image);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        report.eFormat = GetFormat(eKind, image);
+        report.uWidth = image.GetWidth();
+        report.uHeight = image.GetHeight();
+
+        std::vector<std::vector<BYTE>> aaRgba(1u);
+        image.Quantize(aaRgba[0]);
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        library::MipGenerator::GenerateMips(getContent(eKind), report.uWidth, report.uHeight, aaRgba);
+
+        std::chrono::steady_clock::time_point mipsEnd = std::chrono::steady_clock::now();
+        report.mipTime = std::chrono::duration<FLOAT, std::milli>(mipsEnd - start).count();
+
+        start = std::chrono::steady_clock::now();
+
+        std::vector<std::vector<BYTE>> aaBlocks(aaRgba.size());
+        for (UINT uMip = 0u; uMip < static_cast<UINT>(aaRgba.size()); ++uMip)
+        {
+            const UINT uMipWidth = (std::max)(report.uWidth >> uMip, 1u);
+            const UINT uMipHeight = (std::max)(report.uHeight >> uMip, 1u);
+            BlockCompressor::Compress(report.eFormat, aaRgba[uMip], uMipWidth, uMipHeight, aaBlocks[uMip]);
+
+            report.uNumTexels += static_cast<UINT64>(uMipWidth) * uMipHeight;
+            report.uNumBytes += aaBlocks[uMip].size();
+        }
+
+        report.encodeTime = std::chrono::duration<FLOAT, std::milli>(std::chrono::steady_clock::now() - start).count();
+        report.uNumMips = static_cast<UINT>(aaRgba.size());
+        report.psnr = measurePsnr(report.eFormat, aaRgba[0], aaBlocks[0], report.uWidth, report.uHeight);
+
+        return writeDds(outputPath, report.eFormat, report.uWidth, report.uHeight, aaBlocks);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::GetFormat
+
+      Summary:  Returns the format a texture is cooked to
+
+      Args:     eTextureKind eKind
+                  What the texels of the image mean
+                const Image& image
+                  Image of the texture
+
+      Returns:  eBlockFormat
+                  Format of the blocks
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    eBlockFormat TextureCooker::GetFormat(_In_ eTextureKind eKind, _In_ const Image& image)
+    {
+        switch (eKind)
+        {
+        case eTextureKind::NORMAL:
+            return eBlockFormat::BC5;
+        case eTextureKind::MASK:
+            return eBlockFormat::BC4;
+        default:
+            return image.HasAlpha() ? eBlockFormat::BC3 : eBlockFormat::BC1;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::GetFormatName
+
+      Summary:  Returns the name of a format
+
+      Args:     eBlockFormat eFormat
+                  Format of the blocks
+
+      Returns:  const CHAR*
+                  Name of the format
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const CHAR* TextureCooker::GetFormatName(_In_ eBlockFormat eFormat)
+    {
+        static constexpr const CHAR* NAMES[] = { "BC1", "BC3", "BC4", "BC5" };
+
+        return NAMES[static_cast<UINT>(eFormat)];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::getContent
+
+      Summary:  Returns how the MipGenerator filters a kind of texture
+
+      Args:     eTextureKind eKind
+                  What the texels of the image mean
+
+      Returns:  library::eTextureContent
+                  Content the mips are filtered as
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    library::eTextureContent TextureCooker::getContent(_In_ eTextureKind eKind)
+    {
+        switch (eKind)
+        {
+        case eTextureKind::NORMAL:
+            return library::eTextureContent::NORMAL;
+        case eTextureKind::MASK:
+            return library::eTextureContent::DATA;
+        default:
+            return library::eTextureContent::COLOR;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::measurePsnr
+
+      Summary:  Decodes the blocks of an image and compares them to it
+                over the channels the format stores
+
+      Args:     eBlockFormat eFormat
+                  Format of the blocks
+                const std::vector<BYTE>& aRgba
+                  RGBA bytes of the image
+                const std::vector<BYTE>& aBlocks
+                  Blocks of the image
+                UINT uWidth
+                  Width of the image
+                UINT uHeight
+                  Height of the image
+
+      Returns:  FLOAT
+                  Peak signal to noise ratio in decibels, infinite if
+                  the blocks are exact
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT TextureCooker::measurePsnr(_In_ eBlockFormat eFormat, _In_ const std::vector<BYTE>& aRgba, _In_ const std::vector<BYTE>& aBlocks, _In_ UINT uWidth, _In_ UINT uHeight)
+    {
+        static constexpr const UINT NUM_CHANNELS[] = { 3u, 4u, 1u, 2u };
+
+        std::vector<BYTE> aDecoded;
+        BlockCompressor::Decompress(eFormat, aBlocks, uWidth, uHeight, aDecoded);
+
+        const UINT uNumChannels = NUM_CHANNELS[static_cast<UINT>(eFormat)];
+        double squaredError = 0.0;
+        for (size_t i = 0u; i < aRgba.size(); i += 4u)
+        {
+            for (UINT c = 0u; c < uNumChannels; ++c)
+            {
+                const double difference = static_cast<double>(aRgba[i + c]) - static_cast<double>(aDecoded[i + c]);
+                squaredError += difference * difference;
+            }
+        }
+
+        if (squaredError == 0.0)
+        {
+            return std::numeric_limits<FLOAT>::infinity();
+        }
+
+        const double meanSquaredError = squaredError / (static_cast<double>(uWidth) * uHeight * uNumChannels);
+
+        return static_cast<FLOAT>(10.0 * std::log10(255.0 * 255.0 / meanSquaredError));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TextureCooker::writeDds
+
+      Summary:  Writes mips to a DDS file with the legacy header, the
+                format in its FourCC, which every DDS reader knows.
+                The file is written aside then renamed, so the game
+                never reads half a file
+
+      Args:     const std::filesystem::path& outputPath
+                  Path to the DDS file
+                eBlockFormat eFormat
+                  Format of the blocks
+                UINT uWidth
+                  Width of the top mip
+                UINT uHeight
+                  Height of the top mip
+                const std::vector<std::vector<BYTE>>& aaMips
+                  Blocks of the mips, from the top
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT TextureCooker::writeDds(_In_ const std::filesystem::path& outputPath, _In_ eBlockFormat eFormat, _In_ UINT uWidth, _In_ UINT uHeight, _In_ const std::vector<std::vector<BYTE>>& aaMips)
+    {
+        static constexpr const DWORD DDS_MAGIC = 0x20534444u;                  // "DDS "
+        static constexpr const DWORD DDS_HEADER_SIZE = 124u;
+        static constexpr const DWORD DDS_PIXEL_FORMAT_SIZE = 32u;
+        static constexpr const DWORD DDSD_CAPS_HEIGHT_WIDTH_PIXELFORMAT = 0x1007u;
+        static constexpr const DWORD DDSD_MIPMAPCOUNT = 0x20000u;
+        static constexpr const DWORD DDSD_LINEARSIZE = 0x80000u;
+        static constexpr const DWORD DDPF_FOURCC = 0x4u;
+        static constexpr const DWORD DDSCAPS_COMPLEX = 0x8u;
+        static constexpr const DWORD DDSCAPS_TEXTURE = 0x1000u;
+        static constexpr const DWORD DDSCAPS_MIPMAP = 0x400000u;
+        static constexpr const DWORD FOURCCS[] =
+        {
+            0x31545844u,    // "DXT1"
+            0x35545844u,    // "DXT5"
+            0x55344342u,    // "BC4U"
+            0x55354342u,    // "BC5U"
+        };
+
+        std::vector<BYTE> aHeader;
+        aHeader.reserve(4u + DDS_HEADER_SIZE);
+        auto write = [&aHeader](DWORD uValue)
+        {
+            for (UINT i = 0u; i < 4u; ++i)
+            {
+                aHeader.push_back(static_cast<BYTE>((uValue >> (8u * i)) & 0xffu));
+            }
+        };
+
+        write(DDS_MAGIC);
+        write(DDS_HEADER_SIZE);
+        write(DDSD_CAPS_HEIGHT_WIDTH_PIXELFORMAT | DDSD_MIPMAPCOUNT | DDSD_LINEARSIZE);
+        write(uHeight);
+        write(uWidth);
+        write(static_cast<DWORD>(aaMips[0].size()));
+        write(0u);                                                              // Depth
+        write(static_cast<DWORD>(aaMips.size()));
+        for (UINT i = 0u; i < 11u; ++i)
+        {
+            write(0u);                                                          // Reserved
+        }
+
+        write(DDS_PIXEL_FORMAT_SIZE);
+        write(DDPF_FOURCC);
+        write(FOURCCS[static_cast<UINT>(eFormat)]);
+        for (UINT i = 0u; i < 5u; ++i)
+        {
+            write(0u);                                                          // Bit count and masks
+        }
+
+        write(DDSCAPS_TEXTURE | (aaMips.size() > 1u ? DDSCAPS_COMPLEX | DDSCAPS_MIPMAP : 0u));
+        for (UINT i = 0u; i < 4u; ++i)
+        {
+            write(0u);                                                          // Caps 2 to 4, reserved
+        }
+
+        std::filesystem::path temporaryPath = outputPath;
+        temporaryPath += ".tmp";
+
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                return E_FAIL;
+            }
+
+            file.write(reinterpret_cast<const CHAR*>(aHeader.data()), static_cast<std::streamsize>(aHeader.size()));
+            for (const std::vector<BYTE>& aMip : aaMips)
+            {
+                file.write(reinterpret_cast<const CHAR*>(aMip.data()), static_cast<std::streamsize>(aMip.size()));
+            }
+
+            if (!file)
+            {
+                return E_FAIL;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(temporaryPath, outputPath, ec);
+        if (ec)
+        {
+            std::filesystem::remove(temporaryPath, ec);
+
+            return E_FAIL;
+        }
+
+        return S_OK;
+    }
+}
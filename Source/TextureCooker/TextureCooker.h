@@ -0,0 +1,89 @@
+/*+===================================================================
+  File:      TEXTURECOOKER.H
+
+  Summary:   TextureCooker header file contains declarations of
+             TextureCooker class used by the TextureCooker of Game
+             Graphics Programming course.
+
+  Classes: TextureCooker
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "BlockCompressor.h"
+#include "Image.h"
+#include "Texture/MipGenerator.h"
+
+namespace cooker
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   CookReport
+
+      Summary:  What cooking a texture made and how long it took: the
+                format and mips written, the peak signal to noise ratio
+                of the top mip over the channels stored, in decibels,
+                and the milliseconds spent filtering the mips and
+                encoding their blocks
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct CookReport
+    {
+        eBlockFormat eFormat;
+        UINT uWidth;
+        UINT uHeight;
+        UINT uNumMips;
+        UINT64 uNumTexels;
+        UINT64 uNumBytes;
+        FLOAT psnr;
+        FLOAT mipTime;
+        FLOAT encodeTime;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    TextureCooker
+
+      Summary:  Turns an image into a DDS file of block compressed mips
+                down to a texel, which DDSTextureLoader creates as is.
+                Colors are BC1, or BC3 when some texel is not opaque,
+                normals BC5 keeping x and y, and masks BC4 keeping red
+
+      Methods:  Cook
+                  Cooks an image into a DDS file
+                GetFormat
+                  Returns the format a texture is cooked to
+                GetFormatName
+                  Returns the name of a format
+                getContent
+                  Returns how the mips of a kind are filtered
+                measurePsnr
+                  Compares an image to its decoded blocks
+                writeDds
+                  Writes mips to a DDS file
+                TextureCooker
+                  Constructor.
+                ~TextureCooker
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class TextureCooker final
+    {
+    public:
+        TextureCooker() = delete;
+        TextureCooker(const TextureCooker& other) = delete;
+        TextureCooker(TextureCooker&& other) = delete;
+        TextureCooker& operator=(const TextureCooker& other) = delete;
+        TextureCooker& operator=(TextureCooker&& other) = delete;
+        ~TextureCooker() = delete;
+
+        static HRESULT Cook(_In_ const std::filesystem::path& inputPath, _In_ eTextureKind eKind, _In_ const std::filesystem::path& outputPath, _Out_ CookReport& report);
+
+        static eBlockFormat GetFormat(_In_ eTextureKind eKind, _In_ const Image& image);
+        static const CHAR* GetFormatName(_In_ eBlockFormat eFormat);
+
+    private:
+        static library::eTextureContent getContent(_In_ eTextureKind eKind);
+        static FLOAT measurePsnr(_In_ eBlockFormat eFormat, _In_ const std::vector<BYTE>& aRgba, _In_ const std::vector<BYTE>& aBlocks, _In_ UINT uWidth, _In_ UINT uHeight);
+        static HRESULT writeDds(_In_ const std::filesystem::path& outputPath, _In_ eBlockFormat eFormat, _In_ UINT uWidth, _In_ UINT uHeight, _In_ const std::vector<std::vector<BYTE>>& aaMips);
+    };
+}